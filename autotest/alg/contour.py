@@ -347,6 +347,93 @@ def test_contour_raster_acquisition_error():
                                         options = [ "LEVEL_INTERVAL=1",
                                                     "ID_FIELD=0"] ) != 0
 
+###############################################################################
+# Test that errors of the strips processed by worker threads in the tiled
+# mode (NUM_THREADS) are reported
+
+
+def test_contour_raster_acquisition_error_num_threads():
+
+    ogr_ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    ogr_lyr = ogr_ds.CreateLayer('contour', geom_type=ogr.wkbLineString)
+    field_defn = ogr.FieldDefn('ID', ogr.OFTInteger)
+    ogr_lyr.CreateField(field_defn)
+    ds = gdal.Open('../gcore/data/byte_truncated.tif')
+
+    gdal.ErrorReset()
+    with gdaltest.config_option('GDAL_CONTOUR_STRIP_HEIGHT', '5'):
+        with gdaltest.error_handler():
+            assert gdal.ContourGenerateEx(ds.GetRasterBand(1), ogr_lyr,
+                                          options = [ "LEVEL_INTERVAL=1",
+                                                      "ID_FIELD=0",
+                                                      "NUM_THREADS=2"] ) != 0
+    assert gdal.GetLastErrorType() == gdal.CE_Failure
+
+###############################################################################
+# Test that the tiled mode (NUM_THREADS) produces the same contours as the
+# default mode
+
+
+# Strips of one line, where lines cross several seams, and strips of several
+# lines, processed in the calling thread or by worker threads.
+@pytest.mark.parametrize("strip_height,num_threads", [("1", "4"),
+                                                      ("3", "1"),
+                                                      ("3", "4")])
+@pytest.mark.parametrize("polygonize", [False, True])
+@pytest.mark.parametrize("nodata", [None, "330"])
+def test_contour_num_threads(polygonize, nodata, strip_height, num_threads):
+
+    ds = gdal.Open('data/contour_in.tif')
+
+    def contour(options):
+        ogr_ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+        if polygonize:
+            ogr_lyr = ogr_ds.CreateLayer('contour', geom_type=ogr.wkbMultiPolygon)
+            ogr_lyr.CreateField(ogr.FieldDefn('elevMin', ogr.OFTReal))
+            ogr_lyr.CreateField(ogr.FieldDefn('elevMax', ogr.OFTReal))
+            options = options + ['POLYGONIZE=YES', 'ELEV_FIELD_MIN=0', 'ELEV_FIELD_MAX=1']
+            elev_field = 'elevMin'
+        else:
+            ogr_lyr = ogr_ds.CreateLayer('contour', geom_type=ogr.wkbLineString)
+            ogr_lyr.CreateField(ogr.FieldDefn('elev', ogr.OFTReal))
+            options = options + ['ELEV_FIELD=0']
+            elev_field = 'elev'
+        if nodata:
+            options = options + ['NODATA=' + nodata]
+        assert gdal.ContourGenerateEx(ds.GetRasterBand(1), ogr_lyr,
+                                      options=options + ['LEVEL_INTERVAL=5']) == 0
+
+        # Collect the number of features, their total length or area, and
+        # their envelope for each level.
+        levels = []
+        lyr = ogr_ds.ExecuteSQL("select * from contour order by %s asc" % elev_field)
+        for feat in lyr:
+            geom = feat.GetGeometryRef()
+            measure = geom.GetArea() if polygonize else geom.Length()
+            envelope = geom.GetEnvelope()
+            if levels and levels[-1][0] == feat.GetField(elev_field):
+                _, count, total, (minx, maxx, miny, maxy) = levels[-1]
+                levels[-1] = (feat.GetField(elev_field), count + 1, total + measure,
+                              (min(minx, envelope[0]), max(maxx, envelope[1]),
+                               min(miny, envelope[2]), max(maxy, envelope[3])))
+            else:
+                levels.append((feat.GetField(elev_field), 1, measure, envelope))
+        ogr_ds.ReleaseResultSet(lyr)
+        return levels
+
+    expected = contour([])
+
+    with gdaltest.config_option('GDAL_CONTOUR_STRIP_HEIGHT', strip_height):
+        got = contour(['NUM_THREADS=' + num_threads])
+
+    assert len(got) == len(expected)
+    for i, (elev, count, measure, envelope) in enumerate(got):
+        assert elev == expected[i][0]
+        assert count == expected[i][1], elev
+        assert measure == pytest.approx(expected[i][2], rel=1e-12), elev
+        for j in range(4):
+            assert envelope[j] == pytest.approx(expected[i][3][j], abs=1e-8), elev
+
 ###############################################################################
 # Cleanup
 
@@ -32,7 +32,7 @@
 
 
 
-from osgeo import gdal
+from osgeo import gdal, ogr
 import ogrtest
 import gdaltest
 import pytest
@@ -120,3 +120,66 @@ def test_cutline_4():
 
 
 
+
+
+###############################################################################
+# Check that the cutline mask computed chunk by chunk matches the
+# rasterization of the cutline in one go
+
+cutline_chunked_wkt = 'MULTIPOLYGON(((5.5 3,95 20.25,60 97.5,2 60,5.5 3),(30 30,30.5 60,70 45.5,30 30)),((80 80,99 80,99 99,80 99,80 80)))'
+
+
+def _cutline_warp(warp_options, warp_memory_limit):
+
+    src_ds = gdal.GetDriverByName('MEM').Create('', 100, 100)
+    src_ds.SetGeoTransform([0, 1, 0, 100, 0, -1])
+    src_ds.GetRasterBand(1).Fill(255)
+
+    # The cutline is in source pixel/line coordinates.
+    out_ds = gdal.Warp('', src_ds, format='MEM',
+                       warpOptions=['CUTLINE=' + cutline_chunked_wkt] + warp_options,
+                       warpMemoryLimit=warp_memory_limit)
+    return out_ds.GetRasterBand(1).ReadRaster()
+
+
+def _cutline_rasterize(rasterize_options):
+
+    ref_ds = gdal.GetDriverByName('MEM').Create('', 100, 100)
+    ref_ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+    mem_lyr_ds = gdal.GetDriverByName('Memory').Create('', 0, 0, 0)
+    lyr = mem_lyr_ds.CreateLayer('cutline')
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt(cutline_chunked_wkt))
+    lyr.CreateFeature(f)
+    gdal.RasterizeLayer(ref_ds, [1], lyr, burn_values=[255],
+                        options=rasterize_options)
+    return ref_ds.GetRasterBand(1).ReadRaster()
+
+
+def test_cutline_chunked_matches_rasterize():
+
+    # Small warp memory limit to process many chunks
+    assert _cutline_warp([], 20000) == _cutline_rasterize([])
+
+###############################################################################
+# Same with CUTLINE_ALL_TOUCHED, where chunks close to the cutline edges
+# are rasterized the same way as the whole mask
+
+
+def test_cutline_chunked_all_touched_matches_rasterize():
+
+    expected = _cutline_rasterize(['ALL_TOUCHED=TRUE'])
+    assert expected != _cutline_rasterize([])
+    assert _cutline_warp(['CUTLINE_ALL_TOUCHED=TRUE'], 20000) == expected
+
+###############################################################################
+# Check that with CUTLINE_BLEND_DIST, the mask computed chunk by chunk, with
+# chunks entirely inside or outside the cutline, matches the one computed
+# with a single chunk
+
+
+def test_cutline_chunked_blend_dist_matches_single_chunk():
+
+    expected = _cutline_warp(['CUTLINE_BLEND_DIST=5'], 64 * 1024 * 1024)
+    assert expected != _cutline_warp([], 64 * 1024 * 1024)
+    assert _cutline_warp(['CUTLINE_BLEND_DIST=5'], 20000) == expected
@@ -30,6 +30,8 @@
 
 from osgeo import gdal
 
+import gdaltest
+
 import struct
 
 import pytest
@@ -87,3 +89,89 @@ def test_fillnodata_nodata(width, height, input_ar, maxSearchDist, expected):
                     maskBand = None, smoothingIterations = 0)
     ar = ds.ReadRaster()
     assert struct.unpack('B' * npixels, ar) == expected
+
+
+###############################################################################
+# Test INTERPOLATION=PUSH_PULL
+
+
+def _create_hole_dataset():
+    width, height = 60, 50
+    ds = gdal.GetDriverByName('MEM').Create('', width, height, 1, gdal.GDT_Float32)
+    ds.GetRasterBand(1).SetNoDataValue(-1)
+    values = []
+    for y in range(height):
+        for x in range(width):
+            if 10 <= x < 50 and 10 <= y < 40:
+                values.append(-1)
+            else:
+                values.append(x + 2 * y)
+    ds.WriteRaster(0, 0, width, height, struct.pack('f' * len(values), *values))
+    return ds
+
+
+def _read_values(ds):
+    band = ds.GetRasterBand(1)
+    return struct.unpack('f' * (ds.RasterXSize * ds.RasterYSize),
+                         band.ReadRaster(buf_type=gdal.GDT_Float32))
+
+
+def test_fillnodata_push_pull():
+
+    src_values = _read_values(_create_hole_dataset())
+
+    ds = _create_hole_dataset()
+    assert gdal.FillNodata(ds.GetRasterBand(1), None, 0, 0,
+                           ['INTERPOLATION=PUSH_PULL']) == 0
+    values = _read_values(ds)
+    valid = [v for v in src_values if v != -1]
+    for src_v, v in zip(src_values, values):
+        if src_v != -1:
+            assert v == src_v
+        else:
+            assert min(valid) <= v <= max(valid)
+
+    # Same result whatever the number of threads
+    ds = _create_hole_dataset()
+    gdal.FillNodata(ds.GetRasterBand(1), None, 0, 0,
+                    ['INTERPOLATION=PUSH_PULL', 'NUM_THREADS=4'])
+    assert _read_values(ds) == values
+
+    # With smoothing iterations
+    ds = _create_hole_dataset()
+    assert gdal.FillNodata(ds.GetRasterBand(1), None, 0, 2,
+                           ['INTERPOLATION=PUSH_PULL', 'TEMP_FILE_DRIVER=MEM']) == 0
+    assert -1 not in _read_values(ds)
+
+
+def test_fillnodata_push_pull_max_search_dist():
+
+    ds = _create_hole_dataset()
+    gdal.FillNodata(ds.GetRasterBand(1), None, 5, 0,
+                    ['INTERPOLATION=PUSH_PULL', 'NUM_THREADS=ALL_CPUS'])
+    values = _read_values(ds)
+    width = ds.RasterXSize
+    # 5 pixels from the left edge of the hole
+    assert values[20 * width + 14] != -1
+    # 6 pixels from the left edge of the hole, and 9 from the top edge
+    assert values[18 * width + 15] == -1
+    assert values[25 * width + 30] == -1
+
+
+def test_fillnodata_push_pull_too_large():
+
+    # Would need terabytes: fails before allocating anything
+    ds = gdal.GetDriverByName('VRT').Create('', 1000000, 1000000, 1, gdal.GDT_Float32)
+    gdal.ErrorReset()
+    with gdaltest.error_handler():
+        assert gdal.FillNodata(ds.GetRasterBand(1), None, 0, 0,
+                               ['INTERPOLATION=PUSH_PULL']) != 0
+    assert 'usable RAM' in gdal.GetLastErrorMsg()
+
+
+def test_fillnodata_invalid_interpolation():
+
+    ds = _create_hole_dataset()
+    with gdaltest.error_handler():
+        assert gdal.FillNodata(ds.GetRasterBand(1), None, 0, 0,
+                               ['INTERPOLATION=INVALID']) != 0
@@ -31,7 +31,9 @@
 
 
 
+import gdaltest
 import ogrtest
+import pytest
 
 from osgeo import gdal, ogr
 
@@ -193,3 +195,82 @@ def test_polygonize_4():
 
 
 
+
+###############################################################################
+# Test that the tiled mode (NUM_THREADS) produces the same polygons as the
+# default mode
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("strip_height", ['1', '3', None])
+def test_polygonize_num_threads(is_int_polygonize, connectedness, strip_height):
+
+    src_ds = gdal.Open('data/polygonize_in.grd')
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(options):
+        # Create a memory OGR datasource to put results in.
+        mem_drv = ogr.GetDriverByName('Memory')
+        mem_ds = mem_drv.CreateDataSource('out')
+
+        mem_layer = mem_ds.CreateLayer('poly', None, ogr.wkbPolygon)
+
+        fd = ogr.FieldDefn('DN', ogr.OFTInteger)
+        mem_layer.CreateField(fd)
+
+        # run the algorithm.
+        if connectedness == 8:
+            options = options + ['8CONNECTED=8']
+        if is_int_polygonize:
+            result = gdal.Polygonize(src_band, src_band.GetMaskBand(),
+                                     mem_layer, 0, options)
+        else:
+            result = gdal.FPolygonize(src_band, src_band.GetMaskBand(),
+                                      mem_layer, 0, options)
+        assert result == 0, 'Polygonize failed'
+
+        # Features are not written in the same order by both modes, so
+        # sort them by value and position.
+        polygons = []
+        for feat in mem_layer:
+            geom = feat.GetGeometryRef()
+            polygons.append((feat.GetField('DN'), geom.GetEnvelope(),
+                             geom.Clone()))
+        return sorted(polygons, key=lambda x: x[0:2])
+
+    expected = polygonize([])
+
+    with gdaltest.config_option('GDAL_POLYGONIZE_STRIP_HEIGHT', strip_height):
+        got = polygonize(['NUM_THREADS=4'])
+
+    # Confirm we get the same features as in the default mode.
+    assert [dn for dn, _, _ in got] == [dn for dn, _, _ in expected]
+    # Polygons crossing strips may start at another vertex, so compare them
+    # spatially.
+    for (_, _, geom), (_, _, expected_geom) in zip(got, expected):
+        assert geom.GetArea() == pytest.approx(expected_geom.GetArea(), rel=1e-12)
+        if ogrtest.have_geos():
+            assert geom.Equals(expected_geom)
+
+###############################################################################
+# Test that errors of the strip jobs are reported on the calling thread
+
+
+def test_polygonize_num_threads_error():
+
+    src_ds = gdal.Open('../gcore/data/byte_truncated.tif')
+    src_band = src_ds.GetRasterBand(1)
+
+    mem_ds = ogr.GetDriverByName('Memory').CreateDataSource('out')
+    mem_layer = mem_ds.CreateLayer('poly', None, ogr.wkbPolygon)
+    mem_layer.CreateField(ogr.FieldDefn('DN', ogr.OFTInteger))
+
+    gdal.ErrorReset()
+    with gdaltest.config_option('GDAL_POLYGONIZE_STRIP_HEIGHT', '5'):
+        with gdaltest.error_handler():
+            result = gdal.Polygonize(src_band, None, mem_layer, 0,
+                                     ['NUM_THREADS=2'])
+    assert result != 0
+    assert gdal.GetLastErrorType() == gdal.CE_Failure
+    assert gdal.GetLastErrorMsg() != ''
@@ -31,6 +31,9 @@
 
 
 
+import math
+import struct
+
 from osgeo import gdal
 import pytest
 
@@ -130,4 +133,60 @@ def test_proximity_3():
         pytest.fail('got wrong checksum')
     
 
+###############################################################################
+# Test the exact distance transform used with NUM_THREADS against a brute
+# force computation
+
+
+@pytest.mark.parametrize('num_threads', ['1', '3'])
+@pytest.mark.parametrize('options', [[],
+                                     ['VALUES=65,64', 'MAXDIST=12'],
+                                     ['VALUES=65,64', 'MAXDIST=12',
+                                      'FIXED_BUF_VAL=255'],
+                                     ['VALUES=65,64',
+                                      'USE_INPUT_NODATA=YES']])
+def test_proximity_num_threads(num_threads, options):
+
+    src_ds = gdal.Open('data/pat.tif')
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
 
+    dst_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize, 1,
+                                                gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    gdal.ComputeProximity(src_band, dst_band,
+                          options=options + ['NODATA=-1',
+                                             'NUM_THREADS=' + num_threads])
+
+    src = struct.unpack('i' * xsize * ysize,
+                        src_band.ReadRaster(buf_type=gdal.GDT_Int32))
+    got = struct.unpack('f' * xsize * ysize,
+                        dst_band.ReadRaster(buf_type=gdal.GDT_Float32))
+
+    opts = dict(opt.split('=') for opt in options)
+    if 'VALUES' in opts:
+        values = [int(v) for v in opts['VALUES'].split(',')]
+        targets = [i for i in range(xsize * ysize) if src[i] in values]
+    else:
+        targets = [i for i in range(xsize * ysize) if src[i] != 0]
+    assert targets
+    maxdist = float(opts.get('MAXDIST', xsize + ysize))
+    nodata = src_band.GetNoDataValue()
+    if opts.get('USE_INPUT_NODATA') != 'YES':
+        nodata = None
+
+    for i in range(xsize * ysize):
+        x, y = i % xsize, i // xsize
+        dist = math.sqrt(min((t % xsize - x) ** 2 + (t // xsize - y) ** 2
+                             for t in targets))
+        if dist == 0:
+            expected = 0
+        elif (nodata is not None and src[i] == nodata) or dist > maxdist:
+            expected = -1
+        elif 'FIXED_BUF_VAL' in opts:
+            expected = float(opts['FIXED_BUF_VAL'])
+        else:
+            expected = dist
+        assert got[i] == pytest.approx(expected, rel=1e-6), (x, y)
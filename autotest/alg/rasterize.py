@@ -31,6 +31,7 @@
 import struct
 
 
+import gdaltest
 import ogrtest
 
 from osgeo import gdal, ogr, osr
@@ -422,3 +423,99 @@ def test_rasterize_merge_alg_add_polygon(wkt):
                 0, 10, 10, 10, 10,
                 0, 10, 10, 10, 10,)
     assert got == expected, '%s' % str(got)
+
+###############################################################################
+# Test that the binned mode (NUM_THREADS) gives the same result as the
+# default mode
+
+
+@pytest.mark.parametrize("options",
+                         [[],
+                          ["ALL_TOUCHED"],
+                          ["MERGE_ALG=ADD"],
+                          ["MERGE_ALG=ADD", "ALL_TOUCHED"]])
+def test_rasterize_layers_num_threads(options):
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    data_source = ogr.GetDriverByName('MEMORY').CreateDataSource('')
+    layer = data_source.CreateLayer('', sr)
+    layer.CreateField(ogr.FieldDefn('val', ogr.OFTReal))
+    wkts = ['POLYGON((2 2,2 90,45 90,45 2,2 2))',
+            'POLYGON((30.5 10.2,80.3 60.7,20.1 95.5,30.5 10.2))',
+            'MULTIPOLYGON(((60 5,60 30,95 30,60 5)),((70 40,70 99,99 99,70 40)))',
+            'LINESTRING(0.5 0.5,99.5 99.5,50 20.3,10.7 70.2)',
+            'MULTILINESTRING((5 95,95 5),(10 50,90 50.5))',
+            'MULTIPOINT(1.5 1.5,50.5 50.5,98.5 3.5)',
+            'POLYGON((-20 -20,-20 -10,-10 -10,-20 -20))']
+    for i, wkt in enumerate(wkts):
+        feature = ogr.Feature(layer.GetLayerDefn())
+        feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        feature['val'] = i + 1
+        layer.CreateFeature(feature)
+
+    def rasterize(extra_options):
+        ds = gdal.GetDriverByName('MEM').Create('', 100, 100, 2,
+                                                gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 100, 0, -1])
+        ds.SetProjection(sr_wkt)
+        ds.GetRasterBand(1).Fill(1)
+        ds.GetRasterBand(2).Fill(2)
+        assert gdal.RasterizeLayer(ds, [1, 2], layer,
+                                   options=options + ['ATTRIBUTE=val'] +
+                                   extra_options) == 0
+        return ds.ReadRaster()
+
+    expected = rasterize(['CHUNKYSIZE=7'])
+    assert rasterize(['NUM_THREADS=1']) == expected
+    assert rasterize(['NUM_THREADS=1', 'CHUNKYSIZE=7']) == expected
+    assert rasterize(['NUM_THREADS=4']) == expected
+    assert rasterize(['NUM_THREADS=4', 'CHUNKYSIZE=3']) == expected
+    assert rasterize(['NUM_THREADS=ALL_CPUS', 'CHUNKYSIZE=1']) == expected
+
+###############################################################################
+# Test that errors of the binned mode (NUM_THREADS) are reported
+
+
+def test_rasterize_layers_num_threads_error():
+
+    data_source = ogr.GetDriverByName('MEMORY').CreateDataSource('')
+    layer = data_source.CreateLayer('')
+    feature = ogr.Feature(layer.GetLayerDefn())
+    feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(
+        'POLYGON((440720 3750120,440720 3751320,441920 3751320,441920 3750120,440720 3750120))'))
+    layer.CreateFeature(feature)
+
+    # Opened in read-only mode: writing the chunks fails.
+    ds = gdal.Open('../gcore/data/byte.tif')
+    gdal.ErrorReset()
+    with gdaltest.error_handler():
+        ret = gdal.RasterizeLayer(ds, [1], layer, burn_values=[1],
+                                  options=['NUM_THREADS=2', 'CHUNKYSIZE=5'])
+    assert ret != 0
+    assert 'read-only' in gdal.GetLastErrorMsg()
+
+###############################################################################
+# Test that an invalid NUM_THREADS value is ignored with a warning
+
+
+def test_rasterize_layers_num_threads_invalid():
+
+    data_source = ogr.GetDriverByName('MEMORY').CreateDataSource('')
+    layer = data_source.CreateLayer('')
+    feature = ogr.Feature(layer.GetLayerDefn())
+    feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(
+        'POLYGON((2 2,2 8,8 8,8 2,2 2))'))
+    layer.CreateFeature(feature)
+
+    ds = gdal.GetDriverByName('MEM').Create('', 10, 10)
+    ds.SetGeoTransform([0, 1, 0, 10, 0, -1])
+    gdal.ErrorReset()
+    with gdaltest.error_handler():
+        ret = gdal.RasterizeLayer(ds, [1], layer, burn_values=[1],
+                                  options=['NUM_THREADS=foo'])
+    assert ret == 0
+    assert gdal.GetLastErrorType() == gdal.CE_Warning
+    assert 'Invalid value for NUM_THREADS: foo' in gdal.GetLastErrorMsg()
+    assert sum(struct.unpack('B' * 100, ds.ReadRaster())) == 36
@@ -32,7 +32,10 @@
 
 
 
+import random
+
 from osgeo import gdal
+import gdaltest
 import pytest
 
 ###############################################################################
@@ -321,6 +324,77 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print('Got: ', cs)
         pytest.fail('got wrong checksum')
-    
 
+###############################################################################
+# Test that the tiled mode (NUM_THREADS) produces the same result as the
+# default mode
+
+
+# Strips of 1 and 3 lines, so that most polygons span several strips,
+# processed in the calling thread or by worker threads.
+@pytest.mark.parametrize("strip_height,num_threads", [('1', '4'),
+                                                      ('3', '1'),
+                                                      ('3', '4')])
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+@pytest.mark.parametrize("in_place", [False, True])
+def test_sieve_num_threads(connectedness, use_mask, in_place, strip_height,
+                           num_threads):
+
+    xsize = 47
+    ysize = 61
+    r = random.Random(connectedness)
+    data = bytes([r.choice([1, 2, 3]) for _ in range(xsize * ysize)])
+    mask = bytes([0 if r.random() < 0.1 else 255 for _ in range(xsize * ysize)])
+
+    def sieve(options):
+        src_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize)
+        src_ds.WriteRaster(0, 0, xsize, ysize, data)
+        src_band = src_ds.GetRasterBand(1)
+        mask_band = None
+        if use_mask:
+            src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+            mask_band = src_band.GetMaskBand()
+            mask_band.WriteRaster(0, 0, xsize, ysize, mask)
+        if in_place:
+            dst_ds = src_ds
+        else:
+            dst_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize)
+        dst_band = dst_ds.GetRasterBand(1)
+        assert gdal.SieveFilter(src_band, mask_band, dst_band, 5,
+                                connectedness, options=options) == 0
+        return dst_band.Checksum()
+
+    cs_expected = sieve([])
+
+    # Check that some polygons were actually sieved.
+    src_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize)
+    src_ds.WriteRaster(0, 0, xsize, ysize, data)
+    assert src_ds.GetRasterBand(1).Checksum() != cs_expected
+
+    with gdaltest.config_option('GDAL_SIEVE_STRIP_HEIGHT', strip_height):
+        cs = sieve(['NUM_THREADS=' + num_threads])
+
+    if cs != cs_expected:
+        print('Got: ', cs)
+        pytest.fail('got wrong checksum')
+
+###############################################################################
+# Test that errors of the strips processed by worker threads in the tiled
+# mode (NUM_THREADS) are reported
+
+
+def test_sieve_num_threads_error():
+
+    src_ds = gdal.Open('../gcore/data/byte_truncated.tif')
+    src_band = src_ds.GetRasterBand(1)
+    dst_ds = gdal.GetDriverByName('MEM').Create('', src_ds.RasterXSize,
+                                                src_ds.RasterYSize)
+    dst_band = dst_ds.GetRasterBand(1)
 
+    gdal.ErrorReset()
+    with gdaltest.config_option('GDAL_SIEVE_STRIP_HEIGHT', '5'):
+        with gdaltest.error_handler():
+            assert gdal.SieveFilter(src_band, None, dst_band, 5, 4,
+                                    options=['NUM_THREADS=2']) != 0
+    assert gdal.GetLastErrorType() == gdal.CE_Failure
@@ -37,6 +37,7 @@
 #include "cpl_string.h"
 #include "cpl_safemaths.hpp"
 #include "cpl_time.h"
+#include "cpl_vsi_virtual.h"
 #include "cpl_json.h"
 #include "cpl_json_streaming_parser.h"
 #include "cpl_json_streaming_writer.h"
@@ -46,8 +47,10 @@
 #include "cpl_minixml.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <atomic>
 #include <fstream>
 #include <string>
+#include <thread>
 
 static bool gbGotError = false;
 static void CPL_STDCALL myErrorHandler(CPLErr, CPLErrorNum, const char*)
@@ -2888,6 +2891,50 @@ namespace tut
                 ensure_equals(res[i], i + 1);
             }
         }
+
+        // Jobs that submit jobs and wait for them, with more outer jobs
+        // than worker threads. This would dead-lock if the waiting threads
+        // did not help running the pending jobs.
+        {
+            struct NestedJob
+            {
+                CPLWorkerThreadPool* poPool = nullptr;
+                std::vector<int> res{};
+            };
+
+            const auto outerJob = [](void* pData)
+            {
+                NestedJob* psJob = static_cast<NestedJob*>(pData);
+                const auto myJobLocal = [](void* pDataLocal)
+                {
+                    (*static_cast<int*>(pDataLocal))++;
+                };
+                auto jobQueue = psJob->poPool->CreateJobQueue();
+                for( size_t i = 0; i < psJob->res.size(); i++ )
+                {
+                    jobQueue->SubmitJob(myJobLocal, &psJob->res[i]);
+                }
+                jobQueue->WaitCompletion();
+            };
+
+            ensure( !oPool.IsCurrentThreadWorker() );
+            std::vector<NestedJob> asJobs(10);
+            auto jobQueue = oPool.CreateJobQueue();
+            for( auto& sJob: asJobs )
+            {
+                sJob.poPool = &oPool;
+                sJob.res.resize(100);
+                jobQueue->SubmitJob(outerJob, &sJob);
+            }
+            jobQueue->WaitCompletion();
+            for( const auto& sJob: asJobs )
+            {
+                for( int v: sJob.res )
+                {
+                    ensure_equals(v, 1);
+                }
+            }
+        }
     }
 
     // Test CPLHTTPFetch
@@ -3089,4 +3136,174 @@ namespace tut
         VSIUnlink("/vsimem/.gdal/gdalrc");
     }
 
+    // Check that concurrent VSIVirtualHandle::PRead() calls on fp return the
+    // nSize bytes of pabyExpected, and leave the file position unchanged.
+    static void CheckPRead( VSILFILE* fp, const GByte* pabyExpected,
+                            size_t nSize )
+    {
+        VSIVirtualHandle* poHandle = reinterpret_cast<VSIVirtualHandle*>(fp);
+        ensure( poHandle->HasPRead() );
+        ensure_equals( VSIFSeekL(fp, 10, SEEK_SET), 0 );
+
+        CPLWorkerThreadPool oPool;
+        ensure( oPool.Setup(4, nullptr, nullptr) );
+        struct Job
+        {
+            VSIVirtualHandle* poHandle;
+            const GByte* pabyExpected;
+            size_t nFileSize;
+            size_t nOffset;
+            bool bOK;
+        };
+        std::vector<Job> asJobs;
+        for( size_t nOffset = 0; nOffset < nSize + 100; nOffset += 97 )
+        {
+            Job sJob = { poHandle, pabyExpected, nSize, nOffset, false };
+            asJobs.push_back(sJob);
+        }
+        for( auto& sJob: asJobs )
+        {
+            oPool.SubmitJob([](void* pData)
+            {
+                Job* psJob = static_cast<Job*>(pData);
+                GByte abyBuffer[1000];
+                const size_t nRead = psJob->poHandle->PRead(
+                    abyBuffer, sizeof(abyBuffer), psJob->nOffset);
+                const size_t nExpected =
+                    psJob->nOffset >= psJob->nFileSize ? 0 :
+                    std::min(sizeof(abyBuffer),
+                             psJob->nFileSize - psJob->nOffset);
+                psJob->bOK = nRead == nExpected &&
+                    memcmp(abyBuffer, psJob->pabyExpected + psJob->nOffset,
+                           nRead) == 0;
+            }, &sJob);
+        }
+        oPool.WaitCompletion();
+        for( const auto& sJob: asJobs )
+            ensure( sJob.bOK );
+
+        // PRead() does not affect the current file position
+        ensure_equals( VSIFTellL(fp), static_cast<vsi_l_offset>(10) );
+    }
+
+    // Test VSIVirtualHandle::PRead()
+    template<>
+    template<>
+    void object::test<45>()
+    {
+        std::vector<GByte> abyData(100000);
+        for( size_t i = 0; i < abyData.size(); ++i )
+            abyData[i] = static_cast<GByte>(i * 7 + 3);
+
+        const char* pszFilename = "/vsimem/test_pread.bin";
+        VSILFILE* fp = VSIFOpenL(pszFilename, "wb");
+        ensure( fp != nullptr );
+        ensure_equals( VSIFWriteL(abyData.data(), 1, abyData.size(), fp),
+                       abyData.size() );
+        VSIFCloseL(fp);
+
+        for( const char* pszName : { pszFilename,
+                        "/vsisubfile/1000_5000,/vsimem/test_pread.bin" } )
+        {
+            const size_t nStart = strstr(pszName, "/vsisubfile/") ? 1000 : 0;
+            const size_t nSize = nStart ? 5000 : abyData.size();
+
+            fp = VSIFOpenL(pszName, "rb");
+            ensure( fp != nullptr );
+            CheckPRead(fp, abyData.data() + nStart, nSize);
+            VSIFCloseL(fp);
+        }
+
+        // Unix stdio: pread() on a read-only handle
+#ifndef WIN32
+        CPLString osTmpFilename(CPLGenerateTempFilename("test_pread"));
+        ensure_equals( CPLCopyFile(osTmpFilename, pszFilename), 0 );
+        fp = VSIFOpenL(osTmpFilename, "rb");
+        ensure( fp != nullptr );
+        CheckPRead(fp, abyData.data(), abyData.size());
+        VSIFCloseL(fp);
+        VSIUnlink(osTmpFilename);
+#endif
+
+        VSIUnlink(pszFilename);
+    }
+
+    // Stress CPLWorkerThreadPool with jobs submitted concurrently from
+    // worker threads and from outside, while other threads wait
+    template<>
+    template<>
+    void object::test<46>()
+    {
+        CPLWorkerThreadPool oPool;
+        ensure( oPool.Setup(4, nullptr, nullptr) );
+
+        struct Context
+        {
+            CPLWorkerThreadPool* poPool;
+            std::atomic<int>     nCounter;
+        };
+        Context sContext;
+        sContext.poPool = &oPool;
+        sContext.nCounter = 0;
+
+        constexpr int nExternalThreads = 3;
+        constexpr int nRounds = 50;
+        constexpr int nJobsPerRound = 40;
+
+        const auto childJob = [](void* pData)
+        {
+            static_cast<Context*>(pData)->nCounter++;
+        };
+        const auto parentJob = [](void* pData)
+        {
+            Context* psContext = static_cast<Context*>(pData);
+            psContext->nCounter++;
+            // Queued to the deque of the current worker thread.
+            psContext->poPool->SubmitJob(
+                [](void* pDataChild)
+                {
+                    static_cast<Context*>(pDataChild)->nCounter++;
+                }, pData);
+        };
+
+        std::vector<std::thread> aoThreads;
+        for( int iThread = 0; iThread < nExternalThreads; ++iThread )
+        {
+            aoThreads.emplace_back([&sContext, &oPool, childJob, parentJob]()
+            {
+                for( int iRound = 0; iRound < nRounds; ++iRound )
+                {
+                    auto poQueue = oPool.CreateJobQueue();
+                    for( int i = 0; i < nJobsPerRound; ++i )
+                    {
+                        poQueue->SubmitJob(
+                            (i % 2) ? childJob : parentJob, &sContext);
+                    }
+                    poQueue->WaitCompletion();
+                }
+            });
+        }
+        // Another thread only waits, so that the pool is regularly drained
+        // and worker threads go to sleep and are woken up again.
+        std::atomic<bool> bStop{false};
+        std::thread oWaiter([&oPool, &bStop]()
+        {
+            while( !bStop )
+            {
+                oPool.WaitEvent();
+                std::this_thread::yield();
+            }
+        });
+
+        for( auto& oThread: aoThreads )
+            oThread.join();
+        oPool.WaitCompletion();
+        bStop = true;
+        oWaiter.join();
+
+        // Each parent job counts twice (itself and its child).
+        ensure_equals( sContext.nCounter.load(),
+                       nExternalThreads * nRounds * nJobsPerRound * 3 / 2 );
+    }
+
 } // namespace tut
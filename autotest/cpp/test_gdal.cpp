@@ -31,8 +31,11 @@
 #include "gdal.h"
 #include "tilematrixset.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "test_data.h"
 
@@ -1676,4 +1679,102 @@ namespace tut
         poDS.reset();
         VSIUnlink("/vsimem/tmp.pix");
     }
+
+    // Test filling the (sharded) block cache from several threads, and that
+    // evicted dirty blocks are written back
+    template<> template<> void object::test<22>()
+    {
+        GDALDriver* poDriver = GDALDriver::FromHandle(
+            GDALGetDriverByName("GTiff"));
+        if( poDriver == nullptr )
+        {
+            fail("GTiff driver missing");
+            return;
+        }
+        constexpr int nThreads = 4;
+        constexpr int nSize = 512;
+        constexpr int nBlockSize = 64;
+        constexpr int nBlocksPerRow = nSize / nBlockSize;
+        const GIntBig nOldCacheMax = GDALGetCacheMax64();
+        // Much smaller than the 4 * 256 KB of the datasets.
+        const GIntBig nCacheMax = 100 * 1024;
+        GDALSetCacheMax64(nCacheMax);
+
+        const char* const apszOptions[] = {
+            "TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64", nullptr };
+        std::vector<GDALDataset*> apoDS;
+        for( int iThread = 0; iThread < nThreads; ++iThread )
+        {
+            apoDS.push_back(poDriver->Create(
+                CPLSPrintf("/vsimem/test_gdal_22_%d.tif", iThread),
+                nSize, nSize, 1, GDT_Byte,
+                const_cast<char**>(apszOptions)));
+            ensure( apoDS.back() != nullptr );
+        }
+
+        std::vector<GIntBig> anMaxCacheUsed(nThreads);
+        std::vector<std::thread> aoThreads;
+        for( int iThread = 0; iThread < nThreads; ++iThread )
+        {
+            aoThreads.emplace_back([iThread, &apoDS, &anMaxCacheUsed]()
+            {
+                GDALRasterBand* poBand = apoDS[iThread]->GetRasterBand(1);
+                for( int iY = 0; iY < nBlocksPerRow; ++iY )
+                {
+                    for( int iX = 0; iX < nBlocksPerRow; ++iX )
+                    {
+                        GDALRasterBlock* poBlock =
+                            poBand->GetLockedBlockRef(iX, iY, TRUE);
+                        if( poBlock == nullptr )
+                            continue;
+                        memset(poBlock->GetDataRef(),
+                               (iThread + iY * nBlocksPerRow + iX) % 256,
+                               nBlockSize * nBlockSize);
+                        poBlock->MarkDirty();
+                        poBlock->DropLock();
+                        anMaxCacheUsed[iThread] = std::max(
+                            anMaxCacheUsed[iThread], GDALGetCacheUsed64());
+                    }
+                }
+            });
+        }
+        for( auto& oThread: aoThreads )
+            oThread.join();
+
+        // Each thread may temporarily exceed the limit by the block it is
+        // internalizing.
+        for( int iThread = 0; iThread < nThreads; ++iThread )
+        {
+            ensure( anMaxCacheUsed[iThread] <=
+                        nCacheMax + nThreads * nBlockSize * nBlockSize );
+        }
+        ensure( GDALGetCacheUsed64() <= nCacheMax );
+
+        for( auto poDS: apoDS )
+            GDALClose(poDS);
+        GDALSetCacheMax64(nOldCacheMax);
+
+        for( int iThread = 0; iThread < nThreads; ++iThread )
+        {
+            const char* pszFilename =
+                CPLSPrintf("/vsimem/test_gdal_22_%d.tif", iThread);
+            GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+            ensure( poDS != nullptr );
+            std::vector<GByte> abyBlock(nBlockSize * nBlockSize);
+            for( int iY = 0; iY < nBlocksPerRow; ++iY )
+            {
+                for( int iX = 0; iX < nBlocksPerRow; ++iX )
+                {
+                    ensure_equals( poDS->GetRasterBand(1)->ReadBlock(
+                        iX, iY, abyBlock.data()), CE_None );
+                    const GByte byExpected = static_cast<GByte>(
+                        (iThread + iY * nBlocksPerRow + iX) % 256);
+                    ensure_equals( abyBlock.front(), byExpected );
+                    ensure_equals( abyBlock.back(), byExpected );
+                }
+            }
+            poDS.reset();
+            VSIUnlink(pszFilename);
+        }
+    }
 } // namespace tut
@@ -439,6 +439,28 @@ namespace tut
                 equal_linestrings( w.polygons_[5.0][0][1], w.polygons_[7.0][0][0] ) );
 
     }
-}
-
 
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        // A ring touching its exterior ring at one of its vertices must be
+        // an interior ring whatever its starting vertex. This matters for
+        // NUM_THREADS, where rings merged across strips may start at any vertex.
+        for ( int startOnBoundary = 0; startOnBoundary < 2; startOnBoundary++ )
+        {
+            TestPolygonWriter w;
+            {
+                PolygonRingAppender<TestPolygonWriter> appender( w );
+                LineString outer = { Point( 0, 0 ), Point( 4, 0 ), Point( 4, 4 ), Point( 0, 4 ), Point( 0, 0 ) };
+                LineString inner = startOnBoundary ?
+                    LineString{ Point( 4, 2 ), Point( 2, 1 ), Point( 2, 3 ), Point( 4, 2 ) } :
+                    LineString{ Point( 2, 1 ), Point( 2, 3 ), Point( 4, 2 ), Point( 2, 1 ) };
+                appender.addLine( 1.0, outer, true );
+                appender.addLine( 1.0, inner, true );
+            }
+            ensure_equals( w.polygons_[1.0].size(), 1U );
+            ensure_equals( w.polygons_[1.0][0].size(), 2U );
+        }
+    }
+}
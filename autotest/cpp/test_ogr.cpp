@@ -26,10 +26,13 @@
 #include "gdal_unit_test.h"
 
 #include "ogr_p.h"
+#include "ogr_recordbatch.h"
 #include "ogrsf_frmts.h"
 #include "../../gdal/ogr/ogrsf_frmts/osm/gpb.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace tut
 {
@@ -1877,4 +1880,392 @@ namespace tut
         }
     }
 
+    // Test OGRLayer::GetArrowStream()
+    template<>
+    template<>
+    void object::test<21>()
+    {
+        std::unique_ptr<GDALDataset> poDS(
+            GetGDALDriverManager()->GetDriverByName("Memory")->
+                Create("", 0, 0, 0, GDT_Unknown, nullptr));
+        auto poLayer = poDS->CreateLayer("test", nullptr, wkbPoint);
+        {
+            OGRFieldDefn oFieldInt("int", OFTInteger);
+            poLayer->CreateField(&oFieldInt);
+            OGRFieldDefn oFieldReal("real", OFTReal);
+            poLayer->CreateField(&oFieldReal);
+            OGRFieldDefn oFieldStr("str", OFTString);
+            poLayer->CreateField(&oFieldStr);
+            OGRFieldDefn oFieldDate("date", OFTDate);
+            poLayer->CreateField(&oFieldDate);
+        }
+        for( int i = 0; i < 3; i++ )
+        {
+            OGRFeature oFeature(poLayer->GetLayerDefn());
+            oFeature.SetField(0, 10 + i);
+            oFeature.SetField(1, 1.5 * i);
+            if( i != 1 )
+            {
+                oFeature.SetField(2, i == 0 ? "foo" : "barbaz");
+                oFeature.SetGeometryDirectly(new OGRPoint(i, 2 * i));
+            }
+            oFeature.SetField(3, 1970, 1, 2 + i);
+            ensure_equals( poLayer->CreateFeature(&oFeature), OGRERR_NONE );
+        }
+
+        struct ArrowArrayStream stream;
+        {
+            const char* const apszInvalidOptions[] =
+                { "MAX_FEATURES_IN_BATCH=0", nullptr };
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            ensure( !poLayer->GetArrowStream(&stream, apszInvalidOptions) );
+            CPLPopErrorHandler();
+        }
+
+        const char* const apszOptions[] = { "MAX_FEATURES_IN_BATCH=2",
+                                            nullptr };
+        ensure( poLayer->GetArrowStream(&stream, apszOptions) );
+
+        struct ArrowSchema schema;
+        ensure_equals( stream.get_schema(&stream, &schema), 0 );
+        ensure_equals( std::string(schema.format), "+s" );
+        ensure_equals( schema.n_children, 6 );
+        const char* const apszFormats[] = { "l", "i", "g", "u", "tdD", "z" };
+        for( int i = 0; i < 6; i++ )
+            ensure_equals( std::string(schema.children[i]->format),
+                           apszFormats[i] );
+        ensure_equals( std::string(schema.children[0]->name), "OGC_FID" );
+        ensure_equals( std::string(schema.children[3]->name), "str" );
+        schema.release(&schema);
+        ensure( schema.release == nullptr );
+
+        struct ArrowArray array;
+        ensure_equals( stream.get_next(&stream, &array), 0 );
+        ensure( array.release != nullptr );
+        ensure_equals( array.length, 2 );
+        ensure_equals( array.n_children, 6 );
+        {
+            const int32_t* panInt = static_cast<const int32_t*>(
+                array.children[1]->buffers[1]);
+            ensure_equals( panInt[0], 10 );
+            ensure_equals( panInt[1], 11 );
+
+            // Second string is null
+            const auto psStr = array.children[3];
+            ensure_equals( psStr->null_count, 1 );
+            const GByte* pabyValidity =
+                static_cast<const GByte*>(psStr->buffers[0]);
+            ensure_equals( pabyValidity[0] & 3, 1 );
+            const int32_t* panOffsets =
+                static_cast<const int32_t*>(psStr->buffers[1]);
+            ensure_equals( panOffsets[0], 0 );
+            ensure_equals( panOffsets[1], 3 );
+            ensure_equals( panOffsets[2], 3 );
+            ensure_equals( std::string(static_cast<const char*>(
+                                psStr->buffers[2]), 3), "foo" );
+
+            // Days since epoch
+            const int32_t* panDate = static_cast<const int32_t*>(
+                array.children[4]->buffers[1]);
+            ensure_equals( panDate[0], 1 );
+            ensure_equals( panDate[1], 2 );
+
+            // Second geometry is null, first one is a WKB point
+            const auto psGeom = array.children[5];
+            ensure_equals( psGeom->null_count, 1 );
+            const int32_t* panGeomOffsets =
+                static_cast<const int32_t*>(psGeom->buffers[1]);
+            ensure_equals( panGeomOffsets[1], 21 );
+            ensure_equals( panGeomOffsets[2], 21 );
+        }
+        array.release(&array);
+        ensure( array.release == nullptr );
+
+        ensure_equals( stream.get_next(&stream, &array), 0 );
+        ensure_equals( array.length, 1 );
+        {
+            const int64_t* panFID = static_cast<const int64_t*>(
+                array.children[0]->buffers[1]);
+            ensure_equals( panFID[0], 2 );
+            const double* padfReal = static_cast<const double*>(
+                array.children[2]->buffers[1]);
+            ensure_equals( padfReal[0], 3.0 );
+            const auto psStr = array.children[3];
+            ensure_equals( psStr->null_count, 0 );
+            ensure( psStr->buffers[0] == nullptr );
+            ensure_equals( std::string(static_cast<const char*>(
+                                psStr->buffers[2]), 6), "barbaz" );
+        }
+        array.release(&array);
+
+        // End of stream
+        ensure_equals( stream.get_next(&stream, &array), 0 );
+        ensure( array.release == nullptr );
+
+        stream.release(&stream);
+        ensure( stream.release == nullptr );
+
+        // Ignored fields are not exported
+        const char* apszIgnored[] = { "real", "OGR_GEOMETRY", nullptr };
+        ensure_equals( poLayer->SetIgnoredFields(apszIgnored), OGRERR_NONE );
+        const char* const apszNoFIDOptions[] = { "INCLUDE_FID=NO", nullptr };
+        ensure( poLayer->GetArrowStream(&stream, apszNoFIDOptions) );
+        ensure_equals( stream.get_schema(&stream, &schema), 0 );
+        ensure_equals( schema.n_children, 3 );
+        ensure_equals( std::string(schema.children[0]->name), "int" );
+        schema.release(&schema);
+        ensure_equals( stream.get_next(&stream, &array), 0 );
+        ensure_equals( array.length, 3 );
+        ensure_equals( array.n_children, 3 );
+        array.release(&array);
+        stream.release(&stream);
+    }
+
+    // Whether row iRow of an Arrow array is not null
+    static bool IsArrowRowValid( const struct ArrowArray* psArray,
+                                 int64_t iRow )
+    {
+        const GByte* pabyValidity =
+            static_cast<const GByte*>(psArray->buffers[0]);
+        return pabyValidity == nullptr ||
+               ((pabyValidity[iRow / 8] >> (iRow % 8)) & 1) != 0;
+    }
+
+    // Check that two Arrow arrays of the same schema hold the same values
+    static void CheckSameArrowArrays( const struct ArrowSchema* psSchema,
+                                      const struct ArrowArray* psA,
+                                      const struct ArrowArray* psB )
+    {
+        const std::string osFormat(psSchema->format);
+        const std::string osName(psSchema->name ? psSchema->name : "");
+        ensure_equals( osName.c_str(), psA->length, psB->length );
+        ensure_equals( osName.c_str(), psA->null_count, psB->null_count );
+        ensure_equals( osName.c_str(), psA->n_children, psB->n_children );
+        if( osFormat == "+s" )
+        {
+            for( int64_t i = 0; i < psA->n_children; ++i )
+            {
+                CheckSameArrowArrays(psSchema->children[i],
+                                     psA->children[i], psB->children[i]);
+            }
+            return;
+        }
+
+        size_t nValueSize = 0;
+        if( osFormat == "s" )
+            nValueSize = 2;
+        else if( osFormat == "i" || osFormat == "f" ||
+                 osFormat == "tdD" || osFormat == "ttm" )
+            nValueSize = 4;
+        else if( osFormat == "l" || osFormat == "g" ||
+                 osFormat.compare(0, 4, "tsm:") == 0 )
+            nValueSize = 8;
+
+        const GByte* pabyA = static_cast<const GByte*>(psA->buffers[1]);
+        const GByte* pabyB = static_cast<const GByte*>(psB->buffers[1]);
+        const int32_t* panOffsetsA = reinterpret_cast<const int32_t*>(pabyA);
+        const int32_t* panOffsetsB = reinterpret_cast<const int32_t*>(pabyB);
+        for( int64_t i = 0; i < psA->length; ++i )
+        {
+            const bool bValid = IsArrowRowValid(psA, i);
+            ensure_equals( osName.c_str(), bValid, IsArrowRowValid(psB, i) );
+            if( !bValid )
+                continue;
+            if( osFormat == "b" )
+            {
+                ensure_equals( osName.c_str(),
+                               (pabyA[i / 8] >> (i % 8)) & 1,
+                               (pabyB[i / 8] >> (i % 8)) & 1 );
+            }
+            else if( osFormat == "u" || osFormat == "z" )
+            {
+                const std::string osA(
+                    static_cast<const char*>(psA->buffers[2]) +
+                        panOffsetsA[i],
+                    panOffsetsA[i + 1] - panOffsetsA[i]);
+                const std::string osB(
+                    static_cast<const char*>(psB->buffers[2]) +
+                        panOffsetsB[i],
+                    panOffsetsB[i + 1] - panOffsetsB[i]);
+                ensure_equals( osName.c_str(), osA, osB );
+            }
+            else if( osFormat == "+l" )
+            {
+                ensure_equals( osName.c_str(), panOffsetsA[i + 1],
+                               panOffsetsB[i + 1] );
+            }
+            else
+            {
+                ensure( osName.c_str(), nValueSize != 0 );
+                ensure( osName.c_str(),
+                        memcmp(pabyA + i * nValueSize,
+                               pabyB + i * nValueSize, nValueSize) == 0 );
+            }
+        }
+        if( osFormat == "+l" )
+        {
+            CheckSameArrowArrays(psSchema->children[0],
+                                 psA->children[0], psB->children[0]);
+        }
+    }
+
+    // Check that the GetNextArrowArray() fast path of the first layer of
+    // pszFilename returns the same content as the generic implementation.
+    static void CheckArrowFastPath( const char* pszFilename,
+                                    const char* pszExpectedDateTimeFormat )
+    {
+        GDALDatasetUniquePtr poDS(
+            GDALDataset::Open(pszFilename, GDAL_OF_VECTOR));
+        ensure( pszFilename, poDS != nullptr );
+        OGRLayer* poLayer = poDS->GetLayer(0);
+        ensure( pszFilename,
+                poLayer->TestCapability(OLCFastGetArrowStream) != FALSE );
+
+        const char* const apszOptions[] = { "MAX_FEATURES_IN_BATCH=2",
+                                            nullptr };
+        std::vector<struct ArrowArray> asArrays[2];
+        struct ArrowSchema sSchema;
+        for( int iPass = 0; iPass < 2; ++iPass )
+        {
+            struct ArrowArrayStream sStream;
+            ensure( poLayer->GetArrowStream(&sStream, apszOptions) );
+            if( iPass == 0 )
+                ensure_equals( sStream.get_schema(&sStream, &sSchema), 0 );
+            while( true )
+            {
+                struct ArrowArray sArray;
+                // First pass: fast path, second pass: generic implementation
+                ensure_equals( iPass == 0 ?
+                    sStream.get_next(&sStream, &sArray) :
+                    poLayer->OGRLayer::GetNextArrowArray(&sStream, &sArray),
+                    0 );
+                if( sArray.release == nullptr )
+                    break;
+                asArrays[iPass].push_back(sArray);
+            }
+            sStream.release(&sStream);
+        }
+
+        for( int64_t i = 0; i < sSchema.n_children; ++i )
+        {
+            if( strcmp(sSchema.children[i]->name, "datetime") == 0 )
+            {
+                ensure_equals( pszFilename,
+                               std::string(sSchema.children[i]->format),
+                               pszExpectedDateTimeFormat );
+            }
+        }
+        ensure_equals( pszFilename, asArrays[0].size(), asArrays[1].size() );
+        ensure( pszFilename, !asArrays[0].empty() );
+        for( size_t i = 0; i < asArrays[0].size(); ++i )
+            CheckSameArrowArrays(&sSchema, &asArrays[0][i], &asArrays[1][i]);
+
+        for( auto& asPassArrays: asArrays )
+        {
+            for( auto& sArray: asPassArrays )
+                sArray.release(&sArray);
+        }
+        sSchema.release(&sSchema);
+
+        // Only UTC and unknown are valid TIMEZONE values
+        const char* const apszInvalidOptions[] = { "TIMEZONE=+01:00",
+                                                   nullptr };
+        struct ArrowArrayStream sStream;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        ensure( !poLayer->GetArrowStream(&sStream, apszInvalidOptions) );
+        CPLPopErrorHandler();
+    }
+
+    // Test that the GetNextArrowArray() fast paths of the GPKG, FlatGeobuf
+    // and Shapefile drivers match the generic implementation
+    template<>
+    template<>
+    void object::test<22>()
+    {
+        const struct
+        {
+            const char* pszDriver;
+            const char* pszFilename;
+            const char* pszDateTimeFormat;
+        } asDrivers[] = {
+            { "GPKG", "/vsimem/test_arrow.gpkg", "tsm:UTC" },
+            { "FlatGeobuf", "/vsimem/test_arrow.fgb", "tsm:" },
+            { "ESRI Shapefile", "/vsimem/test_arrow.shp", nullptr },
+        };
+        for( const auto& sDriver: asDrivers )
+        {
+            GDALDriver* poDriver =
+                GetGDALDriverManager()->GetDriverByName(sDriver.pszDriver);
+            if( poDriver == nullptr )
+                continue;
+            const bool bIsShape = sDriver.pszDateTimeFormat == nullptr;
+            {
+                GDALDatasetUniquePtr poDS(poDriver->Create(
+                    sDriver.pszFilename, 0, 0, 0, GDT_Unknown, nullptr));
+                ensure( sDriver.pszDriver, poDS != nullptr );
+                auto poLayer = poDS->CreateLayer("test", nullptr, wkbPoint);
+                ensure( sDriver.pszDriver, poLayer != nullptr );
+
+                OGRFieldDefn oFieldInt("int", OFTInteger);
+                ensure_equals( poLayer->CreateField(&oFieldInt),
+                               OGRERR_NONE );
+                OGRFieldDefn oFieldInt64("int64", OFTInteger64);
+                ensure_equals( poLayer->CreateField(&oFieldInt64),
+                               OGRERR_NONE );
+                OGRFieldDefn oFieldReal("real", OFTReal);
+                ensure_equals( poLayer->CreateField(&oFieldReal),
+                               OGRERR_NONE );
+                OGRFieldDefn oFieldStr("str", OFTString);
+                ensure_equals( poLayer->CreateField(&oFieldStr),
+                               OGRERR_NONE );
+                OGRFieldDefn oFieldDate("date", OFTDate);
+                ensure_equals( poLayer->CreateField(&oFieldDate),
+                               OGRERR_NONE );
+                if( !bIsShape )
+                {
+                    OGRFieldDefn oFieldDateTime("datetime", OFTDateTime);
+                    ensure_equals( poLayer->CreateField(&oFieldDateTime),
+                                   OGRERR_NONE );
+                    OGRFieldDefn oFieldBinary("binary", OFTBinary);
+                    ensure_equals( poLayer->CreateField(&oFieldBinary),
+                                   OGRERR_NONE );
+                }
+
+                for( int i = 0; i < 5; ++i )
+                {
+                    OGRFeature oFeature(poLayer->GetLayerDefn());
+                    // The fourth feature only has null fields and geometry
+                    if( i != 3 )
+                    {
+                        oFeature.SetField("int", -10 + i);
+                        oFeature.SetField("int64",
+                                          static_cast<GIntBig>(i) << 40);
+                        oFeature.SetField("real", 1.25 * i);
+                        oFeature.SetField("str", std::string(i, 'x').c_str());
+                        oFeature.SetField("date", 2021, 1 + i, 10 + i);
+                        oFeature.SetGeometryDirectly(new OGRPoint(i, -i));
+                        if( !bIsShape )
+                        {
+                            // Time zones: unknown, UTC, and UTC+02:00
+                            oFeature.SetField("datetime", 2021, 6, 1 + i,
+                                              12, 34, 56.5f,
+                                              i == 0 ? 0 : i == 1 ? 100 : 108);
+                            const GByte abyData[] = { 0, 1, 2, 3 };
+                            oFeature.SetField(
+                                oFeature.GetFieldIndex("binary"), i,
+                                abyData);
+                        }
+                    }
+                    ensure_equals( poLayer->CreateFeature(&oFeature),
+                                   OGRERR_NONE );
+                }
+            }
+
+            CheckArrowFastPath(sDriver.pszFilename, sDriver.pszDateTimeFormat ?
+                                    sDriver.pszDateTimeFormat : "");
+
+            poDriver->Delete(sDriver.pszFilename);
+        }
+    }
+
 } // namespace tut
@@ -33,7 +33,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace tut
 {
@@ -256,4 +258,279 @@ namespace tut
         ensure_approx_equals( y, 200.0 );
     }
 
+    // Compare the result of a transformation with and without the fast paths
+    static void check_fast_path(int nSrcEPSG, int nDstEPSG,
+                                OSRAxisMappingStrategy eStrategy,
+                                const std::vector<double>& adfX,
+                                const std::vector<double>& adfY,
+                                double dfTolerance)
+    {
+        OGRSpatialReference oSrc;
+        OGRSpatialReference oDst;
+        ensure_equals( oSrc.importFromEPSG(nSrcEPSG), OGRERR_NONE );
+        ensure_equals( oDst.importFromEPSG(nDstEPSG), OGRERR_NONE );
+        oSrc.SetAxisMappingStrategy(eStrategy);
+        oDst.SetAxisMappingStrategy(eStrategy);
+
+        std::vector<double> adfXRef(adfX);
+        std::vector<double> adfYRef(adfY);
+        std::vector<int> anErrorsRef(adfX.size());
+        {
+            CPLConfigOptionSetter oSetter("OGR_CT_USE_FAST_PATH", "NO", false);
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oSrc, &oDst));
+            ensure( poCT != nullptr );
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            poCT->TransformWithErrorCodes(static_cast<int>(adfX.size()),
+                                          adfXRef.data(), adfYRef.data(),
+                                          nullptr, nullptr,
+                                          anErrorsRef.data());
+        }
+
+        std::vector<double> adfXFast(adfX);
+        std::vector<double> adfYFast(adfY);
+        std::vector<int> anErrorsFast(adfX.size());
+        {
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oSrc, &oDst));
+            ensure( poCT != nullptr );
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            poCT->TransformWithErrorCodes(static_cast<int>(adfX.size()),
+                                          adfXFast.data(), adfYFast.data(),
+                                          nullptr, nullptr,
+                                          anErrorsFast.data());
+        }
+
+        for( size_t i = 0; i < adfX.size(); i++ )
+        {
+            ensure_equals( anErrorsFast[i] == 0, anErrorsRef[i] == 0 );
+            if( anErrorsRef[i] == 0 )
+            {
+                ensure( std::fabs(adfXFast[i] - adfXRef[i]) <= dfTolerance );
+                ensure( std::fabs(adfYFast[i] - adfYRef[i]) <= dfTolerance );
+            }
+        }
+    }
+
+    // Test the Transverse Mercator fast path
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        std::vector<double> adfLon;
+        std::vector<double> adfLat;
+        for( double lat = -80; lat <= 84; lat += 4 )
+        {
+            for( double lon = -20; lon <= 26; lon += 2 )
+            {
+                adfLon.push_back(lon);
+                adfLat.push_back(lat);
+            }
+        }
+        // WGS 84 -> WGS 84 / UTM zone 31N
+        check_fast_path(4326, 32631, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-6);
+        // Same with latitude, longitude order
+        check_fast_path(4326, 32631, OAMS_AUTHORITY_COMPLIANT,
+                        adfLat, adfLon, 1e-6);
+        // ETRS89 -> ETRS89 / UTM zone 32N
+        check_fast_path(4258, 25832, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-6);
+        // OSGB36 -> British National Grid (non-zero latitude of origin)
+        check_fast_path(4277, 27700, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-6);
+
+        std::vector<double> adfE;
+        std::vector<double> adfN;
+        for( double n = -9e6; n <= 9e6; n += 5e5 )
+        {
+            for( double e = -5e5; e <= 1.5e6; e += 1e5 )
+            {
+                adfE.push_back(e);
+                adfN.push_back(n);
+            }
+        }
+        // Inverse direction
+        check_fast_path(32631, 4326, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfE, adfN, 1e-10);
+        check_fast_path(32631, 4326, OAMS_AUTHORITY_COMPLIANT,
+                        adfE, adfN, 1e-10);
+        check_fast_path(27700, 4277, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfE, adfN, 1e-10);
+    }
+
+    // Test the WGS84 to WebMercator fast path
+    template<>
+    template<>
+    void object::test<7>()
+    {
+        std::vector<double> adfLon;
+        std::vector<double> adfLat;
+        for( double lat = -90; lat <= 90; lat += 5 )
+        {
+            for( double lon = -360; lon <= 360; lon += 15 )
+            {
+                adfLon.push_back(lon);
+                adfLat.push_back(lat);
+            }
+        }
+        check_fast_path(4326, 3857, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-6);
+        check_fast_path(4326, 3857, OAMS_AUTHORITY_COMPLIANT,
+                        adfLat, adfLon, 1e-6);
+    }
+
+    // Test OGRCoordinateTransformation::TransformBounds()
+    template<>
+    template<>
+    void object::test<8>()
+    {
+        OGRSpatialReference oWGS84;
+        oWGS84.importFromEPSG(4326);
+        oWGS84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+        // Simple case
+        {
+            OGRSpatialReference oUTM;
+            oUTM.importFromEPSG(32631);
+            oUTM.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oUTM, &oWGS84));
+            ensure( poCT != nullptr );
+            double xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+            ensure( poCT->TransformBounds(400000, 5000000, 600000, 5200000,
+                                          &xmin, &ymin, &xmax, &ymax, 21) );
+            ensure( xmin < 1.8 && xmin > 1.6 );
+            ensure( xmax > 4.3 && xmax < 4.4 );
+            ensure( ymin > 45.1 && ymin < 45.2 );
+            ensure( ymax > 46.9 && ymax < 47.0 );
+        }
+
+        // Result crossing the antimeridian
+        {
+            OGRSpatialReference oUTM;
+            oUTM.importFromEPSG(32660);
+            oUTM.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oUTM, &oWGS84));
+            ensure( poCT != nullptr );
+            double xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+            ensure( poCT->TransformBounds(500000, -5000000, 1200000, 0,
+                                          &xmin, &ymin, &xmax, &ymax, 21) );
+            ensure( xmin > 170 && xmin < 180 );
+            ensure( xmax > -180 && xmax < -170 );
+        }
+
+        // Source bounds containing the north pole
+        {
+            OGRSpatialReference oPolar;
+            oPolar.importFromEPSG(3413);
+            oPolar.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oPolar, &oWGS84));
+            ensure( poCT != nullptr );
+            double xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+            ensure( poCT->TransformBounds(-1000000, -1000000, 1000000, 1000000,
+                                          &xmin, &ymin, &xmax, &ymax, 21) );
+            ensure_approx_equals( xmin, -180.0 );
+            ensure_approx_equals( xmax, 180.0 );
+            ensure_approx_equals( ymax, 90.0 );
+            ensure( ymin > 70 && ymin < 85 );
+        }
+
+        // Invalid bounds
+        {
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oWGS84, &oWGS84));
+            ensure( poCT != nullptr );
+            double xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            ensure( !poCT->TransformBounds(10, 0, 0, 10,
+                                           &xmin, &ymin, &xmax, &ymax, 21) );
+        }
+    }
+
+    // Test that the Transverse Mercator fast path is not used when PROJ would
+    // not use a projection-only pipeline, and that the OSR_USE_APPROX_TMERC
+    // setting is taken into account by the transformation cache
+    template<>
+    template<>
+    void object::test<9>()
+    {
+        std::vector<double> adfLon;
+        std::vector<double> adfLat;
+        for( double lat = 0; lat <= 80; lat += 8 )
+        {
+            for( double lon = -10; lon <= 16; lon += 2 )
+            {
+                adfLon.push_back(lon);
+                adfLat.push_back(lat);
+            }
+        }
+        // NAD27 -> WGS 84 / UTM zone 31N involves a datum transformation
+        check_fast_path(4267, 32631, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-6);
+        // WGS 84 / UTM zone 31N -> ETRS89 involves a datum transformation
+        check_fast_path(32631, 4258, OAMS_TRADITIONAL_GIS_ORDER,
+                        {400000, 500000, 600000}, {4000000, 5000000, 6000000},
+                        1e-10);
+
+        OGRSpatialReference oWGS84;
+        oWGS84.importFromEPSG(4326);
+        oWGS84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        OGRSpatialReference oUTM;
+        oUTM.importFromEPSG(32631);
+        oUTM.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+        // Far from the central meridian, the approximate algorithm differs
+        // from the exact one.
+        double xExact = 40;
+        double yExact = 45;
+        {
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oWGS84, &oUTM));
+            ensure( poCT != nullptr );
+            ensure( poCT->Transform(1, &xExact, &yExact) );
+        }
+        double xApprox = 40;
+        double yApprox = 45;
+        {
+            CPLConfigOptionSetter oSetter("OSR_USE_APPROX_TMERC", "YES", false);
+            auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+                OGRCreateCoordinateTransformation(&oWGS84, &oUTM));
+            ensure( poCT != nullptr );
+            ensure( poCT->Transform(1, &xApprox, &yApprox) );
+        }
+        ensure( std::fabs(xExact - xApprox) > 1e-3 ||
+                std::fabs(yExact - yApprox) > 1e-3 );
+    }
+
+    // Test that the batched PROJ calls give the same results as the
+    // transformation of each point, including for failing points
+    template<>
+    template<>
+    void object::test<10>()
+    {
+        std::vector<double> adfLon;
+        std::vector<double> adfLat;
+        for( double lat = -90; lat <= 90; lat += 10 )
+        {
+            for( double lon = -180; lon <= 180; lon += 20 )
+            {
+                adfLon.push_back(lon);
+                adfLat.push_back(lat);
+            }
+        }
+        adfLon.push_back(std::numeric_limits<double>::quiet_NaN());
+        adfLat.push_back(0);
+        // WGS 84 -> World Mercator: invalid at the poles
+        check_fast_path(4326, 3395, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-9);
+        check_fast_path(4326, 3395, OAMS_AUTHORITY_COMPLIANT,
+                        adfLat, adfLon, 1e-9);
+        // WGS 84 -> RGF93 / Lambert-93
+        check_fast_path(4326, 2154, OAMS_TRADITIONAL_GIS_ORDER,
+                        adfLon, adfLat, 1e-9);
+    }
+
 } // namespace tut
@@ -619,4 +619,100 @@ def test_pixfun_dB2pow():
     assert numpy.allclose(data, 10.**(refdata / 10.))
 
 
+###############################################################################
+# Verify evaluation of an arithmetic expression.
+
+def test_pixfun_expression():
+
+    filename = 'data/pixfun_expression.vrt'
+    ds = gdal.OpenShared(filename, gdal.GA_ReadOnly)
+    assert ds is not None, ('Unable to open "%s" dataset.' % filename)
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    refdata = []
+    for reffilename in ('data/uint16.tif', 'data/int32.tif',
+                        'data/float32.tif'):
+        refds = gdal.Open(reffilename)
+        assert refds is not None, ('Unable to open "%s" dataset.' % reffilename)
+        refdata.append(refds.GetRasterBand(1).ReadAsArray().astype('float64'))
+    b1, b2, b3 = refdata
+
+    with numpy.errstate(divide='ignore', invalid='ignore'):
+        expected = numpy.where(b1 > 150, (b1 - b2) / (b1 + b2),
+                               -numpy.abs(b3) + 2 * numpy.pi)
+    assert numpy.allclose(data, expected, equal_nan=True)
+
+
+###############################################################################
+# Verify that sources at nodata give nodata with the expression pixel function
+
+def test_pixfun_expression_nodata():
+
+    ds = gdal.Open("""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <NoDataValue>107</NoDataValue>
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="max(B1, 0) * 2"/>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>""")
+    data = ds.GetRasterBand(1).ReadAsArray()
+
+    refdata = gdal.Open('data/byte.tif').ReadAsArray().astype('float64')
+    expected = numpy.where(refdata == 107, 107, refdata * 2)
+    assert numpy.alltrue(data == expected)
+    assert numpy.any(refdata == 107)
+
+
+###############################################################################
+# Verify error cases of the expression pixel function
+
+@pytest.mark.parametrize("expression", ["", "B1 +", "B2", "foo(B1)",
+                                        "min(B1)", "(B1", "B1 ? 1"])
+def test_pixfun_expression_invalid(expression):
+
+    ds = gdal.Open("""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="%s"/>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>""" % expression)
+    with gdaltest.error_handler():
+        assert ds.GetRasterBand(1).ReadRaster() is None
+
+
+###############################################################################
+# Verify that too deeply nested or too complex expressions are rejected
+# without exhausting the stack
+
+@pytest.mark.parametrize("expression", ["(" * 100000 + "B1" + ")" * 100000,
+                                        "-" * 100000 + "B1",
+                                        "B1 ? " * 100000 + "1" + " : 0" * 100000,
+                                        "B1+" * 100000 + "B1"],
+                         ids=["parentheses", "unary", "select", "sum"])
+def test_pixfun_expression_too_deep(expression):
+
+    ds = gdal.Open("""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="%s"/>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>""" % expression)
+    with gdaltest.error_handler():
+        assert ds.GetRasterBand(1).ReadRaster() is None
+    assert 'too' in gdal.GetLastErrorMsg()
+
+
+
 ###############################################################################
@@ -1114,6 +1114,85 @@ def test_tiff_read_vsicurl_multirange():
 
         gdal.VSICurlClearCache()
 
+###############################################################################
+# Test that AdviseRead() prefetches with /vsicurl the blocks of the window
+
+
+def test_tiff_read_vsicurl_advise_read():
+
+    if gdal.GetDriverByName('HTTP') is None:
+        pytest.skip()
+
+    (webserver_process, webserver_port) = webserver.launch(handler=webserver.DispatcherHttpHandler)
+    if webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    src_ds = gdal.GetDriverByName('MEM').Create('', 512, 512)
+    src_data = bytearray([(i * 7919 // 3) % 251 for i in range(512 * 512)])
+    src_ds.WriteRaster(0, 0, 512, 512, bytes(src_data))
+    tmpfilename = '/vsimem/test_tiff_read_vsicurl_advise_read.tif'
+    gdal.GetDriverByName('GTiff').CreateCopy(tmpfilename, src_ds,
+                                             options=['TILED=YES', 'BLOCKXSIZE=64', 'BLOCKYSIZE=64'])
+    f = gdal.VSIFOpenL(tmpfilename, 'rb')
+    filedata = gdal.VSIFReadL(1, gdal.VSIStatL(tmpfilename).size, f)
+    gdal.VSIFCloseL(f)
+    gdal.Unlink(tmpfilename)
+
+    class RangeHandler(object):
+        def __init__(self):
+            self.get_count = 0
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header('Content-Length', len(filedata))
+            request.end_headers()
+
+        def do_GET(self, request):
+            self.get_count += 1
+            rng = request.headers['Range'][len('bytes='):]
+            start = int(rng.split('-')[0])
+            end = min(int(rng.split('-')[1]), len(filedata) - 1)
+            request.protocol_version = 'HTTP/1.1'
+            request.send_response(206)
+            request.send_header('Content-type', 'application/octet-stream')
+            request.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(filedata)))
+            request.send_header('Content-Length', end - start + 1)
+            request.send_header('Connection', 'close')
+            request.end_headers()
+            request.wfile.write(filedata[start:end + 1])
+
+    try:
+        handler = RangeHandler()
+        with webserver.install_http_handler(handler):
+            with gdaltest.config_option('GDAL_DISABLE_READDIR_ON_OPEN', 'EMPTY_DIR'):
+                ds = gdal.Open('/vsicurl/http://127.0.0.1:%d/advise_read.tif' % webserver_port)
+            assert ds is not None
+            band = ds.GetRasterBand(1)
+
+            get_count_before = handler.get_count
+            assert band.AdviseRead(0, 0, 512, 256) == gdal.CE_None
+
+            # Blocks are read one at a time, but should be served from the
+            # prefetched data.
+            for yblock in range(4):
+                for xblock in range(8):
+                    data = band.ReadBlock(xblock, yblock)
+                    for y in range(64):
+                        offset = (yblock * 64 + y) * 512 + xblock * 64
+                        assert data[y * 64:(y + 1) * 64] == src_data[offset:offset + 64]
+            assert handler.get_count - get_count_before <= 2
+
+            ds = None
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
 ###############################################################################
 # Test reading a TIFF made of a single-strip that is more than 2GB (#5403)
 
@@ -3485,3 +3564,102 @@ def test_tiff_read_utf8_encoding_issue_2903():
     ds = None
     os.unlink(tmp_tif_filename)
     os.unlink(tmp_tfw_filename)
+
+
+###############################################################################
+# Test multi-threaded decompression of striles (NUM_THREADS open option)
+
+
+@pytest.mark.parametrize('options', [['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16'],
+                                     ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'INTERLEAVE=BAND'],
+                                     ['BLOCKYSIZE=3']])
+def test_tiff_read_multi_threaded(options):
+
+    src_ds = gdal.Open('data/rgbsmall.tif')
+    filename = '/vsimem/test_tiff_read_multi_threaded.tif'
+    gdal.GetDriverByName('GTiff').CreateCopy(filename, src_ds,
+                                             options=['COMPRESS=DEFLATE', 'PREDICTOR=2'] + options)
+    ref_data = src_ds.ReadRaster()
+    ref_data_band2 = src_ds.GetRasterBand(2).ReadRaster(3, 5, 40, 37)
+    ref_data_sub = src_ds.ReadRaster(1, 2, 45, 20, band_list=[3, 1])
+
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+    assert ds.ReadRaster() == ref_data
+    assert ds.GetRasterBand(2).ReadRaster(3, 5, 40, 37) == ref_data_band2
+    assert ds.ReadRaster(1, 2, 45, 20, band_list=[3, 1]) == ref_data_sub
+    assert [ds.GetRasterBand(i+1).Checksum() for i in range(3)] == \
+           [src_ds.GetRasterBand(i+1).Checksum() for i in range(3)]
+    ds = None
+
+    with gdaltest.config_option('GDAL_NUM_THREADS', 'ALL_CPUS'):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster(buf_type=gdal.GDT_Float32) == \
+               src_ds.ReadRaster(buf_type=gdal.GDT_Float32)
+        ds = None
+
+    gdal.Unlink(filename)
+
+###############################################################################
+# Test that multi-threaded decompression fills the block cache
+
+
+def test_tiff_read_multi_threaded_block_cache():
+
+    src_ds = gdal.Open('data/rgbsmall.tif')
+    filename = '/vsimem/test_tiff_read_multi_threaded_block_cache.tif'
+    gdal.GetDriverByName('GTiff').CreateCopy(filename, src_ds,
+                                             options=['COMPRESS=DEFLATE', 'TILED=YES',
+                                                      'BLOCKXSIZE=16', 'BLOCKYSIZE=16'])
+
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+    cache_used = gdal.GetCacheUsed()
+    assert ds.GetRasterBand(1).ReadRaster() == src_ds.GetRasterBand(1).ReadRaster()
+    # The other bands of the decoded tiles are cached too
+    assert gdal.GetCacheUsed() - cache_used >= 3 * 50 * 50
+    assert ds.GetRasterBand(2).ReadRaster() == src_ds.GetRasterBand(2).ReadRaster()
+    assert ds.GetRasterBand(3).ReadRaster(1, 2, 40, 30) == \
+           src_ds.GetRasterBand(3).ReadRaster(1, 2, 40, 30)
+    ds = None
+
+    gdal.Unlink(filename)
+
+###############################################################################
+# Test that errors raised while decompressing in worker threads are emitted
+# in the calling thread
+
+
+def test_tiff_read_multi_threaded_errors():
+
+    src_ds = gdal.Open('data/byte.tif')
+    filename = '/vsimem/test_tiff_read_multi_threaded_errors.tif'
+    gdal.GetDriverByName('GTiff').CreateCopy(filename, src_ds,
+                                             options=['COMPRESS=DEFLATE', 'TILED=YES',
+                                                      'BLOCKXSIZE=16', 'BLOCKYSIZE=16'])
+    ds = gdal.Open(filename)
+    offset = int(ds.GetRasterBand(1).GetMetadataItem('BLOCK_OFFSET_1_0', 'TIFF'))
+    size = int(ds.GetRasterBand(1).GetMetadataItem('BLOCK_SIZE_1_0', 'TIFF'))
+    ds = None
+
+    f = gdal.VSIFOpenL(filename, 'rb+')
+    gdal.VSIFSeekL(f, offset, 0)
+    gdal.VSIFWriteL(b'\xff' * size, 1, size, f)
+    gdal.VSIFCloseL(f)
+
+    errors = []
+
+    def error_handler(err_type, err_no, err_msg):
+        errors.append(err_msg)
+
+    ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+    gdal.PushErrorHandler(error_handler)
+    try:
+        assert ds.ReadRaster() is None
+    finally:
+        gdal.PopErrorHandler()
+    ds = None
+
+    # The libtiff error, and the final one
+    assert len(errors) >= 2
+    assert 'Decompression of tile 1 failed' in errors[-1]
+
+    gdal.Unlink(filename)
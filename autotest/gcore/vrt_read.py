@@ -1636,3 +1636,72 @@ def test_vrt_usemaskband_alpha():
 
     gdal.GetDriverByName('GTiff').Delete('/vsimem/src1.tif')
     gdal.GetDriverByName('GTiff').Delete('/vsimem/src2.tif')
+
+###############################################################################
+# Test reading non-overlapping sources concurrently
+
+
+@pytest.mark.parametrize("num_threads_xml,open_options,config_value",
+                         [(None, ['NUM_THREADS=4'], None),
+                          ('ALL_CPUS', None, None),
+                          (None, None, '4')])
+def test_vrt_read_sources_multithreaded(num_threads_xml, open_options,
+                                        config_value):
+
+    src_ds = gdal.Open('data/byte.tif')
+    tiles = []
+    for j in range(4):
+        for i in range(4):
+            filename = '/vsimem/vrt_mt_%d_%d.tif' % (i, j)
+            gdal.Translate(filename, src_ds, srcWin=[i * 5, j * 5, 5, 5])
+            tiles.append(filename)
+
+    vrt_ds = gdal.BuildVRT('', tiles)
+    xml = vrt_ds.GetMetadata('xml:VRT')[0]
+    vrt_ds = None
+    if num_threads_xml:
+        xml = xml.replace('<VRTRasterBand',
+                          '<NumThreads>%s</NumThreads><VRTRasterBand' % num_threads_xml, 1)
+
+    with gdaltest.config_option('VRT_NUM_THREADS', config_value):
+        ds = gdal.OpenEx(xml, open_options=open_options)
+        assert ds.GetRasterBand(1).Checksum() == \
+            src_ds.GetRasterBand(1).Checksum(0, 0, 20, 20)
+        assert ds.ReadRaster(2, 3, 15, 12) == src_ds.ReadRaster(2, 3, 15, 12)
+    if num_threads_xml:
+        assert '<NumThreads>%s</NumThreads>' % num_threads_xml in \
+            ds.GetMetadata('xml:VRT')[0]
+    ds = None
+
+    for filename in tiles:
+        gdal.Unlink(filename)
+
+###############################################################################
+# Test that errors of sources read concurrently are reported
+
+
+def test_vrt_read_sources_multithreaded_error():
+
+    vrt_ds = gdal.Open("""<VRTDataset rasterXSize="40" rasterYSize="20">
+  <VRTRasterBand dataType="Byte" band="1">
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="20" />
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte_truncated.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="20" yOff="0" xSize="20" ySize="20" />
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>""")
+
+    with gdaltest.config_option('VRT_NUM_THREADS', '2'):
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            assert vrt_ds.ReadRaster() is None
+        assert gdal.GetLastErrorType() == gdal.CE_Failure
+        assert gdal.GetLastErrorMsg() != ''
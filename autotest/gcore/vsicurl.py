@@ -28,6 +28,10 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
+import subprocess
+import sys
+import threading
 import time
 from osgeo import gdal
 from osgeo import ogr
@@ -573,6 +577,276 @@ def test_vsicurl_no_size_in_HEAD():
     assert statres.size == 10
 
 ###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR
+
+
+def test_vsicurl_disk_cache():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    cache_dir = 'tmp/test_vsicurl_disk_cache'
+    gdal.RmdirRecursive(cache_dir)
+
+    url = '/vsicurl/http://localhost:%d/test_vsicurl_disk_cache.bin' % gdaltest.webserver_port
+    with gdaltest.config_option('CPL_VSIL_CURL_DISK_CACHE_DIR', cache_dir):
+
+        handler = webserver.SequentialHandler()
+        handler.add('HEAD', '/test_vsicurl_disk_cache.bin', 200,
+                    {'Content-Length': '3', 'ETag': '"foo_etag"'})
+        handler.add('GET', '/test_vsicurl_disk_cache.bin', 206,
+                    {'Content-Length': '3',
+                     'Content-Range': 'bytes 0-2/3',
+                     'ETag': '"foo_etag"'}, 'foo')
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, 'rb')
+            assert f is not None
+            data = gdal.VSIFReadL(1, 3, f)
+            gdal.VSIFCloseL(f)
+        assert data == b'foo'
+
+        # Only the validation HEAD request should be emitted: the content
+        # comes from the disk cache
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add('HEAD', '/test_vsicurl_disk_cache.bin', 200,
+                    {'Content-Length': '3', 'ETag': '"foo_etag"'})
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, 'rb')
+            assert f is not None
+            data = gdal.VSIFReadL(1, 3, f)
+            gdal.VSIFCloseL(f)
+        assert data == b'foo'
+
+        # Content changed on server side: the cached chunk must not be used
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add('HEAD', '/test_vsicurl_disk_cache.bin', 200,
+                    {'Content-Length': '3', 'ETag': '"bar_etag"'})
+        handler.add('GET', '/test_vsicurl_disk_cache.bin', 206,
+                    {'Content-Length': '3',
+                     'Content-Range': 'bytes 0-2/3',
+                     'ETag': '"bar_etag"'}, 'bar')
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, 'rb')
+            assert f is not None
+            data = gdal.VSIFReadL(1, 3, f)
+            gdal.VSIFCloseL(f)
+        assert data == b'bar'
+
+    gdal.VSICurlClearCache()
+    gdal.RmdirRecursive(cache_dir)
+
+###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR with a chunk size that changes between
+# sessions
+
+
+def test_vsicurl_disk_cache_chunk_size_change():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    filedata = bytes(bytearray([(i * 7919 // 3) % 251 for i in range(300000)]))
+
+    class RangeHandler(object):
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header('Content-Length', len(filedata))
+            request.send_header('ETag', '"foo_etag"')
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers['Range'][len('bytes='):]
+            start = int(rng.split('-')[0])
+            end = min(int(rng.split('-')[1]), len(filedata) - 1)
+            request.protocol_version = 'HTTP/1.1'
+            request.send_response(206)
+            request.send_header('Content-type', 'application/octet-stream')
+            request.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(filedata)))
+            request.send_header('Content-Length', end - start + 1)
+            request.send_header('ETag', '"foo_etag"')
+            request.send_header('Connection', 'close')
+            request.end_headers()
+            request.wfile.write(filedata[start:end + 1])
+
+    cache_dir = 'tmp/test_vsicurl_disk_cache_chunk_size_change'
+    gdal.RmdirRecursive(cache_dir)
+
+    url = '/vsicurl/http://localhost:%d/test_vsicurl_disk_cache_chunk_size_change.bin' % gdaltest.webserver_port
+
+    # The chunk size is read once per process, hence the use of a subprocess
+    # for each session
+    def read_file_in_subprocess(chunk_size):
+        env = os.environ.copy()
+        env['CPL_VSIL_CURL_DISK_CACHE_DIR'] = cache_dir
+        env['CPL_VSIL_CURL_CHUNK_SIZE'] = chunk_size
+        env['GDAL_DISABLE_READDIR_ON_OPEN'] = 'EMPTY_DIR'
+        script = ("import sys; from osgeo import gdal; "
+                  "f = gdal.VSIFOpenL('%s', 'rb'); "
+                  "data = gdal.VSIFReadL(1, 1000000, f); "
+                  "gdal.VSIFCloseL(f); "
+                  "sys.stdout.buffer.write(data)" % url)
+        return subprocess.check_output([sys.executable, '-c', script], env=env)
+
+    with webserver.install_http_handler(RangeHandler()):
+        assert read_file_in_subprocess('16384') == filedata
+        assert read_file_in_subprocess('65536') == filedata
+        assert read_file_in_subprocess('16384') == filedata
+
+    gdal.RmdirRecursive(cache_dir)
+
+###############################################################################
+# Test CPL_VSIL_CURL_PARALLEL_DOWNLOAD_COUNT
+
+
+def test_vsicurl_parallel_download():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    filedata = bytes(bytearray([(i * 7919 // 3) % 251 for i in range(200000)]))
+
+    class RangeHandler(object):
+        def __init__(self):
+            self.get_count = 0
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header('Content-Length', len(filedata))
+            request.end_headers()
+
+        def do_GET(self, request):
+            self.get_count += 1
+            rng = request.headers['Range'][len('bytes='):]
+            start = int(rng.split('-')[0])
+            end = min(int(rng.split('-')[1]), len(filedata) - 1)
+            request.protocol_version = 'HTTP/1.1'
+            request.send_response(206)
+            request.send_header('Content-type', 'application/octet-stream')
+            request.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(filedata)))
+            request.send_header('Content-Length', end - start + 1)
+            request.send_header('Connection', 'close')
+            request.end_headers()
+            request.wfile.write(filedata[start:end + 1])
+
+    url = '/vsicurl/http://localhost:%d/test_vsicurl_parallel_download.bin' % gdaltest.webserver_port
+    with gdaltest.config_options({'GDAL_DISABLE_READDIR_ON_OPEN': 'EMPTY_DIR',
+                                  'CPL_VSIL_CURL_PARALLEL_DOWNLOAD_COUNT': '4',
+                                  'CPL_VSIL_CURL_PARALLEL_DOWNLOAD_PART_SIZE': '16384'}):
+
+        # Single large read split into several range requests
+        handler = RangeHandler()
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, 'rb')
+            assert f is not None
+            gdal.VSIFSeekL(f, 1000, 0)
+            data = gdal.VSIFReadL(1, len(filedata), f)
+            gdal.VSIFCloseL(f)
+        assert data == filedata[1000:]
+        assert handler.get_count >= 4
+
+        # Sequential reads, with parts downloaded ahead
+        gdal.VSICurlClearCache()
+        handler = RangeHandler()
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, 'rb')
+            assert f is not None
+            data = b''
+            while True:
+                chunk = gdal.VSIFReadL(1, 5000, f)
+                data += chunk
+                if len(chunk) < 5000:
+                    break
+            gdal.VSIFCloseL(f)
+        assert data == filedata
+
+    gdal.VSICurlClearCache()
+
+###############################################################################
+# Test concurrent positional reads with VSIFPReadL()
+
+
+def test_vsicurl_pread():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    filedata = bytes(bytearray([(i * 7 + 3) % 256 for i in range(100000)]))
+
+    class RangeHandler(object):
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header('Content-Length', len(filedata))
+            request.end_headers()
+
+        def do_GET(self, request):
+            if 'Range' not in request.headers:
+                request.send_response(200)
+                request.send_header('Content-Length', len(filedata))
+                request.end_headers()
+                request.wfile.write(filedata)
+                return
+            rng = request.headers['Range'][len('bytes='):].split('-')
+            start = int(rng[0])
+            end = min(int(rng[1]), len(filedata) - 1)
+            self.ranges.append((start, end))
+            request.send_response(206)
+            request.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(filedata)))
+            request.send_header('Content-Length', end - start + 1)
+            request.end_headers()
+            request.wfile.write(filedata[start:end + 1])
+
+    handler = RangeHandler()
+    with webserver.install_http_handler(handler):
+        with gdaltest.config_option('GDAL_DISABLE_READDIR_ON_OPEN', 'EMPTY_DIR'):
+            f = gdal.VSIFOpenL('/vsicurl/http://localhost:%d/test_pread/test.bin' % gdaltest.webserver_port, 'rb')
+        assert f is not None
+        assert gdal.VSIFSeekL(f, 10, 0) == 0
+
+        offsets = list(range(0, len(filedata) + 100, 4999))
+        results = {}
+
+        def pread(offset):
+            results[offset] = gdal.VSIFPReadL(1000, offset, f)
+
+        threads = [threading.Thread(target=pread, args=(offset,)) for offset in offsets]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        for offset in offsets:
+            assert results[offset] == filedata[offset:offset + 1000], offset
+
+        # VSIFPReadL() does not affect the current file position
+        assert gdal.VSIFTellL(f) == 10
+        gdal.VSIFCloseL(f)
+
+    # Data has been fetched with ranged GET requests
+    assert handler.ranges
+
+    gdal.VSICurlClearCache()
+
+###############################################################################
 
 
 def test_vsicurl_stop_webserver():
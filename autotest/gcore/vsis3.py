@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import array
 import json
 import os.path
 import stat
@@ -2382,6 +2383,78 @@ def test_vsis3_sync_source_target_in_vsis3():
     with webserver.install_http_handler(handler):
         assert gdal.Sync( '/vsis3/in/testsync.txt', '/vsis3/out/')
 
+###############################################################################
+# Test Sync() download of a file larger than the default chunk size of 8 MB
+
+
+def test_vsis3_fake_sync_download_default_chunk_size():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    chunk_size = 8 * 1024 * 1024
+    filedata = array.array('I', range((chunk_size + 100000) // 4)).tobytes()
+
+    class RangeHandler(object):
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header('Content-Length', len(filedata))
+            request.end_headers()
+
+        def do_GET(self, request):
+            if request.path != '/test_bucket/test.bin':
+                request.send_response(404)
+                request.send_header('Content-Length', 0)
+                request.end_headers()
+                return
+            if 'Range' not in request.headers:
+                request.send_response(200)
+                request.send_header('Content-Length', len(filedata))
+                request.end_headers()
+                request.wfile.write(filedata)
+                return
+            rng = request.headers['Range'][len('bytes='):].split('-')
+            start = int(rng[0])
+            end = min(int(rng[1]), len(filedata) - 1)
+            self.ranges.append((start, end))
+            request.send_response(206)
+            request.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(filedata)))
+            request.send_header('Content-Length', end - start + 1)
+            request.end_headers()
+            request.wfile.write(filedata[start:end + 1])
+
+    gdal.Mkdir('/vsimem/test_vsis3_fake_sync_download_default_chunk_size', 0)
+
+    handler = RangeHandler()
+    with gdaltest.config_option('VSIS3_SIMULATE_THREADING', 'YES'):
+        with webserver.install_http_handler(handler):
+            assert gdal.Sync('/vsis3/test_bucket/test.bin',
+                             '/vsimem/test_vsis3_fake_sync_download_default_chunk_size',
+                             options=['NUM_THREADS=1'])
+
+    # Each chunk has been fetched with its own ranged GET requests
+    assert handler.ranges
+    assert chunk_size in [start for start, _ in handler.ranges]
+    for start, end in handler.ranges:
+        assert end < chunk_size or start >= chunk_size, (start, end)
+
+    f = gdal.VSIFOpenL('/vsimem/test_vsis3_fake_sync_download_default_chunk_size/test.bin', 'rb')
+    assert f is not None
+    data = gdal.VSIFReadL(1, len(filedata) + 1, f)
+    gdal.VSIFCloseL(f)
+    assert data == filedata
+
+    gdal.RmdirRecursive('/vsimem/test_vsis3_fake_sync_download_default_chunk_size')
+    gdal.VSICurlClearCache()
+
 ###############################################################################
 # Test rename
 
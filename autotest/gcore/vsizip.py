@@ -583,6 +583,62 @@ def test_vsizip_multi_thread_below_threshold():
 
     assert data == 'hello'
 
+###############################################################################
+# Test writing and reading seek-optimized files
+
+
+def test_vsizip_seek_optimized():
+
+    zip_name = '/vsimem/vsizip_seek_optimized.zip'
+    rnd = random.Random(0)
+    data = bytes(bytearray([rnd.randint(0, 15) for i in range(100000)]))
+
+    fmain = gdal.VSIFOpenL('/vsizip/' + zip_name, 'wb')
+    f = gdal.VSIFOpenExL('/vsizip/' + zip_name + '/subdir/test', 'wb', False,
+                         ['SEEK_OPTIMIZED=YES', 'SEEK_OPTIMIZED_CHUNK_SIZE=1K'])
+    for i in range(0, len(data), 4000):
+        gdal.VSIFWriteL(data[i:i+4000], 1, len(data[i:i+4000]), f)
+    gdal.VSIFCloseL(f)
+    with gdaltest.config_option('CPL_VSIL_ZIP_SEEK_OPTIMIZED', 'YES'):
+        f = gdal.VSIFOpenL('/vsizip/' + zip_name + '/test2', 'wb')
+        gdal.VSIFWriteL(data, 1, len(data), f)
+        gdal.VSIFCloseL(f)
+        f = gdal.VSIFOpenL('/vsizip/' + zip_name + '/empty', 'wb')
+        gdal.VSIFCloseL(f)
+    gdal.VSIFCloseL(fmain)
+
+    # The chunk indexes are hidden
+    assert gdal.ReadDirRecursive('/vsizip/' + zip_name) == ['subdir/', 'subdir/test', 'test2', 'empty']
+
+    assert gdal.VSIStatL('/vsizip/' + zip_name + '/empty').size == 0
+    f = gdal.VSIFOpenL('/vsizip/' + zip_name + '/empty', 'rb')
+    assert f
+    gdal.ErrorReset()
+    assert gdal.VSIFReadL(1, 1, f) == b''
+    assert gdal.GetLastErrorMsg() == ''
+    gdal.VSIFCloseL(f)
+    assert gdal.VSIStatL('/vsizip/' + zip_name + '/subdir/test').size == len(data)
+
+    for filename in ('/subdir/test', '/test2'):
+        f = gdal.VSIFOpenL('/vsizip/' + zip_name + filename, 'rb')
+        assert f
+        for i in range(100):
+            offset = rnd.randint(0, len(data) + 10)
+            size = rnd.randint(1, 10000)
+            gdal.VSIFSeekL(f, offset, 0)
+            assert gdal.VSIFReadL(1, size, f) == data[offset:offset+size]
+        gdal.VSIFSeekL(f, 0, 0)
+        got = b''
+        while True:
+            chunk = gdal.VSIFReadL(1, 777, f)
+            if not chunk:
+                break
+            got += chunk
+        assert got == data
+        gdal.VSIFCloseL(f)
+
+    gdal.Unlink(zip_name)
+
 ###############################################################################
 # Test creating ZIP64 file: uncompressed larger than 4GB, but compressed
 # data stream < 4 GB
@@ -151,7 +151,8 @@ def test_derived_test3():
 
     for function in ['real', 'imag', 'complex', 'mod', 'phase', 'conj',
                      'sum', 'diff', 'mul', 'cmul', 'inv', 'intensity',
-                     'sqrt', 'log10', 'dB', 'dB2amp', 'dB2pow']:
+                     'sqrt', 'log10', 'dB', 'dB2amp', 'dB2pow',
+                     'expression']:
         ds = gdal.Open('<VRTDataset rasterXSize="1" rasterYSize="1"><VRTRasterBand subClass="VRTDerivedRasterBand"><PixelFunctionType>%s</PixelFunctionType></VRTRasterBand></VRTDataset>' % function)
         with gdaltest.error_handler():
             ds.GetRasterBand(1).Checksum()
@@ -2132,3 +2132,65 @@ def test_ogr_csv_iter_and_set_feature():
     gdal.Unlink('/vsimem/ogr_csv_iter_and_set_feature.csv')
 
     assert count == 2
+
+###############################################################################
+# Test reading with NUM_THREADS (multi-threaded translation of records)
+
+
+def test_ogr_csv_num_threads():
+
+    content = 'id,str,val,WKT\r\n'
+    for i in range(1000):
+        if i % 10 == 0:
+            content += '%d,"multi\r\nline ""%d""",%d,"POINT (%d 1)"\r\n' % (i, i, i, i)
+        elif i % 10 == 1:
+            content += '\n'
+        else:
+            content += '%d,str%d,%d,\n' % (i, i, i)
+    content += '1000,"unterminated\n'
+    filename = '/vsimem/ogr_csv_num_threads.csv'
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(num_threads):
+        ds = gdal.OpenEx(filename, gdal.OF_VECTOR,
+                         open_options=['NUM_THREADS=' + num_threads])
+        lyr = ds.GetLayer(0)
+        ret = []
+        for f in lyr:
+            g = f.GetGeometryRef()
+            ret.append((f.GetFID(), f['id'], f['str'], f['val'],
+                        g.ExportToWkt() if g else None))
+        f = lyr.GetFeature(5)
+        ret.append((f.GetFID(), f['id']))
+        f = lyr.GetNextFeature()
+        ret.append((f.GetFID(), f['id']))
+        return ret
+
+    ref = read('1')
+    assert len(ref) == 903
+    assert ref[0] == (1, '0', 'multi\nline "0"', '0', 'POINT (0 1)')
+    assert ref[899] == (900, '999', 'str999', '999', None)
+    assert ref[900] == (901, '1000', 'unterminated', None, None)
+    assert ref[901] == (5, '5')
+    assert ref[902] == (6, '6')
+
+    with gdaltest.config_option('OGR_CSV_CHUNK_SIZE', '100'):
+        assert read('4') == ref
+        assert read('ALL_CPUS') == ref
+
+        # Change the ignored fields while reading
+        ds = gdal.OpenEx(filename, gdal.OF_VECTOR,
+                         open_options=['NUM_THREADS=4'])
+        lyr = ds.GetLayer(0)
+        for i in range(101):
+            f = lyr.GetNextFeature()
+        assert f.GetFID() == 101
+        assert f['str'] == 'str112'
+        lyr.SetIgnoredFields(['str'])
+        f = lyr.GetNextFeature()
+        assert f.GetFID() == 102
+        assert f['id'] == '113'
+        assert not f.IsFieldSet('str')
+        ds = None
+
+    gdal.Unlink(filename)
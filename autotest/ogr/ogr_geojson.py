@@ -3163,3 +3163,133 @@ def test_ogr_geojson_export_geometry_axis_order():
     # No CRS
     g = ogr.CreateGeometryFromWkt('POINT (2 49)')
     assert json.loads(g.ExportToJson()) == { "type": "Point", "coordinates": [ 2.0, 49.0 ] }
+
+
+###############################################################################
+# Test that building features directly from the streaming parser gives the
+# same result as going through a json_object tree per feature
+
+
+def test_ogr_geojson_streaming_direct_reading():
+
+    json_content = """{
+  "type": "FeatureCollection",
+  "features": [
+    { "type": "Feature", "id": 1, "properties": { "int": 1, "str": "a", "real": 1.5, "intlist": [1, 2], "nested": { "x": 1 }, "bool": true, "null": null, "dt": "2020-01-02T03:04:05Z", "int64": 12345678901 }, "geometry": { "type": "Point", "coordinates": [1, 2] } },
+    { "type": "Feature", "id": 2, "properties": { "real": 2, "str": 3, "int": 2147483648, "unknown": [1, {"x": 2}], "intlist": 5, "bool": false }, "geometry": { "type": "LineString", "coordinates": [[1, 2], [3, 4, 5]] } },
+    { "type": "Feature", "properties": { "int": null, "str": null }, "geometry": { "type": "Polygon", "coordinates": [[[0, 0], [0, 1], [1, 1], [0, 0]]] } },
+    { "type": "Feature", "properties": { "real": "x" }, "geometry": { "type": "MultiPolygon", "coordinates": [[[[0, 0], [0, 1], [1, 1], [0, 0]]], [[[5, 5, 1], [5, 6, 1], [6, 6, 1], [5, 5, 1]]]] } },
+    { "type": "Feature", "properties": {}, "geometry": { "type": "MultiPoint", "coordinates": [[1, 2], [3, 4]] } },
+    { "type": "Feature", "properties": {}, "geometry": { "type": "MultiLineString", "coordinates": [[[1, 2], [3, 4]], []] } },
+    { "type": "Feature", "properties": {}, "geometry": { "type": "GeometryCollection", "geometries": [{ "type": "Point", "coordinates": [1, 2] }] } },
+    { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [1, 2], "crs": null } },
+    { "type": "Feature", "properties": {}, "geometry": { "type": "Polygon", "coordinates": [] } },
+    { "type": "Feature", "properties": {}, "geometry": null },
+    { "type": "Feature", "int": 3, "str": "top-level", "geometry": { "type": "Point", "coordinates": [1, 2, 3] } }
+  ]
+}"""
+    tmpfilename = '/vsimem/test_ogr_geojson_streaming_direct_reading.json'
+    gdal.FileFromMemBuffer(tmpfilename, json_content)
+
+    for flatten in ('NO', 'YES'):
+        with gdaltest.config_option('OGR_GEOJSON_DIRECT_READING', 'YES'):
+            ds = gdal.OpenEx(tmpfilename, gdal.OF_VECTOR,
+                             open_options=['FLATTEN_NESTED_ATTRIBUTES=' + flatten])
+            direct = [f for f in ds.GetLayer(0)]
+        with gdaltest.config_option('OGR_GEOJSON_DIRECT_READING', 'NO'):
+            ds = gdal.OpenEx(tmpfilename, gdal.OF_VECTOR,
+                             open_options=['FLATTEN_NESTED_ATTRIBUTES=' + flatten])
+            legacy = [f for f in ds.GetLayer(0)]
+        ds = None
+        assert len(direct) == 11
+        assert len(direct) == len(legacy)
+        for f_direct, f_legacy in zip(direct, legacy):
+            if not f_direct.Equal(f_legacy):
+                f_direct.DumpReadable()
+                f_legacy.DumpReadable()
+                pytest.fail()
+
+    # 2147483648 is seen by the first pass, hence an Integer64 field
+    f = direct[1]
+    assert f.GetFieldDefnRef('int').GetType() == ogr.OFTInteger64
+    assert f['int'] == 2147483648
+    assert f['str'] == '3'
+    assert f.GetGeometryRef().ExportToIsoWkt() == 'LINESTRING Z (1 2 0,3 4 5)'
+
+    gdal.Unlink(tmpfilename)
+
+###############################################################################
+# Test that an integer value out of the range of a 32-bit field, only seen
+# after the first pass, is clamped
+
+
+@pytest.mark.parametrize("direct_reading", ['YES', 'NO'])
+def test_ogr_geojson_streaming_integer_out_of_range_after_first_pass(direct_reading):
+
+    json_content = """{
+  "type": "FeatureCollection",
+  "features": [
+    { "type": "Feature", "properties": { "int": 1 }, "geometry": null },
+    { "type": "Feature", "properties": { "int": 3000000000 }, "geometry": null },
+    { "type": "Feature", "properties": { "int": -3000000000 }, "geometry": null }
+  ]
+}"""
+    tmpfilename = '/vsimem/test_ogr_geojson_streaming_integer_out_of_range.json'
+    gdal.FileFromMemBuffer(tmpfilename, json_content)
+
+    with gdaltest.config_option('OGR_GEOJSON_DIRECT_READING', direct_reading):
+        ds = gdal.OpenEx(tmpfilename, gdal.OF_VECTOR,
+                         open_options=['SCHEMA_SNIFF_FEATURES=1'])
+        lyr = ds.GetLayer(0)
+        assert lyr.GetLayerDefn().GetFieldDefn(0).GetType() == ogr.OFTInteger
+        f = lyr.GetNextFeature()
+        assert f['int'] == 1
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            f = lyr.GetNextFeature()
+        assert gdal.GetLastErrorType() == gdal.CE_Warning
+        assert f['int'] == 2147483647
+        with gdaltest.error_handler():
+            f = lyr.GetNextFeature()
+        assert f['int'] == -2147483648
+        ds = None
+
+    gdal.Unlink(tmpfilename)
+
+###############################################################################
+# Test the SCHEMA_SNIFF_FEATURES open option
+
+
+def test_ogr_geojson_schema_sniff_features():
+
+    tmpfilename = '/vsimem/test_ogr_geojson_schema_sniff_features.json'
+    gdal.FileFromMemBuffer(tmpfilename, """{
+  "type": "FeatureCollection",
+  "features": [
+    { "type": "Feature", "properties": { "a": 1 }, "geometry": { "type": "Point", "coordinates": [1, 2] } },
+    { "type": "Feature", "properties": { "a": 2, "b": "late" }, "geometry": { "type": "Point", "coordinates": [3, 4] } },
+    { "type": "Feature", "properties": { "a": 3.5 }, "geometry": { "type": "LineString", "coordinates": [[3, 4], [5, 6]] } }
+  ]
+}""")
+
+    ds = gdal.OpenEx(tmpfilename, gdal.OF_VECTOR,
+                     open_options=['SCHEMA_SNIFF_FEATURES=1'])
+    lyr = ds.GetLayer(0)
+    lyr_defn = lyr.GetLayerDefn()
+    assert lyr_defn.GetFieldCount() == 1
+    assert lyr_defn.GetFieldDefn(0).GetType() == ogr.OFTInteger
+    assert lyr.GetGeomType() == ogr.wkbPoint
+    assert lyr.GetFeatureCount() == 3
+    f = lyr.GetNextFeature()
+    assert f['a'] == 1
+    ds = None
+
+    ds = ogr.Open(tmpfilename)
+    lyr = ds.GetLayer(0)
+    lyr_defn = lyr.GetLayerDefn()
+    assert lyr_defn.GetFieldCount() == 2
+    assert lyr_defn.GetFieldDefn(0).GetType() == ogr.OFTReal
+    assert lyr.GetGeomType() == ogr.wkbUnknown
+    ds = None
+
+    gdal.Unlink(tmpfilename)
@@ -71,12 +71,35 @@ def test_gdal_fillnodata_2():
     ds = None
 
 
+###############################################################################
+# Test -interp push_pull and -o
+
+
+def test_gdal_fillnodata_push_pull():
+
+    script_path = test_py_scripts.get_py_script('gdal_fillnodata')
+    if script_path is None:
+        pytest.skip()
+
+    test_py_scripts.run_py_script(script_path, 'gdal_fillnodata', '-interp push_pull -o NUM_THREADS=2 ' + test_py_scripts.get_data_path('gcore') + 'nodata_byte.tif tmp/test_gdal_fillnodata_push_pull.tif')
+
+    src_ds = gdal.Open(test_py_scripts.get_data_path('gcore') + 'nodata_byte.tif')
+    expected_ds = gdal.GetDriverByName('MEM').CreateCopy('', src_ds)
+    gdal.FillNodata(expected_ds.GetRasterBand(1), None, 100, 0,
+                    ['INTERPOLATION=PUSH_PULL'])
+
+    ds = gdal.Open('tmp/test_gdal_fillnodata_push_pull.tif')
+    assert ds.GetRasterBand(1).Checksum() == expected_ds.GetRasterBand(1).Checksum()
+    ds = None
+
+
 ###############################################################################
 # Cleanup
 
 def test_gdal_fillnodata_cleanup():
 
-    lst = ['tmp/test_gdal_fillnodata_1.tif', 'tmp/test_gdal_fillnodata_2.tif']
+    lst = ['tmp/test_gdal_fillnodata_1.tif', 'tmp/test_gdal_fillnodata_2.tif',
+           'tmp/test_gdal_fillnodata_push_pull.tif']
     for filename in lst:
         try:
             os.remove(filename)
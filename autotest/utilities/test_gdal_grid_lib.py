@@ -29,12 +29,16 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
+import random
 import struct
 
 
 from osgeo import gdal, ogr
 
+import gdaltest
 import ogrtest
+import pytest
 
 ###############################################################################
 #
@@ -133,6 +137,150 @@ def test_gdal_grid_lib_3():
               width=115, height=93, outputBounds=[37.3495161160827, 55.6901531392856, 37.3497618734837, 55.6902650179072],
               format='MEM', algorithm='linear')
 
+###############################################################################
+# Test linear interpolation by tiles (GDAL_GRID_LINEAR_TILE_SIZE)
+
+
+def test_gdal_grid_lib_linear_tiles():
+
+    rng = random.Random(0)
+    points = ['[%.9f, %.9f, %.9f]' % (rng.uniform(0, 100), rng.uniform(0, 100), rng.uniform(0, 1000))
+              for _ in range(3000)]
+    geojson = '{"type": "MultiPoint", "coordinates": [%s]}' % ', '.join(points)
+
+    res = []
+    for tile_size in [None, '7', '64']:
+        with gdaltest.config_option('GDAL_GRID_LINEAR_TILE_SIZE', tile_size):
+            ds = gdal.Grid('', geojson, width=90, height=80,
+                           outputBounds=[-10, -10, 110, 110],
+                           outputType=gdal.GDT_Float64,
+                           format='MEM', algorithm='linear:radius=5:nodata=-1')
+        res.append(struct.unpack('d' * 90 * 80, ds.ReadRaster()))
+
+    for tiled in res[1:]:
+        for ref, got in zip(res[0], tiled):
+            assert got == pytest.approx(ref, rel=1e-9, abs=1e-9)
+
+###############################################################################
+# Brute force computation of a grid node value, to check the k-d tree searches
+
+
+def _gdal_grid_lib_brute_force(algorithm, pts, x, y, radius1, radius2, angle, nodata):
+
+    if radius1 == 0 and radius2 == 0:
+        # Nearest neighbor of all points: last one in case of ties
+        best = None
+        for (px, py, pz) in pts:
+            d2 = (px - x) * (px - x) + (py - y) * (py - y)
+            if best is None or d2 <= best[0]:
+                best = (d2, pz)
+        return best[1]
+
+    r1 = radius1 * radius1
+    r2 = radius2 * radius2
+    a = math.radians(angle)
+    inside = []
+    for (px, py, pz) in pts:
+        rx = px - x
+        ry = py - y
+        if angle != 0:
+            rx, ry = rx * math.cos(a) + ry * math.sin(a), ry * math.cos(a) - rx * math.sin(a)
+        if r2 * rx * rx + r1 * ry * ry <= r1 * r2:
+            inside.append((px, py, pz, rx, ry))
+    if not inside:
+        return nodata
+    if algorithm == 'nearest':
+        best = None
+        for (_, _, pz, rx, ry) in inside:
+            d2 = rx * rx + ry * ry
+            if best is None or d2 <= best[0]:
+                best = (d2, pz)
+        return best[1]
+    if algorithm == 'average':
+        return sum(p[2] for p in inside) / len(inside)
+    if algorithm == 'minimum':
+        return min(p[2] for p in inside)
+    if algorithm == 'maximum':
+        return max(p[2] for p in inside)
+    if algorithm == 'range':
+        return max(p[2] for p in inside) - min(p[2] for p in inside)
+    if algorithm == 'count':
+        return len(inside)
+    if algorithm == 'average_distance':
+        return sum(math.sqrt(p[3] * p[3] + p[4] * p[4]) for p in inside) / len(inside)
+    assert algorithm == 'average_distance_pts'
+    dists = [math.sqrt((q[0] - p[0]) ** 2 + (q[1] - p[1]) ** 2)
+             for i, p in enumerate(inside) for q in inside[i + 1:]]
+    if not dists:
+        return nodata
+    return sum(dists) / len(dists)
+
+###############################################################################
+# Test the k-d tree searches of the nearest neighbor, moving average and data
+# metrics algorithms against a brute force computation
+
+
+@pytest.mark.parametrize('algorithm,radius1,radius2,angle', [
+    ('nearest', 0, 0, 0),
+    ('nearest', 0, 0, 30),
+    ('nearest', 8, 5, 0),
+    ('nearest', 8, 5, 30),
+    ('average', 8, 5, 0),
+    ('average', 8, 5, 30),
+    ('minimum', 8, 5, 30),
+    ('maximum', 8, 5, 30),
+    ('range', 8, 5, 30),
+    ('count', 8, 5, 30),
+    ('average_distance', 8, 5, 30),
+    ('average_distance_pts', 8, 5, 30),
+    ('count', 5, 8, -75),
+])
+def test_gdal_grid_lib_kdtree(algorithm, radius1, radius2, angle):
+
+    rng = random.Random(1)
+    pts = [(rng.uniform(0, 100), rng.uniform(0, 100), rng.uniform(0, 1000))
+           for _ in range(400)]
+    # Duplicated points with different values, to check ties
+    pts += [(pts[i][0], pts[i][1], pts[i][2] + 1) for i in range(0, 400, 40)]
+    geojson = '{"type": "MultiPoint", "coordinates": [%s]}' % ', '.join(
+        '[%.17g, %.17g, %.17g]' % p for p in pts)
+
+    nodata = -9999
+    width = 30
+    height = 25
+    ds = gdal.Grid('', geojson, width=width, height=height,
+                   outputBounds=[-10, -10, 110, 110],
+                   outputType=gdal.GDT_Float64, format='MEM',
+                   algorithm='%s:radius1=%g:radius2=%g:angle=%g:nodata=%g' % (
+                       algorithm, radius1, radius2, angle, nodata))
+    gt = ds.GetGeoTransform()
+    got = struct.unpack('d' * width * height, ds.ReadRaster())
+    for j in range(height):
+        y = gt[3] + (j + 0.5) * gt[5]
+        for i in range(width):
+            x = gt[0] + (i + 0.5) * gt[1]
+            expected = _gdal_grid_lib_brute_force(algorithm, pts, x, y,
+                                                  radius1, radius2, angle, nodata)
+            assert got[j * width + i] == pytest.approx(expected, rel=1e-9, abs=1e-9), (i, j)
+
+###############################################################################
+# Test that the nearest neighbor algorithm without search ellipse returns the
+# exact nearest point on a known grid
+
+
+def test_gdal_grid_lib_nearest_known_grid():
+
+    # Points such that the nearest point of the node at (0.5, 0.5) is not in
+    # the smallest square centered on the node that contains a point.
+    geojson = """{"type": "MultiPoint", "coordinates": [
+        [1.3, 1.3, 10], [1.55, 0.5, 20], [2.5, 0.5, 30], [2.5, 0.5, 40]]}"""
+    ds = gdal.Grid('', geojson, width=3, height=1,
+                   outputBounds=[0, 0, 3, 1],
+                   outputType=gdal.GDT_Float64, format='MEM',
+                   algorithm='nearest')
+    # The 2 last points are at the same location: the last one is used.
+    assert struct.unpack('d' * 3, ds.ReadRaster()) == (20, 20, 40)
+
 ###############################################################################
 # Cleanup
 
@@ -30,6 +30,8 @@
 ###############################################################################
 
 import os
+import struct
+
 from osgeo import gdal
 import gdaltest
 import test_cli_utilities
@@ -114,6 +116,67 @@ def test_gdal_viewshed_all_options():
 ###############################################################################
 
 
+def test_gdal_viewshed_num_threads():
+    make_viewshed_input()
+    _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -num_threads 3 -oz {} -ox {} -oy {} {} {}'.format(oz[0], ox[0], oy[0], viewshed_in, viewshed_out))
+    assert err is None or err == ''
+    ds = gdal.Open(viewshed_out)
+    assert ds
+    cs = ds.GetRasterBand(1).Checksum()
+    ds = None
+    gdal.Unlink(viewshed_out)
+    assert cs == 42397
+
+    _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -num_threads 3 -om NORMAL -f GTiff -oz {} -ox {} -oy {} -b 1 -a_nodata 0 -tz 5 -md 20000 -cc 0.85714 -iv 127 -vv 254 -ov 0 {} {}'.format(oz[1], ox[0], oy[0], viewshed_in, viewshed_out))
+    assert err is None or err == ''
+    ds = gdal.Open(viewshed_out)
+    assert ds
+    cs = ds.GetRasterBand(1).Checksum()
+    ds = None
+    gdal.Unlink(viewshed_in)
+    gdal.Unlink(viewshed_out)
+    assert cs == 24412
+
+
+###############################################################################
+
+
+@pytest.mark.parametrize('num_threads', [None, '3'])
+def test_gdal_viewshed_cumulative(num_threads):
+    make_viewshed_input()
+    observers = [(ox[0], oy[0]), (ox[0] + 10000, oy[0] - 10000)]
+
+    expected = None
+    for x, y in observers:
+        _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -oz {} -ox {} -oy {} -vv 1 -iv 0 -ov 0 {} {}'.format(oz[0], x, y, viewshed_in, viewshed_out))
+        assert err is None or err == ''
+        ds = gdal.Open(viewshed_out)
+        data = struct.unpack('B' * ds.RasterXSize * ds.RasterYSize, ds.GetRasterBand(1).ReadRaster())
+        ds = None
+        if expected is None:
+            expected = list(data)
+        else:
+            expected = [a + b for a, b in zip(expected, data)]
+    gdal.Unlink(viewshed_out)
+
+    options = ' '.join('-ox {} -oy {}'.format(x, y) for x, y in observers)
+    if num_threads:
+        options += ' -num_threads ' + num_threads
+    _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -oz {} {} {} {}'.format(oz[0], options, viewshed_in, viewshed_out))
+    assert err is None or err == ''
+    ds = gdal.Open(viewshed_out)
+    assert ds.GetRasterBand(1).DataType == gdal.GDT_UInt32
+    got = struct.unpack('I' * ds.RasterXSize * ds.RasterYSize, ds.GetRasterBand(1).ReadRaster())
+    ds = None
+    gdal.Unlink(viewshed_in)
+    gdal.Unlink(viewshed_out)
+    assert list(got) == expected
+    assert max(got) > 0
+
+
+###############################################################################
+
+
 def test_gdal_viewshed_missing_source():
 
     _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path())
@@ -150,6 +213,16 @@ def test_gdal_viewshed_missing_oy():
 ###############################################################################
 
 
+@pytest.mark.parametrize('option', ['-vv 1', '-iv 1', '-ov 1', '-a_nodata 1'])
+def test_gdal_viewshed_cumulative_single_observer_option(option):
+
+    _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -ox 0 -oy 0 -ox 1 -oy 1 {} /dev/null /dev/null'.format(option))
+    assert '{} cannot be used with several observers'.format(option.split(' ')[0]) in err
+
+
+###############################################################################
+
+
 def test_gdal_viewshed_invalid_input():
 
     _, err = gdaltest.runexternal_out_and_err(test_cli_utilities.get_gdal_viewshed_path() + ' -ox 0 -oy 0 /dev/null /dev/null')
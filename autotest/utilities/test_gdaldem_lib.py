@@ -518,7 +518,68 @@ def test_gdaldem_lib_nodata():
         print(ds.ReadAsArray())  # Should be 0 0 0 0 181 0 0 0 0
         pytest.fail('Bad checksum')
 
+###############################################################################
+# Test that multi-threaded processing gives the same result as the sequential
+# one
+
+
+@pytest.mark.parametrize('processing,alg', [('hillshade', None),
+                                            ('hillshade', 'ZevenbergenThorne'),
+                                            ('slope', None),
+                                            ('aspect', None),
+                                            ('TRI', 'Wilson'),
+                                            ('TRI', 'Riley'),
+                                            ('TPI', None),
+                                            ('roughness', None)])
+@pytest.mark.parametrize('datatype', [gdal.GDT_Int16, gdal.GDT_Float32])
+def test_gdaldem_lib_num_threads(processing, alg, datatype):
+
+    src_ds = gdal.Translate('', '../gdrivers/data/n43.dt0', format='MEM',
+                            outputType=datatype)
+    src_ds.GetRasterBand(1).SetNoDataValue(50)
+
+    for computeEdges in (False, True):
+        ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                                alg=alg, computeEdges=computeEdges)
+        ref_data = ds.GetRasterBand(1).ReadRaster()
+
+        with gdaltest.config_option('GDALDEM_STRIP_HEIGHT', '7'):
+            ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                                    alg=alg, computeEdges=computeEdges,
+                                    numThreads=4)
+        assert ds.GetRasterBand(1).ReadRaster() == ref_data
+
+        ds = gdal.DEMProcessing('', src_ds, processing, format='MEM',
+                                alg=alg, computeEdges=computeEdges,
+                                numThreads='ALL_CPUS')
+        assert ds.GetRasterBand(1).ReadRaster() == ref_data
+
+###############################################################################
+# Test that errors of the strip jobs are reported on the calling thread
+
+
+def test_gdaldem_lib_num_threads_error():
+
+    src_ds = gdal.Open('../gcore/data/byte_truncated.tif')
+    gdal.ErrorReset()
+    with gdaltest.config_option('GDALDEM_STRIP_HEIGHT', '5'):
+        with gdaltest.error_handler():
+            gdal.DEMProcessing('', src_ds, 'hillshade', format='MEM',
+                               numThreads=2)
+    assert gdal.GetLastErrorType() == gdal.CE_Failure
+    assert gdal.GetLastErrorMsg() != ''
 
+###############################################################################
+# Test invalid -num_threads
+
+
+def test_gdaldem_lib_num_threads_invalid():
+
+    src_ds = gdal.Open('../gdrivers/data/n43.dt0')
+    with gdaltest.error_handler():
+        ds = gdal.DEMProcessing('', src_ds, 'hillshade', format='MEM',
+                                numThreads=0)
+    assert ds is None
 
 
 
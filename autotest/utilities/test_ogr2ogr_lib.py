@@ -29,7 +29,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
-from osgeo import gdal, gdalconst, ogr
+from osgeo import gdal, gdalconst, ogr, osr
 import gdaltest
 import ogrtest
 import pytest
@@ -693,3 +693,96 @@ def test_ogr2ogr_fielddomain_():
     f = lyr.GetNextFeature()
     assert f['bar'] == -1
     assert not f.IsFieldSet('bar_resolved')
+
+###############################################################################
+# Test -num_threads
+
+
+@pytest.mark.parametrize('options', ['', '-t_srs EPSG:4326',
+                                     '-explodecollections -clipsrc 479000 4764000 481000 4766000',
+                                     '-limit 7', '-skipfailures -gt 3'])
+def test_ogr2ogr_lib_num_threads(options):
+
+    src_ds = gdal.GetDriverByName('Memory').Create('', 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(26717)
+    src_lyr = src_ds.CreateLayer('test', srs=srs, geom_type=ogr.wkbUnknown)
+    src_lyr.CreateField(ogr.FieldDefn('id', ogr.OFTInteger))
+    for i in range(1000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f['id'] = i
+        x = 478000 + (i % 40) * 100
+        y = 4763000 + (i // 40) * 150
+        if i % 3 == 0:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(
+                'MULTIPOINT ((%d %d),(%d %d))' % (x, y, x + 50, y + 50)))
+        elif i % 3 == 1:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(
+                'POLYGON ((%d %d,%d %d,%d %d,%d %d))' % (x, y, x + 90, y, x + 90, y + 90, x, y)))
+        src_lyr.CreateFeature(f)
+
+    def translate(num_threads):
+        ds = gdal.VectorTranslate('', src_ds, format='Memory',
+                                  options=options + ' -num_threads ' + num_threads)
+        lyr = ds.GetLayer(0)
+        return [(f['id'], f.GetGeometryRef().ExportToWkt() if f.GetGeometryRef() else None) for f in lyr]
+
+    ref = translate('1')
+    assert ref
+    assert translate('4') == ref
+    assert translate('ALL_CPUS') == ref
+
+    # Source and target datasets are the same: no reader thread
+    src_ds.CopyLayer(src_lyr, 'test_copy')
+    ds = gdal.VectorTranslate(src_ds, src_ds, options=options + ' -nln test_out -num_threads 4 test_copy')
+    assert ds is not None
+    lyr = src_ds.GetLayerByName('test_out')
+    assert [(f['id'], f.GetGeometryRef().ExportToWkt() if f.GetGeometryRef() else None) for f in lyr] == ref
+
+
+###############################################################################
+# Test that errors emitted by worker threads with -num_threads reach the
+# error handler of the calling thread, in feature order
+
+
+def test_ogr2ogr_lib_num_threads_errors():
+
+    src_ds = gdal.GetDriverByName('Memory').Create('', 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+    src_lyr = src_ds.CreateLayer('test', srs=srs, geom_type=ogr.wkbPoint)
+    src_lyr.CreateField(ogr.FieldDefn('id', ogr.OFTInteger))
+    for i in range(500):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f['id'] = i
+        # A few points that cannot be reprojected
+        lat = 100 if i % 100 == 50 else 45
+        f.SetGeometry(ogr.CreateGeometryFromWkt('POINT (2 %d)' % lat))
+        src_lyr.CreateFeature(f)
+
+    def translate(num_threads):
+        messages = []
+
+        def handler(err_class, err_no, err_msg):
+            messages.append((err_class, err_msg))
+
+        gdal.PushErrorHandler(handler)
+        try:
+            ds = gdal.VectorTranslate('', src_ds, format='Memory',
+                                      options='-skipfailures -t_srs EPSG:32631 -num_threads ' + num_threads)
+        finally:
+            gdal.PopErrorHandler()
+        assert ds.GetLayer(0).GetFeatureCount() == 495
+        return messages
+
+    ref = translate('1')
+    assert ref
+    assert translate('4') == ref
+
+
+def test_ogr2ogr_lib_num_threads_invalid():
+
+    src_ds = gdal.OpenEx('../ogr/data/poly.shp')
+    with gdaltest.error_handler():
+        assert gdal.VectorTranslate('', src_ds, format='Memory', options='-num_threads invalid') is None
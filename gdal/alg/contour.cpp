@@ -34,6 +34,7 @@
 #include "utility.h"
 #include "contour_generator.h"
 #include "segment_merger.h"
+#include "tiled_contour_generator.h"
 
 #include "gdal.h"
 #include "gdal_alg.h"
@@ -196,6 +197,29 @@ private:
     void *data_;
 };
 
+/************************************************************************/
+/*                           ContourProcess()                           */
+/************************************************************************/
+
+template <typename RingAppender, typename LevelGenerator>
+static bool ContourProcess( GDALRasterBandH hBand, bool useNoData, double noDataValue,
+                            RingAppender& appender, LevelGenerator& levels,
+                            bool polygonize, int numThreads,
+                            GDALProgressFunc pfnProgress, void *pProgressArg )
+{
+    using namespace marching_squares;
+
+    if ( numThreads > 0 )
+    {
+        TiledContourGeneratorFromRaster<RingAppender, LevelGenerator> cg( hBand, useNoData, noDataValue, appender, levels, polygonize, numThreads );
+        return cg.process( pfnProgress, pProgressArg );
+    }
+
+    SegmentMerger<RingAppender, LevelGenerator> writer(appender, levels, polygonize);
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg( hBand, useNoData, noDataValue, writer, levels );
+    return cg.process( pfnProgress, pProgressArg );
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -517,6 +541,14 @@ an averaged value from the two nearby points (in this case (12+3+5)/3).
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=d|ALL_CPUS
+ *
+ * (GDAL >= 3.4) When set, the raster is split into strips of lines whose
+ * contours are generated independently by that number of worker threads.
+ * Lines (or polygon rings) crossing a strip boundary are merged once the
+ * strips on both sides are done. The same contours are produced as without this option, but
+ * they may be written in a different order, and start at a different vertex.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -600,6 +632,8 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool( options, "POLYGONIZE", false );
 
+    const int numThreads = GDALGetNumThreads( options, "NUM_THREADS", 0 );
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -630,21 +664,15 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             RingAppender appender( w );
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size(), GDALGetRasterMaximum( hBand, &bSuccess ) );
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ true, numThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<RingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ true, numThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<RingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ true, numThreads, pfnProgress, pProgressArg );
             }
         }
         else
@@ -652,21 +680,15 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             GDALRingAppender appender(OGRContourWriter, &oCWI);
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size() );
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ false, numThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ false, numThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourProcess( hBand, useNoData, noDataValue, appender, levels, /* polygonize */ false, numThreads, pfnProgress, pProgressArg );
             }
         }
     }
@@ -34,6 +34,10 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -258,85 +262,518 @@ static int CutlineTransformer( void *pTransformArg,
 }
 
 /************************************************************************/
-/*                       GDALWarpCutlineMasker()                        */
-/*                                                                      */
-/*      This function will generate a source mask based on a            */
-/*      provided cutline, and optional blend distance.                  */
+/* ==================================================================== */
+/*                         GDALWarpCutlineCache                         */
+/* ==================================================================== */
 /************************************************************************/
 
-CPLErr
-GDALWarpCutlineMasker( void *pMaskFuncArg,
-                       int /* nBandCount */,
-                       GDALDataType /* eType */,
-                       int nXOff, int nYOff, int nXSize, int nYSize,
-                       GByte ** /*ppImageData */,
-                       int bMaskIsFloat, void *pValidityMask )
+/* The cutline cache holds the edges of the cutline, in source pixel/line
+ * coordinates, with an index by lines. It is built once per warp operation
+ * and lets GDALWarpCutlineMaskerEx() scan-convert, for each chunk, only the
+ * edges that cross the lines of the chunk, with the same pixel selection
+ * as GDALRasterizeGeometries() (pixel centers, even-odd rule applied to
+ * each polygon of the cutline separately).
+ */
 
+namespace {
+struct GDALCutlineEdge
 {
-    if( nXSize < 1 || nYSize < 1 )
-        return CE_None;
+    // In the order of the points of the ring, as in
+    // GDALCollectRingsFromGeometry().
+    double dfX1 = 0;
+    double dfY1 = 0;
+    double dfX2 = 0;
+    double dfY2 = 0;
+    int    nPolygon = 0;
+};
+
+struct GDALCutlineCrossing
+{
+    int nLine;
+    int nPolygon;
+    int nX;
 
-/* -------------------------------------------------------------------- */
-/*      Do some minimal checking.                                       */
-/* -------------------------------------------------------------------- */
-    if( !bMaskIsFloat )
+    bool operator< ( const GDALCutlineCrossing& other ) const
     {
-        CPLAssert( false );
-        return CE_Failure;
+        if( nLine != other.nLine )
+            return nLine < other.nLine;
+        if( nPolygon != other.nPolygon )
+            return nPolygon < other.nPolygon;
+        return nX < other.nX;
     }
+};
 
-    GDALWarpOptions *psWO = static_cast<GDALWarpOptions *>(pMaskFuncArg);
+typedef enum
+{
+    CUTLINE_CHUNK_OUTSIDE,
+    CUTLINE_CHUNK_INSIDE,
+    CUTLINE_CHUNK_PARTIAL,
+} GDALCutlineChunkStatus;
+}  // namespace
 
-    if( psWO == nullptr || psWO->hCutline == nullptr )
+struct GDALWarpCutlineCache
+{
+    std::vector<GDALCutlineEdge> asEdges{};
+
+    // Edges are indexed by buckets of nBucketHeight lines starting at
+    // dfYOrigin. An edge is referenced by all the buckets it overlaps.
+    double dfYOrigin = 0;
+    double dfBucketHeight = 1;
+    int    nBuckets = 0;
+    std::vector<size_t> anBucketStart{};
+    std::vector<int>    anBucketEdges{};
+
+    int GetBucket( double dfY ) const
     {
-        CPLAssert( false );
-        return CE_Failure;
+        const double dfBucket = floor((dfY - dfYOrigin) / dfBucketHeight);
+        if( !(dfBucket >= 0) )
+            return 0;
+        if( dfBucket >= nBuckets - 1 )
+            return nBuckets - 1;
+        return static_cast<int>(dfBucket);
     }
 
-    GDALDriverH hMemDriver = GDALGetDriverByName("MEM");
-    if( hMemDriver == nullptr )
+    template<class F> void ForEachEdge( double dfYMin, double dfYMax,
+                                        F&& f ) const;
+};
+
+/************************************************************************/
+/*                     GDALWarpCutlineCache::ForEachEdge()              */
+/*                                                                      */
+/*      Call f() once for each edge that may overlap [dfYMin,dfYMax].   */
+/************************************************************************/
+
+template<class F>
+void GDALWarpCutlineCache::ForEachEdge( double dfYMin, double dfYMax,
+                                        F&& f ) const
+{
+    if( nBuckets == 0 )
+        return;
+    const int nFirstBucket = GetBucket(dfYMin);
+    const int nLastBucket = GetBucket(dfYMax);
+    for( int iBucket = nFirstBucket; iBucket <= nLastBucket; iBucket++ )
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "GDALWarpCutlineMasker needs MEM driver");
-        return CE_Failure;
+        for( size_t i = anBucketStart[iBucket];
+             i < anBucketStart[iBucket + 1]; i++ )
+        {
+            const GDALCutlineEdge& sEdge = asEdges[anBucketEdges[i]];
+            const double dfEdgeMinY = std::min(sEdge.dfY1, sEdge.dfY2);
+            const double dfEdgeMaxY = std::max(sEdge.dfY1, sEdge.dfY2);
+            // Visit edges that span several buckets only once.
+            if( std::max(GetBucket(dfEdgeMinY), nFirstBucket) != iBucket ||
+                dfEdgeMinY > dfYMax || dfEdgeMaxY < dfYMin )
+                continue;
+            f(sEdge);
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALCutlineCollectEdges()                       */
+/************************************************************************/
+
+static void GDALCutlineCollectEdges( const OGRGeometry *poGeom,
+                                     int& nPolygon,
+                                     std::vector<GDALCutlineEdge>& asEdges )
+{
+    if( poGeom == nullptr || poGeom->IsEmpty() )
+        return;
+
+    const OGRwkbGeometryType eFlatType = wkbFlatten(poGeom->getGeometryType());
+    if( eFlatType == wkbMultiPolygon )
+    {
+        // Each polygon is rasterized separately.
+        for( const auto poPart: *(poGeom->toMultiPolygon()) )
+            GDALCutlineCollectEdges(poPart, nPolygon, asEdges);
+        return;
+    }
+    if( eFlatType != wkbPolygon )
+        return;
+
+    const auto poPolygon = poGeom->toPolygon();
+    for( const auto poRing: *poPolygon )
+    {
+        const int nCount = poRing->getNumPoints();
+        // Counter-clockwise rings are reversed by
+        // GDALCollectRingsFromGeometry(), which matters for horizontal
+        // edges.
+        const bool bClockwise = CPL_TO_BOOL(poRing->isClockwise());
+        for( int i = 0; i < nCount; i++ )
+        {
+            const int iPrev = (i == 0) ? nCount - 1 : i - 1;
+            const int ind1 = bClockwise ? iPrev : nCount - 1 - iPrev;
+            const int ind2 = bClockwise ? i : nCount - 1 - i;
+            GDALCutlineEdge sEdge;
+            sEdge.dfX1 = poRing->getX(ind1);
+            sEdge.dfY1 = poRing->getY(ind1);
+            sEdge.dfX2 = poRing->getX(ind2);
+            sEdge.dfY2 = poRing->getY(ind2);
+            sEdge.nPolygon = nPolygon;
+            asEdges.push_back(sEdge);
+        }
     }
+    nPolygon++;
+}
+
+/************************************************************************/
+/*                     GDALCreateWarpCutlineCache()                     */
+/************************************************************************/
+
+/**
+ * Build the cutline cache used by GDALWarpCutlineMaskerEx().
+ *
+ * @param hCutline polygon or multipolygon in source pixel/line coordinates.
+ * @return the cache, to free with GDALDestroyWarpCutlineCache(), or NULL if
+ * the cutline is not polygonal.
+ */
+void *GDALCreateWarpCutlineCache( void *hCutline )
+{
+    const OGRGeometry *poCutline = static_cast<const OGRGeometry*>(hCutline);
+    if( poCutline == nullptr )
+        return nullptr;
+    const OGRwkbGeometryType eFlatType =
+        wkbFlatten(poCutline->getGeometryType());
+    if( eFlatType != wkbPolygon && eFlatType != wkbMultiPolygon )
+        return nullptr;
+
+    auto poCache = new (std::nothrow) GDALWarpCutlineCache();
+    if( poCache == nullptr )
+        return nullptr;
+    try
+    {
+        int nPolygon = 0;
+        GDALCutlineCollectEdges(poCutline, nPolygon, poCache->asEdges);
+
+        const size_t nEdges = poCache->asEdges.size();
+        if( nEdges == 0 )
+            return poCache;
+
+        double dfMinY = std::numeric_limits<double>::infinity();
+        double dfMaxY = -std::numeric_limits<double>::infinity();
+        for( const auto& sEdge: poCache->asEdges )
+        {
+            dfMinY = std::min(dfMinY, std::min(sEdge.dfY1, sEdge.dfY2));
+            dfMaxY = std::max(dfMaxY, std::max(sEdge.dfY1, sEdge.dfY2));
+        }
+        if( !(dfMinY <= dfMaxY) ||
+            !CPLIsFinite(dfMinY) || !CPLIsFinite(dfMaxY) )
+        {
+            delete poCache;
+            return nullptr;
+        }
+
+        // Buckets of 64 lines, unless this would create much more bucket
+        // references than there are edges.
+        const double dfMaxBuckets =
+            std::min(1e6, 4.0 * static_cast<double>(nEdges) + 16);
+        poCache->dfYOrigin = floor(dfMinY);
+        poCache->dfBucketHeight =
+            std::max(64.0, (dfMaxY - poCache->dfYOrigin + 1) / dfMaxBuckets);
+        while( true )
+        {
+            poCache->nBuckets = static_cast<int>(
+                (dfMaxY - poCache->dfYOrigin) / poCache->dfBucketHeight) + 1;
+            size_t nRefs = 0;
+            for( const auto& sEdge: poCache->asEdges )
+            {
+                nRefs += 1 +
+                    poCache->GetBucket(std::max(sEdge.dfY1, sEdge.dfY2)) -
+                    poCache->GetBucket(std::min(sEdge.dfY1, sEdge.dfY2));
+            }
+            if( nRefs <= 8 * nEdges + poCache->nBuckets ||
+                poCache->nBuckets == 1 )
+            {
+                break;
+            }
+            poCache->dfBucketHeight *= 2;
+        }
+
+        auto& anBucketStart = poCache->anBucketStart;
+        anBucketStart.assign(poCache->nBuckets + 1, 0);
+        for( const auto& sEdge: poCache->asEdges )
+        {
+            const int nFirst =
+                poCache->GetBucket(std::min(sEdge.dfY1, sEdge.dfY2));
+            const int nLast =
+                poCache->GetBucket(std::max(sEdge.dfY1, sEdge.dfY2));
+            for( int iBucket = nFirst; iBucket <= nLast; iBucket++ )
+                anBucketStart[iBucket + 1]++;
+        }
+        for( int iBucket = 0; iBucket < poCache->nBuckets; iBucket++ )
+            anBucketStart[iBucket + 1] += anBucketStart[iBucket];
+
+        poCache->anBucketEdges.resize(anBucketStart.back());
+        std::vector<size_t> anPos(anBucketStart.begin(),
+                                  anBucketStart.end() - 1);
+        for( size_t i = 0; i < nEdges; i++ )
+        {
+            const auto& sEdge = poCache->asEdges[i];
+            const int nFirst =
+                poCache->GetBucket(std::min(sEdge.dfY1, sEdge.dfY2));
+            const int nLast =
+                poCache->GetBucket(std::max(sEdge.dfY1, sEdge.dfY2));
+            for( int iBucket = nFirst; iBucket <= nLast; iBucket++ )
+                poCache->anBucketEdges[anPos[iBucket]++] = static_cast<int>(i);
+        }
+    }
+    catch( const std::exception& )
+    {
+        delete poCache;
+        return nullptr;
+    }
+
+    CPLDebug("WARP", "Cutline cache: %d edges, %d buckets of %.0f lines",
+             static_cast<int>(poCache->asEdges.size()),
+             poCache->nBuckets, poCache->dfBucketHeight);
+    return poCache;
+}
+
+/************************************************************************/
+/*                    GDALDestroyWarpCutlineCache()                     */
+/************************************************************************/
+
+void GDALDestroyWarpCutlineCache( void *pCutlineCache )
+{
+    delete static_cast<GDALWarpCutlineCache*>(pCutlineCache);
+}
+
+/************************************************************************/
+/*                       GDALCutlineLineRange()                         */
+/*                                                                      */
+/*      Range of lines iY such that dfY1 <= iY + 0.5 < dfY2, clamped    */
+/*      to [0, nYSize-1]. Returns false if empty.                       */
+/************************************************************************/
+
+static bool GDALCutlineLineRange( double dfY1, double dfY2, int nYSize,
+                                  int& nFirstLine, int& nLastLine )
+{
+    double dfFirst = ceil(dfY1 - 0.5);
+    double dfLast = ceil(dfY2 - 0.5) - 1;
+    if( !(dfFirst <= nYSize) || !(dfLast >= -1) )
+        return false;
+    nFirstLine = static_cast<int>(std::max(dfFirst, -1.0));
+    nLastLine = static_cast<int>(std::min(dfLast, static_cast<double>(nYSize)));
+    // Make sure we use exactly the same tests as GDALdllImageFilledPolygon()
+    while( nFirstLine + 0.5 < dfY1 )
+        nFirstLine++;
+    while( nFirstLine - 0.5 >= dfY1 )
+        nFirstLine--;
+    while( nLastLine + 0.5 >= dfY2 )
+        nLastLine--;
+    while( nLastLine + 1.5 < dfY2 )
+        nLastLine++;
+    nFirstLine = std::max(nFirstLine, 0);
+    nLastLine = std::min(nLastLine, nYSize - 1);
+    return nFirstLine <= nLastLine;
+}
+
+/************************************************************************/
+/*                      GDALCutlineRasterizeChunk()                     */
+/*                                                                      */
+/*      Burn the cutline into pabyPolyMask, a zero-initialized buffer   */
+/*      of nXSize * nYSize bytes, as GDALRasterizeGeometries() with     */
+/*      CutlineTransformer would do. Edges entirely on the left of the  */
+/*      chunk only contribute to the parity of the lines they cross,    */
+/*      and edges entirely on its right are ignored. The mask is left   */
+/*      untouched if the chunk is entirely inside or outside.           */
+/************************************************************************/
+
+static GDALCutlineChunkStatus
+GDALCutlineRasterizeChunk( const GDALWarpCutlineCache* poCache,
+                           int nXOff, int nYOff, int nXSize, int nYSize,
+                           GByte* pabyPolyMask )
+{
+    std::vector<GDALCutlineCrossing> asCrossings;
+    // Start and end+1 lines of the edges on the left of the chunk.
+    std::vector<std::pair<int, int>> anLeftEvents;
+    bool bHasHorizontalFill = false;
+
+    const auto FillLine = [pabyPolyMask, nXSize](int iY, int nX1, int nX2)
+    {
+        // Same clamping as gvBurnScanline()
+        nX1 = std::max(nX1, 0);
+        nX2 = std::min(nX2, nXSize - 1);
+        if( nX1 <= nX2 )
+        {
+            memset(pabyPolyMask + static_cast<size_t>(iY) * nXSize + nX1,
+                   255, nX2 - nX1 + 1);
+        }
+    };
+    // floor(dfX + 0.5), clamped to [0, nXSize] which does not change the
+    // burnt pixels.
+    const auto RoundX = [nXSize](double dfX)
+    {
+        const double dfRounded = floor(dfX + 0.5);
+        if( !(dfRounded > 0) )
+            return 0;
+        if( dfRounded >= nXSize )
+            return nXSize;
+        return static_cast<int>(dfRounded);
+    };
+
+    poCache->ForEachEdge(
+        static_cast<double>(nYOff) - 1,
+        static_cast<double>(nYOff) + nYSize + 1,
+        [&](const GDALCutlineEdge& sEdge)
+    {
+        // Same computations as CutlineTransformer() and
+        // GDALdllImageFilledPolygon().
+        const double dfX1 = sEdge.dfX1 - nXOff;
+        const double dfX2 = sEdge.dfX2 - nXOff;
+        double dy1 = sEdge.dfY1 - nYOff;
+        double dy2 = sEdge.dfY2 - nYOff;
+
+        if( dy1 == dy2 )
+        {
+            // Bottom horizontal segments are filled separately.
+            const double dfLine = floor(dy1);
+            if( dfX1 > dfX2 && dfLine >= 0 && dfLine < nYSize &&
+                dfLine + 0.5 == dy1 )
+            {
+                const int nX1 = RoundX(dfX2);
+                const int nX2 = RoundX(dfX1);
+                if( nX1 < nX2 )
+                {
+                    FillLine(static_cast<int>(dfLine), nX1, nX2 - 1);
+                    bHasHorizontalFill = true;
+                }
+            }
+            return;
+        }
+
+        double dx1 = dfX1;
+        double dx2 = dfX2;
+        if( dy1 > dy2 )
+        {
+            std::swap(dy1, dy2);
+            std::swap(dx1, dx2);
+        }
+
+        int nFirstLine = 0;
+        int nLastLine = 0;
+        if( !GDALCutlineLineRange(dy1, dy2, nYSize, nFirstLine, nLastLine) )
+            return;
+
+        // A margin of 0.25 pixel makes sure that the rounded intersections
+        // would be <= 0 or >= nXSize.
+        if( std::max(dx1, dx2) < 0.25 )
+        {
+            anLeftEvents.emplace_back(sEdge.nPolygon, nFirstLine);
+            anLeftEvents.emplace_back(sEdge.nPolygon, nLastLine + 1);
+            return;
+        }
+        if( std::min(dx1, dx2) > nXSize - 0.25 )
+            return;
+
+        for( int iY = nFirstLine; iY <= nLastLine; iY++ )
+        {
+            const double dy = iY + 0.5;
+            const double intersect = (dy-dy1) * (dx2-dx1) / (dy2-dy1) + dx1;
+            asCrossings.push_back({iY, sEdge.nPolygon, RoundX(intersect)});
+        }
+    });
 
 /* -------------------------------------------------------------------- */
-/*      Check the polygon.                                              */
+/*      Edges on the left of the chunk are equivalent to a crossing at  */
+/*      x=0 on the lines where there is an odd number of them.          */
 /* -------------------------------------------------------------------- */
-    OGRGeometryH hPolygon = static_cast<OGRGeometryH>(psWO->hCutline);
+    std::sort(anLeftEvents.begin(), anLeftEvents.end());
+    std::vector<bool> abLineInside;
+    const bool bUniformLines = asCrossings.empty() && !bHasHorizontalFill;
+    if( bUniformLines )
+        abLineInside.resize(nYSize);
+    for( size_t i = 0; i + 1 < anLeftEvents.size(); )
+    {
+        // Events of a polygon come by pairs, so toggling the parity at
+        // each event leaves it even after the last one.
+        const int nPolygon = anLeftEvents[i].first;
+        size_t j = i;
+        bool bOdd = false;
+        for( ; j + 1 < anLeftEvents.size() &&
+               anLeftEvents[j + 1].first == nPolygon; j++ )
+        {
+            bOdd = !bOdd;
+            if( !bOdd )
+                continue;
+            for( int iY = anLeftEvents[j].second;
+                 iY < anLeftEvents[j + 1].second; iY++ )
+            {
+                if( bUniformLines )
+                    abLineInside[iY] = true;
+                else
+                    asCrossings.push_back({iY, nPolygon, 0});
+            }
+        }
+        i = j + 1;
+    }
 
-    if( wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbPolygon
-        && wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbMultiPolygon )
+    if( bUniformLines )
     {
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "Cutline should be a polygon or a multipolygon");
-        return CE_Failure;
+        const auto nInside = std::count(abLineInside.begin(),
+                                        abLineInside.end(), true);
+        if( nInside == 0 )
+            return CUTLINE_CHUNK_OUTSIDE;
+        if( nInside == nYSize )
+            return CUTLINE_CHUNK_INSIDE;
+        for( int iY = 0; iY < nYSize; iY++ )
+        {
+            if( abLineInside[iY] )
+                FillLine(iY, 0, nXSize - 1);
+        }
+        return CUTLINE_CHUNK_PARTIAL;
     }
 
-    OGREnvelope sEnvelope;
-    OGR_G_GetEnvelope( hPolygon, &sEnvelope );
+/* -------------------------------------------------------------------- */
+/*      Fill between pairs of crossings of each polygon, as             */
+/*      GDALdllImageFilledPolygon() does. Crossings on the right of     */
+/*      the chunk were skipped: complete odd lists with nXSize.         */
+/* -------------------------------------------------------------------- */
+    std::sort(asCrossings.begin(), asCrossings.end());
+    for( size_t i = 0; i < asCrossings.size(); )
+    {
+        size_t j = i;
+        while( j < asCrossings.size() &&
+               asCrossings[j].nLine == asCrossings[i].nLine &&
+               asCrossings[j].nPolygon == asCrossings[i].nPolygon )
+        {
+            j++;
+        }
+        const int iY = asCrossings[i].nLine;
+        for( size_t k = i; k < j; k += 2 )
+        {
+            const int nX2 = (k + 1 < j) ? asCrossings[k + 1].nX : nXSize;
+            FillLine(iY, asCrossings[k].nX, nX2 - 1);
+        }
+        i = j;
+    }
 
-    float *pafMask = static_cast<float *>(pValidityMask);
+    return CUTLINE_CHUNK_PARTIAL;
+}
 
-    if( sEnvelope.MaxX + psWO->dfCutlineBlendDist < nXOff
-        || sEnvelope.MinX - psWO->dfCutlineBlendDist > nXOff + nXSize
-        || sEnvelope.MaxY + psWO->dfCutlineBlendDist < nYOff
-        || sEnvelope.MinY - psWO->dfCutlineBlendDist > nYOff + nYSize )
+/************************************************************************/
+/*                      GDALCutlineRasterizeMEM()                       */
+/*                                                                      */
+/*      Burn the cutline into pabyPolyMask with                         */
+/*      GDALRasterizeGeometries().                                      */
+/************************************************************************/
+
+static CPLErr GDALCutlineRasterizeMEM( GDALWarpOptions *psWO,
+                                       OGRGeometryH hPolygon,
+                                       int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       GByte *pabyPolyMask )
+{
+    GDALDriverH hMemDriver = GDALGetDriverByName("MEM");
+    if( hMemDriver == nullptr )
     {
-        // We are far from the blend line - everything is masked to zero.
-        // It would be nice to realize no work is required for this whole
-        // chunk!
-        memset( pafMask, 0, sizeof(float) * nXSize * nYSize );
-        return CE_None;
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GDALWarpCutlineMasker needs MEM driver");
+        return CE_Failure;
     }
 
 /* -------------------------------------------------------------------- */
-/*      Create a byte buffer into which we can burn the                 */
-/*      mask polygon and wrap it up as a memory dataset.                */
+/*      Wrap up the byte buffer as a memory dataset.                    */
 /* -------------------------------------------------------------------- */
-    GByte *pabyPolyMask = static_cast<GByte *>(CPLCalloc(nXSize, nYSize));
-
     char szDataPointer[100] = {};
 
     // cppcheck-suppress redundantCopy
@@ -379,23 +816,189 @@ GDALWarpCutlineMasker( void *pMaskFuncArg,
     // Close and ensure data flushed to underlying array.
     GDALClose( hMemDS );
 
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GDALWarpCutlineMasker()                        */
+/*                                                                      */
+/*      This function will generate a source mask based on a            */
+/*      provided cutline, and optional blend distance.                  */
+/************************************************************************/
+
+CPLErr
+GDALWarpCutlineMasker( void *pMaskFuncArg,
+                       int nBandCount,
+                       GDALDataType eType,
+                       int nXOff, int nYOff, int nXSize, int nYSize,
+                       GByte ** ppImageData,
+                       int bMaskIsFloat, void *pValidityMask )
+
+{
+    return GDALWarpCutlineMaskerEx( pMaskFuncArg, nBandCount, eType,
+                                    nXOff, nYOff, nXSize, nYSize,
+                                    ppImageData,
+                                    bMaskIsFloat, pValidityMask, nullptr );
+}
+
+/************************************************************************/
+/*                      GDALWarpCutlineMaskerEx()                       */
+/*                                                                      */
+/*      Same as GDALWarpCutlineMasker(), using a cutline cache          */
+/*      created with GDALCreateWarpCutlineCache() for psWO->hCutline    */
+/*      when pCutlineCache is not NULL. Chunks entirely inside or       */
+/*      outside of the cutline are then detected without rasterizing    */
+/*      it.                                                             */
+/************************************************************************/
+
+CPLErr
+GDALWarpCutlineMaskerEx( void *pMaskFuncArg,
+                         int /* nBandCount */,
+                         GDALDataType /* eType */,
+                         int nXOff, int nYOff, int nXSize, int nYSize,
+                         GByte ** /*ppImageData */,
+                         int bMaskIsFloat, void *pValidityMask,
+                         void *pCutlineCache )
+
+{
+    if( nXSize < 1 || nYSize < 1 )
+        return CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Do some minimal checking.                                       */
+/* -------------------------------------------------------------------- */
+    if( !bMaskIsFloat )
+    {
+        CPLAssert( false );
+        return CE_Failure;
+    }
+
+    GDALWarpOptions *psWO = static_cast<GDALWarpOptions *>(pMaskFuncArg);
+
+    if( psWO == nullptr || psWO->hCutline == nullptr )
+    {
+        CPLAssert( false );
+        return CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Check the polygon.                                              */
+/* -------------------------------------------------------------------- */
+    OGRGeometryH hPolygon = static_cast<OGRGeometryH>(psWO->hCutline);
+
+    if( wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbPolygon
+        && wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbMultiPolygon )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cutline should be a polygon or a multipolygon");
+        return CE_Failure;
+    }
+
+    OGREnvelope sEnvelope;
+    OGR_G_GetEnvelope( hPolygon, &sEnvelope );
+
+    float *pafMask = static_cast<float *>(pValidityMask);
+
+    if( sEnvelope.MaxX + psWO->dfCutlineBlendDist < nXOff
+        || sEnvelope.MinX - psWO->dfCutlineBlendDist > nXOff + nXSize
+        || sEnvelope.MaxY + psWO->dfCutlineBlendDist < nYOff
+        || sEnvelope.MinY - psWO->dfCutlineBlendDist > nYOff + nYSize )
+    {
+        // We are far from the blend line - everything is masked to zero.
+        memset( pafMask, 0, sizeof(float) * nXSize * nYSize );
+        return CE_None;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Use a temporary cutline cache if none was provided.             */
+/* -------------------------------------------------------------------- */
+    void *pTmpCutlineCache = nullptr;
+    if( pCutlineCache == nullptr )
+    {
+        pTmpCutlineCache = GDALCreateWarpCutlineCache(hPolygon);
+        pCutlineCache = pTmpCutlineCache;
+    }
+    const GDALWarpCutlineCache *poCache =
+        static_cast<const GDALWarpCutlineCache *>(pCutlineCache);
+
+/* -------------------------------------------------------------------- */
+/*      With CUTLINE_ALL_TOUCHED, the pixels touched by the edges are   */
+/*      burnt too, so we only use the cache if no edge is close to      */
+/*      the chunk.                                                      */
+/* -------------------------------------------------------------------- */
+    bool bUseCache = poCache != nullptr;
+    if( bUseCache &&
+        CPLFetchBool( psWO->papszWarpOptions, "CUTLINE_ALL_TOUCHED", false ) )
+    {
+        const double dfMinX = static_cast<double>(nXOff) - 1;
+        const double dfMaxX = static_cast<double>(nXOff) + nXSize + 1;
+        poCache->ForEachEdge(
+            static_cast<double>(nYOff) - 1,
+            static_cast<double>(nYOff) + nYSize + 1,
+            [&bUseCache, dfMinX, dfMaxX](const GDALCutlineEdge& sEdge)
+        {
+            if( std::max(sEdge.dfX1, sEdge.dfX2) >= dfMinX &&
+                std::min(sEdge.dfX1, sEdge.dfX2) <= dfMaxX )
+            {
+                bUseCache = false;
+            }
+        });
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Create a byte buffer into which we can burn the mask polygon.   */
+/* -------------------------------------------------------------------- */
+    GByte *pabyPolyMask = static_cast<GByte *>(
+        VSI_CALLOC_VERBOSE(nXSize, nYSize));
+    if( pabyPolyMask == nullptr )
+    {
+        GDALDestroyWarpCutlineCache(pTmpCutlineCache);
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+    GDALCutlineChunkStatus eStatus = CUTLINE_CHUNK_PARTIAL;
+    if( bUseCache )
+    {
+        eStatus = GDALCutlineRasterizeChunk(poCache, nXOff, nYOff,
+                                            nXSize, nYSize, pabyPolyMask);
+    }
+    else
+    {
+        eErr = GDALCutlineRasterizeMEM(psWO, hPolygon, nXOff, nYOff,
+                                       nXSize, nYSize, pabyPolyMask);
+    }
+    GDALDestroyWarpCutlineCache(pTmpCutlineCache);
+
 /* -------------------------------------------------------------------- */
 /*      In the case with no blend distance, we just apply this as a     */
 /*      mask, zeroing out everything outside the polygon.               */
 /* -------------------------------------------------------------------- */
-    if( psWO->dfCutlineBlendDist == 0.0 )
+    if( eErr != CE_None )
+    {
+        // Nothing to do.
+    }
+    else if( psWO->dfCutlineBlendDist == 0.0 )
     {
-        for( int i = nXSize * nYSize - 1; i >= 0; i-- )
+        if( eStatus == CUTLINE_CHUNK_OUTSIDE )
         {
-            if( pabyPolyMask[i] == 0 )
-                static_cast<float *>(pValidityMask)[i] = 0.0;
+            memset( pafMask, 0, sizeof(float) * nXSize * nYSize );
+        }
+        else if( eStatus == CUTLINE_CHUNK_PARTIAL )
+        {
+            for( int i = nXSize * nYSize - 1; i >= 0; i-- )
+            {
+                if( pabyPolyMask[i] == 0 )
+                    pafMask[i] = 0.0;
+            }
         }
     }
     else
     {
+        if( eStatus == CUTLINE_CHUNK_INSIDE )
+            memset( pabyPolyMask, 255, static_cast<size_t>(nXSize) * nYSize );
         eErr = BlendMaskGenerator( nXOff, nYOff, nXSize, nYSize,
-                                   pabyPolyMask,
-                                   static_cast<float *>(pValidityMask),
+                                   pabyPolyMask, pafMask,
                                    hPolygon, psWO->dfCutlineBlendDist );
     }
 
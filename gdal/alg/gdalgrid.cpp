@@ -37,9 +37,11 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -73,6 +75,478 @@ static void GDALGridGetPointBounds( const void* hFeature, CPLRectObj* pBounds )
     pBounds->maxy = dfY;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                            GDALGridKDTree                            */
+/* ==================================================================== */
+/************************************************************************/
+
+/* Static 2D k-d tree of the input points. The point indices are reordered
+ * so that the points of each node are contiguous, and their coordinates are
+ * copied in that order, so that a search reads memory sequentially.
+ */
+struct GDALGridKDTree
+{
+    struct Node
+    {
+        double  dfMinX;
+        double  dfMinY;
+        double  dfMaxX;
+        double  dfMaxY;
+        GUInt32 nStart;
+        GUInt32 nEnd;
+        // Index of the first child node (the second one follows it), or 0
+        // for a leaf.
+        GUInt32 nFirstChild;
+    };
+
+    std::vector<Node>    asNodes{};
+    std::vector<GUInt32> anIdx{};
+    std::vector<double>  adfX{};
+    std::vector<double>  adfY{};
+
+    template<class F> void Search( double dfMinX, double dfMinY,
+                                   double dfMaxX, double dfMaxY,
+                                   F&& f ) const;
+    bool Nearest( double dfX, double dfY, GUInt32& nNearestIdx ) const;
+    bool HasPointInCircle( double dfCX, double dfCY, double dfRadius2,
+                           double dfExclMinX, double dfExclMinY,
+                           double dfExclMaxX, double dfExclMaxY ) const;
+};
+
+constexpr GUInt32 GRID_KDTREE_LEAF_SIZE = 16;
+
+/************************************************************************/
+/*                        GDALGridKDTreeCreate()                        */
+/************************************************************************/
+
+static GDALGridKDTree* GDALGridKDTreeCreate( GUInt32 nPoints,
+                                             const double* padfX,
+                                             const double* padfY )
+{
+    if( nPoints == 0 )
+        return nullptr;
+
+    GDALGridKDTree* psTree = nullptr;
+    try
+    {
+        psTree = new GDALGridKDTree();
+        auto& anIdx = psTree->anIdx;
+        auto& asNodes = psTree->asNodes;
+        // Points with NaN coordinates can never be in a search ellipse.
+        anIdx.reserve(nPoints);
+        for( GUInt32 i = 0; i < nPoints; i++ )
+        {
+            if( !CPLIsNan(padfX[i]) && !CPLIsNan(padfY[i]) )
+                anIdx.push_back(i);
+        }
+        const GUInt32 nTreePoints = static_cast<GUInt32>(anIdx.size());
+        if( nTreePoints == 0 )
+        {
+            delete psTree;
+            return nullptr;
+        }
+        asNodes.reserve(
+            2 * (static_cast<size_t>(nTreePoints) / GRID_KDTREE_LEAF_SIZE) + 1);
+
+        GDALGridKDTree::Node sRoot;
+        sRoot.nStart = 0;
+        sRoot.nEnd = nTreePoints;
+        sRoot.nFirstChild = 0;
+        asNodes.push_back(sRoot);
+
+        // Nodes are appended in breadth-first order, so that each one is
+        // split after its parent.
+        for( size_t iNode = 0; iNode < asNodes.size(); iNode++ )
+        {
+            const GUInt32 nStart = asNodes[iNode].nStart;
+            const GUInt32 nEnd = asNodes[iNode].nEnd;
+            double dfMinX = padfX[anIdx[nStart]];
+            double dfMinY = padfY[anIdx[nStart]];
+            double dfMaxX = dfMinX;
+            double dfMaxY = dfMinY;
+            for( GUInt32 i = nStart + 1; i < nEnd; i++ )
+            {
+                const double dfX = padfX[anIdx[i]];
+                const double dfY = padfY[anIdx[i]];
+                dfMinX = std::min(dfMinX, dfX);
+                dfMinY = std::min(dfMinY, dfY);
+                dfMaxX = std::max(dfMaxX, dfX);
+                dfMaxY = std::max(dfMaxY, dfY);
+            }
+            asNodes[iNode].dfMinX = dfMinX;
+            asNodes[iNode].dfMinY = dfMinY;
+            asNodes[iNode].dfMaxX = dfMaxX;
+            asNodes[iNode].dfMaxY = dfMaxY;
+
+            if( nEnd - nStart <= GRID_KDTREE_LEAF_SIZE ||
+                (dfMinX == dfMaxX && dfMinY == dfMaxY) )
+            {
+                continue;
+            }
+
+            // Split at the median of the widest dimension.
+            const double* padfCoord =
+                (dfMaxX - dfMinX >= dfMaxY - dfMinY) ? padfX : padfY;
+            const GUInt32 nMid = nStart + (nEnd - nStart) / 2;
+            std::nth_element(anIdx.begin() + nStart, anIdx.begin() + nMid,
+                             anIdx.begin() + nEnd,
+                             [padfCoord](GUInt32 a, GUInt32 b)
+                             { return padfCoord[a] < padfCoord[b]; });
+
+            asNodes[iNode].nFirstChild = static_cast<GUInt32>(asNodes.size());
+            GDALGridKDTree::Node sChild;
+            sChild.nFirstChild = 0;
+            sChild.nStart = nStart;
+            sChild.nEnd = nMid;
+            asNodes.push_back(sChild);
+            sChild.nStart = nMid;
+            sChild.nEnd = nEnd;
+            asNodes.push_back(sChild);
+        }
+
+        psTree->adfX.resize(nTreePoints);
+        psTree->adfY.resize(nTreePoints);
+        for( GUInt32 i = 0; i < nTreePoints; i++ )
+        {
+            psTree->adfX[i] = padfX[anIdx[i]];
+            psTree->adfY[i] = padfY[anIdx[i]];
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate k-d tree of %u points",
+                 static_cast<unsigned>(nPoints));
+        delete psTree;
+        return nullptr;
+    }
+
+    return psTree;
+}
+
+/************************************************************************/
+/*                         GDALGridKDTreeFree()                         */
+/************************************************************************/
+
+static void GDALGridKDTreeFree( const GDALGridKDTree* psTree )
+{
+    delete psTree;
+}
+
+/************************************************************************/
+/*                       GDALGridKDTree::Search()                       */
+/*                                                                      */
+/*      Call f(nPos) for each position, in the reordered arrays, of a   */
+/*      point in the passed rectangle.                                  */
+/************************************************************************/
+
+template<class F>
+void GDALGridKDTree::Search( double dfMinX, double dfMinY,
+                             double dfMaxX, double dfMaxY, F&& f ) const
+{
+    // Nodes are split in halves, so the depth of the tree is at most 32.
+    GUInt32 anStack[128];
+    int nStackSize = 0;
+    anStack[nStackSize++] = 0;
+    while( nStackSize > 0 )
+    {
+        const Node& sNode = asNodes[anStack[--nStackSize]];
+        if( sNode.dfMinX > dfMaxX || sNode.dfMaxX < dfMinX ||
+            sNode.dfMinY > dfMaxY || sNode.dfMaxY < dfMinY )
+        {
+            continue;
+        }
+        if( sNode.dfMinX >= dfMinX && sNode.dfMaxX <= dfMaxX &&
+            sNode.dfMinY >= dfMinY && sNode.dfMaxY <= dfMaxY )
+        {
+            for( GUInt32 i = sNode.nStart; i < sNode.nEnd; i++ )
+                f(i);
+        }
+        else if( sNode.nFirstChild == 0 )
+        {
+            for( GUInt32 i = sNode.nStart; i < sNode.nEnd; i++ )
+            {
+                if( adfX[i] >= dfMinX && adfX[i] <= dfMaxX &&
+                    adfY[i] >= dfMinY && adfY[i] <= dfMaxY )
+                {
+                    f(i);
+                }
+            }
+        }
+        else
+        {
+            anStack[nStackSize++] = sNode.nFirstChild;
+            anStack[nStackSize++] = sNode.nFirstChild + 1;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALGridKDTree::Nearest()                       */
+/*                                                                      */
+/*      Find the point nearest to (dfX, dfY). Among points at the same  */
+/*      distance, the one with the highest index is returned, as the    */
+/*      exhaustive search of GDALGridNearestNeighbor() does.            */
+/************************************************************************/
+
+bool GDALGridKDTree::Nearest( double dfX, double dfY,
+                              GUInt32& nNearestIdx ) const
+{
+    double dfNearestR = std::numeric_limits<double>::max();
+    bool bFound = false;
+
+    // Nodes are split in halves, so the depth of the tree is at most 32.
+    GUInt32 anStack[128];
+    int nStackSize = 0;
+    anStack[nStackSize++] = 0;
+    const auto BoxDistance = [dfX, dfY](const Node& sNode)
+    {
+        const double dfDX = std::max(std::max(sNode.dfMinX - dfX, 0.0),
+                                     dfX - sNode.dfMaxX);
+        const double dfDY = std::max(std::max(sNode.dfMinY - dfY, 0.0),
+                                     dfY - sNode.dfMaxY);
+        return dfDX * dfDX + dfDY * dfDY;
+    };
+    while( nStackSize > 0 )
+    {
+        const Node& sNode = asNodes[anStack[--nStackSize]];
+        // Nodes at the same distance may contain a point of higher index.
+        if( BoxDistance(sNode) > dfNearestR )
+            continue;
+        if( sNode.nFirstChild == 0 )
+        {
+            for( GUInt32 i = sNode.nStart; i < sNode.nEnd; i++ )
+            {
+                const double dfRX = adfX[i] - dfX;
+                const double dfRY = adfY[i] - dfY;
+                const double dfR2 = dfRX * dfRX + dfRY * dfRY;
+                if( dfR2 < dfNearestR ||
+                    (dfR2 == dfNearestR &&
+                     (!bFound || anIdx[i] > nNearestIdx)) )
+                {
+                    dfNearestR = dfR2;
+                    nNearestIdx = anIdx[i];
+                    bFound = true;
+                }
+            }
+        }
+        else
+        {
+            // Push the farthest child first, so as to visit the nearest one
+            // first.
+            const GUInt32 nFirst = sNode.nFirstChild;
+            if( BoxDistance(asNodes[nFirst]) < BoxDistance(asNodes[nFirst + 1]) )
+            {
+                anStack[nStackSize++] = nFirst + 1;
+                anStack[nStackSize++] = nFirst;
+            }
+            else
+            {
+                anStack[nStackSize++] = nFirst;
+                anStack[nStackSize++] = nFirst + 1;
+            }
+        }
+    }
+    return bFound;
+}
+
+/************************************************************************/
+/*                  GDALGridKDTree::HasPointInCircle()                  */
+/*                                                                      */
+/*      Whether a point outside of the passed rectangle is strictly     */
+/*      inside the passed circle.                                       */
+/************************************************************************/
+
+bool GDALGridKDTree::HasPointInCircle( double dfCX, double dfCY,
+                                       double dfRadius2,
+                                       double dfExclMinX, double dfExclMinY,
+                                       double dfExclMaxX,
+                                       double dfExclMaxY ) const
+{
+    // Points on the circle, up to rounding errors, do not count.
+    const double dfInnerRadius2 = dfRadius2 * (1 - 1e-9);
+    GUInt32 anStack[128];
+    int nStackSize = 0;
+    anStack[nStackSize++] = 0;
+    while( nStackSize > 0 )
+    {
+        const Node& sNode = asNodes[anStack[--nStackSize]];
+        if( sNode.dfMinX >= dfExclMinX && sNode.dfMaxX <= dfExclMaxX &&
+            sNode.dfMinY >= dfExclMinY && sNode.dfMaxY <= dfExclMaxY )
+        {
+            continue;
+        }
+        const double dfDX = std::max(std::max(sNode.dfMinX - dfCX, 0.0),
+                                     dfCX - sNode.dfMaxX);
+        const double dfDY = std::max(std::max(sNode.dfMinY - dfCY, 0.0),
+                                     dfCY - sNode.dfMaxY);
+        if( dfDX * dfDX + dfDY * dfDY >= dfInnerRadius2 )
+            continue;
+        if( sNode.nFirstChild == 0 )
+        {
+            for( GUInt32 i = sNode.nStart; i < sNode.nEnd; i++ )
+            {
+                if( adfX[i] >= dfExclMinX && adfX[i] <= dfExclMaxX &&
+                    adfY[i] >= dfExclMinY && adfY[i] <= dfExclMaxY )
+                {
+                    continue;
+                }
+                const double dfRX = adfX[i] - dfCX;
+                const double dfRY = adfY[i] - dfCY;
+                if( dfRX * dfRX + dfRY * dfRY < dfInnerRadius2 )
+                    return true;
+            }
+        }
+        else
+        {
+            anStack[nStackSize++] = sNode.nFirstChild;
+            anStack[nStackSize++] = sNode.nFirstChild + 1;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        GDALGridRowCandidates                         */
+/************************************************************************/
+
+/* Searches are batched by row of grid nodes: the k-d tree is searched once
+ * for the strip of points that may be in the search ellipse of any node of
+ * the row, sorted by X, and each node then only looks at the points of the
+ * strip in the X range of its ellipse.
+ */
+struct GDALGridRowCandidates
+{
+    // X extent of the grid nodes of the rows, set by the caller.
+    double  dfXMin = 0;
+    double  dfXMax = 0;
+
+    // Key of the current strip.
+    bool    bValid = false;
+    double  dfY = 0;
+    double  dfHalfWidth = 0;
+    double  dfHalfHeight = 0;
+    double  dfStripXMin = 0;
+    double  dfStripXMax = 0;
+
+    // (X, index) of the points of the strip, sorted by X.
+    std::vector<std::pair<double, GUInt32>> asStrip{};
+    std::vector<GUInt32> anCandidates{};
+};
+
+/************************************************************************/
+/*                        GDALGridGetCandidates()                       */
+/*                                                                      */
+/*      Return the number of points to consider for the search ellipse */
+/*      centered on (dfXPoint, dfYPoint). *ppanCandidates is set to     */
+/*      the array of their indices, in increasing order, or to NULL if  */
+/*      all the points must be considered. The search ellipse test      */
+/*      must still be done by the caller.                               */
+/************************************************************************/
+
+static GUInt32 GDALGridGetCandidates( void* hExtraParamsIn,
+                                      double dfRadius1, double dfRadius2,
+                                      double dfAngle, GUInt32 nPoints,
+                                      double dfXPoint, double dfYPoint,
+                                      const GUInt32** ppanCandidates )
+{
+    *ppanCandidates = nullptr;
+    const GDALGridExtraParameters* psExtraParams =
+        static_cast<const GDALGridExtraParameters *>(hExtraParamsIn);
+    if( psExtraParams == nullptr || psExtraParams->psKDTree == nullptr ||
+        psExtraParams->psRowCandidates == nullptr ||
+        !(dfRadius1 > 0) || !(dfRadius2 > 0) )
+    {
+        return nPoints;
+    }
+    const GDALGridKDTree* psTree = psExtraParams->psKDTree;
+    GDALGridRowCandidates* psRow = psExtraParams->psRowCandidates;
+
+    // Bounding box of the rotated ellipse, with a margin for rounding
+    // errors
+    double dfHalfWidth = dfRadius1;
+    double dfHalfHeight = dfRadius2;
+    if( dfAngle != 0.0 )
+    {
+        const double dfCos = cos(dfAngle);
+        const double dfSin = sin(dfAngle);
+        dfHalfWidth = sqrt(dfRadius1 * dfRadius1 * dfCos * dfCos +
+                           dfRadius2 * dfRadius2 * dfSin * dfSin);
+        dfHalfHeight = sqrt(dfRadius1 * dfRadius1 * dfSin * dfSin +
+                            dfRadius2 * dfRadius2 * dfCos * dfCos);
+    }
+    // (constant along a row, so that the strip of the row can be reused)
+    const double dfMaxAbsX = std::max(
+        std::max(fabs(psRow->dfXMin), fabs(psRow->dfXMax)), fabs(dfXPoint));
+    const double dfEps = 1e-6 * std::max(dfRadius1, dfRadius2) +
+                         1e-9 * (dfMaxAbsX + fabs(dfYPoint));
+    dfHalfWidth += dfEps;
+    dfHalfHeight += dfEps;
+
+    try
+    {
+        auto& anCandidates = psRow->anCandidates;
+        anCandidates.clear();
+        if( dfXPoint < psRow->dfXMin || dfXPoint > psRow->dfXMax )
+        {
+            // Node outside of the row extent: direct search.
+            psTree->Search(dfXPoint - dfHalfWidth, dfYPoint - dfHalfHeight,
+                           dfXPoint + dfHalfWidth, dfYPoint + dfHalfHeight,
+                           [psTree, &anCandidates](GUInt32 i)
+                           { anCandidates.push_back(psTree->anIdx[i]); });
+        }
+        else
+        {
+            auto& asStrip = psRow->asStrip;
+            const double dfStripXMin = psRow->dfXMin - dfHalfWidth;
+            const double dfStripXMax = psRow->dfXMax + dfHalfWidth;
+            if( !psRow->bValid || psRow->dfY != dfYPoint ||
+                psRow->dfHalfWidth != dfHalfWidth ||
+                psRow->dfHalfHeight != dfHalfHeight ||
+                psRow->dfStripXMin != dfStripXMin ||
+                psRow->dfStripXMax != dfStripXMax )
+            {
+                asStrip.clear();
+                psTree->Search(dfStripXMin, dfYPoint - dfHalfHeight,
+                               dfStripXMax, dfYPoint + dfHalfHeight,
+                               [psTree, &asStrip](GUInt32 i)
+                               { asStrip.emplace_back(psTree->adfX[i],
+                                                      psTree->anIdx[i]); });
+                std::sort(asStrip.begin(), asStrip.end());
+                psRow->bValid = true;
+                psRow->dfY = dfYPoint;
+                psRow->dfHalfWidth = dfHalfWidth;
+                psRow->dfHalfHeight = dfHalfHeight;
+                psRow->dfStripXMin = dfStripXMin;
+                psRow->dfStripXMax = dfStripXMax;
+            }
+
+            const auto oIterStart = std::lower_bound(
+                asStrip.begin(), asStrip.end(),
+                std::pair<double, GUInt32>(dfXPoint - dfHalfWidth, 0));
+            for( auto oIter = oIterStart;
+                 oIter != asStrip.end() && oIter->first <= dfXPoint + dfHalfWidth;
+                 ++oIter )
+            {
+                anCandidates.push_back(oIter->second);
+            }
+        }
+
+        // Process the points in the same order as an exhaustive search, so
+        // that the results do not depend on the tree.
+        std::sort(anCandidates.begin(), anCandidates.end());
+    }
+    catch( const std::exception& )
+    {
+        // Out of memory: fall back to an exhaustive search.
+        psRow->bValid = false;
+        return nPoints;
+    }
+    *ppanCandidates = psRow->anCandidates.data();
+    return static_cast<GUInt32>(psRow->anCandidates.size());
+}
+
 /************************************************************************/
 /*                   GDALGridInverseDistanceToAPower()                  */
 /************************************************************************/
@@ -500,50 +974,12 @@ GDALGridInverseDistanceToAPowerNoSearch(
 /*                        GDALGridMovingAverage()                       */
 /************************************************************************/
 
-/**
- * Moving average.
- *
- * The Moving Average is a simple data averaging algorithm. It uses a moving
- * window of elliptic form to search values and averages all data points
- * within the window. Search ellipse can be rotated by specified angle, the
- * center of ellipse located at the grid node. Also the minimum number of data
- * points to average can be set, if there are not enough points in window, the
- * grid node considered empty and will be filled with specified NODATA value.
- *
- * Mathematically it can be expressed with the formula:
- *
- * \f[
- *      Z=\frac{\sum_{i=1}^n{Z_i}}{n}
- * \f]
- *
- *  where
- *  <ul>
- *      <li> \f$Z\f$ is a resulting value at the grid node,
- *      <li> \f$Z_i\f$ is a known value at point \f$i\f$,
- *      <li> \f$n\f$ is a total number of points in search ellipse.
- *  </ul>
- *
- * @param poOptionsIn Algorithm parameters. This should point to
- * GDALGridMovingAverageOptions object.
- * @param nPoints Number of elements in input arrays.
- * @param padfX Input array of X coordinates.
- * @param padfY Input array of Y coordinates.
- * @param padfZ Input array of Z values.
- * @param dfXPoint X coordinate of the point to compute.
- * @param dfYPoint Y coordinate of the point to compute.
- * @param pdfValue Pointer to variable where the computed grid node value
- * will be returned.
- * @param hExtraParamsIn extra parameters (unused)
- *
- * @return CE_None on success or CE_Failure if something goes wrong.
- */
-
-CPLErr
-GDALGridMovingAverage( const void *poOptionsIn, GUInt32 nPoints,
-                       const double *padfX, const double *padfY,
-                       const double *padfZ,
-                       double dfXPoint, double dfYPoint, double *pdfValue,
-                       CPL_UNUSED void * hExtraParamsIn )
+static CPLErr
+GDALGridMovingAverageInternal( const void *poOptionsIn, GUInt32 nPoints,
+                               const double *padfX, const double *padfY,
+                               const double *padfZ,
+                               double dfXPoint, double dfYPoint, double *pdfValue,
+                               void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -566,8 +1002,14 @@ GDALGridMovingAverage( const void *poOptionsIn, GUInt32 nPoints,
 
     GUInt32 n = 0;  // Used after for.
 
-    for( GUInt32 i = 0; i < nPoints; i++ )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -600,6 +1042,58 @@ GDALGridMovingAverage( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
+/**
+ * Moving average.
+ *
+ * The Moving Average is a simple data averaging algorithm. It uses a moving
+ * window of elliptic form to search values and averages all data points
+ * within the window. Search ellipse can be rotated by specified angle, the
+ * center of ellipse located at the grid node. Also the minimum number of data
+ * points to average can be set, if there are not enough points in window, the
+ * grid node considered empty and will be filled with specified NODATA value.
+ *
+ * Mathematically it can be expressed with the formula:
+ *
+ * \f[
+ *      Z=\frac{\sum_{i=1}^n{Z_i}}{n}
+ * \f]
+ *
+ *  where
+ *  <ul>
+ *      <li> \f$Z\f$ is a resulting value at the grid node,
+ *      <li> \f$Z_i\f$ is a known value at point \f$i\f$,
+ *      <li> \f$n\f$ is a total number of points in search ellipse.
+ *  </ul>
+ *
+ * @param poOptionsIn Algorithm parameters. This should point to
+ * GDALGridMovingAverageOptions object.
+ * @param nPoints Number of elements in input arrays.
+ * @param padfX Input array of X coordinates.
+ * @param padfY Input array of Y coordinates.
+ * @param padfZ Input array of Z values.
+ * @param dfXPoint X coordinate of the point to compute.
+ * @param dfYPoint Y coordinate of the point to compute.
+ * @param pdfValue Pointer to variable where the computed grid node value
+ * will be returned.
+ * @param hExtraParamsIn extra parameters (unused)
+ *
+ * @return CE_None on success or CE_Failure if something goes wrong.
+ */
+
+CPLErr
+GDALGridMovingAverage( const void *poOptionsIn, GUInt32 nPoints,
+                       const double *padfX, const double *padfY,
+                       const double *padfZ,
+                       double dfXPoint, double dfYPoint, double *pdfValue,
+                       CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridMovingAverageInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
 /************************************************************************/
 /*                        GDALGridNearestNeighbor()                     */
 /************************************************************************/
@@ -612,6 +1106,11 @@ GDALGridMovingAverage( const void *poOptionsIn, GUInt32 nPoints,
  * and returns it as a result. If there are no points found, the specified
  * NODATA value will be returned.
  *
+ * When the search ellipse is not set (both radii are 0), all the points are
+ * considered, and the value of the nearest one is returned. In case of ties,
+ * the point with the highest index is used. Starting with GDAL 3.4, this is
+ * done exactly, using a k-d tree of the points when available.
+ *
  * @param poOptionsIn Algorithm parameters. This should point to
  * GDALGridNearestNeighborOptions object.
  * @param nPoints Number of elements in input arrays.
@@ -643,9 +1142,10 @@ GDALGridNearestNeighbor( const void *poOptionsIn, GUInt32 nPoints,
     const double dfRadius1 = poOptions->dfRadius1 * poOptions->dfRadius1;
     const double dfRadius2 = poOptions->dfRadius2 * poOptions->dfRadius2;
     double dfR12 = dfRadius1 * dfRadius2;
-    GDALGridExtraParameters* psExtraParams =
-        static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree* hQuadTree = psExtraParams->hQuadTree;
+    const GDALGridExtraParameters* psExtraParams =
+        static_cast<const GDALGridExtraParameters *>(hExtraParamsIn);
+    const GDALGridKDTree* psKDTree =
+        psExtraParams != nullptr ? psExtraParams->psKDTree : nullptr;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -655,63 +1155,29 @@ GDALGridNearestNeighbor( const void *poOptionsIn, GUInt32 nPoints,
 
     // If the nearest point will not be found, its value remains as NODATA.
     double dfNearestValue = poOptions->dfNoDataValue;
-    // Nearest distance will be initialized with the distance to the first
-    // point in array.
-    double dfNearestR = std::numeric_limits<double>::max();
-    GUInt32 i = 0;
 
-    double dfSearchRadius = psExtraParams->dfInitialSearchRadius;
-    if( hQuadTree != nullptr && dfRadius1 == dfRadius2 && dfSearchRadius > 0 )
+    if( psKDTree != nullptr && dfRadius1 == 0.0 && dfRadius2 == 0.0 )
     {
-        if( dfRadius1 > 0 )
-            dfSearchRadius = poOptions->dfRadius1;
-        CPLRectObj sAoi;
-        while( dfSearchRadius > 0 )
-        {
-            sAoi.minx = dfXPoint - dfSearchRadius;
-            sAoi.miny = dfYPoint - dfSearchRadius;
-            sAoi.maxx = dfXPoint + dfSearchRadius;
-            sAoi.maxy = dfYPoint + dfSearchRadius;
-            int nFeatureCount = 0;
-            GDALGridPoint** papsPoints = reinterpret_cast<GDALGridPoint **>(
-                    CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount) );
-            if( nFeatureCount != 0 )
-            {
-                if( dfRadius1 > 0 )
-                    dfNearestR = dfRadius1;
-                for( int k = 0; k < nFeatureCount; k++)
-                {
-                    const int idx = papsPoints[k]->i;
-                    const double dfRX = padfX[idx] - dfXPoint;
-                    const double dfRY = padfY[idx] - dfYPoint;
-
-                    const double dfR2 = dfRX * dfRX + dfRY * dfRY;
-                    if( dfR2 <= dfNearestR )
-                    {
-                        dfNearestR = dfR2;
-                        dfNearestValue = padfZ[idx];
-                    }
-                }
-
-                CPLFree(papsPoints);
-                break;
-            }
-
-            CPLFree(papsPoints);
-            if( dfRadius1 > 0 )
-                break;
-            dfSearchRadius *= 2;
-#if DEBUG_VERBOSE
-            CPLDebug(
-                "GDAL_GRID", "Increasing search radius to %.16g",
-                dfSearchRadius);
-#endif
-        }
+        // No search ellipse: take the nearest of all points, which does not
+        // depend on the rotation.
+        GUInt32 nNearestIdx = 0;
+        if( psKDTree->Nearest(dfXPoint, dfYPoint, nNearestIdx) )
+            dfNearestValue = padfZ[nNearestIdx];
     }
     else
     {
-        while( i < nPoints )
+        // Nearest distance will be initialized with the distance to the first
+        // point in array.
+        double dfNearestR = std::numeric_limits<double>::max();
+
+        const GUInt32* panCandidates = nullptr;
+        const GUInt32 nCandidates = GDALGridGetCandidates(
+            hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2,
+            dfAngle, nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+        for( GUInt32 k = 0; k < nCandidates; k++ )
         {
+            const GUInt32 i = panCandidates ? panCandidates[k] : k;
             double dfRX = padfX[i] - dfXPoint;
             double dfRY = padfY[i] - dfYPoint;
 
@@ -734,8 +1200,6 @@ GDALGridNearestNeighbor( const void *poOptionsIn, GUInt32 nPoints,
                     dfNearestValue = padfZ[i];
                 }
             }
-
-            i++;
         }
     }
 
@@ -748,44 +1212,12 @@ GDALGridNearestNeighbor( const void *poOptionsIn, GUInt32 nPoints,
 /*                      GDALGridDataMetricMinimum()                     */
 /************************************************************************/
 
-/**
- * Minimum data value (data metric).
- *
- * Minimum value found in grid node search ellipse. If there are no points
- * found, the specified NODATA value will be returned.
- *
- * \f[
- *      Z=\min{(Z_1,Z_2,\ldots,Z_n)}
- * \f]
- *
- *  where
- *  <ul>
- *      <li> \f$Z\f$ is a resulting value at the grid node,
- *      <li> \f$Z_i\f$ is a known value at point \f$i\f$,
- *      <li> \f$n\f$ is a total number of points in search ellipse.
- *  </ul>
- *
- * @param poOptionsIn Algorithm parameters. This should point to
- * GDALGridDataMetricsOptions object.
- * @param nPoints Number of elements in input arrays.
- * @param padfX Input array of X coordinates.
- * @param padfY Input array of Y coordinates.
- * @param padfZ Input array of Z values.
- * @param dfXPoint X coordinate of the point to compute.
- * @param dfYPoint Y coordinate of the point to compute.
- * @param pdfValue Pointer to variable where the computed grid node value
- * will be returned.
- * @param hExtraParamsIn unused.
- *
- * @return CE_None on success or CE_Failure if something goes wrong.
- */
-
-CPLErr
-GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
-                           const double *padfX, const double *padfY,
-                           const double *padfZ,
-                           double dfXPoint, double dfYPoint, double *pdfValue,
-                           CPL_UNUSED void * hExtraParamsIn )
+static CPLErr
+GDALGridDataMetricMinimumInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                   const double *padfX, const double *padfY,
+                                   const double *padfZ,
+                                   double dfXPoint, double dfYPoint, double *pdfValue,
+                                   void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -805,11 +1237,16 @@ GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     double dfMinimumValue=0.0;
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
-    while( i < nPoints )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -836,8 +1273,6 @@ GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
             }
             n++;
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints || n == 0 )
@@ -852,18 +1287,14 @@ GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
-/************************************************************************/
-/*                      GDALGridDataMetricMaximum()                     */
-/************************************************************************/
-
 /**
- * Maximum data value (data metric).
+ * Minimum data value (data metric).
  *
- * Maximum value found in grid node search ellipse. If there are no points
+ * Minimum value found in grid node search ellipse. If there are no points
  * found, the specified NODATA value will be returned.
  *
  * \f[
- *      Z=\max{(Z_1,Z_2,\ldots,Z_n)}
+ *      Z=\min{(Z_1,Z_2,\ldots,Z_n)}
  * \f]
  *
  *  where
@@ -889,11 +1320,29 @@ GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
  */
 
 CPLErr
-GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
+GDALGridDataMetricMinimum( const void *poOptionsIn, GUInt32 nPoints,
                            const double *padfX, const double *padfY,
                            const double *padfZ,
                            double dfXPoint, double dfYPoint, double *pdfValue,
-                           CPL_UNUSED void* hExtraParamsIn )
+                           CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricMinimumInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                      GDALGridDataMetricMaximum()                     */
+/************************************************************************/
+
+static CPLErr
+GDALGridDataMetricMaximumInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                   const double *padfX, const double *padfY,
+                                   const double *padfZ,
+                                   double dfXPoint, double dfYPoint, double *pdfValue,
+                                   void* hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -913,11 +1362,16 @@ GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     double dfMaximumValue=0.0;
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
-    while( i < nPoints )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -944,8 +1398,6 @@ GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
             }
             n++;
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints
@@ -961,19 +1413,14 @@ GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
-/************************************************************************/
-/*                       GDALGridDataMetricRange()                      */
-/************************************************************************/
-
 /**
- * Data range (data metric).
+ * Maximum data value (data metric).
  *
- * A difference between the minimum and maximum values found in grid node
- * search ellipse. If there are no points found, the specified NODATA
- * value will be returned.
+ * Maximum value found in grid node search ellipse. If there are no points
+ * found, the specified NODATA value will be returned.
  *
  * \f[
- *      Z=\max{(Z_1,Z_2,\ldots,Z_n)}-\min{(Z_1,Z_2,\ldots,Z_n)}
+ *      Z=\max{(Z_1,Z_2,\ldots,Z_n)}
  * \f]
  *
  *  where
@@ -999,11 +1446,29 @@ GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
  */
 
 CPLErr
-GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
-                         const double *padfX, const double *padfY,
-                         const double *padfZ,
-                         double dfXPoint, double dfYPoint, double *pdfValue,
-                         CPL_UNUSED void * hExtraParamsIn )
+GDALGridDataMetricMaximum( const void *poOptionsIn, GUInt32 nPoints,
+                           const double *padfX, const double *padfY,
+                           const double *padfZ,
+                           double dfXPoint, double dfYPoint, double *pdfValue,
+                           CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricMaximumInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                       GDALGridDataMetricRange()                      */
+/************************************************************************/
+
+static CPLErr
+GDALGridDataMetricRangeInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                 const double *padfX, const double *padfY,
+                                 const double *padfZ,
+                                 double dfXPoint, double dfYPoint, double *pdfValue,
+                                 void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -1023,11 +1488,16 @@ GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMaximumValue = 0.0;
     double dfMinimumValue = 0.0;
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
-    while( i < nPoints )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -1057,8 +1527,6 @@ GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
             }
             n++;
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints || n == 0 )
@@ -1073,22 +1541,21 @@ GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
-/************************************************************************/
-/*                       GDALGridDataMetricCount()                      */
-/************************************************************************/
-
 /**
- * Number of data points (data metric).
+ * Data range (data metric).
  *
- * A number of data points found in grid node search ellipse.
+ * A difference between the minimum and maximum values found in grid node
+ * search ellipse. If there are no points found, the specified NODATA
+ * value will be returned.
  *
  * \f[
- *      Z=n
+ *      Z=\max{(Z_1,Z_2,\ldots,Z_n)}-\min{(Z_1,Z_2,\ldots,Z_n)}
  * \f]
  *
  *  where
  *  <ul>
  *      <li> \f$Z\f$ is a resulting value at the grid node,
+ *      <li> \f$Z_i\f$ is a known value at point \f$i\f$,
  *      <li> \f$n\f$ is a total number of points in search ellipse.
  *  </ul>
  *
@@ -1108,11 +1575,29 @@ GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
  */
 
 CPLErr
-GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
+GDALGridDataMetricRange( const void *poOptionsIn, GUInt32 nPoints,
                          const double *padfX, const double *padfY,
-                         CPL_UNUSED const double * padfZ,
+                         const double *padfZ,
                          double dfXPoint, double dfYPoint, double *pdfValue,
                          CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricRangeInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                       GDALGridDataMetricCount()                      */
+/************************************************************************/
+
+static CPLErr
+GDALGridDataMetricCountInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                 const double *padfX, const double *padfY,
+                                 CPL_UNUSED const double * padfZ,
+                                 double dfXPoint, double dfYPoint, double *pdfValue,
+                                 void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -1131,11 +1616,16 @@ GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff1 = bRotated ? cos(dfAngle) : 0.0;
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
-    while( i < nPoints )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -1153,8 +1643,6 @@ GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
         {
             n++;
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints )
@@ -1169,26 +1657,18 @@ GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
-/************************************************************************/
-/*                 GDALGridDataMetricAverageDistance()                  */
-/************************************************************************/
-
 /**
- * Average distance (data metric).
+ * Number of data points (data metric).
  *
- * An average distance between the grid node (center of the search ellipse)
- * and all of the data points found in grid node search ellipse. If there are
- * no points found, the specified NODATA value will be returned.
+ * A number of data points found in grid node search ellipse.
  *
  * \f[
- *      Z=\frac{\sum_{i = 1}^n r_i}{n}
+ *      Z=n
  * \f]
  *
  *  where
  *  <ul>
  *      <li> \f$Z\f$ is a resulting value at the grid node,
- *      <li> \f$r_i\f$ is an Euclidean distance from the grid node
- *           to point \f$i\f$,
  *      <li> \f$n\f$ is a total number of points in search ellipse.
  *  </ul>
  *
@@ -1197,7 +1677,7 @@ GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
  * @param nPoints Number of elements in input arrays.
  * @param padfX Input array of X coordinates.
  * @param padfY Input array of Y coordinates.
- * @param padfZ Input array of Z values (unused)
+ * @param padfZ Input array of Z values.
  * @param dfXPoint X coordinate of the point to compute.
  * @param dfYPoint Y coordinate of the point to compute.
  * @param pdfValue Pointer to variable where the computed grid node value
@@ -1208,12 +1688,30 @@ GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
  */
 
 CPLErr
-GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
-                                   const double *padfX, const double *padfY,
-                                   CPL_UNUSED const double * padfZ,
-                                   double dfXPoint, double dfYPoint,
-                                   double *pdfValue,
-                                   CPL_UNUSED void * hExtraParamsIn )
+GDALGridDataMetricCount( const void *poOptionsIn, GUInt32 nPoints,
+                         const double *padfX, const double *padfY,
+                         CPL_UNUSED const double * padfZ,
+                         double dfXPoint, double dfYPoint, double *pdfValue,
+                         CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricCountInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                 GDALGridDataMetricAverageDistance()                  */
+/************************************************************************/
+
+static CPLErr
+GDALGridDataMetricAverageDistanceInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                           const double *padfX, const double *padfY,
+                                           CPL_UNUSED const double * padfZ,
+                                           double dfXPoint, double dfYPoint,
+                                           double *pdfValue,
+                                           void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -1233,11 +1731,16 @@ GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     double dfAccumulator = 0.0;
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
-    while( i < nPoints )
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
+    for( GUInt32 k = 0; k < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
 
@@ -1256,8 +1759,6 @@ GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
             dfAccumulator += sqrt( dfRX * dfRX + dfRY * dfRY );
             n++;
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints || n == 0 )
@@ -1272,28 +1773,22 @@ GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
-/************************************************************************/
-/*                 GDALGridDataMetricAverageDistance()                  */
-/************************************************************************/
-
 /**
- * Average distance between points (data metric).
+ * Average distance (data metric).
  *
- * An average distance between the data points found in grid node search
- * ellipse. The distance between each pair of points within ellipse is
- * calculated and average of all distances is set as a grid node value. If
- * there are no points found, the specified NODATA value will be returned.
-
+ * An average distance between the grid node (center of the search ellipse)
+ * and all of the data points found in grid node search ellipse. If there are
+ * no points found, the specified NODATA value will be returned.
  *
  * \f[
- *      Z=\frac{\sum_{i = 1}^{n-1}\sum_{j=i+1}^{n} r_{ij}}{\left(n-1\right)\,n-\frac{n+{\left(n-1\right)}^{2}-1}{2}}
+ *      Z=\frac{\sum_{i = 1}^n r_i}{n}
  * \f]
  *
  *  where
  *  <ul>
  *      <li> \f$Z\f$ is a resulting value at the grid node,
- *      <li> \f$r_{ij}\f$ is an Euclidean distance between points
- *           \f$i\f$ and \f$j\f$,
+ *      <li> \f$r_i\f$ is an Euclidean distance from the grid node
+ *           to point \f$i\f$,
  *      <li> \f$n\f$ is a total number of points in search ellipse.
  *  </ul>
  *
@@ -1312,13 +1807,32 @@ GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
  * @return CE_None on success or CE_Failure if something goes wrong.
  */
 
-CPLErr
-GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
-                                      const double *padfX, const double *padfY,
-                                      CPL_UNUSED const double * padfZ,
-                                      double dfXPoint, double dfYPoint,
-                                      double *pdfValue,
-                                      CPL_UNUSED void * hExtraParamsIn )
+CPLErr
+GDALGridDataMetricAverageDistance( const void *poOptionsIn, GUInt32 nPoints,
+                                   const double *padfX, const double *padfY,
+                                   CPL_UNUSED const double * padfZ,
+                                   double dfXPoint, double dfYPoint,
+                                   double *pdfValue,
+                                   CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricAverageDistanceInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                 GDALGridDataMetricAverageDistance()                  */
+/************************************************************************/
+
+static CPLErr
+GDALGridDataMetricAverageDistancePtsInternal( const void *poOptionsIn, GUInt32 nPoints,
+                                              const double *padfX, const double *padfY,
+                                              CPL_UNUSED const double * padfZ,
+                                              double dfXPoint, double dfYPoint,
+                                              double *pdfValue,
+                                              void * hExtraParamsIn )
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -1337,12 +1851,17 @@ GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     double dfAccumulator = 0.0;
-    GUInt32 i = 0;
     GUInt32 n = 0;
 
+    const GUInt32* panCandidates = nullptr;
+    const GUInt32 nCandidates = GDALGridGetCandidates(
+        hExtraParamsIn, poOptions->dfRadius1, poOptions->dfRadius2, dfAngle,
+        nPoints, dfXPoint, dfYPoint, &panCandidates );
+
     // Search for the first point within the search ellipse.
-    while( i < nPoints - 1 )
+    for( GUInt32 k = 0; k + 1 < nCandidates; k++ )
     {
+        const GUInt32 i = panCandidates ? panCandidates[k] : k;
         double dfRX1 = padfX[i] - dfXPoint;
         double dfRY1 = padfY[i] - dfYPoint;
 
@@ -1360,8 +1879,9 @@ GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
         {
             // Search all the remaining points within the ellipse and compute
             // distances between them and the first point.
-            for( GUInt32 j = i + 1; j < nPoints; j++ )
+            for( GUInt32 l = k + 1; l < nCandidates; l++ )
             {
+                const GUInt32 j = panCandidates ? panCandidates[l] : l;
                 double dfRX2 = padfX[j] - dfXPoint;
                 double dfRY2 = padfY[j] - dfYPoint;
 
@@ -1387,8 +1907,6 @@ GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-
-        i++;
     }
 
     if( n < poOptions->nMinPoints || n == 0 )
@@ -1403,6 +1921,89 @@ GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
     return CE_None;
 }
 
+/**
+ * Average distance between points (data metric).
+ *
+ * An average distance between the data points found in grid node search
+ * ellipse. The distance between each pair of points within ellipse is
+ * calculated and average of all distances is set as a grid node value. If
+ * there are no points found, the specified NODATA value will be returned.
+
+ *
+ * \f[
+ *      Z=\frac{\sum_{i = 1}^{n-1}\sum_{j=i+1}^{n} r_{ij}}{\left(n-1\right)\,n-\frac{n+{\left(n-1\right)}^{2}-1}{2}}
+ * \f]
+ *
+ *  where
+ *  <ul>
+ *      <li> \f$Z\f$ is a resulting value at the grid node,
+ *      <li> \f$r_{ij}\f$ is an Euclidean distance between points
+ *           \f$i\f$ and \f$j\f$,
+ *      <li> \f$n\f$ is a total number of points in search ellipse.
+ *  </ul>
+ *
+ * @param poOptionsIn Algorithm parameters. This should point to
+ * GDALGridDataMetricsOptions object.
+ * @param nPoints Number of elements in input arrays.
+ * @param padfX Input array of X coordinates.
+ * @param padfY Input array of Y coordinates.
+ * @param padfZ Input array of Z values (unused)
+ * @param dfXPoint X coordinate of the point to compute.
+ * @param dfYPoint Y coordinate of the point to compute.
+ * @param pdfValue Pointer to variable where the computed grid node value
+ * will be returned.
+ * @param hExtraParamsIn extra parameters (unused)
+ *
+ * @return CE_None on success or CE_Failure if something goes wrong.
+ */
+
+CPLErr
+GDALGridDataMetricAverageDistancePts( const void *poOptionsIn, GUInt32 nPoints,
+                                      const double *padfX, const double *padfY,
+                                      CPL_UNUSED const double * padfZ,
+                                      double dfXPoint, double dfYPoint,
+                                      double *pdfValue,
+                                      CPL_UNUSED void * hExtraParamsIn )
+{
+    // The extra parameters of external callers are not a
+    // GDALGridExtraParameters structure: use the exhaustive search.
+    return GDALGridDataMetricAverageDistancePtsInternal(
+        poOptionsIn, nPoints, padfX, padfY, padfZ,
+        dfXPoint, dfYPoint, pdfValue, nullptr );
+}
+
+/************************************************************************/
+/*                 GDALGridLinearOutsideTriangulation()                 */
+/*                                                                      */
+/*      Value of a grid node that is not in any triangle.               */
+/************************************************************************/
+
+static CPLErr
+GDALGridLinearOutsideTriangulation( const GDALGridLinearOptions *poOptions,
+                                    GUInt32 nPoints,
+                                    const double *padfX, const double *padfY,
+                                    const double *padfZ,
+                                    double dfXPoint, double dfYPoint,
+                                    double *pdfValue, void *hExtraParams )
+{
+    const double dfRadius = poOptions->dfRadius;
+    if( dfRadius == 0.0 )
+    {
+        *pdfValue = poOptions->dfNoDataValue;
+        return CE_None;
+    }
+
+    GDALGridNearestNeighborOptions sNeighbourOptions;
+    sNeighbourOptions.dfRadius1 = dfRadius < 0.0 ? 0.0 : dfRadius;
+    sNeighbourOptions.dfRadius2 = dfRadius < 0.0 ? 0.0 : dfRadius;
+    sNeighbourOptions.dfAngle = 0.0;
+    sNeighbourOptions.dfNoDataValue = poOptions->dfNoDataValue;
+    return GDALGridNearestNeighbor( &sNeighbourOptions, nPoints,
+                                    padfX, padfY, padfZ,
+                                    dfXPoint, dfYPoint, pdfValue,
+                                    hExtraParams );
+}
+
 /************************************************************************/
 /*                        GDALGridLinear()                              */
 /************************************************************************/
@@ -1485,28 +2086,194 @@ GDALGridLinear( const void *poOptionsIn, GUInt32 nPoints,
             psExtraParams->nInitialFacetIdx = nOutputFacetIdx;
         }
 
-        const GDALGridLinearOptions *const poOptions =
-            static_cast<const GDALGridLinearOptions *>(poOptionsIn);
-        const double dfRadius = poOptions->dfRadius;
-        if( dfRadius == 0.0 )
+        return GDALGridLinearOutsideTriangulation(
+            static_cast<const GDALGridLinearOptions *>(poOptionsIn),
+            nPoints, padfX, padfY, padfZ, dfXPoint, dfYPoint, pdfValue,
+            hExtraParams );
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         GDALGridLinearTiling                         */
+/************************************************************************/
+
+/* When the GDAL_GRID_LINEAR_TILE_SIZE configuration option is set, the
+ * linear method does not triangulate the whole point set, but, for each
+ * tile of the output grid, the points in a rectangle around it. A triangle
+ * of such a local triangulation is also a triangle of the global Delaunay
+ * triangulation when its circumcircle contains no point outside of the
+ * rectangle, which is checked with the k-d tree. Otherwise, or when a node
+ * inside the convex hull of the points is not covered, the rectangle is
+ * enlarged.
+ */
+struct GDALGridLinearTiling
+{
+    // Size, in grid nodes, of the side of a tile.
+    GUInt32             nTileSize = 0;
+    // Typical distance between two points.
+    double              dfPointSpacing = 0;
+    // Convex hull of the points, in counterclockwise order.
+    std::vector<double> adfHullX{};
+    std::vector<double> adfHullY{};
+
+    bool IsInHull( double dfX, double dfY ) const;
+};
+
+/************************************************************************/
+/*                           GDALGridCross()                            */
+/************************************************************************/
+
+// Cross product of (A - O) and (B - O): positive if O, A, B turn
+// counterclockwise.
+static double GDALGridCross( double dfOX, double dfOY,
+                             double dfAX, double dfAY,
+                             double dfBX, double dfBY )
+{
+    return (dfAX - dfOX) * (dfBY - dfOY) - (dfAY - dfOY) * (dfBX - dfOX);
+}
+
+/************************************************************************/
+/*                    GDALGridLinearTiling::IsInHull()                  */
+/************************************************************************/
+
+bool GDALGridLinearTiling::IsInHull( double dfX, double dfY ) const
+{
+    const size_t nHull = adfHullX.size();
+    const double dfX0 = adfHullX[0];
+    const double dfY0 = adfHullY[0];
+    if( GDALGridCross(dfX0, dfY0, adfHullX[1], adfHullY[1], dfX, dfY) < 0 ||
+        GDALGridCross(dfX0, dfY0, adfHullX[nHull - 1], adfHullY[nHull - 1],
+                      dfX, dfY) > 0 )
+    {
+        return false;
+    }
+
+    // Find the fan triangle (0, i, i + 1) that may contain the point.
+    size_t nLow = 1;
+    size_t nHigh = nHull - 1;
+    while( nHigh - nLow > 1 )
+    {
+        const size_t nMid = (nLow + nHigh) / 2;
+        if( GDALGridCross(dfX0, dfY0, adfHullX[nMid], adfHullY[nMid],
+                          dfX, dfY) >= 0 )
+            nLow = nMid;
+        else
+            nHigh = nMid;
+    }
+    return GDALGridCross(adfHullX[nLow], adfHullY[nLow],
+                         adfHullX[nLow + 1], adfHullY[nLow + 1],
+                         dfX, dfY) >= 0;
+}
+
+/************************************************************************/
+/*                     GDALGridLinearTilingCreate()                     */
+/************************************************************************/
+
+static GDALGridLinearTiling*
+GDALGridLinearTilingCreate( const GDALGridKDTree* psTree, GUInt32 nTileSize )
+{
+    GDALGridLinearTiling* psTiling = nullptr;
+    try
+    {
+        psTiling = new GDALGridLinearTiling();
+        psTiling->nTileSize = nTileSize;
+
+        const std::vector<double>& adfX = psTree->adfX;
+        const std::vector<double>& adfY = psTree->adfY;
+        const size_t nPoints = adfX.size();
+        const GDALGridKDTree::Node& sRoot = psTree->asNodes[0];
+        psTiling->dfPointSpacing =
+            sqrt((sRoot.dfMaxX - sRoot.dfMinX) *
+                 (sRoot.dfMaxY - sRoot.dfMinY) / nPoints);
+
+        // Discard the points strictly inside the quadrilateral of the
+        // leftmost, lowest, rightmost and highest points, which cannot be
+        // on the hull.
+        size_t anExtreme[4] = { 0, 0, 0, 0 };
+        for( size_t i = 1; i < nPoints; i++ )
+        {
+            if( adfX[i] < adfX[anExtreme[0]] ) anExtreme[0] = i;
+            if( adfY[i] < adfY[anExtreme[1]] ) anExtreme[1] = i;
+            if( adfX[i] > adfX[anExtreme[2]] ) anExtreme[2] = i;
+            if( adfY[i] > adfY[anExtreme[3]] ) anExtreme[3] = i;
+        }
+        std::vector<std::pair<double, double>> asPoints;
+        for( size_t i = 0; i < nPoints; i++ )
+        {
+            bool bInside = true;
+            for( int k = 0; bInside && k < 4; k++ )
+            {
+                const size_t iA = anExtreme[k];
+                const size_t iB = anExtreme[(k + 1) % 4];
+                bInside = GDALGridCross(adfX[iA], adfY[iA],
+                                        adfX[iB], adfY[iB],
+                                        adfX[i], adfY[i]) > 0;
+            }
+            if( !bInside )
+                asPoints.emplace_back(adfX[i], adfY[i]);
+        }
+        std::sort(asPoints.begin(), asPoints.end());
+        asPoints.erase(std::unique(asPoints.begin(), asPoints.end()),
+                       asPoints.end());
+
+        // Andrew's monotone chain.
+        const size_t nCandidates = asPoints.size();
+        if( nCandidates < 3 )
         {
-            *pdfValue = poOptions->dfNoDataValue;
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Delaunay triangulation failed");
+            delete psTiling;
+            return nullptr;
         }
-        else
+        std::vector<std::pair<double, double>> asHull(2 * nCandidates);
+        size_t nHull = 0;
+        const auto Turn = [&asHull, &nHull](const std::pair<double, double>& p)
+        {
+            return GDALGridCross(asHull[nHull - 2].first,
+                                 asHull[nHull - 2].second,
+                                 asHull[nHull - 1].first,
+                                 asHull[nHull - 1].second,
+                                 p.first, p.second);
+        };
+        for( size_t i = 0; i < nCandidates; i++ )
+        {
+            while( nHull >= 2 && Turn(asPoints[i]) <= 0 )
+                nHull--;
+            asHull[nHull++] = asPoints[i];
+        }
+        const size_t nLowerHull = nHull + 1;
+        for( size_t i = nCandidates - 1; i > 0; i-- )
+        {
+            while( nHull >= nLowerHull && Turn(asPoints[i - 1]) <= 0 )
+                nHull--;
+            asHull[nHull++] = asPoints[i - 1];
+        }
+        // The first point is repeated at the end.
+        nHull--;
+        if( nHull < 3 )
+        {
+            // All points are aligned.
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Delaunay triangulation failed");
+            delete psTiling;
+            return nullptr;
+        }
+        for( size_t i = 0; i < nHull; i++ )
         {
-            GDALGridNearestNeighborOptions sNeighbourOptions;
-            sNeighbourOptions.dfRadius1 = dfRadius < 0.0 ? 0.0 : dfRadius;
-            sNeighbourOptions.dfRadius2 = dfRadius < 0.0 ? 0.0 : dfRadius;
-            sNeighbourOptions.dfAngle = 0.0;
-            sNeighbourOptions.dfNoDataValue = poOptions->dfNoDataValue;
-            return GDALGridNearestNeighbor( &sNeighbourOptions, nPoints,
-                                            padfX, padfY, padfZ,
-                                            dfXPoint, dfYPoint, pdfValue,
-                                            hExtraParams );
+            psTiling->adfHullX.push_back(asHull[i].first);
+            psTiling->adfHullY.push_back(asHull[i].second);
         }
     }
-
-    return CE_None;
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate convex hull of points");
+        delete psTiling;
+        return nullptr;
+    }
+    return psTiling;
 }
 
 /************************************************************************/
@@ -1537,6 +2304,13 @@ struct _GDALGridJob
     int               (*pfnProgress)(GDALGridJob* psJob);
     GDALDataType        eType;
 
+    // Linear method by tiles: tiles of nTileSize x nTileSize nodes are
+    // processed instead of lines when it is not zero.
+    const GDALGridLinearTiling* psLinearTiling;
+    GUInt32             nTileSize;
+    // Number of lines, or tiles, to process.
+    GUInt32             nProgressTotal;
+
     volatile int   *pnCounter;
     volatile int   *pbStop;
     CPLCond        *hCond;
@@ -1570,7 +2344,8 @@ static int GDALGridProgressMultiThread( GDALGridJob* psJob )
 static int GDALGridProgressMonoThread( GDALGridJob* psJob )
 {
     const int nCounter = ++(*psJob->pnCounter);
-    if( !psJob->pfnRealProgress( nCounter / static_cast<double>(psJob->nYSize),
+    if( !psJob->pfnRealProgress( nCounter /
+                                    static_cast<double>(psJob->nProgressTotal),
                                  "", psJob->pRealProgressArg ) )
     {
         CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
@@ -1580,6 +2355,308 @@ static int GDALGridProgressMonoThread( GDALGridJob* psJob )
     return FALSE;
 }
 
+/************************************************************************/
+/*                      GDALGridLinearProcessTile()                     */
+/*                                                                      */
+/*      Compute the values of the nodes of a tile with the              */
+/*      triangulation of the points at most dfMargin away from it.      */
+/*      bRetry is set if a larger margin is needed.                     */
+/************************************************************************/
+
+static CPLErr GDALGridLinearProcessTile( const GDALGridJob* psJob,
+                                         GDALGridExtraParameters* psExtraParams,
+                                         GUInt32 nXOff, GUInt32 nYOff,
+                                         GUInt32 nTileXSize,
+                                         GUInt32 nTileYSize,
+                                         double dfMargin, double* padfValues,
+                                         bool& bRetry )
+{
+    bRetry = false;
+    const GDALGridKDTree* psTree = psExtraParams->psKDTree;
+    const double* padfZ = psJob->padfZ;
+
+    double dfNodeMinX = psJob->dfXMin + ( nXOff + 0.5 ) * psJob->dfDeltaX;
+    double dfNodeMaxX =
+        psJob->dfXMin + ( nXOff + nTileXSize - 0.5 ) * psJob->dfDeltaX;
+    if( dfNodeMinX > dfNodeMaxX )
+        std::swap(dfNodeMinX, dfNodeMaxX);
+    double dfNodeMinY = psJob->dfYMin + ( nYOff + 0.5 ) * psJob->dfDeltaY;
+    double dfNodeMaxY =
+        psJob->dfYMin + ( nYOff + nTileYSize - 0.5 ) * psJob->dfDeltaY;
+    if( dfNodeMinY > dfNodeMaxY )
+        std::swap(dfNodeMinY, dfNodeMaxY);
+    psExtraParams->psRowCandidates->dfXMin = dfNodeMinX;
+    psExtraParams->psRowCandidates->dfXMax = dfNodeMaxX;
+
+    const double dfMinX = dfNodeMinX - dfMargin;
+    const double dfMinY = dfNodeMinY - dfMargin;
+    const double dfMaxX = dfNodeMaxX + dfMargin;
+    const double dfMaxY = dfNodeMaxY + dfMargin;
+
+    std::vector<GUInt32> anIdx;
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    std::vector<signed char> abValidFacet;
+    try
+    {
+        psTree->Search(dfMinX, dfMinY, dfMaxX, dfMaxY,
+                       [psTree, &anIdx](GUInt32 i)
+                       { anIdx.push_back(psTree->anIdx[i]); });
+        // Make the triangulation independent of the tree layout.
+        std::sort(anIdx.begin(), anIdx.end());
+        adfX.resize(anIdx.size());
+        adfY.resize(anIdx.size());
+        for( size_t i = 0; i < anIdx.size(); i++ )
+        {
+            adfX[i] = psJob->padfX[anIdx[i]];
+            adfY[i] = psJob->padfY[anIdx[i]];
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate points of tile");
+        return CE_Failure;
+    }
+    const bool bAllPoints = anIdx.size() == psTree->anIdx.size();
+    const int nLocalPoints = static_cast<int>(
+        std::min(anIdx.size(), static_cast<size_t>(INT_MAX)));
+    if( nLocalPoints != static_cast<int>(anIdx.size()) )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Too many points in tile. "
+                 "Decrease GDAL_GRID_LINEAR_TILE_SIZE");
+        return CE_Failure;
+    }
+
+    // Qhull fails on aligned points: do not even try.
+    bool bAligned = true;
+    for( int i = 1; bAligned && i < nLocalPoints; i++ )
+    {
+        if( adfX[i] == adfX[0] && adfY[i] == adfY[0] )
+            continue;
+        for( int j = i + 1; bAligned && j < nLocalPoints; j++ )
+        {
+            bAligned = GDALGridCross(adfX[0], adfY[0], adfX[i], adfY[i],
+                                     adfX[j], adfY[j]) == 0;
+        }
+        break;
+    }
+
+    GDALTriangulation* psDT = nullptr;
+    if( !bAligned )
+    {
+        // Qhull is not reentrant: GDALTriangulationCreateDelaunay() holds a
+        // global mutex, so the triangulations of the tiles are computed one at
+        // a time, and only the interpolation of the nodes runs in parallel.
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        psDT = GDALTriangulationCreateDelaunay(nLocalPoints,
+                                               adfX.data(), adfY.data());
+        CPLPopErrorHandler();
+    }
+    if( psDT == nullptr || psDT->nFacets == 0 )
+    {
+        if( psDT != nullptr )
+            GDALTriangulationFree(psDT);
+        if( bAllPoints )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Delaunay triangulation failed");
+            return CE_Failure;
+        }
+        bRetry = true;
+        return CE_None;
+    }
+    if( !GDALTriangulationComputeBarycentricCoefficients(psDT, adfX.data(),
+                                                          adfY.data()) )
+    {
+        GDALTriangulationFree(psDT);
+        return CE_Failure;
+    }
+    try
+    {
+        abValidFacet.resize(psDT->nFacets, 0);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate triangulation of tile");
+        GDALTriangulationFree(psDT);
+        return CE_Failure;
+    }
+
+    // Whether a triangle of the local triangulation is one of the global
+    // Delaunay triangulation.
+    const auto IsValidFacet = [&](int nFacetIdx)
+    {
+        if( abValidFacet[nFacetIdx] == 0 )
+        {
+            const int* panVertexIdx = psDT->pasFacets[nFacetIdx].anVertexIdx;
+            const double dfAX = adfX[panVertexIdx[0]];
+            const double dfAY = adfY[panVertexIdx[0]];
+            const double dfBX = adfX[panVertexIdx[1]] - dfAX;
+            const double dfBY = adfY[panVertexIdx[1]] - dfAY;
+            const double dfCX = adfX[panVertexIdx[2]] - dfAX;
+            const double dfCY = adfY[panVertexIdx[2]] - dfAY;
+            const double dfDenom = 2 * (dfBX * dfCY - dfBY * dfCX);
+            bool bValid = false;
+            if( dfDenom != 0 )
+            {
+                const double dfB2 = dfBX * dfBX + dfBY * dfBY;
+                const double dfC2 = dfCX * dfCX + dfCY * dfCY;
+                const double dfUX = (dfCY * dfB2 - dfBY * dfC2) / dfDenom;
+                const double dfUY = (dfBX * dfC2 - dfCX * dfB2) / dfDenom;
+                bValid = !psTree->HasPointInCircle(
+                    dfAX + dfUX, dfAY + dfUY, dfUX * dfUX + dfUY * dfUY,
+                    dfMinX, dfMinY, dfMaxX, dfMaxY);
+            }
+            abValidFacet[nFacetIdx] = bValid ? 1 : -1;
+        }
+        return abValidFacet[nFacetIdx] > 0;
+    };
+
+    const GDALGridLinearOptions* poOptions =
+        static_cast<const GDALGridLinearOptions *>(psJob->poOptions);
+    CPLErr eErr = CE_None;
+    int nFacetIdx = 0;
+    for( GUInt32 j = 0; !bRetry && eErr == CE_None && j < nTileYSize; j++ )
+    {
+        const double dfYPoint =
+            psJob->dfYMin + ( nYOff + j + 0.5 ) * psJob->dfDeltaY;
+        for( GUInt32 i = 0; i < nTileXSize; i++ )
+        {
+            const double dfXPoint =
+                psJob->dfXMin + ( nXOff + i + 0.5 ) * psJob->dfDeltaX;
+            double* pdfValue =
+                padfValues + static_cast<size_t>(j) * nTileXSize + i;
+
+            int nOutputFacetIdx = -1;
+            const bool bFound = CPL_TO_BOOL(GDALTriangulationFindFacetDirected(
+                psDT, nFacetIdx, dfXPoint, dfYPoint, &nOutputFacetIdx));
+            if( nOutputFacetIdx >= 0 )
+                nFacetIdx = nOutputFacetIdx;
+            if( bFound )
+            {
+                if( !bAllPoints && !IsValidFacet(nOutputFacetIdx) )
+                {
+                    bRetry = true;
+                    break;
+                }
+                double lambda1 = 0.0;
+                double lambda2 = 0.0;
+                double lambda3 = 0.0;
+                GDALTriangulationComputeBarycentricCoordinates(
+                    psDT, nOutputFacetIdx, dfXPoint, dfYPoint,
+                    &lambda1, &lambda2, &lambda3);
+                const int* panVertexIdx =
+                    psDT->pasFacets[nOutputFacetIdx].anVertexIdx;
+                *pdfValue = lambda1 * padfZ[anIdx[panVertexIdx[0]]] +
+                            lambda2 * padfZ[anIdx[panVertexIdx[1]]] +
+                            lambda3 * padfZ[anIdx[panVertexIdx[2]]];
+            }
+            else if( !bAllPoints &&
+                     psJob->psLinearTiling->IsInHull(dfXPoint, dfYPoint) )
+            {
+                bRetry = true;
+                break;
+            }
+            else
+            {
+                eErr = GDALGridLinearOutsideTriangulation(
+                    poOptions, psJob->nPoints, psJob->padfX, psJob->padfY,
+                    padfZ, dfXPoint, dfYPoint, pdfValue, psExtraParams);
+                if( eErr != CE_None )
+                {
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                              "Gridding failed at X position %lu, "
+                              "Y position %lu",
+                              static_cast<long unsigned int>(nXOff + i),
+                              static_cast<long unsigned int>(nYOff + j) );
+                    break;
+                }
+            }
+        }
+    }
+
+    GDALTriangulationFree(psDT);
+    return eErr;
+}
+
+/************************************************************************/
+/*                   GDALGridJobProcessLinearTiles()                    */
+/************************************************************************/
+
+static void GDALGridJobProcessLinearTiles( GDALGridJob* psJob )
+{
+    int (*pfnProgress)(GDALGridJob* psJob) = psJob->pfnProgress;
+    const GUInt32 nTileSize = psJob->nTileSize;
+    const GUInt32 nXSize = psJob->nXSize;
+    const GUInt32 nYSize = psJob->nYSize;
+    const GUInt32 nTilesPerRow = (nXSize - 1) / nTileSize + 1;
+
+    double *padfValues = static_cast<double *>(
+        VSI_MALLOC3_VERBOSE( sizeof(double), nTileSize, nTileSize ));
+    if( padfValues == nullptr )
+    {
+        *(psJob->pbStop) = TRUE;
+        if( pfnProgress != nullptr )
+            pfnProgress(psJob);  // To notify the main thread.
+        return;
+    }
+
+    GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    GDALGridRowCandidates oRowCandidates;
+    sExtraParameters.psRowCandidates = &oRowCandidates;
+
+    const GDALDataType eType = psJob->eType;
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
+    const size_t nLineSpace = static_cast<size_t>(nXSize) * nDataTypeSize;
+
+    for( GUInt32 nTile = psJob->nYStart; nTile < psJob->nProgressTotal;
+         nTile += psJob->nYStep )
+    {
+        const GUInt32 nXOff = (nTile % nTilesPerRow) * nTileSize;
+        const GUInt32 nYOff = (nTile / nTilesPerRow) * nTileSize;
+        const GUInt32 nTileXSize = std::min(nTileSize, nXSize - nXOff);
+        const GUInt32 nTileYSize = std::min(nTileSize, nYSize - nYOff);
+
+        // Start with a margin that should contain the points of the
+        // triangles covering the tile when points are evenly distributed.
+        double dfMargin = 4 * psJob->psLinearTiling->dfPointSpacing;
+        bool bRetry = true;
+        CPLErr eErr = CE_None;
+        while( bRetry && eErr == CE_None )
+        {
+            eErr = GDALGridLinearProcessTile(psJob, &sExtraParameters,
+                                             nXOff, nYOff,
+                                             nTileXSize, nTileYSize,
+                                             dfMargin, padfValues, bRetry);
+            dfMargin *= 2;
+        }
+        if( eErr != CE_None )
+        {
+            *psJob->pbStop = TRUE;
+            if( pfnProgress != nullptr )
+                pfnProgress(psJob);  // To notify the main thread.
+            break;
+        }
+
+        for( GUInt32 j = 0; j < nTileYSize; j++ )
+        {
+            GDALCopyWords( padfValues + static_cast<size_t>(j) * nTileXSize,
+                           GDT_Float64, sizeof(double),
+                           psJob->pabyData + (nYOff + j) * nLineSpace +
+                               static_cast<size_t>(nXOff) * nDataTypeSize,
+                           eType, nDataTypeSize, nTileXSize );
+        }
+
+        if( *psJob->pbStop || (pfnProgress != nullptr && pfnProgress(psJob)) )
+            break;
+    }
+
+    CPLFree(padfValues);
+}
+
 /************************************************************************/
 /*                         GDALGridJobProcess()                         */
 /************************************************************************/
@@ -1587,6 +2664,12 @@ static int GDALGridProgressMonoThread( GDALGridJob* psJob )
 static void GDALGridJobProcess( void* user_data )
 {
     GDALGridJob* const psJob = static_cast<GDALGridJob *>(user_data);
+    if( psJob->nTileSize != 0 )
+    {
+        GDALGridJobProcessLinearTiles(psJob);
+        return;
+    }
+
     int (*pfnProgress)(GDALGridJob* psJob) = psJob->pfnProgress;
     const GUInt32 nXSize = psJob->nXSize;
 
@@ -1623,6 +2706,13 @@ static void GDALGridJobProcess( void* user_data )
     // Have a local copy of sExtraParameters since we want to modify
     // nInitialFacetIdx.
     GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    // The nodes of a line share the search of their neighbouring points.
+    GDALGridRowCandidates oRowCandidates;
+    oRowCandidates.dfXMin = dfXMin + 0.5 * dfDeltaX;
+    oRowCandidates.dfXMax = dfXMin + ( nXSize - 0.5 ) * dfDeltaX;
+    if( oRowCandidates.dfXMin > oRowCandidates.dfXMax )
+        std::swap(oRowCandidates.dfXMin, oRowCandidates.dfXMax);
+    sExtraParameters.psRowCandidates = &oRowCandidates;
     const GDALDataType eType = psJob->eType;
 
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
@@ -1663,6 +2753,16 @@ static void GDALGridJobProcess( void* user_data )
     CPLFree(padfValues);
 }
 
+/************************************************************************/
+/*                      GDALGridHasSearchEllipse()                      */
+/************************************************************************/
+
+// Whether the k-d tree can be used to find the points in the search ellipse.
+template<class T> static bool GDALGridHasSearchEllipse( const T* poOptions )
+{
+    return poOptions->dfRadius1 > 0 && poOptions->dfRadius2 > 0;
+}
+
 /************************************************************************/
 /*                        GDALGridContextCreate()                       */
 /************************************************************************/
@@ -1683,6 +2783,8 @@ struct GDALGridContext
     double*             padfZ;
     bool                bFreePadfXYZArrays;
 
+    GDALGridLinearTiling* psLinearTiling;
+
     CPLWorkerThreadPool *poWorkerThreadPool;
 };
 
@@ -1712,6 +2814,18 @@ static void GDALGridContextCreateQuadTree( GDALGridContext* psContext );
  * the number of worker threads, or ALL_CPUS to use all the cores/CPUs of the
  * computer (default value).
  *
+ * Starting with GDAL 3.4, for the 'linear' algorithm, the
+ * GDAL_GRID_LINEAR_TILE_SIZE configuration option can be set to a number of
+ * grid nodes, so that the grid is processed by tiles of that size with a
+ * triangulation of the points around each tile, instead of a triangulation of
+ * all the points. The triangulations of the tiles are computed one at a time,
+ * as Qhull is not reentrant.
+ *
+ * Starting with GDAL 3.4, the nearest neighbor algorithm without search
+ * ellipse always returns the value of the nearest point (the one with the
+ * highest index in case of ties). Previous versions could return the value of
+ * a point slightly further.
+ *
  * @param eAlgorithm Gridding method.
  * @param poOptions Options to control chosen gridding method.
  * @param nPoints Number of elements in input arrays.
@@ -1741,6 +2855,7 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
     CPLAssert( padfY );
     CPLAssert( padfZ );
     bool bCreateQuadTree = false;
+    bool bCreateKDTree = false;
 
     // Starting address aligned on 32-byte boundary for AVX.
     float* pafXAligned = nullptr;
@@ -1880,7 +2995,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
                    poOptions,
                    sizeof(GDALGridMovingAverageOptions));
 
-            pfnGDALGridMethod = GDALGridMovingAverage;
+            pfnGDALGridMethod = GDALGridMovingAverageInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridMovingAverageOptions *>(poOptions));
             break;
         }
         case GGA_NearestNeighbor:
@@ -1890,9 +3007,11 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
                    sizeof(GDALGridNearestNeighborOptions));
 
             pfnGDALGridMethod = GDALGridNearestNeighbor;
-            bCreateQuadTree = (nPoints > 100 &&
-                static_cast<const GDALGridNearestNeighborOptions *>(poOptions)->dfRadius1 ==
-                static_cast<const GDALGridNearestNeighborOptions *>(poOptions)->dfRadius2);
+            const auto poNNOptions =
+                static_cast<const GDALGridNearestNeighborOptions *>(poOptions);
+            bCreateKDTree = GDALGridHasSearchEllipse(poNNOptions) ||
+                            (poNNOptions->dfRadius1 == 0.0 &&
+                             poNNOptions->dfRadius2 == 0.0);
             break;
         }
         case GGA_MetricMinimum:
@@ -1900,7 +3019,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricMinimum;
+            pfnGDALGridMethod = GDALGridDataMetricMinimumInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_MetricMaximum:
@@ -1908,7 +3029,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricMaximum;
+            pfnGDALGridMethod = GDALGridDataMetricMaximumInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_MetricRange:
@@ -1916,7 +3039,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricRange;
+            pfnGDALGridMethod = GDALGridDataMetricRangeInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_MetricCount:
@@ -1924,7 +3049,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricCount;
+            pfnGDALGridMethod = GDALGridDataMetricCountInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_MetricAverageDistance:
@@ -1932,7 +3059,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricAverageDistance;
+            pfnGDALGridMethod = GDALGridDataMetricAverageDistanceInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_MetricAverageDistancePts:
@@ -1940,7 +3069,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             poOptionsNew = CPLMalloc(sizeof(GDALGridDataMetricsOptions));
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
-            pfnGDALGridMethod = GDALGridDataMetricAverageDistancePts;
+            pfnGDALGridMethod = GDALGridDataMetricAverageDistancePtsInternal;
+            bCreateKDTree = GDALGridHasSearchEllipse(
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions));
             break;
         }
         case GGA_Linear:
@@ -1996,6 +3127,9 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
     psContext->sExtraParameters.pafZ = pafZAligned;
     psContext->sExtraParameters.psTriangulation = nullptr;
     psContext->sExtraParameters.nInitialFacetIdx = 0;
+    psContext->sExtraParameters.psKDTree = nullptr;
+    psContext->sExtraParameters.psRowCandidates = nullptr;
+    psContext->psLinearTiling = nullptr;
     psContext->padfX = pafXAligned ? nullptr : const_cast<double *>(padfX);
     psContext->padfY = pafXAligned ? nullptr : const_cast<double *>(padfY);
     psContext->padfZ = pafXAligned ? nullptr : const_cast<double *>(padfZ);
@@ -2010,6 +3144,15 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
         GDALGridContextCreateQuadTree(psContext);
     }
 
+/* -------------------------------------------------------------------- */
+/*  Create k-d tree if requested.                                       */
+/* -------------------------------------------------------------------- */
+    if( bCreateKDTree )
+    {
+        psContext->sExtraParameters.psKDTree =
+            GDALGridKDTreeCreate(nPoints, padfX, padfY);
+    }
+
     /* -------------------------------------------------------------------- */
     /*  Pre-compute extra parameters in GDALGridExtraParameters              */
     /* -------------------------------------------------------------------- */
@@ -2025,7 +3168,30 @@ GDALGridContextCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
         psContext->sExtraParameters.dfRadiusPower4PreComp = pow ( dfRadius, 4 );
     }
 
-    if( eAlgorithm == GGA_Linear )
+    const int nLinearTileSize =
+        atoi(CPLGetConfigOption("GDAL_GRID_LINEAR_TILE_SIZE", "0"));
+    if( eAlgorithm == GGA_Linear && nLinearTileSize > 0 )
+    {
+        psContext->sExtraParameters.psKDTree =
+            GDALGridKDTreeCreate(nPoints, padfX, padfY);
+        if( psContext->sExtraParameters.psKDTree != nullptr )
+        {
+            psContext->psLinearTiling = GDALGridLinearTilingCreate(
+                psContext->sExtraParameters.psKDTree, nLinearTileSize);
+        }
+        else if( nPoints != 0 )
+        {
+            // All points have NaN coordinates.
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Delaunay triangulation failed");
+        }
+        if( psContext->psLinearTiling == nullptr )
+        {
+            GDALGridContextFree(psContext);
+            return nullptr;
+        }
+    }
+    else if( eAlgorithm == GGA_Linear )
     {
         psContext->sExtraParameters.psTriangulation =
                 GDALTriangulationCreateDelaunay(nPoints, padfX, padfY);
@@ -2145,6 +3311,8 @@ void GDALGridContextFree( GDALGridContext* psContext )
         VSIFreeAligned(psContext->sExtraParameters.pafZ);
         if( psContext->sExtraParameters.psTriangulation )
             GDALTriangulationFree(psContext->sExtraParameters.psTriangulation);
+        GDALGridKDTreeFree(psContext->sExtraParameters.psKDTree);
+        delete psContext->psLinearTiling;
         delete psContext->poWorkerThreadPool;
         CPLFree(psContext);
     }
@@ -2203,7 +3371,8 @@ CPLErr GDALGridContextProcess(
     // by sampling along the edges.  If all points on edges are within
     // triangles, then interior points will also be.
     if( psContext->eAlgorithm == GGA_Linear &&
-        psContext->sExtraParameters.hQuadTree == nullptr )
+        psContext->sExtraParameters.psTriangulation != nullptr &&
+        psContext->sExtraParameters.psKDTree == nullptr )
     {
         bool bNeedNearest = false;
         int nStartLeft = 0;
@@ -2261,7 +3430,9 @@ CPLErr GDALGridContextProcess(
         if( bNeedNearest )
         {
             CPLDebug("GDAL_GRID", "Will need nearest neighbour");
-            GDALGridContextCreateQuadTree(psContext);
+            psContext->sExtraParameters.psKDTree =
+                GDALGridKDTreeCreate(psContext->nPoints,
+                                     psContext->padfX, psContext->padfY);
         }
     }
 
@@ -2292,6 +3463,22 @@ CPLErr GDALGridContextProcess(
     sJob.pbStop = &bStop;
     sJob.hCond = nullptr;
     sJob.hCondMutex = nullptr;
+    sJob.psLinearTiling = psContext->psLinearTiling;
+    sJob.nTileSize = 0;
+    sJob.nProgressTotal = nYSize;
+    if( psContext->psLinearTiling != nullptr )
+    {
+        // Keep the number of tiles in the range of the progress counter.
+        GUInt32 nTileSize = psContext->psLinearTiling->nTileSize;
+        while( static_cast<GUIntBig>((nXSize - 1) / nTileSize + 1) *
+                   ((nYSize - 1) / nTileSize + 1) > INT_MAX )
+        {
+            nTileSize *= 2;
+        }
+        sJob.nTileSize = nTileSize;
+        sJob.nProgressTotal =
+            ((nXSize - 1) / nTileSize + 1) * ((nYSize - 1) / nTileSize + 1);
+    }
 
     if( psContext->poWorkerThreadPool == nullptr )
     {
@@ -2328,7 +3515,7 @@ CPLErr GDALGridContextProcess(
 /* -------------------------------------------------------------------- */
 /*      Report progress.                                                */
 /* -------------------------------------------------------------------- */
-        while( nCounter < static_cast<int>(nYSize) && !bStop )
+        while( nCounter < static_cast<int>(sJob.nProgressTotal) && !bStop )
         {
             CPLCondWait(sJob.hCond, sJob.hCondMutex);
 
@@ -2336,7 +3523,8 @@ CPLErr GDALGridContextProcess(
             CPLReleaseMutex(sJob.hCondMutex);
 
             if( pfnProgress != nullptr &&
-                !pfnProgress( nLocalCounter / static_cast<double>(nYSize),
+                !pfnProgress( nLocalCounter /
+                                static_cast<double>(sJob.nProgressTotal),
                               "", pProgressArg ) )
             {
                 CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
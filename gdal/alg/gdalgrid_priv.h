@@ -35,6 +35,9 @@
 
 //! @cond Doxygen_Suppress
 
+struct GDALGridKDTree;
+struct GDALGridRowCandidates;
+
 typedef struct
 {
     const double* padfX;
@@ -62,6 +65,10 @@ typedef struct
     double  dfRadiusPower2PreComp;
     /*! The radius of search circle to power 4 (pre-computation). */
     double  dfRadiusPower4PreComp;
+    /*! Static k-d tree of the points, or NULL. */
+    const GDALGridKDTree* psKDTree;
+    /*! Points near the current row of grid nodes, owned by each job. */
+    GDALGridRowCandidates* psRowCandidates;
 } GDALGridExtraParameters;
 
 #ifdef HAVE_SSE_AT_COMPILE_TIME
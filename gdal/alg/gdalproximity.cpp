@@ -34,13 +34,21 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -50,6 +58,16 @@ ProcessProximityLine( GInt32 *panSrcScanline, int *panNearX, int *panNearY,
                       float *pafProximity, double *pdfSrcNoDataValue,
                       int nTargetValues, int *panTargetValues );
 
+static CPLErr
+GDALComputeProximityEDT( GDALRasterBandH hSrcBand,
+                         GDALRasterBandH hWorkProximityBand,
+                         GDALRasterBandH hProximityBand,
+                         int nThreads, double dfMaxDist, double dfDistMult,
+                         const double *pdfSrcNoDataValue, float fNoDataValue,
+                         bool bFixedBufVal, double dfFixedBufVal,
+                         int nTargetValues, const int *panTargetValues,
+                         GDALProgressFunc pfnProgress, void *pProgressArg );
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -106,6 +124,17 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.4) If this option is set, proximities are computed with an
+exact Euclidean distance transform instead of the default two pass
+propagation, which may in rare configurations not find the nearest
+target.  A vertical pass counts the lines to the nearest target above and
+below each pixel, and a horizontal pass takes the lower envelope of the
+resulting parabolas for each line.  Both passes are processed by blocks
+of lines, to bound memory use, and the work within a block is shared
+among the requested number of worker threads.
 */
 
 CPLErr CPL_STDCALL
@@ -243,6 +272,11 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         CSLDestroy( papszValuesTokens );
     }
 
+/* -------------------------------------------------------------------- */
+/*      NUM_THREADS selects the exact distance transform.               */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads( papszOptions, "NUM_THREADS", 0 );
+
 /* -------------------------------------------------------------------- */
 /*      Initialize progress counter.                                    */
 /* -------------------------------------------------------------------- */
@@ -270,9 +304,12 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
     GInt32 *panSrcScanline = nullptr;
     bool bTempFileAlreadyDeleted = false;
 
+    // The exact distance transform stores line counts, which may not fit
+    // in a Int16 band.
     if( eProxType == GDT_Byte
         || eProxType == GDT_UInt16
-        || eProxType == GDT_UInt32 )
+        || eProxType == GDT_UInt32
+        || (nThreads > 0 && eProxType == GDT_Int16) )
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if( hDriver == nullptr )
@@ -298,6 +335,16 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand( hWorkProximityDS, 1 );
     }
 
+    if( nThreads > 0 )
+    {
+        eErr = GDALComputeProximityEDT(
+            hSrcBand, hWorkProximityBand, hProximityBand, nThreads,
+            dfMaxDist, dfDistMult, pdfSrcNoData, fNoDataValue,
+            bFixedBufVal, dfFixedBufVal, nTargetValues, panTargetValues,
+            pfnProgress, pProgressArg );
+        goto end;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Allocate buffer for two scanlines of distances as floats        */
 /*      (the current and last line).                                    */
@@ -592,3 +639,362 @@ ProcessProximityLine( GInt32 *panSrcScanline, int *panNearX, int *panNearY,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                          IsProximityTarget()                         */
+/************************************************************************/
+
+static inline bool IsProximityTarget( GInt32 nValue, int nTargetValues,
+                                      const int *panTargetValues )
+{
+    if( nTargetValues == 0 )
+        return nValue != 0;
+    for( int i = 0; i < nTargetValues; i++ )
+    {
+        if( nValue == panTargetValues[i] )
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        ProximityParallelFor()                        */
+/*                                                                      */
+/*      Run oFunc over [0, nCount) split in contiguous ranges, one per  */
+/*      worker thread.                                                  */
+/************************************************************************/
+
+namespace {
+struct ProximityJob
+{
+    const std::function<void(int, int)> *poFunc = nullptr;
+    int iStart = 0;
+    int iEnd = 0;
+};
+} // namespace
+
+static void ProximityJobFunc( void *pData )
+{
+    ProximityJob *psJob = static_cast<ProximityJob *>(pData);
+    (*psJob->poFunc)(psJob->iStart, psJob->iEnd);
+}
+
+static void ProximityParallelFor( CPLJobQueue *poJobQueue, int nThreads,
+                                  int nCount,
+                                  const std::function<void(int, int)> &oFunc )
+{
+    const int nJobs = std::min(nThreads, nCount);
+    if( poJobQueue == nullptr || nJobs <= 1 )
+    {
+        oFunc(0, nCount);
+        return;
+    }
+
+    std::vector<ProximityJob> asJobs(nJobs);
+    for( int i = 0; i < nJobs; i++ )
+    {
+        asJobs[i].poFunc = &oFunc;
+        asJobs[i].iStart = static_cast<int>(
+            static_cast<GIntBig>(nCount) * i / nJobs);
+        asJobs[i].iEnd = static_cast<int>(
+            static_cast<GIntBig>(nCount) * (i + 1) / nJobs);
+        if( !poJobQueue->SubmitJob(ProximityJobFunc, &asJobs[i]) )
+            ProximityJobFunc(&asJobs[i]);
+    }
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                       ProximityLowerEnvelope()                       */
+/*                                                                      */
+/*      Exact squared distance along a line, given for each pixel of    */
+/*      the line the number of lines to the nearest target in its       */
+/*      column (-1 if none), following Felzenszwalb & Huttenlocher,     */
+/*      "Distance Transforms of Sampled Functions".                     */
+/************************************************************************/
+
+static void ProximityLowerEnvelope( const GInt32 *panColDist, int nXSize,
+                                    int *panVertex, double *padfBound,
+                                    double *padfDistSq )
+{
+    int k = -1;
+    for( int q = 0; q < nXSize; q++ )
+    {
+        if( panColDist[q] < 0 )
+            continue;
+        const double dfFQ = static_cast<double>(panColDist[q]) *
+                            panColDist[q] + static_cast<double>(q) * q;
+        if( k < 0 )
+        {
+            k = 0;
+            panVertex[0] = q;
+            padfBound[0] = -std::numeric_limits<double>::infinity();
+            padfBound[1] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+
+        double dfS = 0.0;
+        while( true )
+        {
+            const int v = panVertex[k];
+            const double dfFV = static_cast<double>(panColDist[v]) *
+                                panColDist[v] + static_cast<double>(v) * v;
+            dfS = (dfFQ - dfFV) / (2.0 * (q - v));
+            // padfBound[0] is -infinity, so k never goes below 0.
+            if( dfS <= padfBound[k] )
+                k--;
+            else
+                break;
+        }
+        k++;
+        panVertex[k] = q;
+        padfBound[k] = dfS;
+        padfBound[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    if( k < 0 )
+    {
+        for( int x = 0; x < nXSize; x++ )
+            padfDistSq[x] = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    k = 0;
+    for( int x = 0; x < nXSize; x++ )
+    {
+        while( padfBound[k + 1] < x )
+            k++;
+        const int v = panVertex[k];
+        const double dfDX = static_cast<double>(x - v);
+        padfDistSq[x] = dfDX * dfDX +
+                        static_cast<double>(panColDist[v]) * panColDist[v];
+    }
+}
+
+/************************************************************************/
+/*                      GDALComputeProximityEDT()                       */
+/*                                                                      */
+/*      Exact Euclidean distance transform.  The top to bottom pass     */
+/*      stores in hWorkProximityBand the number of lines to the         */
+/*      nearest target above (or at) each pixel.  The bottom to top     */
+/*      pass combines it with the distance to the nearest target        */
+/*      below, and computes the exact distance along each line.         */
+/************************************************************************/
+
+static CPLErr
+GDALComputeProximityEDT( GDALRasterBandH hSrcBand,
+                         GDALRasterBandH hWorkProximityBand,
+                         GDALRasterBandH hProximityBand,
+                         int nThreads, double dfMaxDist, double dfDistMult,
+                         const double *pdfSrcNoDataValue, float fNoDataValue,
+                         bool bFixedBufVal, double dfFixedBufVal,
+                         int nTargetValues, const int *panTargetValues,
+                         GDALProgressFunc pfnProgress, void *pProgressArg )
+
+{
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+
+/* -------------------------------------------------------------------- */
+/*      Process blocks of lines small enough to keep the source         */
+/*      values, the column distances and the output values of a block   */
+/*      within about 64 MB.                                             */
+/* -------------------------------------------------------------------- */
+    const GIntBig nLineBytes =
+        static_cast<GIntBig>(nXSize) * (2 * sizeof(GInt32) + sizeof(float));
+    const int nBlockLines = static_cast<int>(
+        std::max(static_cast<GIntBig>(1),
+                 std::min(static_cast<GIntBig>(std::min(nYSize, 256)),
+                          static_cast<GIntBig>(64 * 1024 * 1024) /
+                              nLineBytes)));
+
+    std::vector<GInt32> anSrc;
+    std::vector<GInt32> anColDist;
+    std::vector<float> afProximity;
+    std::vector<GInt32> anCarry;
+    try
+    {
+        anSrc.resize(static_cast<size_t>(nXSize) * nBlockLines);
+        anColDist.resize(static_cast<size_t>(nXSize) * nBlockLines);
+        afProximity.resize(static_cast<size_t>(nXSize) * nBlockLines);
+        anCarry.resize(nXSize, -1);
+    }
+    catch( const std::bad_alloc & )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate proximity working buffers" );
+        return CE_Failure;
+    }
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poThreadPool )
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    GInt32 *panSrc = anSrc.data();
+    GInt32 *panColDist = anColDist.data();
+    GInt32 *panCarry = anCarry.data();
+    float *pafProximity = afProximity.data();
+    CPLErr eErr = CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Top to bottom: lines to the nearest target above, each worker   */
+/*      handling a range of columns of the block.                       */
+/* -------------------------------------------------------------------- */
+    for( int iY0 = 0; eErr == CE_None && iY0 < nYSize; iY0 += nBlockLines )
+    {
+        const int nLines = std::min(nBlockLines, nYSize - iY0);
+        eErr = GDALRasterIO( hSrcBand, GF_Read, 0, iY0, nXSize, nLines,
+                             panSrc, nXSize, nLines, GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        ProximityParallelFor( poJobQueue.get(), nThreads, nXSize,
+            [=](int iXStart, int iXEnd)
+            {
+                for( int iX = iXStart; iX < iXEnd; iX++ )
+                {
+                    GInt32 nDist = panCarry[iX];
+                    for( int iLine = 0; iLine < nLines; iLine++ )
+                    {
+                        const size_t i =
+                            static_cast<size_t>(iLine) * nXSize + iX;
+                        if( IsProximityTarget(panSrc[i], nTargetValues,
+                                              panTargetValues) )
+                            nDist = 0;
+                        else if( nDist >= 0 )
+                            nDist++;
+                        panColDist[i] = nDist;
+                    }
+                    panCarry[iX] = nDist;
+                }
+            } );
+
+        eErr = GDALRasterIO( hWorkProximityBand, GF_Write, 0, iY0,
+                             nXSize, nLines, panColDist, nXSize, nLines,
+                             GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        if( !pfnProgress( 0.5 * (iY0 + nLines) / static_cast<double>(nYSize),
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Bottom to top: nearest target below, then exact distance        */
+/*      along each line, each worker handling a range of lines.         */
+/* -------------------------------------------------------------------- */
+    std::fill(anCarry.begin(), anCarry.end(), -1);
+    const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+
+    for( int iY1 = nYSize; eErr == CE_None && iY1 > 0; iY1 -= nBlockLines )
+    {
+        const int iY0 = std::max(0, iY1 - nBlockLines);
+        const int nLines = iY1 - iY0;
+        eErr = GDALRasterIO( hSrcBand, GF_Read, 0, iY0, nXSize, nLines,
+                             panSrc, nXSize, nLines, GDT_Int32, 0, 0 );
+        if( eErr == CE_None )
+            eErr = GDALRasterIO( hWorkProximityBand, GF_Read, 0, iY0,
+                                 nXSize, nLines, panColDist, nXSize, nLines,
+                                 GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        ProximityParallelFor( poJobQueue.get(), nThreads, nXSize,
+            [=](int iXStart, int iXEnd)
+            {
+                for( int iX = iXStart; iX < iXEnd; iX++ )
+                {
+                    GInt32 nDist = panCarry[iX];
+                    for( int iLine = nLines - 1; iLine >= 0; iLine-- )
+                    {
+                        const size_t i =
+                            static_cast<size_t>(iLine) * nXSize + iX;
+                        if( IsProximityTarget(panSrc[i], nTargetValues,
+                                              panTargetValues) )
+                            nDist = 0;
+                        else if( nDist >= 0 )
+                            nDist++;
+                        if( nDist >= 0 &&
+                            (panColDist[i] < 0 || nDist < panColDist[i]) )
+                            panColDist[i] = nDist;
+                    }
+                    panCarry[iX] = nDist;
+                }
+            } );
+
+        std::atomic<bool> bOutOfMemory(false);
+        ProximityParallelFor( poJobQueue.get(), nThreads, nLines,
+            [&](int iLineStart, int iLineEnd)
+            {
+                std::vector<int> anVertex;
+                std::vector<double> adfBound;
+                std::vector<double> adfDistSq;
+                try
+                {
+                    anVertex.resize(nXSize);
+                    adfBound.resize(static_cast<size_t>(nXSize) + 1);
+                    adfDistSq.resize(nXSize);
+                }
+                catch( const std::bad_alloc & )
+                {
+                    bOutOfMemory = true;
+                    return;
+                }
+
+                for( int iLine = iLineStart; iLine < iLineEnd; iLine++ )
+                {
+                    const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+                    ProximityLowerEnvelope( panColDist + nOffset, nXSize,
+                                            anVertex.data(), adfBound.data(),
+                                            adfDistSq.data() );
+                    for( int iX = 0; iX < nXSize; iX++ )
+                    {
+                        const GInt32 nSrc = panSrc[nOffset + iX];
+                        float &fProx = pafProximity[nOffset + iX];
+                        if( IsProximityTarget(nSrc, nTargetValues,
+                                              panTargetValues) )
+                            fProx = 0.0f;
+                        else if( (pdfSrcNoDataValue != nullptr &&
+                                  nSrc == *pdfSrcNoDataValue) ||
+                                 !(adfDistSq[iX] <= dfMaxDistSq) )
+                            fProx = fNoDataValue;
+                        else if( bFixedBufVal )
+                            fProx = static_cast<float>(dfFixedBufVal);
+                        else
+                            fProx = static_cast<float>(
+                                static_cast<float>(sqrt(adfDistSq[iX])) *
+                                dfDistMult);
+                    }
+                }
+            } );
+        if( bOutOfMemory )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Cannot allocate proximity working buffers" );
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = GDALRasterIO( hProximityBand, GF_Write, 0, iY0,
+                             nXSize, nLines, pafProximity, nXSize, nLines,
+                             GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        if( !pfnProgress( 0.5 + 0.5 * (nYSize - iY0) /
+                                    static_cast<double>(nYSize),
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
@@ -32,12 +32,17 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
-#include <vector>
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -46,6 +51,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -363,20 +369,37 @@ static void GDALCollectRingsFromGeometry(
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                         GDALRasterizeShape                           */
+/*                                                                      */
+/*      A geometry (or a part of it) collected into rings and           */
+/*      transformed to pixel/line coordinates, ready to be burnt.       */
+/************************************************************************/
+
+namespace {
+struct GDALRasterizeShape
+{
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int> aPartSize{};
+};
+} // namespace
+
+/************************************************************************/
+/*                       gv_prepare_one_shape()                         */
+/*                                                                      */
+/*      Collect the rings of a geometry and transform them to           */
+/*      pixel/line coordinates. In replace mode, the parts of a         */
+/*      collection are prepared as separate shapes.                     */
 /************************************************************************/
 static void
-gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
-                        int nXSize, int nYSize,
-                        int nBands, GDALDataType eType,
-                        int nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
-                        int bAllTouched,
-                        const OGRGeometry *poShape,
-                        const double *padfBurnValue,
-                        GDALBurnValueSrc eBurnValueSrc,
-                        GDALRasterMergeAlg eMergeAlg,
-                        GDALTransformerFunc pfnTransformer,
-                        void *pTransformArg )
+gv_prepare_one_shape( const OGRGeometry *poShape,
+                      GDALBurnValueSrc eBurnValueSrc,
+                      GDALRasterMergeAlg eMergeAlg,
+                      GDALTransformerFunc pfnTransformer,
+                      void *pTransformArg,
+                      std::vector<GDALRasterizeShape>& aoShapes )
 
 {
     if( poShape == nullptr || poShape->IsEmpty() )
@@ -393,21 +416,64 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
         const auto poGC = poShape->toGeometryCollection();
         for( const auto poPart: *poGC )
         {
-            gv_rasterize_one_shape(pabyChunkBuf, nXOff, nYOff,
-                                   nXSize, nYSize,
-                                   nBands, eType,
-                                   nPixelSpace, nLineSpace, nBandSpace,
-                                   bAllTouched,
-                                   poPart,
-                                   padfBurnValue,
-                                   eBurnValueSrc,
-                                   eMergeAlg,
-                                   pfnTransformer,
-                                   pTransformArg);
+            gv_prepare_one_shape(poPart,
+                                 eBurnValueSrc,
+                                 eMergeAlg,
+                                 pfnTransformer,
+                                 pTransformArg,
+                                 aoShapes);
         }
         return;
     }
 
+    aoShapes.emplace_back();
+    GDALRasterizeShape& oShape = aoShapes.back();
+    oShape.eGeomType = eGeomType;
+
+/* -------------------------------------------------------------------- */
+/*      Transform polygon geometries into a set of rings and a part     */
+/*      size list.                                                      */
+/* -------------------------------------------------------------------- */
+    GDALCollectRingsFromGeometry( poShape, oShape.aPointX, oShape.aPointY,
+                                  oShape.aPointVariant,
+                                  oShape.aPartSize, eBurnValueSrc );
+
+/* -------------------------------------------------------------------- */
+/*      Transform points if needed.                                     */
+/* -------------------------------------------------------------------- */
+    if( pfnTransformer != nullptr )
+    {
+        int *panSuccess =
+            static_cast<int *>(CPLCalloc(sizeof(int), oShape.aPointX.size()));
+
+        // TODO: We need to add all appropriate error checking at some point.
+        pfnTransformer( pTransformArg, FALSE,
+                        static_cast<int>(oShape.aPointX.size()),
+                        oShape.aPointX.data(), oShape.aPointY.data(),
+                        nullptr, panSuccess );
+        CPLFree( panSuccess );
+    }
+}
+
+/************************************************************************/
+/*                      gv_rasterize_prepared_shape()                   */
+/*                                                                      */
+/*      Burn a shape returned by gv_prepare_one_shape(). The point      */
+/*      arrays of the shape are modified in place.                      */
+/************************************************************************/
+static void
+gv_rasterize_prepared_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
+                             int nXSize, int nYSize,
+                             int nBands, GDALDataType eType,
+                             int nPixelSpace, GSpacing nLineSpace,
+                             GSpacing nBandSpace,
+                             int bAllTouched,
+                             GDALRasterizeShape& oShape,
+                             const double *padfBurnValue,
+                             GDALBurnValueSrc eBurnValueSrc,
+                             GDALRasterMergeAlg eMergeAlg )
+
+{
     if(nPixelSpace == 0)
     {
         nPixelSpace = GDALGetDataTypeSizeBytes(eType);
@@ -434,31 +500,10 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     sInfo.eBurnValueSource = eBurnValueSrc;
     sInfo.eMergeAlg = eMergeAlg;
 
-/* -------------------------------------------------------------------- */
-/*      Transform polygon geometries into a set of rings and a part     */
-/*      size list.                                                      */
-/* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry( poShape, aPointX, aPointY, aPointVariant,
-                                  aPartSize, eBurnValueSrc );
-
-/* -------------------------------------------------------------------- */
-/*      Transform points if needed.                                     */
-/* -------------------------------------------------------------------- */
-    if( pfnTransformer != nullptr )
-    {
-        int *panSuccess =
-            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
-
-        // TODO: We need to add all appropriate error checking at some point.
-        pfnTransformer( pTransformArg, FALSE, static_cast<int>(aPointX.size()),
-                        aPointX.data(), aPointY.data(), nullptr, panSuccess );
-        CPLFree( panSuccess );
-    }
+    std::vector<double>& aPointX = oShape.aPointX;
+    std::vector<double>& aPointY = oShape.aPointY;
+    std::vector<double>& aPointVariant = oShape.aPointVariant;
+    const std::vector<int>& aPartSize = oShape.aPartSize;
 
 /* -------------------------------------------------------------------- */
 /*      Shift to account for the buffer offset of this buffer.          */
@@ -474,7 +519,7 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
 /*      stored in continuous memory block.                              */
 /* -------------------------------------------------------------------- */
 
-    switch( eGeomType )
+    switch( oShape.eGeomType )
     {
       case wkbPoint:
       case wkbMultiPoint:
@@ -557,6 +602,40 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     }
 }
 
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void
+gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
+                        int nXSize, int nYSize,
+                        int nBands, GDALDataType eType,
+                        int nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+                        int bAllTouched,
+                        const OGRGeometry *poShape,
+                        const double *padfBurnValue,
+                        GDALBurnValueSrc eBurnValueSrc,
+                        GDALRasterMergeAlg eMergeAlg,
+                        GDALTransformerFunc pfnTransformer,
+                        void *pTransformArg )
+
+{
+    std::vector<GDALRasterizeShape> aoShapes;
+    gv_prepare_one_shape( poShape, eBurnValueSrc, eMergeAlg,
+                          pfnTransformer, pTransformArg, aoShapes );
+    for( auto& oShape: aoShapes )
+    {
+        gv_rasterize_prepared_shape( pabyChunkBuf, nXOff, nYOff,
+                                     nXSize, nYSize,
+                                     nBands, eType,
+                                     nPixelSpace, nLineSpace, nBandSpace,
+                                     bAllTouched,
+                                     oShape,
+                                     padfBurnValue,
+                                     eBurnValueSrc,
+                                     eMergeAlg );
+    }
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -1111,6 +1190,437 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
     return eErr;
 }
 
+/************************************************************************/
+/*                GDALCreateLayerToDatasetTransformer()                 */
+/************************************************************************/
+
+static void *GDALCreateLayerToDatasetTransformer( GDALDatasetH hDS,
+                                                  OGRLayer *poLayer )
+{
+    GDALDataset *poDS = GDALDataset::FromHandle(hDS);
+    char *pszProjection = nullptr;
+
+    OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
+    if( !poSRS )
+    {
+        CPLError( CE_Warning, CPLE_AppDefined,
+                  "Failed to fetch spatial reference on layer %s "
+                  "to build transformer, assuming matching coordinate "
+                  "systems.",
+                  poLayer->GetLayerDefn()->GetName() );
+    }
+    else
+    {
+        poSRS->exportToWkt( &pszProjection );
+    }
+
+    char** papszTransformerOptions = nullptr;
+    if( pszProjection != nullptr )
+        papszTransformerOptions = CSLSetNameValue(
+                papszTransformerOptions, "SRC_SRS", pszProjection );
+    double adfGeoTransform[6] = {};
+    if( poDS->GetGeoTransform( adfGeoTransform ) != CE_None &&
+        poDS->GetGCPCount() == 0 &&
+        poDS->GetMetadata("RPC") == nullptr )
+    {
+        papszTransformerOptions = CSLSetNameValue(
+            papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
+    }
+
+    void *pTransformArg =
+        GDALCreateGenImgProjTransformer2( nullptr, hDS,
+                                          papszTransformerOptions );
+
+    CPLFree( pszProjection );
+    CSLDestroy( papszTransformerOptions );
+
+    return pTransformArg;
+}
+
+/************************************************************************/
+/*                      Binned rasterization                            */
+/************************************************************************/
+
+namespace {
+
+struct GDALRasterizeBinnedShape
+{
+    GDALRasterizeShape oShape{};
+    // Burn values of the layer, or nullptr to burn dfAttrValue in all bands.
+    const double *padfBurnValues = nullptr;
+    double dfAttrValue = 0.0;
+};
+
+struct GDALRasterizeBinnedContext
+{
+    GDALDataset *poDS = nullptr;
+    int nBandCount = 0;
+    int *panBandList = nullptr;
+    GDALDataType eType = GDT_Unknown;
+    int nScanlineBytes = 0;
+    int nYSize = 0;
+    int nYChunkSize = 0;
+    int bAllTouched = FALSE;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    std::vector<GDALRasterizeBinnedShape> aoShapes{};
+    // Indices in aoShapes of the shapes that may touch each chunk, in
+    // reading order.
+    std::vector<std::vector<size_t>> aanChunkShapes{};
+
+    // Protects poDS and the members below.
+    std::mutex oMutex{};
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                       GDALRasterizeBinShape()                        */
+/*                                                                      */
+/*      Register a prepared shape in the chunks whose lines it may      */
+/*      touch.                                                          */
+/************************************************************************/
+
+static void GDALRasterizeBinShape( GDALRasterizeBinnedContext &sCtxt,
+                                   GDALRasterizeBinnedShape &&oBinnedShape )
+{
+    const std::vector<double> &aPointY = oBinnedShape.oShape.aPointY;
+    if( aPointY.empty() )
+        return;
+
+    const int nYSize = sCtxt.nYSize;
+    const int nChunks = static_cast<int>(sCtxt.aanChunkShapes.size());
+    int iFirstChunk = 0;
+    int iLastChunk = nChunks - 1;
+
+    bool bFinite = true;
+    double dfMinY = std::numeric_limits<double>::max();
+    double dfMaxY = -std::numeric_limits<double>::max();
+    for( const double dfY: aPointY )
+    {
+        if( !std::isfinite(dfY) )
+        {
+            bFinite = false;
+            break;
+        }
+        dfMinY = std::min(dfMinY, dfY);
+        dfMaxY = std::max(dfMaxY, dfY);
+    }
+
+    // Non finite coordinates (failed transformations) are passed through to
+    // all chunks, as the regular code path does.
+    if( bFinite )
+    {
+        // One line of margin on each side for the rounding done by the
+        // line and polygon algorithms.
+        const double dfFirstLine = std::floor(dfMinY) - 1;
+        const double dfLastLine = std::floor(dfMaxY) + 1;
+        if( dfLastLine < 0 || dfFirstLine >= nYSize )
+            return;
+        iFirstChunk = static_cast<int>(std::max(0.0, dfFirstLine)) /
+                                                        sCtxt.nYChunkSize;
+        iLastChunk = static_cast<int>(std::min(static_cast<double>(nYSize - 1),
+                                               dfLastLine)) /
+                                                        sCtxt.nYChunkSize;
+    }
+
+    const size_t nIdx = sCtxt.aoShapes.size();
+    sCtxt.aoShapes.emplace_back(std::move(oBinnedShape));
+    for( int iChunk = iFirstChunk; iChunk <= iLastChunk; iChunk++ )
+        sCtxt.aanChunkShapes[iChunk].push_back(nIdx);
+}
+
+/************************************************************************/
+/*                      GDALRasterizeBinnedChunk()                      */
+/*                                                                      */
+/*      Read a chunk of lines, burn the shapes binned to it and write   */
+/*      it back. Dataset accesses are serialized.                       */
+/************************************************************************/
+
+static void GDALRasterizeBinnedChunk( GDALRasterizeBinnedContext &sCtxt,
+                                      int iChunk )
+{
+    GDALDataset *poDS = sCtxt.poDS;
+    const int nXSize = poDS->GetRasterXSize();
+    const int iY = iChunk * sCtxt.nYChunkSize;
+    const int nThisYChunkSize =
+        std::min(sCtxt.nYChunkSize, sCtxt.nYSize - iY);
+
+    CPLErr eErr = CE_None;
+    unsigned char *pabyChunkBuf = nullptr;
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+        if( sCtxt.bStop || sCtxt.eErr != CE_None )
+            eErr = CE_Failure;
+    }
+
+    if( eErr == CE_None )
+    {
+        pabyChunkBuf = static_cast<unsigned char *>(
+            VSI_MALLOC2_VERBOSE(nThisYChunkSize, sCtxt.nScanlineBytes));
+        if( pabyChunkBuf == nullptr )
+            eErr = CE_Failure;
+    }
+
+    if( eErr == CE_None )
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+        eErr = poDS->RasterIO( GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                               pabyChunkBuf, nXSize, nThisYChunkSize,
+                               sCtxt.eType, sCtxt.nBandCount,
+                               sCtxt.panBandList, 0, 0, 0, nullptr );
+    }
+
+    if( eErr == CE_None )
+    {
+        std::vector<double> adfAttrValues(sCtxt.nBandCount);
+        GDALRasterizeShape oShape;
+        for( const size_t nIdx: sCtxt.aanChunkShapes[iChunk] )
+        {
+            const GDALRasterizeBinnedShape &oBinnedShape =
+                                                    sCtxt.aoShapes[nIdx];
+            const double *padfBurnValues = oBinnedShape.padfBurnValues;
+            if( padfBurnValues == nullptr )
+            {
+                std::fill(adfAttrValues.begin(), adfAttrValues.end(),
+                          oBinnedShape.dfAttrValue);
+                padfBurnValues = adfAttrValues.data();
+            }
+
+            // The burning shifts the coordinates to the chunk in place.
+            oShape = oBinnedShape.oShape;
+            gv_rasterize_prepared_shape( pabyChunkBuf, 0, iY,
+                                         nXSize, nThisYChunkSize,
+                                         sCtxt.nBandCount, sCtxt.eType,
+                                         0, 0, 0, sCtxt.bAllTouched, oShape,
+                                         padfBurnValues,
+                                         sCtxt.eBurnValueSource,
+                                         sCtxt.eMergeAlg );
+        }
+
+        std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+        eErr = poDS->RasterIO( GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                               pabyChunkBuf, nXSize, nThisYChunkSize,
+                               sCtxt.eType, sCtxt.nBandCount,
+                               sCtxt.panBandList, 0, 0, 0, nullptr );
+    }
+
+    VSIFree( pabyChunkBuf );
+
+    if( eErr != CE_None )
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+        sCtxt.eErr = CE_Failure;
+    }
+}
+
+/************************************************************************/
+/*                      GDALRasterizeLayersBinned()                     */
+/*                                                                      */
+/*      Implementation of GDALRasterizeLayers() when NUM_THREADS is     */
+/*      set: geometries are read and transformed once, binned by        */
+/*      chunks of lines, and chunks are burnt by worker threads.        */
+/************************************************************************/
+
+static CPLErr GDALRasterizeLayersBinned( GDALDatasetH hDS,
+                                         int nBandCount, int *panBandList,
+                                         int nLayerCount, OGRLayerH *pahLayers,
+                                         GDALTransformerFunc pfnTransformer,
+                                         void *pTransformArg,
+                                         double *padfLayerBurnValues,
+                                         char **papszOptions,
+                                         int nThreads,
+                                         int bAllTouched,
+                                         GDALBurnValueSrc eBurnValueSource,
+                                         GDALRasterMergeAlg eMergeAlg,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressArg )
+{
+    GDALDataset *poDS = GDALDataset::FromHandle(hDS);
+    GDALRasterBand *poBand = poDS->GetRasterBand( panBandList[0] );
+    const int nYSize = poDS->GetRasterYSize();
+
+    GDALRasterizeBinnedContext sCtxt;
+    sCtxt.poDS = poDS;
+    sCtxt.nBandCount = nBandCount;
+    sCtxt.panBandList = panBandList;
+    sCtxt.eType = poBand->GetRasterDataType();
+    sCtxt.nScanlineBytes = nBandCount * poDS->GetRasterXSize() *
+                                    GDALGetDataTypeSizeBytes(sCtxt.eType);
+    sCtxt.nYSize = nYSize;
+    sCtxt.bAllTouched = bAllTouched;
+    sCtxt.eBurnValueSource = eBurnValueSource;
+    sCtxt.eMergeAlg = eMergeAlg;
+
+/* -------------------------------------------------------------------- */
+/*      Establish the chunk size. By default, the cache is shared       */
+/*      between the threads, and there are several chunks per thread    */
+/*      for load balancing, aligned on blocks when possible.            */
+/* -------------------------------------------------------------------- */
+    const char *pszYChunkSize =
+        CSLFetchNameValue( papszOptions, "CHUNKYSIZE" );
+    int nYChunkSize = 0;
+    if( !(pszYChunkSize && ((nYChunkSize = atoi(pszYChunkSize))) != 0) )
+    {
+        const GIntBig nYChunkSize64 = GDALGetCacheMax64() /
+                                      sCtxt.nScanlineBytes / nThreads;
+        const int nMaxChunkSize = nThreads > 1 ?
+                                  DIV_ROUND_UP(nYSize, 4 * nThreads) : nYSize;
+        nYChunkSize = static_cast<int>(
+            std::min(static_cast<GIntBig>(nMaxChunkSize), nYChunkSize64));
+
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        if( nBlockYSize > 0 && nYChunkSize > nBlockYSize )
+            nYChunkSize = (nYChunkSize / nBlockYSize) * nBlockYSize;
+    }
+
+    if( nYChunkSize < 1 )
+        nYChunkSize = 1;
+    if( nYChunkSize > nYSize )
+        nYChunkSize = nYSize;
+    sCtxt.nYChunkSize = nYChunkSize;
+
+    const int nChunks = DIV_ROUND_UP(nYSize, nYChunkSize);
+    CPLDebug( "GDAL",
+              "Rasterizer operating on %d swaths of %d scanlines "
+              "with %d thread(s).",
+              nChunks, nYChunkSize, nThreads );
+    sCtxt.aanChunkShapes.resize(nChunks);
+
+/* ==================================================================== */
+/*      Read the specified layers, transform and bin their geometries. */
+/* ==================================================================== */
+    const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
+
+    pfnProgress( 0.0, nullptr, pProgressArg );
+
+    std::vector<GDALRasterizeShape> aoShapes;
+    for( int iLayer = 0; iLayer < nLayerCount; iLayer++ )
+    {
+        OGRLayer *poLayer = reinterpret_cast<OGRLayer *>(pahLayers[iLayer]);
+
+        if( !poLayer )
+        {
+            CPLError( CE_Warning, CPLE_AppDefined,
+                      "Layer element number %d is NULL, skipping.", iLayer );
+            continue;
+        }
+
+        if( poLayer->GetFeatureCount(FALSE) == 0 )
+            continue;
+
+        int iBurnField = -1;
+        const double *padfBurnValues = nullptr;
+
+        if( pszBurnAttribute )
+        {
+            iBurnField =
+                poLayer->GetLayerDefn()->GetFieldIndex( pszBurnAttribute );
+            if( iBurnField == -1 )
+            {
+                CPLError( CE_Warning, CPLE_AppDefined,
+                          "Failed to find field %s on layer %s, skipping.",
+                          pszBurnAttribute,
+                          poLayer->GetLayerDefn()->GetName() );
+                continue;
+            }
+        }
+        else
+        {
+            padfBurnValues = padfLayerBurnValues + iLayer * nBandCount;
+        }
+
+        GDALTransformerFunc pfnLayerTransformer = pfnTransformer;
+        void *pLayerTransformArg = pTransformArg;
+        if( pfnLayerTransformer == nullptr )
+        {
+            pLayerTransformArg =
+                GDALCreateLayerToDatasetTransformer( hDS, poLayer );
+            if( pLayerTransformArg == nullptr )
+                return CE_Failure;
+            pfnLayerTransformer = GDALGenImgProjTransform;
+        }
+
+        poLayer->ResetReading();
+
+        OGRFeature *poFeat = nullptr;
+        while( (poFeat = poLayer->GetNextFeature()) != nullptr )
+        {
+            aoShapes.clear();
+            gv_prepare_one_shape( poFeat->GetGeometryRef(),
+                                  eBurnValueSource, eMergeAlg,
+                                  pfnLayerTransformer, pLayerTransformArg,
+                                  aoShapes );
+            const double dfAttrValue =
+                pszBurnAttribute ? poFeat->GetFieldAsDouble( iBurnField ) : 0;
+            delete poFeat;
+
+            for( auto &oShape: aoShapes )
+            {
+                GDALRasterizeBinnedShape oBinnedShape;
+                oBinnedShape.oShape = std::move(oShape);
+                oBinnedShape.padfBurnValues = padfBurnValues;
+                oBinnedShape.dfAttrValue = dfAttrValue;
+                GDALRasterizeBinShape( sCtxt, std::move(oBinnedShape) );
+            }
+        }
+
+        poLayer->ResetReading();
+
+        if( pfnLayerTransformer != pfnTransformer )
+            GDALDestroyTransformer( pLayerTransformArg );
+
+        if( !pfnProgress(0.5 * (iLayer + 1) / nLayerCount,
+                         "", pProgressArg) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            return CE_Failure;
+        }
+    }
+
+/* ==================================================================== */
+/*      Burn the chunks. Each chunk is processed by a single job, in    */
+/*      feature order, so the result does not depend on scheduling.     */
+/* ==================================================================== */
+    GDALStripJobRunner oRunner( nChunks, nThreads, nChunks,
+                                [&sCtxt](int iChunk)
+                                { GDALRasterizeBinnedChunk( sCtxt, iChunk ); } );
+
+    const auto Stop = [&sCtxt, &oRunner]()
+    {
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+            sCtxt.bStop = true;
+        }
+        oRunner.Stop();
+        return CE_Failure;
+    };
+
+    const auto HasFailed = [&sCtxt]()
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+        return sCtxt.eErr != CE_None;
+    };
+
+    for( int iChunk = 0; iChunk < nChunks; iChunk++ )
+    {
+        oRunner.Wait( iChunk );
+        if( HasFailed() )
+            return Stop();
+        if( !pfnProgress(0.5 + 0.5 * (iChunk + 1) / nChunks,
+                         "", pProgressArg) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            return Stop();
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1165,6 +1675,15 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.4) Number of worker threads, or ALL_CPUS.
+ * When set, the features of all layers are read and their geometries
+ * transformed only once, then kept in memory, binned by the chunks of lines
+ * they intersect. Chunks are burnt independently, in parallel when more than
+ * one thread is used. Within a chunk, features are burnt in the same order as
+ * without this option, so results are identical, including with MERGE_ALG=ADD
+ * and ALL_TOUCHED. In that mode, the default chunk size is derived from the
+ * cache size divided by the number of threads, with several chunks per
+ * thread.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1215,6 +1734,21 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
         return CE_Failure;
     }
 
+/* -------------------------------------------------------------------- */
+/*      NUM_THREADS selects the binned implementation.                  */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads( papszOptions, "NUM_THREADS", 0 );
+    if( nThreads > 0 )
+    {
+        return GDALRasterizeLayersBinned( hDS, nBandCount, panBandList,
+                                          nLayerCount, pahLayers,
+                                          pfnTransformer, pTransformArg,
+                                          padfLayerBurnValues, papszOptions,
+                                          nThreads, bAllTouched,
+                                          eBurnValueSource, eMergeAlg,
+                                          pfnProgress, pProgressArg );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Establish a chunksize to operate on.  The larger the chunk      */
 /*      size the less times we need to make a pass through all the      */
@@ -1329,43 +1863,12 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
 
         if( pfnTransformer == nullptr )
         {
-            char *pszProjection = nullptr;
             bNeedToFreeTransformer = true;
 
-            OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
-            if( !poSRS )
-            {
-                CPLError( CE_Warning, CPLE_AppDefined,
-                          "Failed to fetch spatial reference on layer %s "
-                          "to build transformer, assuming matching coordinate "
-                          "systems.",
-                          poLayer->GetLayerDefn()->GetName() );
-            }
-            else
-            {
-                poSRS->exportToWkt( &pszProjection );
-            }
-
-            char** papszTransformerOptions = nullptr;
-            if( pszProjection != nullptr )
-                papszTransformerOptions = CSLSetNameValue(
-                        papszTransformerOptions, "SRC_SRS", pszProjection );
-            double adfGeoTransform[6] = {};
-            if( poDS->GetGeoTransform( adfGeoTransform ) != CE_None &&
-                poDS->GetGCPCount() == 0 &&
-                poDS->GetMetadata("RPC") == nullptr )
-            {
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
-            }
-
             pTransformArg =
-                GDALCreateGenImgProjTransformer2( nullptr, hDS,
-                                                  papszTransformerOptions );
+                GDALCreateLayerToDatasetTransformer( hDS, poLayer );
             pfnTransformer = GDALGenImgProjTransform;
 
-            CPLFree( pszProjection );
-            CSLDestroy( papszTransformerOptions );
             if( pTransformArg == nullptr )
             {
                 CPLFree( pabyChunkBuf );
@@ -33,6 +33,10 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
 #include <set>
 #include <vector>
 #include <utility>
@@ -43,6 +47,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -146,6 +151,837 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                        ResolveBigNeighbours()                        */
+/*                                                                      */
+/*      If the biggest neighbour of a small polygon is still smaller    */
+/*      than the threshold, then try tracking to that polygons          */
+/*      biggest neighbour, and so forth. On return, anBigNeighbour is   */
+/*      -1 for polygons that must not be changed, and the id of the     */
+/*      polygon to merge into otherwise.                                */
+/*                                                                      */
+/*      The result does not depend on the order of polygon ids.         */
+/************************************************************************/
+
+static void ResolveBigNeighbours( const GInt32 *panPolyIdMap,
+                                  const GInt32 *panPolyValue,
+                                  const std::vector<int> &anPolySizes,
+                                  std::vector<int> &anBigNeighbour,
+                                  int nSizeThreshold )
+
+{
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for( int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++ )
+    {
+        if( panPolyIdMap[iPoly] != iPoly )
+            continue;
+
+        // Ignore nodata polygons.
+        if( panPolyValue[iPoly] == GP_NODATA_MARKER )
+            continue;
+
+        // Don't try to merge polygons larger than the threshold.
+        if( anPolySizes[iPoly] >= nSizeThreshold )
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if( anBigNeighbour[iPoly] == -1 )
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        // Walk through our neighbours until we find a polygon large enough.
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while( true )
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if( iFinalId < 0 )
+            {
+                break;
+            }
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if( anPolySizes[iFinalId] >= nSizeThreshold )
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if( oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end() )
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if( !bFoundBigEnoughPoly )
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        // Map the whole intermediate chain to it.
+        int iPolyCur = iPoly;
+        while( anBigNeighbour[iPolyCur] != iFinalId )
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug( "GDALSieveFilter",
+              "Small Polygons: %d, Isolated: %d, Unmergable: %d",
+              nSieveTargets, nIsolatedSmall, nFailedMerges );
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                           Tiled sieving                              */
+/*                                                                      */
+/*      The raster is split in strips of full lines, processed by       */
+/*      jobs of the global thread pool, each strip only reading (and    */
+/*      writing) its own lines:                                         */
+/*                                                                      */
+/*      1) The polygon fragments of each strip are enumerated, and      */
+/*         their sizes accumulated. Fragments are then merged across    */
+/*         seams with a union-find, comparing the last line of a strip  */
+/*         to the first line of the next one.                           */
+/*                                                                      */
+/*      2) Each strip enumerates its fragments again and finds the      */
+/*         biggest neighbour of each of them. Neighbour relationships   */
+/*         are visited in the same order as GDALSieveFilter() does,     */
+/*         and ties between neighbours of the same size are resolved    */
+/*         by that order, so that the same merges are done.             */
+/*                                                                      */
+/*      3) Each strip applies the merges to its lines.                  */
+/*                                                                      */
+/*      Memory use is proportional to the number of polygon            */
+/*      fragments, and to the width of the raster, but not to its      */
+/*      height.                                                         */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace {
+
+struct GSFTiledContext;
+
+// A candidate biggest neighbour of a polygon whose fragment is not in the
+// strip where the neighbour relationship is found.
+struct GSFNeighbourCandidate
+{
+    GInt32 nPolyId;
+    GInt32 nNeighbourId;
+    GIntBig nOrder;
+};
+
+struct GSFStrip
+{
+    GSFTiledContext *psCtxt = nullptr;
+    int iStrip = 0;
+    int nYOff = 0;
+    int nYSize = 0;
+
+    // First pass results, indexed by the ids assigned by the strip
+    // enumerator.  anLocalRoot maps them to their strip root, and
+    // anGlobalId, after seams have been merged, to their global id.
+    std::vector<GInt32> anLocalRoot{};
+    std::vector<GInt32> anGlobalId{};
+    std::vector<GInt32> anValue{};
+    std::vector<int> anSize{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<GInt32> anLastLineId{};
+
+    // Second pass results: biggest neighbour (global id) of the fragments
+    // of the strip, and order of the first relationship with it.
+    std::vector<GInt32> anBigNeighbour{};
+    std::vector<GIntBig> anBigNeighbourOrder{};
+    std::vector<GSFNeighbourCandidate> aoAboveCandidates{};
+
+    CPLErr eErr = CE_None;
+};
+
+struct GSFTiledContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hDstBand = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nStripHeight = 0;
+    int nConnectedness = 4;
+
+    std::vector<GSFStrip> aoStrips{};
+
+    // Indexed by global ids (only valid for roots).
+    std::vector<GInt32> anPolyIdMap{};
+    std::vector<GInt32> anPolyValue{};
+    std::vector<int> anPolySizes{};
+    std::vector<int> anBigNeighbour{};
+    std::vector<GIntBig> anBigNeighbourOrder{};
+
+    // Protects the bands and the members below.
+    std::mutex oMutex{};
+    bool bStop = false;
+};
+
+/************************************************************************/
+/*                         GSFTiledReadLine()                           */
+/*                                                                      */
+/*      Read a line, and the mask if there is one. If panRawLineVal     */
+/*      is not NULL, it receives the unmasked values.                   */
+/************************************************************************/
+
+static CPLErr GSFTiledReadLine( GSFTiledContext &sCtxt, int iY,
+                                GInt32 *panLineVal, GByte *pabyMaskLine,
+                                GInt32 *panRawLineVal = nullptr )
+{
+    std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+    if( sCtxt.bStop )
+        return CE_Failure;
+
+    CPLErr eErr = GDALRasterIO( sCtxt.hSrcBand, GF_Read, 0, iY,
+                                sCtxt.nXSize, 1,
+                                panLineVal, sCtxt.nXSize, 1,
+                                GDT_Int32, 0, 0 );
+    if( eErr == CE_None && panRawLineVal != nullptr )
+        memcpy( panRawLineVal, panLineVal, sizeof(GInt32) * sCtxt.nXSize );
+    if( eErr == CE_None && sCtxt.hMaskBand != nullptr )
+        eErr = GPMaskImageData( sCtxt.hMaskBand, pabyMaskLine, iY,
+                                sCtxt.nXSize, panLineVal );
+    return eErr;
+}
+
+/************************************************************************/
+/*                         GSFTiledFirstPass()                          */
+/*                                                                      */
+/*      Enumerate the polygon fragments of a strip, and accumulate      */
+/*      their sizes.                                                    */
+/************************************************************************/
+
+static void GSFTiledFirstPass( void *pData )
+{
+    GSFStrip *psStrip = static_cast<GSFStrip *>(pData);
+    GSFTiledContext &sCtxt = *(psStrip->psCtxt);
+    const int nXSize = sCtxt.nXSize;
+
+    CPLErr eErr = CE_None;
+    try
+    {
+        std::vector<GInt32> anLastLineVal(nXSize);
+        std::vector<GInt32> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(sCtxt.hMaskBand ? nXSize : 0);
+
+        GDALRasterPolygonEnumerator oEnum( sCtxt.nConnectedness );
+
+        const int iYStart = psStrip->nYOff;
+        const int iYEnd = psStrip->nYOff + psStrip->nYSize;
+        for( int iY = iYStart; eErr == CE_None && iY < iYEnd; iY++ )
+        {
+            eErr = GSFTiledReadLine( sCtxt, iY, anThisLineVal.data(),
+                                     abyMaskLine.data() );
+            if( eErr != CE_None )
+                break;
+
+            if( iY == iYStart )
+                oEnum.ProcessLine( nullptr, anThisLineVal.data(),
+                                   nullptr, anThisLineId.data(), nXSize );
+            else
+                oEnum.ProcessLine( anLastLineVal.data(), anThisLineVal.data(),
+                                   anLastLineId.data(), anThisLineId.data(),
+                                   nXSize );
+
+            psStrip->anSize.resize( oEnum.nNextPolygonId );
+            for( int iX = 0; iX < nXSize; iX++ )
+            {
+                const int iPoly = anThisLineId[iX];
+                if( iPoly >= 0 && psStrip->anSize[iPoly] < MY_MAX_INT )
+                    psStrip->anSize[iPoly] += 1;
+            }
+
+            if( iY == iYStart )
+                psStrip->anFirstLineId = anThisLineId;
+            if( iY == iYEnd - 1 )
+                psStrip->anLastLineId = anThisLineId;
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+
+        if( eErr == CE_None )
+        {
+            oEnum.CompleteMerges();
+
+            const int nIds = oEnum.nNextPolygonId;
+            psStrip->anLocalRoot.assign( oEnum.panPolyIdMap,
+                                         oEnum.panPolyIdMap + nIds );
+            psStrip->anValue.assign( oEnum.panPolyValue,
+                                     oEnum.panPolyValue + nIds );
+            for( int iId = 0; iId < nIds; iId++ )
+            {
+                const GInt32 nRoot = psStrip->anLocalRoot[iId];
+                if( nRoot != iId )
+                {
+                    const GIntBig nSize =
+                        static_cast<GIntBig>(psStrip->anSize[nRoot]) +
+                        psStrip->anSize[iId];
+                    psStrip->anSize[nRoot] =
+                        static_cast<int>(std::min<GIntBig>(nSize, MY_MAX_INT));
+                    psStrip->anSize[iId] = 0;
+                }
+            }
+            for( auto& nId: psStrip->anFirstLineId )
+            {
+                if( nId >= 0 )
+                    nId = psStrip->anLocalRoot[nId];
+            }
+            for( auto& nId: psStrip->anLastLineId )
+            {
+                if( nId >= 0 )
+                    nId = psStrip->anLocalRoot[nId];
+            }
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate polygon fragment map" );
+        eErr = CE_Failure;
+    }
+
+    psStrip->eErr = eErr;
+}
+
+/************************************************************************/
+/*                          GSFTiledFindRoot()                          */
+/************************************************************************/
+
+static GInt32 GSFTiledFindRoot( std::vector<GInt32> &anParent, GInt32 nId )
+{
+    while( anParent[nId] != nId )
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                         GSFTiledMergeSeams()                         */
+/*                                                                      */
+/*      Merge the fragments of polygons crossing strip seams, assign    */
+/*      global ids to the fragments of each strip, and compute the      */
+/*      polygon sizes.                                                  */
+/************************************************************************/
+
+static CPLErr GSFTiledMergeSeams( GSFTiledContext &sCtxt )
+{
+    auto& aoStrips = sCtxt.aoStrips;
+    const int nStrips = static_cast<int>(aoStrips.size());
+
+    std::vector<GInt32> anOffset(nStrips);
+    GIntBig nTotalIds = 0;
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        anOffset[iStrip] = static_cast<GInt32>(nTotalIds);
+        nTotalIds += aoStrips[iStrip].anLocalRoot.size();
+        if( nTotalIds > std::numeric_limits<GInt32>::max() )
+        {
+            CPLError( CE_Failure, CPLE_NotSupported,
+                      "Too many polygon fragments" );
+            return CE_Failure;
+        }
+    }
+
+    std::vector<GInt32>& anParent = sCtxt.anPolyIdMap;
+    std::vector<GIntBig> anSize;
+    try
+    {
+        anParent.resize( static_cast<size_t>(nTotalIds) );
+        sCtxt.anPolyValue.resize( static_cast<size_t>(nTotalIds) );
+        sCtxt.anPolySizes.resize( static_cast<size_t>(nTotalIds) );
+        sCtxt.anBigNeighbour.resize( static_cast<size_t>(nTotalIds), -1 );
+        sCtxt.anBigNeighbourOrder.resize( static_cast<size_t>(nTotalIds) );
+        anSize.resize( static_cast<size_t>(nTotalIds) );
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate polygon fragment map" );
+        return CE_Failure;
+    }
+
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        const auto& oStrip = aoStrips[iStrip];
+        for( size_t iId = 0; iId < oStrip.anLocalRoot.size(); iId++ )
+        {
+            anParent[anOffset[iStrip] + iId] =
+                anOffset[iStrip] + oStrip.anLocalRoot[iId];
+            sCtxt.anPolyValue[anOffset[iStrip] + iId] = oStrip.anValue[iId];
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Pixels of the last line of a strip and of the first line of     */
+/*      the next one are connected if they have the same value, and     */
+/*      are adjacent per the connectedness.                             */
+/* -------------------------------------------------------------------- */
+    const auto Union = [&anParent](GInt32 nId1, GInt32 nId2)
+    {
+        nId1 = GSFTiledFindRoot( anParent, nId1 );
+        nId2 = GSFTiledFindRoot( anParent, nId2 );
+        if( nId1 < nId2 )
+            anParent[nId2] = nId1;
+        else if( nId2 < nId1 )
+            anParent[nId1] = nId2;
+    };
+
+    for( int iStrip = 1; iStrip < nStrips; iStrip++ )
+    {
+        const auto& oAbove = aoStrips[iStrip - 1];
+        const auto& oBelow = aoStrips[iStrip];
+        for( int iX = 0; iX < sCtxt.nXSize; iX++ )
+        {
+            const GInt32 nBelow = oBelow.anFirstLineId[iX];
+            if( nBelow < 0 )
+                continue;
+            const int iXMin = sCtxt.nConnectedness == 8 ? std::max(0, iX - 1) : iX;
+            const int iXMax = sCtxt.nConnectedness == 8 ?
+                                std::min(sCtxt.nXSize - 1, iX + 1) : iX;
+            for( int iXAbove = iXMin; iXAbove <= iXMax; iXAbove++ )
+            {
+                const GInt32 nAbove = oAbove.anLastLineId[iXAbove];
+                if( nAbove >= 0 &&
+                    oAbove.anValue[nAbove] == oBelow.anValue[nBelow] )
+                {
+                    Union( anOffset[iStrip - 1] + nAbove,
+                           anOffset[iStrip] + nBelow );
+                }
+            }
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compute global ids and polygon sizes.                           */
+/* -------------------------------------------------------------------- */
+    for( GInt32 iId = 0; iId < static_cast<GInt32>(nTotalIds); iId++ )
+        anParent[iId] = GSFTiledFindRoot( anParent, iId );
+
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        auto& oStrip = aoStrips[iStrip];
+        const size_t nIds = oStrip.anLocalRoot.size();
+        oStrip.anGlobalId.resize( nIds );
+        for( size_t iId = 0; iId < nIds; iId++ )
+        {
+            const GInt32 nGlobalId = anParent[anOffset[iStrip] + iId];
+            oStrip.anGlobalId[iId] = nGlobalId;
+            anSize[nGlobalId] += oStrip.anSize[iId];
+        }
+        for( auto& nId: oStrip.anLastLineId )
+        {
+            if( nId >= 0 )
+                nId = oStrip.anGlobalId[nId];
+        }
+        oStrip.anFirstLineId.clear();
+        oStrip.anFirstLineId.shrink_to_fit();
+        oStrip.anSize.clear();
+        oStrip.anSize.shrink_to_fit();
+        oStrip.anValue.clear();
+        oStrip.anValue.shrink_to_fit();
+    }
+
+    for( size_t iId = 0; iId < anSize.size(); iId++ )
+        sCtxt.anPolySizes[iId] =
+            static_cast<int>(std::min<GIntBig>(anSize[iId], MY_MAX_INT));
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         GSFTiledSecondPass()                         */
+/*                                                                      */
+/*      Find the biggest neighbour of the polygon fragments of a        */
+/*      strip. This follows CompareNeighbour(), but also records the    */
+/*      order in which neighbour relationships are visited by           */
+/*      GDALSieveFilter(), so that ties can be resolved the same way    */
+/*      once the results of all strips are known.                       */
+/************************************************************************/
+
+static void GSFTiledSecondPass( void *pData )
+{
+    GSFStrip *psStrip = static_cast<GSFStrip *>(pData);
+    GSFTiledContext &sCtxt = *(psStrip->psCtxt);
+    const int nXSize = sCtxt.nXSize;
+    const std::vector<int>& anPolySizes = sCtxt.anPolySizes;
+
+    CPLErr eErr = CE_None;
+    try
+    {
+        std::vector<GInt32> anLastLineVal(nXSize);
+        std::vector<GInt32> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(sCtxt.hMaskBand ? nXSize : 0);
+
+        auto& anBigNeighbour = psStrip->anBigNeighbour;
+        auto& anBigNeighbourOrder = psStrip->anBigNeighbourOrder;
+        anBigNeighbour.assign( psStrip->anLocalRoot.size(), -1 );
+        anBigNeighbourOrder.assign( psStrip->anLocalRoot.size(), 0 );
+
+        // Global ids of the last line of the previous strip.
+        const GInt32 *panAboveId =
+            psStrip->iStrip > 0 ?
+                sCtxt.aoStrips[psStrip->iStrip - 1].anLastLineId.data() :
+                nullptr;
+
+        // Record nNeighbourId as a candidate for the fragment nLocalId.
+        const auto Compare = [&](GInt32 nLocalId, GInt32 nNeighbourId,
+                                 GIntBig nOrder)
+        {
+            const GInt32 nRoot = psStrip->anLocalRoot[nLocalId];
+            if( anBigNeighbour[nRoot] == -1
+                || anPolySizes[anBigNeighbour[nRoot]] <
+                                                anPolySizes[nNeighbourId] )
+            {
+                anBigNeighbour[nRoot] = nNeighbourId;
+                anBigNeighbourOrder[nRoot] = nOrder;
+            }
+        };
+
+        // Same as CompareNeighbour(), nId1 being a fragment of the strip,
+        // and nId2 a fragment of the strip if bLocal2, or the global id of a
+        // polygon of the previous strip otherwise.
+        const auto CompareNeighbours = [&](GInt32 nId1, GInt32 nId2,
+                                           bool bLocal2, GIntBig nOrder)
+        {
+            if( nId1 < 0 || nId2 < 0 )
+                return;
+            const GInt32 nGlobalId1 = psStrip->anGlobalId[nId1];
+            const GInt32 nGlobalId2 =
+                bLocal2 ? psStrip->anGlobalId[nId2] : nId2;
+            if( nGlobalId1 == nGlobalId2 )
+                return;
+            Compare( nId1, nGlobalId2, nOrder );
+            if( bLocal2 )
+                Compare( nId2, nGlobalId1, nOrder );
+            else
+                psStrip->aoAboveCandidates.push_back(
+                    GSFNeighbourCandidate{ nGlobalId2, nGlobalId1, nOrder } );
+        };
+
+        GDALRasterPolygonEnumerator oEnum( sCtxt.nConnectedness );
+
+        const int iYStart = psStrip->nYOff;
+        const int iYEnd = psStrip->nYOff + psStrip->nYSize;
+        for( int iY = iYStart; eErr == CE_None && iY < iYEnd; iY++ )
+        {
+            eErr = GSFTiledReadLine( sCtxt, iY, anThisLineVal.data(),
+                                     abyMaskLine.data() );
+            if( eErr != CE_None )
+                break;
+
+            if( iY == iYStart )
+                oEnum.ProcessLine( nullptr, anThisLineVal.data(),
+                                   nullptr, anThisLineId.data(), nXSize );
+            else
+                oEnum.ProcessLine( anLastLineVal.data(), anThisLineVal.data(),
+                                   anLastLineId.data(), anThisLineId.data(),
+                                   nXSize );
+
+            const bool bLocalAbove = iY > iYStart;
+            const GInt32 *panAbove =
+                bLocalAbove ? anLastLineId.data() : panAboveId;
+            for( int iX = 0; iX < nXSize; iX++ )
+            {
+                const GIntBig nOrder =
+                    (static_cast<GIntBig>(iY) * nXSize + iX) * 4;
+                if( panAbove != nullptr )
+                {
+                    CompareNeighbours( anThisLineId[iX], panAbove[iX],
+                                       bLocalAbove, nOrder );
+
+                    if( iX > 0 && sCtxt.nConnectedness == 8 )
+                        CompareNeighbours( anThisLineId[iX], panAbove[iX-1],
+                                           bLocalAbove, nOrder + 1 );
+
+                    if( iX < nXSize-1 && sCtxt.nConnectedness == 8 )
+                        CompareNeighbours( anThisLineId[iX], panAbove[iX+1],
+                                           bLocalAbove, nOrder + 2 );
+                }
+
+                if( iX > 0 )
+                    CompareNeighbours( anThisLineId[iX], anThisLineId[iX-1],
+                                       true, nOrder + 3 );
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate neighbour map" );
+        eErr = CE_Failure;
+    }
+
+    psStrip->eErr = eErr;
+}
+
+/************************************************************************/
+/*                      GSFTiledMergeNeighbours()                       */
+/*                                                                      */
+/*      Merge the biggest neighbours found in a strip into the global   */
+/*      ones. The biggest neighbour wins, and in case of ties, the      */
+/*      one visited first.                                              */
+/************************************************************************/
+
+static void GSFTiledMergeNeighbours( GSFTiledContext &sCtxt,
+                                     GSFStrip &oStrip )
+{
+    const auto Merge = [&sCtxt](GInt32 nPolyId, GInt32 nNeighbourId,
+                                GIntBig nOrder)
+    {
+        int& nBigNeighbour = sCtxt.anBigNeighbour[nPolyId];
+        GIntBig& nBigNeighbourOrder = sCtxt.anBigNeighbourOrder[nPolyId];
+        if( nBigNeighbour == -1 ||
+            sCtxt.anPolySizes[nBigNeighbour] <
+                                        sCtxt.anPolySizes[nNeighbourId] ||
+            (sCtxt.anPolySizes[nBigNeighbour] ==
+                                        sCtxt.anPolySizes[nNeighbourId] &&
+             nOrder < nBigNeighbourOrder) )
+        {
+            nBigNeighbour = nNeighbourId;
+            nBigNeighbourOrder = nOrder;
+        }
+    };
+
+    for( size_t iId = 0; iId < oStrip.anLocalRoot.size(); iId++ )
+    {
+        if( oStrip.anBigNeighbour[iId] >= 0 )
+            Merge( oStrip.anGlobalId[iId], oStrip.anBigNeighbour[iId],
+                   oStrip.anBigNeighbourOrder[iId] );
+    }
+    for( const auto& oCandidate: oStrip.aoAboveCandidates )
+        Merge( oCandidate.nPolyId, oCandidate.nNeighbourId,
+               oCandidate.nOrder );
+
+    oStrip.anBigNeighbour.clear();
+    oStrip.anBigNeighbour.shrink_to_fit();
+    oStrip.anBigNeighbourOrder.clear();
+    oStrip.anBigNeighbourOrder.shrink_to_fit();
+    oStrip.aoAboveCandidates.clear();
+    oStrip.aoAboveCandidates.shrink_to_fit();
+}
+
+/************************************************************************/
+/*                         GSFTiledThirdPass()                          */
+/*                                                                      */
+/*      Apply the merges to the lines of a strip.                       */
+/************************************************************************/
+
+static void GSFTiledThirdPass( void *pData )
+{
+    GSFStrip *psStrip = static_cast<GSFStrip *>(pData);
+    GSFTiledContext &sCtxt = *(psStrip->psCtxt);
+    const int nXSize = sCtxt.nXSize;
+
+    CPLErr eErr = CE_None;
+    try
+    {
+        std::vector<GInt32> anLastLineVal(nXSize);
+        std::vector<GInt32> anThisLineVal(nXSize);
+        std::vector<GInt32> anThisLineWriteVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(sCtxt.hMaskBand ? nXSize : 0);
+
+        GDALRasterPolygonEnumerator oEnum( sCtxt.nConnectedness );
+
+        const int iYStart = psStrip->nYOff;
+        const int iYEnd = psStrip->nYOff + psStrip->nYSize;
+        for( int iY = iYStart; eErr == CE_None && iY < iYEnd; iY++ )
+        {
+            eErr = GSFTiledReadLine( sCtxt, iY, anThisLineVal.data(),
+                                     abyMaskLine.data(),
+                                     anThisLineWriteVal.data() );
+            if( eErr != CE_None )
+                break;
+
+            if( iY == iYStart )
+                oEnum.ProcessLine( nullptr, anThisLineVal.data(),
+                                   nullptr, anThisLineId.data(), nXSize );
+            else
+                oEnum.ProcessLine( anLastLineVal.data(), anThisLineVal.data(),
+                                   anLastLineId.data(), anThisLineId.data(),
+                                   nXSize );
+
+            for( int iX = 0; iX < nXSize; iX++ )
+            {
+                if( anThisLineId[iX] >= 0 )
+                {
+                    const GInt32 nGlobalId =
+                        psStrip->anGlobalId[anThisLineId[iX]];
+                    const int nBigNeighbour =
+                        sCtxt.anBigNeighbour[nGlobalId];
+                    if( nBigNeighbour != -1 )
+                        anThisLineWriteVal[iX] =
+                            sCtxt.anPolyValue[nBigNeighbour];
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+                if( sCtxt.bStop )
+                    eErr = CE_Failure;
+                else
+                    eErr = GDALRasterIO( sCtxt.hDstBand, GF_Write, 0, iY,
+                                         nXSize, 1,
+                                         anThisLineWriteVal.data(), nXSize, 1,
+                                         GDT_Int32, 0, 0 );
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate working buffers" );
+        eErr = CE_Failure;
+    }
+
+    psStrip->eErr = eErr;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                        GDALSieveFilterTiled()                        */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterTiled( GDALRasterBandH hSrcBand,
+                                    GDALRasterBandH hMaskBand,
+                                    GDALRasterBandH hDstBand,
+                                    int nSizeThreshold, int nConnectedness,
+                                    int nThreads,
+                                    GDALProgressFunc pfnProgress,
+                                    void * pProgressArg )
+{
+    GSFTiledContext sCtxt;
+    sCtxt.hSrcBand = hSrcBand;
+    sCtxt.hMaskBand = hMaskBand;
+    sCtxt.hDstBand = hDstBand;
+    sCtxt.nXSize = GDALGetRasterBandXSize( hSrcBand );
+    sCtxt.nYSize = GDALGetRasterBandYSize( hSrcBand );
+    sCtxt.nConnectedness = nConnectedness;
+    if( sCtxt.nYSize == 0 )
+        return CE_None;
+
+    sCtxt.nStripHeight = GDALGetStripHeight( "GDAL_SIEVE_STRIP_HEIGHT",
+                                             sCtxt.nYSize, nThreads );
+
+    const int nStrips =
+        (sCtxt.nYSize + sCtxt.nStripHeight - 1) / sCtxt.nStripHeight;
+    CPLDebug( "GDALSieveFilter", "Sieving %d strips of %d lines with %d thread(s)",
+              nStrips, sCtxt.nStripHeight, nThreads );
+    sCtxt.aoStrips.resize(nStrips);
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        GSFStrip& oStrip = sCtxt.aoStrips[iStrip];
+        oStrip.psCtxt = &sCtxt;
+        oStrip.iStrip = iStrip;
+        oStrip.nYOff = iStrip * sCtxt.nStripHeight;
+        oStrip.nYSize = std::min(sCtxt.nStripHeight,
+                                 sCtxt.nYSize - oStrip.nYOff);
+    }
+
+    const auto Stop = [&sCtxt](GDALStripJobRunner& oRunner)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+            sCtxt.bStop = true;
+        }
+        oRunner.Stop();
+        return CE_Failure;
+    };
+
+    // Run a pass on all strips, calling pfnStripDone on each of them in
+    // order, with a limited number of strips in flight so that memory use
+    // stays bounded.
+    const auto RunPass = [&](CPLThreadFunc pfnFunc, double dfProgressStart,
+                             double dfProgressEnd,
+                             const std::function<void(GSFStrip&)>& pfnStripDone)
+    {
+        GDALStripJobRunner oRunner( nStrips, nThreads, 2 * nThreads,
+                                    [&sCtxt, pfnFunc](int iStrip)
+                                    { pfnFunc( &sCtxt.aoStrips[iStrip] ); } );
+        for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+        {
+            oRunner.Wait( iStrip );
+            if( sCtxt.aoStrips[iStrip].eErr != CE_None )
+                return Stop( oRunner );
+            if( pfnStripDone )
+                pfnStripDone( sCtxt.aoStrips[iStrip] );
+            if( !pfnProgress( dfProgressStart +
+                                (dfProgressEnd - dfProgressStart) *
+                                    (iStrip + 1) / nStrips,
+                              "", pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                return Stop( oRunner );
+            }
+        }
+        return CE_None;
+    };
+
+/* -------------------------------------------------------------------- */
+/*      First pass: enumerate the polygon fragments of each strip,      */
+/*      then merge them across seams.                                   */
+/* -------------------------------------------------------------------- */
+    if( RunPass( GSFTiledFirstPass, 0.0, 0.25, nullptr ) != CE_None )
+        return CE_Failure;
+
+    if( GSFTiledMergeSeams( sCtxt ) != CE_None )
+        return CE_Failure;
+
+/* -------------------------------------------------------------------- */
+/*      Second pass: identify the largest neighbour of each polygon.    */
+/* -------------------------------------------------------------------- */
+    if( RunPass( GSFTiledSecondPass, 0.25, 0.5,
+                 [&sCtxt](GSFStrip& oStrip)
+                 { GSFTiledMergeNeighbours( sCtxt, oStrip ); } ) != CE_None )
+        return CE_Failure;
+
+    ResolveBigNeighbours( sCtxt.anPolyIdMap.data(), sCtxt.anPolyValue.data(),
+                          sCtxt.anPolySizes, sCtxt.anBigNeighbour,
+                          nSizeThreshold );
+    sCtxt.anBigNeighbourOrder.clear();
+    sCtxt.anBigNeighbourOrder.shrink_to_fit();
+
+/* -------------------------------------------------------------------- */
+/*      Third pass: apply the merges.                                   */
+/* -------------------------------------------------------------------- */
+    return RunPass( GSFTiledThirdPass, 0.5, 1.0, nullptr );
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -187,8 +1023,15 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * <ul>
+ * <li>NUM_THREADS=value/ALL_CPUS: (GDAL >= 3.4) When set, the raster is
+ * processed in strips of lines by that number of worker threads. Polygons
+ * crossing strip boundaries are merged, and the same pixel values are
+ * produced as without this option. Besides the per-polygon information,
+ * memory use is then proportional to the raster width, but not to its
+ * height.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -200,7 +1043,7 @@ CPLErr CPL_STDCALL
 GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
                  GDALRasterBandH hDstBand,
                  int nSizeThreshold, int nConnectedness,
-                 CPL_UNUSED char **papszOptions,
+                 char **papszOptions,
                  GDALProgressFunc pfnProgress,
                  void * pProgressArg )
 {
@@ -210,6 +1053,17 @@ GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
 
+/* -------------------------------------------------------------------- */
+/*      NUM_THREADS selects the tiled implementation.                   */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads( papszOptions, "NUM_THREADS", 0 );
+    if( nThreads > 0 )
+    {
+        return GDALSieveFilterTiled( hSrcBand, hMaskBand, hDstBand,
+                                     nSizeThreshold, nConnectedness, nThreads,
+                                     pfnProgress, pProgressArg );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Allocate working buffers.                                       */
 /* -------------------------------------------------------------------- */
@@ -440,84 +1294,14 @@ GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
 /*      threshold, then try tracking to that polygons biggest           */
 /*      neighbour, and so forth.                                        */
 /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for( int iPoly = 0; oFirstEnum.panPolyIdMap != nullptr && // for Coverity
-                        oFirstEnum.panPolyValue != nullptr && // for Coverity
-                        iPoly < static_cast<int>(anPolySizes.size()); iPoly++ )
+    if( oFirstEnum.panPolyIdMap != nullptr && // for Coverity
+        oFirstEnum.panPolyValue != nullptr )  // for Coverity
     {
-        if( oFirstEnum.panPolyIdMap[iPoly] != iPoly )
-            continue;
-
-        // Ignore nodata polygons.
-        if( oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER )
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if( anPolySizes[iPoly] >= nSizeThreshold )
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if( anBigNeighbour[iPoly] == -1 )
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while( true )
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if( iFinalId < 0 )
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if( anPolySizes[iFinalId] >= nSizeThreshold )
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if( oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end() )
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if( !bFoundBigEnoughPoly )
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while( anBigNeighbour[iPolyCur] != iFinalId )
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
+        ResolveBigNeighbours( oFirstEnum.panPolyIdMap,
+                              oFirstEnum.panPolyValue,
+                              anPolySizes, anBigNeighbour, nSizeThreshold );
     }
 
-    CPLDebug( "GDALSieveFilter",
-              "Small Polygons: %d, Isolated: %d, Unmergable: %d",
-              nSieveTargets, nIsolatedSmall, nFailedMerges );
-
 /* ==================================================================== */
 /*      Make a third pass over the image, actually applying the         */
 /*      merges.  We reuse the second enumerator but preserve the        */
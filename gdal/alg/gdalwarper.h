@@ -117,6 +117,16 @@ GDALWarpCutlineMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
                        int nXOff, int nYOff, int nXSize, int nYSize,
                        GByte ** /* ppImageData */,
                        int bMaskIsFloat, void *pValidityMask );
+
+CPLErr CPL_DLL
+GDALWarpCutlineMaskerEx( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
+                         int nXOff, int nYOff, int nXSize, int nYSize,
+                         GByte ** /* ppImageData */,
+                         int bMaskIsFloat, void *pValidityMask,
+                         void *pCutlineCache );
+
+void CPL_DLL *GDALCreateWarpCutlineCache( void *hCutline );
+void CPL_DLL GDALDestroyWarpCutlineCache( void *pCutlineCache );
 /*! @endcond */
 
 /************************************************************************/
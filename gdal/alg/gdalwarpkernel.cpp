@@ -213,6 +213,9 @@ struct _GWKJobStruct
     CPLMutex       *hCondMutex;
     int           (*pfnProgress)(GWKJobStruct* psJob);
     void           *pTransformerArg;
+    // Thread that called GWKRun(), when it is itself a worker thread of the
+    // pool. -1 otherwise.
+    GIntBig         nCallerThreadId;
 
     void           (*pfnFunc)(void*); // used by GWKRun() to assign the proper pTransformerArg
 } ;
@@ -237,8 +240,21 @@ struct GWKThreadData
 static int GWKProgressThread( GWKJobStruct* psJob )
 {
     CPLAcquireMutex(psJob->hCondMutex, 1.0);
-    (*(psJob->pnCounter))++;
+    const int nCounter = ++(*(psJob->pnCounter));
     CPLCondSignal(psJob->hCond);
+    // When GWKRun() was called from a worker thread, it cannot wait for the
+    // above signal, so the lines it processes itself report the progress.
+    if( !*(psJob->pbStop) && psJob->nCallerThreadId == CPLGetPID() )
+    {
+        GDALWarpKernel *poWK = psJob->poWK;
+        if( !poWK->pfnProgress( poWK->dfProgressBase + poWK->dfProgressScale *
+                                (nCounter / static_cast<double>(poWK->nDstYSize)),
+                                "", poWK->pProgress ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            *(psJob->pbStop) = TRUE;
+        }
+    }
     int bStop = *(psJob->pbStop);
     CPLReleaseMutex(psJob->hCondMutex);
 
@@ -285,6 +301,7 @@ static CPLErr GWKGenericMonoThread( GDALWarpKernel *poWK,
     sThreadJob.hCondMutex = nullptr;
     sThreadJob.pfnProgress = GWKProgressMonoThread;
     sThreadJob.pTransformerArg = poWK->pTransformerArg;
+    sThreadJob.nCallerThreadId = -1;
 
     pfnFunc(&sThreadJob);
 
@@ -485,6 +502,9 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
     volatile int bStop = FALSE;
     volatile int nCounter = 0;
 
+    const bool bNested =
+        psThreadData->poJobQueue->GetPool()->IsCurrentThreadWorker();
+
     CPLAcquireMutex(psThreadData->hCondMutex, 1000);
 
 /* -------------------------------------------------------------------- */
@@ -504,6 +524,8 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
             psThreadData->pasThreadJob[i].pfnProgress = GWKProgressThread;
         else
             psThreadData->pasThreadJob[i].pfnProgress = nullptr;
+        psThreadData->pasThreadJob[i].nCallerThreadId =
+            bNested ? CPLGetPID() : -1;
         psThreadData->pasThreadJob[i].pfnFunc = pfnFunc;
         psThreadData->poJobQueue->SubmitJob( ThreadFuncAdapter,
                             static_cast<void*>(&psThreadData->pasThreadJob[i]) );
@@ -511,8 +533,38 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
 
 /* -------------------------------------------------------------------- */
 /*      Report progress.                                                */
+/*                                                                      */
+/*      When warping from a job of the thread pool (for example a VRT   */
+/*      warped dataset read by a multi-threaded overview computation),  */
+/*      do not block waiting for progress notifications, but help       */
+/*      running the jobs in WaitCompletion(): otherwise all the worker  */
+/*      threads could end up waiting for jobs that none can run.        */
+/*      Progress is then reported by the lines this thread processes    */
+/*      (see GWKProgressThread()), and each time a job completes.       */
 /* -------------------------------------------------------------------- */
-    if( poWK->pfnProgress != GDALDummyProgress )
+    if( bNested )
+    {
+        CPLReleaseMutex(psThreadData->hCondMutex);
+        for( int nRemainingJobs = nThreads - 1;
+             nRemainingJobs >= 0 && !bStop; --nRemainingJobs )
+        {
+            psThreadData->poJobQueue->WaitCompletion(nRemainingJobs);
+            if( poWK->pfnProgress == GDALDummyProgress )
+                continue;
+            CPLAcquireMutex(psThreadData->hCondMutex, 1000);
+            if( !bStop && !poWK->pfnProgress(
+                    poWK->dfProgressBase + poWK->dfProgressScale *
+                    (nCounter / static_cast<double>(nDstYSize)),
+                    "", poWK->pProgress ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                bStop = TRUE;
+            }
+            CPLReleaseMutex(psThreadData->hCondMutex);
+        }
+        CPLAcquireMutex(psThreadData->hCondMutex, 1000);
+    }
+    else if( poWK->pfnProgress != GDALDummyProgress )
     {
         while( nCounter < nDstYSize )
         {
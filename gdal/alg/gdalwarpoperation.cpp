@@ -68,6 +68,13 @@ struct GDALWarpPrivateData
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+    // Cutline edges in source pixel/line coordinates, shared by all chunks.
+    void* pCutlineCache = nullptr;
+
+    GDALWarpPrivateData() = default;
+    ~GDALWarpPrivateData() { GDALDestroyWarpCutlineCache(pCutlineCache); }
+    GDALWarpPrivateData(const GDALWarpPrivateData&) = delete;
+    GDALWarpPrivateData& operator=(const GDALWarpPrivateData&) = delete;
 };
 
 static std::mutex gMutex{};
@@ -637,6 +644,17 @@ CPLErr GDALWarpOperation::Initialize( const GDALWarpOptions *psNewOptions )
             eErr = CE_Failure;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Index the cutline edges once for all the chunks.                */
+/* -------------------------------------------------------------------- */
+    if( eErr == CE_None && psOptions->hCutline != nullptr )
+    {
+        GDALWarpPrivateData* psPrivate = GetWarpPrivateData(this);
+        GDALDestroyWarpCutlineCache(psPrivate->pCutlineCache);
+        psPrivate->pCutlineCache =
+            GDALCreateWarpCutlineCache(psOptions->hCutline);
+    }
+
     return eErr;
 }
 
@@ -1964,13 +1982,14 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
         if( eErr == CE_None )
             eErr =
-                GDALWarpCutlineMasker( psOptions,
-                                       psOptions->nBandCount,
-                                       psOptions->eWorkingDataType,
-                                       oWK.nSrcXOff, oWK.nSrcYOff,
-                                       oWK.nSrcXSize, oWK.nSrcYSize,
-                                       oWK.papabySrcImage,
-                                       TRUE, oWK.pafUnifiedSrcDensity );
+                GDALWarpCutlineMaskerEx( psOptions,
+                                         psOptions->nBandCount,
+                                         psOptions->eWorkingDataType,
+                                         oWK.nSrcXOff, oWK.nSrcYOff,
+                                         oWK.nSrcXSize, oWK.nSrcYSize,
+                                         oWK.papabySrcImage,
+                                         TRUE, oWK.pafUnifiedSrcDensity,
+                                         GetWarpPrivateData(this)->pCutlineCache );
     }
 
 /* -------------------------------------------------------------------- */
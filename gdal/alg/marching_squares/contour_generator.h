@@ -71,6 +71,17 @@ public:
         }
         return CE_None;
     }
+    // Make the next fed line be the line of index lineIdx, the line before it
+    // being previousLine (nullptr if lineIdx is 0).
+    // This allows independent generators to process strips of lines.
+    void setStartLine( size_t lineIdx, const double* previousLine )
+    {
+        lineIdx_ = lineIdx;
+        if ( previousLine != nullptr )
+            std::copy( previousLine, previousLine + width_, previousLine_.begin() );
+        else
+            std::fill( previousLine_.begin(), previousLine_.end(), NaN );
+    }
 private:
     size_t width_;
     size_t height_;
@@ -69,6 +69,15 @@ isLeft(const Point& p0, const Point& p1, const Point& p2 )
             - (p2.x -  p0.x) * (p1.y - p0.y) ) > 0;
 }
 
+// Test if p2 is on the segment [p0, p1]
+inline bool
+isOnSegment(const Point& p0, const Point& p1, const Point& p2 )
+{
+    return (p1.x - p0.x) * (p2.y - p0.y) == (p2.x - p0.x) * (p1.y - p0.y)
+        && std::min(p0.x, p1.x) <= p2.x && p2.x <= std::max(p0.x, p1.x)
+        && std::min(p0.y, p1.y) <= p2.y && p2.y <= std::max(p0.y, p1.y);
+}
+
 // LineString type
 typedef std::list<Point> LineString;
 
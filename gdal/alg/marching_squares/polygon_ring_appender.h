@@ -60,8 +60,23 @@ private:
 
         bool isIn( const Ring& other ) const
         {
-            // Check if this is inside other using the winding number algorithm
-            auto checkPoint = this->points.front();
+            // Rings may touch each other (along nodata borders), so use
+            // a point that is not on the other ring to decide. The result
+            // then does not depend on the starting point of the rings.
+            for ( const auto& checkPoint : this->points )
+            {
+                bool onBoundary = false;
+                const bool in = isIn( other, checkPoint, onBoundary );
+                if ( !onBoundary )
+                    return in;
+            }
+            bool onBoundary = false;
+            return isIn( other, this->points.front(), onBoundary );
+        }
+
+        static bool isIn( const Ring& other, const Point& checkPoint, bool& onBoundary )
+        {
+            // Check if checkPoint is inside other using the winding number algorithm
             int windingNum = 0;
             auto otherIter = other.points.begin();
             // p1 and p2 define each segment of the ring other that will be tested
@@ -72,6 +87,10 @@ private:
                     break;
                 }
                 auto p2 = *otherIter;
+                if ( isOnSegment(p1, p2, checkPoint) ) {
+                    onBoundary = true;
+                    return false;
+                }
                 if ( p1.y <= checkPoint.y ) {
                     if ( p2.y  > checkPoint.y ) {
                         if ( isLeft(p1, p2, checkPoint) )  {
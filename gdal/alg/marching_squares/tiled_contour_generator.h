@@ -0,0 +1,435 @@
+/******************************************************************************
+ *
+ * Project:  Marching squares
+ * Purpose:  Multi-threaded contour generation by strips of lines
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+#ifndef MARCHING_SQUARES_TILED_CONTOUR_GENERATOR_H
+#define MARCHING_SQUARES_TILED_CONTOUR_GENERATOR_H
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpl_error.h"
+#include "gdal.h"
+#include "gdal_thread_pool.h"
+
+#include "utility.h"
+#include "point.h"
+#include "contour_generator.h"
+#include "segment_merger.h"
+
+namespace marching_squares
+{
+
+// A line emitted by a SegmentMerger
+struct LevelLine
+{
+    double level;
+    LineString ls;
+    bool closed;
+};
+
+// Line writer that stores the lines of a strip of squares.
+// Non closed lines with an end on one of the seams of the strip are kept apart,
+// since they may continue in the neighbouring strip.
+class StripLineCollector
+{
+public:
+    // Seams are lines of pixel centers. NaN means there is no seam.
+    StripLineCollector( double topSeam, double bottomSeam )
+        : topSeam_( topSeam )
+        , bottomSeam_( bottomSeam )
+    {}
+
+    void addLine( double level, LineString& ls, bool closed )
+    {
+        std::vector<LevelLine>& lines = !closed && ( onSeam_( ls.front() ) || onSeam_( ls.back() ) ) ? pending : complete;
+        lines.push_back( LevelLine{ level, LineString(), closed } );
+        lines.back().ls.swap( ls );
+    }
+
+    std::vector<LevelLine> complete = {};
+    std::vector<LevelLine> pending = {};
+
+private:
+    double topSeam_;
+    double bottomSeam_;
+
+    bool onSeam_( const Point& p ) const
+    {
+        return p.y == topSeam_ || p.y == bottomSeam_;
+    }
+};
+
+// SeamMerger: join lines of consecutive strips that meet on the seam between
+// them, and write the resulting lines (or rings, when polygonizing) as soon as
+// they cannot be extended any more.
+//
+// Strips are added in order. When strip i is added, the lines of the previous
+// strips that are still open all have an end on the seam between strips i-1
+// and i. An end of a line of strip i on that seam is paired with the end of an
+// open line of the same level, at the same position on the seam, coming from
+// the other side of the seam. Both strips compute that position from the same
+// pixel values in the same order (see Square::interpolate_()), so it is equal.
+// Only the lines that have an end on the seam below strip i are then kept, so
+// the memory used is bounded by the lines crossing one seam.
+template <typename LineWriter>
+class SeamMerger
+{
+public:
+    SeamMerger( LineWriter& lineWriter, bool polygonize )
+        : lineWriter_( lineWriter )
+        , polygonize_( polygonize )
+    {}
+
+    // Add the lines of the next strip, whose top seam is topSeam and bottom
+    // seam is bottomSeam (NaN if there is no seam).
+    void addStrip( std::vector<LevelLine>& lines, double topSeam, double bottomSeam )
+    {
+        for ( auto& line : lines )
+        {
+            open_.emplace_back();
+            const ChainIter chain = std::prev( open_.end() );
+            chain->level = line.level;
+            chain->ls.swap( line.ls );
+            connect_( chain, topSeam, true );
+            connect_( chain, topSeam, false );
+        }
+
+        // The ends that have not been paired cannot be extended any more.
+        ends_.clear();
+
+        // Write the lines that cannot be extended to the next strip, and
+        // index the others by their ends on the bottom seam.
+        auto it = open_.begin();
+        while ( it != open_.end() )
+        {
+            const bool closed = it->ls.front() == it->ls.back();
+            const bool atFront = !closed && it->ls.front().y == bottomSeam;
+            const bool atBack = !closed && it->ls.back().y == bottomSeam;
+            if ( atFront || atBack )
+            {
+                if ( atFront )
+                    ends_[key_( it->level, it->ls.front() )] = it;
+                if ( atBack )
+                    ends_[key_( it->level, it->ls.back() )] = it;
+                ++it;
+            }
+            else
+            {
+                write_( *it );
+                it = open_.erase( it );
+            }
+        }
+    }
+
+    // Write the remaining lines.
+    void flush()
+    {
+        for ( auto& chain : open_ )
+            write_( chain );
+        open_.clear();
+        ends_.clear();
+    }
+
+    // non copyable
+    SeamMerger( const SeamMerger<LineWriter>& ) = delete;
+    SeamMerger<LineWriter>& operator=( const SeamMerger<LineWriter>& ) = delete;
+
+private:
+    struct Chain
+    {
+        double level = 0.0;
+        LineString ls = {};
+    };
+
+    typedef typename std::list<Chain>::iterator ChainIter;
+
+    // (level, x) of an end on the current seam
+    typedef std::pair<double, double> EndKey;
+
+    LineWriter& lineWriter_;
+    const bool polygonize_;
+    // lines that may still be extended
+    std::list<Chain> open_ = {};
+    // ends on the current seam of the lines of the previous strips
+    std::map<EndKey, ChainIter> ends_ = {};
+
+    static EndKey key_( double level, const Point& p )
+    {
+        return EndKey( level, p.x );
+    }
+
+    // Extend a line of the current strip, at its front or back, with the
+    // line of the previous strips that ends at the same point of the seam.
+    void connect_( ChainIter chain, double seam, bool atFront )
+    {
+        const Point p = atFront ? chain->ls.front() : chain->ls.back();
+        if ( p.y != seam )
+            return;
+        const auto it = ends_.find( key_( chain->level, p ) );
+        if ( it == ends_.end() )
+            return;
+        const ChainIter other = it->second;
+        ends_.erase( it );
+        if ( other == chain )
+        {
+            // Both ends of the line were paired with the two ends of the same
+            // line of the previous strips: the line is now closed.
+            return;
+        }
+
+        LineString& ls = other->ls;
+        if ( atFront )
+        {
+            if ( !( ls.back() == p ) )
+                ls.reverse();
+            ls.pop_back();
+            chain->ls.splice( chain->ls.begin(), ls );
+        }
+        else
+        {
+            if ( !( ls.front() == p ) )
+                ls.reverse();
+            ls.pop_front();
+            chain->ls.splice( chain->ls.end(), ls );
+        }
+
+        // The other end of the absorbed line, if on the seam, is now an end
+        // of the extended line.
+        const Point otherEnd = atFront ? chain->ls.front() : chain->ls.back();
+        const auto itOther = ends_.find( key_( chain->level, otherEnd ) );
+        if ( itOther != ends_.end() && itOther->second == other )
+            itOther->second = chain;
+        open_.erase( other );
+    }
+
+    void write_( Chain& chain )
+    {
+        const bool closed = chain.ls.front() == chain.ls.back();
+        if ( polygonize_ && !closed )
+            debug("remaining unclosed contour");
+        lineWriter_.addLine( chain.level, chain.ls, polygonize_ && closed );
+    }
+};
+
+// Contour generation by strips of lines, processed by independent
+// ContourGenerator instances on worker threads.
+// Lines crossing the seams between strips are merged once the strips on both
+// sides of the seam are done, the other ones are written strip after strip.
+// The lines written are the same as the ones of a ContourGeneratorFromRaster,
+// but they may be written in a different order, and start at a different point.
+template <typename LineWriter, typename LevelGenerator>
+class TiledContourGeneratorFromRaster
+{
+public:
+    TiledContourGeneratorFromRaster( const GDALRasterBandH band,
+                                     bool hasNoData, double noDataValue,
+                                     LineWriter& writer, LevelGenerator& levelGenerator,
+                                     bool polygonize, int numThreads )
+        : band_( band )
+        , width_( GDALGetRasterBandXSize( band ) )
+        , height_( GDALGetRasterBandYSize( band ) )
+        , hasNoData_( hasNoData )
+        , noDataValue_( noDataValue )
+        , writer_( writer )
+        , levelGenerator_( levelGenerator )
+        , polygonize_( polygonize )
+        , numThreads_( std::max( 1, numThreads ) )
+        , stripHeight_( GDALGetStripHeight( "GDAL_CONTOUR_STRIP_HEIGHT", height_, numThreads_ ) )
+    {
+    }
+
+    bool process( GDALProgressFunc progressFunc = nullptr, void* progressData = nullptr )
+    {
+        const int numStrips = ( height_ + stripHeight_ - 1 ) / stripHeight_;
+        CPLDebug( "CONTOUR", "Processing %d strips of %d lines with %d thread(s)",
+                  numStrips, stripHeight_, numThreads_ );
+        strips_.resize( numStrips );
+        for ( int i = 0; i < numStrips; i++ )
+        {
+            strips_[i].yOff = i * stripHeight_;
+            strips_[i].ySize = std::min( stripHeight_, height_ - strips_[i].yOff );
+        }
+
+        // Strips are consumed in order, and a limited number of them are in
+        // flight, so that memory use stays bounded.
+        GDALStripJobRunner runner( numStrips, numThreads_, 2 * numThreads_,
+                                   [this]( int i ) { processStrip_( strips_[i] ); } );
+
+        const auto stop = [this, &runner]()
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                stop_ = true;
+            }
+            runner.Stop();
+            return false;
+        };
+
+        SeamMerger<LineWriter> seamMerger( writer_, polygonize_ );
+        for ( int i = 0; i < numStrips; i++ )
+        {
+            runner.Wait( i );
+            Strip& strip = strips_[i];
+            if ( !strip.error.empty() )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, "%s", strip.error.c_str() );
+                return stop();
+            }
+            if ( !strip.ok )
+                return stop();
+
+            for ( auto& line : strip.complete )
+                writer_.addLine( line.level, line.ls, line.closed );
+            // Lines crossing the seam with the previous strip are written
+            // once both strips are done.
+            seamMerger.addStrip( strip.pending, topSeam_( strip ), bottomSeam_( strip ) );
+            strip.complete.clear();
+            strip.pending.clear();
+
+            if ( progressFunc && progressFunc( double( strip.yOff + strip.ySize ) / height_, "Processing line", progressData ) == FALSE )
+                return stop();
+        }
+        seamMerger.flush();
+
+        if ( progressFunc)
+            progressFunc( 1.0, "", progressData );
+        return true;
+    }
+
+private:
+    struct Strip
+    {
+        int yOff = 0;
+        int ySize = 0;
+        bool ok = true;
+        std::string error = {};
+        std::vector<LevelLine> complete = {};
+        std::vector<LevelLine> pending = {};
+    };
+
+    const GDALRasterBandH band_;
+    int width_;
+    int height_;
+    bool hasNoData_;
+    double noDataValue_;
+    LineWriter& writer_;
+    LevelGenerator& levelGenerator_;
+    bool polygonize_;
+    int numThreads_;
+    int stripHeight_;
+
+    std::vector<Strip> strips_ = {};
+    // protects stop_
+    std::mutex mutex_ = {};
+    // serializes raster reads
+    std::mutex ioMutex_ = {};
+    bool stop_ = false;
+
+    // Seams are the lines of pixel centers shared with the previous and next strips
+    double topSeam_( const Strip& strip ) const
+    {
+        return strip.yOff > 0 ? strip.yOff - .5 : NaN;
+    }
+
+    double bottomSeam_( const Strip& strip ) const
+    {
+        return strip.yOff + strip.ySize < height_ ? strip.yOff + strip.ySize - .5 : NaN;
+    }
+
+    bool readLine_( int lineIdx, double* line )
+    {
+        std::lock_guard<std::mutex> lock( ioMutex_ );
+        CPLErr error = GDALRasterIO( band_, GF_Read, 0, lineIdx, width_,
+                                     1, line, width_, 1, GDT_Float64, 0, 0 );
+        if ( error != CE_None )
+        {
+            CPLDebug( "CONTOUR", "failed fetch %d %d", lineIdx, width_ );
+            return false;
+        }
+        return true;
+    }
+
+    bool runStrip_( Strip& strip, StripLineCollector& collector )
+    {
+        std::vector<double> previousLine;
+        std::vector<double> line( width_ );
+        if ( strip.yOff > 0 )
+        {
+            previousLine.resize( width_ );
+            if ( !readLine_( strip.yOff - 1, &previousLine[0] ) )
+                return false;
+        }
+
+        SegmentMerger<StripLineCollector, LevelGenerator> merger( collector, levelGenerator_, polygonize_ );
+        ContourGenerator<decltype(merger), LevelGenerator> cg( width_, height_, hasNoData_, noDataValue_, merger, levelGenerator_ );
+        cg.setStartLine( strip.yOff, previousLine.empty() ? nullptr : &previousLine[0] );
+        for ( int lineIdx = strip.yOff; lineIdx < strip.yOff + strip.ySize; lineIdx++ )
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                if ( stop_ )
+                    return false;
+            }
+            if ( !readLine_( lineIdx, &line[0] ) )
+                return false;
+            cg.feedLine( &line[0] );
+        }
+        return true;
+    }
+
+    void processStrip_( Strip& strip )
+    {
+        StripLineCollector collector( topSeam_( strip ), bottomSeam_( strip ) );
+        bool ok = false;
+        std::string error;
+        try
+        {
+            ok = runStrip_( strip, collector );
+        }
+        catch ( const std::exception& e )
+        {
+            error = e.what();
+        }
+
+        strip.complete = std::move( collector.complete );
+        strip.pending = std::move( collector.pending );
+        strip.ok = ok;
+        strip.error = error;
+    }
+
+    TiledContourGeneratorFromRaster( const TiledContourGeneratorFromRaster& ) = delete;
+    TiledContourGeneratorFromRaster& operator=( const TiledContourGeneratorFromRaster& ) = delete;
+};
+
+}
+
+#endif
@@ -35,8 +35,11 @@
 #include <string.h>
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <utility>
 #include <vector>
 
@@ -44,11 +47,13 @@
 #include "gdal.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
+#include "ogr_geometry.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -414,12 +419,11 @@ static void AddEdges( GInt32 *panThisLineId, GInt32 *panLastLineId,
 }
 
 /************************************************************************/
-/*                         EmitPolygonToLayer()                         */
+/*                         RPolygonToGeometry()                         */
 /************************************************************************/
 
-static CPLErr
-EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
-                    RPolygon *poRPoly, double *padfGeoTransform )
+static OGRGeometryH RPolygonToGeometry( RPolygon *poRPoly,
+                                        const double *padfGeoTransform )
 
 {
 /* -------------------------------------------------------------------- */
@@ -461,6 +465,18 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
         OGR_G_AddGeometryDirectly( hPolygon, hRing );
     }
 
+    return hPolygon;
+}
+
+/************************************************************************/
+/*                        EmitGeometryToLayer()                         */
+/************************************************************************/
+
+static CPLErr
+EmitGeometryToLayer( OGRLayerH hOutLayer, int iPixValField,
+                     OGRGeometryH hPolygon, double dfPolyValue )
+
+{
 /* -------------------------------------------------------------------- */
 /*      Create the feature object.                                      */
 /* -------------------------------------------------------------------- */
@@ -469,7 +485,7 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
     OGR_F_SetGeometryDirectly( hFeat, hPolygon );
 
     if( iPixValField >= 0 )
-        OGR_F_SetFieldDouble( hFeat, iPixValField, poRPoly->dfPolyValue );
+        OGR_F_SetFieldDouble( hFeat, iPixValField, dfPolyValue );
 
 /* -------------------------------------------------------------------- */
 /*      Write the to the layer.                                         */
@@ -484,6 +500,21 @@ EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
     return eErr;
 }
 
+/************************************************************************/
+/*                         EmitPolygonToLayer()                         */
+/************************************************************************/
+
+static CPLErr
+EmitPolygonToLayer( OGRLayerH hOutLayer, int iPixValField,
+                    RPolygon *poRPoly, const double *padfGeoTransform )
+
+{
+    return EmitGeometryToLayer( hOutLayer, iPixValField,
+                                RPolygonToGeometry( poRPoly,
+                                                    padfGeoTransform ),
+                                poRPoly->dfPolyValue );
+}
+
 /************************************************************************/
 /*                          GPMaskImageData()                           */
 /*                                                                      */
@@ -513,6 +544,618 @@ GPMaskImageData( GDALRasterBandH hMaskBand, GByte* pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                        Tiled polygonization                          */
+/*                                                                      */
+/*      The raster is split in strips of full lines. A first pass,      */
+/*      run independently on each strip, enumerates the polygon         */
+/*      fragments of the strip, also enumerating the last line of the   */
+/*      previous strip so that the connections across the seam are      */
+/*      evaluated with the same rules as GDALRasterPolygonEnumerator.   */
+/*      Fragments are then merged across seams with a union-find, and   */
+/*      a second pass collects the polygon edges of each strip with     */
+/*      the merged ids. Polygons that are completed within a strip are  */
+/*      turned into geometries by the worker; the other ones are        */
+/*      assembled from their strip parts as strips are written out.     */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace {
+
+template<class DataType> struct GPTiledContext;
+
+template<class DataType>
+struct GPStrip
+{
+    CPL_DISALLOW_COPY_ASSIGN(GPStrip)
+
+    GPTiledContext<DataType> *psCtxt = nullptr;
+    int iStrip = 0;
+    int nYOff = 0;
+    int nYSize = 0;
+
+    // First pass results. anLocalId is indexed by the ids assigned by the
+    // strip enumerator, and first maps them to their strip root, then,
+    // after seams have been merged, to their global id.
+    std::vector<GInt32> anLocalId{};
+    std::vector<DataType> anValue{};
+    std::vector<int> anMinLine{};
+    std::vector<int> anMaxLine{};
+    std::vector<GInt32> anFirstLineId{};  // Last line of previous strip.
+    std::vector<GInt32> anLastLineId{};
+
+    // Second pass results.
+    std::vector<std::pair<double, OGRGeometryUniquePtr>> aoGeoms{};
+    std::vector<std::pair<GInt32, std::unique_ptr<RPolygon>>> aoParts{};
+
+    CPLErr eErr = CE_None;
+
+    GPStrip() = default;
+    GPStrip(GPStrip&&) = default;
+    GPStrip& operator=(GPStrip&&) = default;
+};
+
+template<class DataType>
+struct GPTiledContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALDataType eDT = GDT_Unknown;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nStripHeight = 0;
+    int nConnectedness = 4;
+    const double *padfGeoTransform = nullptr;
+
+    std::vector<GPStrip<DataType>> aoStrips{};
+
+    // Strips of the first and last lines touched by each polygon (valid
+    // for global root ids only).
+    std::vector<int> anFirstStrip{};
+    std::vector<int> anLastStrip{};
+
+    // Protects the source bands and the members below.
+    std::mutex oMutex{};
+    bool bStop = false;
+};
+
+/************************************************************************/
+/*                          GPTiledReadLine()                           */
+/************************************************************************/
+
+template<class DataType>
+static CPLErr GPTiledReadLine( GPTiledContext<DataType> &sCtxt, int iY,
+                               DataType *panLineVal, GByte *pabyMaskLine )
+{
+    std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+    if( sCtxt.bStop )
+        return CE_Failure;
+
+    CPLErr eErr = GDALRasterIO( sCtxt.hSrcBand, GF_Read, 0, iY,
+                                sCtxt.nXSize, 1,
+                                panLineVal, sCtxt.nXSize, 1,
+                                sCtxt.eDT, 0, 0 );
+    if( eErr == CE_None && sCtxt.hMaskBand != nullptr )
+        eErr = GPMaskImageData( sCtxt.hMaskBand, pabyMaskLine, iY,
+                                sCtxt.nXSize, panLineVal );
+    return eErr;
+}
+
+/************************************************************************/
+/*                         GPTiledFirstPass()                           */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static void GPTiledFirstPass( void *pData )
+{
+    GPStrip<DataType> *psStrip = static_cast<GPStrip<DataType> *>(pData);
+    GPTiledContext<DataType> &sCtxt = *(psStrip->psCtxt);
+    const int nXSize = sCtxt.nXSize;
+
+    std::vector<DataType> anLastLineVal(nXSize);
+    std::vector<DataType> anThisLineVal(nXSize);
+    std::vector<GInt32> anLastLineId(nXSize);
+    std::vector<GInt32> anThisLineId(nXSize);
+    std::vector<GByte> abyMaskLine(sCtxt.hMaskBand ? nXSize : 0);
+
+    GDALRasterPolygonEnumeratorT<DataType,
+                                 EqualityTest> oEnum(sCtxt.nConnectedness);
+
+    const int iYStart = psStrip->nYOff > 0 ? psStrip->nYOff - 1 : 0;
+    const int iYEnd = psStrip->nYOff + psStrip->nYSize;
+    CPLErr eErr = CE_None;
+    for( int iY = iYStart; eErr == CE_None && iY < iYEnd; iY++ )
+    {
+        eErr = GPTiledReadLine( sCtxt, iY, anThisLineVal.data(),
+                                abyMaskLine.data() );
+        if( eErr != CE_None )
+            break;
+
+        if( iY == iYStart )
+            oEnum.ProcessLine( nullptr, anThisLineVal.data(),
+                               nullptr, anThisLineId.data(), nXSize );
+        else
+            oEnum.ProcessLine( anLastLineVal.data(), anThisLineVal.data(),
+                               anLastLineId.data(), anThisLineId.data(),
+                               nXSize );
+
+        // Ids created by this line start on it.
+        psStrip->anMinLine.resize( oEnum.nNextPolygonId, iY );
+        psStrip->anMaxLine.resize( oEnum.nNextPolygonId, iY );
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            if( anThisLineId[iX] >= 0 )
+                psStrip->anMaxLine[anThisLineId[iX]] = iY;
+        }
+
+        if( iY == iYStart && psStrip->nYOff > 0 )
+            psStrip->anFirstLineId = anThisLineId;
+        if( iY == iYEnd - 1 )
+            psStrip->anLastLineId = anThisLineId;
+
+        std::swap(anLastLineVal, anThisLineVal);
+        std::swap(anLastLineId, anThisLineId);
+    }
+
+    if( eErr == CE_None )
+    {
+        oEnum.CompleteMerges();
+
+        const int nIds = oEnum.nNextPolygonId;
+        psStrip->anLocalId.assign( oEnum.panPolyIdMap,
+                                   oEnum.panPolyIdMap + nIds );
+        psStrip->anValue.assign( oEnum.panPolyValue,
+                                 oEnum.panPolyValue + nIds );
+        for( int iId = 0; iId < nIds; iId++ )
+        {
+            const GInt32 nRoot = psStrip->anLocalId[iId];
+            psStrip->anMinLine[nRoot] = std::min(psStrip->anMinLine[nRoot],
+                                                 psStrip->anMinLine[iId]);
+            psStrip->anMaxLine[nRoot] = std::max(psStrip->anMaxLine[nRoot],
+                                                 psStrip->anMaxLine[iId]);
+        }
+        for( auto& nId: psStrip->anFirstLineId )
+        {
+            if( nId >= 0 )
+                nId = psStrip->anLocalId[nId];
+        }
+        for( auto& nId: psStrip->anLastLineId )
+        {
+            if( nId >= 0 )
+                nId = psStrip->anLocalId[nId];
+        }
+    }
+
+    psStrip->eErr = eErr;
+}
+
+/************************************************************************/
+/*                         GPTiledFindRoot()                            */
+/************************************************************************/
+
+static GInt32 GPTiledFindRoot( std::vector<GInt32> &anParent, GInt32 nId )
+{
+    while( anParent[nId] != nId )
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                         GPTiledMergeSeams()                          */
+/*                                                                      */
+/*      Merge the fragments of polygons crossing strip seams, and       */
+/*      remap the first pass ids of each strip to global ids.           */
+/************************************************************************/
+
+template<class DataType>
+static CPLErr GPTiledMergeSeams( GPTiledContext<DataType> &sCtxt )
+{
+    auto& aoStrips = sCtxt.aoStrips;
+    const int nStrips = static_cast<int>(aoStrips.size());
+
+    std::vector<GInt32> anOffset(nStrips);
+    GIntBig nTotalIds = 0;
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        anOffset[iStrip] = static_cast<GInt32>(nTotalIds);
+        nTotalIds += aoStrips[iStrip].anLocalId.size();
+        if( nTotalIds > std::numeric_limits<GInt32>::max() )
+        {
+            CPLError( CE_Failure, CPLE_NotSupported,
+                      "Too many polygon fragments" );
+            return CE_Failure;
+        }
+    }
+
+    std::vector<GInt32> anParent;
+    try
+    {
+        anParent.resize( static_cast<size_t>(nTotalIds) );
+        sCtxt.anFirstStrip.resize( static_cast<size_t>(nTotalIds) );
+        sCtxt.anLastStrip.resize( static_cast<size_t>(nTotalIds) );
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate polygon fragment map" );
+        return CE_Failure;
+    }
+
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        const auto& anLocalId = aoStrips[iStrip].anLocalId;
+        for( size_t iId = 0; iId < anLocalId.size(); iId++ )
+            anParent[anOffset[iStrip] + iId] = anOffset[iStrip] + anLocalId[iId];
+    }
+
+    for( int iStrip = 1; iStrip < nStrips; iStrip++ )
+    {
+        const auto& anAbove = aoStrips[iStrip - 1].anLastLineId;
+        const auto& anBelow = aoStrips[iStrip].anFirstLineId;
+        for( int iX = 0; iX < sCtxt.nXSize; iX++ )
+        {
+            if( anAbove[iX] < 0 || anBelow[iX] < 0 )
+                continue;
+            const GInt32 nRootAbove =
+                GPTiledFindRoot( anParent, anOffset[iStrip - 1] + anAbove[iX] );
+            const GInt32 nRootBelow =
+                GPTiledFindRoot( anParent, anOffset[iStrip] + anBelow[iX] );
+            if( nRootAbove < nRootBelow )
+                anParent[nRootBelow] = nRootAbove;
+            else if( nRootBelow < nRootAbove )
+                anParent[nRootAbove] = nRootBelow;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compute the range of lines of each polygon, and hence the       */
+/*      strips where its edges are collected.                           */
+/* -------------------------------------------------------------------- */
+    std::fill( sCtxt.anFirstStrip.begin(), sCtxt.anFirstStrip.end(),
+               std::numeric_limits<int>::max() );
+    std::fill( sCtxt.anLastStrip.begin(), sCtxt.anLastStrip.end(), -1 );
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        GPStrip<DataType>& oStrip = aoStrips[iStrip];
+        for( size_t iId = 0; iId < oStrip.anLocalId.size(); iId++ )
+        {
+            const GInt32 nGlobalId =
+                GPTiledFindRoot( anParent, anOffset[iStrip] +
+                                           oStrip.anLocalId[iId] );
+            if( oStrip.anLocalId[iId] == static_cast<GInt32>(iId) )
+            {
+                // The bottom edge of a polygon is collected by the strip of
+                // the line below it.
+                const int nFirstLine = oStrip.anMinLine[iId];
+                const int nLastLine = std::min(oStrip.anMaxLine[iId] + 1,
+                                               sCtxt.nYSize - 1);
+                sCtxt.anFirstStrip[nGlobalId] =
+                    std::min( sCtxt.anFirstStrip[nGlobalId],
+                              nFirstLine / sCtxt.nStripHeight );
+                sCtxt.anLastStrip[nGlobalId] =
+                    std::max( sCtxt.anLastStrip[nGlobalId],
+                              nLastLine / sCtxt.nStripHeight );
+            }
+            oStrip.anLocalId[iId] = nGlobalId;
+        }
+
+        oStrip.anMinLine.clear();
+        oStrip.anMinLine.shrink_to_fit();
+        oStrip.anMaxLine.clear();
+        oStrip.anMaxLine.shrink_to_fit();
+        oStrip.anFirstLineId.clear();
+        oStrip.anFirstLineId.shrink_to_fit();
+    }
+    for( auto& oStrip: aoStrips )
+    {
+        oStrip.anLastLineId.clear();
+        oStrip.anLastLineId.shrink_to_fit();
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         GPTiledSecondPass()                          */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static void GPTiledSecondPass( void *pData )
+{
+    GPStrip<DataType> *psStrip = static_cast<GPStrip<DataType> *>(pData);
+    GPTiledContext<DataType> &sCtxt = *(psStrip->psCtxt);
+    const int nXSize = sCtxt.nXSize;
+    const int nIds = static_cast<int>(psStrip->anLocalId.size());
+
+/* -------------------------------------------------------------------- */
+/*      Map the ids of the strip enumerator to one slot per polygon,    */
+/*      so that AddEdges() compares global polygons.                    */
+/* -------------------------------------------------------------------- */
+    std::map<GInt32, GInt32> oMapGlobalIdToSlot;
+    std::vector<GInt32> anIdToSlot(nIds);
+    std::vector<GInt32> anSlotGlobalId;
+    std::vector<DataType> anSlotValue;
+    for( int iId = 0; iId < nIds; iId++ )
+    {
+        const GInt32 nGlobalId = psStrip->anLocalId[iId];
+        auto oIter = oMapGlobalIdToSlot.find(nGlobalId);
+        if( oIter == oMapGlobalIdToSlot.end() )
+        {
+            const GInt32 nSlot = static_cast<GInt32>(anSlotGlobalId.size());
+            oMapGlobalIdToSlot[nGlobalId] = nSlot;
+            anSlotGlobalId.push_back(nGlobalId);
+            anSlotValue.push_back(psStrip->anValue[iId]);
+            anIdToSlot[iId] = nSlot;
+        }
+        else
+        {
+            anIdToSlot[iId] = oIter->second;
+        }
+    }
+    std::vector<RPolygon*> apoPoly(anSlotGlobalId.size());
+
+    std::vector<DataType> anLastLineVal(nXSize);
+    std::vector<DataType> anThisLineVal(nXSize);
+    std::vector<GInt32> anLastLineId(nXSize + 2, -1);
+    std::vector<GInt32> anThisLineId(nXSize + 2, -1);
+    std::vector<GByte> abyMaskLine(sCtxt.hMaskBand ? nXSize : 0);
+
+    GDALRasterPolygonEnumeratorT<DataType,
+                                 EqualityTest> oEnum(sCtxt.nConnectedness);
+
+    const int iYStart = psStrip->nYOff > 0 ? psStrip->nYOff - 1 : 0;
+    const int iYEnd = psStrip->nYOff + psStrip->nYSize;
+    const int iYLast = iYEnd == sCtxt.nYSize ? iYEnd : iYEnd - 1;
+    CPLErr eErr = CE_None;
+    for( int iY = iYStart; eErr == CE_None && iY <= iYLast; iY++ )
+    {
+        if( iY == sCtxt.nYSize )
+        {
+            for( int iX = 0; iX < nXSize + 2; iX++ )
+                anThisLineId[iX] = -1;
+        }
+        else
+        {
+            eErr = GPTiledReadLine( sCtxt, iY, anThisLineVal.data(),
+                                    abyMaskLine.data() );
+            if( eErr != CE_None )
+                break;
+
+            if( iY == iYStart )
+                oEnum.ProcessLine( nullptr, anThisLineVal.data(),
+                                   nullptr, anThisLineId.data() + 1,
+                                   nXSize );
+            else
+                oEnum.ProcessLine( anLastLineVal.data(),
+                                   anThisLineVal.data(),
+                                   anLastLineId.data() + 1,
+                                   anThisLineId.data() + 1,
+                                   nXSize );
+
+            // Should not happen as the enumeration is the same as in the
+            // first pass.
+            if( oEnum.nNextPolygonId > nIds )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Inconsistent polygon enumeration" );
+                eErr = CE_Failure;
+                break;
+            }
+        }
+
+        // The last line of the previous strip is only used for the edges
+        // at the top of the strip.
+        if( iY >= psStrip->nYOff )
+        {
+            for( int iX = 0; iX < nXSize + 1; iX++ )
+            {
+                AddEdges( anThisLineId.data(), anLastLineId.data(),
+                          anIdToSlot.data(), anSlotValue.data(),
+                          apoPoly.data(), iX, iY );
+            }
+        }
+
+        std::swap(anLastLineVal, anThisLineVal);
+        std::swap(anLastLineId, anThisLineId);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Build the geometries of the polygons completed in this strip,   */
+/*      and keep the parts of the others.                               */
+/* -------------------------------------------------------------------- */
+    for( size_t iSlot = 0; iSlot < apoPoly.size(); iSlot++ )
+    {
+        RPolygon *poRPoly = apoPoly[iSlot];
+        if( poRPoly == nullptr )
+            continue;
+        const GInt32 nGlobalId = anSlotGlobalId[iSlot];
+        if( eErr == CE_None &&
+            sCtxt.anFirstStrip[nGlobalId] == psStrip->iStrip &&
+            sCtxt.anLastStrip[nGlobalId] == psStrip->iStrip )
+        {
+            psStrip->aoGeoms.emplace_back(
+                poRPoly->dfPolyValue,
+                OGRGeometryUniquePtr(OGRGeometry::FromHandle(
+                    RPolygonToGeometry( poRPoly, sCtxt.padfGeoTransform ))) );
+            delete poRPoly;
+        }
+        else if( eErr == CE_None )
+        {
+            psStrip->aoParts.emplace_back(
+                nGlobalId, std::unique_ptr<RPolygon>(poRPoly) );
+        }
+        else
+        {
+            delete poRPoly;
+        }
+    }
+
+    psStrip->anLocalId.clear();
+    psStrip->anLocalId.shrink_to_fit();
+    psStrip->anValue.clear();
+    psStrip->anValue.shrink_to_fit();
+
+    psStrip->eErr = eErr;
+}
+
+} // namespace
+
+/************************************************************************/
+/*                        GDALPolygonizeTiledT()                        */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static CPLErr
+GDALPolygonizeTiledT( GDALRasterBandH hSrcBand,
+                      GDALRasterBandH hMaskBand,
+                      OGRLayerH hOutLayer, int iPixValField,
+                      int nConnectedness, int nThreads,
+                      const double *padfGeoTransform,
+                      GDALProgressFunc pfnProgress,
+                      void * pProgressArg,
+                      GDALDataType eDT )
+
+{
+    GPTiledContext<DataType> sCtxt;
+    sCtxt.hSrcBand = hSrcBand;
+    sCtxt.hMaskBand = hMaskBand;
+    sCtxt.eDT = eDT;
+    sCtxt.nXSize = GDALGetRasterBandXSize( hSrcBand );
+    sCtxt.nYSize = GDALGetRasterBandYSize( hSrcBand );
+    sCtxt.nConnectedness = nConnectedness;
+    sCtxt.padfGeoTransform = padfGeoTransform;
+
+    sCtxt.nStripHeight = GDALGetStripHeight( "GDAL_POLYGONIZE_STRIP_HEIGHT",
+                                             sCtxt.nYSize, nThreads );
+
+    const int nStrips =
+        (sCtxt.nYSize + sCtxt.nStripHeight - 1) / sCtxt.nStripHeight;
+    CPLDebug( "GDAL", "Polygonizing %d strips of %d lines with %d thread(s)",
+              nStrips, sCtxt.nStripHeight, nThreads );
+    sCtxt.aoStrips.resize(nStrips);
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        GPStrip<DataType>& oStrip = sCtxt.aoStrips[iStrip];
+        oStrip.psCtxt = &sCtxt;
+        oStrip.iStrip = iStrip;
+        oStrip.nYOff = iStrip * sCtxt.nStripHeight;
+        oStrip.nYSize = std::min(sCtxt.nStripHeight,
+                                 sCtxt.nYSize - oStrip.nYOff);
+    }
+
+    const auto Stop = [&sCtxt](GDALStripJobRunner& oRunner)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+            sCtxt.bStop = true;
+        }
+        oRunner.Stop();
+        return CE_Failure;
+    };
+
+/* -------------------------------------------------------------------- */
+/*      First pass: enumerate the polygon fragments of each strip.      */
+/* -------------------------------------------------------------------- */
+    {
+        GDALStripJobRunner oRunner( nStrips, nThreads, nStrips,
+            [&sCtxt](int iStrip)
+            {
+                GPTiledFirstPass<DataType, EqualityTest>(
+                                                &sCtxt.aoStrips[iStrip] );
+            } );
+        for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+        {
+            oRunner.Wait( iStrip );
+            if( sCtxt.aoStrips[iStrip].eErr != CE_None )
+                return Stop( oRunner );
+            if( !pfnProgress( 0.10 * (iStrip + 1) / nStrips, "",
+                              pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                return Stop( oRunner );
+            }
+        }
+    }
+
+    if( GPTiledMergeSeams( sCtxt ) != CE_None )
+        return CE_Failure;
+
+/* -------------------------------------------------------------------- */
+/*      Second pass: collect the polygon edges of each strip, and       */
+/*      write the polygons in strip order, as soon as they are          */
+/*      complete. A limited number of strips are in flight so that      */
+/*      memory use stays bounded.                                       */
+/* -------------------------------------------------------------------- */
+    GDALStripJobRunner oRunner( nStrips, nThreads, 2 * nThreads,
+        [&sCtxt](int iStrip)
+        {
+            GPTiledSecondPass<DataType, EqualityTest>(
+                                                &sCtxt.aoStrips[iStrip] );
+        } );
+    std::map<GInt32, std::unique_ptr<RPolygon>> oMapPendingPolygons;
+    CPLErr eErr = CE_None;
+    for( int iStrip = 0; eErr == CE_None && iStrip < nStrips; iStrip++ )
+    {
+        GPStrip<DataType>& oStrip = sCtxt.aoStrips[iStrip];
+        oRunner.Wait( iStrip );
+        eErr = oStrip.eErr;
+
+        for( size_t i = 0; eErr == CE_None && i < oStrip.aoGeoms.size(); i++ )
+        {
+            auto& oGeom = oStrip.aoGeoms[i];
+            eErr = EmitGeometryToLayer(
+                hOutLayer, iPixValField,
+                OGRGeometry::ToHandle(oGeom.second.release()), oGeom.first );
+        }
+        for( size_t i = 0; eErr == CE_None && i < oStrip.aoParts.size(); i++ )
+        {
+            const GInt32 nGlobalId = oStrip.aoParts[i].first;
+            RPolygon *poPart = oStrip.aoParts[i].second.get();
+            auto& poRPoly = oMapPendingPolygons[nGlobalId];
+            if( poRPoly == nullptr )
+            {
+                poRPoly.reset( new RPolygon( poPart->dfPolyValue ) );
+            }
+            for( const auto& oStringIter: poPart->oMapStrings )
+            {
+                const auto& oString = oStringIter.second;
+                for( size_t j = 1; j < oString.size(); j++ )
+                {
+                    poRPoly->AddSegment( oString[j-1].x, oString[j-1].y,
+                                         oString[j].x, oString[j].y );
+                }
+            }
+            if( sCtxt.anLastStrip[nGlobalId] == iStrip )
+            {
+                eErr = EmitPolygonToLayer( hOutLayer, iPixValField,
+                                           poRPoly.get(), padfGeoTransform );
+                oMapPendingPolygons.erase(nGlobalId);
+            }
+        }
+
+        oStrip.aoGeoms.clear();
+        oStrip.aoParts.clear();
+
+        if( eErr == CE_None &&
+            !pfnProgress( 0.10 + 0.90 * (iStrip + 1) / nStrips,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    if( eErr != CE_None )
+        return Stop( oRunner );
+
+    CPLAssert( oMapPendingPolygons.empty() );
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -548,38 +1191,6 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-/* -------------------------------------------------------------------- */
-/*      Allocate working buffers.                                       */
-/* -------------------------------------------------------------------- */
-    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
-    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
-
-    DataType *panLastLineVal = static_cast<DataType *>(
-        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
-    DataType *panThisLineVal = static_cast<DataType *>(
-        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
-    GInt32 *panLastLineId = static_cast<GInt32 *>(
-        VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
-    GInt32 *panThisLineId = static_cast<GInt32 *>(
-        VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
-
-    GByte *pabyMaskLine =
-        hMaskBand != nullptr
-        ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
-        : nullptr;
-
-    if( panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        (hMaskBand != nullptr && pabyMaskLine == nullptr) )
-    {
-        CPLFree( panThisLineId );
-        CPLFree( panLastLineId );
-        CPLFree( panThisLineVal );
-        CPLFree( panLastLineVal );
-        CPLFree( pabyMaskLine );
-        return CE_Failure;
-    }
-
 /* -------------------------------------------------------------------- */
 /*      Get the geotransform, if there is one, so we can convert the    */
 /*      vectors into georeferenced coordinates.                         */
@@ -613,6 +1224,49 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+/* -------------------------------------------------------------------- */
+/*      NUM_THREADS selects the tiled implementation.                   */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads( papszOptions, "NUM_THREADS", 0 );
+    if( nThreads > 0 )
+    {
+        return GDALPolygonizeTiledT<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            nThreads, adfGeoTransform, pfnProgress, pProgressArg, eDT );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Allocate working buffers.                                       */
+/* -------------------------------------------------------------------- */
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+
+    DataType *panLastLineVal = static_cast<DataType *>(
+        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
+    DataType *panThisLineVal = static_cast<DataType *>(
+        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
+    GInt32 *panLastLineId = static_cast<GInt32 *>(
+        VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
+    GInt32 *panThisLineId = static_cast<GInt32 *>(
+        VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
+
+    GByte *pabyMaskLine =
+        hMaskBand != nullptr
+        ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
+        : nullptr;
+
+    if( panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        (hMaskBand != nullptr && pabyMaskLine == nullptr) )
+    {
+        CPLFree( panThisLineId );
+        CPLFree( panLastLineId );
+        CPLFree( panThisLineVal );
+        CPLFree( panLastLineVal );
+        CPLFree( pabyMaskLine );
+        return CE_Failure;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      The first pass over the raster is only used to build up the     */
 /*      polygon id map so we will know in advance what polygons are     */
@@ -911,6 +1565,12 @@ GBool GDALFloatEquals( float A, float B )
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>NUM_THREADS=value/ALL_CPUS: (GDAL >= 3.4) When set, the raster is
+ * processed in strips of lines, polygonized independently by that number of
+ * worker threads. Polygons crossing strip boundaries are merged, so the same
+ * polygons are produced as without this option, but they may be written in
+ * a different order, and their rings may start at a different vertex.
+ * Polygons are written as soon as they are complete, strip after strip.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -988,6 +1648,12 @@ GDALPolygonize( GDALRasterBandH hSrcBand,
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>NUM_THREADS=value/ALL_CPUS: (GDAL >= 3.4) When set, the raster is
+ * processed in strips of lines, polygonized independently by that number of
+ * worker threads. Polygons crossing strip boundaries are merged, so the same
+ * polygons are produced as without this option, but they may be written in
+ * a different order, and their rings may start at a different vertex.
+ * Polygons are written as soon as they are complete, strip after strip.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
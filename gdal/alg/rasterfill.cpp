@@ -35,15 +35,22 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -365,6 +372,567 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
     }
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Push-pull interpolation (INTERPOLATION=PUSH_PULL).              */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace {
+
+// One level of the push-pull pyramid. Level 0 is the full resolution
+// raster, and each following level halves the resolution, down to a single
+// pixel.
+struct GFNLevel
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    std::vector<float> afValue{};
+    std::vector<float> afWeight{};
+};
+
+// Values of the per-pixel state at full resolution.
+constexpr GByte GFN_TO_FILL = 0;
+constexpr GByte GFN_VALID = 1;
+constexpr GByte GFN_TOO_FAR = 2;
+
+struct GFNRangeJob
+{
+    const std::function<void(int, int)>* pfnFunc = nullptr;
+    int nStart = 0;
+    int nEnd = 0;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          GFNRunRangeJob()                            */
+/************************************************************************/
+
+static void GFNRunRangeJob( void* pData )
+{
+    GFNRangeJob* psJob = static_cast<GFNRangeJob*>(pData);
+    (*psJob->pfnFunc)(psJob->nStart, psJob->nEnd);
+}
+
+/************************************************************************/
+/*                          GFNRunParallel()                            */
+/*                                                                      */
+/*      Call pfnFunc(nStart, nEnd) on sub-ranges covering [0, nItems[.  */
+/*      The sub-ranges are processed by the job queue, if any, when     */
+/*      nCost (the number of pixels touched) makes it worth it.         */
+/************************************************************************/
+
+static void GFNRunParallel( CPLJobQueue* poJobQueue, int nThreads,
+                            int nItems, GIntBig nCost,
+                            const std::function<void(int, int)>& pfnFunc )
+{
+    const int nJobs = (poJobQueue == nullptr || nCost < 65536) ? 1 :
+        std::min(nItems, 4 * nThreads);
+    if( nJobs <= 1 )
+    {
+        pfnFunc(0, nItems);
+        return;
+    }
+
+    std::vector<GFNRangeJob> asJobs(nJobs);
+    for( int iJob = 0; iJob < nJobs; iJob++ )
+    {
+        asJobs[iJob].pfnFunc = &pfnFunc;
+        asJobs[iJob].nStart =
+            static_cast<int>(static_cast<GIntBig>(nItems) * iJob / nJobs);
+        asJobs[iJob].nEnd =
+            static_cast<int>(static_cast<GIntBig>(nItems) * (iJob + 1) / nJobs);
+        if( !poJobQueue->SubmitJob(GFNRunRangeJob, &asJobs[iJob]) )
+            GFNRunRangeJob(&asJobs[iJob]);
+    }
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                       GFNMarkTooFarPixels()                          */
+/*                                                                      */
+/*      Flag as GFN_TOO_FAR the pixels to fill whose euclidean          */
+/*      distance to the nearest source pixel exceeds dfMaxSearchDist,   */
+/*      with the exact separable distance transform of Felzenszwalb     */
+/*      and Huttenlocher: a column pass computing the vertical          */
+/*      distance to the nearest source, then a row pass taking the      */
+/*      lower envelope of the parabolas rooted at each column.          */
+/************************************************************************/
+
+static void GFNMarkTooFarPixels( const GFNLevel& oLevel0,
+                                 std::vector<GByte>& abyState,
+                                 std::vector<int>& anColDist,
+                                 double dfMaxSearchDist,
+                                 CPLJobQueue* poJobQueue, int nThreads )
+{
+    const int nXSize = oLevel0.nXSize;
+    const int nYSize = oLevel0.nYSize;
+    const GIntBig nPixels = static_cast<GIntBig>(nXSize) * nYSize;
+    // Larger than any distance within the raster.
+    const int nInfinity = nXSize + nYSize + 1;
+
+    GFNRunParallel( poJobQueue, nThreads, nXSize, nPixels,
+        [&](int nStart, int nEnd)
+        {
+            for( int iX = nStart; iX < nEnd; iX++ )
+            {
+                int nDist = nInfinity;
+                for( int iY = 0; iY < nYSize; iY++ )
+                {
+                    const size_t i = static_cast<size_t>(iY) * nXSize + iX;
+                    nDist = oLevel0.afWeight[i] > 0 ? 0 :
+                                std::min(nDist + 1, nInfinity);
+                    anColDist[i] = nDist;
+                }
+                nDist = nInfinity;
+                for( int iY = nYSize - 1; iY >= 0; iY-- )
+                {
+                    const size_t i = static_cast<size_t>(iY) * nXSize + iX;
+                    nDist = anColDist[i] == 0 ? 0 :
+                                std::min(nDist + 1, nInfinity);
+                    anColDist[i] = std::min(anColDist[i], nDist);
+                }
+            }
+        } );
+
+    const double dfMaxSquaredDist = dfMaxSearchDist * dfMaxSearchDist;
+    GFNRunParallel( poJobQueue, nThreads, nYSize, nPixels,
+        [&](int nStart, int nEnd)
+        {
+            // Columns of the parabolas of the lower envelope, and abscissa
+            // from which each of them is the lowest.
+            std::vector<int> anSites(nXSize);
+            std::vector<double> adfFrom(nXSize + 1);
+            for( int iY = nStart; iY < nEnd; iY++ )
+            {
+                const int *panDist = &anColDist[static_cast<size_t>(iY) * nXSize];
+                GByte *pabyState = &abyState[static_cast<size_t>(iY) * nXSize];
+                const auto Height = [panDist](int iX)
+                {
+                    return static_cast<double>(panDist[iX]) * panDist[iX] +
+                           static_cast<double>(iX) * iX;
+                };
+
+                int k = -1;
+                for( int iX = 0; iX < nXSize; iX++ )
+                {
+                    if( panDist[iX] == nInfinity )
+                        continue;
+                    double dfFrom = -std::numeric_limits<double>::infinity();
+                    while( k >= 0 )
+                    {
+                        dfFrom = (Height(iX) - Height(anSites[k])) /
+                                 (2.0 * (iX - anSites[k]));
+                        if( dfFrom > adfFrom[k] )
+                            break;
+                        k--;
+                    }
+                    if( k < 0 )
+                        dfFrom = -std::numeric_limits<double>::infinity();
+                    k++;
+                    anSites[k] = iX;
+                    adfFrom[k] = dfFrom;
+                }
+
+                if( k < 0 )
+                {
+                    for( int iX = 0; iX < nXSize; iX++ )
+                    {
+                        if( pabyState[iX] == GFN_TO_FILL )
+                            pabyState[iX] = GFN_TOO_FAR;
+                    }
+                    continue;
+                }
+
+                adfFrom[k + 1] = std::numeric_limits<double>::infinity();
+                int j = 0;
+                for( int iX = 0; iX < nXSize; iX++ )
+                {
+                    while( adfFrom[j + 1] < iX )
+                        j++;
+                    if( pabyState[iX] != GFN_TO_FILL )
+                        continue;
+                    const double dfDX = iX - anSites[j];
+                    const double dfDY = panDist[anSites[j]];
+                    if( dfDX * dfDX + dfDY * dfDY > dfMaxSquaredDist )
+                        pabyState[iX] = GFN_TOO_FAR;
+                }
+            }
+        } );
+}
+
+/************************************************************************/
+/*                          GFNPushLevel()                              */
+/*                                                                      */
+/*      Compute a level from the finer one: each pixel gets the         */
+/*      weighted average of its (up to) 4 children, and the sum of      */
+/*      their weights clamped to 1.                                     */
+/************************************************************************/
+
+static void GFNPushLevel( const GFNLevel& oFine, GFNLevel& oCoarse,
+                          CPLJobQueue* poJobQueue, int nThreads )
+{
+    GFNRunParallel( poJobQueue, nThreads, oCoarse.nYSize,
+                    static_cast<GIntBig>(oFine.nXSize) * oFine.nYSize,
+        [&oFine, &oCoarse](int nStart, int nEnd)
+        {
+            for( int iY = nStart; iY < nEnd; iY++ )
+            {
+                const int iFineY0 = 2 * iY;
+                const int iFineY1 = std::min(2 * iY + 1, oFine.nYSize - 1);
+                for( int iX = 0; iX < oCoarse.nXSize; iX++ )
+                {
+                    const int iFineX0 = 2 * iX;
+                    const int iFineX1 = std::min(2 * iX + 1, oFine.nXSize - 1);
+                    double dfWeightSum = 0.0;
+                    double dfValueSum = 0.0;
+                    for( int iFineY = iFineY0; iFineY <= iFineY1; iFineY++ )
+                    {
+                        for( int iFineX = iFineX0; iFineX <= iFineX1; iFineX++ )
+                        {
+                            const size_t i =
+                                static_cast<size_t>(iFineY) * oFine.nXSize + iFineX;
+                            const double dfWeight = oFine.afWeight[i];
+                            if( dfWeight > 0 )
+                            {
+                                dfWeightSum += dfWeight;
+                                dfValueSum += dfWeight * oFine.afValue[i];
+                            }
+                        }
+                    }
+                    const size_t i = static_cast<size_t>(iY) * oCoarse.nXSize + iX;
+                    if( dfWeightSum > 0 )
+                    {
+                        oCoarse.afValue[i] =
+                            static_cast<float>(dfValueSum / dfWeightSum);
+                        oCoarse.afWeight[i] =
+                            static_cast<float>(std::min(1.0, dfWeightSum));
+                    }
+                    else
+                    {
+                        oCoarse.afValue[i] = 0.0f;
+                        oCoarse.afWeight[i] = 0.0f;
+                    }
+                }
+            }
+        } );
+}
+
+/************************************************************************/
+/*                          GFNPullLevel()                              */
+/*                                                                      */
+/*      Complete the pixels of a level whose weight is below 1 with     */
+/*      the bilinear interpolation of the (already completed) coarser   */
+/*      level. At full resolution, only the pixels to fill are          */
+/*      updated.                                                        */
+/************************************************************************/
+
+static void GFNPullLevel( GFNLevel& oFine, const GFNLevel& oCoarse,
+                          const GByte* pabyState,
+                          CPLJobQueue* poJobQueue, int nThreads )
+{
+    // Fine pixel i is at coarse coordinate i / 2 - 0.25, so it lies
+    // between coarse pixels (i - 1) / 2 and (i + 1) / 2 (rounded down),
+    // with weights 0.25 and 0.75 (even i) or 0.75 and 0.25 (odd i).
+    const auto Taps = [](int i, int nCoarseSize, int anTap[2],
+                         double adfTapWeight[2])
+    {
+        anTap[0] = (i - 1) >> 1;
+        anTap[1] = (i + 1) >> 1;
+        adfTapWeight[0] = (i & 1) ? 0.75 : 0.25;
+        adfTapWeight[1] = 1.0 - adfTapWeight[0];
+        for( int iTap = 0; iTap < 2; iTap++ )
+        {
+            if( anTap[iTap] < 0 || anTap[iTap] >= nCoarseSize )
+            {
+                anTap[iTap] = 0;
+                adfTapWeight[iTap] = 0.0;
+            }
+        }
+    };
+
+    GFNRunParallel( poJobQueue, nThreads, oFine.nYSize,
+                    static_cast<GIntBig>(oFine.nXSize) * oFine.nYSize,
+        [&](int nStart, int nEnd)
+        {
+            for( int iY = nStart; iY < nEnd; iY++ )
+            {
+                int anTapY[2];
+                double adfTapWeightY[2];
+                Taps(iY, oCoarse.nYSize, anTapY, adfTapWeightY);
+
+                for( int iX = 0; iX < oFine.nXSize; iX++ )
+                {
+                    const size_t i = static_cast<size_t>(iY) * oFine.nXSize + iX;
+                    const double dfFineWeight = oFine.afWeight[i];
+                    if( dfFineWeight >= 1.0 ||
+                        (pabyState && pabyState[i] != GFN_TO_FILL) )
+                        continue;
+
+                    int anTapX[2];
+                    double adfTapWeightX[2];
+                    Taps(iX, oCoarse.nXSize, anTapX, adfTapWeightX);
+
+                    double dfWeightSum = 0.0;
+                    double dfValueSum = 0.0;
+                    for( int iTapY = 0; iTapY < 2; iTapY++ )
+                    {
+                        for( int iTapX = 0; iTapX < 2; iTapX++ )
+                        {
+                            const size_t iCoarse =
+                                static_cast<size_t>(anTapY[iTapY]) *
+                                    oCoarse.nXSize + anTapX[iTapX];
+                            const double dfWeight =
+                                adfTapWeightY[iTapY] * adfTapWeightX[iTapX] *
+                                oCoarse.afWeight[iCoarse];
+                            if( dfWeight > 0 )
+                            {
+                                dfWeightSum += dfWeight;
+                                dfValueSum += dfWeight * oCoarse.afValue[iCoarse];
+                            }
+                        }
+                    }
+                    if( dfWeightSum > 0 )
+                    {
+                        oFine.afValue[i] = static_cast<float>(
+                            dfFineWeight * oFine.afValue[i] +
+                            (1.0 - dfFineWeight) * dfValueSum / dfWeightSum);
+                        oFine.afWeight[i] = 1.0f;
+                    }
+                }
+            }
+        } );
+}
+
+/************************************************************************/
+/*                       GDALFillNodataPushPull()                       */
+/*                                                                      */
+/*      Fill by push-pull interpolation: a pyramid of weighted          */
+/*      averages is built from the valid pixels (push), then holes      */
+/*      at each level are filled, from the coarsest level to the        */
+/*      finest one, by bilinear interpolation of the coarser level      */
+/*      (pull). This runs in time linear with the number of pixels      */
+/*      whatever the size of the holes, and each level is processed     */
+/*      by nThreads threads. The whole band is held in memory.          */
+/************************************************************************/
+
+static CPLErr
+GDALFillNodataPushPull( GDALRasterBandH hTargetBand,
+                        GDALRasterBandH hMaskBand,
+                        double dfMaxSearchDist,
+                        bool bHasNoData, float fNoData,
+                        int nThreads,
+                        GDALRasterBandH hFiltMaskBand,
+                        double dfProgressRatio,
+                        GDALProgressFunc pfnProgress,
+                        void * pProgressArg )
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    const bool bLimitSearchDist =
+        dfMaxSearchDist * dfMaxSearchDist <
+            static_cast<double>(nXSize - 1) * (nXSize - 1) +
+            static_cast<double>(nYSize - 1) * (nYSize - 1);
+
+/* -------------------------------------------------------------------- */
+/*      The whole pyramid is held in memory: fail clearly rather than   */
+/*      swapping on large rasters.                                      */
+/* -------------------------------------------------------------------- */
+    double dfNeededRAM = static_cast<double>(nPixels) *
+        (sizeof(GByte) + (bLimitSearchDist ? sizeof(int) : 0));
+    for( int nLevelXSize = nXSize, nLevelYSize = nYSize; ; )
+    {
+        dfNeededRAM += static_cast<double>(nLevelXSize) * nLevelYSize *
+                       2 * sizeof(float);
+        if( nLevelXSize == 1 && nLevelYSize == 1 )
+            break;
+        nLevelXSize = (nLevelXSize + 1) / 2;
+        nLevelYSize = (nLevelYSize + 1) / 2;
+    }
+    const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+    if( nUsableRAM > 0 && dfNeededRAM > static_cast<double>(nUsableRAM / 2) )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Push-pull interpolation of %d x %d pixels would need "
+                 "%.0f MB, more than half of the usable RAM. "
+                 "Use INTERPOLATION=INV_DIST",
+                 nXSize, nYSize, dfNeededRAM / (1024 * 1024));
+        return CE_Failure;
+    }
+
+    std::vector<GFNLevel> aoLevels;
+    std::vector<GByte> abyState;
+    try
+    {
+        abyState.resize(nPixels);
+        int nLevelXSize = nXSize;
+        int nLevelYSize = nYSize;
+        while( true )
+        {
+            aoLevels.emplace_back();
+            GFNLevel& oLevel = aoLevels.back();
+            oLevel.nXSize = nLevelXSize;
+            oLevel.nYSize = nLevelYSize;
+            oLevel.afValue.resize(
+                static_cast<size_t>(nLevelXSize) * nLevelYSize);
+            oLevel.afWeight.resize(
+                static_cast<size_t>(nLevelXSize) * nLevelYSize);
+            if( nLevelXSize == 1 && nLevelYSize == 1 )
+                break;
+            nLevelXSize = (nLevelXSize + 1) / 2;
+            nLevelYSize = (nLevelYSize + 1) / 2;
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate push-pull pyramid of %d x %d pixels",
+                 nXSize, nYSize);
+        return CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read the band and its mask.                                     */
+/* -------------------------------------------------------------------- */
+    GFNLevel& oLevel0 = aoLevels[0];
+    CPLErr eErr = CE_None;
+    for( int iY = 0; iY < nYSize && eErr == CE_None; iY++ )
+    {
+        const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+        eErr = GDALRasterIO( hMaskBand, GF_Read, 0, iY, nXSize, 1,
+                             &abyState[nOffset], nXSize, 1, GDT_Byte, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        eErr = GDALRasterIO( hTargetBand, GF_Read, 0, iY, nXSize, 1,
+                             &oLevel0.afValue[nOffset], nXSize, 1,
+                             GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const size_t i = nOffset + iX;
+            abyState[i] = abyState[i] ? GFN_VALID : GFN_TO_FILL;
+            // Source pixels at the NODATA value are kept but not used.
+            oLevel0.afWeight[i] =
+                abyState[i] == GFN_VALID &&
+                !(bHasNoData && oLevel0.afValue[i] == fNoData) ? 1.0f : 0.0f;
+        }
+
+        if( !pfnProgress( dfProgressRatio * 0.4 * (iY + 1) / nYSize,
+                          "Filling...", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+    if( eErr != CE_None )
+        return eErr;
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poThreadPool )
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+/* -------------------------------------------------------------------- */
+/*      Exclude the pixels further than dfMaxSearchDist from any        */
+/*      source pixel, unless that distance covers the whole raster.     */
+/* -------------------------------------------------------------------- */
+    if( bLimitSearchDist )
+    {
+        try
+        {
+            std::vector<int> anColDist(nPixels);
+            GFNMarkTooFarPixels( oLevel0, abyState, anColDist, dfMaxSearchDist,
+                                 poJobQueue.get(), nThreads );
+        }
+        catch( const std::bad_alloc& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate distance buffer of %d x %d pixels",
+                     nXSize, nYSize);
+            return CE_Failure;
+        }
+    }
+
+    if( !pfnProgress( dfProgressRatio * 0.5, "Filling...", pProgressArg ) )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        return CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Push then pull.                                                 */
+/* -------------------------------------------------------------------- */
+    const int nLevels = static_cast<int>(aoLevels.size());
+    for( int iLevel = 1; iLevel < nLevels; iLevel++ )
+    {
+        GFNPushLevel( aoLevels[iLevel - 1], aoLevels[iLevel],
+                      poJobQueue.get(), nThreads );
+    }
+    for( int iLevel = nLevels - 2; iLevel >= 0; iLevel-- )
+    {
+        GFNPullLevel( aoLevels[iLevel], aoLevels[iLevel + 1],
+                      iLevel == 0 ? abyState.data() : nullptr,
+                      poJobQueue.get(), nThreads );
+    }
+
+    if( !pfnProgress( dfProgressRatio * 0.6, "Filling...", pProgressArg ) )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        return CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write out the lines with filled pixels, and the filtering       */
+/*      mask if smoothing is requested.                                 */
+/* -------------------------------------------------------------------- */
+    std::vector<GByte> abyFiltMask(nXSize);
+    for( int iY = 0; iY < nYSize && eErr == CE_None; iY++ )
+    {
+        const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+        bool bLineFilled = false;
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const bool bFilled = abyState[nOffset + iX] == GFN_TO_FILL &&
+                                 oLevel0.afWeight[nOffset + iX] > 0;
+            abyFiltMask[iX] = bFilled ? 255 : 0;
+            bLineFilled |= bFilled;
+        }
+
+        if( bLineFilled )
+        {
+            eErr = GDALRasterIO( hTargetBand, GF_Write, 0, iY, nXSize, 1,
+                                 &oLevel0.afValue[nOffset], nXSize, 1,
+                                 GDT_Float32, 0, 0 );
+            if( eErr != CE_None )
+                break;
+        }
+
+        if( hFiltMaskBand )
+        {
+            eErr = GDALRasterIO( hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
+                                 abyFiltMask.data(), nXSize, 1, GDT_Byte,
+                                 0, 0 );
+            if( eErr != CE_None )
+                break;
+        }
+
+        if( !pfnProgress( dfProgressRatio * (0.6 + 0.4 * (iY + 1) / nYSize),
+                          "Filling...", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -401,6 +969,21 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>INTERPOLATION=INV_DIST/PUSH_PULL: (GDAL >= 3.4) Interpolation
+ * algorithm. INV_DIST, the default, is the four direction search described
+ * above. PUSH_PULL builds a pyramid of averages of the valid pixels, halving
+ * the resolution down to a single pixel, and then fills the nodata pixels of
+ * each level, from the coarsest to the finest one, by bilinear interpolation
+ * of the coarser level. Its run time is linear with the number of pixels,
+ * whatever the size of the regions to fill, but the whole band is held in
+ * memory (about 12 bytes per pixel, 16 when dfMaxSearchDist is smaller than
+ * the raster diagonal): it fails if this exceeds half of the usable physical
+ * RAM. Only the pixels within dfMaxSearchDist
+ * (euclidean distance) of a valid pixel are filled. TEMP_FILE_DRIVER
+ * is only used to create a work file for smoothing iterations.</li>
+ * <li>NUM_THREADS=value/ALL_CPUS: (GDAL >= 3.4) Number of threads used
+ * with INTERPOLATION=PUSH_PULL. Defaults to 1. The result does not depend
+ * on the number of threads.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -445,6 +1028,16 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
     // If there are smoothing iterations, reserve 10% of the progress for them.
     const double dfProgressRatio = nSmoothingIterations > 0 ? 0.9 : 1.0;
 
+    const char* pszInterpolation =
+        CSLFetchNameValueDef(papszOptions, "INTERPOLATION", "INV_DIST");
+    if( !EQUAL(pszInterpolation, "INV_DIST") &&
+        !EQUAL(pszInterpolation, "PUSH_PULL") )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for INTERPOLATION: %s", pszInterpolation);
+        return CE_Failure;
+    }
+
     const char* pszNoData = CSLFetchNameValue(papszOptions, "NODATA");
     bool bHasNoData = false;
     float fNoData = 0.0f;
@@ -496,6 +1089,68 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
                 papszWorkFileOptions, "BIGTIFF", "IF_SAFER");
     }
 
+/* -------------------------------------------------------------------- */
+/*      Push-pull interpolation, with a work file only for smoothing.   */
+/* -------------------------------------------------------------------- */
+    if( EQUAL(pszInterpolation, "PUSH_PULL") )
+    {
+        const int nThreads =
+            GDALGetNumThreads( papszOptions, "NUM_THREADS", 1 );
+
+        const CPLString osFiltMaskTmpFile =
+            CPLGenerateTempFilename("") + CPLString("fill_filtmask_work.tif");
+        GDALDatasetH hFiltMaskDS = nullptr;
+        if( nSmoothingIterations > 0 )
+        {
+            hFiltMaskDS =
+                GDALCreate( hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1,
+                            GDT_Byte, papszWorkFileOptions );
+            CSLDestroy(papszWorkFileOptions);
+            if( hFiltMaskDS == nullptr )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                    "Could not create mask work file. Check driver capabilities.");
+                return CE_Failure;
+            }
+        }
+        else
+        {
+            CSLDestroy(papszWorkFileOptions);
+        }
+        GDALRasterBandH hFiltMaskBand =
+            hFiltMaskDS ? GDALGetRasterBand( hFiltMaskDS, 1 ) : nullptr;
+
+        CPLErr eErr =
+            GDALFillNodataPushPull( hTargetBand, hMaskBand, dfMaxSearchDist,
+                                    bHasNoData, fNoData, nThreads,
+                                    hFiltMaskBand, dfProgressRatio,
+                                    pfnProgress, pProgressArg );
+
+        if( eErr == CE_None && hFiltMaskBand )
+        {
+            // Force masks to be to flushed and recomputed.
+            GDALFlushRasterCache( hMaskBand );
+
+            void *pScaledProgress =
+                GDALCreateScaledProgress( dfProgressRatio, 1.0,
+                                          pfnProgress, pProgressArg );
+
+            eErr = GDALMultiFilter( hTargetBand, hMaskBand, hFiltMaskBand,
+                                    nSmoothingIterations,
+                                    GDALScaledProgress, pScaledProgress );
+
+            GDALDestroyScaledProgress( pScaledProgress );
+        }
+
+        if( hFiltMaskDS )
+        {
+            GDALClose( hFiltMaskDS );
+            GDALDeleteDataset( hDriver, osFiltMaskTmpFile );
+        }
+
+        return eErr;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Create a work file to hold the Y "last value" indices.          */
 /* -------------------------------------------------------------------- */
@@ -31,16 +31,25 @@
 #include <cmath>
 #include <cstring>
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
@@ -113,6 +122,515 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
         return dfZ;
 }
 
+namespace {
+
+/* Parameters of the viewshed of one observer. Columns are relative to the */
+/* left of the processed area, lines are absolute. */
+struct ViewshedObserver
+{
+    const double* padfGeoTransform = nullptr;
+    double dfDistance2 = 0.0;
+    double dfCurvCoeff = 0.0;
+    double dfSphereDiameter = std::numeric_limits<double>::infinity();
+    double dfTargetHeight = 0.0;
+    double dfOutOfRangeVal = 0.0;
+    double dfZObserver = 0.0;
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType heightMode = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+    int nX = 0;
+    int nY = 0;
+    int nXSize = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+};
+
+/* Reads nXCount DEM values of line iLine starting at column nXOff. */
+typedef std::function<bool(int iLine, int nXOff, int nXCount,
+                           double* padfLine)> ViewshedReadFunc;
+
+/* Writes nXCount results of line iLine starting at column nXOff. */
+typedef std::function<bool(int iLine, int nXOff, int nXCount,
+                           const GByte* pabyResult,
+                           const double* padfHeightResult)> ViewshedWriteFunc;
+
+/* Called after each processed line. Returns false to stop. */
+typedef std::function<bool()> ViewshedLineDoneFunc;
+
+/* Sweep over the lines above (or below) the observer, for the columns */
+/* left and/or right of it. */
+struct ViewshedSweepArgs
+{
+    const ViewshedObserver* poObserver = nullptr;
+    const double* padfFirstLineVal = nullptr;
+    bool bUp = true;
+    bool bLeft = true;
+    bool bRight = true;
+    ViewshedReadFunc pfnRead{};
+    ViewshedWriteFunc pfnWrite{};
+    ViewshedLineDoneFunc pfnLineDone{};
+};
+
+} // namespace
+
+/************************************************************************/
+/*                      ViewshedProcessFirstLine()                      */
+/************************************************************************/
+
+/* Processes the line of the observer, in place in padfFirstLineVal. */
+static void ViewshedProcessFirstLine(const ViewshedObserver& o,
+                                     double* padfFirstLineVal,
+                                     std::vector<GByte>& vResult,
+                                     double* dfHeightResult)
+{
+    const int nX = o.nX;
+    const int nXSize = o.nXSize;
+    const GDALViewshedOutputType heightMode = o.heightMode;
+    GByte *pabyResult = vResult.data();
+    double dfZ = 0.0;
+
+    /* mark the observer point as visible */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX] : 0.0;
+    pabyResult[nX] = o.byVisibleVal;
+    if(heightMode != GVOT_NORMAL)
+        dfHeightResult[nX] = dfGroundLevel;
+
+    if (nX > 0)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX - 1] : 0.0;
+        CPL_IGNORE_RET_VAL(
+            AdjustHeightInRange(o.padfGeoTransform,
+                            1,
+                            0,
+                            padfFirstLineVal[nX - 1],
+                            o.dfDistance2,
+                            o.dfCurvCoeff,
+                            o.dfSphereDiameter));
+        pabyResult[nX - 1] = o.byVisibleVal;
+        if(heightMode != GVOT_NORMAL)
+            dfHeightResult[nX - 1] = dfGroundLevel;
+    }
+    if (nX < nXSize - 1)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX + 1] : 0.0;
+        CPL_IGNORE_RET_VAL(
+            AdjustHeightInRange(o.padfGeoTransform,
+                            1,
+                            0,
+                            padfFirstLineVal[nX + 1],
+                            o.dfDistance2,
+                            o.dfCurvCoeff,
+                            o.dfSphereDiameter));
+        pabyResult[nX + 1] = o.byVisibleVal;
+        if(heightMode != GVOT_NORMAL)
+            dfHeightResult[nX + 1] = dfGroundLevel;
+    }
+
+    /* process left direction */
+    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[iPixel] : 0.0;
+        bool adjusted = AdjustHeightInRange(o.padfGeoTransform,
+                                            nX - iPixel,
+                                            0,
+                                            padfFirstLineVal[iPixel],
+                                            o.dfDistance2,
+                                            o.dfCurvCoeff,
+                                            o.dfSphereDiameter);
+        if (adjusted)
+        {
+            dfZ = CalcHeightLine(nX - iPixel,
+                                 padfFirstLineVal[iPixel + 1],
+                                 o.dfZObserver);
+
+            if(heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(  iPixel,
+                            dfZ,
+                            o.dfTargetHeight,
+                            padfFirstLineVal,
+                            vResult,
+                            o.byVisibleVal,
+                            o.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= 0; iPixel--)
+            {
+                pabyResult[iPixel] = o.byOutOfRangeVal;
+                if(heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = o.dfOutOfRangeVal;
+            }
+        }
+    }
+    /* process right direction */
+    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[iPixel] : 0.0;
+        bool adjusted = AdjustHeightInRange(o.padfGeoTransform,
+                                            iPixel - nX,
+                                            0,
+                                            padfFirstLineVal[iPixel],
+                                            o.dfDistance2,
+                                            o.dfCurvCoeff,
+                                            o.dfSphereDiameter);
+        if (adjusted)
+        {
+            dfZ = CalcHeightLine(iPixel - nX,
+                                 padfFirstLineVal[iPixel - 1],
+                                 o.dfZObserver);
+
+            if(heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel,
+                          dfZ,
+                          o.dfTargetHeight,
+                          padfFirstLineVal,
+                          vResult,
+                          o.byVisibleVal,
+                          o.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel < nXSize; iPixel++)
+            {
+                pabyResult[iPixel] = o.byOutOfRangeVal;
+                if(heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = o.dfOutOfRangeVal;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                         ViewshedProcessLine()                        */
+/************************************************************************/
+
+/* Processes a line at nDY lines from the observer, given the previously */
+/* processed line closer to the observer. The observer column is always */
+/* processed, as both sides depend on it. */
+static void ViewshedProcessLine(const ViewshedObserver& o, int nDY,
+                                bool bLeft, bool bRight,
+                                double* padfThisLineVal,
+                                const double* padfLastLineVal,
+                                std::vector<GByte>& vResult,
+                                double* dfHeightResult)
+{
+    const int nX = o.nX;
+    const int nXSize = o.nXSize;
+    const GDALViewshedMode eMode = o.eMode;
+    const GDALViewshedOutputType heightMode = o.heightMode;
+    GByte *pabyResult = vResult.data();
+    double dfZ = 0.0;
+
+    /* set up initial point on the scanline */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[nX] : 0.0;
+    bool adjusted = AdjustHeightInRange(o.padfGeoTransform,
+                                        0,
+                                        nDY,
+                                        padfThisLineVal[nX],
+                                        o.dfDistance2,
+                                        o.dfCurvCoeff,
+                                        o.dfSphereDiameter);
+    if (adjusted)
+    {
+        dfZ = CalcHeightLine(nDY,
+                             padfLastLineVal[nX],
+                             o.dfZObserver);
+
+        if(heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] = std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+
+        SetVisibility(nX,
+                      dfZ,
+                      o.dfTargetHeight,
+                      padfThisLineVal,
+                      vResult,
+                      o.byVisibleVal,
+                      o.byInvisibleVal);
+    }
+    else
+    {
+        pabyResult[nX] = o.byOutOfRangeVal;
+        if(heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] = o.dfOutOfRangeVal;
+    }
+
+    /* process left direction */
+    for (int iPixel = nX - 1; bLeft && iPixel >= 0; iPixel--)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
+        bool left_adjusted = AdjustHeightInRange(o.padfGeoTransform,
+                                                 nX - iPixel,
+                                                 nDY,
+                                                 padfThisLineVal[iPixel],
+                                                 o.dfDistance2,
+                                                 o.dfCurvCoeff,
+                                                 o.dfSphereDiameter);
+        if (left_adjusted)
+        {
+            if (eMode != GVM_Edge)
+                dfZ = CalcHeightDiagonal(nX - iPixel,
+                                         nDY,
+                                         padfThisLineVal[iPixel + 1],
+                                         padfLastLineVal[iPixel],
+                                         o.dfZObserver);
+
+            if (eMode != GVM_Diagonal)
+            {
+                double dfZ2 = nX - iPixel >= nDY ?
+                    CalcHeightEdge(nDY,
+                                   nX - iPixel,
+                                   padfLastLineVal[iPixel + 1],
+                                   padfThisLineVal[iPixel + 1],
+                                   o.dfZObserver) :
+                    CalcHeightEdge(nX - iPixel,
+                                   nDY,
+                                   padfLastLineVal[iPixel + 1],
+                                   padfLastLineVal[iPixel],
+                                   o.dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            if(heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel,
+                          dfZ,
+                          o.dfTargetHeight,
+                          padfThisLineVal,
+                          vResult,
+                          o.byVisibleVal,
+                          o.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= 0; iPixel--)
+            {
+                pabyResult[iPixel] = o.byOutOfRangeVal;
+                if(heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = o.dfOutOfRangeVal;
+            }
+        }
+    }
+    /* process right direction */
+    for (int iPixel = nX + 1; bRight && iPixel < nXSize; iPixel++)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
+        bool right_adjusted = AdjustHeightInRange(o.padfGeoTransform,
+                                                  iPixel - nX,
+                                                  nDY,
+                                                  padfThisLineVal[iPixel],
+                                                  o.dfDistance2,
+                                                  o.dfCurvCoeff,
+                                                  o.dfSphereDiameter);
+        if (right_adjusted)
+        {
+            if (eMode != GVM_Edge)
+                dfZ = CalcHeightDiagonal(iPixel - nX,
+                                         nDY,
+                                         padfThisLineVal[iPixel - 1],
+                                         padfLastLineVal[iPixel],
+                                         o.dfZObserver);
+
+            if (eMode != GVM_Diagonal)
+            {
+                double dfZ2 = iPixel - nX >= nDY ?
+                    CalcHeightEdge(nDY,
+                                   iPixel - nX,
+                                   padfLastLineVal[iPixel - 1],
+                                   padfThisLineVal[iPixel - 1],
+                                   o.dfZObserver) :
+                    CalcHeightEdge(iPixel - nX,
+                                   nDY,
+                                   padfLastLineVal[iPixel - 1],
+                                   padfLastLineVal[iPixel],
+                                   o.dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            if(heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel,
+                          dfZ,
+                          o.dfTargetHeight,
+                          padfThisLineVal,
+                          vResult,
+                          o.byVisibleVal,
+                          o.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel < nXSize; iPixel++)
+            {
+                pabyResult[iPixel] = o.byOutOfRangeVal;
+                if(heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = o.dfOutOfRangeVal;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                            ViewshedSweep()                           */
+/************************************************************************/
+
+/* Scans upwards or downwards from the line of the observer. As the */
+/* columns left and right of the observer only depend on the observer */
+/* column and on themselves, they can be swept independently. */
+static bool ViewshedSweep(const ViewshedSweepArgs& sArgs)
+{
+    const ViewshedObserver& o = *sArgs.poObserver;
+    const int nX = o.nX;
+    const int nXSize = o.nXSize;
+
+    /* the observer column is read by both sides, and written by the right one */
+    const int nReadOff = sArgs.bLeft ? 0 : nX;
+    const int nReadCount = (sArgs.bRight ? nXSize : nX + 1) - nReadOff;
+    const int nWriteOff = nReadOff;
+    const int nWriteCount = (sArgs.bRight ? nXSize : nX) - nWriteOff;
+
+    std::vector<double> vLastLineVal;
+    std::vector<double> vThisLineVal;
+    std::vector<GByte> vResult;
+    std::vector<double> vHeightResult;
+    try
+    {
+        vLastLineVal.assign(sArgs.padfFirstLineVal, sArgs.padfFirstLineVal + nXSize);
+        vThisLineVal.resize(nXSize);
+        vResult.resize(nXSize);
+        if(o.heightMode != GVOT_NORMAL)
+            vHeightResult.resize(nXSize);
+    } catch (...)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot allocate vectors for viewshed");
+        return false;
+    }
+
+    double *padfLastLineVal = vLastLineVal.data();
+    double *padfThisLineVal = vThisLineVal.data();
+    double *dfHeightResult = vHeightResult.data();
+
+    const int nStep = sArgs.bUp ? -1 : 1;
+    const int nLineEnd = sArgs.bUp ? o.nYStart - 1 : o.nYStop;
+    for (int iLine = o.nY + nStep; iLine != nLineEnd; iLine += nStep)
+    {
+        if (!sArgs.pfnRead(iLine, nReadOff, nReadCount, padfThisLineVal + nReadOff))
+            return false;
+
+        ViewshedProcessLine(o, std::abs(iLine - o.nY), sArgs.bLeft, sArgs.bRight,
+                            padfThisLineVal, padfLastLineVal, vResult, dfHeightResult);
+
+        /* write result line */
+        if (!sArgs.pfnWrite(iLine, nWriteOff, nWriteCount,
+                            vResult.data() + nWriteOff,
+                            o.heightMode != GVOT_NORMAL ? dfHeightResult + nWriteOff : nullptr))
+            return false;
+
+        std::swap(padfLastLineVal, padfThisLineVal);
+
+        if (!sArgs.pfnLineDone())
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           ViewshedRunJobs()                          */
+/************************************************************************/
+
+namespace {
+struct ViewshedJobs
+{
+    std::vector<std::function<bool()>> aoJobs{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    size_t nJobsDone = 0;
+    int nUnitsDone = 0;
+    bool bStop = false;
+    bool bError = false;
+};
+
+struct ViewshedJob
+{
+    ViewshedJobs* poJobs = nullptr;
+    size_t iJob = 0;
+};
+} // namespace
+
+static void ViewshedJobFunc(void* pData)
+{
+    ViewshedJob* psJob = static_cast<ViewshedJob*>(pData);
+    ViewshedJobs& oJobs = *psJob->poJobs;
+    const bool bOK = oJobs.aoJobs[psJob->iJob]();
+    std::lock_guard<std::mutex> oLock(oJobs.oMutex);
+    if (!bOK)
+    {
+        oJobs.bError = true;
+        oJobs.bStop = true;
+    }
+    oJobs.nJobsDone++;
+    oJobs.oCV.notify_one();
+}
+
+/* Advances progress by one unit, from any job. Returns false to stop. */
+static bool ViewshedJobsAdvance(ViewshedJobs& oJobs)
+{
+    std::lock_guard<std::mutex> oLock(oJobs.oMutex);
+    oJobs.nUnitsDone++;
+    oJobs.oCV.notify_one();
+    return !oJobs.bStop;
+}
+
+/* Runs the jobs on the global thread pool and reports progress, from */
+/* dfProgressStart to 1, from the calling thread. */
+static bool ViewshedRunJobs(ViewshedJobs& oJobs, int nThreads, int nTotalUnits,
+                            double dfProgressStart,
+                            GDALProgressFunc pfnProgress, void* pProgressArg)
+{
+    CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    std::vector<ViewshedJob> asJobs(oJobs.aoJobs.size());
+    for (size_t i = 0; i < asJobs.size(); i++)
+    {
+        asJobs[i].poJobs = &oJobs;
+        asJobs[i].iJob = i;
+        if (!poJobQueue || !poJobQueue->SubmitJob(ViewshedJobFunc, &asJobs[i]))
+            ViewshedJobFunc(&asJobs[i]);
+    }
+
+    bool bInterrupted = false;
+    {
+        std::unique_lock<std::mutex> oLock(oJobs.oMutex);
+        while (oJobs.nJobsDone < asJobs.size())
+        {
+            oJobs.oCV.wait(oLock);
+            const double dfProgress = dfProgressStart + (1.0 - dfProgressStart) *
+                oJobs.nUnitsDone / std::max(1, nTotalUnits);
+            if (!bInterrupted && !pfnProgress(dfProgress, "", pProgressArg))
+            {
+                bInterrupted = true;
+                oJobs.bStop = true;
+            }
+        }
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    if (bInterrupted)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+    return !oJobs.bError;
+}
 
 /************************************************************************/
 /*                        GDALViewshedGenerate()                         */
@@ -192,7 +710,11 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
  *                   Parameters dfTargetHeight, dfVisibleVal and dfInvisibleVal will be ignored.
  *
  *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ * @param papszExtraOptions Options. (GDAL >= 3.4) NUM_THREADS=value/ALL_CPUS:
+ *                          the areas above-left, above-right, below-left and
+ *                          below-right of the observer, which only depend on
+ *                          the lines and columns of the observer, are then swept
+ *                          in parallel by up to 4 threads.
  *
  * @return not NULL output dataset on success (to be closed with GDALClose()) or NULL if an error occurs.
  *
@@ -214,7 +736,7 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     VALIDATE_POINTER1( hBand, "GDALViewshedGenerate", nullptr );
     VALIDATE_POINTER1( pszTargetRasterName, "GDALViewshedGenerate", nullptr );
 
-    CPL_IGNORE_RET_VAL(papszExtraOptions);
+    const int nThreads = GDALGetNumThreads(papszExtraOptions, "NUM_THREADS", 0);
 
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
@@ -275,16 +797,12 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     nX -= nXStart;
 
     std::vector<double> vFirstLineVal;
-    std::vector<double> vLastLineVal;
-    std::vector<double> vThisLineVal;
     std::vector<GByte> vResult;
     std::vector<double> vHeightResult;
 
     try
     {
         vFirstLineVal.resize(nXSize);
-        vLastLineVal.resize(nXSize);
-        vThisLineVal.resize(nXSize);
         vResult.resize(nXSize);
 
         if(heightMode != GVOT_NORMAL)
@@ -297,8 +815,6 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     }
 
     double *padfFirstLineVal = vFirstLineVal.data();
-    double *padfLastLineVal = vLastLineVal.data();
-    double *padfThisLineVal = vThisLineVal.data();
     GByte *pabyResult = vResult.data();
     double *dfHeightResult = vHeightResult.data();
 
@@ -352,14 +868,27 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
         return nullptr;
     }
 
-    const double dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
-    double dfZ = 0.0;
-    const double dfDistance2 = dfMaxDistance * dfMaxDistance;
+    ViewshedObserver oObserver;
+    oObserver.padfGeoTransform = adfGeoTransform.data();
+    oObserver.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    oObserver.dfCurvCoeff = dfCurvCoeff;
+    oObserver.dfTargetHeight = dfTargetHeight;
+    oObserver.dfOutOfRangeVal = dfOutOfRangeVal;
+    oObserver.dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
+    oObserver.eMode = eMode;
+    oObserver.heightMode = heightMode;
+    oObserver.byVisibleVal = byVisibleVal;
+    oObserver.byInvisibleVal = byInvisibleVal;
+    oObserver.byOutOfRangeVal = byOutOfRangeVal;
+    oObserver.nX = nX;
+    oObserver.nY = nY;
+    oObserver.nXSize = nXSize;
+    oObserver.nYStart = nYStart;
+    oObserver.nYStop = nYStop;
 
     /* If we can't get a SemiMajor axis from the SRS, it will be
      * SRS_WGS84_SEMIMAJOR
     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
     const OGRSpatialReference* poDstSRS = poDstDS->GetSpatialRef();
     if (poDstSRS)
     {
@@ -368,490 +897,448 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
 
         /* If we fetched the axis from the SRS, use it */
         if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
+            oObserver.dfSphereDiameter = dfSemiMajor * 2.0;
         else
             CPLDebug( "GDALViewshedGenerate", "Unable to fetch SemiMajor axis from spatial reference");
 
     }
 
-    /* mark the observer point as visible */
-    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX] : 0.0;
-    pabyResult[nX] = byVisibleVal;
-    if(heightMode != GVOT_NORMAL)
-        dfHeightResult[nX] = dfGroundLevel;
+    ViewshedProcessFirstLine(oObserver, padfFirstLineVal, vResult, dfHeightResult);
 
-    if (nX > 0)
+    /* write result line */
+
+    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
+        heightMode != GVOT_NORMAL ? static_cast<void*>(dfHeightResult) : static_cast<void*>(pabyResult), nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX - 1] : 0.0;
-        CPL_IGNORE_RET_VAL(
-            AdjustHeightInRange(adfGeoTransform.data(),
-                            1,
-                            0,
-                            padfFirstLineVal[nX - 1],
-                            dfDistance2,
-                            dfCurvCoeff,
-                            dfSphereDiameter));
-        pabyResult[nX - 1] = byVisibleVal;
-        if(heightMode != GVOT_NORMAL)
-            dfHeightResult[nX - 1] = dfGroundLevel;
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, nY - nYStart, nXSize, 1);
+        return nullptr;
     }
-    if (nX < nXSize - 1)
+
+    /* scan upwards, then downwards */
+    std::mutex oIOMutex;
+    ViewshedSweepArgs sArgs;
+    sArgs.poObserver = &oObserver;
+    sArgs.padfFirstLineVal = padfFirstLineVal;
+    sArgs.pfnRead = [&](int iLine, int nXOff, int nXCount, double* padfLine)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[nX + 1] : 0.0;
-        CPL_IGNORE_RET_VAL(
-            AdjustHeightInRange(adfGeoTransform.data(),
-                            1,
-                            0,
-                            padfFirstLineVal[nX + 1],
-                            dfDistance2,
-                            dfCurvCoeff,
-                            dfSphereDiameter));
-        pabyResult[nX + 1] = byVisibleVal;
-        if(heightMode != GVOT_NORMAL)
-            dfHeightResult[nX + 1] = dfGroundLevel;
-    }
-
-    /* process left direction */
-    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(hBand, GF_Read, nXStart + nXOff, iLine, nXCount, 1,
+            padfLine, nXCount, 1, GDT_Float64, 0, 0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXStart + nXOff, iLine, nXCount, 1);
+            return false;
+        }
+        return true;
+    };
+    sArgs.pfnWrite = [&](int iLine, int nXOff, int nXCount,
+                         const GByte* pabyLineResult, const double* padfLineHeightResult)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[iPixel] : 0.0;
-        bool adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                            nX - iPixel,
-                                            0,
-                                            padfFirstLineVal[iPixel],
-                                            dfDistance2,
-                                            dfCurvCoeff,
-                                            dfSphereDiameter);
-        if (adjusted)
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(hTargetBand, GF_Write, nXOff, iLine - nYStart, nXCount, 1,
+            heightMode != GVOT_NORMAL ? const_cast<double*>(padfLineHeightResult) : static_cast<void*>(const_cast<GByte*>(pabyLineResult)),
+            nXCount, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
         {
-            dfZ = CalcHeightLine(nX - iPixel,
-                                 padfFirstLineVal[iPixel + 1],
-                                 dfZObserver);
-
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
-
-            SetVisibility(  iPixel,
-                            dfZ,
-                            dfTargetHeight,
-                            padfFirstLineVal,
-                            vResult,
-                            byVisibleVal,
-                            byInvisibleVal);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", nXOff, iLine - nYStart, nXCount, 1);
+            return false;
         }
-        else
+        return true;
+    };
+
+    const int nLines = nYStop - nYStart;
+    if (nThreads == 0)
+    {
+        int nLinesDone = 1;
+        sArgs.pfnLineDone = [&]()
         {
-            for (; iPixel >= 0; iPixel--)
+            nLinesDone++;
+            if (!pfnProgress(nLinesDone / static_cast<double>(nLines), "", pProgressArg))
             {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
             }
-        }
+            return true;
+        };
+        sArgs.bUp = true;
+        if (!ViewshedSweep(sArgs))
+            return nullptr;
+        sArgs.bUp = false;
+        if (!ViewshedSweep(sArgs))
+            return nullptr;
     }
-    /* process right direction */
-    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
+    else
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfFirstLineVal[iPixel] : 0.0;
-        bool adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                            iPixel - nX,
-                                            0,
-                                            padfFirstLineVal[iPixel],
-                                            dfDistance2,
-                                            dfCurvCoeff,
-                                            dfSphereDiameter);
-        if (adjusted)
+        /* the four quadrants around the observer are independent */
+        ViewshedJobs oJobs;
+        sArgs.pfnLineDone = [&oJobs]() { return ViewshedJobsAdvance(oJobs); };
+        int nTotalUnits = 0;
+        for (int iQuadrant = 0; iQuadrant < 4; iQuadrant++)
         {
-            dfZ = CalcHeightLine(iPixel - nX,
-                                 padfFirstLineVal[iPixel - 1],
-                                 dfZObserver);
-
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
-
-            SetVisibility(iPixel,
-                          dfZ,
-                          dfTargetHeight,
-                          padfFirstLineVal,
-                          vResult,
-                          byVisibleVal,
-                          byInvisibleVal);
-        }
-        else
-        {
-            for (; iPixel < nXSize; iPixel++)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
+            ViewshedSweepArgs sQuadrantArgs(sArgs);
+            sQuadrantArgs.bUp = iQuadrant < 2;
+            sQuadrantArgs.bLeft = (iQuadrant % 2) == 0;
+            sQuadrantArgs.bRight = !sQuadrantArgs.bLeft;
+            const int nQuadrantLines = sQuadrantArgs.bUp ? nY - nYStart : nYStop - nY - 1;
+            if (nQuadrantLines <= 0 || (sQuadrantArgs.bLeft && nX == 0))
+                continue;
+            nTotalUnits += nQuadrantLines;
+            oJobs.aoJobs.emplace_back([sQuadrantArgs]() { return ViewshedSweep(sQuadrantArgs); });
         }
+        if (!ViewshedRunJobs(oJobs, nThreads, nTotalUnits, 1.0 / nLines,
+                             pfnProgress, pProgressArg))
+            return nullptr;
     }
-    /* write result line */
 
-    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
-        heightMode != GVOT_NORMAL ? static_cast<void*>(dfHeightResult) : static_cast<void*>(pabyResult), nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
+    if (!pfnProgress(1.0, "", pProgressArg))
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-            "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, nY - nYStart, nXSize, 1);
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
         return nullptr;
     }
 
-    /* scan upwards */
-    std::copy(vFirstLineVal.begin(),
-              vFirstLineVal.end(),
-              vLastLineVal.begin());
-    for (int iLine = nY - 1; iLine >= nYStart; iLine--)
-    {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-            padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXStart, iLine, nXSize, 1);
-            return nullptr;
-        }
+    return GDALDataset::FromHandle(poDstDS.release());
+}
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[nX] : 0.0;
-        bool adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                            0,
-                                            nY - iLine,
-                                            padfThisLineVal[nX],
-                                            dfDistance2,
-                                            dfCurvCoeff,
-                                            dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(nY - iLine,
-                                 padfLastLineVal[nX],
-                                 dfZObserver);
+/************************************************************************/
+/*                   GDALViewshedGenerateCumulative()                   */
+/************************************************************************/
 
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+/**
+ * Create cumulative viewshed of several observers from raster DEM.
+ *
+ * The viewshed of each observer is computed as with GDALViewshedGenerate(),
+ * and the output raster, of type UInt32, counts for each cell the number of
+ * observers from which it is visible. The DEM area covering the range of all
+ * observers is read once in memory, and shared by the viewsheds, which are
+ * computed in parallel when the NUM_THREADS option is set.
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated. Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObservers number of observers.
+ *
+ * @param padfObserverX observer X values (in SRS units)
+ *
+ * @param padfObserverY observer Y values (in SRS units)
+ *
+ * @param dfObserverHeight The height of the observers above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface. (default 0)
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and refraction.
+ * See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3, GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute viewsheds.
+ *                      The output raster covers the range of all observers.
+ *                      If set to 0, then unlimited range is assumed, and the
+ *                      output raster covers the whole raster.
+ *                      The DEM and the counts over that area are held in
+ *                      memory (12 bytes per pixel): the function fails if
+ *                      this exceeds half of the usable physical RAM.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszExtraOptions Options. NUM_THREADS=value/ALL_CPUS to compute
+ *                          the viewsheds of that number of observers in parallel.
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or NULL if an error occurs.
+ *
+ * @since GDAL 3.4
+ */
 
-            SetVisibility(nX,
-                          dfZ,
-                          dfTargetHeight,
-                          padfThisLineVal,
-                          vResult,
-                          byVisibleVal,
-                          byInvisibleVal);
-        }
-        else
-        {
-            pabyResult[nX] = byOutOfRangeVal;
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
-        }
+GDALDatasetH GDALViewshedGenerateCumulative(GDALRasterBandH hBand,
+                            const char* pszDriverName,
+                            const char* pszTargetRasterName,
+                            CSLConstList papszCreationOptions,
+                    int nObservers, const double* padfObserverX, const double* padfObserverY,
+                    double dfObserverHeight, double dfTargetHeight, double dfCurvCoeff,
+                    GDALViewshedMode eMode, double dfMaxDistance,
+                    GDALProgressFunc pfnProgress, void *pProgressArg,
+                    CSLConstList papszExtraOptions)
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
-            bool left_adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                                     nX - iPixel,
-                                                     nY - iLine,
-                                                     padfThisLineVal[iPixel],
-                                                     dfDistance2,
-                                                     dfCurvCoeff,
-                                                     dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(nX - iPixel,
-                                             nY - iLine,
-                                             padfThisLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 = nX - iPixel >= nY - iLine ?
-                        CalcHeightEdge(nY - iLine,
-                                       nX - iPixel,
-                                       padfLastLineVal[iPixel + 1],
-                                       padfThisLineVal[iPixel + 1],
-                                       dfZObserver) :
-                        CalcHeightEdge(nX - iPixel,
-                                       nY - iLine,
-                                       padfLastLineVal[iPixel + 1],
-                                       padfLastLineVal[iPixel],
-                                       dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+{
+    VALIDATE_POINTER1( hBand, "GDALViewshedGenerateCumulative", nullptr );
+    VALIDATE_POINTER1( pszTargetRasterName, "GDALViewshedGenerateCumulative", nullptr );
+    if (nObservers <= 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No observer");
+        return nullptr;
+    }
+    VALIDATE_POINTER1( padfObserverX, "GDALViewshedGenerateCumulative", nullptr );
+    VALIDATE_POINTER1( padfObserverY, "GDALViewshedGenerateCumulative", nullptr );
 
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                SetVisibility(iPixel,
-                              dfZ,
-                              dfTargetHeight,
-                              padfThisLineVal,
-                              vResult,
-                              byVisibleVal,
-                              byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if(heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
-            bool right_adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                                      iPixel - nX,
-                                                      nY - iLine,
-                                                      padfThisLineVal[iPixel],
-                                                      dfDistance2,
-                                                      dfCurvCoeff,
-                                                      dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(iPixel - nX,
-                                             nY - iLine,
-                                             padfThisLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 = iPixel - nX >= nY - iLine ?
-                        CalcHeightEdge(nY - iLine,
-                                       iPixel - nX,
-                                       padfLastLineVal[iPixel - 1],
-                                       padfThisLineVal[iPixel - 1],
-                                       dfZObserver) :
-                        CalcHeightEdge(iPixel - nX,
-                                       nY - iLine,
-                                       padfLastLineVal[iPixel - 1],
-                                       padfLastLineVal[iPixel],
-                                       dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    const int nThreads = GDALGetNumThreads(papszExtraOptions, "NUM_THREADS", 1);
 
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                SetVisibility(iPixel,
-                              dfZ,
-                              dfTargetHeight,
-                              padfThisLineVal,
-                              vResult,
-                              byVisibleVal,
-                              byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if(heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
+    if( pfnProgress == nullptr )
+        pfnProgress = GDALDummyProgress;
 
-        /* write result line */
-        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-            heightMode != GVOT_NORMAL ? static_cast<void*>(dfHeightResult) : static_cast<void*>(pabyResult), nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
+    if( !pfnProgress( 0.0, "", pProgressArg ) )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        return nullptr;
+    }
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform {{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset( hBand );
+    if( hSrcDS != nullptr )
+        GDALGetGeoTransform( hSrcDS, adfGeoTransform.data());
 
-        if (!pfnProgress((nYStart - iLine + 1) / static_cast<double>(nYStop),
-                "", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            return nullptr;
-        }
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
     }
-    /* scan downwards */
-    memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
-    for(int iLine = nY + 1; iLine < nYStop; iLine++ )
+
+    const int nXSize = GDALGetRasterBandXSize( hBand );
+    const int nYSize = GDALGetRasterBandYSize( hBand );
+
+    /* calculate observer positions, and the area of interest of each observer */
+    /* and of all of them */
+    std::vector<std::array<int, 6>> anObservers; // nX, nY, nXStart, nXStop, nYStart, nYStop
+    int nXMin = nXSize;
+    int nXMax = 0;
+    int nYMin = nYSize;
+    int nYMax = 0;
+    for (int i = 0; i < nObservers; i++)
     {
-        if (GDALRasterIO( hBand, GF_Read, nXStart, iLine, nXStop - nXStart, 1,
-            padfThisLineVal, nXStop - nXStart, 1, GDT_Float64, 0, 0 ))
+        double dfX, dfY;
+        GDALApplyGeoTransform(adfInvGeoTransform, padfObserverX[i], padfObserverY[i], &dfX, &dfY);
+        const int nX = static_cast<int>(dfX);
+        const int nY = static_cast<int>(dfY);
+        // Unlike GDALViewshedGenerate(), the observer must be strictly inside the DEM.
+        if (!(dfX >= 0 && dfY >= 0) || nX >= nXSize || nY >= nYSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXStart, iLine, nXStop - nXStart, 1);
+                     "The location of observer %d falls outside of the DEM area", i);
             return nullptr;
         }
+        std::array<int, 6> anObserver;
+        anObserver[0] = nX;
+        anObserver[1] = nY;
+        anObserver[2] = dfMaxDistance > 0? (std::max)(0, static_cast<int>(std::floor(nX - adfInvGeoTransform[1] * dfMaxDistance))) : 0;
+        anObserver[3] = dfMaxDistance > 0? (std::min)(nXSize, static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] * dfMaxDistance) + 1)) : nXSize;
+        anObserver[4] = dfMaxDistance > 0? (std::max)(0, static_cast<int>(std::floor(nY + adfInvGeoTransform[5] * dfMaxDistance))) : 0;
+        anObserver[5] = dfMaxDistance > 0? (std::min)(nYSize, static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] * dfMaxDistance) + 1)) : nYSize;
+        nXMin = std::min(nXMin, anObserver[2]);
+        nXMax = std::max(nXMax, anObserver[3]);
+        nYMin = std::min(nYMin, anObserver[4]);
+        nYMax = std::max(nYMax, anObserver[5]);
+        anObservers.push_back(anObserver);
+    }
+    const int nAreaXSize = nXMax - nXMin;
+    const int nAreaYSize = nYMax - nYMin;
+    const size_t nAreaSize = static_cast<size_t>(nAreaXSize) * nAreaYSize;
+
+    /* the DEM and the counts of the whole area are held in memory: fail */
+    /* clearly rather than swapping, e.g. with a large DEM and no maximum */
+    /* distance */
+    const double dfNeededRAM = static_cast<double>(nAreaSize) *
+                               (sizeof(double) + sizeof(GUInt32));
+    const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+    if (nUsableRAM > 0 && dfNeededRAM > static_cast<double>(nUsableRAM / 2))
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cumulative viewshed of a %d x %d area would need %.0f MB, "
+                 "more than half of the usable RAM. "
+                 "Use a smaller maximum distance",
+                 nAreaXSize, nAreaYSize, dfNeededRAM / (1024 * 1024));
+        return nullptr;
+    }
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[nX] : 0.0;
-        bool adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                            0,
-                                            iLine - nY,
-                                            padfThisLineVal[nX],
-                                            dfDistance2,
-                                            dfCurvCoeff,
-                                            dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iLine - nY,
-                                 padfLastLineVal[nX],
-                                 dfZObserver);
+    /* read the DEM once */
+    std::vector<double> adfDEM;
+    std::vector<std::atomic<GUInt32>> anCount;
+    try
+    {
+        adfDEM.resize(nAreaSize);
+        std::vector<std::atomic<GUInt32>>(nAreaSize).swap(anCount);
+    } catch (...)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %d x %d DEM and count arrays for viewshed", nAreaXSize, nAreaYSize);
+        return nullptr;
+    }
+    if (GDALRasterIO(hBand, GF_Read, nXMin, nYMin, nAreaXSize, nAreaYSize,
+        adfDEM.data(), nAreaXSize, nAreaYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXMin, nYMin, nAreaXSize, nAreaYSize);
+        return nullptr;
+    }
 
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+    double dfSphereDiameter(std::numeric_limits<double>::infinity());
+    const OGRSpatialReference* poSrcSRS = hSrcDS ? GDALDataset::FromHandle(hSrcDS)->GetSpatialRef() : nullptr;
+    if (poSrcSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poSrcSRS->GetSemiMajor(&eSRSerr);
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
+    }
 
-            SetVisibility(nX,
-                          dfZ,
-                          dfTargetHeight,
-                          padfThisLineVal,
-                          vResult,
-                          byVisibleVal,
-                          byInvisibleVal);
-        }
-        else
+    /* each job takes the next observer until all are processed */
+    std::atomic<int> nNextObserver(0);
+    ViewshedJobs oJobs;
+    const auto ProcessObservers = [&]()
+    {
+        std::vector<double> vFirstLineVal;
+        std::vector<GByte> vResult;
+        try
         {
-            pabyResult[nX] = byOutOfRangeVal;
-            if(heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
+            vFirstLineVal.resize(nAreaXSize);
+            vResult.resize(nAreaXSize);
+        } catch (...)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot allocate vectors for viewshed");
+            return false;
         }
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
+        for (int i = nNextObserver++; i < nObservers; i = nNextObserver++)
         {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
-            bool left_adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                                     nX - iPixel,
-                                                     iLine - nY,
-                                                     padfThisLineVal[iPixel],
-                                                     dfDistance2,
-                                                     dfCurvCoeff,
-                                                     dfSphereDiameter);
-            if (left_adjusted)
+            const std::array<int, 6>& anObserver = anObservers[i];
+            const int nXStart = anObserver[2];
+            ViewshedObserver oObserver;
+            oObserver.padfGeoTransform = adfGeoTransform.data();
+            oObserver.dfDistance2 = dfMaxDistance * dfMaxDistance;
+            oObserver.dfCurvCoeff = dfCurvCoeff;
+            oObserver.dfSphereDiameter = dfSphereDiameter;
+            oObserver.dfTargetHeight = dfTargetHeight;
+            oObserver.eMode = eMode;
+            oObserver.byVisibleVal = 1;
+            oObserver.byInvisibleVal = 0;
+            oObserver.byOutOfRangeVal = 0;
+            oObserver.nX = anObserver[0] - nXStart;
+            oObserver.nY = anObserver[1];
+            oObserver.nXSize = anObserver[3] - nXStart;
+            oObserver.nYStart = anObserver[4];
+            oObserver.nYStop = anObserver[5];
+
+            const auto Read = [&](int iLine, int nXOff, int nXCount, double* padfLine)
             {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(nX - iPixel, iLine - nY,
-                        padfThisLineVal[iPixel + 1], padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 = nX - iPixel >= iLine - nY ?
-                        CalcHeightEdge(iLine - nY,
-                                       nX - iPixel,
-                                       padfLastLineVal[iPixel + 1],
-                                       padfThisLineVal[iPixel + 1],
-                                       dfZObserver) :
-                        CalcHeightEdge(nX - iPixel,
-                                       iLine - nY,
-                                       padfLastLineVal[iPixel + 1],
-                                       padfLastLineVal[iPixel],
-                                       dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
-
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                SetVisibility(iPixel,
-                              dfZ,
-                              dfTargetHeight,
-                              padfThisLineVal,
-                              vResult,
-                              byVisibleVal,
-                              byInvisibleVal);
-            }
-            else
+                memcpy(padfLine,
+                       adfDEM.data() + static_cast<size_t>(iLine - nYMin) * nAreaXSize + nXStart - nXMin + nXOff,
+                       nXCount * sizeof(double));
+                return true;
+            };
+            const auto Accumulate = [&](int iLine, int nXOff, int nXCount,
+                                        const GByte* pabyLineResult, const double*)
             {
-                for (; iPixel >= 0; iPixel--)
+                std::atomic<GUInt32>* panLineCount =
+                    anCount.data() + static_cast<size_t>(iLine - nYMin) * nAreaXSize + nXStart - nXMin + nXOff;
+                for (int iPixel = 0; iPixel < nXCount; iPixel++)
                 {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if(heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                    if (pabyLineResult[iPixel])
+                        panLineCount[iPixel].fetch_add(1, std::memory_order_relaxed);
                 }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfThisLineVal[iPixel] : 0.0;
-            bool right_adjusted = AdjustHeightInRange(adfGeoTransform.data(),
-                                                      iPixel - nX,
-                                                      iLine - nY,
-                                                      padfThisLineVal[iPixel],
-                                                      dfDistance2,
-                                                      dfCurvCoeff,
-                                                      dfSphereDiameter);
-            if (right_adjusted)
+                return true;
+            };
+
+            CPL_IGNORE_RET_VAL(Read(oObserver.nY, 0, oObserver.nXSize, vFirstLineVal.data()));
+            oObserver.dfZObserver = dfObserverHeight + vFirstLineVal[oObserver.nX];
+            ViewshedProcessFirstLine(oObserver, vFirstLineVal.data(), vResult, nullptr);
+            CPL_IGNORE_RET_VAL(Accumulate(oObserver.nY, 0, oObserver.nXSize, vResult.data(), nullptr));
+
+            ViewshedSweepArgs sArgs;
+            sArgs.poObserver = &oObserver;
+            sArgs.padfFirstLineVal = vFirstLineVal.data();
+            sArgs.pfnRead = Read;
+            sArgs.pfnWrite = Accumulate;
+            sArgs.pfnLineDone = [&oJobs]()
             {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(iPixel - nX,
-                                             iLine - nY,
-                                             padfThisLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 = iPixel - nX >= iLine - nY ?
-                        CalcHeightEdge(iLine - nY,
-                                       iPixel - nX,
-                                       padfLastLineVal[iPixel - 1],
-                                       padfThisLineVal[iPixel - 1],
-                                       dfZObserver) :
-                        CalcHeightEdge(iPixel - nX,
-                                       iLine - nY,
-                                       padfLastLineVal[iPixel - 1],
-                                       padfLastLineVal[iPixel],
-                                       dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
-
-                if(heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                SetVisibility(iPixel,
-                              dfZ,
-                              dfTargetHeight,
-                              padfThisLineVal,
-                              vResult,
-                              byVisibleVal,
-                              byInvisibleVal);
-            }
-            else
+                std::lock_guard<std::mutex> oLock(oJobs.oMutex);
+                return !oJobs.bStop;
+            };
+            for (int iDir = 0; iDir < 2; iDir++)
             {
-                for (; iPixel < nXSize; iPixel++)
+                sArgs.bUp = iDir == 0;
+                if (!ViewshedSweep(sArgs))
                 {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if(heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                    /* not a failure if the sweep was interrupted because */
+                    /* a stop was requested, otherwise stop the other jobs */
+                    std::lock_guard<std::mutex> oLock(oJobs.oMutex);
+                    if (oJobs.bStop)
+                        return true;
+                    oJobs.bStop = true;
+                    return false;
                 }
             }
-        }
 
-        /* write result line */
-        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-            heightMode != GVOT_NORMAL ? static_cast<void*>(dfHeightResult) : static_cast<void*>(pabyResult), nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, iLine - nYStart, nXSize, 1);
-            return nullptr;
+            if (!ViewshedJobsAdvance(oJobs))
+                return true;
         }
+        return true;
+    };
+    for (int i = 0; i < std::min(nThreads, nObservers); i++)
+        oJobs.aoJobs.emplace_back(ProcessObservers);
+    if (!ViewshedRunJobs(oJobs, nThreads, nObservers, 0.0,
+                         pfnProgress, pProgressArg))
+        return nullptr;
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver = hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(hDriver->Create(pszTargetRasterName, nAreaXSize, nAreaYSize, 1, GDT_UInt32,
+                                                const_cast<char**>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "Cannot create dataset for %s", pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (poSrcSRS)
+        poDstDS->SetSpatialRef(poSrcSRS);
+
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXMin + adfGeoTransform[2] * nYMin;
+    adfDstGeoTransform[1] = adfGeoTransform[1];
+    adfDstGeoTransform[2] = adfGeoTransform[2];
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXMin + adfGeoTransform[5] * nYMin;
+    adfDstGeoTransform[4] = adfGeoTransform[4];
+    adfDstGeoTransform[5] = adfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
 
-        if(!pfnProgress((iLine + 1) / static_cast<double>(nYStop),
-                         "", pProgressArg) )
+    auto hTargetBand = poDstDS->GetRasterBand(1);
+    std::vector<GUInt32> anLineCount(nAreaXSize);
+    for (int iLine = 0; iLine < nAreaYSize; iLine++)
+    {
+        for (int iPixel = 0; iPixel < nAreaXSize; iPixel++)
+            anLineCount[iPixel] = anCount[static_cast<size_t>(iLine) * nAreaXSize + iPixel].load();
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine, nAreaXSize, 1,
+            anLineCount.data(), nAreaXSize, 1, GDT_UInt32, 0, 0))
         {
-            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, iLine, nAreaXSize, 1);
             return nullptr;
         }
     }
 
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
     return GDALDataset::FromHandle(poDstDS.release());
 }
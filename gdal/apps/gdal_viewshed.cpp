@@ -25,6 +25,8 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include <vector>
+
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "gdal_version.h"
@@ -47,11 +49,11 @@ static void Usage(const char* pszErrorMsg = nullptr)
        "Usage: gdal_viewshed [-b <band>]\n"
        "                     [-a_nodata <value>] [-f <formatname>]\n"
        "                     [-oz <observer_height>] [-tz <target_height>] [-md <max_distance>]\n"
-       "                     -ox <observer_x> -oy <observer_y>\n"
+       "                     -ox <observer_x> -oy <observer_y> [-ox <observer_x> -oy <observer_y>]*\n"
        "                     [-vv <visibility>] [-iv <invisibility>]\n"
        "                     [-ov <out_of_range>] [-cc <curvature_coef>]\n"
        "                     [[-co NAME=VALUE] ...]\n"
-       "                     [-q] [-om <output mode>]\n"
+       "                     [-q] [-om <output mode>] [-num_threads <n|ALL_CPUS>]\n"
        "                     <src_filename> <dst_filename>\n");
 
     if( pszErrorMsg != nullptr )
@@ -82,10 +84,8 @@ MAIN_START(argc, argv)
     double dfObserverHeight = 2.0;
     double dfTargetHeight = 0.0;
     double dfMaxDistance = 0.0;
-    bool bObserverXSpecified = false;
-    double dfObserverX = 0.0;
-    bool bObserverYSpecified = false;
-    double dfObserverY = 0.0;
+    std::vector<double> adfObserverX;
+    std::vector<double> adfObserverY;
     double dfVisibleVal = 255.0;
     double dfInvisibleVal = 0.0;
     double dfOutOfRangeVal = 0.0;
@@ -98,6 +98,10 @@ MAIN_START(argc, argv)
     GDALProgressFunc pfnProgress = nullptr;
     char** papszCreateOptions = nullptr;
     const char *pszOutputMode = nullptr;
+    const char *pszNumThreads = nullptr;
+    // Last option among -vv, -iv, -ov and -a_nodata, which only apply to
+    // the viewshed of a single observer.
+    const char *pszSingleObserverOption = nullptr;
 
     GDALAllRegister();
 
@@ -126,14 +130,12 @@ MAIN_START(argc, argv)
         else if( EQUAL(argv[i],"-ox") )
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            bObserverXSpecified = true;
-            dfObserverX = CPLAtofTaintedSuppressed(argv[++i]);
+            adfObserverX.push_back(CPLAtofTaintedSuppressed(argv[++i]));
         }
         else if (EQUAL(argv[i], "-oy"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            bObserverYSpecified = true;
-            dfObserverY = CPLAtofTaintedSuppressed(argv[++i]);
+            adfObserverY.push_back(CPLAtofTaintedSuppressed(argv[++i]));
         }
         else if( EQUAL(argv[i],"-oz") )
         {
@@ -143,16 +145,19 @@ MAIN_START(argc, argv)
         else if (EQUAL(argv[i], "-vv"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszSingleObserverOption = argv[i];
             dfVisibleVal = CPLAtofTaintedSuppressed(argv[++i]);
         }
         else if (EQUAL(argv[i], "-iv"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszSingleObserverOption = argv[i];
             dfInvisibleVal = CPLAtofTaintedSuppressed(argv[++i]);
         }
         else if (EQUAL(argv[i], "-ov"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszSingleObserverOption = argv[i];
             dfOutOfRangeVal = CPLAtofTaintedSuppressed(argv[++i]);
         }
         else if( EQUAL(argv[i],"-co"))
@@ -163,6 +168,7 @@ MAIN_START(argc, argv)
         else if (EQUAL(argv[i], "-a_nodata"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszSingleObserverOption = argv[i];
             dfNoDataVal = CPLAtofM(argv[++i]);;
         }
         else if (EQUAL(argv[i], "-tz"))
@@ -190,6 +196,11 @@ MAIN_START(argc, argv)
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
             pszOutputMode = argv[++i];
         }
+        else if( EQUAL(argv[i],"-num_threads") )
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszNumThreads = argv[++i];
+        }
         else if ( EQUAL(argv[i],"-q") || EQUAL(argv[i],"-quiet") )
         {
             bQuiet = TRUE;
@@ -216,16 +227,27 @@ MAIN_START(argc, argv)
         Usage("Missing destination filename.");
     }
 
-    if( !bObserverXSpecified )
+    if( adfObserverX.empty() )
     {
         Usage("Missing -ox.");
     }
 
-    if( !bObserverYSpecified )
+    if( adfObserverY.empty() )
     {
         Usage("Missing -oy.");
     }
 
+    if( adfObserverX.size() != adfObserverY.size() )
+    {
+        Usage("-ox and -oy must be specified the same number of times.");
+    }
+
+    if( adfObserverX.size() > 1 && pszSingleObserverOption != nullptr )
+    {
+        Usage(CPLSPrintf("%s cannot be used with several observers",
+                         pszSingleObserverOption));
+    }
+
     if (!bQuiet)
         pfnProgress = GDALTermProgress;
 
@@ -257,6 +279,10 @@ MAIN_START(argc, argv)
         {
             Usage("-om must be either NORMAL, DEM or GROUND");
         }
+        if( outputMode != GVOT_NORMAL && adfObserverX.size() > 1 )
+        {
+            Usage("-om must be NORMAL with several observers");
+        }
     }
 
 /* -------------------------------------------------------------------- */
@@ -278,15 +304,35 @@ MAIN_START(argc, argv)
 /* -------------------------------------------------------------------- */
 /*      Invoke.                                                         */
 /* -------------------------------------------------------------------- */
-    GDALDatasetH hDstDS = GDALViewshedGenerate( hBand,
+    CPLStringList aosExtraOptions;
+    if( pszNumThreads )
+        aosExtraOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+
+    GDALDatasetH hDstDS = nullptr;
+    if( adfObserverX.size() > 1 )
+    {
+        hDstDS = GDALViewshedGenerateCumulative( hBand,
+                         pszDriverName ? pszDriverName : osFormat.c_str(),
+                         pszDstFilename, papszCreateOptions,
+                         static_cast<int>(adfObserverX.size()),
+                         adfObserverX.data(), adfObserverY.data(),
+                         dfObserverHeight, dfTargetHeight, dfCurvCoeff,
+                         GVM_Edge, dfMaxDistance,
+                         pfnProgress, nullptr, aosExtraOptions.List());
+    }
+    else
+    {
+        hDstDS = GDALViewshedGenerate( hBand,
                          pszDriverName ? pszDriverName : osFormat.c_str(),
                          pszDstFilename, papszCreateOptions,
-                         dfObserverX, dfObserverY,
+                         adfObserverX[0], adfObserverY[0],
                          dfObserverHeight, dfTargetHeight,
                          dfVisibleVal, dfInvisibleVal,
                          dfOutOfRangeVal, dfNoDataVal, dfCurvCoeff,
                          GVM_Edge, dfMaxDistance,
-                         pfnProgress, nullptr, outputMode, nullptr);
+                         pfnProgress, nullptr, outputMode,
+                         aosExtraOptions.List());
+    }
     bool bSuccess = hDstDS != nullptr;
     GDALClose( hSrcDS );
     GDALClose( hDstDS );
@@ -109,6 +109,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
@@ -116,6 +119,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -179,6 +183,7 @@ struct GDALDEMProcessingOptions
     bool bMultiDirectional = false;
     char** papszCreateOptions = nullptr;
     int nBand = 1;
+    int nNumThreads = 1;
 };
 
 /************************************************************************/
@@ -298,6 +303,480 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                    GDALGeneric3x3LineProcessor                       */
+/*                                                                      */
+/*      Computes output lines from 3 source lines. Shared by the        */
+/*      sequential and the multi-threaded processing.                   */
+/************************************************************************/
+
+template<class T>
+struct GDALGeneric3x3LineProcessor
+{
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+
+    bool LineHasNoDataValue( const T* pafLine ) const;
+    void ProcessLine( int iY, const T* pafThreeLineWin,
+                      int nLine1Off, int nLine2Off, int nLine3Off,
+                      bool bOneOfThreeLinesHasNoData,
+                      float* pafOutputBuf ) const;
+};
+
+/************************************************************************/
+/*                        LineHasNoDataValue()                          */
+/************************************************************************/
+
+template<class T>
+bool GDALGeneric3x3LineProcessor<T>::LineHasNoDataValue( const T* pafLine ) const
+{
+    if( !bSrcHasNoData )
+        return false;
+
+    if( !std::numeric_limits<T>::is_integer )
+    {
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            if( (!bIsSrcNoDataNan &&
+                 ARE_REAL_EQUAL(pafLine[iX], fSrcNoDataValue)) ||
+                (bIsSrcNoDataNan &&
+                 CPLIsNan(static_cast<double>(pafLine[iX]))) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int iX = 0;
+    for( ; iX + 3 < nXSize; iX +=4 )
+    {
+        if( pafLine[iX] == fSrcNoDataValue ||
+            pafLine[iX + 1] == fSrcNoDataValue ||
+            pafLine[iX + 2] == fSrcNoDataValue ||
+            pafLine[iX + 3] == fSrcNoDataValue )
+        {
+            return true;
+        }
+    }
+    for( ; iX < nXSize; iX++ )
+    {
+        if( pafLine[iX] == fSrcNoDataValue )
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                           ProcessLine()                              */
+/*                                                                      */
+/*      Compute output line iY. The lines iY-1, iY and iY+1, when       */
+/*      they exist, are at the given offsets of pafThreeLineWin.        */
+/************************************************************************/
+
+template<class T>
+void GDALGeneric3x3LineProcessor<T>::ProcessLine(
+    int iY, const T* pafThreeLineWin,
+    int nLine1Off, int nLine2Off, int nLine3Off,
+    bool bOneOfThreeLinesHasNoData,
+    float* pafOutputBuf ) const
+{
+    // Move a 3x3 pafWindow over each cell
+    // (where the cell in question is #4)
+    //
+    //      0 1 2
+    //      3 4 5
+    //      6 7 8
+
+    if( iY == 0 || iY == nYSize - 1 )
+    {
+        if( !bComputeAtEdges || nXSize < 2 || nYSize < 2 )
+        {
+            // Exclude the edges
+            for( int j = 0; j < nXSize; j++ )
+            {
+                pafOutputBuf[j] = fDstNoDataValue;
+            }
+            return;
+        }
+
+        for( int j = 0; j < nXSize; j++ )
+        {
+            int jmin = (j == 0) ? j : j - 1;
+            int jmax = (j == nXSize - 1) ? j : j + 1;
+
+            if( iY == 0 )
+            {
+                T afWin[9] = {
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmin],
+                             pafThreeLineWin[nLine3Off + jmin],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + j],
+                             pafThreeLineWin[nLine3Off + j],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmax],
+                             pafThreeLineWin[nLine3Off + jmax],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    pafThreeLineWin[nLine2Off + jmin],
+                    pafThreeLineWin[nLine2Off + j],
+                    pafThreeLineWin[nLine2Off + jmax],
+                    pafThreeLineWin[nLine3Off + jmin],
+                    pafThreeLineWin[nLine3Off + j],
+                    pafThreeLineWin[nLine3Off + jmax]
+                };
+                pafOutputBuf[j] = ComputeVal(
+                    bSrcHasNoData,
+                    fSrcNoDataValue,
+                    bIsSrcNoDataNan,
+                    afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+            else
+            {
+                T afWin[9] = {
+                    pafThreeLineWin[nLine1Off + jmin],
+                    pafThreeLineWin[nLine1Off + j],
+                    pafThreeLineWin[nLine1Off + jmax],
+                    pafThreeLineWin[nLine2Off + jmin],
+                    pafThreeLineWin[nLine2Off + j],
+                    pafThreeLineWin[nLine2Off + jmax],
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmin],
+                             pafThreeLineWin[nLine1Off + jmin],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + j],
+                             pafThreeLineWin[nLine1Off + j],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmax],
+                             pafThreeLineWin[nLine1Off + jmax],
+                             bSrcHasNoData, fSrcNoDataValue),
+                };
+                pafOutputBuf[j] = ComputeVal(
+                    bSrcHasNoData,
+                    fSrcNoDataValue,
+                    bIsSrcNoDataNan,
+                    afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+        }
+        return;
+    }
+
+    // Values extrapolated at the left and right edges may be equal to the
+    // floating-point nodata value even if the source lines do not contain it.
+    const bool bEdgeHasNoData = bOneOfThreeLinesHasNoData ||
+        (bSrcHasNoData && !std::numeric_limits<T>::is_integer);
+
+    if( bComputeAtEdges && nXSize >= 2 )
+    {
+        int j = 0;
+        T afWin[9] = {
+            INTERPOL(pafThreeLineWin[nLine1Off + j],
+                     pafThreeLineWin[nLine1Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine1Off + j],
+            pafThreeLineWin[nLine1Off + j+1],
+            INTERPOL(pafThreeLineWin[nLine2Off + j],
+                     pafThreeLineWin[nLine2Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine2Off + j],
+            pafThreeLineWin[nLine2Off + j+1],
+            INTERPOL(pafThreeLineWin[nLine3Off + j],
+                     pafThreeLineWin[nLine3Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine3Off + j],
+            pafThreeLineWin[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bEdgeHasNoData,
+                fSrcNoDataValue,
+                bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    int j = 1;
+    if( pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
+    {
+        j = pfnAlg_multisample(pafThreeLineWin,
+                               nLine1Off,
+                               nLine2Off,
+                               nLine3Off,
+                               nXSize,
+                               pData,
+                               pafOutputBuf);
+    }
+
+    for( ; j < nXSize - 1; j++ )
+    {
+        T afWin[9] = {
+            pafThreeLineWin[nLine1Off + j-1],
+            pafThreeLineWin[nLine1Off + j],
+            pafThreeLineWin[nLine1Off + j+1],
+            pafThreeLineWin[nLine2Off + j-1],
+            pafThreeLineWin[nLine2Off + j],
+            pafThreeLineWin[nLine2Off + j+1],
+            pafThreeLineWin[nLine3Off + j-1],
+            pafThreeLineWin[nLine3Off + j],
+            pafThreeLineWin[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+
+    if( bComputeAtEdges && nXSize >= 2 )
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {
+            pafThreeLineWin[nLine1Off + j-1],
+            pafThreeLineWin[nLine1Off + j],
+            INTERPOL(pafThreeLineWin[nLine1Off + j],
+                     pafThreeLineWin[nLine1Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine2Off + j-1],
+            pafThreeLineWin[nLine2Off + j],
+            INTERPOL(pafThreeLineWin[nLine2Off + j],
+                     pafThreeLineWin[nLine2Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafThreeLineWin[nLine3Off + j-1],
+            pafThreeLineWin[nLine3Off + j],
+            INTERPOL(pafThreeLineWin[nLine3Off + j],
+                     pafThreeLineWin[nLine3Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue)
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bEdgeHasNoData,
+                fSrcNoDataValue,
+                bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if( nXSize > 1 )
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingThreaded()                  */
+/*                                                                      */
+/*      Process the raster in strips of lines, each strip being read    */
+/*      with a one line halo and computed by a job of the global        */
+/*      thread pool. Strips are written in order by the calling         */
+/*      thread. Raster I/O is serialized.                               */
+/************************************************************************/
+
+namespace {
+
+template<class T> struct GDALGeneric3x3Context;
+
+template<class T>
+struct GDALGeneric3x3Strip
+{
+    GDALGeneric3x3Context<T>* psCtxt = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    std::vector<float> afOutput{};
+    CPLErr eErr = CE_None;
+};
+
+template<class T>
+struct GDALGeneric3x3Context
+{
+    const GDALGeneric3x3LineProcessor<T>* poProcessor = nullptr;
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALDataType eReadDT = GDT_Unknown;
+    std::vector<GDALGeneric3x3Strip<T>> aoStrips{};
+    std::mutex oIOMutex{};
+    // Protects bStop.
+    std::mutex oMutex{};
+    bool bStop = false;
+};
+
+template<class T>
+void GDALGeneric3x3ProcessStrip( GDALGeneric3x3Strip<T>* psStrip )
+{
+    GDALGeneric3x3Context<T>* psCtxt = psStrip->psCtxt;
+    const GDALGeneric3x3LineProcessor<T>& oProcessor = *(psCtxt->poProcessor);
+    const int nXSize = oProcessor.nXSize;
+
+    CPLErr eErr = CE_None;
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        if( psCtxt->bStop )
+            eErr = CE_Failure;
+    }
+
+    // Source lines of the strip and its one line halo.
+    const int nReadYOff = std::max(0, psStrip->nYOff - 1);
+    const int nReadYEnd = std::min(oProcessor.nYSize,
+                                   psStrip->nYOff + psStrip->nYSize + 1);
+    const int nReadYSize = nReadYEnd - nReadYOff;
+    std::vector<T> afLines;
+    std::vector<bool> abLineHasNoDataValue;
+    if( eErr == CE_None )
+    {
+        try
+        {
+            afLines.resize(static_cast<size_t>(nXSize) * nReadYSize);
+            abLineHasNoDataValue.resize(nReadYSize);
+            psStrip->afOutput.resize(static_cast<size_t>(nXSize) * psStrip->nYSize);
+        }
+        catch( const std::bad_alloc& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for lines %d to %d",
+                     nReadYOff, nReadYEnd - 1);
+            eErr = CE_Failure;
+        }
+    }
+
+    if( eErr == CE_None )
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oIOMutex);
+        eErr = GDALRasterIO( psCtxt->hSrcBand, GF_Read,
+                             0, nReadYOff, nXSize, nReadYSize,
+                             afLines.data(), nXSize, nReadYSize,
+                             psCtxt->eReadDT, 0, 0 );
+    }
+
+    if( eErr == CE_None )
+    {
+        for( int i = 0; i < nReadYSize; i++ )
+        {
+            abLineHasNoDataValue[i] = oProcessor.LineHasNoDataValue(
+                afLines.data() + static_cast<size_t>(i) * nXSize);
+        }
+
+        for( int iY = psStrip->nYOff;
+             iY < psStrip->nYOff + psStrip->nYSize; iY++ )
+        {
+            const int iLine = iY - nReadYOff;
+            const int iLine1 = std::max(0, iLine - 1);
+            const int iLine3 = std::min(nReadYSize - 1, iLine + 1);
+            const bool bOneOfThreeLinesHasNoData =
+                abLineHasNoDataValue[iLine1] ||
+                abLineHasNoDataValue[iLine] ||
+                abLineHasNoDataValue[iLine3];
+            oProcessor.ProcessLine(
+                iY, afLines.data(),
+                iLine1 * nXSize, iLine * nXSize, iLine3 * nXSize,
+                bOneOfThreeLinesHasNoData,
+                psStrip->afOutput.data() +
+                    static_cast<size_t>(iY - psStrip->nYOff) * nXSize );
+        }
+    }
+
+    psStrip->eErr = eErr;
+}
+
+}  // namespace
+
+template<class T>
+static
+CPLErr GDALGeneric3x3ProcessingThreaded(
+    GDALRasterBandH hSrcBand,
+    GDALRasterBandH hDstBand,
+    GDALDataType eReadDT,
+    const GDALGeneric3x3LineProcessor<T>& oProcessor,
+    int nThreads,
+    GDALProgressFunc pfnProgress,
+    void *pProgressData )
+{
+    const int nXSize = oProcessor.nXSize;
+    const int nYSize = oProcessor.nYSize;
+
+    GDALGeneric3x3Context<T> sCtxt;
+    sCtxt.poProcessor = &oProcessor;
+    sCtxt.hSrcBand = hSrcBand;
+    sCtxt.eReadDT = eReadDT;
+
+    const int nStripHeight =
+        GDALGetStripHeight( "GDALDEM_STRIP_HEIGHT", nYSize, nThreads );
+
+    const int nStrips = (nYSize + nStripHeight - 1) / nStripHeight;
+    CPLDebug( "GDALDEM", "Processing %d strips of %d lines with %d thread(s)",
+              nStrips, nStripHeight, nThreads );
+    sCtxt.aoStrips.resize(nStrips);
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        GDALGeneric3x3Strip<T>& oStrip = sCtxt.aoStrips[iStrip];
+        oStrip.psCtxt = &sCtxt;
+        oStrip.nYOff = iStrip * nStripHeight;
+        oStrip.nYSize = std::min(nStripHeight, nYSize - oStrip.nYOff);
+    }
+
+    const auto Stop = [&sCtxt](GDALStripJobRunner& oRunner)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oMutex);
+            sCtxt.bStop = true;
+        }
+        oRunner.Stop();
+        return CE_Failure;
+    };
+
+    // Keep a limited number of strips in flight so that memory use stays
+    // bounded.
+    GDALStripJobRunner oRunner( nStrips, nThreads, 2 * nThreads,
+                                [&sCtxt](int iStrip)
+                                { GDALGeneric3x3ProcessStrip<T>(
+                                                &sCtxt.aoStrips[iStrip]); } );
+    for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+    {
+        oRunner.Wait( iStrip );
+        GDALGeneric3x3Strip<T>& oStrip = sCtxt.aoStrips[iStrip];
+        if( oStrip.eErr != CE_None )
+            return Stop( oRunner );
+
+        CPLErr eErr = CE_None;
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+            eErr = GDALRasterIO( hDstBand, GF_Write,
+                                 0, oStrip.nYOff, nXSize, oStrip.nYSize,
+                                 oStrip.afOutput.data(), nXSize, oStrip.nYSize,
+                                 GDT_Float32, 0, 0 );
+        }
+        std::vector<float>().swap(oStrip.afOutput);
+        if( eErr != CE_None )
+            return Stop( oRunner );
+
+        if( !pfnProgress( 1.0 * (oStrip.nYOff + oStrip.nYSize) / nYSize,
+                          nullptr, pProgressData ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            return Stop( oRunner );
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -311,6 +790,7 @@ CPLErr GDALGeneric3x3Processing(
     typename GDALGeneric3x3ProcessingAlg_multisample<T>::type pfnAlg_multisample,
     void *pData,
     bool bComputeAtEdges,
+    int nThreads,
     GDALProgressFunc pfnProgress,
     void *pProgressData )
 {
@@ -329,19 +809,6 @@ CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf = static_cast<float *>(
-        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin  = static_cast<T *>(
-        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -389,17 +856,45 @@ CPLErr GDALGeneric3x3Processing(
     if( !bDstHasNoData )
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3LineProcessor<T> oProcessor;
+    oProcessor.pfnAlg = pfnAlg;
+    oProcessor.pfnAlg_multisample = pfnAlg_multisample;
+    oProcessor.pData = pData;
+    oProcessor.bComputeAtEdges = bComputeAtEdges;
+    oProcessor.nXSize = nXSize;
+    oProcessor.nYSize = nYSize;
+    oProcessor.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    oProcessor.fSrcNoDataValue = fSrcNoDataValue;
+    oProcessor.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    oProcessor.fDstNoDataValue = fDstNoDataValue;
+
+    if( nThreads > 1 && nYSize > 0 )
+    {
+        const CPLErr eErr = GDALGeneric3x3ProcessingThreaded(
+            hSrcBand, hDstBand, eReadDT, oProcessor, nThreads,
+            pfnProgress, pProgressData);
+        if( eErr == CE_None )
+            pfnProgress( 1.0, nullptr, pProgressData );
+        return eErr;
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf = static_cast<float *>(
+        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin  = static_cast<T *>(
+        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
+    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2*nXSize;
 
-    // Move a 3x3 pafWindow over each cell
-    // (where the cell in question is #4)
-    //
-    //      0 1 2
-    //      3 4 5
-    //      6 7 8
-
     /* Preload the first 2 lines */
 
     bool abLineHasNoDataValue[3] = {
@@ -426,50 +921,18 @@ CPLErr GDALGeneric3x3Processing(
 
             return CE_Failure;
         }
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            abLineHasNoDataValue[i] = false;
-            for( int iX = 0; iX < nXSize; iX++ )
-            {
-                if( pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue )
-                {
-                    abLineHasNoDataValue[i] = true;
-                    break;
-                }
-            }
-        }
+        abLineHasNoDataValue[i] =
+            oProcessor.LineHasNoDataValue(pafThreeLineWin + i * nXSize);
       }
     }  // End extra scope for VC12
 
     CPLErr eErr = CE_None;
     if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
     {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j],    pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]
-            };
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
+        // The first line is computed from lines 0 and 1, the line before
+        // it being extrapolated.
+        oProcessor.ProcessLine(0, pafThreeLineWin, -1, 0, nXSize,
+                               CPL_TO_BOOL(bSrcHasNoData), pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write,
                     0, 0, nXSize, 1,
                     pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
@@ -522,145 +985,15 @@ CPLErr GDALGeneric3x3Processing(
 
         // In case none of the 3 lines have nodata values, then no need to
         // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for( ; iX + 3 < nXSize; iX +=4 )
-            {
-                if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue )
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if( !bLastLineHasNoDataValue )
-            {
-                for( ; iX < nXSize; iX++ )
-                {
-                    if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue )
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            oProcessor.LineHasNoDataValue(pafThreeLineWin + nLine3Off);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                abLineHasNoDataValue[1] ||
-                                abLineHasNoDataValue[2];
-        }
-
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            int j = 0;
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if( pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
-        {
-            j = pfnAlg_multisample(pafThreeLineWin,
-                                   nLine1Off,
-                                   nLine2Off,
-                                   nLine3Off,
-                                   nXSize,
-                                   pData,
-                                   pafOutputBuf);
-        }
-
-        for( ; j < nXSize - 1; j++ )
-        {
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue)
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if( nXSize > 1 )
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        oProcessor.ProcessLine(i, pafThreeLineWin,
+                               nLine1Off, nLine2Off, nLine3Off,
+                               bOneOfThreeLinesHasNoData, pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -694,36 +1027,8 @@ CPLErr GDALGeneric3x3Processing(
 
     if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
     {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
+        oProcessor.ProcessLine(i, pafThreeLineWin, nLine1Off, nLine2Off, -1,
+                               CPL_TO_BOOL(bSrcHasNoData), pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write,
                             0, i, nXSize, 1,
                             pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
@@ -1124,6 +1429,254 @@ int GDALHillshadeAlg_same_res_multisample( const T* pafThreeLineWin,
 }
 #endif
 
+
+/************************************************************************/
+/*                            GDALDEMSSE                                */
+/*                                                                      */
+/*      Operations on 4 consecutive source values, with the same        */
+/*      arithmetic as the per-pixel algorithms for type T, so that      */
+/*      the whole row (_multisample) implementations below give the     */
+/*      same results.                                                   */
+/************************************************************************/
+
+#ifdef HAVE_16_SSE_REG
+template<class T> struct GDALDEMSSE;
+
+template<> struct GDALDEMSSE<GInt32>
+{
+    typedef __m128i Reg;
+
+    static Reg Load( const GInt32* p )
+    {
+        return _mm_loadu_si128( reinterpret_cast<__m128i const*>(p) );
+    }
+    static Reg Add( Reg a, Reg b ) { return _mm_add_epi32(a, b); }
+    static Reg Sub( Reg a, Reg b ) { return _mm_sub_epi32(a, b); }
+    static Reg Abs( Reg a )
+    {
+        const __m128i sign = _mm_srai_epi32(a, 31);
+        return _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+    }
+    // a > b ? a : b
+    static Reg Max( Reg a, Reg b )
+    {
+        const __m128i mask = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+    // a < b ? a : b
+    static Reg Min( Reg a, Reg b )
+    {
+        const __m128i mask = _mm_cmplt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+    static __m128 ToFloat( Reg a ) { return _mm_cvtepi32_ps(a); }
+    static __m128d ToDoubleLow( Reg a ) { return _mm_cvtepi32_pd(a); }
+    static __m128d ToDoubleHigh( Reg a )
+    {
+        return _mm_cvtepi32_pd(_mm_srli_si128(a, 8));
+    }
+};
+
+template<> struct GDALDEMSSE<float>
+{
+    typedef __m128 Reg;
+
+    static Reg Load( const float* p ) { return _mm_loadu_ps(p); }
+    static Reg Add( Reg a, Reg b ) { return _mm_add_ps(a, b); }
+    static Reg Sub( Reg a, Reg b ) { return _mm_sub_ps(a, b); }
+    static Reg Abs( Reg a ) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    // a > b ? a : b, and b if one of them is NaN
+    static Reg Max( Reg a, Reg b ) { return _mm_max_ps(a, b); }
+    // a < b ? a : b, and b if one of them is NaN
+    static Reg Min( Reg a, Reg b ) { return _mm_min_ps(a, b); }
+    static __m128 ToFloat( Reg a ) { return a; }
+    static __m128d ToDoubleLow( Reg a ) { return _mm_cvtps_pd(a); }
+    static __m128d ToDoubleHigh( Reg a )
+    {
+        return _mm_cvtps_pd(_mm_movehl_ps(a, a));
+    }
+};
+
+// 3x3 windows of 4 consecutive pixels, numbered as in afWin.
+template<class T>
+struct GDALDEMSSEWin
+{
+    typedef GDALDEMSSE<T> SSE;
+    typename SSE::Reg w[9];
+
+    GDALDEMSSEWin( const T* pafThreeLineWin,
+                   int nLine1Off, int nLine2Off, int nLine3Off, int j )
+    {
+        const T* apLines[3] = { pafThreeLineWin + nLine1Off + j - 1,
+                                pafThreeLineWin + nLine2Off + j - 1,
+                                pafThreeLineWin + nLine3Off + j - 1 };
+        for( int k = 0; k < 9; k++ )
+            w[k] = SSE::Load(apLines[k / 3] + k % 3);
+    }
+
+    // (w0 + w3 + w3 + w6) - (w2 + w5 + w5 + w8)
+    typename SSE::Reg HornX() const
+    {
+        return SSE::Sub(SSE::Add(SSE::Add(SSE::Add(w[0], w[3]), w[3]), w[6]),
+                        SSE::Add(SSE::Add(SSE::Add(w[2], w[5]), w[5]), w[8]));
+    }
+
+    // (w6 + w7 + w7 + w8) - (w0 + w1 + w1 + w2)
+    typename SSE::Reg HornY() const
+    {
+        return SSE::Sub(SSE::Add(SSE::Add(SSE::Add(w[6], w[7]), w[7]), w[8]),
+                        SSE::Add(SSE::Add(SSE::Add(w[0], w[1]), w[1]), w[2]));
+    }
+};
+
+static inline __m128 GDALDEMToFloat( __m128d low, __m128d high )
+{
+    return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+}
+
+// Same as ApproxADivByInvSqrtB() on 2 values.
+static inline __m128d GDALDEMApproxADivByInvSqrtB( __m128d a, __m128d b )
+{
+    const __m128d b_half = _mm_mul_pd(b, _mm_set1_pd(0.5));
+    __m128d inv_sqrt_b = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(b)));
+    inv_sqrt_b = _mm_mul_pd(inv_sqrt_b,
+                            _mm_sub_pd(_mm_set1_pd(1.5),
+                                       _mm_mul_pd(b_half,
+                                                  _mm_mul_pd(inv_sqrt_b,
+                                                             inv_sqrt_b))));
+    return _mm_mul_pd(a, inv_sqrt_b);
+}
+
+/************************************************************************/
+/*                  GDALHillshadeAlg_multisample()                      */
+/************************************************************************/
+
+// Whole row version of GDALHillshadeAlg<T, GradientAlg::HORN>
+template<class T>
+static
+int GDALHillshadeAlg_multisample( const T* pafThreeLineWin,
+                                  int nLine1Off,
+                                  int nLine2Off,
+                                  int nLine3Off,
+                                  int nXSize,
+                                  void* pData,
+                                  float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+    const GDALHillshadeAlgData* psData =
+        static_cast<const GDALHillshadeAlgData*>(pData);
+    const __m128d reg_inv_ewres = _mm_set1_pd(psData->inv_ewres);
+    const __m128d reg_inv_nsres = _mm_set1_pd(psData->inv_nsres);
+    const __m128d reg_sin_alt = _mm_set1_pd(psData->sin_altRadians_mul_254);
+    const __m128d reg_cos_az =
+        _mm_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254);
+    const __m128d reg_sin_az =
+        _mm_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254);
+    const __m128d reg_square_z = _mm_set1_pd(psData->square_z);
+    const __m128d reg_one = _mm_set1_pd(1.0);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg accX = oWin.HornX();
+        const typename SSE::Reg accY = oWin.HornY();
+        __m128d res[2];
+        for( int k = 0; k < 2; k++ )
+        {
+            const __m128d x = _mm_mul_pd(
+                k == 0 ? SSE::ToDoubleLow(accX) : SSE::ToDoubleHigh(accX),
+                reg_inv_ewres);
+            const __m128d y = _mm_mul_pd(
+                k == 0 ? SSE::ToDoubleLow(accY) : SSE::ToDoubleHigh(accY),
+                reg_inv_nsres);
+            const __m128d xx_plus_yy = _mm_add_pd(_mm_mul_pd(x, x),
+                                                  _mm_mul_pd(y, y));
+            const __m128d numerator = _mm_sub_pd(reg_sin_alt,
+                _mm_sub_pd(_mm_mul_pd(y, reg_cos_az),
+                           _mm_mul_pd(x, reg_sin_az)));
+            const __m128d denominator = _mm_add_pd(reg_one,
+                _mm_mul_pd(reg_square_z, xx_plus_yy));
+            const __m128d cang_mul_254 =
+                GDALDEMApproxADivByInvSqrtB(numerator, denominator);
+            // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+            res[k] = _mm_max_pd(reg_one, _mm_add_pd(reg_one, cang_mul_254));
+        }
+        _mm_storeu_ps(pafOutputBuf + j, GDALDEMToFloat(res[0], res[1]));
+    }
+    return j;
+}
+
+/************************************************************************/
+/*             GDALHillshadeAlg_same_res_float_multisample()            */
+/************************************************************************/
+
+// Whole row version of GDALHillshadeAlg_same_res<float>
+static
+int GDALHillshadeAlg_same_res_float_multisample( const float* pafThreeLineWin,
+                                                 int nLine1Off,
+                                                 int nLine2Off,
+                                                 int nLine3Off,
+                                                 int nXSize,
+                                                 void* pData,
+                                                 float* pafOutputBuf )
+{
+    const GDALHillshadeAlgData* psData =
+        static_cast<const GDALHillshadeAlgData*>(pData);
+    const __m128d reg_fact_x =
+        _mm_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m128d reg_fact_y =
+        _mm_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m128d reg_constant_num =
+        _mm_set1_pd(psData->sin_altRadians_mul_254);
+    const __m128d reg_constant_denom =
+        _mm_set1_pd(psData->square_z_mul_square_inv_res);
+    const __m128d reg_one = _mm_set1_pd(1.0);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<float> oWin(pafThreeLineWin,
+                                        nLine1Off, nLine2Off, nLine3Off, j);
+        const __m128* w = oWin.w;
+        __m128 accX = _mm_sub_ps(w[0], w[8]);
+        const __m128 six_minus_two = _mm_sub_ps(w[6], w[2]);
+        __m128 accY = accX;
+        const __m128 three_minus_five = _mm_sub_ps(w[3], w[5]);
+        const __m128 one_minus_seven = _mm_sub_ps(w[1], w[7]);
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, six_minus_two);
+        accY = _mm_sub_ps(accY, six_minus_two);
+
+        __m128d res[2];
+        for( int k = 0; k < 2; k++ )
+        {
+            const __m128d x = k == 0 ? _mm_cvtps_pd(accX) :
+                                _mm_cvtps_pd(_mm_movehl_ps(accX, accX));
+            const __m128d y = k == 0 ? _mm_cvtps_pd(accY) :
+                                _mm_cvtps_pd(_mm_movehl_ps(accY, accY));
+            const __m128d xx_plus_yy = _mm_add_pd(_mm_mul_pd(x, x),
+                                                  _mm_mul_pd(y, y));
+            const __m128d numerator = _mm_add_pd(reg_constant_num,
+                _mm_add_pd(_mm_mul_pd(x, reg_fact_x),
+                           _mm_mul_pd(y, reg_fact_y)));
+            const __m128d denominator = _mm_add_pd(reg_one,
+                _mm_mul_pd(reg_constant_denom, xx_plus_yy));
+            const __m128d cang_mul_254 =
+                GDALDEMApproxADivByInvSqrtB(numerator, denominator);
+            // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+            res[k] = _mm_max_pd(reg_one, _mm_add_pd(reg_one, cang_mul_254));
+        }
+        _mm_storeu_ps(pafOutputBuf + j, GDALDEMToFloat(res[0], res[1]));
+    }
+    return j;
+}
+#endif
+
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI*M_PI)/4);
 
 template<class T, GradientAlg alg>
@@ -1375,6 +1928,68 @@ void* GDALCreateSlopeData( double* adfGeoTransform,
     return pData;
 }
 
+#ifdef HAVE_16_SSE_REG
+// Whole row version of GDALSlopeHornAlg<T>
+template<class T>
+static
+int GDALSlopeHornAlg_multisample( const T* pafThreeLineWin,
+                                  int nLine1Off,
+                                  int nLine2Off,
+                                  int nLine3Off,
+                                  int nXSize,
+                                  void* pData,
+                                  float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+    const GDALSlopeAlgData* psData = static_cast<const GDALSlopeAlgData*>(pData);
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const __m128d reg_8_scale = _mm_set1_pd(8 * psData->scale);
+    const __m128d reg_100 = _mm_set1_pd(100.0);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg accX = oWin.HornX();
+        const typename SSE::Reg accY = oWin.HornY();
+        __m128d res[2];
+        for( int k = 0; k < 2; k++ )
+        {
+            const __m128d dx = _mm_div_pd(
+                k == 0 ? SSE::ToDoubleLow(accX) : SSE::ToDoubleHigh(accX),
+                reg_ewres);
+            const __m128d dy = _mm_div_pd(
+                k == 0 ? SSE::ToDoubleLow(accY) : SSE::ToDoubleHigh(accY),
+                reg_nsres);
+            const __m128d key = _mm_add_pd(_mm_mul_pd(dx, dx),
+                                           _mm_mul_pd(dy, dy));
+            res[k] = _mm_div_pd(_mm_sqrt_pd(key), reg_8_scale);
+        }
+
+        if( psData->slopeFormat == 1 )
+        {
+            double adfTan[4];
+            _mm_storeu_pd(adfTan, res[0]);
+            _mm_storeu_pd(adfTan + 2, res[1]);
+            for( int k = 0; k < 4; k++ )
+            {
+                pafOutputBuf[j + k] = static_cast<float>(
+                    atan(adfTan[k]) * kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            _mm_storeu_ps(pafOutputBuf + j,
+                          GDALDEMToFloat(_mm_mul_pd(reg_100, res[0]),
+                                         _mm_mul_pd(reg_100, res[1])));
+        }
+    }
+    return j;
+}
+#endif
+
 /************************************************************************/
 /*                         GDALAspect()                                 */
 /************************************************************************/
@@ -2785,6 +3400,155 @@ float GDALRoughnessAlg( const T* afWin, float /*fDstNoDataValue*/,
     return static_cast<float>(pafRoughnessMax - pafRoughnessMin);
 }
 
+#ifdef HAVE_16_SSE_REG
+/************************************************************************/
+/*           Whole row versions of TRI, TPI and roughness               */
+/************************************************************************/
+
+// Whole row version of GDALTRIAlgWilson<T>
+template<class T>
+static
+int GDALTRIAlgWilson_multisample( const T* pafThreeLineWin,
+                                  int nLine1Off,
+                                  int nLine2Off,
+                                  int nLine3Off,
+                                  int nXSize,
+                                  void* /*pData*/,
+                                  float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+    const __m128 reg_one_eighth = _mm_set1_ps(0.125f);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg* w = oWin.w;
+        typename SSE::Reg sum = SSE::Abs(SSE::Sub(w[0], w[4]));
+        for( int k = 1; k < 9; k++ )
+        {
+            if( k != 4 )
+                sum = SSE::Add(sum, SSE::Abs(SSE::Sub(w[k], w[4])));
+        }
+        _mm_storeu_ps(pafOutputBuf + j,
+                      _mm_mul_ps(SSE::ToFloat(sum), reg_one_eighth));
+    }
+    return j;
+}
+
+// Whole row version of GDALTRIAlgRiley<T>
+template<class T>
+static
+int GDALTRIAlgRiley_multisample( const T* pafThreeLineWin,
+                                 int nLine1Off,
+                                 int nLine2Off,
+                                 int nLine3Off,
+                                 int nXSize,
+                                 void* /*pData*/,
+                                 float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg* w = oWin.w;
+        __m128d sum[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+        for( int k = 0; k < 9; k++ )
+        {
+            if( k == 4 )
+                continue;
+            const typename SSE::Reg diff = SSE::Sub(w[k], w[4]);
+            const __m128d diff0 = SSE::ToDoubleLow(diff);
+            const __m128d diff1 = SSE::ToDoubleHigh(diff);
+            if( k == 0 )
+            {
+                sum[0] = _mm_mul_pd(diff0, diff0);
+                sum[1] = _mm_mul_pd(diff1, diff1);
+            }
+            else
+            {
+                sum[0] = _mm_add_pd(sum[0], _mm_mul_pd(diff0, diff0));
+                sum[1] = _mm_add_pd(sum[1], _mm_mul_pd(diff1, diff1));
+            }
+        }
+        _mm_storeu_ps(pafOutputBuf + j,
+                      GDALDEMToFloat(_mm_sqrt_pd(sum[0]),
+                                     _mm_sqrt_pd(sum[1])));
+    }
+    return j;
+}
+
+// Whole row version of GDALTPIAlg<T>
+template<class T>
+static
+int GDALTPIAlg_multisample( const T* pafThreeLineWin,
+                            int nLine1Off,
+                            int nLine2Off,
+                            int nLine3Off,
+                            int nXSize,
+                            void* /*pData*/,
+                            float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+    const __m128 reg_one_eighth = _mm_set1_ps(0.125f);
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg* w = oWin.w;
+        typename SSE::Reg sum = w[0];
+        for( int k = 1; k < 9; k++ )
+        {
+            if( k != 4 )
+                sum = SSE::Add(sum, w[k]);
+        }
+        _mm_storeu_ps(pafOutputBuf + j,
+                      _mm_sub_ps(SSE::ToFloat(w[4]),
+                                 _mm_mul_ps(SSE::ToFloat(sum),
+                                            reg_one_eighth)));
+    }
+    return j;
+}
+
+// Whole row version of GDALRoughnessAlg<T>
+template<class T>
+static
+int GDALRoughnessAlg_multisample( const T* pafThreeLineWin,
+                                  int nLine1Off,
+                                  int nLine2Off,
+                                  int nLine3Off,
+                                  int nXSize,
+                                  void* /*pData*/,
+                                  float* pafOutputBuf )
+{
+    typedef GDALDEMSSE<T> SSE;
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j += 4 )
+    {
+        const GDALDEMSSEWin<T> oWin(pafThreeLineWin,
+                                    nLine1Off, nLine2Off, nLine3Off, j);
+        const typename SSE::Reg* w = oWin.w;
+        typename SSE::Reg maxVal = w[0];
+        typename SSE::Reg minVal = w[0];
+        for( int k = 1; k < 9; k++ )
+        {
+            maxVal = SSE::Max(w[k], maxVal);
+            minVal = SSE::Min(w[k], minVal);
+        }
+        _mm_storeu_ps(pafOutputBuf + j,
+                      SSE::ToFloat(SSE::Sub(maxVal, minVal)));
+    }
+    return j;
+}
+#endif
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       GDALGeneric3x3Dataset                        */
@@ -3557,6 +4321,7 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
     void* pData = nullptr;
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type pfnAlgFloat_multisample = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type pfnAlgInt32_multisample = nullptr;
 
     if( eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional )
@@ -3626,6 +4391,8 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
                     pfnAlgFloat = GDALHillshadeAlg_same_res<float>;
                     pfnAlgInt32 = GDALHillshadeAlg_same_res<GInt32>;
 #ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                                GDALHillshadeAlg_same_res_float_multisample;
                     pfnAlgInt32_multisample =
                                 GDALHillshadeAlg_same_res_multisample<GInt32>;
 #endif
@@ -3634,6 +4401,12 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
                 {
                     pfnAlgFloat = GDALHillshadeAlg<float, GradientAlg::HORN>;
                     pfnAlgInt32 = GDALHillshadeAlg<GInt32, GradientAlg::HORN>;
+#ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                                GDALHillshadeAlg_multisample<float>;
+                    pfnAlgInt32_multisample =
+                                GDALHillshadeAlg_multisample<GInt32>;
+#endif
                 }
             }
         }
@@ -3653,6 +4426,10 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample = GDALSlopeHornAlg_multisample<float>;
+            pfnAlgInt32_multisample = GDALSlopeHornAlg_multisample<GInt32>;
+#endif
         }
     }
 
@@ -3684,11 +4461,19 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         {
             pfnAlgFloat = GDALTRIAlgWilson<float>;
             pfnAlgInt32 = GDALTRIAlgWilson<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample = GDALTRIAlgWilson_multisample<float>;
+            pfnAlgInt32_multisample = GDALTRIAlgWilson_multisample<GInt32>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALTRIAlgRiley<float>;
             pfnAlgInt32 = GDALTRIAlgRiley<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample = GDALTRIAlgRiley_multisample<float>;
+            pfnAlgInt32_multisample = GDALTRIAlgRiley_multisample<GInt32>;
+#endif
         }
     }
     else if( eUtilityMode == TPI )
@@ -3697,6 +4482,10 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         bDstHasNoData = true;
         pfnAlgFloat = GDALTPIAlg<float>;
         pfnAlgInt32 = GDALTPIAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+        pfnAlgFloat_multisample = GDALTPIAlg_multisample<float>;
+        pfnAlgInt32_multisample = GDALTPIAlg_multisample<GInt32>;
+#endif
     }
     else if( eUtilityMode == ROUGHNESS )
     {
@@ -3704,6 +4493,10 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         bDstHasNoData = true;
         pfnAlgFloat = GDALRoughnessAlg<float>;
         pfnAlgInt32 = GDALRoughnessAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+        pfnAlgFloat_multisample = GDALRoughnessAlg_multisample<float>;
+        pfnAlgInt32_multisample = GDALRoughnessAlg_multisample<GInt32>;
+#endif
     }
 
     const GDALDataType eDstDataType =
@@ -3907,15 +4700,17 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
                                              pfnAlgInt32_multisample,
                                              pData,
                                              psOptions->bComputeAtEdges,
+                                             psOptions->nNumThreads,
                                              pfnProgress, pProgressData);
         }
         else
         {
             GDALGeneric3x3Processing<float>(hSrcBand, hDstBand,
                                             pfnAlgFloat,
-                                            nullptr,
+                                            pfnAlgFloat_multisample,
                                             pData,
                                             psOptions->bComputeAtEdges,
+                                            psOptions->nNumThreads,
                                             pfnProgress, pProgressData);
         }
     }
@@ -4143,6 +4938,22 @@ GDALDEMProcessingOptions *GDALDEMProcessingOptionsNew(
             psOptions->papszCreateOptions =
                 CSLAddString( psOptions->papszCreateOptions, papszArgv[++i] );
         }
+        else if( EQUAL(papszArgv[i],"-num_threads") && i+1<argc )
+        {
+            const char* pszNumThreads = papszArgv[++i];
+            if( EQUAL(pszNumThreads, "ALL_CPUS") )
+                psOptions->nNumThreads = CPLGetNumCPUs();
+            else
+                psOptions->nNumThreads = atoi(pszNumThreads);
+            if( psOptions->nNumThreads < 1 )
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -num_threads: %s", pszNumThreads);
+                GDALDEMProcessingOptionsFree(psOptions);
+                return nullptr;
+            }
+            psOptions->nNumThreads = std::min(psOptions->nNumThreads, 128);
+        }
         else if( papszArgv[i][0] == '-' )
         {
             CPLError(CE_Failure, CPLE_NotSupported,
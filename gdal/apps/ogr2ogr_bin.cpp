@@ -80,7 +80,7 @@ static void Usage( const char* pszAdditionalMsg = nullptr, bool bShort = true )
         "               [-dim XY|XYZ|XYM|XYZM|layer_dim] [layer [layer ...]]\n"
         "\n"
         "Advanced options :\n"
-        "               [-gt n] [-ds_transaction]\n"
+        "               [-gt n] [-ds_transaction] [-num_threads value]\n"
         "               [[-oo NAME=VALUE] ...] [[-doo NAME=VALUE] ...]\n"
         "               [-clipsrc [xmin ymin xmax ymax]|WKT|datasource|spat_extent]\n"
         "               [-clipsrcsql sql_statement] [-clipsrclayer layer]\n"
@@ -34,13 +34,16 @@
 
 #include <cassert>
 #include <climits>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <string>
@@ -50,13 +53,16 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -359,6 +365,10 @@ struct GDALVectorTranslateOptions
 
     /*! Maximum number of features, or -1 if no limit. */
     GIntBig nLimit;
+
+    /*! Number of threads used to translate features (field mapping,
+        reprojection and geometry operations). 1 means no multi-threading. */
+    int nNumThreads;
 };
 
 struct TargetLayerInfo
@@ -430,6 +440,18 @@ public:
                                       GIntBig& nTotalEventsDone);
 };
 
+/*! Target feature built from a source feature, or one of them with
+    -explodecollections. */
+struct TranslatedFeaturePart
+{
+    /*! Target feature, or null if it has been clipped out. */
+    std::unique_ptr<OGRFeature> poDstFeature{};
+    /*! Whether OGRFeature::SetFrom() failed. Following parts are not built. */
+    bool         bSetFromFailed = false;
+    /*! Number of geometries that could not be reprojected. */
+    int          nReprojectionFailures = 0;
+};
+
 class LayerTranslator
 {
 public:
@@ -453,6 +475,7 @@ public:
     bool                          m_bExplodeCollections;
     bool                          m_bNativeData;
     GIntBig                       m_nLimit;
+    int                           m_nNumThreads;
     OGRGeometryFactory::TransformWithOptionsCache m_transformWithOptionsCache;
 
     int                 Translate(OGRFeature* poFeatureIn,
@@ -463,6 +486,37 @@ public:
                                   GDALProgressFunc pfnProgress,
                                   void *pProgressArg,
                                   GDALVectorTranslateOptions *psOptions);
+
+    void                TranslateFeature(OGRFeature* poFeature,
+                                         TargetLayerInfo* psInfo,
+                                         OGRFeatureDefn* poDstDefn,
+                                         OGRSpatialReference* poOutputSRS,
+                                         const std::vector<OGRCoordinateTransformation*>& apoCT,
+                                         const OGRGeometryFactory::TransformWithOptionsCache& oCache,
+                                         const GDALVectorTranslateOptions *psOptions,
+                                         std::vector<TranslatedFeaturePart>& aoParts) const;
+
+    bool                WriteTranslatedFeature(OGRFeature* poFeature,
+                                               std::vector<TranslatedFeaturePart>& aoParts,
+                                               TargetLayerInfo* psInfo,
+                                               GIntBig& nTotalEventsDone,
+                                               int& nFeaturesInTransaction,
+                                               GIntBig& nFeaturesWritten,
+                                               GDALVectorTranslateOptions *psOptions);
+
+    int                 TranslatePipelined(OGRFeature* poFirstFeature,
+                                           TargetLayerInfo* psInfo,
+                                           OGRSpatialReference* poOutputSRS,
+                                           GIntBig nCountLayerFeatures,
+                                           GIntBig* pnReadFeatureCount,
+                                           GIntBig& nTotalEventsDone,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressArg,
+                                           GDALVectorTranslateOptions *psOptions,
+                                           int& nFeaturesInTransaction,
+                                           GIntBig& nCount,
+                                           GIntBig& nFeaturesWritten,
+                                           bool& bRet);
 };
 
 static OGRLayer* GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -2606,6 +2660,7 @@ GDALDatasetH GDALVectorTranslate( const char *pszDest, GDALDatasetH hDstDS, int
     oTranslator.m_bExplodeCollections = psOptions->bExplodeCollections;
     oTranslator.m_bNativeData = psOptions->bNativeData;
     oTranslator.m_nLimit = psOptions->nLimit;
+    oTranslator.m_nNumThreads = psOptions->nNumThreads;
 
     if( psOptions->nGroupTransactions )
     {
@@ -4582,17 +4637,11 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
                                 void *pProgressArg,
                                 GDALVectorTranslateOptions *psOptions )
 {
-    const int eGType = m_eGType;
     OGRSpatialReference* poOutputSRS = m_poOutputSRS;
 
     OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
     OGRLayer *poDstLayer = psInfo->m_poDstLayer;
-    const int* const panMap = psInfo->m_anMap.data();
-    const int iSrcZField = psInfo->m_iSrcZField;
-    const bool bPreserveFID = psInfo->m_bPreserveFID;
     const int nSrcGeomFieldCount = poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
-    const int nDstGeomFieldCount = poDstLayer->GetLayerDefn()->GetGeomFieldCount();
-    const bool bExplodeCollections = m_bExplodeCollections && nDstGeomFieldCount <= 1;
     const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
 
     if( poOutputSRS == nullptr && !m_bNullifyOutputSRS )
@@ -4624,6 +4673,9 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
     int         nFeaturesInTransaction = 0;
     GIntBig      nCount = 0; /* written + failed */
     GIntBig      nFeaturesWritten = 0;
+    bool         bTryPipeline = m_nNumThreads > 1 &&
+                                poFeatureIn == nullptr &&
+                                psOptions->nFIDToFetch == OGRNullFID;
 
     bool bRet = true;
     CPLErrorReset();
@@ -4663,431 +4715,921 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
 
         psInfo->m_nFeaturesRead ++;
 
-        int nIters = 1;
-        std::unique_ptr<OGRGeometryCollection> poCollToExplode;
-        int iGeomCollToExplode = -1;
-        if (bExplodeCollections)
+        // The coordinate transformations must be the same for all features
+        // to be cloned for the worker threads.
+        if( bTryPipeline && !psInfo->m_bPerFeatureCT )
+        {
+            bTryPipeline = false;
+            const int nRet = TranslatePipelined(
+                poFeature, psInfo, poOutputSRS, nCountLayerFeatures,
+                pnReadFeatureCount, nTotalEventsDone, pfnProgress,
+                pProgressArg, psOptions, nFeaturesInTransaction, nCount,
+                nFeaturesWritten, bRet);
+            if( nRet == 0 )
+                return false;
+            if( nRet > 0 )
+                break;
+        }
+
+        std::vector<OGRCoordinateTransformation*> apoCT;
+        for( const auto& poCT: psInfo->m_apoCT )
+            apoCT.push_back(poCT.get());
+        std::vector<TranslatedFeaturePart> aoParts;
+        TranslateFeature(poFeature, psInfo, poDstLayer->GetLayerDefn(),
+                         poOutputSRS, apoCT, m_transformWithOptionsCache,
+                         psOptions, aoParts);
+        if( !WriteTranslatedFeature(poFeature, aoParts, psInfo,
+                                    nTotalEventsDone, nFeaturesInTransaction,
+                                    nFeaturesWritten, psOptions) )
         {
-            OGRGeometry* poSrcGeometry;
-            if( iRequestedSrcGeomField >= 0 )
-                poSrcGeometry = poFeature->GetGeomFieldRef(
-                                        iRequestedSrcGeomField);
-            else
-                poSrcGeometry = poFeature->GetGeometryRef();
-            if (poSrcGeometry &&
-                OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
-            {
-                const int nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
-                if( nParts > 0 )
-                {
-                    iGeomCollToExplode = iRequestedSrcGeomField >= 0 ?
-                        iRequestedSrcGeomField : 0;
-                    poCollToExplode.reset(
-                        poFeature->StealGeometry(iGeomCollToExplode)->toGeometryCollection());
-                    nIters = nParts;
-                }
-            }
+            OGRFeature::DestroyFeature( poFeature );
+            return false;
+        }
+
+        OGRFeature::DestroyFeature( poFeature );
+
+        /* Report progress */
+        nCount ++;
+        bool bGoOn = true;
+        if (pfnProgress)
+        {
+            bGoOn = pfnProgress(nCountLayerFeatures ? nCount * 1.0 / nCountLayerFeatures: 1.0, "", pProgressArg) != FALSE;
+        }
+        if( !bGoOn )
+        {
+            bRet = false;
+            break;
         }
 
-        OGRFeature *poDstFeature = nullptr;
-        for(int iPart = 0; iPart < nIters; iPart++)
+        if (pnReadFeatureCount)
+            *pnReadFeatureCount = nCount;
+
+        if( psOptions->nFIDToFetch != OGRNullFID )
+            break;
+        if( poFeatureIn != nullptr )
+            break;
+    }
+
+    if( psOptions->nGroupTransactions )
+    {
+        if( psOptions->nLayerTransaction )
+        {
+            if( poDstLayer->CommitTransaction() != OGRERR_NONE )
+                bRet = false;
+        }
+    }
+
+    if( poFeatureIn == nullptr )
+    {
+        CPLDebug("GDALVectorTranslate", CPL_FRMT_GIB " features written in layer '%s'",
+                nFeaturesWritten, poDstLayer->GetName());
+    }
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                 LayerTranslator::TranslateFeature()                  */
+/*                                                                      */
+/*      Build the target feature(s) of a source feature, whose          */
+/*      geometries may be stolen. The target layer is not used, so      */
+/*      this may run concurrently for several features, provided        */
+/*      each thread has its own coordinate transformations and cache.   */
+/************************************************************************/
+
+void LayerTranslator::TranslateFeature( OGRFeature* poFeature,
+                                        TargetLayerInfo* psInfo,
+                                        OGRFeatureDefn* poDstDefn,
+                                        OGRSpatialReference* poOutputSRS,
+                                        const std::vector<OGRCoordinateTransformation*>& apoCT,
+                                        const OGRGeometryFactory::TransformWithOptionsCache& oCache,
+                                        const GDALVectorTranslateOptions *psOptions,
+                                        std::vector<TranslatedFeaturePart>& aoParts ) const
+{
+    const int eGType = m_eGType;
+    const int* const panMap = psInfo->m_anMap.data();
+    const int iSrcZField = psInfo->m_iSrcZField;
+    const int nSrcGeomFieldCount = poFeature->GetGeomFieldCount();
+    const int nDstGeomFieldCount = poDstDefn->GetGeomFieldCount();
+    const bool bExplodeCollections = m_bExplodeCollections && nDstGeomFieldCount <= 1;
+    const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
+
+    int nIters = 1;
+    std::unique_ptr<OGRGeometryCollection> poCollToExplode;
+    int iGeomCollToExplode = -1;
+    if (bExplodeCollections)
+    {
+        OGRGeometry* poSrcGeometry;
+        if( iRequestedSrcGeomField >= 0 )
+            poSrcGeometry = poFeature->GetGeomFieldRef(
+                                    iRequestedSrcGeomField);
+        else
+            poSrcGeometry = poFeature->GetGeometryRef();
+        if (poSrcGeometry &&
+            OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
         {
-            if( psOptions->nLayerTransaction &&
-                ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+            const int nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
+            if( nParts > 0 )
             {
-                if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
-                    poDstLayer->StartTransaction() == OGRERR_FAILURE )
-                {
-                    OGRFeature::DestroyFeature( poFeature );
-                    return false;
-                }
-                nFeaturesInTransaction = 0;
+                iGeomCollToExplode = iRequestedSrcGeomField >= 0 ?
+                    iRequestedSrcGeomField : 0;
+                poCollToExplode.reset(
+                    poFeature->StealGeometry(iGeomCollToExplode)->toGeometryCollection());
+                nIters = nParts;
             }
-            else if( !psOptions->nLayerTransaction &&
-                     psOptions->nGroupTransactions >= 0 &&
-                     ++nTotalEventsDone >= psOptions->nGroupTransactions )
+        }
+    }
+
+    aoParts.clear();
+    aoParts.reserve(nIters);
+    for(int iPart = 0; iPart < nIters; iPart++)
+    {
+        aoParts.emplace_back();
+        TranslatedFeaturePart& oPart = aoParts.back();
+
+        std::unique_ptr<OGRFeature> poDstFeature(new OGRFeature(poDstDefn));
+
+        /* Optimization to avoid duplicating the source geometry in the */
+        /* target feature : we steal it from the source feature for now... */
+        OGRGeometry* poStolenGeometry = nullptr;
+        if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
+            (nDstGeomFieldCount == 1 ||
+             (nDstGeomFieldCount == 0 && m_poClipSrc)) )
+        {
+            poStolenGeometry = poFeature->StealGeometry();
+        }
+        else if( !bExplodeCollections &&
+                 iRequestedSrcGeomField >= 0 )
+        {
+            poStolenGeometry = poFeature->StealGeometry(
+                iRequestedSrcGeomField);
+        }
+
+        if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
+        {
+            OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
+            delete poStolenGeometry;
+            poStolenGeometry = nullptr;
+            const bool bClippedOut = poClipped == nullptr || poClipped->IsEmpty();
+            delete poClipped;
+            if( bClippedOut )
+                continue;
+        }
+
+        if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
+        {
+            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
+            oPart.bSetFromFailed = true;
+            return;
+        }
+
+        if (psOptions->bEmptyStrAsNull) {
+            for( int i=0; i < poDstFeature->GetFieldCount(); i++ )
             {
-                if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
-                        m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
-                {
-                    OGRFeature::DestroyFeature( poFeature );
-                    return false;
-                }
-                nTotalEventsDone = 0;
+                if (!poDstFeature->IsFieldSetAndNotNull(i))
+                    continue;
+                auto fieldDef = poDstFeature->GetFieldDefnRef(i);
+                if (fieldDef->GetType() != OGRFieldType::OFTString)
+                    continue;
+                auto str = poDstFeature->GetFieldAsString(i);
+                if (strcmp(str, "") == 0)
+                    poDstFeature->SetFieldNull(i);
             }
+        }
 
-            CPLErrorReset();
-            poDstFeature = OGRFeature::CreateFeature( poDstLayer->GetLayerDefn() );
+        /* ... and now we can attach the stolen geometry */
+        if( poStolenGeometry )
+        {
+            poDstFeature->SetGeometryDirectly(poStolenGeometry);
+        }
+
+        if( psInfo->m_bPreserveFID )
+            poDstFeature->SetFID( poFeature->GetFID() );
+        else if( psInfo->m_iSrcFIDField >= 0 &&
+                 poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
+            poDstFeature->SetFID( poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField) );
+
+        /* Erase native data if asked explicitly */
+        if( !m_bNativeData )
+        {
+            poDstFeature->SetNativeData(nullptr);
+            poDstFeature->SetNativeMediaType(nullptr);
+        }
 
-            /* Optimization to avoid duplicating the source geometry in the */
-            /* target feature : we steal it from the source feature for now... */
-            OGRGeometry* poStolenGeometry = nullptr;
-            if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
-                (nDstGeomFieldCount == 1 ||
-                 (nDstGeomFieldCount == 0 && m_poClipSrc)) )
+        bool bClippedOut = false;
+        for( int iGeom = 0; !bClippedOut && iGeom < nDstGeomFieldCount; iGeom ++ )
+        {
+            OGRGeometry* poDstGeometry;
+
+            if( poCollToExplode && iGeom == iGeomCollToExplode )
             {
-                poStolenGeometry = poFeature->StealGeometry();
+                OGRGeometry* poPart = poCollToExplode->getGeometryRef(0);
+                poCollToExplode->removeGeometry(0, FALSE);
+                poDstGeometry = poPart;
+                assert(poDstGeometry);
             }
-            else if( !bExplodeCollections &&
-                     iRequestedSrcGeomField >= 0 )
+            else
             {
-                poStolenGeometry = poFeature->StealGeometry(
-                    iRequestedSrcGeomField);
+                poDstGeometry = poDstFeature->StealGeometry(iGeom);
+                if (poDstGeometry == nullptr)
+                    continue;
             }
 
-            if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
+            if (iSrcZField != -1)
             {
-                OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
-                delete poStolenGeometry;
-                poStolenGeometry = nullptr;
-                if (poClipped == nullptr || poClipped->IsEmpty())
-                {
-                    delete poClipped;
-                    goto end_loop;
-                }
-                delete poClipped;
+                SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
+                /* This will correct the coordinate dimension to 3 */
+                OGRGeometry* poDupGeometry = poDstGeometry->clone();
+                delete poDstGeometry;
+                poDstGeometry = poDupGeometry;
             }
 
-            if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
+            if (m_nCoordDim == 2 || m_nCoordDim == 3)
             {
-                if( psOptions->nGroupTransactions )
-                {
-                    if( psOptions->nLayerTransaction )
-                    {
-                        if( poDstLayer->CommitTransaction() != OGRERR_NONE )
-                        {
-                            OGRFeature::DestroyFeature( poFeature );
-                            OGRFeature::DestroyFeature( poDstFeature );
-                            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                            return false;
-                        }
-                    }
-                }
-
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
-
-                OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
-                OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                return false;
+                poDstGeometry->setCoordinateDimension( m_nCoordDim );
             }
-
-            if (psOptions->bEmptyStrAsNull) {
-                for( int i=0; i < poDstFeature->GetFieldCount(); i++ )
-                {
-                    if (!poDstFeature->IsFieldSetAndNotNull(i))
-                        continue;
-                    auto fieldDef = poDstFeature->GetFieldDefnRef(i);
-                    if (fieldDef->GetType() != OGRFieldType::OFTString)
-                        continue;
-                    auto str = poDstFeature->GetFieldAsString(i);
-                    if (strcmp(str, "") == 0)
-                        poDstFeature->SetFieldNull(i);
-                }
+            else if (m_nCoordDim == 4)
+            {
+                poDstGeometry->set3D( TRUE );
+                poDstGeometry->setMeasured( TRUE );
             }
-
-            /* ... and now we can attach the stolen geometry */
-            if( poStolenGeometry )
+            else if (m_nCoordDim == COORD_DIM_XYM)
             {
-                poDstFeature->SetGeometryDirectly(poStolenGeometry);
+                poDstGeometry->set3D( FALSE );
+                poDstGeometry->setMeasured( TRUE );
             }
-
-            if( bPreserveFID )
-                poDstFeature->SetFID( poFeature->GetFID() );
-            else if( psInfo->m_iSrcFIDField >= 0 &&
-                     poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
-                poDstFeature->SetFID( poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField) );
-
-            /* Erase native data if asked explicitly */
-            if( !m_bNativeData )
+            else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
             {
-                poDstFeature->SetNativeData(nullptr);
-                poDstFeature->SetNativeMediaType(nullptr);
+                const OGRwkbGeometryType eDstLayerGeomType =
+                  poDstDefn->GetGeomFieldDefn(iGeom)->GetType();
+                poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
+                poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
             }
 
-            for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
+            if (m_eGeomOp == GEOMOP_SEGMENTIZE)
             {
-                OGRGeometry* poDstGeometry;
-
-                if( poCollToExplode && iGeom == iGeomCollToExplode )
-                {
-                    OGRGeometry* poPart = poCollToExplode->getGeometryRef(0);
-                    poCollToExplode->removeGeometry(0, FALSE);
-                    poDstGeometry = poPart;
-                    assert(poDstGeometry);
-                }
-                else
+                if (m_dfGeomOpParam > 0)
+                    poDstGeometry->segmentize(m_dfGeomOpParam);
+            }
+            else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+            {
+                if (m_dfGeomOpParam > 0)
                 {
-                    poDstGeometry = poDstFeature->StealGeometry(iGeom);
-                    if (poDstGeometry == nullptr)
-                        continue;
+                    OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
+                    if (poNewGeom)
+                    {
+                        delete poDstGeometry;
+                        poDstGeometry = poNewGeom;
+                    }
                 }
+            }
 
-                if (iSrcZField != -1)
+            if (m_poClipSrc)
+            {
+                OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
+                delete poDstGeometry;
+                if (poClipped == nullptr || poClipped->IsEmpty())
                 {
-                    SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
-                    /* This will correct the coordinate dimension to 3 */
-                    OGRGeometry* poDupGeometry = poDstGeometry->clone();
-                    delete poDstGeometry;
-                    poDstGeometry = poDupGeometry;
+                    delete poClipped;
+                    bClippedOut = true;
+                    break;
                 }
+                poDstGeometry = poClipped;
+            }
 
-                if (m_nCoordDim == 2 || m_nCoordDim == 3)
-                {
-                    poDstGeometry->setCoordinateDimension( m_nCoordDim );
-                }
-                else if (m_nCoordDim == 4)
-                {
-                    poDstGeometry->set3D( TRUE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if (m_nCoordDim == COORD_DIM_XYM)
-                {
-                    poDstGeometry->set3D( FALSE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
-                {
-                    const OGRwkbGeometryType eDstLayerGeomType =
-                      poDstLayer->GetLayerDefn()->GetGeomFieldDefn(iGeom)->GetType();
-                    poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
-                    poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
-                }
+            OGRCoordinateTransformation* const poCT = apoCT[iGeom];
+            char** const papszTransformOptions = psInfo->m_aosTransformOptions[iGeom].List();
 
-                if (m_eGeomOp == GEOMOP_SEGMENTIZE)
-                {
-                    if (m_dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(m_dfGeomOpParam);
-                }
-                else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+            if( poCT != nullptr || papszTransformOptions != nullptr)
+            {
+                OGRGeometry* poReprojectedGeom =
+                    OGRGeometryFactory::transformWithOptions(
+                        poDstGeometry, poCT, papszTransformOptions, oCache);
+                if( poReprojectedGeom == nullptr )
                 {
-                    if (m_dfGeomOpParam > 0)
+                    oPart.nReprojectionFailures ++;
+                    if( !psOptions->bSkipFailures )
                     {
-                        OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poNewGeom;
-                        }
+                        delete poDstGeometry;
+                        return;
                     }
                 }
 
-                if (m_poClipSrc)
+                delete poDstGeometry;
+                poDstGeometry = poReprojectedGeom;
+            }
+            else if (poOutputSRS != nullptr)
+            {
+                poDstGeometry->assignSpatialReference(poOutputSRS);
+            }
+
+            if( poDstGeometry != nullptr )
+            {
+                if (m_poClipDst)
                 {
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
+                    OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
                     delete poDstGeometry;
                     if (poClipped == nullptr || poClipped->IsEmpty())
                     {
                         delete poClipped;
-                        goto end_loop;
+                        bClippedOut = true;
+                        break;
                     }
+
                     poDstGeometry = poClipped;
                 }
 
-                OGRCoordinateTransformation* const poCT = psInfo->m_apoCT[iGeom].get();
-                char** const papszTransformOptions = psInfo->m_aosTransformOptions[iGeom].List();
-
-                if( poCT != nullptr || papszTransformOptions != nullptr)
+                if( m_bMakeValid )
                 {
-                    OGRGeometry* poReprojectedGeom =
-                        OGRGeometryFactory::transformWithOptions(
-                            poDstGeometry, poCT, papszTransformOptions, m_transformWithOptionsCache);
-                    if( poReprojectedGeom == nullptr )
+                    OGRGeometry* poValidGeom = poDstGeometry->MakeValid();
+                    delete poDstGeometry;
+                    poDstGeometry = poValidGeom;
+                    if( poDstGeometry == nullptr )
                     {
-                        if( psOptions->nGroupTransactions )
-                        {
-                            if( psOptions->nLayerTransaction )
-                            {
-                                if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
-                                    !psOptions->bSkipFailures )
-                                {
-                                    OGRFeature::DestroyFeature( poFeature );
-                                    OGRFeature::DestroyFeature( poDstFeature );
-                                    delete poDstGeometry;
-                                    return false;
-                                }
-                            }
-                        }
-
-                        CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
-                                  poFeature->GetFID() );
-                        if( !psOptions->bSkipFailures )
-                        {
-                            OGRFeature::DestroyFeature( poFeature );
-                            OGRFeature::DestroyFeature( poDstFeature );
-                            delete poDstGeometry;
-                            return false;
-                        }
+                        bClippedOut = true;
+                        break;
                     }
-
+                    OGRGeometry* poCleanedGeom =
+                        OGRGeometryFactory::removeLowerDimensionSubGeoms(poDstGeometry);
                     delete poDstGeometry;
-                    poDstGeometry = poReprojectedGeom;
+                    poDstGeometry = poCleanedGeom;
                 }
-                else if (poOutputSRS != nullptr)
+
+                if( eGType != GEOMTYPE_UNCHANGED )
                 {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
+                    poDstGeometry = OGRGeometryFactory::forceTo(
+                            poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
                 }
-
-                if( poDstGeometry != nullptr )
+                else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
+                        m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
+                        m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR ||
+                        m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
                 {
-                    if (m_poClipDst)
-                    {
-                        OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
-                        delete poDstGeometry;
-                        if (poClipped == nullptr || poClipped->IsEmpty())
-                        {
-                            delete poClipped;
-                            goto end_loop;
-                        }
-
-                        poDstGeometry = poClipped;
-                    }
+                    OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
+                    eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
+                    poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+                }
+            }
 
-                    if( m_bMakeValid )
-                    {
-                        OGRGeometry* poValidGeom = poDstGeometry->MakeValid();
-                        delete poDstGeometry;
-                        poDstGeometry = poValidGeom;
-                        if( poDstGeometry == nullptr )
-                            goto end_loop;
-                        OGRGeometry* poCleanedGeom =
-                            OGRGeometryFactory::removeLowerDimensionSubGeoms(poDstGeometry);
-                        delete poDstGeometry;
-                        poDstGeometry = poCleanedGeom;
-                    }
+            poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+        }
+        if( bClippedOut )
+            continue;
 
-                    if( eGType != GEOMTYPE_UNCHANGED )
-                    {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                                poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
-                    }
-                    else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
-                            m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
-                            m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR ||
-                            m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
+        if( !psInfo->m_oMapResolved.empty() )
+        {
+            for( const auto& kv: psInfo->m_oMapResolved )
+            {
+                const int nDstField = kv.first;
+                const int nSrcField = kv.second.nSrcField;
+                if( poFeature->IsFieldSetAndNotNull(nSrcField) )
+                {
+                    const auto poDomain = kv.second.poDomain;
+                    const auto oIterDomain = psInfo->m_oMapDomainToKV.find(poDomain);
+                    if( oIterDomain == psInfo->m_oMapDomainToKV.end() )
+                        continue;
+                    const auto& oMapKV = oIterDomain->second;
+                    const auto iter = oMapKV.find(
+                        poFeature->GetFieldAsString(nSrcField));
+                    if( iter != oMapKV.end() )
                     {
-                        OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
-                        eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
-                        poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+                        poDstFeature->SetField(nDstField, iter->second.c_str());
                     }
                 }
+            }
+        }
+
+        oPart.poDstFeature = std::move(poDstFeature);
+    }
+}
+
+/************************************************************************/
+/*              LayerTranslator::WriteTranslatedFeature()               */
+/*                                                                      */
+/*      Write the parts built by TranslateFeature() into the target     */
+/*      layer, managing transactions. Returns false if the              */
+/*      translation must be aborted.                                    */
+/************************************************************************/
+
+bool LayerTranslator::WriteTranslatedFeature( OGRFeature* poFeature,
+                                              std::vector<TranslatedFeaturePart>& aoParts,
+                                              TargetLayerInfo* psInfo,
+                                              GIntBig& nTotalEventsDone,
+                                              int& nFeaturesInTransaction,
+                                              GIntBig& nFeaturesWritten,
+                                              GDALVectorTranslateOptions *psOptions )
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    const bool bPreserveFID = psInfo->m_bPreserveFID;
 
-                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+    for( auto& oPart: aoParts )
+    {
+        if( psOptions->nLayerTransaction &&
+            ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+        {
+            if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
+                poDstLayer->StartTransaction() == OGRERR_FAILURE )
+            {
+                return false;
             }
+            nFeaturesInTransaction = 0;
+        }
+        else if( !psOptions->nLayerTransaction &&
+                 psOptions->nGroupTransactions >= 0 &&
+                 ++nTotalEventsDone >= psOptions->nGroupTransactions )
+        {
+            if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
+                    m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
+            {
+                return false;
+            }
+            nTotalEventsDone = 0;
+        }
 
-            if( !psInfo->m_oMapResolved.empty() )
+        if( oPart.bSetFromFailed )
+        {
+            if( psOptions->nGroupTransactions )
             {
-                for( const auto& kv: psInfo->m_oMapResolved )
+                if( psOptions->nLayerTransaction )
                 {
-                    const int nDstField = kv.first;
-                    const int nSrcField = kv.second.nSrcField;
-                    if( poFeature->IsFieldSetAndNotNull(nSrcField) )
+                    if( poDstLayer->CommitTransaction() != OGRERR_NONE )
                     {
-                        const auto poDomain = kv.second.poDomain;
-                        const auto& oMapKV = psInfo->m_oMapDomainToKV[poDomain];
-                        const auto iter = oMapKV.find(
-                            poFeature->GetFieldAsString(nSrcField));
-                        if( iter != oMapKV.end() )
-                        {
-                            poDstFeature->SetField(nDstField, iter->second.c_str());
-                        }
+                        return false;
                     }
                 }
             }
 
-            CPLErrorReset();
-            if( poDstLayer->CreateFeature( poDstFeature ) == OGRERR_NONE )
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
+                    poFeature->GetFID(), poSrcLayer->GetName() );
+            return false;
+        }
+
+        for( int i = 0; i < oPart.nReprojectionFailures; i++ )
+        {
+            if( psOptions->nGroupTransactions )
             {
-                nFeaturesWritten ++;
-                if( (bPreserveFID && poDstFeature->GetFID() != poFeature->GetFID()) ||
-                    (!bPreserveFID && psInfo->m_iSrcFIDField >= 0 && poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField) &&
-                     poDstFeature->GetFID() != poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField)) )
+                if( psOptions->nLayerTransaction )
                 {
-                    CPLError( CE_Warning, CPLE_AppDefined,
-                              "Feature id not preserved");
+                    if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
+                        !psOptions->bSkipFailures )
+                    {
+                        return false;
+                    }
                 }
             }
-            else if( !psOptions->bSkipFailures )
+
+            CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
+                      poFeature->GetFID() );
+            if( !psOptions->bSkipFailures )
             {
-                if( psOptions->nGroupTransactions )
-                {
-                    if( psOptions->nLayerTransaction )
-                        poDstLayer->RollbackTransaction();
-                }
+                return false;
+            }
+        }
 
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
+        OGRFeature* poDstFeature = oPart.poDstFeature.get();
+        if( poDstFeature == nullptr )
+            continue;
 
-                OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
-                return false;
+        CPLErrorReset();
+        if( poDstLayer->CreateFeature( poDstFeature ) == OGRERR_NONE )
+        {
+            nFeaturesWritten ++;
+            if( (bPreserveFID && poDstFeature->GetFID() != poFeature->GetFID()) ||
+                (!bPreserveFID && psInfo->m_iSrcFIDField >= 0 && poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField) &&
+                 poDstFeature->GetFID() != poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField)) )
+            {
+                CPLError( CE_Warning, CPLE_AppDefined,
+                          "Feature id not preserved");
             }
-            else
+        }
+        else if( !psOptions->bSkipFailures )
+        {
+            if( psOptions->nGroupTransactions )
             {
-                CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
-                           poFeature->GetFID(), poSrcLayer->GetName() );
-                if( psOptions->nGroupTransactions )
+                if( psOptions->nLayerTransaction )
+                    poDstLayer->RollbackTransaction();
+            }
+
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
+                    poFeature->GetFID(), poSrcLayer->GetName() );
+            return false;
+        }
+        else
+        {
+            CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
+                       poFeature->GetFID(), poSrcLayer->GetName() );
+            if( psOptions->nGroupTransactions )
+            {
+                if( psOptions->nLayerTransaction )
                 {
-                    if( psOptions->nLayerTransaction )
-                    {
-                        poDstLayer->RollbackTransaction();
-                        CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
-                    }
-                    else
-                    {
-                        m_poODS->RollbackTransaction();
-                        m_poODS->StartTransaction(psOptions->bForceTransaction);
-                    }
+                    poDstLayer->RollbackTransaction();
+                    CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
+                }
+                else
+                {
+                    m_poODS->RollbackTransaction();
+                    m_poODS->StartTransaction(psOptions->bForceTransaction);
                 }
             }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        TranslationPipeline                           */
+/*                                                                      */
+/*      State shared by the stages of LayerTranslator::                 */
+/*      TranslatePipelined(): a reader, worker threads that build the   */
+/*      target features of batches of source features, and the          */
+/*      calling thread that writes them in source order.                */
+/*                                                                      */
+/*      Errors emitted by the reader and the workers are collected per  */
+/*      feature and re-emitted by the calling thread before writing     */
+/*      the feature, so that they reach its error handlers in order.    */
+/************************************************************************/
+
+namespace {
+
+typedef std::vector<CPLErrorHandlerAccumulatorStruct> CollectedErrors;
+
+void ReEmitErrors(const CollectedErrors& aoErrors)
+{
+    for( const auto& oError: aoErrors )
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+}
+
+struct TranslationWorkerContext
+{
+    std::vector<std::unique_ptr<OGRCoordinateTransformation>> apoCTOwned{};
+    std::vector<OGRCoordinateTransformation*> apoCT{};
+    OGRGeometryFactory::TransformWithOptionsCache oCache{};
+};
+
+struct TranslationPipeline;
+
+struct TranslationBatch
+{
+    TranslationPipeline* poPipeline = nullptr;
+    std::vector<OGRFeature*> apoSrcFeatures{};
+    std::vector<std::vector<TranslatedFeaturePart>> aaoParts{};
+    // Errors emitted while reading and translating each source feature.
+    std::vector<CollectedErrors> aaoErrors{};
+    bool bDone = false;
+
+    TranslationBatch() = default;
+    TranslationBatch(const TranslationBatch&) = delete;
+    TranslationBatch& operator=(const TranslationBatch&) = delete;
+
+    ~TranslationBatch()
+    {
+        for( OGRFeature* poFeature: apoSrcFeatures )
+            OGRFeature::DestroyFeature(poFeature);
+    }
+};
+
+struct TranslationPipeline
+{
+    const LayerTranslator* poTranslator = nullptr;
+    TargetLayerInfo* psInfo = nullptr;
+    OGRFeatureDefn* poDstDefn = nullptr;
+    OGRSpatialReference* poOutputSRS = nullptr;
+    const GDALVectorTranslateOptions* psOptions = nullptr;
+    size_t nBatchSize = 0;
+    size_t nMaxBatches = 0;
+
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    // Batches in source order. Protected by oMutex.
+    std::deque<std::unique_ptr<TranslationBatch>> apoBatches{};
+    // Contexts not in use by a worker. Protected by oMutex.
+    std::vector<std::unique_ptr<TranslationWorkerContext>> apoFreeContexts{};
+    bool bReaderFinished = false;
+    bool bStop = false;
+    bool bReadError = false;
+    // Errors emitted when reaching the end of the source layer.
+    // Protected by oMutex.
+    CollectedErrors aoEndOfReadErrors{};
+    OGRFeature* poFirstFeature = nullptr;
+
+    std::unique_ptr<TranslationWorkerContext> CreateContext();
+    bool ReadBatch();
+    void ReaderLoop();
+    static void ReaderThreadFunc(void* pData);
+    static void TranslateBatchFunc(void* pData);
+};
+
+/************************************************************************/
+/*                           CreateContext()                            */
+/************************************************************************/
 
-end_loop:
-            OGRFeature::DestroyFeature( poDstFeature );
+// Must be called with oMutex held, as cloning uses the transformations of
+// psInfo.
+std::unique_ptr<TranslationWorkerContext> TranslationPipeline::CreateContext()
+{
+    std::unique_ptr<TranslationWorkerContext> poContext(
+        new TranslationWorkerContext());
+    for( const auto& poCT: psInfo->m_apoCT )
+    {
+        OGRCoordinateTransformation* poClone = nullptr;
+        if( poCT )
+        {
+            poClone = poCT->Clone();
+            if( poClone == nullptr )
+                return nullptr;
         }
+        poContext->apoCTOwned.emplace_back(poClone);
+        poContext->apoCT.push_back(poClone);
+    }
+    return poContext;
+}
 
-        OGRFeature::DestroyFeature( poFeature );
+/************************************************************************/
+/*                             ReadBatch()                              */
+/*                                                                      */
+/*      Read the next batch of source features and queue its            */
+/*      translation. Returns false when there is nothing more to read.  */
+/************************************************************************/
 
-        /* Report progress */
-        nCount ++;
-        bool bGoOn = true;
-        if (pfnProgress)
+bool TranslationPipeline::ReadBatch()
+{
+    OGRLayer* poSrcLayer = psInfo->m_poSrcLayer;
+    const GIntBig nLimit = poTranslator->m_nLimit;
+
+    std::unique_ptr<TranslationBatch> poBatch(new TranslationBatch());
+    poBatch->poPipeline = this;
+    if( poFirstFeature )
+    {
+        poBatch->apoSrcFeatures.push_back(poFirstFeature);
+        poBatch->aaoErrors.emplace_back();
+        poFirstFeature = nullptr;
+    }
+
+    bool bEOF = false;
+    while( poBatch->apoSrcFeatures.size() < nBatchSize )
+    {
+        if( nLimit >= 0 && psInfo->m_nFeaturesRead >= nLimit )
         {
-            bGoOn = pfnProgress(nCountLayerFeatures ? nCount * 1.0 / nCountLayerFeatures: 1.0, "", pProgressArg) != FALSE;
+            bEOF = true;
+            break;
         }
-        if( !bGoOn )
+        CollectedErrors aoErrors;
+        CPLErrorReset();
+        CPLInstallErrorHandlerAccumulator(aoErrors);
+        OGRFeature* poFeature = poSrcLayer->GetNextFeature();
+        CPLUninstallErrorHandlerAccumulator();
+        if( poFeature == nullptr )
         {
-            bRet = false;
+            if( CPLGetLastErrorType() == CE_Failure )
+                bReadError = true;
+            std::lock_guard<std::mutex> oLock(oMutex);
+            aoEndOfReadErrors.insert(aoEndOfReadErrors.end(),
+                                     aoErrors.begin(), aoErrors.end());
+            bEOF = true;
             break;
         }
+        psInfo->m_nFeaturesRead ++;
+        poBatch->apoSrcFeatures.push_back(poFeature);
+        poBatch->aaoErrors.emplace_back(std::move(aoErrors));
+    }
 
-        if (pnReadFeatureCount)
-            *pnReadFeatureCount = nCount;
+    if( !poBatch->apoSrcFeatures.empty() )
+    {
+        TranslationBatch* poBatchRaw = poBatch.get();
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            apoBatches.push_back(std::move(poBatch));
+        }
+        if( !poJobQueue->SubmitJob(TranslateBatchFunc, poBatchRaw) )
+            TranslateBatchFunc(poBatchRaw);
+    }
+    return !bEOF;
+}
 
-        if( psOptions->nFIDToFetch != OGRNullFID )
-            break;
-        if( poFeatureIn != nullptr )
+/************************************************************************/
+/*                             ReaderLoop()                             */
+/************************************************************************/
+
+void TranslationPipeline::ReaderLoop()
+{
+    while( true )
+    {
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [this] {
+                return bStop || apoBatches.size() < nMaxBatches; });
+            if( bStop )
+                break;
+        }
+        if( !ReadBatch() )
             break;
     }
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        bReaderFinished = true;
+    }
+    oCV.notify_all();
+}
 
-    if( psOptions->nGroupTransactions )
+void TranslationPipeline::ReaderThreadFunc(void* pData)
+{
+    static_cast<TranslationPipeline*>(pData)->ReaderLoop();
+}
+
+/************************************************************************/
+/*                         TranslateBatchFunc()                         */
+/************************************************************************/
+
+void TranslationPipeline::TranslateBatchFunc(void* pData)
+{
+    TranslationBatch* poBatch = static_cast<TranslationBatch*>(pData);
+    TranslationPipeline* poPipeline = poBatch->poPipeline;
+
+    std::unique_ptr<TranslationWorkerContext> poContext;
     {
-        if( psOptions->nLayerTransaction )
+        std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+        if( !poPipeline->apoFreeContexts.empty() )
         {
-            if( poDstLayer->CommitTransaction() != OGRERR_NONE )
+            poContext = std::move(poPipeline->apoFreeContexts.back());
+            poPipeline->apoFreeContexts.pop_back();
+        }
+        else
+        {
+            // Cannot fail: the first context has been successfully created.
+            poContext = poPipeline->CreateContext();
+        }
+    }
+
+    poBatch->aaoParts.resize(poBatch->apoSrcFeatures.size());
+    for( size_t i = 0; poContext && i < poBatch->apoSrcFeatures.size(); i++ )
+    {
+        CPLInstallErrorHandlerAccumulator(poBatch->aaoErrors[i]);
+        poPipeline->poTranslator->TranslateFeature(
+            poBatch->apoSrcFeatures[i], poPipeline->psInfo,
+            poPipeline->poDstDefn, poPipeline->poOutputSRS,
+            poContext->apoCT, poContext->oCache, poPipeline->psOptions,
+            poBatch->aaoParts[i]);
+        CPLUninstallErrorHandlerAccumulator();
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+        if( poContext )
+            poPipeline->apoFreeContexts.push_back(std::move(poContext));
+        poBatch->bDone = true;
+    }
+    poPipeline->oCV.notify_all();
+}
+
+} // namespace
+
+/************************************************************************/
+/*                 LayerTranslator::TranslatePipelined()                */
+/*                                                                      */
+/*      Translate poFirstFeature and the remaining features of the      */
+/*      source layer with a pipeline: a reader stage (in its own        */
+/*      thread, unless the source and target datasets are the same),   */
+/*      worker threads building the target features and the calling    */
+/*      thread writing them in source order, so that the target layer   */
+/*      is only accessed from a single thread.                          */
+/*                                                                      */
+/*      Returns -1 if the pipeline cannot be used (poFirstFeature is    */
+/*      then left to the caller), 0 if the translation must be          */
+/*      aborted, and 1 when done, with bRet set to false if reading     */
+/*      failed or was interrupted.                                      */
+/************************************************************************/
+
+int LayerTranslator::TranslatePipelined( OGRFeature* poFirstFeature,
+                                         TargetLayerInfo* psInfo,
+                                         OGRSpatialReference* poOutputSRS,
+                                         GIntBig nCountLayerFeatures,
+                                         GIntBig* pnReadFeatureCount,
+                                         GIntBig& nTotalEventsDone,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressArg,
+                                         GDALVectorTranslateOptions *psOptions,
+                                         int& nFeaturesInTransaction,
+                                         GIntBig& nCount,
+                                         GIntBig& nFeaturesWritten,
+                                         bool& bRet )
+{
+    CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(m_nNumThreads);
+    if( poThreadPool == nullptr )
+        return -1;
+
+    TranslationPipeline oPipeline;
+    oPipeline.poTranslator = this;
+    oPipeline.psInfo = psInfo;
+    oPipeline.poDstDefn = psInfo->m_poDstLayer->GetLayerDefn();
+    oPipeline.poOutputSRS = poOutputSRS;
+    oPipeline.psOptions = psOptions;
+    oPipeline.nBatchSize = 64;
+    oPipeline.nMaxBatches = 4 * static_cast<size_t>(m_nNumThreads);
+    oPipeline.poJobQueue = poThreadPool->CreateJobQueue();
+
+    auto poContext = oPipeline.CreateContext();
+    if( poContext == nullptr )
+    {
+        CPLDebug("GDALVectorTranslate",
+                 "Cannot clone coordinate transformation. "
+                 "Translating layer %s in a single thread",
+                 psInfo->m_poSrcLayer->GetName());
+        return -1;
+    }
+    oPipeline.apoFreeContexts.push_back(std::move(poContext));
+    oPipeline.poFirstFeature = poFirstFeature;
+
+    // Reading from another thread than the one writing would not be safe
+    // if the source and target datasets are the same.
+    CPLJoinableThread* hReaderThread = nullptr;
+    if( m_poSrcDS != m_poODS )
+    {
+        hReaderThread = CPLCreateJoinableThread(
+            TranslationPipeline::ReaderThreadFunc, &oPipeline);
+    }
+    int nRet = 1;
+    while( true )
+    {
+        if( hReaderThread == nullptr )
+        {
+            while( !oPipeline.bReaderFinished &&
+                   oPipeline.apoBatches.size() < oPipeline.nMaxBatches )
+            {
+                if( !oPipeline.ReadBatch() )
+                    oPipeline.bReaderFinished = true;
+            }
+        }
+
+        std::unique_ptr<TranslationBatch> poBatch;
+        {
+            std::unique_lock<std::mutex> oLock(oPipeline.oMutex);
+            oPipeline.oCV.wait(oLock, [&oPipeline] {
+                return oPipeline.apoBatches.empty() ?
+                            oPipeline.bReaderFinished :
+                            oPipeline.apoBatches.front()->bDone; });
+            if( oPipeline.apoBatches.empty() )
+                break;
+            poBatch = std::move(oPipeline.apoBatches.front());
+            oPipeline.apoBatches.pop_front();
+        }
+        // Wake up the reader now that there is room for another batch.
+        oPipeline.oCV.notify_all();
+
+        bool bGoOn = true;
+        for( size_t i = 0; bGoOn && i < poBatch->apoSrcFeatures.size(); i++ )
+        {
+            OGRFeature* poFeature = poBatch->apoSrcFeatures[i];
+            ReEmitErrors(poBatch->aaoErrors[i]);
+            if( !WriteTranslatedFeature(poFeature, poBatch->aaoParts[i], psInfo,
+                                        nTotalEventsDone,
+                                        nFeaturesInTransaction,
+                                        nFeaturesWritten, psOptions) )
+            {
+                nRet = 0;
+                bGoOn = false;
+                break;
+            }
+
+            /* Report progress */
+            nCount ++;
+            if (pfnProgress)
+            {
+                bGoOn = pfnProgress(nCountLayerFeatures ? nCount * 1.0 / nCountLayerFeatures: 1.0, "", pProgressArg) != FALSE;
+            }
+            if( !bGoOn )
+            {
                 bRet = false;
+                break;
+            }
+
+            if (pnReadFeatureCount)
+                *pnReadFeatureCount = nCount;
         }
+        if( !bGoOn )
+            break;
     }
 
-    if( poFeatureIn == nullptr )
     {
-        CPLDebug("GDALVectorTranslate", CPL_FRMT_GIB " features written in layer '%s'",
-                nFeaturesWritten, poDstLayer->GetName());
+        std::lock_guard<std::mutex> oLock(oPipeline.oMutex);
+        oPipeline.bStop = true;
     }
+    oPipeline.oCV.notify_all();
+    if( hReaderThread )
+        CPLJoinThread(hReaderThread);
+    oPipeline.poJobQueue->WaitCompletion();
+    OGRFeature::DestroyFeature(oPipeline.poFirstFeature);
+    if( nRet == 1 && bRet )
+        ReEmitErrors(oPipeline.aoEndOfReadErrors);
 
-    return bRet;
+    if( oPipeline.bReadError )
+        bRet = false;
+
+    return nRet;
 }
 
 /************************************************************************/
@@ -5239,6 +5781,7 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
     psOptions->hSpatialFilter = nullptr;
     psOptions->bNativeData = true;
     psOptions->nLimit = -1;
+    psOptions->nNumThreads = 1;
 
     int nArgc = CSLCount(papszArgv);
     for( int i = 0; papszArgv != nullptr && i < nArgc; i++ )
@@ -5868,6 +6411,22 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
         {
             psOptions->nLimit = CPLAtoGIntBig( papszArgv[++i] );
         }
+        else if( i+1 < nArgc && EQUAL(papszArgv[i],"-num_threads") )
+        {
+            const char* pszNumThreads = papszArgv[++i];
+            if( EQUAL(pszNumThreads, "ALL_CPUS") )
+                psOptions->nNumThreads = CPLGetNumCPUs();
+            else if( CPLGetValueType(pszNumThreads) == CPL_VALUE_INTEGER )
+                psOptions->nNumThreads =
+                    std::max(1, std::min(128, atoi(pszNumThreads)));
+            else
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -num_threads: %s", pszNumThreads);
+                GDALVectorTranslateOptionsFree(psOptions);
+                return nullptr;
+            }
+        }
         else if( papszArgv[i][0] == '-' )
         {
             CPLError(CE_Failure, CPLE_NotSupported,
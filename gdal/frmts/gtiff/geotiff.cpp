@@ -316,6 +316,7 @@ private:
     CPLVirtualMem        *m_psVirtualMemIOMapping = nullptr;
     std::unique_ptr<CPLJobQueue> m_poCompressQueue{};
     CPLMutex             *m_hCompressThreadPoolMutex = nullptr;
+    std::vector<TIFF*>    m_ahDecompressTIFF{}; // Child handles used by MultiThreadedRead()
 
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>> m_oCacheStrileToOffsetByteCount{1024};
@@ -370,6 +371,9 @@ private:
 
     signed char m_nHasOptimizedReadMultiRange = -1;
 
+    // Number of threads for block decompression in MultiThreadedRead().
+    int         m_nDecompressThreads = 0;
+
     signed char m_nZLevel = -1;
     signed char m_nLZMAPreset = -1;
     signed char m_nZSTDLevel = -1;
@@ -399,6 +403,7 @@ private:
     bool        m_bStreamingOut:1;
     bool        m_bScanDeferred:1;
     bool        m_bSingleIFDOpened = false;
+    bool        m_bMultiThreadedReadCompatible = false;
     bool        m_bLoadedBlockDirty:1;
     bool        m_bWriteError:1;
     bool        m_bLookedForProjection:1;
@@ -515,6 +520,14 @@ private:
                                         GPtrDiff_t nCompressedBufferSize );
     bool           SubmitCompressionJob( int nStripOrTile, GByte* pabyData,
                                          GPtrDiff_t cc, int nHeight) ;
+    void           InitDecompressionThreads( char** papszOptions );
+    int            GetDecompressThreadCount() const;
+    static void    ThreadDecompressionFunc( void* pData );
+    int            MultiThreadedRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                                      void * pData, GDALDataType eBufType,
+                                      int nBandCount, const int *panBandMap,
+                                      GSpacing nPixelSpace, GSpacing nLineSpace,
+                                      GSpacing nBandSpace );
 
     int            GuessJPEGQuality( bool& bOutHasQuantizationTable,
                                      bool& bOutHasHuffmanTable );
@@ -598,6 +611,11 @@ private:
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GSpacing nBandSpace,
                               GDALRasterIOExtraArg* psExtraArg ) override;
+    virtual CPLErr AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               int nBandCount, int *panBandMap,
+                               char **papszOptions ) override;
     virtual char **GetFileList() override;
 
     virtual CPLErr IBuildOverviews( const char *, int, int *, int, int *,
@@ -1232,6 +1250,10 @@ public:
                               GDALDataType eBufType,
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GDALRasterIOExtraArg* psExtraArg ) override final;
+    virtual CPLErr AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               char **papszOptions ) override;
 
     virtual const char *GetDescription() const override final;
     virtual void        SetDescription( const char * ) override final;
@@ -2219,6 +2241,16 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
             return static_cast<CPLErr>(nErr);
     }
 
+    if( eRWFlag == GF_Read &&
+        nXSize == nBufXSize && nYSize == nBufYSize )
+    {
+        const int nErr = MultiThreadedRead(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType,
+            nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace );
+        if( nErr >= 0 )
+            return static_cast<CPLErr>(nErr);
+    }
+
     void* pBufferedData = nullptr;
     if( eAccess == GA_ReadOnly &&
         eRWFlag == GF_Read &&
@@ -2251,6 +2283,153 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+CPLErr GTiffDataset::AdviseRead( int nXOff, int nYOff,
+                                 int nXSize, int nYSize,
+                                 int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType,
+                                 int nBandCount, int *panBandMap,
+                                 char **papszOptions )
+{
+    int bStopProcessing = FALSE;
+    const CPLErr eErr = ValidateRasterIOOrAdviseReadParameters(
+        "AdviseRead()", &bStopProcessing, nXOff, nYOff, nXSize, nYSize,
+        nBufXSize, nBufYSize, nBandCount, panBandMap);
+    if( eErr != CE_None || bStopProcessing )
+        return eErr;
+
+    // Prefetching is only worth it on file systems where issuing a request
+    // has a significant latency.
+    if( eAccess != GA_ReadOnly || m_bStreamingIn || nBandCount == 0 ||
+        m_bTreatAsSplit || m_bTreatAsSplitBitmap ||
+        !HasOptimizedReadMultiRange() )
+    {
+        return CE_None;
+    }
+
+    // Redirect the request to the overview that RasterIO() would use.
+    if( nBufXSize < nXSize && nBufYSize < nYSize )
+    {
+        int nXOffMod = nXOff;
+        int nYOffMod = nYOff;
+        int nXSizeMod = nXSize;
+        int nYSizeMod = nYSize;
+        GDALRasterBand* poFirstBand = GetRasterBand(
+            panBandMap ? panBandMap[0] : 1);
+        ++m_nJPEGOverviewVisibilityCounter;
+        const int iOvrLevel = GDALBandGetBestOverviewLevel2(
+            poFirstBand, nXOffMod, nYOffMod, nXSizeMod, nYSizeMod,
+            nBufXSize, nBufYSize, nullptr );
+        GDALRasterBand* poOvrBand =
+            iOvrLevel >= 0 ? poFirstBand->GetOverview(iOvrLevel) : nullptr;
+        --m_nJPEGOverviewVisibilityCounter;
+        GDALDataset* poOvrDS =
+            poOvrBand ? poOvrBand->GetDataset() : nullptr;
+        if( poOvrDS != nullptr && poOvrDS != this )
+        {
+            if( poOvrDS->GetRasterCount() != nBands )
+                return CE_None;
+            return poOvrDS->AdviseRead( nXOffMod, nYOffMod,
+                                        nXSizeMod, nYSizeMod,
+                                        nBufXSize, nBufYSize, eBufType,
+                                        nBandCount, panBandMap,
+                                        papszOptions );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Collect the byte ranges of the blocks intersecting the window   */
+/*      that are not already in the block cache.                        */
+/* -------------------------------------------------------------------- */
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
+    const int nBandIters =
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBandCount : 1;
+
+    std::vector< std::pair<vsi_l_offset, size_t> > aOffsetSize;
+    for( int iBand = 0; iBand < nBandIters; ++iBand )
+    {
+        const int nBand = panBandMap ? panBandMap[iBand] : iBand + 1;
+        GTiffRasterBand* poBand =
+            cpl::down_cast<GTiffRasterBand*>(GetRasterBand(nBand));
+        int nBandBlockXSize = 0;
+        int nBandBlockYSize = 0;
+        poBand->GetBlockSize(&nBandBlockXSize, &nBandBlockYSize);
+        const bool bSameBlocking = nBandBlockXSize == m_nBlockXSize &&
+                                   nBandBlockYSize == m_nBlockYSize;
+        for( int iY = nBlockY1; iY <= nBlockY2; ++iY )
+        {
+            for( int iX = nBlockX1; iX <= nBlockX2; ++iX )
+            {
+                if( bSameBlocking )
+                {
+                    GDALRasterBlock* poBlock =
+                        poBand->TryGetLockedBlockRef(iX, iY);
+                    if( poBlock != nullptr )
+                    {
+                        poBlock->DropLock();
+                        continue;
+                    }
+                }
+                int nBlockId = iX + iY * nBlocksPerRow;
+                if( m_nPlanarConfig == PLANARCONFIG_SEPARATE )
+                    nBlockId += (nBand - 1) * m_nBlocksPerBand;
+                vsi_l_offset nOffset = 0;
+                vsi_l_offset nSize = 0;
+                if( IsBlockAvailable(nBlockId, &nOffset, &nSize) &&
+                    nSize > 0 &&
+                    static_cast<size_t>(nSize) == nSize )
+                {
+                    aOffsetSize.push_back(
+                        std::pair<vsi_l_offset, size_t>(
+                            nOffset, static_cast<size_t>(nSize)));
+                }
+            }
+        }
+    }
+    if( aOffsetSize.empty() )
+        return CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Merge contiguous or overlapping ranges, and hand them over to   */
+/*      the file system.                                                */
+/* -------------------------------------------------------------------- */
+    std::sort(aOffsetSize.begin(), aOffsetSize.end());
+
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    anOffsets.push_back(aOffsetSize[0].first);
+    anSizes.push_back(aOffsetSize[0].second);
+    for( size_t i = 1; i < aOffsetSize.size(); ++i )
+    {
+        const vsi_l_offset nCurEnd = anOffsets.back() + anSizes.back();
+        if( aOffsetSize[i].first <= nCurEnd )
+        {
+            const vsi_l_offset nNewEnd =
+                aOffsetSize[i].first + aOffsetSize[i].second;
+            if( nNewEnd > nCurEnd )
+                anSizes.back() += static_cast<size_t>(nNewEnd - nCurEnd);
+        }
+        else
+        {
+            anOffsets.push_back(aOffsetSize[i].first);
+            anSizes.push_back(aOffsetSize[i].second);
+        }
+    }
+
+    VSIFAdviseReadL( static_cast<int>(anOffsets.size()),
+                     anOffsets.data(), anSizes.data(),
+                     VSI_TIFFGetVSILFile(TIFFClientdata( m_hTIFF )) );
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                        FetchBufferVirtualMemIO                       */
 /************************************************************************/
@@ -4564,6 +4743,16 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
             return static_cast<CPLErr>(nErr);
     }
 
+    if( eRWFlag == GF_Read &&
+        nXSize == nBufXSize && nYSize == nBufYSize )
+    {
+        const int nErr = m_poGDS->MultiThreadedRead(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType,
+            1, &nBand, nPixelSpace, nLineSpace, 0 );
+        if( nErr >= 0 )
+            return static_cast<CPLErr>(nErr);
+    }
+
     void* pBufferedData = nullptr;
     if( m_poGDS->eAccess == GA_ReadOnly &&
         eRWFlag == GF_Read &&
@@ -4637,6 +4826,21 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::AdviseRead( int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    int nBufXSize, int nBufYSize,
+                                    GDALDataType eBufType,
+                                    char **papszOptions )
+{
+    return m_poGDS->AdviseRead( nXOff, nYOff, nXSize, nYSize,
+                                nBufXSize, nBufYSize, eBufType,
+                                1, &nBand, papszOptions );
+}
+
 /************************************************************************/
 /*                       IGetDataCoverageStatus()                       */
 /************************************************************************/
@@ -4789,6 +4993,535 @@ bool GTiffDataset::ReadStrile(int nBlockId,
     return true;
 }
 
+/************************************************************************/
+/*                      ThreadDecompressionFunc()                       */
+/************************************************************************/
+
+#if !defined(__MINGW32__)
+namespace {
+#endif
+struct GTiffDecompressionContext
+{
+    CPLMutex           *hMutex = nullptr;
+    CPLCond            *hCond = nullptr;  // Signaled when a handle is freed
+    std::vector<TIFF*>  ahFreeTIFF{};     // Handles not used by a job
+    bool                bSuccess = true;
+    int                 nFailedBlockId = -1;
+    bool                bKeepDecoded = false; // To fill the block cache
+
+    GTiffDataset       *poDS = nullptr;
+    GDALDataType        eDT = GDT_Unknown;
+    int                 nDTSize = 0;
+    bool                bSeparate = false;
+    bool                bIgnoreReadErrors = false;
+    GPtrDiff_t          nBlockBufSize = 0;
+
+    // Description of the target window and buffer
+    int                 nXOff = 0;
+    int                 nYOff = 0;
+    int                 nXSize = 0;
+    int                 nYSize = 0;
+    GByte              *pabyData = nullptr;
+    GDALDataType        eBufType = GDT_Unknown;
+    int                 nBandCount = 0;
+    const int          *panBandMap = nullptr;
+    GSpacing            nPixelSpace = 0;
+    GSpacing            nLineSpace = 0;
+    GSpacing            nBandSpace = 0;
+};
+
+struct GTiffDecompressionJob
+{
+    GTiffDecompressionContext *psContext = nullptr;
+    int                 nBlockId = -1;
+    int                 nXBlock = 0;
+    int                 nYBlock = 0;
+    int                 iBand = -1; // Index in panBandMap, or -1 for all bands
+    vsi_l_offset        nOffset = 0;
+    size_t              nSize = 0;
+    GPtrDiff_t          nBlockReqSize = 0;
+    GByte              *pabyCompressedData = nullptr;
+    GByte              *pabyDecoded = nullptr; // If bKeepDecoded
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
+/************************************************************************/
+/*                       GTiffCopyBlockWindow()                         */
+/*                                                                      */
+/*      Copy the intersection of a decoded block with the requested     */
+/*      window, for the iBand-th requested band. pabyBlock points to    */
+/*      the first sample of that band, with nSrcPixelSpace bytes        */
+/*      between pixels.                                                 */
+/************************************************************************/
+
+static void GTiffCopyBlockWindow( const GTiffDecompressionContext* psContext,
+                                  const GTiffDecompressionJob* psJob,
+                                  int nBlockXSize, int nBlockYSize,
+                                  int iBand, const GByte* pabyBlock,
+                                  int nSrcPixelSpace )
+{
+    const int nXStart = std::max(psContext->nXOff,
+                                 psJob->nXBlock * nBlockXSize);
+    const int nXEnd = static_cast<int>(std::min(
+        static_cast<GIntBig>(psContext->nXOff) + psContext->nXSize,
+        static_cast<GIntBig>(psJob->nXBlock + 1) * nBlockXSize));
+    const int nYStart = std::max(psContext->nYOff,
+                                 psJob->nYBlock * nBlockYSize);
+    const int nYEnd = static_cast<int>(std::min(
+        static_cast<GIntBig>(psContext->nYOff) + psContext->nYSize,
+        static_cast<GIntBig>(psJob->nYBlock + 1) * nBlockYSize));
+
+    for( int iY = nYStart; iY < nYEnd; ++iY )
+    {
+        const GByte* pabySrc = pabyBlock +
+            (static_cast<GPtrDiff_t>(iY - psJob->nYBlock * nBlockYSize) *
+                nBlockXSize +
+             (nXStart - psJob->nXBlock * nBlockXSize)) * nSrcPixelSpace;
+        GByte* pabyDst = psContext->pabyData +
+            (iY - psContext->nYOff) * psContext->nLineSpace +
+            (nXStart - psContext->nXOff) * psContext->nPixelSpace +
+            iBand * psContext->nBandSpace;
+        GDALCopyWords64( pabySrc, psContext->eDT, nSrcPixelSpace,
+                         pabyDst, psContext->eBufType,
+                         static_cast<int>(psContext->nPixelSpace),
+                         nXEnd - nXStart );
+    }
+}
+#if !defined(__MINGW32__)
+}
+#endif
+
+void GTiffDataset::ThreadDecompressionFunc( void* pData )
+{
+    GTiffDecompressionJob* psJob = static_cast<GTiffDecompressionJob*>(pData);
+    GTiffDecompressionContext* psContext = psJob->psContext;
+    GTiffDataset* poDS = psContext->poDS;
+
+    // Errors are re-emitted by the calling thread of MultiThreadedRead().
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+
+    // Wait for a free handle: there may be less handles than threads if
+    // the pool has grown since they were created.
+    TIFF* hTIFF = nullptr;
+    {
+        CPLMutexHolderD(&psContext->hMutex);
+        while( psContext->bSuccess && psContext->ahFreeTIFF.empty() )
+            CPLCondWait(psContext->hCond, psContext->hMutex);
+        if( psContext->bSuccess )
+        {
+            hTIFF = psContext->ahFreeTIFF.back();
+            psContext->ahFreeTIFF.pop_back();
+        }
+    }
+    if( hTIFF == nullptr )
+    {
+        CPLUninstallErrorHandlerAccumulator();
+        return;
+    }
+
+    GByte* pabyDecoded = static_cast<GByte*>(
+        VSI_MALLOC_VERBOSE(psContext->nBlockBufSize));
+    bool bOK = pabyDecoded != nullptr;
+    if( bOK )
+    {
+        if( psJob->nBlockReqSize < psContext->nBlockBufSize )
+            memset( pabyDecoded, 0, psContext->nBlockBufSize );
+        if( !TIFFReadFromUserBuffer( hTIFF, psJob->nBlockId,
+                                     psJob->pabyCompressedData,
+                                     psJob->nSize,
+                                     pabyDecoded, psJob->nBlockReqSize ) &&
+            !psContext->bIgnoreReadErrors )
+        {
+            bOK = false;
+        }
+    }
+
+    {
+        CPLMutexHolderD(&psContext->hMutex);
+        psContext->ahFreeTIFF.push_back(hTIFF);
+        if( !bOK )
+        {
+            psContext->bSuccess = false;
+            psContext->nFailedBlockId = psJob->nBlockId;
+        }
+        CPLCondBroadcast(psContext->hCond);
+    }
+
+    if( bOK )
+    {
+        // Jobs write to disjoint areas of the output buffer.
+        const int nSrcBands = psContext->bSeparate ? 1 : poDS->nBands;
+        const int nSrcPixelSpace = nSrcBands * psContext->nDTSize;
+        const int iBandStart = psJob->iBand >= 0 ? psJob->iBand : 0;
+        const int iBandEnd = psJob->iBand >= 0 ? psJob->iBand + 1 :
+                                                 psContext->nBandCount;
+        for( int iBand = iBandStart; iBand < iBandEnd; ++iBand )
+        {
+            const int nSrcBandOffset = psContext->bSeparate ? 0 :
+                (psContext->panBandMap[iBand] - 1) * psContext->nDTSize;
+            GTiffCopyBlockWindow( psContext, psJob,
+                                  poDS->m_nBlockXSize, poDS->m_nBlockYSize,
+                                  iBand, pabyDecoded + nSrcBandOffset,
+                                  nSrcPixelSpace );
+        }
+    }
+
+    if( bOK && psContext->bKeepDecoded )
+        psJob->pabyDecoded = pabyDecoded;
+    else
+        VSIFree(pabyDecoded);
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                         MultiThreadedRead()                          */
+/************************************************************************/
+
+// Read a non-resampled window, by fetching the raw striles it intersects in
+// one go and decompressing them in parallel on the global thread pool.
+// Returns -1 if the request is not eligible, in which case the caller must
+// go through the regular block based path.
+int GTiffDataset::MultiThreadedRead( int nXOff, int nYOff,
+                                     int nXSize, int nYSize,
+                                     void * pData, GDALDataType eBufType,
+                                     int nBandCount, const int *panBandMap,
+                                     GSpacing nPixelSpace, GSpacing nLineSpace,
+                                     GSpacing nBandSpace )
+{
+    const int nThreads = GetDecompressThreadCount();
+    if( nThreads <= 1 ||
+        !m_bMultiThreadedReadCompatible ||
+        eAccess != GA_ReadOnly ||
+        m_bStreamingIn ||
+        m_nCompression == COMPRESSION_NONE ||
+        m_nCompression == COMPRESSION_OJPEG )
+    {
+        return -1;
+    }
+
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    if( m_nBitsPerSample != GDALGetDataTypeSizeBits(eDT) )
+        return -1;
+
+    const bool bSeparate = m_nPlanarConfig == PLANARCONFIG_SEPARATE;
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const GIntBig nJobCount =
+        static_cast<GIntBig>(nBlockX2 - nBlockX1 + 1) *
+        (nBlockY2 - nBlockY1 + 1) * (bSeparate ? nBandCount : 1);
+    if( nJobCount < 2 || nJobCount > INT_MAX )
+        return -1;
+
+    CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if( poThreadPool == nullptr )
+        return -1;
+
+    const GPtrDiff_t nBlockBufSize = TIFFIsTiled(m_hTIFF) ?
+        static_cast<GPtrDiff_t>(TIFFTileSize(m_hTIFF)) :
+        static_cast<GPtrDiff_t>(TIFFStripSize(m_hTIFF));
+    if( nBlockBufSize == 0 )
+        return -1;
+    // Bound the size of a compressed strile we are ready to ingest, to
+    // avoid huge allocations on corrupted files. Bigger striles go through
+    // the regular path.
+    const vsi_l_offset nMaxStrileSize =
+        static_cast<vsi_l_offset>(nBlockBufSize) * 2 + 1024 * 1024;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the striles to decode. Sparse ones are handled by the   */
+/*      regular path, which knows how to fill them with nodata.         */
+/* -------------------------------------------------------------------- */
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
+    std::vector<GTiffDecompressionJob> asJobs;
+    asJobs.reserve(static_cast<size_t>(nJobCount));
+    for( int iYBlock = nBlockY1; iYBlock <= nBlockY2; ++iYBlock )
+    {
+        // The bottom most partial tiles and strips are sometimes only
+        // partially encoded. (#1179)
+        GPtrDiff_t nBlockReqSize = nBlockBufSize;
+        if( iYBlock * m_nBlockYSize > nRasterYSize - m_nBlockYSize )
+        {
+            nBlockReqSize = (nBlockBufSize / m_nBlockYSize)
+                * (m_nBlockYSize - static_cast<int>(
+                    (static_cast<GIntBig>(iYBlock + 1) * m_nBlockYSize)
+                        % nRasterYSize));
+        }
+
+        for( int iXBlock = nBlockX1; iXBlock <= nBlockX2; ++iXBlock )
+        {
+            for( int iBand = 0; iBand < (bSeparate ? nBandCount : 1); ++iBand )
+            {
+                GTiffDecompressionJob sJob;
+                sJob.nBlockId = iXBlock + iYBlock * nBlocksPerRow;
+                if( bSeparate )
+                {
+                    sJob.nBlockId +=
+                        (panBandMap[iBand] - 1) * m_nBlocksPerBand;
+                    sJob.iBand = iBand;
+                }
+                sJob.nXBlock = iXBlock;
+                sJob.nYBlock = iYBlock;
+                sJob.nBlockReqSize = nBlockReqSize;
+
+                vsi_l_offset nSize = 0;
+                if( !IsBlockAvailable(sJob.nBlockId, &sJob.nOffset, &nSize) ||
+                    nSize == 0 || nSize > nMaxStrileSize )
+                {
+                    return -1;
+                }
+                sJob.nSize = static_cast<size_t>(nSize);
+                asJobs.push_back(sJob);
+            }
+        }
+    }
+
+    GTiffDecompressionContext sContext;
+    sContext.poDS = this;
+    sContext.eDT = eDT;
+    sContext.nDTSize = nDTSize;
+    sContext.bSeparate = bSeparate;
+    sContext.bIgnoreReadErrors = m_bIgnoreReadErrors;
+    sContext.nBlockBufSize = nBlockBufSize;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pabyData = static_cast<GByte*>(pData);
+    sContext.eBufType = eBufType;
+    sContext.nBandCount = nBandCount;
+    sContext.panBandMap = panBandMap;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.nBandSpace = nBandSpace;
+
+/* -------------------------------------------------------------------- */
+/*      Striles whose blocks are all in the block cache are copied      */
+/*      from it.                                                        */
+/* -------------------------------------------------------------------- */
+    const auto CopyFromCache = [this, &sContext, nBandCount, panBandMap,
+                                nDTSize](const GTiffDecompressionJob& sJob)
+    {
+        const int iBandStart = sJob.iBand >= 0 ? sJob.iBand : 0;
+        const int iBandEnd = sJob.iBand >= 0 ? sJob.iBand + 1 : nBandCount;
+        std::vector<GDALRasterBlock*> apoBlocks;
+        for( int iBand = iBandStart; iBand < iBandEnd; ++iBand )
+        {
+            GDALRasterBlock* poBlock =
+                cpl::down_cast<GTiffRasterBand *>(
+                    GetRasterBand(panBandMap[iBand]))->TryGetLockedBlockRef(
+                        sJob.nXBlock, sJob.nYBlock);
+            if( poBlock == nullptr )
+                break;
+            apoBlocks.push_back(poBlock);
+        }
+        const bool bAllCached =
+            static_cast<int>(apoBlocks.size()) == iBandEnd - iBandStart;
+        for( size_t i = 0; i < apoBlocks.size(); ++i )
+        {
+            if( bAllCached )
+            {
+                GTiffCopyBlockWindow(
+                    &sContext, &sJob, m_nBlockXSize, m_nBlockYSize,
+                    iBandStart + static_cast<int>(i),
+                    static_cast<const GByte*>(apoBlocks[i]->GetDataRef()),
+                    nDTSize );
+            }
+            apoBlocks[i]->DropLock();
+        }
+        return bAllCached;
+    };
+
+    {
+        std::vector<GTiffDecompressionJob> asJobsToDecode;
+        for( const auto& sJob: asJobs )
+        {
+            if( !CopyFromCache(sJob) )
+                asJobsToDecode.push_back(sJob);
+        }
+        asJobs = std::move(asJobsToDecode);
+    }
+    if( asJobs.empty() )
+        return static_cast<int>(CE_None);
+
+    // Decoded striles are inserted in the block cache, as IReadBlock()
+    // would do, so that per-band or per-scanline requests do not decode
+    // them again, unless they would evict most of its content.
+    sContext.bKeepDecoded =
+        static_cast<GIntBig>(asJobs.size()) * nBlockBufSize <=
+            GDALGetCacheMax64() / 4;
+
+    const auto CacheDecodedBlock = [this, bSeparate, panBandMap, eDT,
+                                    nDTSize](const GTiffDecompressionJob& sJob)
+    {
+        const int nSrcPixelSpace = (bSeparate ? 1 : nBands) * nDTSize;
+        const int nBandStart = bSeparate ? panBandMap[sJob.iBand] : 1;
+        const int nBandEnd = bSeparate ? nBandStart : nBands;
+        for( int nBandIdx = nBandStart; nBandIdx <= nBandEnd; ++nBandIdx )
+        {
+            GTiffRasterBand* poBand =
+                cpl::down_cast<GTiffRasterBand *>(GetRasterBand(nBandIdx));
+            GDALRasterBlock* poBlock =
+                poBand->TryGetLockedBlockRef(sJob.nXBlock, sJob.nYBlock);
+            if( poBlock == nullptr )
+            {
+                poBlock = poBand->GetLockedBlockRef(sJob.nXBlock,
+                                                    sJob.nYBlock, TRUE);
+                if( poBlock == nullptr )
+                    continue;
+                GDALCopyWords64(
+                    sJob.pabyDecoded +
+                        (bSeparate ? 0 : (nBandIdx - 1) * nDTSize),
+                    eDT, nSrcPixelSpace,
+                    poBlock->GetDataRef(), eDT, nDTSize,
+                    static_cast<GPtrDiff_t>(m_nBlockXSize) * m_nBlockYSize );
+            }
+            poBlock->DropLock();
+        }
+    };
+
+/* -------------------------------------------------------------------- */
+/*      Create as many child TIFF handles as needed. This must be done  */
+/*      from this thread, as it involves I/O on the shared file handle. */
+/*      Jobs may run concurrently in all the threads of the pool and in */
+/*      this thread while it waits for their completion. If the pool    */
+/*      grows meanwhile, jobs wait for a handle to be freed.            */
+/* -------------------------------------------------------------------- */
+    const int nHandles = static_cast<int>(
+        std::min(static_cast<GIntBig>(poThreadPool->GetThreadCount()) + 1,
+                 static_cast<GIntBig>(asJobs.size())));
+    while( static_cast<int>(m_ahDecompressTIFF.size()) < nHandles )
+    {
+        TIFF* hTIFF = VSI_TIFFOpenChild(m_hTIFF);
+        if( hTIFF == nullptr )
+            break;
+        if( !TIFFSetSubDirectory(hTIFF, m_nDirOffset) )
+        {
+            XTIFFClose(hTIFF);
+            break;
+        }
+        RestoreVolatileParameters(hTIFF);
+        m_ahDecompressTIFF.push_back(hTIFF);
+    }
+    if( m_ahDecompressTIFF.empty() )
+        return -1;
+
+    sContext.ahFreeTIFF = m_ahDecompressTIFF;
+    sContext.hMutex = CPLCreateMutex();
+    CPLReleaseMutex(sContext.hMutex);
+    sContext.hCond = CPLCreateCond();
+
+    auto poQueue = poThreadPool->CreateJobQueue();
+    VSILFILE* fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+
+/* -------------------------------------------------------------------- */
+/*      Process the jobs by batches, so as to bound the memory used     */
+/*      for compressed data. Within a batch, the raw striles are read   */
+/*      in a single multi-range request, sorted by increasing offset.   */
+/* -------------------------------------------------------------------- */
+    constexpr size_t MAX_BATCH_COMPRESSED_SIZE = 100 * 1024 * 1024;
+    CPLErr eErr = CE_None;
+    std::vector<GByte> abyCompressedData;
+    size_t iJob = 0;
+    while( iJob < asJobs.size() && eErr == CE_None )
+    {
+        size_t nBatchSize = 0;
+        size_t iJobEnd = iJob;
+        while( iJobEnd < asJobs.size() &&
+               (iJobEnd == iJob ||
+                nBatchSize + asJobs[iJobEnd].nSize <= MAX_BATCH_COMPRESSED_SIZE) )
+        {
+            nBatchSize += asJobs[iJobEnd].nSize;
+            ++iJobEnd;
+        }
+
+        std::vector<GTiffDecompressionJob*> apsBatch;
+        for( size_t i = iJob; i < iJobEnd; ++i )
+            apsBatch.push_back(&asJobs[i]);
+        std::sort(apsBatch.begin(), apsBatch.end(),
+                  [](const GTiffDecompressionJob* a,
+                     const GTiffDecompressionJob* b)
+                  { return a->nOffset < b->nOffset; });
+
+        try
+        {
+            abyCompressedData.resize(nBatchSize);
+        }
+        catch( const std::exception& )
+        {
+            ReportError(CE_Failure, CPLE_OutOfMemory,
+                        "Cannot allocate %u bytes",
+                        static_cast<unsigned>(nBatchSize));
+            eErr = CE_Failure;
+            break;
+        }
+
+        std::vector<void*> apData;
+        std::vector<vsi_l_offset> anOffsets;
+        std::vector<size_t> anSizes;
+        size_t nBufOffset = 0;
+        for( auto psJob: apsBatch )
+        {
+            psJob->psContext = &sContext;
+            psJob->pabyCompressedData = abyCompressedData.data() + nBufOffset;
+            nBufOffset += psJob->nSize;
+            apData.push_back(psJob->pabyCompressedData);
+            anOffsets.push_back(psJob->nOffset);
+            anSizes.push_back(psJob->nSize);
+        }
+        if( VSIFReadMultiRangeL( static_cast<int>(apData.size()),
+                                 apData.data(), anOffsets.data(),
+                                 anSizes.data(), fp ) != 0 )
+        {
+            ReportError(CE_Failure, CPLE_FileIO,
+                        "Cannot read strile data");
+            eErr = CE_Failure;
+            break;
+        }
+
+        for( auto psJob: apsBatch )
+            poQueue->SubmitJob(ThreadDecompressionFunc, psJob);
+        poQueue->WaitCompletion();
+
+        for( size_t i = iJob; i < iJobEnd; ++i )
+        {
+            auto& sJob = asJobs[i];
+            for( const auto& oError: sJob.aoErrors )
+            {
+                ReportError( oError.type, oError.no, "%s",
+                             oError.msg.c_str() );
+            }
+            sJob.aoErrors.clear();
+            if( sJob.pabyDecoded )
+            {
+                if( sContext.bSuccess )
+                    CacheDecodedBlock(sJob);
+                VSIFree(sJob.pabyDecoded);
+                sJob.pabyDecoded = nullptr;
+            }
+        }
+
+        if( !sContext.bSuccess )
+        {
+            ReportError( CE_Failure, CPLE_AppDefined,
+                         "Decompression of %s %d failed.",
+                         TIFFIsTiled(m_hTIFF) ? "tile" : "strip",
+                         sContext.nFailedBlockId );
+            eErr = CE_Failure;
+        }
+
+        iJob = iJobEnd;
+    }
+
+    CPLDestroyCond(sContext.hCond);
+    CPLDestroyMutex(sContext.hMutex);
+
+    return static_cast<int>(eErr);
+}
+
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -7883,6 +8616,12 @@ int GTiffDataset::Finalize()
         delete m_poColorTable;
     m_poColorTable = nullptr;
 
+    // Child handles used for multi-threaded decompression must be closed
+    // before their parent.
+    for( TIFF* hTIFF: m_ahDecompressTIFF )
+        XTIFFClose( hTIFF );
+    m_ahDecompressTIFF.clear();
+
     if( m_hTIFF )
     {
         XTIFFClose( m_hTIFF );
@@ -8887,6 +9626,55 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
     }
 }
 
+/************************************************************************/
+/*                      InitDecompressionThreads()                      */
+/************************************************************************/
+
+void GTiffDataset::InitDecompressionThreads( char** papszOptions )
+{
+    const char* pszValue = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
+    if( pszValue == nullptr )
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if( pszValue == nullptr )
+        return;
+
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if( nThreads > 1024 )
+        nThreads = 1024; // to please Coverity
+    if( nThreads > 1 )
+    {
+        if( m_nCompression == COMPRESSION_NONE )
+        {
+            CPLDebug( "GTiff",
+                      "NUM_THREADS ignored with uncompressed" );
+        }
+        else
+        {
+            m_nDecompressThreads = nThreads;
+        }
+    }
+    else if( nThreads < 0 ||
+             (!EQUAL(pszValue, "0") &&
+              !EQUAL(pszValue, "1") &&
+              !EQUAL(pszValue, "ALL_CPUS")) )
+    {
+        ReportError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for NUM_THREADS: %s", pszValue);
+    }
+}
+
+/************************************************************************/
+/*                     GetDecompressThreadCount()                       */
+/************************************************************************/
+
+int GTiffDataset::GetDecompressThreadCount() const
+{
+    // Overviews and masks inherit the setting of the main dataset.
+    return m_poBaseDS ? m_poBaseDS->m_nDecompressThreads :
+                        m_nDecompressThreads;
+}
+
 /************************************************************************/
 /*                       GetGTIFFKeysFlavor()                           */
 /************************************************************************/
@@ -12739,6 +13527,10 @@ GDALDataset *GTiffDataset::Open( GDALOpenInfo * poOpenInfo )
     {
         poDS->InitCreationOrOpenOptions(poOpenInfo->papszOpenOptions);
     }
+    else
+    {
+        poDS->InitDecompressionThreads(poOpenInfo->papszOpenOptions);
+    }
 
     poDS->m_bLoadPam = true;
     poDS->m_bColorProfileMetadataChanged = false;
@@ -14220,6 +15012,12 @@ CPLErr GTiffDataset::OpenOffset( TIFF *hTIFFIn,
             SetBand( iBand + 1, new GTiffRasterBand( this, iBand + 1 ) );
     }
 
+    // Only plain GTiffRasterBand whose in-memory representation matches the
+    // one of the decoded striles can go through MultiThreadedRead().
+    m_bMultiThreadedReadCompatible =
+        !bTreatAsRGBA && !m_bTreatAsSplitBitmap && !m_bTreatAsSplit &&
+        !bTreatAsBitmap && !bTreatAsOdd;
+
     if( GetRasterBand(1)->GetRasterDataType() == GDT_Unknown )
     {
         ReportError(CE_Failure, CPLE_NotSupported,
@@ -20283,7 +21081,7 @@ void GDALRegister_GTiff()
     poDriver->SetMetadataItem( GDAL_DMD_CREATIONOPTIONLIST, osOptions );
     poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST,
 "<OpenOptionList>"
-"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression. Can be set to ALL_CPUS' default='1'/>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression (update mode) or decompression (read-only mode). Can be set to ALL_CPUS' default='1'/>"
 "   <Option name='GEOTIFF_KEYS_FLAVOR' type='string-select' default='STANDARD' description='Which flavor of GeoTIFF keys must be used (for writing)'>"
 "       <Value>STANDARD</Value>"
 "       <Value>ESRI_PE</Value>"
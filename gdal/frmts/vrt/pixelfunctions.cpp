@@ -27,7 +27,14 @@
  * DEALINGS IN THE SOFTWARE.
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cpl_mem_cache.h"
 #include "gdal.h"
 #include "vrtdataset.h"
 
@@ -873,6 +880,893 @@ static CPLErr dB2PowPixelFunc( void **papoSources, int nSources, void *pData,
                               nPixelSpace, nLineSpace, 10.0, 10.0);
 }  // dB2PowPixelFunc
 
+/************************************************************************/
+/* ==================================================================== */
+/*                        Expression pixel function                     */
+/* ==================================================================== */
+/************************************************************************/
+
+// The expression is parsed once into a tree, which is then compiled into a
+// sequence of instructions operating on registers. A register is a vector
+// of VRT_EXPR_CHUNK_SIZE doubles, so that each instruction is applied to a
+// whole run of pixels in a tight loop, rather than interpreting the
+// expression for each pixel.
+
+constexpr int VRT_EXPR_CHUNK_SIZE = 1024;
+
+namespace {
+
+typedef enum
+{
+    VRT_EXPR_SOURCE,
+    VRT_EXPR_CONSTANT,
+    VRT_EXPR_NEG,
+    VRT_EXPR_NOT,
+    VRT_EXPR_ADD,
+    VRT_EXPR_SUB,
+    VRT_EXPR_MUL,
+    VRT_EXPR_DIV,
+    VRT_EXPR_MOD,
+    VRT_EXPR_POW,
+    VRT_EXPR_LT,
+    VRT_EXPR_LE,
+    VRT_EXPR_GT,
+    VRT_EXPR_GE,
+    VRT_EXPR_EQ,
+    VRT_EXPR_NE,
+    VRT_EXPR_AND,
+    VRT_EXPR_OR,
+    VRT_EXPR_SELECT,
+    VRT_EXPR_ABS,
+    VRT_EXPR_SQRT,
+    VRT_EXPR_EXP,
+    VRT_EXPR_LOG,
+    VRT_EXPR_LOG10,
+    VRT_EXPR_SIN,
+    VRT_EXPR_COS,
+    VRT_EXPR_TAN,
+    VRT_EXPR_ASIN,
+    VRT_EXPR_ACOS,
+    VRT_EXPR_ATAN,
+    VRT_EXPR_FLOOR,
+    VRT_EXPR_CEIL,
+    VRT_EXPR_ROUND,
+    VRT_EXPR_ISNAN,
+    VRT_EXPR_ATAN2,
+    VRT_EXPR_MIN,
+    VRT_EXPR_MAX,
+} VRTExprOp;
+
+struct VRTExprFunction
+{
+    const char *pszName;
+    VRTExprOp   eOp;
+    int         nArgs;
+};
+
+const VRTExprFunction asVRTExprFunctions[] =
+{
+    { "abs", VRT_EXPR_ABS, 1 },
+    { "sqrt", VRT_EXPR_SQRT, 1 },
+    { "exp", VRT_EXPR_EXP, 1 },
+    { "log", VRT_EXPR_LOG, 1 },
+    { "log10", VRT_EXPR_LOG10, 1 },
+    { "sin", VRT_EXPR_SIN, 1 },
+    { "cos", VRT_EXPR_COS, 1 },
+    { "tan", VRT_EXPR_TAN, 1 },
+    { "asin", VRT_EXPR_ASIN, 1 },
+    { "acos", VRT_EXPR_ACOS, 1 },
+    { "atan", VRT_EXPR_ATAN, 1 },
+    { "floor", VRT_EXPR_FLOOR, 1 },
+    { "ceil", VRT_EXPR_CEIL, 1 },
+    { "round", VRT_EXPR_ROUND, 1 },
+    { "isnan", VRT_EXPR_ISNAN, 1 },
+    { "atan2", VRT_EXPR_ATAN2, 2 },
+    { "min", VRT_EXPR_MIN, 2 },
+    { "max", VRT_EXPR_MAX, 2 },
+    { "pow", VRT_EXPR_POW, 2 },
+    { "fmod", VRT_EXPR_MOD, 2 },
+};
+
+/************************************************************************/
+/*                            VRTExprNode                               */
+/************************************************************************/
+
+struct VRTExprNode
+{
+    VRTExprOp   eOp = VRT_EXPR_CONSTANT;
+    double      dfValue = 0.0;  // VRT_EXPR_CONSTANT
+    int         nSource = 0;    // VRT_EXPR_SOURCE, 0-based
+    int         nDepth = 1;     // Depth of the sub-tree rooted at this node
+    std::vector<std::unique_ptr<VRTExprNode>> apoArgs{};
+};
+
+/************************************************************************/
+/*                           VRTExprParser                              */
+/************************************************************************/
+
+// Recursive descent parser of the grammar:
+//   expr     := or [ '?' expr ':' expr ]
+//   or       := and { '||' and }
+//   and      := equality { '&&' equality }
+//   equality := relation { ('==' | '!=') relation }
+//   relation := sum { ('<' | '<=' | '>' | '>=') sum }
+//   sum      := product { ('+' | '-') product }
+//   product  := unary { ('*' | '/' | '%') unary }
+//   unary    := ('-' | '+' | '!') unary | power
+//   power    := primary [ '^' unary ]
+//   primary  := number | 'B'n | function '(' expr { ',' expr } ')' |
+//               '(' expr ')'
+// As expressions come from untrusted VRT content, the nesting depth of the
+// recursion, and the depth of the resulting tree (which is later walked
+// recursively), are limited.
+class VRTExprParser
+{
+    CPL_DISALLOW_COPY_ASSIGN(VRTExprParser)
+
+    static constexpr int MAX_NESTING_DEPTH = 100;
+    static constexpr int MAX_TREE_DEPTH = 1000;
+
+    const char *m_pszStart;
+    const char *m_psz;
+    int         m_nSources;
+    int         m_nNestingDepth = 0;
+    CPLString   m_osError{};
+
+    // Increments the nesting depth for its lifetime.
+    struct NestingGuard
+    {
+        CPL_DISALLOW_COPY_ASSIGN(NestingGuard)
+
+        int& m_nDepth;
+        explicit NestingGuard( int& nDepth ) : m_nDepth(nDepth) { ++m_nDepth; }
+        ~NestingGuard() { --m_nDepth; }
+    };
+
+    void SkipSpaces()
+    {
+        while( *m_psz == ' ' || *m_psz == '\t' ||
+               *m_psz == '\n' || *m_psz == '\r' )
+            ++m_psz;
+    }
+
+    bool Accept( const char *pszToken )
+    {
+        SkipSpaces();
+        const size_t nLen = strlen(pszToken);
+        if( strncmp(m_psz, pszToken, nLen) != 0 )
+            return false;
+        // Do not take '<' for the start of '<=', etc.
+        if( nLen == 1 && (pszToken[0] == '<' || pszToken[0] == '>' ||
+                          pszToken[0] == '=' || pszToken[0] == '!') &&
+            m_psz[1] == '=' )
+            return false;
+        m_psz += nLen;
+        return true;
+    }
+
+    std::unique_ptr<VRTExprNode> Error( const char *pszMsg )
+    {
+        if( m_osError.empty() )
+            m_osError.Printf("%s at position %d",
+                             pszMsg, static_cast<int>(m_psz - m_pszStart));
+        return nullptr;
+    }
+
+    // Sets the depth of poNode from its arguments. Returns nullptr with an
+    // error if it is too deep.
+    std::unique_ptr<VRTExprNode> CheckDepth(
+                                std::unique_ptr<VRTExprNode>&& poNode )
+    {
+        for( const auto& poArg: poNode->apoArgs )
+            poNode->nDepth = std::max(poNode->nDepth, poArg->nDepth + 1);
+        if( poNode->nDepth > MAX_TREE_DEPTH )
+            return Error("Expression too complex");
+        return std::move(poNode);
+    }
+
+    std::unique_ptr<VRTExprNode> MakeNode(
+                                VRTExprOp eOp,
+                                std::unique_ptr<VRTExprNode>&& poArg1,
+                                std::unique_ptr<VRTExprNode>&& poArg2 = nullptr )
+    {
+        std::unique_ptr<VRTExprNode> poNode(new VRTExprNode());
+        poNode->eOp = eOp;
+        poNode->apoArgs.emplace_back(std::move(poArg1));
+        if( poArg2 )
+            poNode->apoArgs.emplace_back(std::move(poArg2));
+        return CheckDepth(std::move(poNode));
+    }
+
+    std::unique_ptr<VRTExprNode> ParseExpr();
+    std::unique_ptr<VRTExprNode> ParseOr();
+    std::unique_ptr<VRTExprNode> ParseAnd();
+    std::unique_ptr<VRTExprNode> ParseEquality();
+    std::unique_ptr<VRTExprNode> ParseRelation();
+    std::unique_ptr<VRTExprNode> ParseSum();
+    std::unique_ptr<VRTExprNode> ParseProduct();
+    std::unique_ptr<VRTExprNode> ParseUnary();
+    std::unique_ptr<VRTExprNode> ParsePower();
+    std::unique_ptr<VRTExprNode> ParsePrimary();
+
+  public:
+    VRTExprParser( const char *pszExpr, int nSources ) :
+        m_pszStart(pszExpr), m_psz(pszExpr), m_nSources(nSources) {}
+
+    std::unique_ptr<VRTExprNode> Parse()
+    {
+        auto poNode = ParseExpr();
+        SkipSpaces();
+        if( poNode && *m_psz != '\0' )
+            return Error("Unexpected character");
+        return poNode;
+    }
+
+    const CPLString& GetError() const { return m_osError; }
+};
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseExpr()
+{
+    NestingGuard oGuard(m_nNestingDepth);
+    if( m_nNestingDepth > MAX_NESTING_DEPTH )
+        return Error("Expression nested too deeply");
+    auto poNode = ParseOr();
+    if( poNode && Accept("?") )
+    {
+        auto poTrue = ParseExpr();
+        if( !poTrue )
+            return nullptr;
+        if( !Accept(":") )
+            return Error("':' expected");
+        auto poFalse = ParseExpr();
+        if( !poFalse )
+            return nullptr;
+        auto poSelect = MakeNode(VRT_EXPR_SELECT, std::move(poNode),
+                                 std::move(poTrue));
+        if( !poSelect )
+            return nullptr;
+        poSelect->apoArgs.emplace_back(std::move(poFalse));
+        return CheckDepth(std::move(poSelect));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseOr()
+{
+    auto poNode = ParseAnd();
+    while( poNode && Accept("||") )
+    {
+        auto poRight = ParseAnd();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(VRT_EXPR_OR, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseAnd()
+{
+    auto poNode = ParseEquality();
+    while( poNode && Accept("&&") )
+    {
+        auto poRight = ParseEquality();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(VRT_EXPR_AND, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseEquality()
+{
+    auto poNode = ParseRelation();
+    while( poNode )
+    {
+        VRTExprOp eOp;
+        if( Accept("==") )
+            eOp = VRT_EXPR_EQ;
+        else if( Accept("!=") )
+            eOp = VRT_EXPR_NE;
+        else
+            break;
+        auto poRight = ParseRelation();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseRelation()
+{
+    auto poNode = ParseSum();
+    while( poNode )
+    {
+        VRTExprOp eOp;
+        if( Accept("<=") )
+            eOp = VRT_EXPR_LE;
+        else if( Accept(">=") )
+            eOp = VRT_EXPR_GE;
+        else if( Accept("<") )
+            eOp = VRT_EXPR_LT;
+        else if( Accept(">") )
+            eOp = VRT_EXPR_GT;
+        else
+            break;
+        auto poRight = ParseSum();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseSum()
+{
+    auto poNode = ParseProduct();
+    while( poNode )
+    {
+        VRTExprOp eOp;
+        if( Accept("+") )
+            eOp = VRT_EXPR_ADD;
+        else if( Accept("-") )
+            eOp = VRT_EXPR_SUB;
+        else
+            break;
+        auto poRight = ParseProduct();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseProduct()
+{
+    auto poNode = ParseUnary();
+    while( poNode )
+    {
+        VRTExprOp eOp;
+        if( Accept("*") )
+            eOp = VRT_EXPR_MUL;
+        else if( Accept("/") )
+            eOp = VRT_EXPR_DIV;
+        else if( Accept("%") )
+            eOp = VRT_EXPR_MOD;
+        else
+            break;
+        auto poRight = ParseUnary();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParseUnary()
+{
+    NestingGuard oGuard(m_nNestingDepth);
+    if( m_nNestingDepth > MAX_NESTING_DEPTH )
+        return Error("Expression nested too deeply");
+    if( Accept("-") )
+    {
+        auto poArg = ParseUnary();
+        if( !poArg )
+            return nullptr;
+        return MakeNode(VRT_EXPR_NEG, std::move(poArg));
+    }
+    if( Accept("+") )
+        return ParseUnary();
+    if( Accept("!") )
+    {
+        auto poArg = ParseUnary();
+        if( !poArg )
+            return nullptr;
+        return MakeNode(VRT_EXPR_NOT, std::move(poArg));
+    }
+    return ParsePower();
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParsePower()
+{
+    auto poNode = ParsePrimary();
+    if( poNode && Accept("^") )
+    {
+        auto poRight = ParseUnary();
+        if( !poRight )
+            return nullptr;
+        poNode = MakeNode(VRT_EXPR_POW, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<VRTExprNode> VRTExprParser::ParsePrimary()
+{
+    SkipSpaces();
+    if( Accept("(") )
+    {
+        auto poNode = ParseExpr();
+        if( !poNode )
+            return nullptr;
+        if( !Accept(")") )
+            return Error("')' expected");
+        return poNode;
+    }
+
+    if( (*m_psz >= '0' && *m_psz <= '9') || *m_psz == '.' )
+    {
+        char *pszEnd = nullptr;
+        const double dfValue = CPLStrtod(m_psz, &pszEnd);
+        if( pszEnd == m_psz )
+            return Error("Invalid number");
+        m_psz = pszEnd;
+        std::unique_ptr<VRTExprNode> poNode(new VRTExprNode());
+        poNode->eOp = VRT_EXPR_CONSTANT;
+        poNode->dfValue = dfValue;
+        return poNode;
+    }
+
+    const char *pszIdentStart = m_psz;
+    while( (*m_psz >= 'a' && *m_psz <= 'z') ||
+           (*m_psz >= 'A' && *m_psz <= 'Z') ||
+           (*m_psz >= '0' && *m_psz <= '9') || *m_psz == '_' )
+    {
+        ++m_psz;
+    }
+    const std::string osIdent(pszIdentStart, m_psz - pszIdentStart);
+    if( osIdent.empty() )
+        return Error("Unexpected character");
+
+    if( (osIdent[0] == 'B' || osIdent[0] == 'b') && osIdent.size() > 1 &&
+        CPLGetValueType(osIdent.c_str() + 1) == CPL_VALUE_INTEGER )
+    {
+        const int nSource = atoi(osIdent.c_str() + 1);
+        if( nSource < 1 || nSource > m_nSources )
+        {
+            m_psz = pszIdentStart;
+            return Error(CPLSPrintf("Invalid source %s", osIdent.c_str()));
+        }
+        std::unique_ptr<VRTExprNode> poNode(new VRTExprNode());
+        poNode->eOp = VRT_EXPR_SOURCE;
+        poNode->nSource = nSource - 1;
+        return poNode;
+    }
+
+    if( osIdent == "pi" )
+    {
+        std::unique_ptr<VRTExprNode> poNode(new VRTExprNode());
+        poNode->eOp = VRT_EXPR_CONSTANT;
+        poNode->dfValue = M_PI;
+        return poNode;
+    }
+
+    for( const auto& sFunction: asVRTExprFunctions )
+    {
+        if( osIdent != sFunction.pszName )
+            continue;
+        if( !Accept("(") )
+            return Error("'(' expected");
+        std::unique_ptr<VRTExprNode> poNode(new VRTExprNode());
+        poNode->eOp = sFunction.eOp;
+        for( int i = 0; i < sFunction.nArgs; i++ )
+        {
+            if( i > 0 && !Accept(",") )
+                return Error("',' expected");
+            auto poArg = ParseExpr();
+            if( !poArg )
+                return nullptr;
+            poNode->apoArgs.emplace_back(std::move(poArg));
+        }
+        if( !Accept(")") )
+            return Error("')' expected");
+        return CheckDepth(std::move(poNode));
+    }
+
+    m_psz = pszIdentStart;
+    return Error(CPLSPrintf("Unknown identifier '%s'", osIdent.c_str()));
+}
+
+/************************************************************************/
+/*                            VRTExprProgram                            */
+/************************************************************************/
+
+struct VRTExprInstruction
+{
+    VRTExprOp eOp;
+    int       nDst;
+    int       nArg1;
+    int       nArg2;
+    int       nArg3;
+};
+
+// Registers [0, nSources[ hold the values of the sources, followed by the
+// registers of constants, initialized once per evaluation, and the
+// registers of temporary results.
+class VRTExprProgram
+{
+    int m_nSources = 0;
+    int m_nRegisters = 0;
+    std::vector<std::pair<int, double>> m_aoConstants{};
+    std::vector<VRTExprInstruction> m_asInstructions{};
+    std::vector<bool> m_abUsedSources{};
+    std::vector<int> m_anFreeRegisters{};
+    int m_nResultRegister = -1;
+
+    bool IsTemporary( int nRegister ) const
+    {
+        return nRegister >= m_nSources &&
+               std::find_if(m_aoConstants.begin(), m_aoConstants.end(),
+                            [nRegister](const std::pair<int, double>& oPair)
+                            { return oPair.first == nRegister; }) ==
+                    m_aoConstants.end();
+    }
+
+    int AllocRegister()
+    {
+        if( !m_anFreeRegisters.empty() )
+        {
+            const int nRegister = m_anFreeRegisters.back();
+            m_anFreeRegisters.pop_back();
+            return nRegister;
+        }
+        return m_nRegisters++;
+    }
+
+    void ReleaseRegister( int nRegister )
+    {
+        if( IsTemporary(nRegister) )
+            m_anFreeRegisters.push_back(nRegister);
+    }
+
+    static bool FoldConstant( VRTExprNode* poNode );
+    int Compile( const VRTExprNode* poNode );
+
+  public:
+    static std::unique_ptr<VRTExprProgram> Create( const char* pszExpr,
+                                                   int nSources );
+
+    int GetSourceCount() const { return m_nSources; }
+    int GetRegisterCount() const { return m_nRegisters; }
+    bool IsSourceUsed( int iSource ) const { return m_abUsedSources[iSource]; }
+
+    int Run( double** papdfRegisters, int nCount ) const;
+};
+
+// Evaluate in place the sub-expressions that only involve constants.
+bool VRTExprProgram::FoldConstant( VRTExprNode* poNode )
+{
+    bool bAllConstants = true;
+    for( auto& poArg: poNode->apoArgs )
+    {
+        if( !FoldConstant(poArg.get()) )
+            bAllConstants = false;
+    }
+    if( poNode->eOp == VRT_EXPR_SOURCE )
+        return false;
+    if( poNode->eOp == VRT_EXPR_CONSTANT )
+        return true;
+    if( !bAllConstants )
+        return false;
+
+    double adfRegisters[4] = { 0, 0, 0, 0 };
+    double* apdfRegisters[4] = { &adfRegisters[0], &adfRegisters[1],
+                                 &adfRegisters[2], &adfRegisters[3] };
+    VRTExprProgram oProgram;
+    oProgram.m_nRegisters = 4;
+    VRTExprInstruction sInstr = { poNode->eOp, 3, 0, 1, 2 };
+    for( size_t i = 0; i < poNode->apoArgs.size(); ++i )
+        adfRegisters[i] = poNode->apoArgs[i]->dfValue;
+    oProgram.m_asInstructions.push_back(sInstr);
+    oProgram.Run(apdfRegisters, 1);
+
+    poNode->eOp = VRT_EXPR_CONSTANT;
+    poNode->dfValue = adfRegisters[3];
+    poNode->apoArgs.clear();
+    return true;
+}
+
+int VRTExprProgram::Compile( const VRTExprNode* poNode )
+{
+    if( poNode->eOp == VRT_EXPR_SOURCE )
+    {
+        m_abUsedSources[poNode->nSource] = true;
+        return poNode->nSource;
+    }
+    if( poNode->eOp == VRT_EXPR_CONSTANT )
+    {
+        for( const auto& oPair: m_aoConstants )
+        {
+            if( oPair.second == poNode->dfValue )
+                return oPair.first;
+        }
+        const int nRegister = m_nRegisters++;
+        m_aoConstants.emplace_back(nRegister, poNode->dfValue);
+        return nRegister;
+    }
+
+    int anArgs[3] = { -1, -1, -1 };
+    for( size_t i = 0; i < poNode->apoArgs.size(); ++i )
+        anArgs[i] = Compile(poNode->apoArgs[i].get());
+    for( size_t i = 0; i < poNode->apoArgs.size(); ++i )
+        ReleaseRegister(anArgs[i]);
+    const int nDst = AllocRegister();
+    VRTExprInstruction sInstr = { poNode->eOp, nDst,
+                                  anArgs[0], anArgs[1], anArgs[2] };
+    m_asInstructions.push_back(sInstr);
+    return nDst;
+}
+
+std::unique_ptr<VRTExprProgram> VRTExprProgram::Create( const char* pszExpr,
+                                                        int nSources )
+{
+    VRTExprParser oParser(pszExpr, nSources);
+    auto poTree = oParser.Parse();
+    if( !poTree )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid expression '%s': %s",
+                 pszExpr, oParser.GetError().c_str());
+        return nullptr;
+    }
+    FoldConstant(poTree.get());
+
+    std::unique_ptr<VRTExprProgram> poProgram(new VRTExprProgram());
+    poProgram->m_nSources = nSources;
+    poProgram->m_nRegisters = nSources;
+    poProgram->m_abUsedSources.resize(nSources);
+    poProgram->m_nResultRegister = poProgram->Compile(poTree.get());
+    return poProgram;
+}
+
+/************************************************************************/
+/*                                 Run()                                */
+/************************************************************************/
+
+// Execute the program on nCount values. papdfRegisters must have
+// GetRegisterCount() entries, whose used sources are already filled.
+// Returns the register holding the result.
+int VRTExprProgram::Run( double** papdfRegisters, int nCount ) const
+{
+    for( const auto& oPair: m_aoConstants )
+    {
+        double* padfDst = papdfRegisters[oPair.first];
+        std::fill(padfDst, padfDst + nCount, oPair.second);
+    }
+
+#define VRT_EXPR_UNARY(expr) \
+    for( int i = 0; i < nCount; ++i ) \
+    { \
+        const double x = padfA[i]; \
+        padfDst[i] = (expr); \
+    } \
+    break
+
+#define VRT_EXPR_BINARY(expr) \
+    for( int i = 0; i < nCount; ++i ) \
+    { \
+        const double x = padfA[i]; \
+        const double y = padfB[i]; \
+        padfDst[i] = (expr); \
+    } \
+    break
+
+    for( const auto& sInstr: m_asInstructions )
+    {
+        double* padfDst = papdfRegisters[sInstr.nDst];
+        const double* padfA = papdfRegisters[sInstr.nArg1];
+        const double* padfB =
+            sInstr.nArg2 >= 0 ? papdfRegisters[sInstr.nArg2] : nullptr;
+        switch( sInstr.eOp )
+        {
+            case VRT_EXPR_SOURCE:
+            case VRT_EXPR_CONSTANT:
+                break;
+            case VRT_EXPR_NEG: VRT_EXPR_UNARY(-x);
+            case VRT_EXPR_NOT: VRT_EXPR_UNARY(x == 0.0 ? 1.0 : 0.0);
+            case VRT_EXPR_ADD: VRT_EXPR_BINARY(x + y);
+            case VRT_EXPR_SUB: VRT_EXPR_BINARY(x - y);
+            case VRT_EXPR_MUL: VRT_EXPR_BINARY(x * y);
+            case VRT_EXPR_DIV: VRT_EXPR_BINARY(x / y);
+            case VRT_EXPR_MOD: VRT_EXPR_BINARY(fmod(x, y));
+            case VRT_EXPR_POW: VRT_EXPR_BINARY(pow(x, y));
+            case VRT_EXPR_LT: VRT_EXPR_BINARY(x < y ? 1.0 : 0.0);
+            case VRT_EXPR_LE: VRT_EXPR_BINARY(x <= y ? 1.0 : 0.0);
+            case VRT_EXPR_GT: VRT_EXPR_BINARY(x > y ? 1.0 : 0.0);
+            case VRT_EXPR_GE: VRT_EXPR_BINARY(x >= y ? 1.0 : 0.0);
+            case VRT_EXPR_EQ: VRT_EXPR_BINARY(x == y ? 1.0 : 0.0);
+            case VRT_EXPR_NE: VRT_EXPR_BINARY(x != y ? 1.0 : 0.0);
+            case VRT_EXPR_AND:
+                VRT_EXPR_BINARY(x != 0.0 && y != 0.0 ? 1.0 : 0.0);
+            case VRT_EXPR_OR:
+                VRT_EXPR_BINARY(x != 0.0 || y != 0.0 ? 1.0 : 0.0);
+            case VRT_EXPR_SELECT:
+            {
+                const double* padfC = papdfRegisters[sInstr.nArg3];
+                for( int i = 0; i < nCount; ++i )
+                    padfDst[i] = padfA[i] != 0.0 ? padfB[i] : padfC[i];
+                break;
+            }
+            case VRT_EXPR_ABS: VRT_EXPR_UNARY(fabs(x));
+            case VRT_EXPR_SQRT: VRT_EXPR_UNARY(sqrt(x));
+            case VRT_EXPR_EXP: VRT_EXPR_UNARY(exp(x));
+            case VRT_EXPR_LOG: VRT_EXPR_UNARY(log(x));
+            case VRT_EXPR_LOG10: VRT_EXPR_UNARY(log10(x));
+            case VRT_EXPR_SIN: VRT_EXPR_UNARY(sin(x));
+            case VRT_EXPR_COS: VRT_EXPR_UNARY(cos(x));
+            case VRT_EXPR_TAN: VRT_EXPR_UNARY(tan(x));
+            case VRT_EXPR_ASIN: VRT_EXPR_UNARY(asin(x));
+            case VRT_EXPR_ACOS: VRT_EXPR_UNARY(acos(x));
+            case VRT_EXPR_ATAN: VRT_EXPR_UNARY(atan(x));
+            case VRT_EXPR_FLOOR: VRT_EXPR_UNARY(floor(x));
+            case VRT_EXPR_CEIL: VRT_EXPR_UNARY(ceil(x));
+            case VRT_EXPR_ROUND: VRT_EXPR_UNARY(std::round(x));
+            case VRT_EXPR_ISNAN: VRT_EXPR_UNARY(CPLIsNan(x) ? 1.0 : 0.0);
+            case VRT_EXPR_ATAN2: VRT_EXPR_BINARY(atan2(x, y));
+            case VRT_EXPR_MIN: VRT_EXPR_BINARY(std::min(x, y));
+            case VRT_EXPR_MAX: VRT_EXPR_BINARY(std::max(x, y));
+        }
+    }
+
+#undef VRT_EXPR_UNARY
+#undef VRT_EXPR_BINARY
+
+    return m_nResultRegister;
+}
+
+/************************************************************************/
+/*                        GetExprProgram()                              */
+/************************************************************************/
+
+// Compiled programs are cached, since the pixel function is called for
+// each block with the same expression.
+std::shared_ptr<VRTExprProgram> GetExprProgram( const char* pszExpr,
+                                                int nSources )
+{
+    static std::mutex oMutex;
+    static lru11::Cache<std::string, std::shared_ptr<VRTExprProgram>>
+                                                                oCache(64);
+    const std::string osKey(CPLSPrintf("%d:%s", nSources, pszExpr));
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    std::shared_ptr<VRTExprProgram> poProgram;
+    if( oCache.tryGet(osKey, poProgram) )
+        return poProgram;
+    poProgram = VRTExprProgram::Create(pszExpr, nSources);
+    if( poProgram )
+        oCache.insert(osKey, poProgram);
+    return poProgram;
+}
+
+} // namespace
+
+/************************************************************************/
+/*                            ExprPixelFunc()                           */
+/************************************************************************/
+
+static CPLErr ExprPixelFunc( void **papoSources, int nSources, void *pData,
+                             int nXSize, int nYSize,
+                             GDALDataType eSrcType, GDALDataType eBufType,
+                             int nPixelSpace, int nLineSpace,
+                             CSLConstList papszArgs )
+{
+    /* ---- Init ---- */
+    if( GDALDataTypeIsComplex( eSrcType ) )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "expression: complex source data types are not supported");
+        return CE_Failure;
+    }
+
+    const char* pszExpr = CSLFetchNameValue(papszArgs, "expression");
+    if( pszExpr == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression: missing 'expression' argument");
+        return CE_Failure;
+    }
+
+    auto poProgram = GetExprProgram(pszExpr, nSources);
+    if( !poProgram )
+        return CE_Failure;
+
+    const char* pszNoData = CSLFetchNameValue(papszArgs, "NoData");
+    const bool bHasNoData = pszNoData != nullptr;
+    const double dfNoData = bHasNoData ? CPLAtof(pszNoData) : 0.0;
+    const bool bNoDataIsNan = bHasNoData && CPLIsNan(dfNoData);
+
+    const int nChunkSize = std::min(nXSize, VRT_EXPR_CHUNK_SIZE);
+    const int nRegisters = poProgram->GetRegisterCount();
+    std::vector<double> adfRegisters;
+    // One more register to hold the masked result
+    std::vector<double*> apdfRegisters(nRegisters + 1);
+    try
+    {
+        adfRegisters.resize(static_cast<size_t>(nRegisters + 1) * nChunkSize);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "expression: cannot allocate working buffers");
+        return CE_Failure;
+    }
+    for( int i = 0; i <= nRegisters; ++i )
+    {
+        apdfRegisters[i] =
+            adfRegisters.data() + static_cast<size_t>(i) * nChunkSize;
+    }
+
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+
+    /* ---- Set pixels ---- */
+    for( int iLine = 0; iLine < nYSize; ++iLine )
+    {
+        for( int iCol = 0; iCol < nXSize; iCol += nChunkSize )
+        {
+            const int nCount = std::min(nChunkSize, nXSize - iCol);
+            const size_t nOffset =
+                static_cast<size_t>(iLine) * nXSize + iCol;
+
+            for( int iSrc = 0; iSrc < nSources; ++iSrc )
+            {
+                if( !poProgram->IsSourceUsed(iSrc) )
+                    continue;
+                const GByte* pabySrc = static_cast<const GByte*>(
+                    papoSources[iSrc]) + nOffset * nSrcTypeSize;
+                if( eSrcType == GDT_Float64 )
+                {
+                    apdfRegisters[iSrc] = const_cast<double*>(
+                        reinterpret_cast<const double*>(pabySrc));
+                }
+                else
+                {
+                    apdfRegisters[iSrc] = adfRegisters.data() +
+                        static_cast<size_t>(iSrc) * nChunkSize;
+                    GDALCopyWords(pabySrc, eSrcType, nSrcTypeSize,
+                                  apdfRegisters[iSrc], GDT_Float64,
+                                  static_cast<int>(sizeof(double)), nCount);
+                }
+            }
+
+            const double* padfResult =
+                apdfRegisters[poProgram->Run(apdfRegisters.data(), nCount)];
+
+            if( bHasNoData )
+            {
+                // The last register is never used by the program, so
+                // that the result can be masked without altering a source.
+                double* padfOut = apdfRegisters[nRegisters];
+                for( int i = 0; i < nCount; ++i )
+                {
+                    bool bIsNoData = false;
+                    for( int iSrc = 0; iSrc < nSources; ++iSrc )
+                    {
+                        if( !poProgram->IsSourceUsed(iSrc) )
+                            continue;
+                        const double dfVal = apdfRegisters[iSrc][i];
+                        if( bNoDataIsNan ? CPLIsNan(dfVal) :
+                                           dfVal == dfNoData )
+                        {
+                            bIsNoData = true;
+                            break;
+                        }
+                    }
+                    padfOut[i] = bIsNoData ? dfNoData : padfResult[i];
+                }
+                padfResult = padfOut;
+            }
+
+            GDALCopyWords(padfResult, GDT_Float64,
+                          static_cast<int>(sizeof(double)),
+                          static_cast<GByte *>(pData) +
+                              static_cast<GSpacing>(nLineSpace) * iLine +
+                              static_cast<GSpacing>(nPixelSpace) * iCol,
+                          eBufType, nPixelSpace, nCount);
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                     GDALRegisterDefaultPixelFunc()                   */
 /************************************************************************/
@@ -910,8 +1804,14 @@ static CPLErr dB2PowPixelFunc( void **papoSources, int nSources, void *pData,
  * - "dB2pow": perform scale conversion from logarithmic to linear
  *             (power) (i.e. 10 ^ ( x / 10 ) ) of a single raster
  *             band (real only)
+ * - "expression": evaluate the arithmetic expression given in the
+ *                 "expression" argument, in which B1, B2, ... refer to the
+ *                 sources (real only). Pixels for which one of the used
+ *                 sources is equal to the band nodata value are set to
+ *                 nodata.
  *
  * @see GDALAddDerivedBandPixelFunc
+ * @see GDALAddDerivedBandPixelFuncWithArgs
  *
  * @return CE_None
  */
@@ -934,6 +1834,7 @@ CPLErr GDALRegisterDefaultPixelFunc()
     GDALAddDerivedBandPixelFunc("dB", DBPixelFunc);
     GDALAddDerivedBandPixelFunc("dB2amp", dB2AmpPixelFunc);
     GDALAddDerivedBandPixelFunc("dB2pow", dB2PowPixelFunc);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", ExprPixelFunc);
 
     return CE_None;
 }
@@ -32,6 +32,7 @@
 #include "cpl_minixml.h"
 #include "cpl_string.h"
 #include "gdal_frmts.h"
+#include "gdal_thread_pool.h"
 #include "ogr_spatialref.h"
 #include "gdal_utils.h"
 
@@ -401,6 +402,11 @@ CPLXMLNode *VRTDataset::SerializeToXML( const char *pszVRTPathIn )
         }
     }
 
+    if( !m_osNumThreads.empty() )
+    {
+        CPLCreateXMLElementAndValue( psDSTree, "NumThreads", m_osNumThreads );
+    }
+
     return psDSTree;
 }
 
@@ -642,9 +648,43 @@ CPLErr VRTDataset::XMLInit( CPLXMLNode *psTree, const char *pszVRTPathIn )
         }
     }
 
+    m_osNumThreads = CPLGetXMLValue( psTree, "NumThreads", "" );
+
     return CE_None;
 }
 
+/************************************************************************/
+/*                           GetNumThreads()                            */
+/************************************************************************/
+
+/** Return the number of threads used to read sources concurrently.
+ *
+ * Taken from the NUM_THREADS open option, the NumThreads element, or the
+ * VRT_NUM_THREADS configuration option, in that order. Defaults to 1.
+ */
+int VRTDataset::GetNumThreads()
+{
+    if( m_nNumThreads >= 0 )
+        return m_nNumThreads;
+
+    const char* pszValue = CSLFetchNameValue(papszOpenOptions, "NUM_THREADS");
+    if( pszValue == nullptr && !m_osNumThreads.empty() )
+        pszValue = m_osNumThreads.c_str();
+    if( pszValue == nullptr )
+        pszValue = CPLGetConfigOption("VRT_NUM_THREADS", nullptr);
+    m_nNumThreads = GDALGetNumThreads(pszValue, 1);
+
+    // Each thread keeps a source dataset opened, so do not use more threads
+    // than the pool of datasets can hold (see GDALDatasetPool::Ref()).
+    int nMaxPoolSize =
+        atoi(CPLGetConfigOption("GDAL_MAX_DATASET_POOL_SIZE", "100"));
+    if( nMaxPoolSize < 2 || nMaxPoolSize > 1000 )
+        nMaxPoolSize = 100;
+    m_nNumThreads = std::min(m_nNumThreads, nMaxPoolSize);
+
+    return m_nNumThreads;
+}
+
 /************************************************************************/
 /*                            GetGCPCount()                             */
 /************************************************************************/
@@ -212,6 +212,11 @@ class CPL_DLL VRTDataset CPL_NON_FINAL: public GDALDataset
 
     int            m_nRecursionCounter = 0;
 
+    // Number of threads to read sources concurrently: value of the NumThreads
+    // element, and effective value (-1 if not yet resolved).
+    CPLString      m_osNumThreads{};
+    int            m_nNumThreads = -1;
+
     VRTRasterBand*      InitBand(const char* pszSubclass, int nBand,
                                  bool bAllowPansharpened);
     static GDALDataset *OpenVRTProtocol( const char* pszSpec );
@@ -283,6 +288,8 @@ class CPL_DLL VRTDataset CPL_NON_FINAL: public GDALDataset
 
     std::shared_ptr<GDALGroup> GetRootGroup() const override;
 
+    int                 GetNumThreads();
+
     /* Used by PDF driver for example */
     GDALDataset*        GetSingleSimpleSource();
     void                BuildVirtualOverviews();
@@ -583,6 +590,19 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL: public VRTRasterBand
     bool           CanUseSourcesMinMaxImplementations();
     void           CheckSource( VRTSimpleSource *poSS );
 
+    bool           CanReadSourcesInParallel(
+                            int nXOff, int nYOff, int nXSize, int nYSize,
+                            int nBufXSize, int nBufYSize,
+                            std::vector<VRTSimpleSource*>& apoSources );
+    CPLErr         ReadSourcesInParallel(
+                            const std::vector<VRTSimpleSource*>& apoSources,
+                            int nThreads,
+                            int nXOff, int nYOff, int nXSize, int nYSize,
+                            void *pData, int nBufXSize, int nBufYSize,
+                            GDALDataType eBufType,
+                            GSpacing nPixelSpace, GSpacing nLineSpace,
+                            GDALRasterIOExtraArg* psExtraArg );
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   public:
@@ -778,7 +798,11 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL: public VRTSourcedRasterBand
 
     static CPLErr AddPixelFunction( const char *pszFuncName,
                                     GDALDerivedPixelFunc pfnPixelFunc );
+    static CPLErr AddPixelFunction( const char *pszFuncName,
+                                    GDALDerivedPixelFuncWithArgs pfnPixelFunc );
     static GDALDerivedPixelFunc GetPixelFunction( const char *pszFuncName );
+    static GDALDerivedPixelFuncWithArgs
+                    GetPixelFunctionWithArgs( const char *pszFuncName );
 
     void SetPixelFunctionName( const char *pszFuncName );
     void SetSourceTransferType( GDALDataType eDataType );
@@ -53,6 +53,8 @@ using namespace GDALPy;
 #endif
 
 static std::map<CPLString, GDALDerivedPixelFunc> osMapPixelFunction;
+static std::map<CPLString, GDALDerivedPixelFuncWithArgs>
+                                            osMapPixelFunctionWithArgs;
 
 /* Flags for getting buffers */
 #define PyBUF_WRITABLE 0x0001
@@ -250,6 +252,38 @@ GDALAddDerivedBandPixelFunc( const char *pszFuncName,
     return CE_None;
 }
 
+/**
+ * This adds a pixel function accepting arguments to the global list of
+ * available pixel functions for derived bands.
+ *
+ * The arguments are the attributes of the PixelFunctionArguments element
+ * of the derived band, as a list of KEY=VALUE strings. If the derived band
+ * has a nodata value, and no NoData argument is explicitly set, it is passed
+ * as the NoData argument.
+ *
+ * @param pszFuncName Name used to access pixel function
+ * @param pfnNewFunction Pixel function associated with name.  An
+ *  existing pixel function registered with the same name will be
+ *  replaced with the new one.
+ *
+ * @return CE_None, invalid (NULL) parameters are currently ignored.
+ * @since GDAL 3.4
+ */
+CPLErr CPL_STDCALL
+GDALAddDerivedBandPixelFuncWithArgs( const char *pszFuncName,
+                                     GDALDerivedPixelFuncWithArgs pfnNewFunction )
+{
+    if( pszFuncName == nullptr || pszFuncName[0] == '\0' ||
+        pfnNewFunction == nullptr )
+    {
+      return CE_None;
+    }
+
+    osMapPixelFunctionWithArgs[pszFuncName] = pfnNewFunction;
+
+    return CE_None;
+}
+
 /*! @cond Doxygen_Suppress */
 
 /**
@@ -272,6 +306,27 @@ VRTDerivedRasterBand::AddPixelFunction(
     return GDALAddDerivedBandPixelFunc(pszFuncName, pfnNewFunction);
 }
 
+/**
+ * This adds a pixel function accepting arguments to the global list of
+ * available pixel functions for derived bands.
+ *
+ * This is the same as the c function GDALAddDerivedBandPixelFuncWithArgs()
+ *
+ * @param pszFuncName Name used to access pixel function
+ * @param pfnNewFunction Pixel function associated with name.  An
+ *  existing pixel function registered with the same name will be
+ *  replaced with the new one.
+ *
+ * @return CE_None, invalid (NULL) parameters are currently ignored.
+ * @since GDAL 3.4
+ */
+CPLErr
+VRTDerivedRasterBand::AddPixelFunction(
+    const char *pszFuncName, GDALDerivedPixelFuncWithArgs pfnNewFunction )
+{
+    return GDALAddDerivedBandPixelFuncWithArgs(pszFuncName, pfnNewFunction);
+}
+
 /************************************************************************/
 /*                           GetPixelFunction()                         */
 /************************************************************************/
@@ -302,6 +357,35 @@ VRTDerivedRasterBand::GetPixelFunction( const char *pszFuncName )
     return oIter->second;
 }
 
+/************************************************************************/
+/*                      GetPixelFunctionWithArgs()                      */
+/************************************************************************/
+
+/**
+ * Get a pixel function accepting arguments previously registered using the
+ * global AddPixelFunction.
+ *
+ * @param pszFuncName The name associated with the pixel function.
+ *
+ * @return A derived band pixel function, or NULL if none have been
+ * registered for pszFuncName.
+ * @since GDAL 3.4
+ */
+GDALDerivedPixelFuncWithArgs
+VRTDerivedRasterBand::GetPixelFunctionWithArgs( const char *pszFuncName )
+{
+    if( pszFuncName == nullptr || pszFuncName[0] == '\0' )
+    {
+        return nullptr;
+    }
+
+    const auto oIter = osMapPixelFunctionWithArgs.find(pszFuncName);
+    if( oIter == osMapPixelFunctionWithArgs.end())
+        return nullptr;
+
+    return oIter->second;
+}
+
 /************************************************************************/
 /*                         SetPixelFunctionName()                       */
 /************************************************************************/
@@ -813,11 +897,15 @@ CPLErr VRTDerivedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 
     /* ---- Get pixel function for band ---- */
     GDALDerivedPixelFunc pfnPixelFunc = nullptr;
+    GDALDerivedPixelFuncWithArgs pfnPixelFuncWithArgs = nullptr;
 
     if( EQUAL(m_poPrivate->m_osLanguage, "C") )
     {
-        pfnPixelFunc = VRTDerivedRasterBand::GetPixelFunction(pszFuncName);
-        if( pfnPixelFunc == nullptr )
+        pfnPixelFuncWithArgs =
+            VRTDerivedRasterBand::GetPixelFunctionWithArgs(pszFuncName);
+        if( pfnPixelFuncWithArgs == nullptr )
+            pfnPixelFunc = VRTDerivedRasterBand::GetPixelFunction(pszFuncName);
+        if( pfnPixelFunc == nullptr && pfnPixelFuncWithArgs == nullptr )
         {
             CPLError( CE_Failure, CPLE_IllegalArg,
                     "VRTDerivedRasterBand::IRasterIO:"
@@ -1159,6 +1247,26 @@ CPLErr VRTDerivedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                              eSrcType, eBufType, static_cast<int>(nPixelSpace),
                              static_cast<int>(nLineSpace) );
     }
+    else if( eErr == CE_None && pfnPixelFuncWithArgs != nullptr )
+    {
+        CPLStringList aosArgs;
+        for( const auto& oArg: m_poPrivate->m_oFunctionArgs )
+        {
+            aosArgs.SetNameValue(oArg.first, oArg.second);
+        }
+        if( m_bNoDataValueSet && aosArgs.FetchNameValue("NoData") == nullptr )
+        {
+            aosArgs.SetNameValue("NoData",
+                                 CPLSPrintf("%.18g", m_dfNoDataValue));
+        }
+        eErr = pfnPixelFuncWithArgs( static_cast<void **>( pBuffers ),
+                                     nSources,
+                                     pData, nBufXSize, nBufYSize,
+                                     eSrcType, eBufType,
+                                     static_cast<int>(nPixelSpace),
+                                     static_cast<int>(nLineSpace),
+                                     aosArgs.List() );
+    }
 end:
     // Release buffers.
     for ( int iSource = 0; iSource < nSources; iSource++ ) {
@@ -1249,10 +1357,12 @@ CPLErr VRTDerivedRasterBand::XMLInit( CPLXMLNode *psTree,
     CPLXMLNode* psArgs = CPLGetXMLNode( psTree, "PixelFunctionArguments" );
     if( psArgs != nullptr )
     {
-        if( !EQUAL(m_poPrivate->m_osLanguage, "Python") )
+        if( !EQUAL(m_poPrivate->m_osLanguage, "Python") &&
+            GetPixelFunctionWithArgs(pszFuncName) == nullptr )
         {
             CPLError(CE_Failure, CPLE_NotSupported,
-                     "PixelFunctionArguments can only be used with Python");
+                     "PixelFunctionArguments can only be used with Python, "
+                     "or pixel functions accepting arguments");
             return CE_Failure;
         }
         for( CPLXMLNode* psIter = psArgs->psChild;
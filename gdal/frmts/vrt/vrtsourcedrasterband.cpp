@@ -37,6 +37,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <set>
 #include <string>
 
 #include "cpl_conv.h"
@@ -48,6 +50,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_geometry.h"
 
 CPL_CVSID("$Id$")
@@ -299,6 +302,27 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 
     m_nRecursionCounter++;
 
+/* -------------------------------------------------------------------- */
+/*      Read independent sources concurrently if requested.             */
+/* -------------------------------------------------------------------- */
+    const int nThreads = nSources > 1 ? l_poDS->GetNumThreads() : 1;
+    if( nThreads > 1 )
+    {
+        std::vector<VRTSimpleSource*> apoSources;
+        if( CanReadSourcesInParallel( nXOff, nYOff, nXSize, nYSize,
+                                      nBufXSize, nBufYSize, apoSources ) )
+        {
+            const CPLErr eErr =
+                ReadSourcesInParallel( apoSources, nThreads,
+                                       nXOff, nYOff, nXSize, nYSize,
+                                       pData, nBufXSize, nBufYSize,
+                                       eBufType, nPixelSpace, nLineSpace,
+                                       psExtraArg );
+            m_nRecursionCounter--;
+            return eErr;
+        }
+    }
+
     GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
     void * const pProgressDataGlobal = psExtraArg->pProgressData;
 
@@ -335,6 +359,206 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                      CanReadSourcesInParallel()                      */
+/************************************************************************/
+
+// Sources can be read concurrently if they are all simple sources, that
+// write to non-overlapping windows of the output buffer (so that the result
+// does not depend on the order in which they are composited), and that read
+// from distinct datasets (as a dataset cannot be used from several threads).
+bool VRTSourcedRasterBand::CanReadSourcesInParallel(
+                            int nXOff, int nYOff, int nXSize, int nYSize,
+                            int nBufXSize, int nBufYSize,
+                            std::vector<VRTSimpleSource*>& apoSources )
+{
+    struct DstWindow
+    {
+        int nXOff;
+        int nYOff;
+        int nXSize;
+        int nYSize;
+    };
+    std::vector<DstWindow> asWindows;
+    std::set<CPLString> oSetDatasets;
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !papoSources[iSource]->IsSimpleSource() )
+            return false;
+        VRTSimpleSource* const poSource =
+            static_cast<VRTSimpleSource *>( papoSources[iSource] );
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        DstWindow sWindow;
+        if( !poSource->GetSrcDstWindow( nXOff, nYOff, nXSize, nYSize,
+                                nBufXSize, nBufYSize,
+                                &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize,
+                                &nReqXOff, &nReqYOff, &nReqXSize, &nReqYSize,
+                                &sWindow.nXOff, &sWindow.nYOff,
+                                &sWindow.nXSize, &sWindow.nYSize ) )
+        {
+            continue;
+        }
+
+        GDALRasterBand* poSrcBand = poSource->m_poMaskBandMainBand ?
+            poSource->m_poMaskBandMainBand : poSource->m_poRasterBand;
+        if( poSrcBand == nullptr )
+            return false;
+        GDALDataset* poSrcDS = poSrcBand->GetDataset();
+        if( poSrcDS == nullptr || poSrcDS == poDS )
+            return false;
+        // Proxy datasets of the same file may share the same underlying
+        // dataset, hence the check on the name.
+        CPLString osKey(poSrcDS->GetDescription());
+        if( osKey.empty() )
+            osKey.Printf("%p", poSrcDS);
+        if( !oSetDatasets.insert(osKey).second )
+            return false;
+
+        apoSources.push_back(poSource);
+        asWindows.push_back(sWindow);
+    }
+
+    if( apoSources.size() < 2 )
+        return false;
+
+    std::vector<size_t> anIdx(asWindows.size());
+    for( size_t i = 0; i < anIdx.size(); ++i )
+        anIdx[i] = i;
+    std::sort(anIdx.begin(), anIdx.end(),
+              [&asWindows](size_t a, size_t b)
+              { return asWindows[a].nYOff < asWindows[b].nYOff; });
+    for( size_t i = 0; i < anIdx.size(); ++i )
+    {
+        const DstWindow& sA = asWindows[anIdx[i]];
+        for( size_t j = i + 1; j < anIdx.size(); ++j )
+        {
+            const DstWindow& sB = asWindows[anIdx[j]];
+            if( sB.nYOff >= sA.nYOff + sA.nYSize )
+                break;
+            if( sB.nXOff < sA.nXOff + sA.nXSize &&
+                sA.nXOff < sB.nXOff + sB.nXSize )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        ReadSourcesInParallel()                       */
+/************************************************************************/
+
+namespace {
+struct VRTSourceReadContext
+{
+    GDALDataType         eBandDataType = GDT_Unknown;
+    int                  nXOff = 0;
+    int                  nYOff = 0;
+    int                  nXSize = 0;
+    int                  nYSize = 0;
+    void*                pData = nullptr;
+    int                  nBufXSize = 0;
+    int                  nBufYSize = 0;
+    GDALDataType         eBufType = GDT_Unknown;
+    GSpacing             nPixelSpace = 0;
+    GSpacing             nLineSpace = 0;
+    GDALRasterIOExtraArg sExtraArg{};
+
+    std::mutex           oMutex{};
+    bool                 bSuccess = true;
+};
+} // namespace
+
+static void VRTReadSourceJob( VRTSourceReadContext* psContext,
+                              VRTSimpleSource* poSource )
+{
+    {
+        std::lock_guard<std::mutex> oGuard(psContext->oMutex);
+        if( !psContext->bSuccess )
+            return;
+    }
+
+    GDALRasterIOExtraArg sExtraArg(psContext->sExtraArg);
+    const CPLErr eErr =
+        poSource->RasterIO( psContext->eBandDataType,
+                                   psContext->nXOff, psContext->nYOff,
+                                   psContext->nXSize, psContext->nYSize,
+                                   psContext->pData,
+                                   psContext->nBufXSize, psContext->nBufYSize,
+                                   psContext->eBufType,
+                                   psContext->nPixelSpace,
+                                   psContext->nLineSpace,
+                                   &sExtraArg );
+    if( eErr != CE_None )
+    {
+        std::lock_guard<std::mutex> oGuard(psContext->oMutex);
+        psContext->bSuccess = false;
+    }
+}
+
+CPLErr VRTSourcedRasterBand::ReadSourcesInParallel(
+                            const std::vector<VRTSimpleSource*>& apoSources,
+                            int nThreads,
+                            int nXOff, int nYOff, int nXSize, int nYSize,
+                            void *pData, int nBufXSize, int nBufYSize,
+                            GDALDataType eBufType,
+                            GSpacing nPixelSpace, GSpacing nLineSpace,
+                            GDALRasterIOExtraArg* psExtraArg )
+{
+    VRTSourceReadContext sContext;
+    sContext.eBandDataType = eDataType;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pData = pData;
+    sContext.nBufXSize = nBufXSize;
+    sContext.nBufYSize = nBufYSize;
+    sContext.eBufType = eBufType;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.sExtraArg = *psExtraArg;
+    sContext.sExtraArg.pfnProgress = nullptr;
+    sContext.sExtraArg.pProgressData = nullptr;
+
+    // Errors of the jobs are re-emitted by this thread, and progress is
+    // reported from it as jobs complete.
+    const int nJobs = static_cast<int>(apoSources.size());
+    GDALStripJobRunner oRunner( nJobs, nThreads, nJobs,
+                                [&sContext, &apoSources](int i)
+                                { VRTReadSourceJob( &sContext,
+                                                    apoSources[i] ); } );
+    for( int i = 0; i < nJobs; i++ )
+    {
+        oRunner.Wait( i );
+        if( psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress( 1.0 * (i + 1) / nJobs, "",
+                                      psExtraArg->pProgressData ) )
+        {
+            {
+                std::lock_guard<std::mutex> oGuard(sContext.oMutex);
+                sContext.bSuccess = false;
+            }
+            oRunner.Stop();
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            return CE_Failure;
+        }
+    }
+
+    return sContext.bSuccess ? CE_None : CE_Failure;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -931,6 +931,9 @@ class CPL_DLL GDALRasterBlock
 
     CPL_INTERNAL void        RecycleFor( int nXOffIn, int nYOffIn );
 
+    CPL_INTERNAL static int  FlushCacheBlock_internal( bool bDirtyBlocksOnly,
+                                                       bool bSkipDirtyBlocks );
+
   public:
                 GDALRasterBlock( GDALRasterBand *, int, int );
                 GDALRasterBlock( int nXOffIn, int nYOffIn ); /* only for lookup purpose */
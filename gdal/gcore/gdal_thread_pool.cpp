@@ -28,33 +28,174 @@
 
 #include "gdal_thread_pool.h"
 
-#include <mutex>
+#include <algorithm>
 
-static std::mutex gMutexThreadPool;
-static CPLWorkerThreadPool *gpoCompressThreadPool = nullptr;
+#include "cpl_conv.h"
+#include "cpl_string.h"
 
+// The pool lives in port, so that VSI handlers can use it too.
 CPLWorkerThreadPool* GDALGetGlobalThreadPool(int nThreads)
 {
-    std::lock_guard<std::mutex> oGuard(gMutexThreadPool);
-    if( gpoCompressThreadPool == nullptr )
+    return CPLGetGlobalWorkerThreadPool(nThreads);
+}
+
+void GDALDestroyGlobalThreadPool()
+{
+    CPLDestroyGlobalWorkerThreadPool();
+}
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+static int GDALParseNumThreads(const char* pszNumThreads, int nDefault,
+                               const char* pszItem)
+{
+    if( pszNumThreads == nullptr )
+        return nDefault;
+    int nThreads = 0;
+    if( EQUAL(pszNumThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else if( CPLGetValueType(pszNumThreads) == CPL_VALUE_INTEGER )
+        nThreads = atoi(pszNumThreads);
+    else
     {
-        gpoCompressThreadPool = new CPLWorkerThreadPool();
-        if( !gpoCompressThreadPool->Setup(nThreads, nullptr, nullptr) )
-        {
-            delete gpoCompressThreadPool;
-            gpoCompressThreadPool = nullptr;
-        }
+        CPLError(CE_Warning, CPLE_IllegalArg,
+                 "Invalid value for %s: %s. Ignoring it",
+                 pszItem, pszNumThreads);
+        return nDefault;
     }
-    else if( nThreads > gpoCompressThreadPool->GetThreadCount() )
+    return std::max(1, std::min(128, nThreads));
+}
+
+// Return the number of threads set by pszNumThreads (an integer or
+// ALL_CPUS), clamped to [1, 128], or nDefault if it is null. Other values
+// are ignored with a warning.
+int GDALGetNumThreads(const char* pszNumThreads, int nDefault)
+{
+    return GDALParseNumThreads(pszNumThreads, nDefault, "NUM_THREADS");
+}
+
+// Return the number of threads set by the pszItem option, or nDefault if
+// it is not set or invalid.
+int GDALGetNumThreads(CSLConstList papszOptions, const char* pszItem,
+                      int nDefault)
+{
+    return GDALParseNumThreads(CSLFetchNameValue(papszOptions, pszItem),
+                               nDefault, pszItem);
+}
+
+/************************************************************************/
+/*                         GDALGetStripHeight()                         */
+/************************************************************************/
+
+// Return the height of the strips of lines into which a raster of nYSize
+// lines is split to be processed by nThreads threads.
+// Strips are at least 64 lines, with several strips per thread.
+// The pszConfigOption configuration option, mostly for testing purposes,
+// overrides it.
+int GDALGetStripHeight(const char* pszConfigOption, int nYSize, int nThreads)
+{
+    const char* pszStripHeight = CPLGetConfigOption(pszConfigOption, nullptr);
+    int nStripHeight = 0;
+    if( pszStripHeight )
+        nStripHeight = atoi(pszStripHeight);
+    else
+        nStripHeight = std::max(64, std::min(1024,
+                            (nYSize + 4 * nThreads - 1) / (4 * nThreads)));
+    return std::max(1, std::min(nStripHeight, nYSize));
+}
+
+/************************************************************************/
+/*                          GDALReemitErrors()                          */
+/************************************************************************/
+
+// Emit in the calling thread the errors collected by
+// CPLInstallErrorHandlerAccumulator(), and clear them.
+void GDALReemitErrors(std::vector<CPLErrorHandlerAccumulatorStruct>& aoErrors)
+{
+    for( const auto& oError: aoErrors )
+        CPLError( oError.type, oError.no, "%s", oError.msg.c_str() );
+    aoErrors.clear();
+}
+
+/************************************************************************/
+/*                         GDALStripJobRunner()                         */
+/************************************************************************/
+
+GDALStripJobRunner::GDALStripJobRunner(
+                            int nJobs, int nThreads, int nMaxJobsInFlight,
+                            const std::function<void(int)>& oJobFunc ):
+    m_oJobFunc(oJobFunc),
+    m_nMaxJobsInFlight(std::max(1, nMaxJobsInFlight)),
+    m_asJobs(nJobs)
+{
+    for( int iJob = 0; iJob < nJobs; iJob++ )
     {
-        // Increase size of thread pool
-        gpoCompressThreadPool->Setup(nThreads, nullptr, nullptr, false);
+        m_asJobs[iJob].poRunner = this;
+        m_asJobs[iJob].iJob = iJob;
     }
-    return gpoCompressThreadPool;
+    CPLWorkerThreadPool* poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if( poThreadPool )
+        m_poJobQueue = poThreadPool->CreateJobQueue();
 }
 
-void GDALDestroyGlobalThreadPool()
+/************************************************************************/
+/*                               RunJob()                               */
+/************************************************************************/
+
+void GDALStripJobRunner::RunJob(void* pData)
+{
+    Job* psJob = static_cast<Job*>(pData);
+    GDALStripJobRunner* poRunner = psJob->poRunner;
+
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    poRunner->m_oJobFunc(psJob->iJob);
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(poRunner->m_oMutex);
+    psJob->bDone = true;
+    poRunner->m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                                Wait()                                */
+/************************************************************************/
+
+// Queue the jobs up to iJob + nMaxJobsInFlight - 1, wait for job iJob to
+// be done, and re-emit its errors. Jobs must be waited for in order.
+void GDALStripJobRunner::Wait(int iJob)
+{
+    const int nJobs = static_cast<int>(m_asJobs.size());
+    for( ; m_nSubmitted < nJobs &&
+           m_nSubmitted < iJob + m_nMaxJobsInFlight; m_nSubmitted++ )
+    {
+        Job* psJob = &m_asJobs[m_nSubmitted];
+        // Run the job in the calling thread if it cannot be queued.
+        if( !m_poJobQueue || !m_poJobQueue->SubmitJob(RunJob, psJob) )
+            RunJob(psJob);
+    }
+
+    Job& sJob = m_asJobs[iJob];
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        m_oCV.wait(oLock, [&sJob] { return sJob.bDone; });
+    }
+    GDALReemitErrors(sJob.aoErrors);
+}
+
+/************************************************************************/
+/*                                Stop()                                */
+/************************************************************************/
+
+// Queue no more jobs, wait for the queued ones, and re-emit their errors.
+// Callers should first make the running jobs exit early, if possible.
+// Wait() must not be called afterwards.
+void GDALStripJobRunner::Stop()
 {
-    delete gpoCompressThreadPool;
-    gpoCompressThreadPool = nullptr;
+    if( m_poJobQueue )
+        m_poJobQueue->WaitCompletion();
+    for( int iJob = 0; iJob < m_nSubmitted; iJob++ )
+        GDALReemitErrors(m_asJobs[iJob].aoErrors);
 }
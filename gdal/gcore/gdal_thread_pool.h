@@ -29,10 +29,70 @@
 #ifndef GDAL_THREAD_POOL_H
 #define GDAL_THREAD_POOL_H
 
+#include "cpl_port.h"
+#include "cpl_error_internal.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 CPLWorkerThreadPool* GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+int GDALGetNumThreads(const char* pszNumThreads, int nDefault);
+
+int GDALGetNumThreads(CSLConstList papszOptions, const char* pszItem,
+                      int nDefault);
+
+int GDALGetStripHeight(const char* pszConfigOption, int nYSize, int nThreads);
+
+void GDALReemitErrors(std::vector<CPLErrorHandlerAccumulatorStruct>& aoErrors);
+
+/************************************************************************/
+/*                          GDALStripJobRunner                          */
+/************************************************************************/
+
+// Runs the jobs processing the strips of a raster (or any other list of
+// independent jobs) in a job queue of the global thread pool, or in the
+// calling thread if there is no more than one thread.
+// Jobs are queued in order, with at most nMaxJobsInFlight of them queued or
+// running ahead of the one waited for, so that memory use stays bounded.
+// The errors emitted by a job are re-emitted by the calling thread when the
+// job is waited for.
+class GDALStripJobRunner
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALStripJobRunner)
+
+    struct Job
+    {
+        GDALStripJobRunner* poRunner = nullptr;
+        int iJob = 0;
+        bool bDone = false;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    std::function<void(int)> m_oJobFunc;
+    int m_nMaxJobsInFlight = 1;
+    int m_nSubmitted = 0;
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    std::vector<Job> m_asJobs{};
+    // Last member, so that it waits for the jobs before the others are
+    // destroyed.
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    static void RunJob(void* pData);
+
+  public:
+    GDALStripJobRunner(int nJobs, int nThreads, int nMaxJobsInFlight,
+                       const std::function<void(int)>& oJobFunc);
+
+    void Wait(int iJob);
+    void Stop();
+};
+
 #endif // GDAL_THREAD_POOL_H
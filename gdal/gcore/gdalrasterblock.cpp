@@ -48,21 +48,36 @@ CPL_CVSID("$Id$")
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static volatile GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD( &hRBLock )
-#define TAKE_LOCK       CPLMutexHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK    CPLDestroyMutex( hRBLock )
-#else
+/* -------------------------------------------------------------------- */
+/*      The LRU list of cached blocks is split into several shards,     */
+/*      each one with its own lock, so that threads working on          */
+/*      different blocks rarely contend. A block is assigned to a       */
+/*      shard from its band and coordinates, which do not change while  */
+/*      it is attached to the list. Eviction keeps the GDAL_CACHEMAX    */
+/*      semantics by comparing the sum of the memory used by all shards */
+/*      to the limit, and evicts preferably from the shard of the block */
+/*      being internalized (approximate global LRU).                   */
+/* -------------------------------------------------------------------- */
+
+constexpr int MAX_CACHE_SHARDS = 64;
+
+struct GDALRasterBlockCacheShard
+{
+    CPLLock*                 hLock = nullptr;
+    GDALRasterBlock         *poOldest = nullptr;  // Tail.
+    GDALRasterBlock         *poNewest = nullptr;  // Head.
+    volatile GIntBig         nCacheUsed = 0;
+    // Avoid false sharing between the shards.
+    char                     abyPadding[64 - sizeof(CPLLock*) -
+                                        2 * sizeof(GDALRasterBlock*) -
+                                        sizeof(GIntBig)] = {};
+};
+
+static GDALRasterBlockCacheShard aoShards[MAX_CACHE_SHARDS];
 
-static CPLLock* hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -92,12 +107,69 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK         CPLLockHolderD( &hRBLock, GetLockType() ); \
-                                CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK               CPLLockHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK            CPLDestroyLock( hRBLock )
+/************************************************************************/
+/*                           GetShardCount()                            */
+/************************************************************************/
 
-#endif
+static int GetShardCount()
+{
+    // Thread-safe initialization of a function-local static.
+    static const int nShardCount = []()
+    {
+        const char* pszShards =
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "AUTO");
+        const int nCount = EQUAL(pszShards, "AUTO") ?
+            CPLGetNumCPUs() : atoi(pszShards);
+        return std::max(1, std::min(nCount, MAX_CACHE_SHARDS));
+    }();
+    return nShardCount;
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+static GDALRasterBlockCacheShard& GetShard( GDALRasterBlock* poBlock )
+{
+    const int nShardCount = GetShardCount();
+    if( nShardCount == 1 )
+        return aoShards[0];
+    // Spread the blocks of a same band over all shards, so that several
+    // threads reading the same dataset also benefit from sharding.
+    size_t nHash = reinterpret_cast<size_t>(poBlock->GetBand()) /
+                                                            sizeof(void*);
+    nHash = nHash * 31 + static_cast<unsigned>(poBlock->GetYOff());
+    nHash = nHash * 31 + static_cast<unsigned>(poBlock->GetXOff());
+    return aoShards[nHash % nShardCount];
+}
+
+/************************************************************************/
+/*                          GetCacheUsedAll()                           */
+/************************************************************************/
+
+// The sum is computed without taking the locks of the shards, and is thus
+// only approximate when other threads are modifying the cache.
+static GIntBig GetCacheUsedAll()
+{
+    const int nShardCount = GetShardCount();
+    GIntBig nTotal = 0;
+    for( int i = 0; i < nShardCount; ++i )
+        nTotal += aoShards[i].nCacheUsed;
+    return nTotal;
+}
+
+#define INITIALIZE_LOCK         InitializeLocks()
+#define TAKE_LOCK(oShard)       CPLLockHolderOptionalLockD( (oShard).hLock )
+
+static void InitializeLocks()
+{
+    const int nShardCount = GetShardCount();
+    for( int i = 0; i < nShardCount; ++i )
+    {
+        CPLLockHolderD( &aoShards[i].hLock, GetLockType() );
+        CPLLockSetDebugPerf(aoShards[i].hLock, bDebugContention);
+    }
+}
 
 //#define ENABLE_DEBUG
 
@@ -164,13 +236,9 @@ void CPL_STDCALL GDALSetCacheMax64( GIntBig nNewSizeInBytes )
 /*      Flush blocks till we are under the new limit or till we         */
 /*      can't seem to flush anymore.                                    */
 /* -------------------------------------------------------------------- */
-    while( nCacheUsed > nCacheMax )
+    while( GetCacheUsedAll() > nCacheMax )
     {
-        const GIntBig nOldCacheUsed = nCacheUsed;
-
-        GDALFlushCacheBlock();
-
-        if( nCacheUsed == nOldCacheUsed )
+        if( !GDALFlushCacheBlock() )
             break;
     }
 }
@@ -324,6 +392,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GetCacheUsedAll();
     if (nCacheUsed > INT_MAX)
     {
         static bool bHasWarned = false;
@@ -352,7 +421,7 @@ int CPL_STDCALL GDALGetCacheUsed()
  * @since GDAL 1.8.0
  */
 
-GIntBig CPL_STDCALL GDALGetCacheUsed64() { return nCacheUsed; }
+GIntBig CPL_STDCALL GDALGetCacheUsed64() { return GetCacheUsedAll(); }
 
 /************************************************************************/
 /*                        GDALFlushCacheBlock()                         */
@@ -431,16 +500,39 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
 
 {
-    GDALRasterBlock *poTarget;
+    return FlushCacheBlock_internal( CPL_TO_BOOL(bDirtyBlocksOnly), false );
+}
+
+/************************************************************************/
+/*                      FlushCacheBlock_internal()                      */
+/************************************************************************/
 
+// If bSkipDirtyBlocks is set, dirty blocks are not considered for eviction.
+int GDALRasterBlock::FlushCacheBlock_internal( bool bDirtyBlocksOnly,
+                                               bool bSkipDirtyBlocks )
+
+{
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Start from a different shard at each call, so that eviction is
+    // spread over all of them.
+    static int nNextShard = 0;
+    const int nShardCount = GetShardCount();
+    const int iFirstShard = static_cast<int>(
+        static_cast<unsigned>(CPLAtomicInc(&nNextShard)) % nShardCount);
+    for( int i = 0; poTarget == nullptr && i < nShardCount; ++i )
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockCacheShard& oShard =
+            aoShards[(iFirstShard + i) % nShardCount];
+        TAKE_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while( poTarget != nullptr )
         {
-            if( !bDirtyBlocksOnly ||
-                (poTarget->GetDirty() && nDisableDirtyBlockFlushCounter == 0) )
+            const bool bCandidate = bDirtyBlocksOnly ?
+                (poTarget->GetDirty() && nDisableDirtyBlockFlushCounter == 0) :
+                (!bSkipDirtyBlocks || !poTarget->GetDirty());
+            if( bCandidate )
             {
                 if( CPLAtomicCompareAndExchange(
                         &(poTarget->nLockCount), 0, -1) )
@@ -450,7 +542,7 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
         }
 
         if( poTarget == nullptr )
-            return FALSE;
+            continue;
         if( bSleepsForBockCacheDebug )
         {
             // coverity[tainted_data]
@@ -465,6 +557,9 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if( poTarget == nullptr )
+        return FALSE;
+
     if( bSleepsForBockCacheDebug )
     {
         // coverity[tainted_data]
@@ -717,19 +812,20 @@ void GDALRasterBlock::Detach()
 {
     if( bMustDetach )
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if( poOldest == this )
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard& oShard = GetShard(this);
+    if( oShard.poOldest == this )
+        oShard.poOldest = poPrevious;
 
-    if( poNewest == this )
+    if( oShard.poNewest == this )
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if( poPrevious != nullptr )
@@ -743,7 +839,7 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if( pData )
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+        oShard.nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -763,27 +859,33 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert( (poNewest == nullptr && poOldest == nullptr)
-               || (poNewest != nullptr && poOldest != nullptr) );
-
-    if( poNewest != nullptr )
+    const int nShardCount = GetShardCount();
+    for( int i = 0; i < nShardCount; ++i )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        CPLAssert( poOldest->poNext == nullptr );
+        GDALRasterBlockCacheShard& oShard = aoShards[i];
+        TAKE_LOCK(oShard);
 
-        GDALRasterBlock* poLast = nullptr;
-        for( GDALRasterBlock *poBlock = poNewest;
-             poBlock != nullptr;
-             poBlock = poBlock->poNext )
+        CPLAssert( (oShard.poNewest == nullptr && oShard.poOldest == nullptr)
+                   || (oShard.poNewest != nullptr && oShard.poOldest != nullptr) );
+
+        if( oShard.poNewest != nullptr )
         {
-            CPLAssert( poBlock->poPrevious == poLast );
+            CPLAssert( oShard.poNewest->poPrevious == nullptr );
+            CPLAssert( oShard.poOldest->poNext == nullptr );
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock* poLast = nullptr;
+            for( GDALRasterBlock *poBlock = oShard.poNewest;
+                 poBlock != nullptr;
+                 poBlock = poBlock->poNext )
+            {
+                CPLAssert( poBlock->poPrevious == poLast );
+                CPLAssert( &GetShard(poBlock) == &oShard );
 
-        CPLAssert( poOldest == poLast );
+                poLast = poBlock;
+            }
+
+            CPLAssert( oShard.poOldest == poLast );
+        }
     }
 }
 
@@ -794,25 +896,29 @@ void GDALRasterBlock::Verify() {}
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks( GDALRasterBand* poBand )
 {
-    TAKE_LOCK;
-    for( GDALRasterBlock *poBlock = poNewest;
-                          poBlock != nullptr;
-                          poBlock = poBlock->poNext )
+    const int nShardCount = GetShardCount();
+    for( int i = 0; i < nShardCount; ++i )
     {
-        if ( poBlock->GetBand() == poBand )
+        TAKE_LOCK(aoShards[i]);
+        for( GDALRasterBlock *poBlock = aoShards[i].poNewest;
+                              poBlock != nullptr;
+                              poBlock = poBlock->poNext )
         {
-            printf("Cache has still blocks of band %p\n", poBand);/*ok*/
-            printf("Band : %d\n", poBand->GetBand());/*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());/*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());/*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);/*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);/*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset());/*ok*/
-            if( poBand->GetDataset() )
-                printf("Dataset : %s\n",/*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if ( poBlock->GetBand() == poBand )
+            {
+                printf("Cache has still blocks of band %p\n", poBand);/*ok*/
+                printf("Band : %d\n", poBand->GetBand());/*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());/*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());/*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);/*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);/*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset());/*ok*/
+                if( poBand->GetDataset() )
+                    printf("Dataset : %s\n",/*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -868,11 +974,13 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockCacheShard& oShard = GetShard(this);
+
     // Can be safely tested outside the lock
-    if( poNewest == this )
+    if( oShard.poNewest == this )
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
@@ -885,15 +993,16 @@ void GDALRasterBlock::Touch_unlocked()
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if( poNewest == this )
+    GDALRasterBlockCacheShard& oShard = GetShard(this);
+    if( oShard.poNewest == this )
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if( poOldest == this )
-        poOldest = this->poPrevious;
+    if( oShard.poOldest == this )
+        oShard.poOldest = this->poPrevious;
 
     if( poPrevious != nullptr )
         poPrevious->poNext = poNext;
@@ -902,19 +1011,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if( poNewest != nullptr )
+    if( oShard.poNewest != nullptr )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        poNewest->poPrevious = this;
+        CPLAssert( oShard.poNewest->poPrevious == nullptr );
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if( poOldest == nullptr )
+    if( oShard.poOldest == nullptr )
     {
         CPLAssert( poPrevious == nullptr && poNext == nullptr );
-        poOldest = this;
+        oShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -943,8 +1052,8 @@ CPLErr GDALRasterBlock::Internalize()
 
     void        *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
-    // only be called if we have go through there.
+    // This call will initialize the locks of the cache shards. Other call
+    // places can only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
@@ -962,12 +1071,13 @@ CPLErr GDALRasterBlock::Internalize()
         GDALRasterBlock* apoBlocksToFree[64] = { nullptr };
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            GDALRasterBlockCacheShard& oShard = GetShard(this);
+            TAKE_LOCK(oShard);
 
             if( bFirstIter )
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while( nCacheUsed > nCurCacheMax )
+                oShard.nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+            GDALRasterBlock *poTarget = oShard.poOldest;
+            while( GetCacheUsedAll() > nCurCacheMax )
             {
                 GDALRasterBlock* poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
@@ -1012,7 +1122,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.poOldest;
                         while( poTarget != nullptr )
                         {
                             if( CPLAtomicCompareAndExchange(
@@ -1021,6 +1131,7 @@ CPLErr GDALRasterBlock::Internalize()
                                 CPLDebug("GDAL", "Evicting dirty block of another dataset");
                                 break;
                             }
+                            poTarget = poTarget->poPrevious;
                         }
                     }
                 }
@@ -1049,12 +1160,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = GetCacheUsedAll() > nCurCacheMax;
                         break;
                     }
                     if( nBlocksToFree == 64 )
                     {
-                        bLoopAgain = ( nCacheUsed > nCurCacheMax );
+                        bLoopAgain = ( GetCacheUsedAll() > nCurCacheMax );
                         break;
                     }
 
@@ -1119,6 +1230,16 @@ CPLErr GDALRasterBlock::Internalize()
     }
     while(bLoopAgain);
 
+    // If the shard of this block did not have enough evictable blocks,
+    // make room in the other ones. Dirty blocks must not be written while
+    // dirty block flushing is disabled.
+    while( GetCacheUsedAll() > nCurCacheMax &&
+           FlushCacheBlock_internal(
+               false, nDisableDirtyBlockFlushCounter != 0) )
+    {
+        /* go on */
+    }
+
     if( pNewData == nullptr )
     {
         pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE( nSizeInBytes );
@@ -1180,9 +1301,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if( hRBLock != nullptr )
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for( int i = 0; i < MAX_CACHE_SHARDS; ++i )
+    {
+        if( aoShards[i].hLock != nullptr )
+            CPLDestroyLock( aoShards[i].hLock );
+        aoShards[i].hLock = nullptr;
+    }
 }
 /*! @endcond */
 
@@ -1261,7 +1385,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(this));
 
     return FALSE;
 }
@@ -1270,14 +1394,18 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    const int nShardCount = GetShardCount();
+    for( int i = 0; i < nShardCount; ++i )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = aoShards[i].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d (shard %d)\n", iBlock, i);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
@@ -815,6 +815,49 @@ public:
                                          double *z, double *t,
                                          int *panErrorCodes );
 
+    /**
+     * Transform a bounding box from source to destination space.
+     *
+     * The edges of the box are densified with densify_pts intermediate
+     * points, and all points are transformed with a single call to
+     * Transform(). Points that fail to transform are ignored.
+     *
+     * When the target CRS is geographic, the returned longitude extent is the
+     * smallest one containing all transformed points: if it crosses the
+     * antimeridian, the returned minimum longitude is greater than the maximum
+     * longitude. If a pole of the target CRS is inside the source bounding
+     * box, the latitude extent is extended up to it, and the longitude extent
+     * is the whole [-180,180] range.
+     *
+     * The coordinates are in the data axis order of the source and target
+     * CRS, as for Transform().
+     *
+     * This method is the same as the C function OCTTransformBounds().
+     *
+     * @param xmin Minimum bounding coordinate of the first axis in source CRS.
+     * @param ymin Minimum bounding coordinate of the second axis in source CRS.
+     * @param xmax Maximum bounding coordinate of the first axis in source CRS.
+     * @param ymax Maximum bounding coordinate of the second axis in source CRS.
+     * @param out_xmin Minimum bounding coordinate of the first axis in target CRS.
+     * @param out_ymin Minimum bounding coordinate of the second axis in target CRS.
+     * @param out_xmax Maximum bounding coordinate of the first axis in target CRS.
+     * @param out_ymax Maximum bounding coordinate of the second axis in target CRS.
+     * @param densify_pts Number of points to add to each edge of the bounding
+     *                    box. Recommended: 21.
+     * @return TRUE if successful, or FALSE if none of the points could be
+     * transformed.
+     * @since GDAL 3.4
+     */
+    virtual int TransformBounds( const double xmin,
+                                 const double ymin,
+                                 const double xmax,
+                                 const double ymax,
+                                 double* out_xmin,
+                                 double* out_ymin,
+                                 double* out_xmax,
+                                 double* out_ymax,
+                                 const int densify_pts );
+
     /** Convert a OGRCoordinateTransformation* to a OGRCoordinateTransformationH.
      * @since GDAL 2.3
      */
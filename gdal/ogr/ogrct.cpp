@@ -36,7 +36,9 @@
 #include <cstring>
 #include <limits>
 #include <list>
+#include <map>
 #include <mutex>
+#include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -521,6 +523,329 @@ int OCTCoordinateTransformationOptionsSetBallparkAllowed(
 }
 
 
+#ifndef PROJ_ERR_COORD_TRANSFM_INVALID_COORD
+#define PROJ_ERR_COORD_TRANSFM_INVALID_COORD             2049
+#define PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN 2050
+#define PROJ_ERR_COORD_TRANSFM_NO_OPERATION              2051
+#endif
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                        OGRCTAdjustLongitude()                        */
+/************************************************************************/
+
+// Same as PROJ adjlon(): bring a longitude in radians into [-pi, pi].
+static double OGRCTAdjustLongitude( double lon )
+{
+    if( std::fabs(lon) < M_PI + 1e-12 )
+        return lon;
+    lon += M_PI;
+    lon -= 2 * M_PI * floor(lon / (2 * M_PI));
+    lon -= M_PI;
+    return lon;
+}
+
+/************************************************************************/
+/*                         OGRCTTransverseMercator                      */
+/************************************************************************/
+
+// Ellipsoidal Transverse Mercator using the Poder/Engsager 6th order series,
+// which is the default ("exact") algorithm of PROJ. This is used to project
+// directly between a geographic CRS and a Transverse Mercator CRS based on
+// it, without the per-point overhead of going through a PROJ pipeline.
+
+class OGRCTTransverseMercator
+{
+    static constexpr int ORDER = 6;
+
+    double m_dfA = 0.0;
+    double m_dfLon0 = 0.0;
+    double m_dfFalseEasting = 0.0;
+    double m_dfFalseNorthing = 0.0;
+    double m_dfQn = 0.0;
+    double m_dfZb = 0.0;
+    double m_adfCgb[ORDER] = {};
+    double m_adfCbg[ORDER] = {};
+    double m_adfUtg[ORDER] = {};
+    double m_adfGtu[ORDER] = {};
+    bool m_bGeogNorthFirst = false;
+    bool m_bProjNorthFirst = false;
+
+    // Real Clenshaw summation of sum(a[k] * sin((k+1) * arg)).
+    static double ClenS(const double* a, double arg)
+    {
+        const double r = 2 * cos(arg);
+        double hr = a[ORDER - 1];
+        double hr1 = 0.0;
+        for( int k = ORDER - 2; k >= 0; --k )
+        {
+            const double hr2 = hr1;
+            hr1 = hr;
+            hr = -hr2 + r * hr1 + a[k];
+        }
+        return sin(arg) * hr;
+    }
+
+    // Complex Clenshaw summation of sum(a[k] * sin((k+1) * (argR + i argI))).
+    static void ClenSComplex(const double* a, double argR, double argI,
+                             double& dfR, double& dfI)
+    {
+        const double sinR = sin(argR);
+        const double cosR = cos(argR);
+        const double sinhI = sinh(argI);
+        const double coshI = cosh(argI);
+        double r = 2 * cosR * coshI;
+        double i = -2 * sinR * sinhI;
+        double hr = a[ORDER - 1];
+        double hi = 0.0;
+        double hr1 = 0.0;
+        double hi1 = 0.0;
+        for( int k = ORDER - 2; k >= 0; --k )
+        {
+            const double hr2 = hr1;
+            const double hi2 = hi1;
+            hr1 = hr;
+            hi1 = hi;
+            hr = -hr2 + r * hr1 - i * hi1 + a[k];
+            hi = -hi2 + i * hr1 + r * hi1;
+        }
+        r = sinR * coshI;
+        i = cosR * sinhI;
+        dfR = r * hr - i * hi;
+        dfI = r * hi + i * hr;
+    }
+
+    // Conversion between geodetic and Gaussian latitudes.
+    static double GaTG(const double* p, double B)
+    {
+        const double cos2B = 2 * cos(2 * B);
+        double h = 0.0;
+        double h1 = p[ORDER - 1];
+        double h2 = 0.0;
+        for( int k = ORDER - 2; k >= 0; --k )
+        {
+            h = -h2 + cos2B * h1 + p[k];
+            h2 = h1;
+            h1 = h;
+        }
+        return B + h * sin(2 * B);
+    }
+
+public:
+    // Maximum absolute normalized easting accepted (150 degrees).
+    static constexpr double MAX_CE = 2.623395162778;
+
+    void Init(double dfSemiMajor, double dfInvFlattening,
+              double dfLat0Deg, double dfLon0Deg, double dfScale,
+              double dfFalseEasting, double dfFalseNorthing)
+    {
+        m_dfA = dfSemiMajor;
+        m_dfLon0 = dfLon0Deg * M_PI / 180.0;
+        m_dfFalseEasting = dfFalseEasting;
+        m_dfFalseNorthing = dfFalseNorthing;
+
+        const double f = 1.0 / dfInvFlattening;
+        const double n = f / (2 - f);
+        double np = n;
+
+        m_adfCgb[0] = n*( 2 + n*(-2/3.0 + n*(-2 + n*(116/45.0 + n*(26/45.0 + n*(-2854/675.0))))));
+        m_adfCbg[0] = n*(-2 + n*( 2/3.0 + n*( 4/3.0 + n*(-82/45.0 + n*(32/45.0 + n*(4642/4725.0))))));
+        np *= n;
+        m_adfCgb[1] = np*(7/3.0 + n*( -8/5.0 + n*(-227/45.0 + n*(2704/315.0 + n*( 2323/945.0)))));
+        m_adfCbg[1] = np*(5/3.0 + n*(-16/15.0 + n*( -13/9.0 + n*( 904/315.0 + n*(-1522/945.0)))));
+        np *= n;
+        m_adfCgb[2] = np*( 56/15.0 + n*(-136/35.0 + n*(-1262/105.0 + n*( 73814/2835.0))));
+        m_adfCbg[2] = np*(-26/15.0 + n*(  34/21.0 + n*(    8/5.0 + n*(-12686/2835.0))));
+        np *= n;
+        m_adfCgb[3] = np*(4279/630.0 + n*(-332/35.0 + n*(-399572/14175.0)));
+        m_adfCbg[3] = np*(1237/630.0 + n*( -12/5.0 + n*( -24832/14175.0)));
+        np *= n;
+        m_adfCgb[4] = np*(4174/315.0 + n*(-144838/6237.0));
+        m_adfCbg[4] = np*(-734/315.0 + n*( 109598/31185.0));
+        np *= n;
+        m_adfCgb[5] = np*(601676/22275.0);
+        m_adfCbg[5] = np*(444337/155925.0);
+
+        np = n * n;
+        m_dfQn = dfScale / (1 + n) * (1 + np*(1/4.0 + np*(1/64.0 + np/256.0)));
+
+        m_adfUtg[0] = n*(-0.5 + n*( 2/3.0 + n*(-37/96.0 + n*( 1/360.0 + n*(  81/512.0 + n*(-96199/604800.0))))));
+        m_adfGtu[0] = n*( 0.5 + n*(-2/3.0 + n*(  5/16.0 + n*(41/180.0 + n*(-127/288.0 + n*(  7891/37800.0))))));
+        m_adfUtg[1] = np*(-1/48.0 + n*(-1/15.0 + n*(437/1440.0 + n*(-46/105.0 + n*( 1118711/3870720.0)))));
+        m_adfGtu[1] = np*(13/48.0 + n*(-3/5.0 + n*(557/1440.0 + n*(281/630.0 + n*(-1983433/1935360.0)))));
+        np *= n;
+        m_adfUtg[2] = np*(-17/480.0 + n*(  37/840.0 + n*(  209/4480.0 + n*( -5569/90720.0))));
+        m_adfGtu[2] = np*( 61/240.0 + n*(-103/140.0 + n*(15061/26880.0 + n*(167603/181440.0))));
+        np *= n;
+        m_adfUtg[3] = np*(-4397/161280.0 + n*(  11/504.0 + n*( 830251/7257600.0)));
+        m_adfGtu[3] = np*(49561/161280.0 + n*(-179/168.0 + n*(6601661/7257600.0)));
+        np *= n;
+        m_adfUtg[4] = np*(-4583/161280.0 + n*(  108847/3991680.0));
+        m_adfGtu[4] = np*(34729/80640.0 + n*(-3418889/1995840.0));
+        np *= n;
+        m_adfUtg[5] = np*(-20648693/638668800.0);
+        m_adfGtu[5] = np*(212378941/319334400.0);
+
+        // Northing of the latitude of origin.
+        const double dfLat0 = dfLat0Deg * M_PI / 180.0;
+        const double Z = GaTG(m_adfCbg, dfLat0);
+        m_dfZb = -m_dfQn * (Z + ClenS(m_adfGtu, 2 * Z));
+    }
+
+    // Initialize from a geographic CRS and a Transverse Mercator CRS, if
+    // the conversion between them is a pure projection that can be handled.
+    bool InitFromCRS(const OGRSpatialReference* poGeog,
+                     const OGRSpatialReference* poProj)
+    {
+        if( !poGeog->IsGeographic() || poGeog->IsDerivedGeographic() ||
+            poGeog->GetAxesCount() != 2 ||
+            !poProj->IsProjected() || poProj->GetAxesCount() != 2 )
+        {
+            return false;
+        }
+        const char* pszProjection = poProj->GetAttrValue("PROJECTION");
+        if( pszProjection == nullptr ||
+            !EQUAL(pszProjection, SRS_PT_TRANSVERSE_MERCATOR) )
+        {
+            return false;
+        }
+        if( poProj->GetLinearUnits(nullptr) != 1.0 ||
+            std::fabs(poGeog->GetAngularUnits(nullptr) -
+                      CPLAtof(SRS_UA_DEGREE_CONV)) > 1e-15 ||
+            poGeog->GetPrimeMeridian(nullptr) != 0.0 )
+        {
+            return false;
+        }
+        const double dfInvFlattening = poGeog->GetInvFlattening();
+        if( !(dfInvFlattening > 0.0) )
+            return false;
+
+        const auto GetNorthFirst = [](const OGRSpatialReference* poSRS,
+                                      bool& bNorthFirst)
+        {
+            OGRAxisOrientation eOrient0 = OAO_Other;
+            OGRAxisOrientation eOrient1 = OAO_Other;
+            poSRS->GetAxis(nullptr, 0, &eOrient0);
+            poSRS->GetAxis(nullptr, 1, &eOrient1);
+            bNorthFirst = eOrient0 == OAO_North;
+            return (eOrient0 == OAO_East && eOrient1 == OAO_North) ||
+                   (eOrient0 == OAO_North && eOrient1 == OAO_East);
+        };
+        if( !GetNorthFirst(poGeog, m_bGeogNorthFirst) ||
+            !GetNorthFirst(poProj, m_bProjNorthFirst) )
+        {
+            return false;
+        }
+
+        // The projected CRS must be based on the geographic CRS, so that
+        // no datum transformation is involved.
+        std::unique_ptr<OGRSpatialReference> poBaseGeog(poProj->CloneGeogCS());
+        const char* const apszOptions[] = {
+            "IGNORE_DATA_AXIS_TO_SRS_AXIS_MAPPING=YES", nullptr };
+        if( poBaseGeog == nullptr ||
+            !poBaseGeog->IsSame(poGeog, apszOptions) )
+        {
+            return false;
+        }
+
+        Init(poGeog->GetSemiMajor(), dfInvFlattening,
+             poProj->GetNormProjParm(SRS_PP_LATITUDE_OF_ORIGIN, 0.0),
+             poProj->GetNormProjParm(SRS_PP_CENTRAL_MERIDIAN, 0.0),
+             poProj->GetNormProjParm(SRS_PP_SCALE_FACTOR, 1.0),
+             poProj->GetNormProjParm(SRS_PP_FALSE_EASTING, 0.0),
+             poProj->GetNormProjParm(SRS_PP_FALSE_NORTHING, 0.0));
+        return true;
+    }
+
+    bool IsGeogNorthFirst() const { return m_bGeogNorthFirst; }
+    bool IsProjNorthFirst() const { return m_bProjNorthFirst; }
+
+    // Longitude/latitude in degrees to easting/northing in metres.
+    // Returns 0 or a PROJ error code.
+    int Forward(double& x, double& y) const
+    {
+        double lam = x * (M_PI / 180.0);
+        double phi = y * (M_PI / 180.0);
+        if( std::fabs(phi) - M_PI / 2 > 1e-12 || lam > 10 || lam < -10 )
+            return PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
+        phi = std::max(-M_PI / 2, std::min(M_PI / 2, phi));
+        lam = OGRCTAdjustLongitude(lam - m_dfLon0);
+
+        // Ellipsoidal latitude, longitude -> Gaussian latitude, longitude
+        double Cn = GaTG(m_adfCbg, phi);
+        // Gaussian latitude, longitude -> complementary spherical latitude
+        const double sinCn = sin(Cn);
+        const double cosCn = cos(Cn);
+        const double sinCe = sin(lam);
+        const double cosCe = cos(lam);
+        Cn = atan2(sinCn, cosCe * cosCn);
+        double Ce = atan2(sinCe * cosCn, hypot(sinCn, cosCn * cosCe));
+        // Complementary spherical N, E -> ellipsoidal normalized N, E
+        Ce = asinh(tan(Ce));
+        double dCn = 0.0;
+        double dCe = 0.0;
+        ClenSComplex(m_adfGtu, 2 * Cn, 2 * Ce, dCn, dCe);
+        Cn += dCn;
+        Ce += dCe;
+        if( !(std::fabs(Ce) <= MAX_CE) )
+            return PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+        x = m_dfA * m_dfQn * Ce + m_dfFalseEasting;
+        y = m_dfA * (m_dfQn * Cn + m_dfZb) + m_dfFalseNorthing;
+        return 0;
+    }
+
+    // Easting/northing in metres to longitude/latitude in degrees.
+    // Returns 0 or a PROJ error code.
+    int Inverse(double& x, double& y) const
+    {
+        double Cn = ((y - m_dfFalseNorthing) / m_dfA - m_dfZb) / m_dfQn;
+        double Ce = ((x - m_dfFalseEasting) / m_dfA) / m_dfQn;
+        if( !(std::fabs(Ce) <= MAX_CE) )
+            return PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+        // Normalized N, E -> complementary spherical latitude, longitude
+        double dCn = 0.0;
+        double dCe = 0.0;
+        ClenSComplex(m_adfUtg, 2 * Cn, 2 * Ce, dCn, dCe);
+        Cn += dCn;
+        Ce += dCe;
+        Ce = atan(sinh(Ce));
+        // Complementary spherical latitude -> Gaussian latitude, longitude
+        const double sinCn = sin(Cn);
+        const double cosCn = cos(Cn);
+        const double sinCe = sin(Ce);
+        const double cosCe = cos(Ce);
+        Ce = atan2(sinCe, cosCe * cosCn);
+        Cn = atan2(sinCn * cosCe, hypot(sinCe, cosCe * cosCn));
+        // Gaussian latitude, longitude -> ellipsoidal latitude, longitude
+        x = OGRCTAdjustLongitude(Ce + m_dfLon0) * (180.0 / M_PI);
+        y = GaTG(m_adfCgb, Cn) * (180.0 / M_PI);
+        return 0;
+    }
+};
+
+/************************************************************************/
+/*                    OGRCTWGS84LongLatToWebMercator()                  */
+/************************************************************************/
+
+// Longitude/latitude in degrees to WebMercator easting/northing in metres,
+// with the same domain checks as PROJ. Returns 0 or a PROJ error code.
+static int OGRCTWGS84LongLatToWebMercator( double& x, double& y )
+{
+    constexpr double SPHERE_RADIUS = 6378137.0;
+    const double lam = x * (M_PI / 180.0);
+    const double phi = y * (M_PI / 180.0);
+    if( std::fabs(phi) - M_PI / 2 > 1e-12 || lam > 10 || lam < -10 )
+        return PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
+    if( std::fabs(std::fabs(phi) - M_PI / 2) <= 1e-10 )
+        return PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+    x = SPHERE_RADIUS * OGRCTAdjustLongitude(lam);
+    y = SPHERE_RADIUS * asinh(tan(phi));
+    return 0;
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                              OGRProjCT                               */
 /************************************************************************/
@@ -539,6 +864,18 @@ class OGRProjCT : public OGRCoordinateTransformation
     double      dfTargetWrapLong = 0.0;
 
     bool        bWebMercatorToWGS84LongLat = false;
+    bool        bWGS84LongLatToWebMercator = false;
+
+    // Analytical Transverse Mercator from a geographic CRS to a projected CRS
+    // based on it, or the reverse when m_bTMercInverse is set.
+    bool        m_bTMercFastPath = false;
+    bool        m_bTMercInverse = false;
+    OGRCTTransverseMercator m_oTMerc{};
+
+    // Whether the two first coordinates must be swapped on input/output of
+    // the WGS84 to WebMercator and Transverse Mercator fast paths.
+    bool        m_bFastPathSwapIn = false;
+    bool        m_bFastPathSwapOut = false;
 
     int         nErrorCount = 0;
 
@@ -547,6 +884,10 @@ class OGRProjCT : public OGRCoordinateTransformation
     PJ*         m_pj = nullptr;
     bool        m_bReversePj = false;
 
+    // Whether points may be transformed with a single proj_trans_generic()
+    // call.
+    bool        m_bBatchTransform = false;
+
     bool        m_bEmitErrors = true;
 
     bool        bNoTransform = false;
@@ -611,6 +952,20 @@ class OGRProjCT : public OGRCoordinateTransformation
     int m_iCurTransformation = -1;
     OGRCoordinateTransformationOptions m_options{};
 
+    // Cache of the operation returned by SelectOperationCached(), per cell of
+    // a regular grid in source CRS coordinates.
+    bool m_bOpSelectionGridInitialized = false;
+    double m_dfOpSelectionGridOriginX = 0.0;
+    double m_dfOpSelectionGridOriginY = 0.0;
+    double m_dfOpSelectionGridCellSize = 0.0;
+    std::map<std::pair<int, int>, int> m_oMapOpSelectionCache{};
+
+    int         SelectOperation( double x, double y,
+                                 int iExcluded0, int iExcluded1 ) const;
+    int         SelectOperationCached( double x, double y );
+
+    void        ReportTransformError( int err );
+
     void ComputeThreshold();
 
     OGRProjCT(const OGRProjCT& other)
@@ -799,6 +1154,16 @@ OGRCreateCoordinateTransformation( const OGRSpatialReference *poSource,
  * researched, and at each call to Transform(), the best of those candidate
  * regarding the centroid of the coordinate set will be dynamically selected.
  *
+ * Starting with GDAL 3.4, when no user defined coordinate transformation
+ * pipeline is specified, transformations from WGS84 geographic to WebMercator,
+ * and between a geographic CRS and a Transverse Mercator CRS (such as UTM)
+ * based on it, are done with analytical formulas without going through PROJ for
+ * each point. The results are the same as PROJ ones, within a few micrometres.
+ * Other transformations that use a single coordinate operation transform all
+ * the points of a Transform() call with a single PROJ call.
+ * This can be disabled by setting the OGR_CT_USE_FAST_PATH configuration
+ * option to NO.
+ *
  * @param poSource source spatial reference system.
  * @param poTarget target spatial reference system.
  * @param options Coordinate transformation options.
@@ -971,6 +1336,163 @@ void OGRProjCT::ComputeThreshold()
     }
 }
 
+/************************************************************************/
+/*                   IsProjectionOnlyTMercPipeline()                    */
+/************************************************************************/
+
+// Returns whether PROJ would transform from poSRSSource to poSRSTarget with a
+// single operation, made only of axis swapping, unit conversion and the exact
+// Transverse Mercator projection (forward or inverse). This is what the
+// OGRCTTransverseMercator fast path computes: any other pipeline (datum
+// shift, grid, different algorithm...) must go through PROJ.
+static bool IsProjectionOnlyTMercPipeline( const OGRSpatialReference* poSRSSource,
+                                           const OGRSpatialReference* poSRSTarget )
+{
+    auto ctx = OSRGetProjTLSContext();
+    char* pszSrcSRS = GetWktOrProjString(poSRSSource);
+    char* pszTargetSRS = GetWktOrProjString(poSRSTarget);
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    auto src = proj_create(ctx, pszSrcSRS);
+    auto dst = proj_create(ctx, pszTargetSRS);
+    CPLPopErrorHandler();
+    CPLFree(pszSrcSRS);
+    CPLFree(pszTargetSRS);
+
+    bool bRet = false;
+    auto operation_ctx = (src && dst) ?
+        proj_create_operation_factory_context(ctx, nullptr) : nullptr;
+    if( operation_ctx )
+    {
+        proj_operation_factory_context_set_grid_availability_use(
+            ctx, operation_ctx,
+            PROJ_GRID_AVAILABILITY_DISCARD_OPERATION_IF_MISSING_GRID);
+        auto op_list = proj_create_operations(ctx, src, dst, operation_ctx);
+        if( op_list && proj_list_get_count(op_list) == 1 )
+        {
+            auto op = proj_list_get(ctx, op_list, 0);
+            const char* pszProjString =
+                op ? proj_as_proj_string(ctx, op, PJ_PROJ_5, nullptr) : nullptr;
+            if( pszProjString &&
+                strstr(pszProjString, "+approx") == nullptr &&
+                strstr(pszProjString, "+algo=evenden_snyder") == nullptr )
+            {
+                const CPLStringList aosTokens(
+                    CSLTokenizeString2(pszProjString, " ", 0));
+                bool bHasTMerc = false;
+                bRet = true;
+                for( int i = 0; i < aosTokens.size(); i++ )
+                {
+                    if( !STARTS_WITH(aosTokens[i], "+proj=") )
+                        continue;
+                    const char* pszMethod = aosTokens[i] + strlen("+proj=");
+                    if( EQUAL(pszMethod, "tmerc") || EQUAL(pszMethod, "utm") )
+                        bHasTMerc = true;
+                    else if( !EQUAL(pszMethod, "pipeline") &&
+                             !EQUAL(pszMethod, "axisswap") &&
+                             !EQUAL(pszMethod, "unitconvert") )
+                        bRet = false;
+                }
+                bRet = bRet && bHasTMerc;
+            }
+            proj_destroy(op);
+        }
+        proj_list_destroy(op_list);
+        proj_operation_factory_context_destroy(operation_ctx);
+    }
+    proj_destroy(src);
+    proj_destroy(dst);
+    return bRet;
+}
+
+/************************************************************************/
+/*                    IsWebMercatorAndWGS84LongLat()                    */
+/************************************************************************/
+
+// Returns whether poSRSProj is the WebMercator CRS and poSRSGeog the WGS84
+// geographic CRS, so that the transformation between both can be done with
+// simple spherical formulas.
+static bool IsWebMercatorAndWGS84LongLat( const OGRSpatialReference* poSRSProj,
+                                          const OGRSpatialReference* poSRSGeog )
+{
+    bool bRet = false;
+    OGRAxisOrientation orientAxis0, orientAxis1;
+    if( poSRSProj->IsProjected() && poSRSGeog->IsGeographic() &&
+        poSRSGeog->GetAxis(nullptr, 0, &orientAxis0) != nullptr &&
+        poSRSGeog->GetAxis(nullptr, 1, &orientAxis1) != nullptr &&
+        ((orientAxis0 == OAO_North && orientAxis1 == OAO_East &&
+          poSRSGeog->GetDataAxisToSRSAxisMapping() == std::vector<int>{2,1}) ||
+         (orientAxis0 == OAO_East && orientAxis1 == OAO_North &&
+          poSRSGeog->GetDataAxisToSRSAxisMapping() == std::vector<int>{1,2})) )
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        char *pszProjProj4Defn = nullptr;
+        poSRSProj->exportToProj4( &pszProjProj4Defn );
+
+        char *pszGeogProj4Defn = nullptr;
+        poSRSGeog->exportToProj4( &pszGeogProj4Defn );
+        CPLPopErrorHandler();
+
+        if( pszProjProj4Defn && pszGeogProj4Defn )
+        {
+            if( pszProjProj4Defn[0] != '\0' &&
+                pszProjProj4Defn[strlen(pszProjProj4Defn)-1] == ' ' )
+                pszProjProj4Defn[strlen(pszProjProj4Defn)-1] = 0;
+            if( pszGeogProj4Defn[0] != '\0' &&
+                pszGeogProj4Defn[strlen(pszGeogProj4Defn)-1] == ' ' )
+                pszGeogProj4Defn[strlen(pszGeogProj4Defn)-1] = 0;
+            char* pszNeedle = strstr(pszProjProj4Defn, "  ");
+            if( pszNeedle )
+                memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
+            pszNeedle = strstr(pszGeogProj4Defn, "  ");
+            if( pszNeedle )
+                memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
+
+            if( (strstr(pszGeogProj4Defn, "+datum=WGS84") != nullptr ||
+                strstr(pszGeogProj4Defn,
+                        "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
+                strstr(pszProjProj4Defn, "+nadgrids=@null ") != nullptr &&
+                strstr(pszProjProj4Defn, "+towgs84") == nullptr )
+            {
+                char* pszDst = strstr(pszGeogProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
+                if( pszDst != nullptr)
+                {
+                    char* pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
+                    memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+                }
+                else
+                {
+                    memcpy(strstr(pszGeogProj4Defn, "+datum=WGS84"), "+ellps", 6);
+                }
+
+                pszDst = strstr(pszProjProj4Defn, "+nadgrids=@null ");
+                char* pszSrc = pszDst + strlen("+nadgrids=@null ");
+                memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+
+                pszDst = strstr(pszProjProj4Defn, "+wktext ");
+                if( pszDst )
+                {
+                    pszSrc = pszDst + strlen("+wktext ");
+                    memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+                }
+                bRet =
+                    strcmp(pszGeogProj4Defn,
+                        "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
+                    (strcmp(pszProjProj4Defn,
+                        "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 "
+                        "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0 ||
+                    strcmp(pszProjProj4Defn,
+                        "+proj=merc +a=6378137 +b=6378137 +lat_ts=0 +lon_0=0 "
+                        "+x_0=0 +y_0=0 +k=1 +units=m +no_defs") == 0);
+            }
+        }
+
+        CPLFree(pszProjProj4Defn);
+        CPLFree(pszGeogProj4Defn);
+    }
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                             Initialize()                             */
 /************************************************************************/
@@ -1076,82 +1598,69 @@ int OGRProjCT::Initialize( const OGRSpatialReference * poSourceIn,
 
     ComputeThreshold();
 
-    // Detect webmercator to WGS84
-    OGRAxisOrientation orientAxis0, orientAxis1;
-    if( options.d->osCoordOperation.empty() &&
-        poSRSSource && poSRSTarget &&
-        poSRSSource->IsProjected() && poSRSTarget->IsGeographic() &&
-        poSRSTarget->GetAxis(nullptr, 0, &orientAxis0) != nullptr &&
-        poSRSTarget->GetAxis(nullptr, 1, &orientAxis1) != nullptr &&
-        ((orientAxis0 == OAO_North && orientAxis1 == OAO_East &&
-          poSRSTarget->GetDataAxisToSRSAxisMapping() == std::vector<int>{2,1}) ||
-         (orientAxis0 == OAO_East && orientAxis1 == OAO_North &&
-          poSRSTarget->GetDataAxisToSRSAxisMapping() == std::vector<int>{1,2})) )
+    // Detect webmercator to WGS84, and the reverse direction
+    const bool bFastPathAllowed =
+        !options.d->bCheckWithInvertProj &&
+        CPLTestBool(CPLGetConfigOption("OGR_CT_USE_FAST_PATH", "YES"));
+    const bool bUseFastPath =
+        options.d->osCoordOperation.empty() && poSRSSource && poSRSTarget &&
+        bFastPathAllowed;
+    m_bBatchTransform = bFastPathAllowed;
+    if( options.d->osCoordOperation.empty() && poSRSSource && poSRSTarget )
     {
-        CPLPushErrorHandler(CPLQuietErrorHandler);
-        char *pszSrcProj4Defn = nullptr;
-        poSRSSource->exportToProj4( &pszSrcProj4Defn );
-
-        char *pszDstProj4Defn = nullptr;
-        poSRSTarget->exportToProj4( &pszDstProj4Defn );
-        CPLPopErrorHandler();
-
-        if( pszSrcProj4Defn && pszDstProj4Defn )
+        bWebMercatorToWGS84LongLat =
+            IsWebMercatorAndWGS84LongLat(poSRSSource, poSRSTarget);
+    }
+    if( bUseFastPath && !bWebMercatorToWGS84LongLat )
+    {
+        bWGS84LongLatToWebMercator =
+            IsWebMercatorAndWGS84LongLat(poSRSTarget, poSRSSource);
+    }
+
+    // Detect a geographic CRS to a Transverse Mercator CRS based on it, and
+    // the reverse direction. Not done if the approximate Transverse Mercator
+    // algorithm is requested, as we implement the exact one.
+    const char* pszETMERC = CPLGetConfigOption("OSR_USE_ETMERC", nullptr);
+    const char* pszApproxTMERC =
+        CPLGetConfigOption("OSR_USE_APPROX_TMERC", nullptr);
+    if( bUseFastPath && !bWebMercatorToWGS84LongLat &&
+        !bWGS84LongLatToWebMercator &&
+        !(pszETMERC && pszETMERC[0] && !CPLTestBool(pszETMERC)) &&
+        !(pszApproxTMERC && pszApproxTMERC[0] &&
+          CPLTestBool(pszApproxTMERC)) )
+    {
+        // InitFromCRS() only checks the CRS definitions: also make sure that
+        // PROJ would use the same projection-only pipeline.
+        if( m_oTMerc.InitFromCRS(poSRSSource, poSRSTarget) &&
+            IsProjectionOnlyTMercPipeline(poSRSSource, poSRSTarget) )
         {
-            if( pszSrcProj4Defn[0] != '\0' &&
-                pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] == ' ' )
-                pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] = 0;
-            if( pszDstProj4Defn[0] != '\0' &&
-                pszDstProj4Defn[strlen(pszDstProj4Defn)-1] == ' ' )
-                pszDstProj4Defn[strlen(pszDstProj4Defn)-1] = 0;
-            char* pszNeedle = strstr(pszSrcProj4Defn, "  ");
-            if( pszNeedle )
-                memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
-            pszNeedle = strstr(pszDstProj4Defn, "  ");
-            if( pszNeedle )
-                memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
-
-            if( (strstr(pszDstProj4Defn, "+datum=WGS84") != nullptr ||
-                strstr(pszDstProj4Defn,
-                        "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
-                strstr(pszSrcProj4Defn, "+nadgrids=@null ") != nullptr &&
-                strstr(pszSrcProj4Defn, "+towgs84") == nullptr )
-            {
-                char* pszDst = strstr(pszDstProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
-                if( pszDst != nullptr)
-                {
-                    char* pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
-                    memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-                }
-                else
-                {
-                    memcpy(strstr(pszDstProj4Defn, "+datum=WGS84"), "+ellps", 6);
-                }
-
-                pszDst = strstr(pszSrcProj4Defn, "+nadgrids=@null ");
-                char* pszSrc = pszDst + strlen("+nadgrids=@null ");
-                memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-
-                pszDst = strstr(pszSrcProj4Defn, "+wktext ");
-                if( pszDst )
-                {
-                    pszSrc = pszDst + strlen("+wktext ");
-                    memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-                }
-                bWebMercatorToWGS84LongLat =
-                    strcmp(pszDstProj4Defn,
-                        "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
-                    (strcmp(pszSrcProj4Defn,
-                        "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 "
-                        "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0 ||
-                    strcmp(pszSrcProj4Defn,
-                        "+proj=merc +a=6378137 +b=6378137 +lat_ts=0 +lon_0=0 "
-                        "+x_0=0 +y_0=0 +k=1 +units=m +no_defs") == 0);
-            }
+            m_bTMercFastPath = true;
+            m_bFastPathSwapIn = m_oTMerc.IsGeogNorthFirst();
+            m_bFastPathSwapOut = m_oTMerc.IsProjNorthFirst();
         }
-
-        CPLFree(pszSrcProj4Defn);
-        CPLFree(pszDstProj4Defn);
+        else if( m_oTMerc.InitFromCRS(poSRSTarget, poSRSSource) &&
+                 IsProjectionOnlyTMercPipeline(poSRSSource, poSRSTarget) )
+        {
+            m_bTMercFastPath = true;
+            m_bTMercInverse = true;
+            m_bFastPathSwapIn = m_oTMerc.IsProjNorthFirst();
+            m_bFastPathSwapOut = m_oTMerc.IsGeogNorthFirst();
+        }
+    }
+    else if( bWGS84LongLatToWebMercator )
+    {
+        OGRAxisOrientation eOrientation = OAO_Other;
+        poSRSSource->GetAxis(nullptr, 0, &eOrientation);
+        m_bFastPathSwapIn = eOrientation != OAO_East;
+        eOrientation = OAO_Other;
+        poSRSTarget->GetAxis(nullptr, 0, &eOrientation);
+        m_bFastPathSwapOut = eOrientation != OAO_East;
+    }
+    if( bWGS84LongLatToWebMercator || m_bTMercFastPath )
+    {
+        CPLDebug("OGRCT", "Using %s fast path",
+                 bWGS84LongLatToWebMercator ? "WebMercator" :
+                                              "Transverse Mercator");
     }
 
     const char* pszCTOpSelection = CPLGetConfigOption("OGR_CT_OP_SELECTION", nullptr);
@@ -1204,7 +1713,8 @@ int OGRProjCT::Initialize( const OGRSpatialReference * poSourceIn,
                  m_bReversePj ? "(reversed) " : "");
 #endif
     }
-    else if( !bWebMercatorToWGS84LongLat && poSRSSource && poSRSTarget )
+    else if( !bWebMercatorToWGS84LongLat && !bWGS84LongLatToWebMercator &&
+             !m_bTMercFastPath && poSRSSource && poSRSTarget )
     {
         const auto CanUseAuthorityDef = [](const OGRSpatialReference* poSRS1,
                                            OGRSpatialReference* poSRSFromAuth,
@@ -1815,6 +2325,183 @@ int OGRCoordinateTransformation::TransformWithErrorCodes(
     return bOverallSuccess;
 }
 
+/************************************************************************/
+/*                         GetLongitudeExtent()                         */
+/************************************************************************/
+
+// Compute the extent of a set of longitudes as the complement of the largest
+// interval without any longitude. When this interval does not contain the
+// antimeridian, the returned minimum is greater than the maximum.
+static void GetLongitudeExtent( std::vector<double>& adfLon,
+                                double& dfMin, double& dfMax )
+{
+    std::sort(adfLon.begin(), adfLon.end());
+    dfMin = adfLon.front();
+    dfMax = adfLon.back();
+    double dfLargestGap = 0;
+    size_t iLargestGap = 0;
+    for( size_t i = 1; i < adfLon.size(); i++ )
+    {
+        if( adfLon[i] - adfLon[i-1] > dfLargestGap )
+        {
+            dfLargestGap = adfLon[i] - adfLon[i-1];
+            iLargestGap = i;
+        }
+    }
+    if( dfLargestGap > 180 )
+    {
+        dfMin = adfLon[iLargestGap];
+        dfMax = adfLon[iLargestGap - 1];
+    }
+}
+
+/************************************************************************/
+/*                          TransformBounds()                           */
+/************************************************************************/
+
+int OGRCoordinateTransformation::TransformBounds( const double xmin,
+                                                  const double ymin,
+                                                  const double xmax,
+                                                  const double ymax,
+                                                  double* out_xmin,
+                                                  double* out_ymin,
+                                                  double* out_xmax,
+                                                  double* out_ymax,
+                                                  const int densify_pts )
+{
+    if( densify_pts < 0 || densify_pts > 10000 )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "densify_pts must be between 0 and 10000");
+        return FALSE;
+    }
+    if( !(xmin <= xmax) || !(ymin <= ymax) )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid bounding box: minimum greater than maximum");
+        return FALSE;
+    }
+
+    // Each edge contributes its first corner and densify_pts points, and all
+    // points are transformed at once.
+    const int nPointsPerEdge = densify_pts + 1;
+    const int nPoints = 4 * nPointsPerEdge;
+    std::vector<double> adfX(nPoints);
+    std::vector<double> adfY(nPoints);
+    for( int i = 0; i < nPointsPerEdge; i++ )
+    {
+        const double dfRatio = static_cast<double>(i) / nPointsPerEdge;
+        const double dfDX = (xmax - xmin) * dfRatio;
+        const double dfDY = (ymax - ymin) * dfRatio;
+        adfX[i] = xmin + dfDX;
+        adfY[i] = ymin;
+        adfX[nPointsPerEdge + i] = xmax;
+        adfY[nPointsPerEdge + i] = ymin + dfDY;
+        adfX[2 * nPointsPerEdge + i] = xmax - dfDX;
+        adfY[2 * nPointsPerEdge + i] = ymax;
+        adfX[3 * nPointsPerEdge + i] = xmin;
+        adfY[3 * nPointsPerEdge + i] = ymax - dfDY;
+    }
+
+    std::vector<int> abSuccess(nPoints);
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        Transform(nPoints, adfX.data(), adfY.data(), nullptr, nullptr,
+                  abSuccess.data());
+    }
+
+    // Index of the longitude among the data axes, if the target CRS is
+    // geographic.
+    int iLonAxis = -1;
+    OGRSpatialReference* poTargetCRS = GetTargetCS();
+    if( poTargetCRS && poTargetCRS->IsGeographic() )
+    {
+        const auto& mapping = poTargetCRS->GetDataAxisToSRSAxisMapping();
+        OGRAxisOrientation eOrientation = OAO_Other;
+        if( !mapping.empty() )
+            poTargetCRS->GetAxis(nullptr, std::abs(mapping[0]) - 1,
+                                 &eOrientation);
+        iLonAxis = (eOrientation == OAO_East ||
+                    eOrientation == OAO_West) ? 0 : 1;
+    }
+
+    std::vector<double> adfOut[2];
+    for( int i = 0; i < nPoints; i++ )
+    {
+        if( abSuccess[i] && std::isfinite(adfX[i]) &&
+            std::isfinite(adfY[i]) )
+        {
+            adfOut[0].push_back(adfX[i]);
+            adfOut[1].push_back(adfY[i]);
+        }
+    }
+    if( adfOut[0].empty() )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unable to transform any point of the bounding box");
+        return FALSE;
+    }
+
+    double adfMin[2];
+    double adfMax[2];
+    for( int iAxis = 0; iAxis < 2; iAxis++ )
+    {
+        if( iAxis == iLonAxis )
+        {
+            GetLongitudeExtent(adfOut[iAxis], adfMin[iAxis], adfMax[iAxis]);
+        }
+        else
+        {
+            const auto oMinMax = std::minmax_element(adfOut[iAxis].begin(),
+                                                     adfOut[iAxis].end());
+            adfMin[iAxis] = *oMinMax.first;
+            adfMax[iAxis] = *oMinMax.second;
+        }
+    }
+
+    // Extend the extent to the poles of the target geographic CRS that
+    // are inside the source bounding box.
+    OGRSpatialReference* poSourceCRS = GetSourceCS();
+    if( iLonAxis >= 0 && !(poSourceCRS && poSourceCRS->IsGeographic()) )
+    {
+        std::unique_ptr<OGRCoordinateTransformation> poInverse(GetInverse());
+        const int iLatAxis = 1 - iLonAxis;
+        for( const double dfPoleLat: { -90.0, 90.0 } )
+        {
+            if( poInverse == nullptr )
+                break;
+            double adfPole[2];
+            adfPole[iLonAxis] = 0.0;
+            adfPole[iLatAxis] = dfPoleLat;
+            int bSuccess = FALSE;
+            {
+                CPLErrorStateBackuper oErrorStateBackuper;
+                CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+                poInverse->Transform(1, &adfPole[0], &adfPole[1], nullptr,
+                                     nullptr, &bSuccess);
+            }
+            if( bSuccess &&
+                adfPole[0] >= xmin && adfPole[0] <= xmax &&
+                adfPole[1] >= ymin && adfPole[1] <= ymax )
+            {
+                if( dfPoleLat < 0 )
+                    adfMin[iLatAxis] = dfPoleLat;
+                else
+                    adfMax[iLatAxis] = dfPoleLat;
+                adfMin[iLonAxis] = -180.0;
+                adfMax[iLonAxis] = 180.0;
+            }
+        }
+    }
+
+    *out_xmin = adfMin[0];
+    *out_ymin = adfMin[1];
+    *out_xmax = adfMax[0];
+    *out_ymax = adfMax[1];
+    return TRUE;
+}
+
 /************************************************************************/
 /*                             Transform()                             */
 /************************************************************************/
@@ -1840,14 +2527,180 @@ int OGRProjCT::Transform( int nCount, double *x, double *y, double *z,
 }
 
 /************************************************************************/
-/*                       TransformWithErrorCodes()                      */
+/*                        ReportTransformError()                        */
 /************************************************************************/
 
-#ifndef PROJ_ERR_COORD_TRANSFM_INVALID_COORD
-#define PROJ_ERR_COORD_TRANSFM_INVALID_COORD             2049
-#define PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN 2050
-#define PROJ_ERR_COORD_TRANSFM_NO_OPERATION              2051
+// Try to report an error through CPL, with the PROJ error string if
+// possible. Try to avoid reporting thousands of errors: further error
+// reporting on this OGRProjCT is suppressed once 20 errors have been reported.
+void OGRProjCT::ReportTransformError( int err )
+{
+    if( ++nErrorCount < 20 )
+    {
+#if PROJ_VERSION_MAJOR >= 8
+        const char *pszError = proj_context_errno_string(
+            OSRGetProjTLSContext(), err);
+#else
+        const char *pszError = proj_errno_string(err);
 #endif
+        if( m_bEmitErrors )
+        {
+            if( pszError == nullptr )
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Reprojection failed, err = %d", err );
+            else
+                CPLError( CE_Failure, CPLE_AppDefined, "%s", pszError );
+        }
+        else
+        {
+            if( pszError == nullptr )
+                CPLDebug("OGRCT",
+                         "Reprojection failed, err = %d", err );
+            else
+                CPLDebug("OGRCT", "%s", pszError );
+        }
+    }
+    else if( nErrorCount == 20 )
+    {
+        if( m_bEmitErrors )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Reprojection failed, err = %d, further errors will be "
+                     "suppressed on the transform object.",
+                     err );
+        }
+        else
+        {
+            CPLDebug("OGRCT",
+                     "Reprojection failed, err = %d, further errors will be "
+                     "suppressed on the transform object.",
+                     err );
+        }
+    }
+}
+
+/************************************************************************/
+/*                          SelectOperation()                           */
+/************************************************************************/
+
+// Select, among m_oTransformations, the operation whose area of use contains
+// (x,y) and has the best accuracy if m_eStrategy == BEST_ACCURACY, or the
+// first matching one if m_eStrategy == FIRST_MATCHING. Returns -1 if none.
+int OGRProjCT::SelectOperation( double x, double y,
+                                int iExcluded0, int iExcluded1 ) const
+{
+    int iBestTransf = -1;
+    double dfBestAccuracy = std::numeric_limits<double>::infinity();
+    const int nOperations = static_cast<int>(m_oTransformations.size());
+    for( int i = 0; i < nOperations; i++ )
+    {
+        if( i == iExcluded0 || i == iExcluded1 )
+        {
+            continue;
+        }
+        const auto& transf = m_oTransformations[i];
+        if( x >= transf.minx && x <= transf.maxx &&
+            y >= transf.miny && y <= transf.maxy &&
+            (iBestTransf < 0 || (transf.accuracy >= 0 &&
+                                 transf.accuracy < dfBestAccuracy)) )
+        {
+            iBestTransf = i;
+            dfBestAccuracy = transf.accuracy;
+            if( m_eStrategy == Strategy::FIRST_MATCHING )
+                break;
+        }
+    }
+    return iBestTransf;
+}
+
+/************************************************************************/
+/*                       SelectOperationCached()                        */
+/************************************************************************/
+
+// Same as SelectOperation() without excluded operations, but caching the
+// result per cell of a regular grid covering the areas of use of the
+// operations. The result is only cached for cells that are entirely inside or
+// outside the area of use of each operation, in which case it is the same for
+// all points of the cell.
+int OGRProjCT::SelectOperationCached( double x, double y )
+{
+    if( !m_bOpSelectionGridInitialized )
+    {
+        m_bOpSelectionGridInitialized = true;
+        double dfMinX = std::numeric_limits<double>::infinity();
+        double dfMinY = std::numeric_limits<double>::infinity();
+        double dfMaxX = -std::numeric_limits<double>::infinity();
+        double dfMaxY = -std::numeric_limits<double>::infinity();
+        for( const auto& transf: m_oTransformations )
+        {
+            dfMinX = std::min(dfMinX, transf.minx);
+            dfMinY = std::min(dfMinY, transf.miny);
+            dfMaxX = std::max(dfMaxX, transf.maxx);
+            dfMaxY = std::max(dfMaxY, transf.maxy);
+        }
+        constexpr int GRID_SIZE = 1024;
+        const double dfCellSize =
+            std::max(dfMaxX - dfMinX, dfMaxY - dfMinY) / GRID_SIZE;
+        if( std::isfinite(dfMinX) && std::isfinite(dfMinY) &&
+            std::isfinite(dfCellSize) && dfCellSize > 0 )
+        {
+            m_dfOpSelectionGridOriginX = dfMinX;
+            m_dfOpSelectionGridOriginY = dfMinY;
+            m_dfOpSelectionGridCellSize = dfCellSize;
+        }
+    }
+
+    const double dfCellX =
+        floor((x - m_dfOpSelectionGridOriginX) / m_dfOpSelectionGridCellSize);
+    const double dfCellY =
+        floor((y - m_dfOpSelectionGridOriginY) / m_dfOpSelectionGridCellSize);
+    // Also false when the grid could not be set up.
+    if( !(std::fabs(dfCellX) < 1e6 && std::fabs(dfCellY) < 1e6) )
+        return SelectOperation(x, y, -1, -1);
+
+    const std::pair<int, int> oKey(static_cast<int>(dfCellX),
+                                   static_cast<int>(dfCellY));
+    const auto oIter = m_oMapOpSelectionCache.find(oKey);
+    if( oIter != m_oMapOpSelectionCache.end() )
+        return oIter->second;
+
+    const int iBestTransf = SelectOperation(x, y, -1, -1);
+
+    // Use a small margin to be robust to the rounding of the computation of
+    // the cell of a point.
+    const double dfEps = m_dfOpSelectionGridCellSize * 1e-6;
+    const double dfCellMinX = m_dfOpSelectionGridOriginX +
+                              dfCellX * m_dfOpSelectionGridCellSize - dfEps;
+    const double dfCellMinY = m_dfOpSelectionGridOriginY +
+                              dfCellY * m_dfOpSelectionGridCellSize - dfEps;
+    const double dfCellMaxX =
+        dfCellMinX + m_dfOpSelectionGridCellSize + 2 * dfEps;
+    const double dfCellMaxY =
+        dfCellMinY + m_dfOpSelectionGridCellSize + 2 * dfEps;
+    for( const auto& transf: m_oTransformations )
+    {
+        const bool bInside = dfCellMinX >= transf.minx &&
+                             dfCellMaxX <= transf.maxx &&
+                             dfCellMinY >= transf.miny &&
+                             dfCellMaxY <= transf.maxy;
+        const bool bOutside = dfCellMaxX < transf.minx ||
+                              dfCellMinX > transf.maxx ||
+                              dfCellMaxY < transf.miny ||
+                              dfCellMinY > transf.maxy;
+        if( !bInside && !bOutside )
+            return iBestTransf;
+    }
+
+    constexpr size_t MAX_CACHED_CELLS = 10000;
+    if( m_oMapOpSelectionCache.size() >= MAX_CACHED_CELLS )
+        m_oMapOpSelectionCache.clear();
+    m_oMapOpSelectionCache[oKey] = iBestTransf;
+    return iBestTransf;
+}
+
+/************************************************************************/
+/*                       TransformWithErrorCodes()                      */
+/************************************************************************/
 
 int OGRProjCT::TransformWithErrorCodes(
             int nCount, double *x, double *y, double *z, double* t,
@@ -2057,6 +2910,45 @@ int OGRProjCT::TransformWithErrorCodes(
         bTransformDone = true;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Optimized transform from WGS84 to WebMercator, and between a    */
+/*      geographic CRS and a Transverse Mercator CRS based on it.       */
+/* -------------------------------------------------------------------- */
+    if( bWGS84LongLatToWebMercator || m_bTMercFastPath )
+    {
+        for( int i = 0; i < nCount; i++ )
+        {
+            double dfX = m_bFastPathSwapIn ? y[i] : x[i];
+            double dfY = m_bFastPathSwapIn ? x[i] : y[i];
+            int err;
+            if( !std::isfinite(dfX) || !std::isfinite(dfY) )
+                err = PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
+            else if( bWGS84LongLatToWebMercator )
+                err = OGRCTWGS84LongLatToWebMercator(dfX, dfY);
+            else if( m_bTMercInverse )
+                err = m_oTMerc.Inverse(dfX, dfY);
+            else
+                err = m_oTMerc.Forward(dfX, dfY);
+
+            if( err == 0 )
+            {
+                x[i] = m_bFastPathSwapOut ? dfY : dfX;
+                y[i] = m_bFastPathSwapOut ? dfX : dfY;
+            }
+            else
+            {
+                if( std::isfinite(x[i]) && std::isfinite(y[i]) )
+                    ReportTransformError(err);
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+            }
+            if( panErrorCodes )
+                panErrorCodes[i] = err;
+        }
+
+        bTransformDone = true;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Select dynamically the best transformation for the data, if     */
 /*      needed.                                                         */
@@ -2101,29 +2993,12 @@ int OGRProjCT::TransformWithErrorCodes(
         // grid.
         for( int iRetry = 0; iRetry <= N_MAX_RETRY; iRetry++ )
         {
-            int iBestTransf = -1;
             // Select transform whose BBOX match our data and has the best accuracy
             // if m_eStrategy == BEST_ACCURACY. Or just the first BBOX matching one, if
             //  m_eStrategy == FIRST_MATCHING
-            double dfBestAccuracy = std::numeric_limits<double>::infinity();
-            for( int i = 0; i < nOperations; i++ )
-            {
-                if( i == iExcluded[0] || i == iExcluded[1] )
-                {
-                    continue;
-                }
-                const auto& transf = m_oTransformations[i];
-                if( avgX >= transf.minx && avgX <= transf.maxx &&
-                    avgY >= transf.miny && avgY <= transf.maxy &&
-                    (iBestTransf < 0 || (transf.accuracy >= 0 &&
-                                        transf.accuracy < dfBestAccuracy)) )
-                {
-                    iBestTransf = i;
-                    dfBestAccuracy = transf.accuracy;
-                    if( m_eStrategy == Strategy::FIRST_MATCHING )
-                        break;
-                }
-            }
+            const int iBestTransf = iRetry == 0 ?
+                SelectOperationCached(avgX, avgY) :
+                SelectOperation(avgX, avgY, iExcluded[0], iExcluded[1]);
             if( iBestTransf < 0 )
             {
                 break;
@@ -2210,6 +3085,91 @@ int OGRProjCT::TransformWithErrorCodes(
 /*      Do the transformation (or not...) using PROJ                    */
 /* -------------------------------------------------------------------- */
 
+#if PROJ_VERSION_MAJOR >= 7
+    // Only for single operations: when proj_create_crs_to_crs() returns a
+    // set of candidate operations (of unknown type), the operation is
+    // selected per point, and failed points would be transformed twice.
+    if( !bTransformDone && m_bBatchTransform &&
+        proj_get_type(pj) != PJ_TYPE_UNKNOWN )
+    {
+        // Transform all points with a single proj_trans_generic() call.
+        // As it does not report per-point errors, failed points are
+        // transformed again individually from their saved input
+        // coordinates to retrieve the error code.
+        std::vector<double> adfXIn(x, x + nCount);
+        std::vector<double> adfYIn(y, y + nCount);
+        std::vector<double> adfZIn;
+        std::vector<double> adfTIn;
+        if( z )
+            adfZIn.assign(z, z + nCount);
+        if( t )
+            adfTIn.assign(t, t + nCount);
+        for( int i = 0; i < nCount; i++ )
+        {
+            if( !std::isfinite(x[i]) )
+            {
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+            }
+        }
+
+        const size_t nZCount = z ? static_cast<size_t>(nCount) : 0;
+        const size_t nTCount = t ? static_cast<size_t>(nCount) : 0;
+        proj_errno_reset(pj);
+        proj_trans_generic(pj, m_bReversePj ? PJ_INV : PJ_FWD,
+                           x, sizeof(double), nCount,
+                           y, sizeof(double), nCount,
+                           z, sizeof(double), nZCount,
+                           t, sizeof(double), nTCount);
+        proj_errno_reset(pj);
+
+        for( int i = 0; i < nCount; i++ )
+        {
+            int err = 0;
+            if( !std::isfinite(adfXIn[i]) )
+            {
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+                if( z )
+                    z[i] = adfZIn[i];
+                if( t )
+                    t[i] = adfTIn[i];
+                err = PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
+            }
+            else if( x[i] == HUGE_VAL )
+            {
+                PJ_COORD coord;
+                coord.xyzt.x = adfXIn[i];
+                coord.xyzt.y = adfYIn[i];
+                coord.xyzt.z = z ? adfZIn[i] : 0;
+                coord.xyzt.t = t ? adfTIn[i] : HUGE_VAL;
+                proj_errno_reset(pj);
+                coord = proj_trans(pj, m_bReversePj ? PJ_INV : PJ_FWD, coord);
+                x[i] = coord.xyzt.x;
+                y[i] = coord.xyzt.y;
+                if( z )
+                    z[i] = coord.xyzt.z;
+                if( t )
+                    t[i] = coord.xyzt.t;
+                if( coord.xyzt.x == HUGE_VAL )
+                {
+                    err = proj_errno(pj);
+                    // PROJ should normally emit an error, but in case it does not
+                    // (e.g PROJ 6.3 with the +ortho projection), synthetize one
+                    if( err == 0 )
+                        err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+                    ReportTransformError(err);
+                }
+            }
+
+            if( panErrorCodes )
+                panErrorCodes[i] = err;
+        }
+
+        bTransformDone = true;
+    }
+#endif
+
     if( !bTransformDone )
     {
         for( int i = 0; i < nCount; i++ )
@@ -2264,56 +3224,8 @@ int OGRProjCT::TransformWithErrorCodes(
             if( panErrorCodes )
                 panErrorCodes[i] = err;
 
-/* -------------------------------------------------------------------- */
-/*      Try to report an error through CPL.  Get proj error string      */
-/*      if possible.  Try to avoid reporting thousands of errors.       */
-/*      Suppress further error reporting on this OGRProjCT if we        */
-/*      have already reported 20 errors.                                */
-/* -------------------------------------------------------------------- */
             if( err != 0 )
-            {
-                if( ++nErrorCount < 20 )
-                {
-#if PROJ_VERSION_MAJOR >= 8
-                    const char *pszError = proj_context_errno_string(ctx, err);
-#else
-                    const char *pszError = proj_errno_string(err);
-#endif
-                    if( m_bEmitErrors )
-                    {
-                        if( pszError == nullptr )
-                            CPLError( CE_Failure, CPLE_AppDefined,
-                                      "Reprojection failed, err = %d", err );
-                        else
-                            CPLError( CE_Failure, CPLE_AppDefined, "%s", pszError );
-                    }
-                    else
-                    {
-                        if( pszError == nullptr )
-                            CPLDebug("OGRCT",
-                                     "Reprojection failed, err = %d", err );
-                        else
-                            CPLDebug("OGRCT", "%s", pszError );
-                    }
-                }
-                else if( nErrorCount == 20 )
-                {
-                    if( m_bEmitErrors )
-                    {
-                        CPLError(CE_Failure, CPLE_AppDefined,
-                                 "Reprojection failed, err = %d, further errors will be "
-                                 "suppressed on the transform object.",
-                                 err );
-                    }
-                    else
-                    {
-                        CPLDebug("OGRCT",
-                                 "Reprojection failed, err = %d, further errors will be "
-                                 "suppressed on the transform object.",
-                                 err );
-                    }
-                }
-            }
+                ReportTransformError(err);
         }
     }
 
@@ -2445,6 +3357,8 @@ OGRCoordinateTransformation* OGRProjCT::GetInverse() const
 
     poNewCT->m_pj = new_pj;
     poNewCT->m_bReversePj = !m_bReversePj;
+    poNewCT->m_bBatchTransform =
+        m_bBatchTransform && !newOptions.d->bCheckWithInvertProj;
     poNewCT->bNoTransform = bNoTransform;
     poNewCT->m_eStrategy = m_eStrategy;
     poNewCT->m_options = newOptions;
@@ -2493,6 +3407,13 @@ CTCacheKey OGRProjCT::MakeCacheKey(const OGRSpatialReference* poSRS1,
     std::string ret( GetKeyForSRS(poSRS1) );
     ret += GetKeyForSRS(poSRS2);
     ret += options.d->GetKey();
+    // Whether the analytical fast paths may be used, and which Transverse
+    // Mercator algorithm is used, as they change the instantiated pipeline
+    ret += CPLGetConfigOption("OGR_CT_USE_FAST_PATH", "YES");
+    ret += '|';
+    ret += CPLGetConfigOption("OSR_USE_ETMERC", "");
+    ret += '|';
+    ret += CPLGetConfigOption("OSR_USE_APPROX_TMERC", "");
     return ret;
 }
 
@@ -2650,6 +3571,43 @@ int OCTTransform4DWithErrorCodes( OGRCoordinateTransformationH hTransform,
         TransformWithErrorCodes( nCount, x, y, z, t, panErrorCodes );
 }
 
+/************************************************************************/
+/*                         OCTTransformBounds()                         */
+/************************************************************************/
+
+/** \brief Transform a bounding box from source to destination space.
+ *
+ * This function is the same as OGRCoordinateTransformation::TransformBounds().
+ *
+ * @param hTransform Transformation object
+ * @param xmin Minimum bounding coordinate of the first axis in source CRS.
+ * @param ymin Minimum bounding coordinate of the second axis in source CRS.
+ * @param xmax Maximum bounding coordinate of the first axis in source CRS.
+ * @param ymax Maximum bounding coordinate of the second axis in source CRS.
+ * @param out_xmin Minimum bounding coordinate of the first axis in target CRS.
+ * @param out_ymin Minimum bounding coordinate of the second axis in target CRS.
+ * @param out_xmax Maximum bounding coordinate of the first axis in target CRS.
+ * @param out_ymax Maximum bounding coordinate of the second axis in target CRS.
+ * @param densify_pts Number of points to add to each edge of the bounding box.
+ * @return TRUE or FALSE
+ * @since GDAL 3.4
+ */
+int OCTTransformBounds( OGRCoordinateTransformationH hTransform,
+                        const double xmin, const double ymin,
+                        const double xmax, const double ymax,
+                        double* out_xmin, double* out_ymin,
+                        double* out_xmax, double* out_ymax,
+                        const int densify_pts )
+
+{
+    VALIDATE_POINTER1( hTransform, "OCTTransformBounds", FALSE );
+
+    return OGRCoordinateTransformation::FromHandle(hTransform)->
+        TransformBounds( xmin, ymin, xmax, ymax,
+                         out_xmin, out_ymin, out_xmax, out_ymax,
+                         densify_pts );
+}
+
 /************************************************************************/
 /*                         OGRCTDumpStatistics()                        */
 /************************************************************************/
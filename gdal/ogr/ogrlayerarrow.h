@@ -0,0 +1,117 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Helper to build Arrow arrays from OGR features.
+ *
+ ******************************************************************************
+ * Copyright (c) 2022, GDAL developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef OGRLAYERARROW_H_INCLUDED
+#define OGRLAYERARROW_H_INCLUDED
+
+//! @cond Doxygen_Suppress
+
+#include "cpl_port.h"
+#include "ogr_feature.h"
+#include "ogr_recordbatch.h"
+
+#include <memory>
+#include <vector>
+
+/************************************************************************/
+/*                          OGRArrowArrayHelper                         */
+/************************************************************************/
+
+/** Helper to build a batch of features as an Arrow struct array, whose
+ * children are the FID column (if INCLUDE_FID=YES), the non-ignored
+ * attribute fields and the non-ignored geometry fields (as WKB).
+ *
+ * Drivers that can read their records without instantiating OGRFeature
+ * objects use the setters with the index of the row in the batch. Values
+ * that are not set are null. Values of string, binary, list and geometry
+ * fields must be set in increasing row order.
+ */
+class CPL_DLL OGRArrowArrayHelper
+{
+  public:
+    static constexpr int DEFAULT_MAX_FEATURES_IN_BATCH = 65536;
+
+    static int GetSchema( OGRFeatureDefn* poFeatureDefn,
+                          const char* pszFIDName,
+                          CSLConstList papszOptions,
+                          struct ArrowSchema* out_schema );
+
+    OGRArrowArrayHelper( OGRFeatureDefn* poFeatureDefn,
+                         CSLConstList papszOptions,
+                         struct ArrowArray* out_array );
+    ~OGRArrowArrayHelper();
+
+    bool IsValid() const { return m_bValid; }
+    int  GetMaxFeatureCount() const { return m_nMaxFeatures; }
+
+    /** Whether the field (or geometry field) is part of the array. */
+    bool IsFieldSelected( int iField ) const
+                                    { return m_anFieldColumn[iField] >= 0; }
+    bool IsGeomFieldSelected( int iGeomField ) const
+                            { return m_anGeomFieldColumn[iGeomField] >= 0; }
+
+    void SetFID( int iRow, GIntBig nFID );
+
+    // Integer fields, whatever their sub-type
+    void SetInteger( int iField, int iRow, GIntBig nValue );
+    // Real fields, whatever their sub-type
+    void SetReal( int iField, int iRow, double dfValue );
+    // String or binary fields
+    bool SetBytes( int iField, int iRow, const void* pData, size_t nLen );
+    // Date, Time or DateTime fields
+    void SetDateTime( int iField, int iRow, const OGRField* psField );
+    // Any type of field
+    bool SetField( int iField, int iRow, const OGRField* psField );
+
+    bool SetGeometry( int iGeomField, int iRow, const OGRGeometry* poGeom );
+    bool SetWKB( int iGeomField, int iRow, const GByte* pabyWKB,
+                 size_t nWKBSize );
+
+    bool SetFeature( int iRow, const OGRFeature* poFeature );
+
+    bool Finalize( int nRows );
+
+  private:
+    struct Column;
+
+    bool                                 m_bValid = false;
+    OGRFeatureDefn                      *m_poFeatureDefn = nullptr;
+    struct ArrowArray                   *m_psOutArray = nullptr;
+    int                                  m_nMaxFeatures =
+                                            DEFAULT_MAX_FEATURES_IN_BATCH;
+    int                                  m_nFIDColumn = -1;
+    std::vector<int>                     m_anFieldColumn{};
+    std::vector<int>                     m_anGeomFieldColumn{};
+    std::vector<std::unique_ptr<Column>> m_apoColumns{};
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRArrowArrayHelper)
+};
+
+//! @endcond
+
+#endif  /* OGRLAYERARROW_H_INCLUDED */
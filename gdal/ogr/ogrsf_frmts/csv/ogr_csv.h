@@ -33,6 +33,7 @@
 
 #include "ogrsf_frmts.h"
 
+#include <memory>
 #include <set>
 
 #if defined(_MSC_VER) && _MSC_VER <= 1600 // MSVC <= 2010
@@ -72,8 +73,12 @@ void OGRCSVDriverRemoveFromMap(const char *pszName, GDALDataset *poDS);
 /*                             OGRCSVLayer                              */
 /************************************************************************/
 
+class OGRCSVParallelReader;
+
 class OGRCSVLayer final: public OGRLayer
 {
+    friend class OGRCSVParallelReader;
+
   public:
 
     enum class StringQuoting
@@ -94,6 +99,10 @@ class OGRCSVLayer final: public OGRLayer
     bool                bHasFieldNames;
 
     OGRFeature         *GetNextUnfilteredFeature();
+    OGRFeature         *ReadNextFeature();
+    OGRFeature         *TranslateFeature( char **papszTokens, int nFID,
+                                          bool &bWarned,
+                                          CPLString *posDeferredWarning ) const;
 
     bool                bNew;
     bool                bInWriteMode;
@@ -142,6 +151,9 @@ class OGRCSVLayer final: public OGRLayer
 
     StringQuoting       m_eStringQuoting = StringQuoting::IF_AMBIGUOUS;
 
+    int                 m_nNumThreads = 1;
+    std::unique_ptr<OGRCSVParallelReader> m_poParallelReader{};
+
     char              **GetNextLineTokens();
 
     static bool         Matches( const char *pszFieldName,
@@ -173,6 +185,7 @@ class OGRCSVLayer final: public OGRLayer
     void                ResetReading() override;
     OGRFeature         *GetNextFeature() override;
     virtual OGRFeature *GetFeature( GIntBig nFID ) override;
+    virtual OGRErr      SetIgnoredFields( const char **papszFields ) override;
 
     OGRFeatureDefn     *GetLayerDefn() override { return poFeatureDefn; }
 
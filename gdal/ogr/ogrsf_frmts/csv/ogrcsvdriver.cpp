@@ -374,6 +374,7 @@ void RegisterOGRCSV()
 "    <Value>AUTO</Value>"
 "  </Option>"
 "  <Option name='EMPTY_STRING_AS_NULL' type='boolean' description='Whether to consider empty strings as null fields on reading' default='NO'/>"
+"  <Option name='NUM_THREADS' type='string' description='Number of worker threads used to translate records into features, or ALL_CPUS'/>"
 "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
@@ -40,8 +40,12 @@
 #  include <fcntl.h>
 #endif
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -49,6 +53,8 @@
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -225,6 +231,394 @@ char **OGRCSVReadParseLineL( VSILFILE *fp, char chDelimiter,
     return papszReturn;
 }
 
+/************************************************************************/
+/*                        OGRCSVReportWarning()                         */
+/************************************************************************/
+
+static void OGRCSVReportWarning( CPLString *posDeferredWarning,
+                                 const char *pszMsg )
+{
+    if( posDeferredWarning != nullptr )
+        *posDeferredWarning = pszMsg;
+    else
+        CPLError(CE_Warning, CPLE_AppDefined, "%s", pszMsg);
+}
+
+/************************************************************************/
+/*                        OGRCSVGetLineExtent()                         */
+/*                                                                      */
+/*      Locate the line starting at nStart in a memory buffer, with     */
+/*      the same end-of-line rules as CPLReadLineL(): CRLF and LFCR     */
+/*      are a single line ending. Returns 1 if a line is found, 0 if    */
+/*      more data is needed and -1 at end of data.                      */
+/************************************************************************/
+
+static int OGRCSVGetLineExtent( const char *pszData, size_t nSize,
+                                size_t nStart, bool bEOF,
+                                size_t &nLineEnd, size_t &nNext )
+{
+    if( nStart >= nSize )
+        return bEOF ? -1 : 0;
+
+    size_t i = nStart;
+    while( i < nSize && pszData[i] != 13 && pszData[i] != 10 )
+        i++;
+    nLineEnd = i;
+
+    // The byte following a line ending must be known to tell a CRLF from
+    // a CR followed by an empty line.
+    if( i + 1 >= nSize )
+    {
+        if( !bEOF )
+            return 0;
+        nNext = nSize;
+        return 1;
+    }
+
+    const bool bTwoCharsEOL = (pszData[i] == 13 && pszData[i + 1] == 10) ||
+                              (pszData[i] == 10 && pszData[i + 1] == 13);
+    nNext = i + (bTwoCharsEOL ? 2 : 1);
+    return 1;
+}
+
+/************************************************************************/
+/*                     OGRCSVGetLineContentLength()                     */
+/*                                                                      */
+/*      Length of a line as seen through the nul-terminated string      */
+/*      returned by CPLReadLineL().                                     */
+/************************************************************************/
+
+static size_t OGRCSVGetLineContentLength( const char *pszLine, size_t nLen )
+{
+    const void *pNul = memchr(pszLine, 0, nLen);
+    return pNul ? static_cast<size_t>(static_cast<const char *>(pNul) - pszLine)
+                : nLen;
+}
+
+static bool OGRCSVStartsWithBOM( const char *pszLine, size_t nLen )
+{
+    const GByte *pabyData = reinterpret_cast<const GByte *>(pszLine);
+    return nLen >= 3 && pabyData[0] == 0xEF && pabyData[1] == 0xBB &&
+           pabyData[2] == 0xBF;
+}
+
+/************************************************************************/
+/*                       OGRCSVGetRecordExtent()                        */
+/*                                                                      */
+/*      Locate the record starting at nStart, using the same rules      */
+/*      as OGRCSVReadParseLineL(): lines are appended as long as the    */
+/*      number of double quotes is odd. bEmpty is set if the record     */
+/*      has no token. Returns as OGRCSVGetLineExtent().                 */
+/************************************************************************/
+
+static int OGRCSVGetRecordExtent( const char *pszData, size_t nSize,
+                                  size_t nStart, bool bEOF,
+                                  bool bHonourStrings,
+                                  size_t &nRecordEnd, bool &bEmpty )
+{
+    size_t nLineEnd = 0;
+    size_t nNext = 0;
+    const int nRet =
+        OGRCSVGetLineExtent(pszData, nSize, nStart, bEOF, nLineEnd, nNext);
+    if( nRet <= 0 )
+        return nRet;
+
+    size_t nLineStart = nStart;
+    if( OGRCSVStartsWithBOM(pszData + nStart, nLineEnd - nStart) )
+        nLineStart += 3;
+    size_t nLen = OGRCSVGetLineContentLength(pszData + nLineStart,
+                                             nLineEnd - nLineStart);
+    bEmpty = nLen == 0;
+
+    if( bHonourStrings )
+    {
+        size_t nQuotes = static_cast<size_t>(
+            std::count(pszData + nLineStart, pszData + nLineStart + nLen, '"'));
+        while( (nQuotes % 2) != 0 )
+        {
+            nLineStart = nNext;
+            const int nRetNext = OGRCSVGetLineExtent(pszData, nSize, nLineStart,
+                                                     bEOF, nLineEnd, nNext);
+            if( nRetNext == 0 )
+                return 0;
+            if( nRetNext < 0 )
+                break;
+            nLen = OGRCSVGetLineContentLength(pszData + nLineStart,
+                                              nLineEnd - nLineStart);
+            nQuotes += static_cast<size_t>(std::count(
+                pszData + nLineStart, pszData + nLineStart + nLen, '"'));
+        }
+    }
+
+    nRecordEnd = nNext;
+    return 1;
+}
+
+/************************************************************************/
+/*                         OGRCSVSplitRecord()                          */
+/*                                                                      */
+/*      Tokenize a record located by OGRCSVGetRecordExtent() exactly    */
+/*      as OGRCSVReadParseLineL() would have done.                      */
+/************************************************************************/
+
+static char **OGRCSVSplitRecord( const char *pszData, size_t nStart,
+                                 size_t nEnd, char chDelimiter,
+                                 bool bDontHonourStrings,
+                                 bool bMergeDelimiter )
+{
+    std::string osRecord;
+    size_t nLineStart = nStart;
+    size_t nLineEnd = 0;
+    size_t nNext = 0;
+    while( OGRCSVGetLineExtent(pszData, nEnd, nLineStart, true,
+                               nLineEnd, nNext) > 0 )
+    {
+        size_t nContentStart = nLineStart;
+        if( nLineStart == nStart )
+        {
+            if( OGRCSVStartsWithBOM(pszData + nLineStart,
+                                    nLineEnd - nLineStart) )
+                nContentStart += 3;
+        }
+        else
+        {
+            // The '\n' gets lost in CPLReadLine().
+            osRecord += '\n';
+        }
+        osRecord.append(pszData + nContentStart,
+                        OGRCSVGetLineContentLength(pszData + nContentStart,
+                                                   nLineEnd - nContentStart));
+        nLineStart = nNext;
+    }
+
+    if( chDelimiter == '\t' && bDontHonourStrings )
+        return CSLTokenizeStringComplex(osRecord.c_str(), "\t", FALSE, TRUE);
+
+    return CSVSplitLine(osRecord.c_str(), chDelimiter, false, bMergeDelimiter);
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         OGRCSVParallelReader                         */
+/* ==================================================================== */
+/*      Splits the file, from its current position, into chunks of      */
+/*      whole records that worker threads translate into features.      */
+/*      Chunks are delivered in file order, so that FIDs and            */
+/*      warnings are the same as with sequential reading.               */
+/************************************************************************/
+
+class OGRCSVParallelReader
+{
+    struct Chunk
+    {
+        OGRCSVParallelReader *poReader = nullptr;
+        std::string osData{};
+        std::vector<std::pair<size_t, size_t>> anRecords{};
+        int nFirstFID = 0;
+        std::vector<OGRFeature *> apoFeatures{};
+        CPLString osWarning{};
+        size_t nWarningIdx = 0;
+        bool bDone = false;
+    };
+
+    OGRCSVLayer *m_poLayer = nullptr;
+    bool m_bHonourStrings = true;
+    size_t m_nChunkSize = 0;
+    size_t m_nMaxChunks = 0;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::deque<std::unique_ptr<Chunk>> m_apoChunks{};
+    size_t m_iNextFeature = 0;
+    std::string m_osPending{};
+    bool m_bEOF = false;
+    int m_nNextChunkFID = 0;
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+
+    bool ReadChunk();
+    static void ParseChunk( void *pData );
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRCSVParallelReader)
+
+  public:
+    OGRCSVParallelReader( OGRCSVLayer *poLayer, int nThreads, int nFirstFID );
+    ~OGRCSVParallelReader();
+
+    OGRFeature *GetNextFeature();
+};
+
+/************************************************************************/
+/*                        OGRCSVParallelReader()                        */
+/************************************************************************/
+
+OGRCSVParallelReader::OGRCSVParallelReader( OGRCSVLayer *poLayer,
+                                            int nThreads, int nFirstFID ) :
+    m_poLayer(poLayer),
+    m_bHonourStrings(!(poLayer->chDelimiter == '\t' &&
+                       poLayer->bDontHonourStrings)),
+    // Mostly for testing purposes.
+    m_nChunkSize(static_cast<size_t>(std::max(
+        1, atoi(CPLGetConfigOption("OGR_CSV_CHUNK_SIZE", "1000000"))))),
+    m_nMaxChunks(2 * static_cast<size_t>(nThreads)),
+    m_nNextChunkFID(nFirstFID)
+{
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if( poThreadPool )
+        m_poJobQueue = poThreadPool->CreateJobQueue();
+}
+
+/************************************************************************/
+/*                       ~OGRCSVParallelReader()                        */
+/************************************************************************/
+
+OGRCSVParallelReader::~OGRCSVParallelReader()
+{
+    if( m_poJobQueue )
+        m_poJobQueue->WaitCompletion();
+    for( const auto &poChunk : m_apoChunks )
+    {
+        for( OGRFeature *poFeature : poChunk->apoFeatures )
+            delete poFeature;
+    }
+}
+
+/************************************************************************/
+/*                             ReadChunk()                              */
+/*                                                                      */
+/*      Read the next chunk of whole records and queue its              */
+/*      translation. Returns false at end of file.                      */
+/************************************************************************/
+
+bool OGRCSVParallelReader::ReadChunk()
+{
+    std::vector<std::pair<size_t, size_t>> anRecords;
+    size_t nPos = 0;
+    while( nPos < m_nChunkSize )
+    {
+        size_t nRecordEnd = 0;
+        bool bEmpty = false;
+        const int nRet = OGRCSVGetRecordExtent(
+            m_osPending.data(), m_osPending.size(), nPos, m_bEOF,
+            m_bHonourStrings, nRecordEnd, bEmpty);
+        if( nRet < 0 )
+            break;
+        if( nRet == 0 )
+        {
+            // Grow geometrically so that very long records are not
+            // rescanned too many times.
+            const size_t nOldSize = m_osPending.size();
+            const size_t nToRead = std::max(m_nChunkSize, nOldSize - nPos);
+            m_osPending.resize(nOldSize + nToRead);
+            const size_t nRead = VSIFReadL(&m_osPending[nOldSize], 1, nToRead,
+                                           m_poLayer->fpCSV);
+            m_osPending.resize(nOldSize + nRead);
+            if( nRead < nToRead )
+                m_bEOF = true;
+            continue;
+        }
+        if( !bEmpty )
+            anRecords.emplace_back(nPos, nRecordEnd);
+        nPos = nRecordEnd;
+    }
+    if( nPos == 0 )
+        return false;
+
+    std::unique_ptr<Chunk> poChunk(new Chunk());
+    poChunk->poReader = this;
+    poChunk->nFirstFID = m_nNextChunkFID;
+    m_nNextChunkFID += static_cast<int>(anRecords.size());
+    poChunk->anRecords = std::move(anRecords);
+    poChunk->osData.swap(m_osPending);
+    m_osPending.assign(poChunk->osData, nPos, std::string::npos);
+    poChunk->osData.resize(nPos);
+
+    Chunk *poChunkRaw = poChunk.get();
+    m_apoChunks.push_back(std::move(poChunk));
+    if( m_poJobQueue == nullptr ||
+        !m_poJobQueue->SubmitJob(ParseChunk, poChunkRaw) )
+    {
+        ParseChunk(poChunkRaw);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             ParseChunk()                             */
+/************************************************************************/
+
+void OGRCSVParallelReader::ParseChunk( void *pData )
+{
+    Chunk *poChunk = static_cast<Chunk *>(pData);
+    OGRCSVParallelReader *poReader = poChunk->poReader;
+    const OGRCSVLayer *poLayer = poReader->m_poLayer;
+
+    bool bWarned = false;
+    poChunk->apoFeatures.reserve(poChunk->anRecords.size());
+    for( const auto &oRecord : poChunk->anRecords )
+    {
+        char **papszTokens = OGRCSVSplitRecord(
+            poChunk->osData.data(), oRecord.first, oRecord.second,
+            poLayer->chDelimiter, poLayer->bDontHonourStrings,
+            poLayer->bMergeDelimiter);
+        const bool bWarnedBefore = bWarned;
+        const int nFID =
+            poChunk->nFirstFID + static_cast<int>(poChunk->apoFeatures.size());
+        poChunk->apoFeatures.push_back(poLayer->TranslateFeature(
+            papszTokens, nFID, bWarned, &poChunk->osWarning));
+        if( bWarned && !bWarnedBefore )
+            poChunk->nWarningIdx = poChunk->apoFeatures.size() - 1;
+        CSLDestroy(papszTokens);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(poReader->m_oMutex);
+        poChunk->bDone = true;
+    }
+    poReader->m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature *OGRCSVParallelReader::GetNextFeature()
+{
+    while( true )
+    {
+        while( m_apoChunks.size() < m_nMaxChunks && ReadChunk() )
+        {
+        }
+        if( m_apoChunks.empty() )
+            return nullptr;
+
+        Chunk *poChunk = m_apoChunks.front().get();
+        {
+            std::unique_lock<std::mutex> oLock(m_oMutex);
+            m_oCV.wait(oLock, [poChunk] { return poChunk->bDone; });
+        }
+
+        if( m_iNextFeature < poChunk->apoFeatures.size() )
+        {
+            // Emit the warning of the worker if no earlier record has
+            // already triggered one.
+            if( !poChunk->osWarning.empty() &&
+                m_iNextFeature == poChunk->nWarningIdx &&
+                !m_poLayer->bWarningBadTypeOrWidth )
+            {
+                m_poLayer->bWarningBadTypeOrWidth = true;
+                CPLError(CE_Warning, CPLE_AppDefined, "%s",
+                         poChunk->osWarning.c_str());
+            }
+            OGRFeature *poFeature = poChunk->apoFeatures[m_iNextFeature];
+            poChunk->apoFeatures[m_iNextFeature] = nullptr;
+            m_iNextFeature++;
+            return poFeature;
+        }
+
+        m_apoChunks.pop_front();
+        m_iNextFeature = 0;
+    }
+}
+
 /************************************************************************/
 /*                            OGRCSVLayer()                             */
 /*                                                                      */
@@ -340,6 +734,8 @@ void OGRCSVLayer::BuildFeatureDefn( const char *pszNfdcGeomField,
     bEmptyStringNull =
         CPLFetchBool(papszOpenOptions, "EMPTY_STRING_AS_NULL", false);
 
+    m_nNumThreads = GDALGetNumThreads(papszOpenOptions, "NUM_THREADS", 1);
+
     // If this is not a new file, read ahead to establish if it is
     // already in CRLF (DOS) mode, or just a normal unix CR mode.
     if( !bNew && bInWriteMode )
@@ -1368,6 +1764,8 @@ OGRCSVLayer::~OGRCSVLayer()
                  poFeatureDefn->GetName());
     }
 
+    m_poParallelReader.reset();
+
     // Make sure the header file is written even if no features are written.
     if( bNew && bInWriteMode )
         WriteHeader();
@@ -1388,6 +1786,8 @@ OGRCSVLayer::~OGRCSVLayer()
 void OGRCSVLayer::ResetReading()
 
 {
+    m_poParallelReader.reset();
+
     if( fpCSV )
         VSIRewindL(fpCSV);
 
@@ -1430,7 +1830,9 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
 {
     if( nFID < 1 || fpCSV == nullptr )
         return nullptr;
-    if( nFID < nNextFID || bNeedRewindBeforeRead )
+    // The parallel reader is ahead of nNextFID in the file.
+    if( nFID < nNextFID || bNeedRewindBeforeRead ||
+        m_poParallelReader != nullptr )
         ResetReading();
     while( nNextFID < nFID )
     {
@@ -1440,7 +1842,31 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
         CSLDestroy(papszTokens);
         nNextFID++;
     }
-    return GetNextUnfilteredFeature();
+    return ReadNextFeature();
+}
+
+/************************************************************************/
+/*                          SetIgnoredFields()                          */
+/************************************************************************/
+
+OGRErr OGRCSVLayer::SetIgnoredFields( const char **papszFields )
+{
+    // The worker threads of the parallel reader use the field definitions:
+    // stop them, and resume reading after the last returned feature.
+    if( m_poParallelReader != nullptr )
+    {
+        const int nFID = nNextFID;
+        ResetReading();
+        while( nNextFID < nFID )
+        {
+            char **papszTokens = GetNextLineTokens();
+            if( papszTokens == nullptr )
+                break;
+            CSLDestroy(papszTokens);
+            nNextFID++;
+        }
+    }
+    return OGRLayer::SetIgnoredFields(papszFields);
 }
 
 /************************************************************************/
@@ -1453,11 +1879,66 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
     if( fpCSV == nullptr )
         return nullptr;
 
+    if( m_nNumThreads > 1 && !bInWriteMode )
+    {
+        if( m_poParallelReader == nullptr )
+        {
+            m_poParallelReader.reset(
+                new OGRCSVParallelReader(this, m_nNumThreads, nNextFID));
+        }
+        OGRFeature *poFeature = m_poParallelReader->GetNextFeature();
+        if( poFeature != nullptr )
+        {
+            nNextFID = static_cast<int>(poFeature->GetFID()) + 1;
+            m_nFeaturesRead++;
+        }
+        return poFeature;
+    }
+
+    return ReadNextFeature();
+}
+
+/************************************************************************/
+/*                          ReadNextFeature()                           */
+/*                                                                      */
+/*      Read and translate the next record from the current file        */
+/*      position.                                                       */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::ReadNextFeature()
+
+{
     // Read the CSV record.
     char **papszTokens = GetNextLineTokens();
     if( papszTokens == nullptr )
         return nullptr;
 
+    OGRFeature *poFeature =
+        TranslateFeature(papszTokens, nNextFID, bWarningBadTypeOrWidth,
+                         nullptr);
+    nNextFID++;
+
+    CSLDestroy(papszTokens);
+
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                          TranslateFeature()                          */
+/*                                                                      */
+/*      Build a feature from the tokens of a record. This does not      */
+/*      modify the layer state, so it may be called from worker         */
+/*      threads: the first warning is then stored in                   */
+/*      posDeferredWarning instead of being emitted.                    */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::TranslateFeature( char **papszTokens, int nFID,
+                                           bool &bWarned,
+                                           CPLString *posDeferredWarning ) const
+
+{
     // Create the OGR feature.
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
 
@@ -1541,14 +2022,15 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 {
                     poFeature->SetField(iOGRField, 0);
                 }
-                else if( !bWarningBadTypeOrWidth )
+                else if( !bWarned )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Invalid value type found in record %d for field %s. "
-                        "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                    bWarned = true;
+                    OGRCSVReportWarning(
+                        posDeferredWarning,
+                        CPLSPrintf("Invalid value type found in record %d for "
+                                   "field %s. This warning will no longer be "
+                                   "emitted",
+                                   nFID, poFieldDefn->GetNameRef()));
                 }
             }
         }
@@ -1567,31 +2049,34 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 if( eType == CPL_VALUE_INTEGER || eType == CPL_VALUE_REAL )
                 {
                     poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                    if( !bWarningBadTypeOrWidth &&
+                    if( !bWarned &&
                         (eFieldType == OFTInteger ||
                          eFieldType == OFTInteger64) &&
                         eType == CPL_VALUE_REAL )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(CE_Warning, CPLE_AppDefined,
-                                 "Invalid value type found in record %d for "
-                                 "field %s. "
-                                 "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                        bWarned = true;
+                        OGRCSVReportWarning(
+                            posDeferredWarning,
+                            CPLSPrintf("Invalid value type found in record %d "
+                                       "for field %s. This warning will no "
+                                       "longer be emitted",
+                                       nFID, poFieldDefn->GetNameRef()));
                     }
-                    else if( !bWarningBadTypeOrWidth &&
+                    else if( !bWarned &&
                              poFieldDefn->GetWidth() > 0 &&
                              static_cast<int>(strlen(papszTokens[iAttr])) >
                                  poFieldDefn->GetWidth() )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(CE_Warning, CPLE_AppDefined,
-                                 "Value with a width greater than field width "
-                                 "found in record %d for field %s. "
-                                 "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                        bWarned = true;
+                        OGRCSVReportWarning(
+                            posDeferredWarning,
+                            CPLSPrintf("Value with a width greater than field "
+                                       "width found in record %d for field "
+                                       "%s. This warning will no longer be "
+                                       "emitted",
+                                       nFID, poFieldDefn->GetNameRef()));
                     }
-                    else if( !bWarningBadTypeOrWidth &&
+                    else if( !bWarned &&
                              eType == CPL_VALUE_REAL &&
                              poFieldDefn->GetWidth() > 0)
                     {
@@ -1602,26 +2087,28 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                                 : 0;
                         if( nPrecision > poFieldDefn->GetPrecision() )
                         {
-                            bWarningBadTypeOrWidth = true;
-                            CPLError(CE_Warning, CPLE_AppDefined,
-                                     "Value with a precision greater than "
-                                     "field precision found in record %d for "
-                                     "field %s. "
-                                     "This warning will no longer be emitted",
-                                     nNextFID, poFieldDefn->GetNameRef());
+                            bWarned = true;
+                            OGRCSVReportWarning(
+                                posDeferredWarning,
+                                CPLSPrintf("Value with a precision greater "
+                                           "than field precision found in "
+                                           "record %d for field %s. This "
+                                           "warning will no longer be emitted",
+                                           nFID, poFieldDefn->GetNameRef()));
                         }
                     }
                 }
                 else
                 {
-                    if( !bWarningBadTypeOrWidth )
+                    if( !bWarned )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(
-                            CE_Warning, CPLE_AppDefined,
-                            "Invalid value type found in record %d for field "
-                            "%s. This warning will no longer be emitted.",
-                            nNextFID, poFieldDefn->GetNameRef());
+                        bWarned = true;
+                        OGRCSVReportWarning(
+                            posDeferredWarning,
+                            CPLSPrintf("Invalid value type found in record %d "
+                                       "for field %s. This warning will no "
+                                       "longer be emitted.",
+                                       nFID, poFieldDefn->GetNameRef()));
                     }
                 }
             }
@@ -1631,15 +2118,16 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             if( papszTokens[iAttr][0] != '\0' && !poFieldDefn->IsIgnored() )
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if( !bWarningBadTypeOrWidth &&
+                if( !bWarned &&
                     !poFeature->IsFieldSetAndNotNull(iOGRField) )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Invalid value type found in record %d for field %s. "
-                        "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                    bWarned = true;
+                    OGRCSVReportWarning(
+                        posDeferredWarning,
+                        CPLSPrintf("Invalid value type found in record %d for "
+                                   "field %s. This warning will no longer be "
+                                   "emitted",
+                                   nFID, poFieldDefn->GetNameRef()));
                 }
             }
         }
@@ -1652,16 +2140,17 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             else
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if( !bWarningBadTypeOrWidth && poFieldDefn->GetWidth() > 0 &&
+                if( !bWarned && poFieldDefn->GetWidth() > 0 &&
                     static_cast<int>(strlen(papszTokens[iAttr])) >
                         poFieldDefn->GetWidth() )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(CE_Warning, CPLE_AppDefined,
-                             "Value with a width greater than field width "
-                             "found in record %d for field %s. "
-                             "This warning will no longer be emitted",
-                             nNextFID, poFieldDefn->GetNameRef());
+                    bWarned = true;
+                    OGRCSVReportWarning(
+                        posDeferredWarning,
+                        CPLSPrintf("Value with a width greater than field "
+                                   "width found in record %d for field %s. "
+                                   "This warning will no longer be emitted",
+                                   nFID, poFieldDefn->GetNameRef()));
                 }
             }
         }
@@ -1770,12 +2259,8 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         }
     }
 
-    CSLDestroy(papszTokens);
-
     // Translate the record id.
-    poFeature->SetFID(nNextFID++);
-
-    m_nFeaturesRead++;
+    poFeature->SetFID(nFID);
 
     return poFeature;
 }
@@ -114,6 +114,8 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
         // deserialize
         void ensurePadfBuffers(size_t count);
         OGRErr ensureFeatureBuf(uint32_t featureSize);
+        OGRErr readFeatureBuf(GIntBig &fid, bool &bEOF);
+        OGRGeometry *readGeometry(const FlatGeobuf::Feature *feature);
         OGRErr parseFeature(OGRFeature *poFeature);
         const std::vector<flatbuffers::Offset<FlatGeobuf::Column>> writeColumns(flatbuffers::FlatBufferBuilder &fbb);
         void readColumns();
@@ -137,6 +139,8 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
 
         virtual OGRFeature *GetFeature(GIntBig nFeatureId) override;
         virtual OGRFeature *GetNextFeature() override;
+        virtual int GetNextArrowArray(struct ArrowArrayStream *stream,
+                                      struct ArrowArray *out_array) override;
         virtual OGRErr CreateField(OGRFieldDefn *poField, int bApproxOK = true) override;
         virtual OGRErr ICreateFeature(OGRFeature *poFeature) override;
         virtual int TestCapability(const char *) override;
@@ -37,8 +37,10 @@
 #include "cplerrors.h"
 #include "geometryreader.h"
 #include "geometrywriter.h"
+#include "ogrlayerarrow.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <new>
 #include <stdexcept>
 
@@ -723,8 +725,8 @@ OGRErr OGRFlatGeobufLayer::ensureFeatureBuf(uint32_t featureSize) {
     return OGRERR_NONE;
 }
 
-OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
-    GIntBig fid;
+OGRErr OGRFlatGeobufLayer::readFeatureBuf(GIntBig &fid, bool &bEOF) {
+    bEOF = false;
     auto seek = false;
     if (m_queriedSpatialIndex && !m_ignoreSpatialFilter) {
         const auto item = m_foundItems[m_featuresPos];
@@ -734,8 +736,6 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
     } else {
         fid = m_featuresPos;
     }
-    poFeature->SetFID(fid);
-
 
     //CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long unsigned int>(m_featuresPos));
 
@@ -743,14 +743,18 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
         seek = true;
 
     if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1) {
-        if (VSIFEofL(m_poFp))
+        if (VSIFEofL(m_poFp)) {
+            bEOF = true;
             return OGRERR_NONE;
+        }
         return CPLErrorIO("seeking to feature location");
     }
     uint32_t featureSize;
     if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1) {
-        if (VSIFEofL(m_poFp))
+        if (VSIFEofL(m_poFp)) {
+            bEOF = true;
             return OGRERR_NONE;
+        }
         return CPLErrorIO("reading feature size");
     }
     CPL_LSBPTR32(&featureSize);
@@ -795,26 +799,40 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
             return OGRERR_CORRUPT_DATA;
         }
     }
+    return OGRERR_NONE;
+}
 
-    const auto feature = GetRoot<Feature>(m_featureBuf);
+OGRGeometry *OGRFlatGeobufLayer::readGeometry(const Feature *feature) {
     const auto geometry = feature->geometry();
-    if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr) {
-        auto geometryType = m_geometryType;
-        if (geometryType == GeometryType::Unknown)
-            geometryType = geometry->type();
-        GeometryReader reader { geometry, geometryType, m_hasZ, m_hasM };
-        OGRGeometry *poOGRGeometry = reader.read();
-        if (poOGRGeometry == nullptr) {
-            CPLError(CE_Failure, CPLE_AppDefined, "Failed to read geometry");
+    if (geometry == nullptr)
+        return nullptr;
+    auto geometryType = m_geometryType;
+    if (geometryType == GeometryType::Unknown)
+        geometryType = geometry->type();
+    GeometryReader reader { geometry, geometryType, m_hasZ, m_hasM };
+    OGRGeometry *poOGRGeometry = reader.read();
+    if (poOGRGeometry == nullptr) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Failed to read geometry");
+        return nullptr;
+    }
+    if (m_poSRS != nullptr)
+        poOGRGeometry->assignSpatialReference(m_poSRS);
+    return poOGRGeometry;
+}
+
+OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
+    GIntBig fid;
+    bool bEOF;
+    const auto eErr = readFeatureBuf(fid, bEOF);
+    poFeature->SetFID(fid);
+    if (eErr != OGRERR_NONE || bEOF)
+        return eErr;
+
+    const auto feature = GetRoot<Feature>(m_featureBuf);
+    if (!m_poFeatureDefn->IsGeometryIgnored() && feature->geometry() != nullptr) {
+        OGRGeometry *poOGRGeometry = readGeometry(feature);
+        if (poOGRGeometry == nullptr)
             return OGRERR_CORRUPT_DATA;
-        }
-// #ifdef DEBUG
-//             char *wkt;
-//             poOGRGeometry->exportToWkt(&wkt);
-//             CPLDebugOnly("FlatGeobuf", "readGeometry as wkt: %s", wkt);
-// #endif
-        if (m_poSRS != nullptr)
-            poOGRGeometry->assignSpatialReference(m_poSRS);
         poFeature->SetGeometryDirectly(poOGRGeometry);
     }
 
@@ -1065,6 +1083,230 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
 }
 
 
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Decode the feature buffers directly into the Arrow array,       */
+/*      without instantiating OGRFeature objects.                       */
+/************************************************************************/
+
+int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                          struct ArrowArray *out_array)
+{
+    // Attribute filters evaluated client-side need OGRFeature objects
+    if (m_create || (m_poAttrQuery != nullptr && !m_ignoreAttributeFilter))
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    OGRArrowArrayHelper oHelper(m_poFeatureDefn,
+                                m_aosArrowArrayStreamOptions.List(),
+                                out_array);
+    if (!oHelper.IsValid())
+        return ENOMEM;
+
+    const bool bGeomSelected = m_poFeatureDefn->GetGeomFieldCount() > 0 &&
+                               oHelper.IsGeomFieldSelected(0);
+    const bool bFilterGeom = m_poFilterGeom != nullptr && !m_ignoreSpatialFilter;
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    const int nMaxFeatures = oHelper.GetMaxFeatureCount();
+    int iRow = 0;
+    while (iRow < nMaxFeatures) {
+        if (m_featuresCount > 0 && m_featuresPos >= m_featuresCount)
+            break;
+
+        if (readIndex() != OGRERR_NONE)
+            return EIO;
+
+        if (m_queriedSpatialIndex && m_featuresCount == 0)
+            break;
+
+        GIntBig fid;
+        bool bEOF;
+        if (readFeatureBuf(fid, bEOF) != OGRERR_NONE) {
+            CPLError(CE_Failure, CPLE_AppDefined, "Fatal error parsing feature");
+            return EIO;
+        }
+        if (bEOF || VSIFEofL(m_poFp))
+            break;
+
+        m_featuresPos++;
+
+        const auto feature = GetRoot<Feature>(m_featureBuf);
+        std::unique_ptr<OGRGeometry> poGeom;
+        if ((bGeomSelected || bFilterGeom) && feature->geometry() != nullptr) {
+            poGeom.reset(readGeometry(feature));
+            if (poGeom == nullptr)
+                return EIO;
+        }
+        if (bFilterGeom && !FilterGeometry(poGeom.get()))
+            continue;
+
+        oHelper.SetFID(iRow, fid);
+        if (bGeomSelected && poGeom && !oHelper.SetGeometry(0, iRow, poGeom.get()))
+            return ENOMEM;
+
+        const auto properties = feature->properties();
+        const auto columns = m_poHeader->columns();
+        if (properties != nullptr && properties->size() > 0) {
+            const auto data = properties->data();
+            const auto size = properties->size();
+            if (size < (sizeof(uint16_t) + sizeof(uint8_t)) || columns == nullptr) {
+                CPLErrorInvalidSize("property value");
+                return EIO;
+            }
+            uoffset_t offset = 0;
+            while (offset + 1 < size) {
+                if (offset + sizeof(uint16_t) > size) {
+                    CPLErrorInvalidSize("property value");
+                    return EIO;
+                }
+                uint16_t i;
+                memcpy(&i, data + offset, sizeof(uint16_t));
+                CPL_LSBPTR16(&i);
+                offset += sizeof(uint16_t);
+                if (i >= columns->size() || i >= nFieldCount) {
+                    CPLError(CE_Failure, CPLE_AppDefined, "Column index %hu out of range", i);
+                    return EIO;
+                }
+                const bool isSelected = oHelper.IsFieldSelected(i);
+
+                // Fixed size values
+                size_t nValueSize = 0;
+                const auto type = columns->Get(i)->type();
+                switch (type) {
+                    case ColumnType::Bool:
+                    case ColumnType::Byte:
+                    case ColumnType::UByte: nValueSize = 1; break;
+                    case ColumnType::Short:
+                    case ColumnType::UShort: nValueSize = 2; break;
+                    case ColumnType::Int:
+                    case ColumnType::UInt:
+                    case ColumnType::Float: nValueSize = 4; break;
+                    case ColumnType::Long:
+                    case ColumnType::ULong:
+                    case ColumnType::Double: nValueSize = 8; break;
+                    default: break;
+                }
+                if (nValueSize > 0) {
+                    if (offset + nValueSize > size) {
+                        CPLErrorInvalidSize("property value");
+                        return EIO;
+                    }
+                    const auto pabyValue = data + offset;
+                    offset += static_cast<uoffset_t>(nValueSize);
+                    if (!isSelected)
+                        continue;
+                    switch (type) {
+                        case ColumnType::Bool:
+                        case ColumnType::UByte:
+                            oHelper.SetInteger(i, iRow, pabyValue[0]);
+                            break;
+                        case ColumnType::Byte:
+                            oHelper.SetInteger(i, iRow,
+                                *reinterpret_cast<const signed char*>(pabyValue));
+                            break;
+                        case ColumnType::Short: {
+                            int16_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR16(&v);
+                            oHelper.SetInteger(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::UShort: {
+                            uint16_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR16(&v);
+                            oHelper.SetInteger(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::Int: {
+                            int32_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR32(&v);
+                            oHelper.SetInteger(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::UInt: {
+                            uint32_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR32(&v);
+                            oHelper.SetInteger(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::Long: {
+                            int64_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR64(&v);
+                            oHelper.SetInteger(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::ULong: {
+                            uint64_t v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR64(&v);
+                            oHelper.SetReal(i, iRow, static_cast<double>(v));
+                            break;
+                        }
+                        case ColumnType::Float: {
+                            float v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR32(&v);
+                            oHelper.SetReal(i, iRow, v);
+                            break;
+                        }
+                        case ColumnType::Double: {
+                            double v;
+                            memcpy(&v, pabyValue, sizeof(v));
+                            CPL_LSBPTR64(&v);
+                            oHelper.SetReal(i, iRow, v);
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    continue;
+                }
+
+                // Variable size values, prefixed by their length
+                if (offset + sizeof(uint32_t) > size) {
+                    CPLErrorInvalidSize("property length");
+                    return EIO;
+                }
+                uint32_t len;
+                memcpy(&len, data + offset, sizeof(uint32_t));
+                CPL_LSBPTR32(&len);
+                offset += sizeof(uint32_t);
+                if (len > static_cast<uint32_t>(INT_MAX) || len > size - offset) {
+                    CPLErrorInvalidSize("property value");
+                    return EIO;
+                }
+                const auto pabyValue = data + offset;
+                offset += len;
+                if (!isSelected)
+                    continue;
+                if (type == ColumnType::DateTime) {
+                    if (len > 32) {
+                        CPLErrorInvalidSize("datetime value");
+                        return EIO;
+                    }
+                    char str[32+1];
+                    memcpy(str, pabyValue, len);
+                    str[len] = '\0';
+                    OGRField sField;
+                    if (OGRParseDate(str, &sField, 0))
+                        oHelper.SetDateTime(i, iRow, &sField);
+                }
+                else if (!oHelper.SetBytes(i, iRow, pabyValue, len)) {
+                    return EIO;
+                }
+            }
+        }
+
+        iRow++;
+    }
+
+    return oHelper.Finalize(iRow) ? 0 : ENOMEM;
+}
+
 OGRErr OGRFlatGeobufLayer::CreateField(OGRFieldDefn *poField, int /* bApproxOK */)
 {
     // CPLDebugOnly("FlatGeobuf", "CreateField %s %s", poField->GetNameRef(), poField->GetFieldTypeName(poField->GetType()));
@@ -1338,6 +1580,8 @@ int OGRFlatGeobufLayer::TestCapability(const char *pszCap)
         return m_poHeader != nullptr && m_poHeader->index_node_size() > 0;
     else if (EQUAL(pszCap, OLCStringsAsUTF8))
         return true;
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return !m_create && m_poAttrQuery == nullptr;
     else
         return false;
 }
@@ -657,7 +657,8 @@ int         OGREditableLayer::TestCapability( const char * pszCap )
         return m_bSupportsCreateGeomField;
     if( EQUAL(pszCap, OLCCurveGeometries) )
         return m_bSupportsCurveGeometries;
-    if( EQUAL(pszCap, OLCTransactions) )
+    if( EQUAL(pszCap, OLCTransactions) ||
+        EQUAL(pszCap, OLCFastGetArrowStream) )
         return FALSE;
 
     return m_poDecoratedLayer->TestCapability(pszCap);
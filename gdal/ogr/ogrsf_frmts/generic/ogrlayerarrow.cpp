@@ -0,0 +1,1221 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Columnar batch reading API of OGRLayer, using the Arrow C data
+ *           interface.
+ *
+ ******************************************************************************
+ * Copyright (c) 2022, GDAL developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrsf_frmts.h"
+#include "ogr_api.h"
+#include "ogr_p.h"
+#include "ogr_recordbatch.h"
+#include "ogrlayerarrow.h"
+
+#include "cpl_time.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+CPL_CVSID("$Id$")
+
+/************************************************************************/
+/*                          OGRArrowBuffer                              */
+/************************************************************************/
+
+namespace {
+
+// Growable buffer, with the alignment recommended by the Arrow
+// specification, and whose content beyond the written part is zeroed.
+struct OGRArrowBuffer
+{
+    GByte  *pabyData = nullptr;
+    size_t  nCapacity = 0;
+
+    OGRArrowBuffer() = default;
+    ~OGRArrowBuffer() { VSIFreeAligned(pabyData); }
+
+    bool Reserve( size_t nSize )
+    {
+        if( nSize <= nCapacity )
+            return true;
+        const size_t nNewCapacity = std::max(
+            std::max(nSize, static_cast<size_t>(64)),
+            nCapacity + nCapacity / 2);
+        GByte* pabyNewData = static_cast<GByte*>(
+            VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nNewCapacity));
+        if( pabyNewData == nullptr )
+            return false;
+        if( nCapacity )
+            memcpy(pabyNewData, pabyData, nCapacity);
+        memset(pabyNewData + nCapacity, 0, nNewCapacity - nCapacity);
+        VSIFreeAligned(pabyData);
+        pabyData = pabyNewData;
+        nCapacity = nNewCapacity;
+        return true;
+    }
+
+    // Transfer ownership of the data to the caller.
+    GByte* Release()
+    {
+        GByte* pabyRet = pabyData;
+        pabyData = nullptr;
+        nCapacity = 0;
+        return pabyRet;
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRArrowBuffer)
+};
+
+typedef enum
+{
+    OGR_ARROW_BOOLEAN,
+    OGR_ARROW_INT16,
+    OGR_ARROW_INT32,
+    OGR_ARROW_INT64,
+    OGR_ARROW_FLOAT32,
+    OGR_ARROW_FLOAT64,
+    OGR_ARROW_DATE32,
+    OGR_ARROW_TIME32_MS,
+    OGR_ARROW_TIMESTAMP_MS,
+    OGR_ARROW_TIMESTAMP_MS_UTC,
+    OGR_ARROW_STRING,
+    OGR_ARROW_BINARY,
+    OGR_ARROW_LIST,
+} OGRArrowType;
+
+} // namespace
+
+/************************************************************************/
+/*                       OGRArrowArrayHelper::Column                    */
+/************************************************************************/
+
+struct OGRArrowArrayHelper::Column
+{
+    OGRArrowType    eType = OGR_ARROW_INT32;
+    bool            bHasValidity = true;
+    OGRArrowBuffer  oValidity{};
+    // Offsets of OGR_ARROW_STRING, OGR_ARROW_BINARY and OGR_ARROW_LIST
+    OGRArrowBuffer  oOffsets{};
+    // Fixed-size values, or bytes of OGR_ARROW_STRING / OGR_ARROW_BINARY
+    OGRArrowBuffer  oValues{};
+    // Number of rows whose end offset is set (variable-size types)
+    int             nFilledRows = 0;
+    // Items of OGR_ARROW_LIST, without validity
+    std::unique_ptr<Column> poChild{};
+    int             nChildLength = 0;
+
+    Column() = default;
+    CPL_DISALLOW_COPY_ASSIGN(Column)
+};
+
+namespace {
+
+/************************************************************************/
+/*                          Type helpers                                */
+/************************************************************************/
+
+size_t OGRArrowGetTypeSize( OGRArrowType eType )
+{
+    switch( eType )
+    {
+        case OGR_ARROW_BOOLEAN: return 0; // bit-packed
+        case OGR_ARROW_INT16: return sizeof(int16_t);
+        case OGR_ARROW_INT32: return sizeof(int32_t);
+        case OGR_ARROW_INT64: return sizeof(int64_t);
+        case OGR_ARROW_FLOAT32: return sizeof(float);
+        case OGR_ARROW_FLOAT64: return sizeof(double);
+        case OGR_ARROW_DATE32: return sizeof(int32_t);
+        case OGR_ARROW_TIME32_MS: return sizeof(int32_t);
+        case OGR_ARROW_TIMESTAMP_MS:
+        case OGR_ARROW_TIMESTAMP_MS_UTC: return sizeof(int64_t);
+        case OGR_ARROW_STRING:
+        case OGR_ARROW_BINARY:
+        case OGR_ARROW_LIST:
+            break;
+    }
+    return 0;
+}
+
+const char* OGRArrowGetFormat( OGRArrowType eType )
+{
+    switch( eType )
+    {
+        case OGR_ARROW_BOOLEAN: return "b";
+        case OGR_ARROW_INT16: return "s";
+        case OGR_ARROW_INT32: return "i";
+        case OGR_ARROW_INT64: return "l";
+        case OGR_ARROW_FLOAT32: return "f";
+        case OGR_ARROW_FLOAT64: return "g";
+        case OGR_ARROW_DATE32: return "tdD";
+        case OGR_ARROW_TIME32_MS: return "ttm";
+        case OGR_ARROW_TIMESTAMP_MS: return "tsm:";
+        case OGR_ARROW_TIMESTAMP_MS_UTC: return "tsm:UTC";
+        case OGR_ARROW_STRING: return "u";
+        case OGR_ARROW_BINARY: return "z";
+        case OGR_ARROW_LIST: return "+l";
+    }
+    return "";
+}
+
+// Whether DateTime values are declared as UTC timestamps (TIMEZONE=UTC).
+bool OGRArrowIsDateTimeUTC( CSLConstList papszOptions )
+{
+    return EQUAL(CSLFetchNameValueDef(papszOptions, "TIMEZONE", "unknown"),
+                 "UTC");
+}
+
+// Returns the type of the field, and of the items for list fields.
+// Returns false for types that are not handled.
+bool OGRArrowGetFieldType( const OGRFieldDefn* poFieldDefn,
+                           bool bDateTimeUTC,
+                           OGRArrowType& eType, OGRArrowType& eItemType )
+{
+    const OGRFieldSubType eSubType = poFieldDefn->GetSubType();
+    eItemType = OGR_ARROW_INT32;
+    switch( poFieldDefn->GetType() )
+    {
+        case OFTInteger:
+            eType = eSubType == OFSTBoolean ? OGR_ARROW_BOOLEAN :
+                    eSubType == OFSTInt16 ? OGR_ARROW_INT16 : OGR_ARROW_INT32;
+            return true;
+        case OFTInteger64:
+            eType = OGR_ARROW_INT64;
+            return true;
+        case OFTReal:
+            eType = eSubType == OFSTFloat32 ? OGR_ARROW_FLOAT32 :
+                                              OGR_ARROW_FLOAT64;
+            return true;
+        case OFTString:
+            eType = OGR_ARROW_STRING;
+            return true;
+        case OFTBinary:
+            eType = OGR_ARROW_BINARY;
+            return true;
+        case OFTDate:
+            eType = OGR_ARROW_DATE32;
+            return true;
+        case OFTTime:
+            eType = OGR_ARROW_TIME32_MS;
+            return true;
+        case OFTDateTime:
+            eType = bDateTimeUTC ? OGR_ARROW_TIMESTAMP_MS_UTC :
+                                   OGR_ARROW_TIMESTAMP_MS;
+            return true;
+        case OFTIntegerList:
+            eType = OGR_ARROW_LIST;
+            eItemType = eSubType == OFSTBoolean ? OGR_ARROW_BOOLEAN :
+                        eSubType == OFSTInt16 ? OGR_ARROW_INT16 :
+                                                OGR_ARROW_INT32;
+            return true;
+        case OFTInteger64List:
+            eType = OGR_ARROW_LIST;
+            eItemType = OGR_ARROW_INT64;
+            return true;
+        case OFTRealList:
+            eType = OGR_ARROW_LIST;
+            eItemType = eSubType == OFSTFloat32 ? OGR_ARROW_FLOAT32 :
+                                                  OGR_ARROW_FLOAT64;
+            return true;
+        case OFTStringList:
+            eType = OGR_ARROW_LIST;
+            eItemType = OGR_ARROW_STRING;
+            return true;
+        case OFTWideString:
+        case OFTWideStringList:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                       Release callbacks                              */
+/************************************************************************/
+
+void OGRArrowReleaseSchema( struct ArrowSchema* psSchema )
+{
+    CPLFree(const_cast<char*>(psSchema->format));
+    CPLFree(const_cast<char*>(psSchema->name));
+    CPLFree(const_cast<char*>(psSchema->metadata));
+    for( int64_t i = 0; i < psSchema->n_children; ++i )
+    {
+        if( psSchema->children[i]->release )
+            psSchema->children[i]->release(psSchema->children[i]);
+        CPLFree(psSchema->children[i]);
+    }
+    CPLFree(psSchema->children);
+    psSchema->release = nullptr;
+}
+
+void OGRArrowReleaseArray( struct ArrowArray* psArray )
+{
+    for( int64_t i = 0; i < psArray->n_buffers; ++i )
+        VSIFreeAligned(const_cast<void*>(psArray->buffers[i]));
+    CPLFree(psArray->buffers);
+    for( int64_t i = 0; i < psArray->n_children; ++i )
+    {
+        if( psArray->children[i]->release )
+            psArray->children[i]->release(psArray->children[i]);
+        CPLFree(psArray->children[i]);
+    }
+    CPLFree(psArray->children);
+    psArray->release = nullptr;
+}
+
+/************************************************************************/
+/*                          Schema helpers                              */
+/************************************************************************/
+
+struct ArrowSchema* OGRArrowCreateSchema( const char* pszFormat,
+                                          const char* pszName,
+                                          bool bNullable )
+{
+    auto psSchema = static_cast<struct ArrowSchema*>(
+        CPLCalloc(1, sizeof(struct ArrowSchema)));
+    psSchema->format = CPLStrdup(pszFormat);
+    psSchema->name = CPLStrdup(pszName);
+    psSchema->flags = bNullable ? ARROW_FLAG_NULLABLE : 0;
+    psSchema->release = OGRArrowReleaseSchema;
+    return psSchema;
+}
+
+// Encode key/value pairs with the binary layout of ArrowSchema::metadata.
+char* OGRArrowEncodeMetadata(
+            const std::vector<std::pair<std::string, std::string>>& aoKV )
+{
+    size_t nSize = sizeof(int32_t);
+    for( const auto& oKV: aoKV )
+        nSize += 2 * sizeof(int32_t) + oKV.first.size() + oKV.second.size();
+    char* pszMetadata = static_cast<char*>(CPLMalloc(nSize));
+    char* pszIter = pszMetadata;
+    const auto AppendInt32 = [&pszIter](size_t nVal)
+    {
+        const int32_t nVal32 = static_cast<int32_t>(nVal);
+        memcpy(pszIter, &nVal32, sizeof(nVal32));
+        pszIter += sizeof(nVal32);
+    };
+    const auto AppendString = [&pszIter, &AppendInt32](const std::string& s)
+    {
+        AppendInt32(s.size());
+        memcpy(pszIter, s.data(), s.size());
+        pszIter += s.size();
+    };
+    AppendInt32(aoKV.size());
+    for( const auto& oKV: aoKV )
+    {
+        AppendString(oKV.first);
+        AppendString(oKV.second);
+    }
+    return pszMetadata;
+}
+
+/************************************************************************/
+/*                          Array helpers                               */
+/************************************************************************/
+
+inline void OGRArrowSetBit( GByte* pabyBitmap, int i )
+{
+    pabyBitmap[i / 8] |= static_cast<GByte>(1 << (i % 8));
+}
+
+GIntBig OGRArrowGetUnixTime( int nYear, int nMonth, int nDay,
+                             int nHour, int nMinute, int nSecond )
+{
+    struct tm brokendowntime;
+    memset(&brokendowntime, 0, sizeof(brokendowntime));
+    brokendowntime.tm_year = nYear - 1900;
+    brokendowntime.tm_mon = nMonth - 1;
+    brokendowntime.tm_mday = nDay;
+    brokendowntime.tm_hour = nHour;
+    brokendowntime.tm_min = nMinute;
+    brokendowntime.tm_sec = nSecond;
+    return CPLYMDHMSToUnixTime(&brokendowntime);
+}
+
+} // namespace
+
+/************************************************************************/
+/*                             GetSchema()                              */
+/************************************************************************/
+
+int OGRArrowArrayHelper::GetSchema( OGRFeatureDefn* poFeatureDefn,
+                                    const char* pszFIDName,
+                                    CSLConstList papszOptions,
+                                    struct ArrowSchema* out_schema )
+{
+    std::vector<struct ArrowSchema*> apsChildren;
+
+    if( CPLTestBool(CSLFetchNameValueDef(papszOptions, "INCLUDE_FID", "YES")) )
+    {
+        apsChildren.push_back(OGRArrowCreateSchema(
+            OGRArrowGetFormat(OGR_ARROW_INT64), pszFIDName, false));
+    }
+
+    const bool bDateTimeUTC = OGRArrowIsDateTimeUTC(papszOptions);
+    for( int iField = 0; iField < poFeatureDefn->GetFieldCount(); ++iField )
+    {
+        const auto poFieldDefn = poFeatureDefn->GetFieldDefn(iField);
+        OGRArrowType eType, eItemType;
+        if( poFieldDefn->IsIgnored() ||
+            !OGRArrowGetFieldType(poFieldDefn, bDateTimeUTC,
+                                  eType, eItemType) )
+        {
+            continue;
+        }
+        auto psChild = OGRArrowCreateSchema(OGRArrowGetFormat(eType),
+                                            poFieldDefn->GetNameRef(),
+                                            CPL_TO_BOOL(poFieldDefn->IsNullable()));
+        if( eType == OGR_ARROW_LIST )
+        {
+            psChild->n_children = 1;
+            psChild->children = static_cast<struct ArrowSchema**>(
+                CPLMalloc(sizeof(struct ArrowSchema*)));
+            psChild->children[0] = OGRArrowCreateSchema(
+                OGRArrowGetFormat(eItemType), "item", false);
+        }
+        apsChildren.push_back(psChild);
+    }
+
+    for( int iGeomField = 0; iGeomField < poFeatureDefn->GetGeomFieldCount();
+         ++iGeomField )
+    {
+        const auto poGeomFieldDefn = poFeatureDefn->GetGeomFieldDefn(iGeomField);
+        if( poGeomFieldDefn->IsIgnored() )
+            continue;
+        const char* pszName = poGeomFieldDefn->GetNameRef();
+        auto psChild = OGRArrowCreateSchema(
+            OGRArrowGetFormat(OGR_ARROW_BINARY),
+            pszName[0] ? pszName : OGR_GEOMETRY_DEFAULT_NON_EMPTY_NAME,
+            CPL_TO_BOOL(poGeomFieldDefn->IsNullable()));
+        psChild->metadata = OGRArrowEncodeMetadata(
+            {{ "ARROW:extension:name", "ogc.wkb" }});
+        apsChildren.push_back(psChild);
+    }
+
+    memset(out_schema, 0, sizeof(*out_schema));
+    out_schema->format = CPLStrdup("+s");
+    out_schema->name = CPLStrdup("");
+    out_schema->n_children = static_cast<int64_t>(apsChildren.size());
+    out_schema->children = static_cast<struct ArrowSchema**>(
+        CPLMalloc(sizeof(struct ArrowSchema*) *
+                  std::max<size_t>(1, apsChildren.size())));
+    if( !apsChildren.empty() )
+    {
+        memcpy(out_schema->children, apsChildren.data(),
+               sizeof(struct ArrowSchema*) * apsChildren.size());
+    }
+    out_schema->release = OGRArrowReleaseSchema;
+    return 0;
+}
+
+/************************************************************************/
+/*                         OGRArrowArrayHelper()                        */
+/************************************************************************/
+
+OGRArrowArrayHelper::OGRArrowArrayHelper( OGRFeatureDefn* poFeatureDefn,
+                                          CSLConstList papszOptions,
+                                          struct ArrowArray* out_array ) :
+    m_poFeatureDefn(poFeatureDefn),
+    m_psOutArray(out_array),
+    m_anFieldColumn(poFeatureDefn->GetFieldCount(), -1),
+    m_anGeomFieldColumn(poFeatureDefn->GetGeomFieldCount(), -1)
+{
+    memset(out_array, 0, sizeof(*out_array));
+
+    const char* pszMaxFeatures =
+        CSLFetchNameValue(papszOptions, "MAX_FEATURES_IN_BATCH");
+    if( pszMaxFeatures )
+        m_nMaxFeatures = std::max(1, atoi(pszMaxFeatures));
+
+    const auto AddColumn = [this](OGRArrowType eType, bool bHasValidity)
+    {
+        std::unique_ptr<Column> poColumn(new Column());
+        poColumn->eType = eType;
+        poColumn->bHasValidity = bHasValidity;
+        const size_t nMaxFeatures = static_cast<size_t>(m_nMaxFeatures);
+        bool bOK = true;
+        if( bHasValidity )
+            bOK &= poColumn->oValidity.Reserve((nMaxFeatures + 7) / 8);
+        if( eType == OGR_ARROW_STRING || eType == OGR_ARROW_BINARY ||
+            eType == OGR_ARROW_LIST )
+        {
+            bOK &= poColumn->oOffsets.Reserve(
+                            (nMaxFeatures + 1) * sizeof(int32_t));
+            if( eType != OGR_ARROW_LIST )
+                bOK &= poColumn->oValues.Reserve(1);
+        }
+        else if( eType == OGR_ARROW_BOOLEAN )
+        {
+            bOK &= poColumn->oValues.Reserve((nMaxFeatures + 7) / 8);
+        }
+        else
+        {
+            bOK &= poColumn->oValues.Reserve(
+                nMaxFeatures * OGRArrowGetTypeSize(eType));
+        }
+        m_apoColumns.emplace_back(std::move(poColumn));
+        return bOK;
+    };
+
+    bool bOK = true;
+    if( CPLTestBool(CSLFetchNameValueDef(papszOptions, "INCLUDE_FID", "YES")) )
+    {
+        m_nFIDColumn = static_cast<int>(m_apoColumns.size());
+        bOK &= AddColumn(OGR_ARROW_INT64, false);
+    }
+
+    const bool bDateTimeUTC = OGRArrowIsDateTimeUTC(papszOptions);
+    for( int iField = 0; iField < poFeatureDefn->GetFieldCount(); ++iField )
+    {
+        const auto poFieldDefn = poFeatureDefn->GetFieldDefn(iField);
+        OGRArrowType eType, eItemType;
+        if( poFieldDefn->IsIgnored() ||
+            !OGRArrowGetFieldType(poFieldDefn, bDateTimeUTC,
+                                  eType, eItemType) )
+        {
+            continue;
+        }
+        m_anFieldColumn[iField] = static_cast<int>(m_apoColumns.size());
+        bOK &= AddColumn(eType, true);
+        if( eType == OGR_ARROW_LIST )
+        {
+            auto& poChild = m_apoColumns.back()->poChild;
+            poChild.reset(new Column());
+            poChild->eType = eItemType;
+            poChild->bHasValidity = false;
+            bOK &= poChild->oValues.Reserve(1);
+            if( eItemType == OGR_ARROW_STRING )
+                bOK &= poChild->oOffsets.Reserve(sizeof(int32_t));
+        }
+    }
+
+    for( int iGeomField = 0; iGeomField < poFeatureDefn->GetGeomFieldCount();
+         ++iGeomField )
+    {
+        if( poFeatureDefn->GetGeomFieldDefn(iGeomField)->IsIgnored() )
+            continue;
+        m_anGeomFieldColumn[iGeomField] = static_cast<int>(m_apoColumns.size());
+        bOK &= AddColumn(OGR_ARROW_BINARY, true);
+    }
+
+    m_bValid = bOK;
+}
+
+/************************************************************************/
+/*                        ~OGRArrowArrayHelper()                        */
+/************************************************************************/
+
+OGRArrowArrayHelper::~OGRArrowArrayHelper() = default;
+
+/************************************************************************/
+/*                               SetFID()                               */
+/************************************************************************/
+
+void OGRArrowArrayHelper::SetFID( int iRow, GIntBig nFID )
+{
+    if( m_nFIDColumn >= 0 )
+    {
+        reinterpret_cast<int64_t*>(
+            m_apoColumns[m_nFIDColumn]->oValues.pabyData)[iRow] = nFID;
+    }
+}
+
+/************************************************************************/
+/*                             SetInteger()                             */
+/************************************************************************/
+
+void OGRArrowArrayHelper::SetInteger( int iField, int iRow, GIntBig nValue )
+{
+    if( m_anFieldColumn[iField] < 0 )
+        return;
+    Column& oColumn = *(m_apoColumns[m_anFieldColumn[iField]]);
+    GByte* pabyValues = oColumn.oValues.pabyData;
+    switch( oColumn.eType )
+    {
+        case OGR_ARROW_BOOLEAN:
+            if( nValue )
+                OGRArrowSetBit(pabyValues, iRow);
+            break;
+        case OGR_ARROW_INT16:
+            reinterpret_cast<int16_t*>(pabyValues)[iRow] =
+                static_cast<int16_t>(nValue);
+            break;
+        case OGR_ARROW_INT32:
+            reinterpret_cast<int32_t*>(pabyValues)[iRow] =
+                static_cast<int32_t>(nValue);
+            break;
+        case OGR_ARROW_INT64:
+            reinterpret_cast<int64_t*>(pabyValues)[iRow] = nValue;
+            break;
+        default:
+            CPLAssert(false);
+            return;
+    }
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+}
+
+/************************************************************************/
+/*                              SetReal()                               */
+/************************************************************************/
+
+void OGRArrowArrayHelper::SetReal( int iField, int iRow, double dfValue )
+{
+    if( m_anFieldColumn[iField] < 0 )
+        return;
+    Column& oColumn = *(m_apoColumns[m_anFieldColumn[iField]]);
+    if( oColumn.eType == OGR_ARROW_FLOAT32 )
+    {
+        reinterpret_cast<float*>(oColumn.oValues.pabyData)[iRow] =
+            static_cast<float>(dfValue);
+    }
+    else
+    {
+        CPLAssert(oColumn.eType == OGR_ARROW_FLOAT64);
+        reinterpret_cast<double*>(oColumn.oValues.pabyData)[iRow] = dfValue;
+    }
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+}
+
+/************************************************************************/
+/*                           ReserveBytes()                             */
+/************************************************************************/
+
+// Make room for nLen bytes for row iRow of a variable-size column, set
+// the offsets of the rows skipped since the last call (that are null), and
+// return a pointer where to write the value.
+static GByte* OGRArrowReserveBytes( OGRArrowBuffer& oOffsets,
+                                    OGRArrowBuffer& oValues,
+                                    int& nFilledRows,
+                                    int iRow, size_t nLen )
+{
+    if( iRow < nFilledRows )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Values of variable size must be set in increasing "
+                 "row order, and only once");
+        return nullptr;
+    }
+    int32_t* panOffsets = reinterpret_cast<int32_t*>(oOffsets.pabyData);
+    const int32_t nStart = panOffsets[nFilledRows];
+    for( ; nFilledRows < iRow; ++nFilledRows )
+        panOffsets[nFilledRows + 1] = nStart;
+    if( nLen > static_cast<size_t>(INT_MAX - nStart) )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Too large content for an Arrow array. "
+                 "Use a lower value of MAX_FEATURES_IN_BATCH");
+        return nullptr;
+    }
+    if( !oValues.Reserve(static_cast<size_t>(nStart) + nLen) )
+        return nullptr;
+    panOffsets[iRow + 1] = nStart + static_cast<int32_t>(nLen);
+    nFilledRows = iRow + 1;
+    return oValues.pabyData + nStart;
+}
+
+/************************************************************************/
+/*                              SetBytes()                              */
+/************************************************************************/
+
+bool OGRArrowArrayHelper::SetBytes( int iField, int iRow,
+                                    const void* pData, size_t nLen )
+{
+    if( m_anFieldColumn[iField] < 0 )
+        return true;
+    Column& oColumn = *(m_apoColumns[m_anFieldColumn[iField]]);
+    CPLAssert(oColumn.eType == OGR_ARROW_STRING ||
+              oColumn.eType == OGR_ARROW_BINARY);
+    GByte* pabyDst = OGRArrowReserveBytes(oColumn.oOffsets, oColumn.oValues,
+                                          oColumn.nFilledRows, iRow, nLen);
+    if( pabyDst == nullptr )
+        return false;
+    if( nLen )
+        memcpy(pabyDst, pData, nLen);
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+    return true;
+}
+
+/************************************************************************/
+/*                            SetDateTime()                             */
+/************************************************************************/
+
+void OGRArrowArrayHelper::SetDateTime( int iField, int iRow,
+                                       const OGRField* psField )
+{
+    if( m_anFieldColumn[iField] < 0 )
+        return;
+    Column& oColumn = *(m_apoColumns[m_anFieldColumn[iField]]);
+    const auto& sDate = psField->Date;
+    switch( oColumn.eType )
+    {
+        case OGR_ARROW_DATE32:
+        {
+            const GIntBig nUnixTime = OGRArrowGetUnixTime(
+                sDate.Year, sDate.Month, sDate.Day, 0, 0, 0);
+            reinterpret_cast<int32_t*>(oColumn.oValues.pabyData)[iRow] =
+                static_cast<int32_t>(nUnixTime / 86400);
+            break;
+        }
+        case OGR_ARROW_TIME32_MS:
+        {
+            reinterpret_cast<int32_t*>(oColumn.oValues.pabyData)[iRow] =
+                (sDate.Hour * 3600 + sDate.Minute * 60) * 1000 +
+                static_cast<int32_t>(std::round(sDate.Second * 1000.0f));
+            break;
+        }
+        case OGR_ARROW_TIMESTAMP_MS:
+        case OGR_ARROW_TIMESTAMP_MS_UTC:
+        {
+            GIntBig nUnixTime = OGRArrowGetUnixTime(
+                sDate.Year, sDate.Month, sDate.Day,
+                sDate.Hour, sDate.Minute, 0);
+            // Convert to UTC when the time zone is known
+            if( sDate.TZFlag > 1 )
+                nUnixTime -= (sDate.TZFlag - 100) * 15 * 60;
+            reinterpret_cast<int64_t*>(oColumn.oValues.pabyData)[iRow] =
+                nUnixTime * 1000 +
+                static_cast<int64_t>(std::round(sDate.Second * 1000.0f));
+            break;
+        }
+        default:
+            CPLAssert(false);
+            return;
+    }
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+}
+
+/************************************************************************/
+/*                              SetField()                              */
+/************************************************************************/
+
+bool OGRArrowArrayHelper::SetField( int iField, int iRow,
+                                    const OGRField* psField )
+{
+    if( m_anFieldColumn[iField] < 0 || OGR_RawField_IsUnset(psField) ||
+        OGR_RawField_IsNull(psField) )
+    {
+        return true;
+    }
+
+    const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(iField);
+    switch( poFieldDefn->GetType() )
+    {
+        case OFTInteger:
+            SetInteger(iField, iRow, psField->Integer);
+            return true;
+        case OFTInteger64:
+            SetInteger(iField, iRow, psField->Integer64);
+            return true;
+        case OFTReal:
+            SetReal(iField, iRow, psField->Real);
+            return true;
+        case OFTString:
+            return SetBytes(iField, iRow, psField->String,
+                            strlen(psField->String));
+        case OFTBinary:
+            return SetBytes(iField, iRow, psField->Binary.paData,
+                            psField->Binary.nCount);
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+            SetDateTime(iField, iRow, psField);
+            return true;
+        case OFTIntegerList:
+        case OFTInteger64List:
+        case OFTRealList:
+        case OFTStringList:
+            break;
+        case OFTWideString:
+        case OFTWideStringList:
+            return true;
+    }
+
+    // Lists
+    Column& oColumn = *(m_apoColumns[m_anFieldColumn[iField]]);
+    Column& oChild = *(oColumn.poChild);
+    const int nCount = psField->IntegerList.nCount;
+    if( iRow < oColumn.nFilledRows )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Values of variable size must be set in increasing "
+                 "row order, and only once");
+        return false;
+    }
+    int32_t* panOffsets = reinterpret_cast<int32_t*>(oColumn.oOffsets.pabyData);
+    for( ; oColumn.nFilledRows < iRow; ++oColumn.nFilledRows )
+        panOffsets[oColumn.nFilledRows + 1] = oChild.nChildLength;
+    if( nCount > INT_MAX - oChild.nChildLength )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Too large content for an Arrow array. "
+                 "Use a lower value of MAX_FEATURES_IN_BATCH");
+        return false;
+    }
+    const size_t nNewLength =
+        static_cast<size_t>(oChild.nChildLength) + nCount;
+    if( oChild.eType == OGR_ARROW_STRING )
+    {
+        if( !oChild.oOffsets.Reserve((nNewLength + 1) * sizeof(int32_t)) )
+            return false;
+        for( int i = 0; i < nCount; ++i )
+        {
+            const char* pszStr = psField->StringList.paList[i];
+            const size_t nLen = strlen(pszStr);
+            GByte* pabyDst = OGRArrowReserveBytes(
+                oChild.oOffsets, oChild.oValues, oChild.nFilledRows,
+                oChild.nChildLength + i, nLen);
+            if( pabyDst == nullptr )
+                return false;
+            memcpy(pabyDst, pszStr, nLen);
+        }
+    }
+    else if( oChild.eType == OGR_ARROW_BOOLEAN )
+    {
+        if( !oChild.oValues.Reserve((nNewLength + 7) / 8) )
+            return false;
+        for( int i = 0; i < nCount; ++i )
+        {
+            if( psField->IntegerList.paList[i] )
+                OGRArrowSetBit(oChild.oValues.pabyData, oChild.nChildLength + i);
+        }
+    }
+    else
+    {
+        if( !oChild.oValues.Reserve(nNewLength *
+                                    OGRArrowGetTypeSize(oChild.eType)) )
+        {
+            return false;
+        }
+        GByte* pabyValues = oChild.oValues.pabyData;
+        const int iStart = oChild.nChildLength;
+        for( int i = 0; i < nCount; ++i )
+        {
+            switch( oChild.eType )
+            {
+                case OGR_ARROW_INT16:
+                    reinterpret_cast<int16_t*>(pabyValues)[iStart + i] =
+                        static_cast<int16_t>(psField->IntegerList.paList[i]);
+                    break;
+                case OGR_ARROW_INT32:
+                    reinterpret_cast<int32_t*>(pabyValues)[iStart + i] =
+                        psField->IntegerList.paList[i];
+                    break;
+                case OGR_ARROW_INT64:
+                    reinterpret_cast<int64_t*>(pabyValues)[iStart + i] =
+                        psField->Integer64List.paList[i];
+                    break;
+                case OGR_ARROW_FLOAT32:
+                    reinterpret_cast<float*>(pabyValues)[iStart + i] =
+                        static_cast<float>(psField->RealList.paList[i]);
+                    break;
+                case OGR_ARROW_FLOAT64:
+                    reinterpret_cast<double*>(pabyValues)[iStart + i] =
+                        psField->RealList.paList[i];
+                    break;
+                default:
+                    CPLAssert(false);
+                    break;
+            }
+        }
+    }
+    oChild.nChildLength += nCount;
+    panOffsets[iRow + 1] = oChild.nChildLength;
+    oColumn.nFilledRows = iRow + 1;
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+    return true;
+}
+
+/************************************************************************/
+/*                            SetGeometry()                             */
+/************************************************************************/
+
+bool OGRArrowArrayHelper::SetGeometry( int iGeomField, int iRow,
+                                       const OGRGeometry* poGeom )
+{
+    if( m_anGeomFieldColumn[iGeomField] < 0 || poGeom == nullptr )
+        return true;
+    Column& oColumn = *(m_apoColumns[m_anGeomFieldColumn[iGeomField]]);
+    const size_t nSize = poGeom->WkbSize();
+    GByte* pabyDst = OGRArrowReserveBytes(oColumn.oOffsets, oColumn.oValues,
+                                          oColumn.nFilledRows, iRow, nSize);
+    if( pabyDst == nullptr )
+        return false;
+    poGeom->exportToWkb(wkbNDR, pabyDst, wkbVariantIso);
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+    return true;
+}
+
+/************************************************************************/
+/*                               SetWKB()                               */
+/************************************************************************/
+
+bool OGRArrowArrayHelper::SetWKB( int iGeomField, int iRow,
+                                  const GByte* pabyWKB, size_t nWKBSize )
+{
+    if( m_anGeomFieldColumn[iGeomField] < 0 )
+        return true;
+    Column& oColumn = *(m_apoColumns[m_anGeomFieldColumn[iGeomField]]);
+    GByte* pabyDst = OGRArrowReserveBytes(oColumn.oOffsets, oColumn.oValues,
+                                          oColumn.nFilledRows, iRow, nWKBSize);
+    if( pabyDst == nullptr )
+        return false;
+    memcpy(pabyDst, pabyWKB, nWKBSize);
+    OGRArrowSetBit(oColumn.oValidity.pabyData, iRow);
+    return true;
+}
+
+/************************************************************************/
+/*                             SetFeature()                             */
+/************************************************************************/
+
+bool OGRArrowArrayHelper::SetFeature( int iRow, const OGRFeature* poFeature )
+{
+    SetFID(iRow, poFeature->GetFID());
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    for( int iField = 0; iField < nFieldCount; ++iField )
+    {
+        if( !SetField(iField, iRow, poFeature->GetRawFieldRef(iField)) )
+            return false;
+    }
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    for( int iGeomField = 0; iGeomField < nGeomFieldCount; ++iGeomField )
+    {
+        if( !SetGeometry(iGeomField, iRow,
+                         poFeature->GetGeomFieldRef(iGeomField)) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+// Transfer the content of the columns to the output array. An empty batch
+// results in a released array, which means end of stream.
+bool OGRArrowArrayHelper::Finalize( int nRows )
+{
+    memset(m_psOutArray, 0, sizeof(*m_psOutArray));
+    if( nRows == 0 )
+        return true;
+
+    const auto ExportColumn = [](Column& oColumn, int nLength)
+    {
+        auto psArray = static_cast<struct ArrowArray*>(
+            CPLCalloc(1, sizeof(struct ArrowArray)));
+        psArray->release = OGRArrowReleaseArray;
+        psArray->length = nLength;
+        const bool bVarSize = oColumn.eType == OGR_ARROW_STRING ||
+                              oColumn.eType == OGR_ARROW_BINARY;
+        const bool bList = oColumn.eType == OGR_ARROW_LIST;
+        psArray->n_buffers = bVarSize ? 3 : 2;
+        psArray->buffers = static_cast<const void**>(
+            CPLCalloc(static_cast<size_t>(psArray->n_buffers), sizeof(void*)));
+
+        if( oColumn.bHasValidity )
+        {
+            int nValid = 0;
+            const GByte* pabyValidity = oColumn.oValidity.pabyData;
+            for( int i = 0; i < nLength; ++i )
+                nValid += (pabyValidity[i / 8] >> (i % 8)) & 1;
+            psArray->null_count = nLength - nValid;
+            if( psArray->null_count )
+                psArray->buffers[0] = oColumn.oValidity.Release();
+        }
+
+        if( bVarSize || bList )
+        {
+            int32_t* panOffsets =
+                reinterpret_cast<int32_t*>(oColumn.oOffsets.pabyData);
+            const int32_t nEnd = bList ? oColumn.poChild->nChildLength :
+                                         panOffsets[oColumn.nFilledRows];
+            for( ; oColumn.nFilledRows < nLength; ++oColumn.nFilledRows )
+                panOffsets[oColumn.nFilledRows + 1] = nEnd;
+            psArray->buffers[1] = oColumn.oOffsets.Release();
+            if( bVarSize )
+            {
+                // Consumers expect a non-NULL data buffer, even when all
+                // values are empty or null.
+                oColumn.oValues.Reserve(1);
+                psArray->buffers[2] = oColumn.oValues.Release();
+            }
+        }
+        else
+        {
+            psArray->buffers[1] = oColumn.oValues.Release();
+        }
+        return psArray;
+    };
+
+    m_psOutArray->length = nRows;
+    m_psOutArray->n_buffers = 1;
+    m_psOutArray->buffers = static_cast<const void**>(
+        CPLCalloc(1, sizeof(void*)));
+    m_psOutArray->n_children = static_cast<int64_t>(m_apoColumns.size());
+    m_psOutArray->children = static_cast<struct ArrowArray**>(
+        CPLCalloc(std::max<size_t>(1, m_apoColumns.size()),
+                  sizeof(struct ArrowArray*)));
+    m_psOutArray->release = OGRArrowReleaseArray;
+    for( size_t i = 0; i < m_apoColumns.size(); ++i )
+    {
+        Column& oColumn = *(m_apoColumns[i]);
+        auto psChild = ExportColumn(oColumn, nRows);
+        if( oColumn.eType == OGR_ARROW_LIST )
+        {
+            psChild->n_children = 1;
+            psChild->children = static_cast<struct ArrowArray**>(
+                CPLMalloc(sizeof(struct ArrowArray*)));
+            psChild->children[0] =
+                ExportColumn(*(oColumn.poChild), oColumn.poChild->nChildLength);
+        }
+        m_psOutArray->children[i] = psChild;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        Arrow stream callbacks                        */
+/************************************************************************/
+
+static int OGRLayerGetArrowSchema( struct ArrowArrayStream* stream,
+                                   struct ArrowSchema* out_schema )
+{
+    auto poLayer = static_cast<OGRLayer*>(stream->private_data);
+    return poLayer->GetArrowSchema(stream, out_schema);
+}
+
+static int OGRLayerGetNextArrowArray( struct ArrowArrayStream* stream,
+                                      struct ArrowArray* out_array )
+{
+    auto poLayer = static_cast<OGRLayer*>(stream->private_data);
+    return poLayer->GetNextArrowArray(stream, out_array);
+}
+
+static const char* OGRLayerGetLastErrorArrowArrayStream(
+                                            struct ArrowArrayStream* )
+{
+    const char* pszLastErrorMsg = CPLGetLastErrorMsg();
+    return pszLastErrorMsg[0] != '\0' ? pszLastErrorMsg : nullptr;
+}
+
+static void OGRLayerReleaseArrowArrayStream( struct ArrowArrayStream* stream )
+{
+    stream->private_data = nullptr;
+    stream->release = nullptr;
+}
+
+/************************************************************************/
+/*                           GetArrowStream()                           */
+/************************************************************************/
+
+/** Get a batch of features as an Arrow array stream.
+ *
+ * The returned stream follows the
+ * <a href="https://arrow.apache.org/docs/format/CStreamInterface.html">Arrow
+ * C stream interface</a>, whose structures are declared in
+ * ogr_recordbatch.h. Each array returned by the get_next() callback of
+ * the stream is a struct array, with one child per column, and at most
+ * MAX_FEATURES_IN_BATCH rows. The end of the stream is signaled by an
+ * array whose release member is NULL.
+ *
+ * The columns are, in that order:
+ * <ul>
+ * <li>the FID, as a non-nullable int64 column, named after GetFIDColumn()
+ *     or "OGC_FID" if it is empty, unless INCLUDE_FID=NO</li>
+ * <li>the attribute fields that are not ignored. Boolean, Int16 and Float32
+ *     sub-types are mapped to the corresponding Arrow types. Date, Time and
+ *     DateTime fields are mapped to date32, time32[ms] and timestamp[ms]
+ *     (see the TIMEZONE option). List fields are mapped to lists.</li>
+ * <li>the geometry fields that are not ignored, as binary columns holding
+ *     ISO WKB, with the ARROW:extension:name metadata set to "ogc.wkb".</li>
+ * </ul>
+ *
+ * The default implementation uses GetNextFeature(), and thus honours the
+ * spatial and attribute filters. Drivers that advertise the
+ * OLCFastGetArrowStream capability read their records without
+ * instantiating OGRFeature objects.
+ *
+ * The stream shares the reading state of the layer: ResetReading() is
+ * called by this method, and GetNextFeature() must not be called while
+ * the stream is being consumed. The stream must be released before the
+ * layer is destroyed.
+ *
+ * Options may be:
+ * <ul>
+ * <li>MAX_FEATURES_IN_BATCH=integer: maximum number of features per
+ *     array. Defaults to 65536.</li>
+ * <li>INCLUDE_FID=YES/NO: whether to include the FID column. Defaults to
+ *     YES.</li>
+ * <li>GEOMETRY_ENCODING=WKB: encoding of geometries. Only WKB is currently
+ *     supported.</li>
+ * <li>TIMEZONE=UTC/unknown: time zone of DateTime columns. With UTC, they
+ *     are timestamps in UTC ("tsm:UTC"), and values without a time zone are
+ *     assumed to be in UTC. With unknown, they are timestamps without time
+ *     zone ("tsm:"). In both cases, values with a known time zone are
+ *     converted to UTC. Defaults to UTC for drivers whose DateTime values
+ *     are in UTC, like GeoPackage, and to unknown otherwise.</li>
+ * </ul>
+ *
+ * This method is the same as the C function OGR_L_GetArrowStream().
+ *
+ * @param out_stream Pointer to a non-NULL ArrowArrayStream structure,
+ *                   initialized by this method.
+ * @param papszOptions NULL terminated list of KEY=VALUE options.
+ * @return true in case of success.
+ * @since GDAL 3.4
+ */
+bool OGRLayer::GetArrowStream( struct ArrowArrayStream* out_stream,
+                               CSLConstList papszOptions )
+{
+    memset(out_stream, 0, sizeof(*out_stream));
+
+    const char* pszGeomEncoding =
+        CSLFetchNameValueDef(papszOptions, "GEOMETRY_ENCODING", "WKB");
+    if( !EQUAL(pszGeomEncoding, "WKB") )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for GEOMETRY_ENCODING: %s",
+                 pszGeomEncoding);
+        return false;
+    }
+
+    const char* pszMaxFeatures =
+        CSLFetchNameValue(papszOptions, "MAX_FEATURES_IN_BATCH");
+    if( pszMaxFeatures && atoi(pszMaxFeatures) <= 0 )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid value for MAX_FEATURES_IN_BATCH: %s",
+                 pszMaxFeatures);
+        return false;
+    }
+
+    const char* pszTimeZone =
+        CSLFetchNameValueDef(papszOptions, "TIMEZONE", "unknown");
+    if( !EQUAL(pszTimeZone, "UTC") && !EQUAL(pszTimeZone, "unknown") )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for TIMEZONE: %s", pszTimeZone);
+        return false;
+    }
+
+    m_aosArrowArrayStreamOptions.Assign(CSLDuplicate(papszOptions), true);
+
+    ResetReading();
+
+    out_stream->get_schema = OGRLayerGetArrowSchema;
+    out_stream->get_next = OGRLayerGetNextArrowArray;
+    out_stream->get_last_error = OGRLayerGetLastErrorArrowArrayStream;
+    out_stream->release = OGRLayerReleaseArrowArrayStream;
+    out_stream->private_data = this;
+    return true;
+}
+
+/************************************************************************/
+/*                           GetArrowSchema()                           */
+/************************************************************************/
+
+/** Get the schema of the arrays returned by the stream of
+ * GetArrowStream().
+ *
+ * This is the implementation of the get_schema() callback of the stream,
+ * and should generally not be called directly.
+ *
+ * @return 0 in case of success, or an errno error code.
+ * @since GDAL 3.4
+ */
+int OGRLayer::GetArrowSchema( struct ArrowArrayStream*,
+                              struct ArrowSchema* out_schema )
+{
+    const char* pszFIDName = GetFIDColumn();
+    return OGRArrowArrayHelper::GetSchema(
+        GetLayerDefn(),
+        (pszFIDName && pszFIDName[0]) ? pszFIDName : "OGC_FID",
+        m_aosArrowArrayStreamOptions.List(), out_schema);
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+/** Get the next array of the stream of GetArrowStream().
+ *
+ * This is the implementation of the get_next() callback of the stream,
+ * and should generally not be called directly. Drivers may override it
+ * to fill an OGRArrowArrayHelper directly from their records.
+ *
+ * @return 0 in case of success, or an errno error code.
+ * @since GDAL 3.4
+ */
+int OGRLayer::GetNextArrowArray( struct ArrowArrayStream*,
+                                 struct ArrowArray* out_array )
+{
+    OGRArrowArrayHelper oHelper(GetLayerDefn(),
+                                m_aosArrowArrayStreamOptions.List(),
+                                out_array);
+    if( !oHelper.IsValid() )
+        return ENOMEM;
+
+    const int nMaxFeatures = oHelper.GetMaxFeatureCount();
+    int iRow = 0;
+    while( iRow < nMaxFeatures )
+    {
+        std::unique_ptr<OGRFeature> poFeature(GetNextFeature());
+        if( poFeature == nullptr )
+            break;
+        if( !oHelper.SetFeature(iRow, poFeature.get()) )
+            return ENOMEM;
+        ++iRow;
+    }
+    return oHelper.Finalize(iRow) ? 0 : ENOMEM;
+}
+
+/************************************************************************/
+/*                         OGR_L_GetArrowStream()                       */
+/************************************************************************/
+
+/** Get a batch of features as an Arrow array stream.
+ *
+ * This function is the same as the C++ method OGRLayer::GetArrowStream().
+ *
+ * @param hLayer Layer
+ * @param out_stream Pointer to a non-NULL ArrowArrayStream structure,
+ *                   initialized by this function.
+ * @param papszOptions NULL terminated list of KEY=VALUE options.
+ * @return true in case of success.
+ * @since GDAL 3.4
+ */
+bool OGR_L_GetArrowStream( OGRLayerH hLayer,
+                           struct ArrowArrayStream* out_stream,
+                           char** papszOptions )
+{
+    VALIDATE_POINTER1( hLayer, "OGR_L_GetArrowStream", false );
+    VALIDATE_POINTER1( out_stream, "OGR_L_GetArrowStream", false );
+
+    return OGRLayer::FromHandle(hLayer)->GetArrowStream(out_stream,
+                                                        papszOptions);
+}
@@ -172,6 +172,8 @@ OGRErr      OGRLayerDecorator::GetExtent(int iGeomField, OGREnvelope *psExtent,
 int         OGRLayerDecorator::TestCapability( const char * pszCapability )
 {
     if( !m_poDecoratedLayer ) return FALSE;
+    // GetArrowStream() is not forwarded, and uses the generic implementation
+    if( EQUAL(pszCapability, OLCFastGetArrowStream) ) return FALSE;
     return m_poDecoratedLayer->TestCapability(pszCapability);
 }
 
@@ -950,6 +950,11 @@ void OGRGeoJSONDataSource::SetOptionsOnReader(GDALOpenInfo* poOpenInfo,
     poReader->SetDateAsString(
         CPLTestBool(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "DATE_AS_STRING",
                 CPLGetConfigOption("OGR_GEOJSON_DATE_AS_STRING", "NO"))));
+
+    poReader->SetSchemaSniffFeatures(
+        CPLAtoGIntBig(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
+                "SCHEMA_SNIFF_FEATURES",
+                CPLGetConfigOption("OGR_GEOJSON_MAX_FEATURES_FIRST_PASS", "0"))));
 }
 
 /************************************************************************/
@@ -41,6 +41,8 @@
 #include "cpl_json_streaming_parser.h"
 #include <ogr_api.h>
 
+#include <memory>
+
 CPL_CVSID("$Id$")
 
 static
@@ -67,6 +69,52 @@ const size_t ESTIMATE_OBJECT_SIZE = ESTIMATE_BASE_OBJECT_SIZE +
                     sizeof(struct lh_table) +
                     JSON_OBJECT_DEF_HASH_ENTRIES * ESTIMATE_OBJECT_ELT_SIZE;
 
+/************************************************************************/
+/*                       OGRGeoJSONParseNumber()                        */
+/************************************************************************/
+
+// Returns true if the number is an integer (returned in nVal), or false if
+// it is a real number (returned in dfVal).
+static bool OGRGeoJSONParseNumber( const char* pszValue, size_t nLen,
+                                   GIntBig& nVal, double& dfVal )
+{
+    if( CPLGetValueType(pszValue) == CPL_VALUE_REAL )
+    {
+        dfVal = CPLAtof(pszValue);
+        return false;
+    }
+    if( nLen == strlen("Infinity") && EQUAL(pszValue, "Infinity") )
+    {
+        dfVal = std::numeric_limits<double>::infinity();
+        return false;
+    }
+    if( nLen == strlen("-Infinity") && EQUAL(pszValue, "-Infinity") )
+    {
+        dfVal = -std::numeric_limits<double>::infinity();
+        return false;
+    }
+    if( nLen == strlen("NaN") && EQUAL(pszValue, "NaN") )
+    {
+        dfVal = std::numeric_limits<double>::quiet_NaN();
+        return false;
+    }
+    nVal = CPLAtoGIntBig(pszValue);
+    return true;
+}
+
+/************************************************************************/
+/*                        OGRGeoJSONNewNumber()                         */
+/************************************************************************/
+
+static json_object* OGRGeoJSONNewNumber( const char* pszValue, size_t nLen )
+{
+    GIntBig nVal = 0;
+    double dfVal = 0.0;
+    if( OGRGeoJSONParseNumber(pszValue, nLen, nVal, dfVal) )
+        return json_object_new_int64(nVal);
+    return json_object_new_double(dfVal);
+}
+
 /************************************************************************/
 /*                      OGRGeoJSONReaderStreamingParser                 */
 /************************************************************************/
@@ -104,10 +152,80 @@ class OGRGeoJSONReaderStreamingParser: public CPLJSonStreamingParser
         bool m_bStartFeature = false;
         bool m_bEndFeature = false;
 
+        // State of the direct building of features, where OGRFeature fields
+        // and geometries are set from the parser events without materializing
+        // a json_object tree for each feature. Only nested property values
+        // and unusual constructs are captured as (small) json_object.
+        enum class DirectMember { NONE, ID, PROPERTIES, GEOMETRY, OTHER };
+        enum class DirectGeomMember { NONE, TYPE, COORDINATES, OTHER };
+        enum class CaptureTarget { PROPERTY, ID, OTHER_MEMBER, GEOMETRY,
+                                   GEOMETRY_MEMBER };
+        enum class ScalarType { STRING, NUMBER, BOOLEAN, NULL_VALUE };
+        enum CoordToken : GByte { COORD_START_ARRAY, COORD_END_ARRAY,
+                                  COORD_NUMBER };
+
+        bool m_bDirect = false;
+        OGRFeature* m_poDirectFeature = nullptr;
+        DirectMember m_eDirectMember = DirectMember::NONE;
+        CPLString m_osDirectKey{};
+        int m_nDirectField = -1;
+        int m_nDirectNextField = 0;
+        bool m_bInDirectProperties = false;
+        bool m_bDirectHasProperties = false;
+        bool m_bDirectHasGeometry = false;
+        bool m_bDirectHasId = false;
+        CPLString m_osDirectIdKey{};
+        json_object* m_poDirectId = nullptr;
+        json_object* m_poDirectOtherMembers = nullptr;
+
+        bool m_bInDirectGeometry = false;
+        DirectGeomMember m_eDirectGeomMember = DirectGeomMember::NONE;
+        CPLString m_osDirectGeomKey{};
+        bool m_bDirectHasGeomType = false;
+        CPLString m_osDirectGeomType{};
+        json_object* m_poDirectGeomObj = nullptr;
+        bool m_bInDirectCoordinates = false;
+        bool m_bDirectHasCoordinates = false;
+        CPLString m_osDirectCoordKey{};
+        std::vector<GByte> m_abyCoordTokens{};
+        std::vector<double> m_adfCoordValues{};
+        std::vector<OGRRawPoint> m_asDirectXY{};
+        std::vector<double> m_adfDirectZ{};
+
+        int m_nIgnoreDepth = -1;
+        int m_nCaptureDepth = -1;
+        CaptureTarget m_eCaptureTarget = CaptureTarget::PROPERTY;
+        json_object* m_poCaptureRoot = nullptr;
+
         void AppendObject(json_object* poNewObj);
         void AnalyzeFeature();
         void TooComplex();
 
+        void DirectStartFeature();
+        void DirectFinishFeature();
+        void DirectStartContainer(bool bObject);
+        void DirectEndContainer(bool bObject);
+        void DirectStartMember(const char* pszKey, size_t nKeyLen);
+        void DirectScalar(ScalarType eType, const char* pszValue, size_t nLen);
+        void DirectSetField(ScalarType eType, const char* pszValue, size_t nLen);
+        void DirectAddOtherMember(json_object* poVal);
+        void DirectAddGeometryMember(const char* pszKey, json_object* poVal);
+        void DirectFinishGeometry();
+        OGRGeometry* DirectBuildGeometry(GeoJSONObject::Type eType);
+        bool DirectReadPosition(size_t& iTok, size_t& iVal,
+                                double& dfX, double& dfY, double& dfZ,
+                                bool& b3D) const;
+        bool DirectReadPositions(size_t& iTok, size_t& iVal,
+                                 OGRSimpleCurve* poCurve);
+        void DirectSetGeometry(OGRGeometry* poGeom);
+        json_object* ReplayCoordinates();
+        void StartCapture(CaptureTarget eTarget, bool bObject);
+        void FinishCapture();
+        void ResetDirectState();
+        static json_object* NewScalarObject(ScalarType eType,
+                                            const char* pszValue,
+                                            size_t nLen);
+
         CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONReaderStreamingParser)
 
     public:
@@ -208,6 +326,15 @@ void OGRGeoJSONBaseReader::SetDateAsString( bool bDateAsString )
     bDateAsString_ = bDateAsString;
 }
 
+/************************************************************************/
+/*                        SetSchemaSniffFeatures                        */
+/************************************************************************/
+
+void OGRGeoJSONBaseReader::SetSchemaSniffFeatures( GIntBig nSchemaSniffFeatures )
+{
+    nSchemaSniffFeatures_ = nSchemaSniffFeatures;
+}
+
 /************************************************************************/
 /*                           OGRGeoJSONReader                           */
 /************************************************************************/
@@ -324,6 +451,14 @@ OGRGeoJSONReaderStreamingParser::OGRGeoJSONReaderStreamingParser(
 {
     m_nMaxObjectSize = atoi(CPLGetConfigOption("OGR_GEOJSON_MAX_OBJ_SIZE", "200"))
                 * 1024 * 1024;
+
+    // Native data requires the serialized feature, and the GeoCouch layout
+    // requires looking at the properties object as a whole, so only
+    // regular layouts are eligible for direct feature building.
+    m_bDirect = !bFirstPass && !bStoreNativeData &&
+                !oReader.bIsGeocouchSpatiallistFormat &&
+                CPLTestBool(CPLGetConfigOption("OGR_GEOJSON_DIRECT_READING",
+                                               "YES"));
 }
 
 /************************************************************************/
@@ -338,6 +473,7 @@ OGRGeoJSONReaderStreamingParser::~OGRGeoJSONReaderStreamingParser()
         json_object_put(m_poCurObj);
     for(size_t i = 0; i < m_apoFeatures.size(); i++ )
         delete m_apoFeatures[i];
+    ResetDirectState();
 }
 
 /************************************************************************/
@@ -399,6 +535,13 @@ void OGRGeoJSONReaderStreamingParser::AppendObject(json_object* poNewObj)
 
 void OGRGeoJSONReaderStreamingParser::AnalyzeFeature()
 {
+    // Features beyond the schema sniffing window are not analyzed, so that
+    // the remainder of the last parsed buffer does not alter the schema.
+    if( m_oReader.nSchemaSniffFeatures_ > 0 &&
+        m_poLayer->GetFeatureCount(FALSE) >= m_oReader.nSchemaSniffFeatures_ )
+    {
+        return;
+    }
     if( !m_oReader.GenerateFeatureDefn( m_poLayer, m_poCurObj ) )
     {
     }
@@ -417,6 +560,19 @@ void OGRGeoJSONReaderStreamingParser::StartObject()
         return;
     }
 
+    if( m_bDirect && m_bInFeaturesArray && m_nDepth == 2 )
+    {
+        DirectStartFeature();
+        m_bStartFeature = true;
+        m_nDepth ++;
+        return;
+    }
+    if( m_poDirectFeature )
+    {
+        DirectStartContainer(true);
+        return;
+    }
+
     if( m_bInFeaturesArray && m_nDepth == 2 )
     {
         m_poCurObj = json_object_new_object();
@@ -464,6 +620,12 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
         return;
     }
 
+    if( m_poDirectFeature )
+    {
+        DirectEndContainer(true);
+        return;
+    }
+
     m_nDepth --;
 
     if( m_bInFeaturesArray && m_nDepth == 2 && m_poCurObj )
@@ -539,6 +701,12 @@ void OGRGeoJSONReaderStreamingParser::StartObjectMember(const char* pszKey,
         return;
     }
 
+    if( m_poDirectFeature )
+    {
+        DirectStartMember(pszKey, nKeyLen);
+        return;
+    }
+
     if( m_nDepth == 1 )
     {
         m_bInFeatures = strcmp(pszKey, "features") == 0;
@@ -592,6 +760,12 @@ void OGRGeoJSONReaderStreamingParser::StartArray()
         return;
     }
 
+    if( m_poDirectFeature )
+    {
+        DirectStartContainer(false);
+        return;
+    }
+
     if( m_nDepth == 1 && m_bInFeatures )
     {
         m_bInFeaturesArray = true;
@@ -619,6 +793,13 @@ void OGRGeoJSONReaderStreamingParser::StartArray()
 
 void OGRGeoJSONReaderStreamingParser::StartArrayMember()
 {
+    if( m_poDirectFeature )
+    {
+        if( m_nCaptureDepth >= 0 )
+            m_nCurObjMemEstimate += ESTIMATE_ARRAY_ELT_SIZE;
+        return;
+    }
+
     if( m_poCurObj )
     {
         m_nCurObjMemEstimate += ESTIMATE_ARRAY_ELT_SIZE;
@@ -644,186 +825,1198 @@ void OGRGeoJSONReaderStreamingParser::EndArray()
         return;
     }
 
+    if( m_poDirectFeature )
+    {
+        DirectEndContainer(false);
+        return;
+    }
+
     m_nDepth --;
     if( m_nDepth == 1 && m_bInFeaturesArray )
     {
         m_bInFeaturesArray = false;
     }
-    else if( m_poCurObj )
+    else if( m_poCurObj )
+    {
+        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        {
+            m_abFirstMember.pop_back();
+            m_osJson += "]";
+        }
+
+        m_apoCurObj.pop_back();
+    }
+}
+
+/************************************************************************/
+/*                              String()                                */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::String(const char* pszValue, size_t nLen)
+{
+    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    {
+        TooComplex();
+        return;
+    }
+
+    if( m_poDirectFeature )
+    {
+        DirectScalar(ScalarType::STRING, pszValue, nLen);
+        return;
+    }
+
+    if( m_nDepth == 1 && m_bInType )
+    {
+        m_bIsTypeKnown = true;
+        m_bIsFeatureCollection = strcmp(pszValue, "FeatureCollection") == 0;
+    }
+    else if( m_poCurObj )
+    {
+        if( m_bFirstPass )
+        {
+            if( m_bInFeaturesArray )
+                m_nTotalOGRFeatureMemEstimate += sizeof(OGRField) + nLen;
+
+            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+            m_nCurObjMemEstimate += nLen + sizeof(void*);
+        }
+        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        {
+            m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
+        }
+        AppendObject(json_object_new_string(pszValue));
+    }
+}
+
+/************************************************************************/
+/*                              Number()                                */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::Number(const char* pszValue, size_t nLen)
+{
+    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    {
+        TooComplex();
+        return;
+    }
+
+    if( m_poDirectFeature )
+    {
+        DirectScalar(ScalarType::NUMBER, pszValue, nLen);
+        return;
+    }
+
+    if( m_poCurObj )
+    {
+        if( m_bFirstPass )
+        {
+            if( m_bInFeaturesArray )
+            {
+                if( m_bInCoordinates )
+                    m_nTotalOGRFeatureMemEstimate += sizeof(double);
+                else
+                    m_nTotalOGRFeatureMemEstimate += sizeof(OGRField);
+            }
+
+            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+        }
+        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        {
+            m_osJson.append(pszValue, nLen);
+        }
+
+        AppendObject(OGRGeoJSONNewNumber(pszValue, nLen));
+    }
+}
+
+/************************************************************************/
+/*                              Boolean()                               */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::Boolean(bool bVal)
+{
+    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    {
+        TooComplex();
+        return;
+    }
+
+    if( m_poDirectFeature )
+    {
+        const char* pszVal = bVal ? "true" : "false";
+        DirectScalar(ScalarType::BOOLEAN, pszVal, strlen(pszVal));
+        return;
+    }
+
+    if( m_poCurObj )
+    {
+        if( m_bFirstPass )
+        {
+            if( m_bInFeaturesArray )
+                m_nTotalOGRFeatureMemEstimate += sizeof(OGRField);
+
+            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+        }
+        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        {
+            m_osJson += bVal ? "true": "false";
+        }
+
+        AppendObject( json_object_new_boolean(bVal) );
+    }
+}
+
+/************************************************************************/
+/*                               Null()                                 */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::Null()
+{
+    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    {
+        TooComplex();
+        return;
+    }
+
+    if( m_poDirectFeature )
+    {
+        DirectScalar(ScalarType::NULL_VALUE, "null", strlen("null"));
+        return;
+    }
+
+    if( m_poCurObj )
+    {
+        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        {
+            m_osJson += "null";
+        }
+
+        m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+        AppendObject( nullptr );
+    }
+}
+
+/************************************************************************/
+/*                            TooComplex()                              */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::TooComplex()
+{
+    if( !ExceptionOccurred() )
+        Exception("GeoJSON object too complex, please see the OGR_GEOJSON_MAX_OBJ_SIZE environment option");
+}
+
+/************************************************************************/
+/*                             Exception()                              */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::Exception(const char* pszMessage)
+{
+    CPLError(CE_Failure, CPLE_AppDefined, "%s", pszMessage);
+}
+
+/************************************************************************/
+/*                         ResetDirectState()                           */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::ResetDirectState()
+{
+    delete m_poDirectFeature;
+    m_poDirectFeature = nullptr;
+    if( m_poCaptureRoot )
+        json_object_put(m_poCaptureRoot);
+    m_poCaptureRoot = nullptr;
+    if( m_poDirectId )
+        json_object_put(m_poDirectId);
+    m_poDirectId = nullptr;
+    if( m_poDirectOtherMembers )
+        json_object_put(m_poDirectOtherMembers);
+    m_poDirectOtherMembers = nullptr;
+    if( m_poDirectGeomObj )
+        json_object_put(m_poDirectGeomObj);
+    m_poDirectGeomObj = nullptr;
+
+    m_apoCurObj.clear();
+    m_bKeySet = false;
+    m_nIgnoreDepth = -1;
+    m_nCaptureDepth = -1;
+    m_eDirectMember = DirectMember::NONE;
+    m_nDirectField = -1;
+    m_nDirectNextField = 0;
+    m_bInDirectProperties = false;
+    m_bDirectHasProperties = false;
+    m_bDirectHasGeometry = false;
+    m_bDirectHasId = false;
+    m_bInDirectGeometry = false;
+    m_eDirectGeomMember = DirectGeomMember::NONE;
+    m_bDirectHasGeomType = false;
+    m_bInDirectCoordinates = false;
+    m_bDirectHasCoordinates = false;
+    m_abyCoordTokens.clear();
+    m_adfCoordValues.clear();
+}
+
+/************************************************************************/
+/*                        DirectStartFeature()                          */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectStartFeature()
+{
+    ResetDirectState();
+    m_poDirectFeature = new OGRFeature( m_poLayer->GetLayerDefn() );
+}
+
+/************************************************************************/
+/*                        DirectFinishFeature()                         */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectFinishFeature()
+{
+    OGRFeature* poFeature = m_poDirectFeature;
+    m_poDirectFeature = nullptr;
+    OGRFeatureDefn* poFDefn = poFeature->GetDefnRef();
+
+    // Same semantics as OGRGeoJSONBaseReader::ReadFeature(): without a
+    // "properties" member, top-level members matching a field are used.
+    if( !m_oReader.bAttributesSkip_ && !m_bDirectHasProperties )
+    {
+        if( m_poDirectOtherMembers )
+        {
+            json_object_iter it;
+            it.key = nullptr;
+            it.val = nullptr;
+            it.entry = nullptr;
+            json_object_object_foreachC( m_poDirectOtherMembers, it )
+            {
+                const int nFldIndex = poFDefn->GetFieldIndexCaseSensitive(it.key);
+                if( nFldIndex >= 0 )
+                {
+                    if( it.val )
+                        poFeature->SetField(nFldIndex, json_object_get_string(it.val) );
+                    else
+                        poFeature->SetFieldNull(nFldIndex );
+                }
+            }
+        }
+        if( m_bDirectHasId )
+        {
+            const int nFldIndex =
+                poFDefn->GetFieldIndexCaseSensitive(m_osDirectIdKey);
+            if( nFldIndex >= 0 )
+            {
+                if( m_poDirectId )
+                    poFeature->SetField(nFldIndex, json_object_get_string(m_poDirectId) );
+                else
+                    poFeature->SetFieldNull(nFldIndex );
+            }
+        }
+    }
+
+    if( m_poDirectId != nullptr && m_oReader.bFeatureLevelIdAsFID_ )
+    {
+        poFeature->SetFID(
+            static_cast<GIntBig>(json_object_get_int64( m_poDirectId )) );
+    }
+    else if( m_poDirectId != nullptr )
+    {
+        const int nIdx = poFDefn->GetFieldIndexCaseSensitive( "id" );
+        if( nIdx >= 0 && !poFeature->IsFieldSet(nIdx) )
+        {
+            poFeature->SetField(nIdx, json_object_get_string(m_poDirectId));
+        }
+    }
+
+    if( !m_bDirectHasGeometry )
+    {
+        static bool bWarned = false;
+        if( !bWarned )
+        {
+            bWarned = true;
+            CPLDebug(
+                "GeoJSON",
+                "Non conformant Feature object. Missing \'geometry\' member.");
+        }
+    }
+
+    m_apoFeatures.push_back( poFeature );
+
+    ResetDirectState();
+    m_nCurObjMemEstimate = 0;
+    m_nTotalOGRFeatureMemEstimate += sizeof(OGRFeature);
+    m_bEndFeature = true;
+}
+
+/************************************************************************/
+/*                           StartCapture()                             */
+/************************************************************************/
+
+/* Starts building a json_object for the object or array beginning at the */
+/* current depth. FinishCapture() is called once it is closed.            */
+
+void OGRGeoJSONReaderStreamingParser::StartCapture(CaptureTarget eTarget,
+                                                   bool bObject)
+{
+    CPLAssert( m_poCaptureRoot == nullptr );
+    m_eCaptureTarget = eTarget;
+    m_nCaptureDepth = m_nDepth;
+    m_poCaptureRoot = bObject ? json_object_new_object() :
+                                json_object_new_array();
+    m_nCurObjMemEstimate += bObject ? ESTIMATE_OBJECT_SIZE :
+                                      ESTIMATE_ARRAY_SIZE;
+    m_apoCurObj.clear();
+    m_apoCurObj.push_back(m_poCaptureRoot);
+    m_bKeySet = false;
+}
+
+/************************************************************************/
+/*                           FinishCapture()                            */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::FinishCapture()
+{
+    json_object* poObj = m_poCaptureRoot;
+    m_poCaptureRoot = nullptr;
+    m_nCaptureDepth = -1;
+    m_apoCurObj.clear();
+    m_bKeySet = false;
+
+    switch( m_eCaptureTarget )
+    {
+        case CaptureTarget::PROPERTY:
+            OGRGeoJSONReaderSetField(m_poLayer, m_poDirectFeature,
+                                     m_nDirectField, m_osDirectKey, poObj,
+                                     m_oReader.bFlattenNestedAttributes_,
+                                     m_oReader.chNestedAttributeSeparator_);
+            json_object_put(poObj);
+            break;
+
+        case CaptureTarget::ID:
+            if( m_poDirectId )
+                json_object_put(m_poDirectId);
+            m_poDirectId = poObj;
+            break;
+
+        case CaptureTarget::OTHER_MEMBER:
+            DirectAddOtherMember(poObj);
+            break;
+
+        case CaptureTarget::GEOMETRY:
+            DirectSetGeometry(
+                m_oReader.ReadGeometry(poObj, m_poLayer->GetSpatialRef()));
+            json_object_put(poObj);
+            break;
+
+        case CaptureTarget::GEOMETRY_MEMBER:
+            DirectAddGeometryMember(m_osDirectGeomKey, poObj);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                       DirectAddOtherMember()                         */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectAddOtherMember(json_object* poVal)
+{
+    if( m_poDirectOtherMembers == nullptr )
+        m_poDirectOtherMembers = json_object_new_object();
+    json_object_object_add(m_poDirectOtherMembers, m_osDirectKey, poVal);
+}
+
+/************************************************************************/
+/*                      DirectAddGeometryMember()                       */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectAddGeometryMember(
+                                    const char* pszKey, json_object* poVal)
+{
+    if( m_poDirectGeomObj == nullptr )
+        m_poDirectGeomObj = json_object_new_object();
+    json_object_object_add(m_poDirectGeomObj, pszKey, poVal);
+}
+
+/************************************************************************/
+/*                         ReplayCoordinates()                          */
+/************************************************************************/
+
+/* Converts the recorded coordinate tokens into json_object arrays. If the */
+/* coordinates array is not yet closed, m_apoCurObj is left with the stack */
+/* of the arrays still open, so that capture can go on from there.        */
+
+json_object* OGRGeoJSONReaderStreamingParser::ReplayCoordinates()
+{
+    json_object* poRoot = nullptr;
+    m_apoCurObj.clear();
+    size_t iVal = 0;
+    for( const GByte byToken: m_abyCoordTokens )
+    {
+        if( byToken == COORD_START_ARRAY )
+        {
+            json_object* poArray = json_object_new_array();
+            if( m_apoCurObj.empty() )
+                poRoot = poArray;
+            else
+                json_object_array_add(m_apoCurObj.back(), poArray);
+            m_apoCurObj.push_back(poArray);
+        }
+        else if( byToken == COORD_END_ARRAY )
+        {
+            m_apoCurObj.pop_back();
+        }
+        else
+        {
+            json_object_array_add(m_apoCurObj.back(),
+                        json_object_new_double(m_adfCoordValues[iVal]));
+            iVal ++;
+        }
+    }
+    m_abyCoordTokens.clear();
+    m_adfCoordValues.clear();
+    return poRoot;
+}
+
+/************************************************************************/
+/*                        DirectStartContainer()                        */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectStartContainer(bool bObject)
+{
+    if( m_nIgnoreDepth >= 0 )
+    {
+        // Skipped content.
+    }
+    else if( m_nCaptureDepth >= 0 )
+    {
+        json_object* poNewObj = bObject ? json_object_new_object() :
+                                          json_object_new_array();
+        m_nCurObjMemEstimate += bObject ? ESTIMATE_OBJECT_SIZE :
+                                          ESTIMATE_ARRAY_SIZE;
+        AppendObject(poNewObj);
+        m_apoCurObj.push_back(poNewObj);
+    }
+    else if( m_bInDirectCoordinates )
+    {
+        if( bObject )
+        {
+            // Not a regular position: let the json_object based geometry
+            // reader deal with it.
+            json_object* poRoot = ReplayCoordinates();
+            m_bInDirectCoordinates = false;
+            m_eCaptureTarget = CaptureTarget::GEOMETRY_MEMBER;
+            m_nCaptureDepth = 4;
+            m_poCaptureRoot = poRoot;
+            m_bKeySet = false;
+            m_osDirectGeomKey = m_osDirectCoordKey;
+            DirectStartContainer(bObject);
+            return;
+        }
+        m_abyCoordTokens.push_back(COORD_START_ARRAY);
+        m_nCurObjMemEstimate += 1;
+    }
+    else if( m_nDepth == 3 )
+    {
+        switch( m_eDirectMember )
+        {
+            case DirectMember::PROPERTIES:
+                m_bDirectHasProperties = true;
+                if( bObject && !m_oReader.bAttributesSkip_ )
+                {
+                    m_bInDirectProperties = true;
+                    m_nDirectNextField = 0;
+                }
+                else
+                {
+                    m_nIgnoreDepth = m_nDepth;
+                }
+                break;
+
+            case DirectMember::GEOMETRY:
+                if( bObject )
+                {
+                    m_bInDirectGeometry = true;
+                    m_eDirectGeomMember = DirectGeomMember::NONE;
+                }
+                else
+                {
+                    StartCapture(CaptureTarget::GEOMETRY, bObject);
+                }
+                break;
+
+            case DirectMember::ID:
+                StartCapture(CaptureTarget::ID, bObject);
+                break;
+
+            case DirectMember::OTHER:
+                if( m_nDirectField >= 0 )
+                    StartCapture(CaptureTarget::OTHER_MEMBER, bObject);
+                else
+                    m_nIgnoreDepth = m_nDepth;
+                break;
+
+            case DirectMember::NONE:
+                m_nIgnoreDepth = m_nDepth;
+                break;
+        }
+    }
+    else if( m_nDepth == 4 && m_bInDirectProperties )
+    {
+        if( m_nDirectField >= 0 ||
+            (bObject && m_oReader.bFlattenNestedAttributes_) )
+        {
+            StartCapture(CaptureTarget::PROPERTY, bObject);
+        }
+        else
+        {
+            CPLDebug("GeoJSON", "Cannot find field %s", m_osDirectKey.c_str());
+            m_nIgnoreDepth = m_nDepth;
+        }
+    }
+    else if( m_nDepth == 4 && m_bInDirectGeometry )
+    {
+        if( m_eDirectGeomMember == DirectGeomMember::COORDINATES && !bObject )
+        {
+            m_bInDirectCoordinates = true;
+            m_osDirectCoordKey = m_osDirectGeomKey;
+            m_abyCoordTokens.clear();
+            m_adfCoordValues.clear();
+            m_abyCoordTokens.push_back(COORD_START_ARRAY);
+        }
+        else if( m_eDirectGeomMember != DirectGeomMember::NONE )
+        {
+            StartCapture(CaptureTarget::GEOMETRY_MEMBER, bObject);
+        }
+        else
+        {
+            m_nIgnoreDepth = m_nDepth;
+        }
+    }
+    else
+    {
+        m_nIgnoreDepth = m_nDepth;
+    }
+
+    m_nDepth ++;
+}
+
+/************************************************************************/
+/*                         DirectEndContainer()                         */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectEndContainer(bool bObject)
+{
+    m_nDepth --;
+
+    if( m_nIgnoreDepth >= 0 )
+    {
+        if( m_nDepth == m_nIgnoreDepth )
+            m_nIgnoreDepth = -1;
+    }
+    else if( m_nCaptureDepth >= 0 )
+    {
+        m_apoCurObj.pop_back();
+        if( m_nDepth == m_nCaptureDepth )
+            FinishCapture();
+    }
+    else if( m_bInDirectCoordinates )
     {
-        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        m_abyCoordTokens.push_back(COORD_END_ARRAY);
+        if( m_nDepth == 4 )
         {
-            m_abFirstMember.pop_back();
-            m_osJson += "]";
+            m_bInDirectCoordinates = false;
+            m_bDirectHasCoordinates = true;
         }
-
-        m_apoCurObj.pop_back();
+    }
+    else if( m_nDepth == 3 )
+    {
+        if( m_bInDirectProperties )
+            m_bInDirectProperties = false;
+        else if( m_bInDirectGeometry )
+            DirectFinishGeometry();
+    }
+    else if( m_nDepth == 2 && bObject )
+    {
+        DirectFinishFeature();
     }
 }
 
 /************************************************************************/
-/*                              String()                                */
+/*                         DirectStartMember()                          */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::String(const char* pszValue, size_t nLen)
+void OGRGeoJSONReaderStreamingParser::DirectStartMember(const char* pszKey,
+                                                        size_t nKeyLen)
 {
-    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    if( m_nIgnoreDepth >= 0 )
+        return;
+
+    if( m_nCaptureDepth >= 0 )
     {
-        TooComplex();
+        m_nCurObjMemEstimate += ESTIMATE_OBJECT_ELT_SIZE;
+        m_osCurKey.assign(pszKey, nKeyLen);
+        m_bKeySet = true;
         return;
     }
 
-    if( m_nDepth == 1 && m_bInType )
+    if( m_nDepth == 3 )
     {
-        m_bIsTypeKnown = true;
-        m_bIsFeatureCollection = strcmp(pszValue, "FeatureCollection") == 0;
+        m_osDirectKey.assign(pszKey, nKeyLen);
+        m_nDirectField = -1;
+        if( EQUAL(pszKey, "properties") )
+            m_eDirectMember = DirectMember::PROPERTIES;
+        else if( EQUAL(pszKey, "geometry") )
+        {
+            m_eDirectMember = DirectMember::GEOMETRY;
+            m_bDirectHasGeometry = true;
+        }
+        else if( EQUAL(pszKey, "id") )
+        {
+            m_eDirectMember = DirectMember::ID;
+            m_bDirectHasId = true;
+            m_osDirectIdKey = m_osDirectKey;
+            if( m_poDirectId )
+                json_object_put(m_poDirectId);
+            m_poDirectId = nullptr;
+        }
+        else
+        {
+            m_eDirectMember = DirectMember::OTHER;
+            // Only kept if it might be used as a field, in the absence of
+            // a "properties" member.
+            if( !m_oReader.bAttributesSkip_ )
+            {
+                m_nDirectField = m_poDirectFeature->GetDefnRef()->
+                                        GetFieldIndexCaseSensitive(pszKey);
+            }
+        }
     }
-    else if( m_poCurObj )
+    else if( m_nDepth == 4 && m_bInDirectProperties )
     {
-        if( m_bFirstPass )
-        {
-            if( m_bInFeaturesArray )
-                m_nTotalOGRFeatureMemEstimate += sizeof(OGRField) + nLen;
+        m_osDirectKey.assign(pszKey, nKeyLen);
 
-            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
-            m_nCurObjMemEstimate += nLen + sizeof(void*);
+        // Properties generally come in the same order for all features,
+        // so first check the field following the previous one.
+        OGRFeatureDefn* poFDefn = m_poDirectFeature->GetDefnRef();
+        if( m_nDirectNextField < poFDefn->GetFieldCount() &&
+            strcmp(poFDefn->GetFieldDefn(m_nDirectNextField)->GetNameRef(),
+                   pszKey) == 0 )
+        {
+            m_nDirectField = m_nDirectNextField;
         }
-        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        else
         {
-            m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
+            m_nDirectField = poFDefn->GetFieldIndexCaseSensitive(pszKey);
         }
-        AppendObject(json_object_new_string(pszValue));
+        if( m_nDirectField >= 0 )
+            m_nDirectNextField = m_nDirectField + 1;
+    }
+    else if( m_nDepth == 4 && m_bInDirectGeometry )
+    {
+        m_osDirectGeomKey.assign(pszKey, nKeyLen);
+        if( EQUAL(pszKey, "type") )
+            m_eDirectGeomMember = DirectGeomMember::TYPE;
+        else if( EQUAL(pszKey, "coordinates") )
+            m_eDirectGeomMember = DirectGeomMember::COORDINATES;
+        else if( EQUAL(pszKey, "crs") || EQUAL(pszKey, "geometries") )
+            m_eDirectGeomMember = DirectGeomMember::OTHER;
+        else
+            m_eDirectGeomMember = DirectGeomMember::NONE;
     }
 }
 
 /************************************************************************/
-/*                              Number()                                */
+/*                          NewScalarObject()                           */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::Number(const char* pszValue, size_t nLen)
+json_object* OGRGeoJSONReaderStreamingParser::NewScalarObject(
+                                                        ScalarType eType,
+                                                        const char* pszValue,
+                                                        size_t nLen)
 {
-    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    switch( eType )
+    {
+        case ScalarType::STRING:
+            return json_object_new_string(pszValue);
+        case ScalarType::NUMBER:
+            return OGRGeoJSONNewNumber(pszValue, nLen);
+        case ScalarType::BOOLEAN:
+            return json_object_new_boolean(pszValue[0] == 't');
+        case ScalarType::NULL_VALUE:
+            break;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                            DirectScalar()                            */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::DirectScalar(ScalarType eType,
+                                                   const char* pszValue,
+                                                   size_t nLen)
+{
+    if( m_nIgnoreDepth >= 0 )
+        return;
+
+    const auto NewScalar = [eType, pszValue, nLen]()
     {
-        TooComplex();
+        return NewScalarObject(eType, pszValue, nLen);
+    };
+
+    if( m_nCaptureDepth >= 0 )
+    {
+        m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+        if( eType == ScalarType::STRING )
+            m_nCurObjMemEstimate += nLen + sizeof(void*);
+        AppendObject(NewScalar());
         return;
     }
 
-    if( m_poCurObj )
+    if( m_bInDirectCoordinates )
     {
-        if( m_bFirstPass )
+        if( eType == ScalarType::NUMBER )
         {
-            if( m_bInFeaturesArray )
-            {
-                if( m_bInCoordinates )
-                    m_nTotalOGRFeatureMemEstimate += sizeof(double);
-                else
-                    m_nTotalOGRFeatureMemEstimate += sizeof(OGRField);
-            }
-
-            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+            GIntBig nVal = 0;
+            double dfVal = 0.0;
+            if( OGRGeoJSONParseNumber(pszValue, nLen, nVal, dfVal) )
+                dfVal = static_cast<double>(nVal);
+            m_abyCoordTokens.push_back(COORD_NUMBER);
+            m_adfCoordValues.push_back(dfVal);
+            m_nCurObjMemEstimate += 1 + sizeof(double);
         }
-        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        else
         {
-            m_osJson.append(pszValue, nLen);
+            // Not a regular position: let the json_object based geometry
+            // reader deal with it.
+            json_object* poRoot = ReplayCoordinates();
+            m_bInDirectCoordinates = false;
+            m_eCaptureTarget = CaptureTarget::GEOMETRY_MEMBER;
+            m_nCaptureDepth = 4;
+            m_poCaptureRoot = poRoot;
+            m_bKeySet = false;
+            m_osDirectGeomKey = m_osDirectCoordKey;
+            AppendObject(NewScalar());
         }
+        return;
+    }
 
-        if( CPLGetValueType(pszValue) == CPL_VALUE_REAL )
-        {
-            AppendObject(json_object_new_double(CPLAtof(pszValue)));
-        }
-        else if( nLen == strlen("Infinity") && EQUAL(pszValue, "Infinity") )
-        {
-            AppendObject(json_object_new_double(
-                std::numeric_limits<double>::infinity()));
-        }
-        else if( nLen == strlen("-Infinity") && EQUAL(pszValue, "-Infinity") )
+    if( m_nDepth == 3 )
+    {
+        switch( m_eDirectMember )
         {
-            AppendObject(json_object_new_double(
-                -std::numeric_limits<double>::infinity()));
+            case DirectMember::PROPERTIES:
+                if( eType != ScalarType::NULL_VALUE )
+                    m_bDirectHasProperties = true;
+                break;
+
+            case DirectMember::GEOMETRY:
+                // 'geometry':null means no geometry.
+                if( eType != ScalarType::NULL_VALUE )
+                {
+                    json_object* poObj = NewScalar();
+                    DirectSetGeometry(m_oReader.ReadGeometry(
+                                        poObj, m_poLayer->GetSpatialRef()));
+                    json_object_put(poObj);
+                }
+                break;
+
+            case DirectMember::ID:
+                m_poDirectId = NewScalar();
+                break;
+
+            case DirectMember::OTHER:
+                if( m_nDirectField >= 0 )
+                    DirectAddOtherMember(NewScalar());
+                break;
+
+            case DirectMember::NONE:
+                break;
         }
-        else if( nLen == strlen("NaN") && EQUAL(pszValue, "NaN") )
+    }
+    else if( m_nDepth == 4 && m_bInDirectProperties )
+    {
+        if( m_nDirectField >= 0 )
+            DirectSetField(eType, pszValue, nLen);
+        else
+            CPLDebug("GeoJSON", "Cannot find field %s", m_osDirectKey.c_str());
+    }
+    else if( m_nDepth == 4 && m_bInDirectGeometry )
+    {
+        if( m_eDirectGeomMember == DirectGeomMember::TYPE &&
+            eType == ScalarType::STRING )
         {
-            AppendObject(json_object_new_double(
-                std::numeric_limits<double>::quiet_NaN()));
+            m_bDirectHasGeomType = true;
+            m_osDirectGeomType.assign(pszValue, nLen);
         }
-        else
+        else if( m_eDirectGeomMember != DirectGeomMember::NONE )
         {
-            AppendObject(json_object_new_int64(CPLAtoGIntBig(pszValue)));
+            DirectAddGeometryMember(m_osDirectGeomKey, NewScalar());
         }
     }
 }
 
 /************************************************************************/
-/*                              Boolean()                               */
+/*                           DirectSetField()                           */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::Boolean(bool bVal)
+/* Sets a scalar property value. The common combinations of token and     */
+/* field types are handled here. Others go through a transient            */
+/* json_object and OGRGeoJSONReaderSetField() to keep the same semantics. */
+
+void OGRGeoJSONReaderStreamingParser::DirectSetField(ScalarType eType,
+                                                     const char* pszValue,
+                                                     size_t nLen)
 {
-    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    OGRFeature* poFeature = m_poDirectFeature;
+    const int nField = m_nDirectField;
+    OGRFieldDefn* poFieldDefn = poFeature->GetFieldDefnRef(nField);
+    const OGRFieldType eFieldType = poFieldDefn->GetType();
+
+    if( eType == ScalarType::NULL_VALUE )
     {
-        TooComplex();
+        poFeature->SetFieldNull( nField );
         return;
     }
 
-    if( m_poCurObj )
+    if( eType == ScalarType::STRING &&
+        eFieldType != OFTInteger && eFieldType != OFTInteger64 &&
+        eFieldType != OFTReal && eFieldType != OFTIntegerList &&
+        eFieldType != OFTInteger64List && eFieldType != OFTRealList )
     {
-        if( m_bFirstPass )
-        {
-            if( m_bInFeaturesArray )
-                m_nTotalOGRFeatureMemEstimate += sizeof(OGRField);
+        poFeature->SetField( nField, pszValue );
+        return;
+    }
 
-            m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+    if( eType == ScalarType::NUMBER &&
+        (eFieldType == OFTInteger || eFieldType == OFTInteger64 ||
+         eFieldType == OFTReal) )
+    {
+        GIntBig nVal = 0;
+        double dfVal = 0.0;
+        const bool bIsInteger =
+            OGRGeoJSONParseNumber(pszValue, nLen, nVal, dfVal);
+        if( eFieldType == OFTReal )
+        {
+            poFeature->SetField( nField,
+                bIsInteger ? static_cast<double>(nVal) : dfVal );
+            return;
         }
-        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
+        if( bIsInteger )
         {
-            m_osJson += bVal ? "true": "false";
+            if( eFieldType == OFTInteger )
+            {
+                // Values out of the range of the field, that the first pass
+                // has not seen, are clamped with a warning.
+                poFeature->SetField( nField, nVal );
+                if( EQUAL( poFieldDefn->GetNameRef(),
+                           m_poLayer->GetFIDColumn() ) )
+                    poFeature->SetFID( poFeature->GetFieldAsInteger(nField) );
+            }
+            else
+            {
+                poFeature->SetField( nField, nVal );
+                if( EQUAL( poFieldDefn->GetNameRef(),
+                           m_poLayer->GetFIDColumn() ) )
+                    poFeature->SetFID( nVal );
+            }
+            return;
         }
-
-        AppendObject( json_object_new_boolean(bVal) );
     }
+
+    json_object* poVal = NewScalarObject(eType, pszValue, nLen);
+    OGRGeoJSONReaderSetField(m_poLayer, poFeature, nField, m_osDirectKey,
+                             poVal, false, 0);
+    json_object_put(poVal);
 }
 
 /************************************************************************/
-/*                               Null()                                 */
+/*                         DirectSetGeometry()                          */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::Null()
+void OGRGeoJSONReaderStreamingParser::DirectSetGeometry(OGRGeometry* poGeom)
 {
-    if( m_nCurObjMemEstimate > m_nMaxObjectSize )
+    if( poGeom )
+        m_poDirectFeature->SetGeometryDirectly(poGeom);
+}
+
+/************************************************************************/
+/*                         DirectReadPosition()                         */
+/************************************************************************/
+
+bool OGRGeoJSONReaderStreamingParser::DirectReadPosition(size_t& iTok,
+                                                         size_t& iVal,
+                                                         double& dfX,
+                                                         double& dfY,
+                                                         double& dfZ,
+                                                         bool& b3D) const
+{
+    const size_t nTokens = m_abyCoordTokens.size();
+    if( iTok >= nTokens || m_abyCoordTokens[iTok] != COORD_START_ARRAY )
+        return false;
+    iTok ++;
+    const size_t iFirstVal = iVal;
+    while( iTok < nTokens && m_abyCoordTokens[iTok] == COORD_NUMBER )
     {
-        TooComplex();
-        return;
+        iTok ++;
+        iVal ++;
     }
+    if( iTok >= nTokens || m_abyCoordTokens[iTok] != COORD_END_ARRAY )
+        return false;
+    iTok ++;
+    const size_t nCoords = iVal - iFirstVal;
+    if( nCoords < GeoJSONObject::eMinCoordinateDimension )
+        return false;
+    dfX = m_adfCoordValues[iFirstVal];
+    dfY = m_adfCoordValues[iFirstVal + 1];
+    b3D = nCoords >= GeoJSONObject::eMaxCoordinateDimension;
+    dfZ = b3D ? m_adfCoordValues[iFirstVal + 2] : 0.0;
+    return true;
+}
 
-    if( m_poCurObj )
-    {
-        if( m_bInFeaturesArray && m_bStoreNativeData && m_nDepth >= 3 )
-        {
-            m_osJson += "null";
-        }
+/************************************************************************/
+/*                        DirectReadPositions()                         */
+/************************************************************************/
 
-        m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
-        AppendObject( nullptr );
+bool OGRGeoJSONReaderStreamingParser::DirectReadPositions(size_t& iTok,
+                                                          size_t& iVal,
+                                                          OGRSimpleCurve* poCurve)
+{
+    const size_t nTokens = m_abyCoordTokens.size();
+    if( iTok >= nTokens || m_abyCoordTokens[iTok] != COORD_START_ARRAY )
+        return false;
+    iTok ++;
+    m_asDirectXY.clear();
+    m_adfDirectZ.clear();
+    bool bAny3D = false;
+    while( iTok < nTokens && m_abyCoordTokens[iTok] == COORD_START_ARRAY )
+    {
+        double dfX = 0.0;
+        double dfY = 0.0;
+        double dfZ = 0.0;
+        bool b3D = false;
+        if( !DirectReadPosition(iTok, iVal, dfX, dfY, dfZ, b3D) )
+            return false;
+        m_asDirectXY.emplace_back(dfX, dfY);
+        m_adfDirectZ.push_back(dfZ);
+        bAny3D |= b3D;
     }
+    if( iTok >= nTokens || m_abyCoordTokens[iTok] != COORD_END_ARRAY )
+        return false;
+    iTok ++;
+    poCurve->setPoints( static_cast<int>(m_asDirectXY.size()),
+                        m_asDirectXY.data(),
+                        bAny3D ? m_adfDirectZ.data() : nullptr );
+    return true;
 }
 
 /************************************************************************/
-/*                            TooComplex()                              */
+/*                        DirectBuildGeometry()                         */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::TooComplex()
+/* Builds the geometry from the recorded coordinate tokens. Returns       */
+/* nullptr if they do not have the regular structure of the geometry      */
+/* type, in which case the json_object based reader is used instead, to   */
+/* get its exact behavior and error reporting.                            */
+
+OGRGeometry* OGRGeoJSONReaderStreamingParser::DirectBuildGeometry(
+                                                GeoJSONObject::Type eType)
 {
-    if( !ExceptionOccurred() )
-        Exception("GeoJSON object too complex, please see the OGR_GEOJSON_MAX_OBJ_SIZE environment option");
+    const size_t nTokens = m_abyCoordTokens.size();
+    size_t iTok = 0;
+    size_t iVal = 0;
+    const auto IsStartArray = [this, &iTok, nTokens]()
+    {
+        return iTok < nTokens && m_abyCoordTokens[iTok] == COORD_START_ARRAY;
+    };
+    const auto IsEndArray = [this, &iTok, nTokens]()
+    {
+        return iTok < nTokens && m_abyCoordTokens[iTok] == COORD_END_ARRAY;
+    };
+
+    std::unique_ptr<OGRGeometry> poGeom;
+    switch( eType )
+    {
+        case GeoJSONObject::ePoint:
+        {
+            double dfX = 0.0;
+            double dfY = 0.0;
+            double dfZ = 0.0;
+            bool b3D = false;
+            if( !DirectReadPosition(iTok, iVal, dfX, dfY, dfZ, b3D) )
+                return nullptr;
+            if( b3D )
+                poGeom.reset(new OGRPoint(dfX, dfY, dfZ));
+            else
+                poGeom.reset(new OGRPoint(dfX, dfY));
+            break;
+        }
+
+        case GeoJSONObject::eLineString:
+        {
+            auto poLine = new OGRLineString();
+            poGeom.reset(poLine);
+            if( !DirectReadPositions(iTok, iVal, poLine) )
+                return nullptr;
+            break;
+        }
+
+        case GeoJSONObject::eMultiPoint:
+        {
+            auto poMP = new OGRMultiPoint();
+            poGeom.reset(poMP);
+            if( !IsStartArray() )
+                return nullptr;
+            iTok ++;
+            while( IsStartArray() )
+            {
+                double dfX = 0.0;
+                double dfY = 0.0;
+                double dfZ = 0.0;
+                bool b3D = false;
+                if( !DirectReadPosition(iTok, iVal, dfX, dfY, dfZ, b3D) )
+                    return nullptr;
+                if( b3D )
+                    poMP->addGeometryDirectly(new OGRPoint(dfX, dfY, dfZ));
+                else
+                    poMP->addGeometryDirectly(new OGRPoint(dfX, dfY));
+            }
+            if( !IsEndArray() )
+                return nullptr;
+            iTok ++;
+            break;
+        }
+
+        case GeoJSONObject::eMultiLineString:
+        {
+            auto poMLS = new OGRMultiLineString();
+            poGeom.reset(poMLS);
+            if( !IsStartArray() )
+                return nullptr;
+            iTok ++;
+            while( IsStartArray() )
+            {
+                // Sub-geometries must be complete when added, for the
+                // dimension of the container to be set accordingly.
+                std::unique_ptr<OGRLineString> poLine(new OGRLineString());
+                if( !DirectReadPositions(iTok, iVal, poLine.get()) )
+                    return nullptr;
+                poMLS->addGeometryDirectly(poLine.release());
+            }
+            if( !IsEndArray() )
+                return nullptr;
+            iTok ++;
+            break;
+        }
+
+        case GeoJSONObject::ePolygon:
+        case GeoJSONObject::eMultiPolygon:
+        {
+            const bool bMulti = eType == GeoJSONObject::eMultiPolygon;
+            OGRMultiPolygon* poMPoly = nullptr;
+            if( bMulti )
+            {
+                poMPoly = new OGRMultiPolygon();
+                poGeom.reset(poMPoly);
+                if( !IsStartArray() )
+                    return nullptr;
+                iTok ++;
+            }
+            while( IsStartArray() )
+            {
+                std::unique_ptr<OGRPolygon> poPoly(new OGRPolygon());
+                iTok ++;
+                // A polygon without rings is not a regular construct.
+                if( !IsStartArray() )
+                    return nullptr;
+                while( IsStartArray() )
+                {
+                    std::unique_ptr<OGRLinearRing> poRing(new OGRLinearRing());
+                    if( !DirectReadPositions(iTok, iVal, poRing.get()) )
+                        return nullptr;
+                    poPoly->addRingDirectly(poRing.release());
+                }
+                if( !IsEndArray() )
+                    return nullptr;
+                iTok ++;
+                if( !bMulti )
+                {
+                    poGeom = std::move(poPoly);
+                    break;
+                }
+                poMPoly->addGeometryDirectly(poPoly.release());
+            }
+            if( bMulti )
+            {
+                if( !IsEndArray() )
+                    return nullptr;
+                iTok ++;
+            }
+            break;
+        }
+
+        default:
+            return nullptr;
+    }
+
+    if( poGeom == nullptr || iTok != nTokens )
+        return nullptr;
+    return poGeom.release();
 }
 
 /************************************************************************/
-/*                             Exception()                              */
+/*                        DirectFinishGeometry()                        */
 /************************************************************************/
 
-void OGRGeoJSONReaderStreamingParser::Exception(const char* pszMessage)
+void OGRGeoJSONReaderStreamingParser::DirectFinishGeometry()
 {
-    CPLError(CE_Failure, CPLE_AppDefined, "%s", pszMessage);
+    m_bInDirectGeometry = false;
+
+    OGRGeometry* poGeom = nullptr;
+    if( m_poDirectGeomObj == nullptr && m_bDirectHasGeomType &&
+        m_bDirectHasCoordinates )
+    {
+        poGeom = DirectBuildGeometry(
+                            OGRGeoJSONGetTypeFromName(m_osDirectGeomType));
+    }
+
+    if( poGeom )
+    {
+        OGRSpatialReference* poSRS = m_poLayer->GetSpatialRef();
+        poGeom->assignSpatialReference(
+            poSRS ? poSRS : OGRSpatialReference::GetWGS84SRS());
+        if( !m_oReader.bGeometryPreserve_ )
+        {
+            OGRGeometryCollection* poMetaGeometry = new OGRGeometryCollection();
+            poMetaGeometry->addGeometryDirectly( poGeom );
+            poGeom = poMetaGeometry;
+        }
+    }
+    else
+    {
+        // crs member, GeometryCollection, invalid geometries, etc.
+        json_object* poObj = m_poDirectGeomObj ? m_poDirectGeomObj :
+                                                 json_object_new_object();
+        m_poDirectGeomObj = nullptr;
+        if( m_bDirectHasGeomType )
+        {
+            json_object_object_add(poObj, "type",
+                    json_object_new_string(m_osDirectGeomType.c_str()));
+        }
+        if( m_bDirectHasCoordinates )
+        {
+            json_object_object_add(poObj, m_osDirectCoordKey,
+                                   ReplayCoordinates());
+        }
+        poGeom = m_oReader.ReadGeometry(poObj, m_poLayer->GetSpatialRef());
+        json_object_put(poObj);
+    }
+
+    DirectSetGeometry(poGeom);
+
+    m_bDirectHasGeomType = false;
+    m_bDirectHasCoordinates = false;
+    m_abyCoordTokens.clear();
+    m_adfCoordValues.clear();
 }
 
 /************************************************************************/
@@ -867,8 +2060,7 @@ bool OGRGeoJSONReader::FirstPassReadLayer( OGRGeoJSONDataSource* poDS,
     bool bThresholdReached = false;
     const GIntBig nMaxBytesFirstPass = CPLAtoGIntBig(
         CPLGetConfigOption("OGR_GEOJSON_MAX_BYTES_FIRST_PASS", "0"));
-    const GIntBig nLimitFeaturesFirstPass = CPLAtoGIntBig(CPLGetConfigOption(
-        "OGR_GEOJSON_MAX_FEATURES_FIRST_PASS", "0"));
+    const GIntBig nLimitFeaturesFirstPass = nSchemaSniffFeatures_;
     while( true )
     {
         nIter ++;
@@ -928,6 +2120,7 @@ bool OGRGeoJSONReader::FirstPassReadLayer( OGRGeoJSONDataSource* poDS,
             poLayer->GetFeatureCount(FALSE) >= nLimitFeaturesFirstPass )
         {
             CPLDebug("GeoJSON", "First pass: early exit since above "
+                     "SCHEMA_SNIFF_FEATURES / "
                      "OGR_GEOJSON_MAX_FEATURES_FIRST_PASS");
             bThresholdReached = true;
             break;
@@ -2343,11 +3536,17 @@ void OGRGeoJSONReaderSetField( OGRLayer* poLayer,
     }
     else if( OFTInteger == eType )
     {
-        poFeature->SetField( nField, json_object_get_int(poVal) );
+        // Values out of the range of the field, that the first pass has not
+        // seen, are clamped with a warning.
+        if( json_object_get_type(poVal) == json_type_int )
+            poFeature->SetField( nField,
+                        static_cast<GIntBig>(json_object_get_int64(poVal)) );
+        else
+            poFeature->SetField( nField, json_object_get_int(poVal) );
 
         // Check if FID available and set correct value.
         if( EQUAL( poFieldDefn->GetNameRef(), poLayer->GetFIDColumn() ) )
-            poFeature->SetFID( json_object_get_int(poVal) );
+            poFeature->SetFID( poFeature->GetFieldAsInteger(nField) );
     }
     else if( OFTInteger64 == eType )
     {
@@ -2741,7 +3940,15 @@ GeoJSONObject::Type OGRGeoJSONGetType( json_object* poObj )
     if( nullptr == poObjType )
         return GeoJSONObject::eUnknown;
 
-    const char* name = json_object_get_string( poObjType );
+    return OGRGeoJSONGetTypeFromName( json_object_get_string( poObjType ) );
+}
+
+/************************************************************************/
+/*                       OGRGeoJSONGetTypeFromName                      */
+/************************************************************************/
+
+GeoJSONObject::Type OGRGeoJSONGetTypeFromName( const char* name )
+{
     if( EQUAL( name, "Point" ) )
         return GeoJSONObject::ePoint;
     else if( EQUAL( name, "LineString" ) )
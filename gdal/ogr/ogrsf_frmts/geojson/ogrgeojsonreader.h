@@ -100,6 +100,7 @@ class OGRGeoJSONBaseReader
     void SetStoreNativeData( bool bStoreNativeData );
     void SetArrayAsString( bool bArrayAsString );
     void SetDateAsString( bool bDateAsString );
+    void SetSchemaSniffFeatures( GIntBig nSchemaSniffFeatures );
 
     bool GenerateFeatureDefn( OGRLayer* poLayer, json_object* poObj );
     void FinalizeLayerDefn( OGRLayer* poLayer, CPLString& osFIDColumn );
@@ -115,8 +116,10 @@ class OGRGeoJSONBaseReader
     bool bStoreNativeData_ = false;
     bool bArrayAsString_ = false;
     bool bDateAsString_ = false;
+    GIntBig nSchemaSniffFeatures_ = 0;
 
   private:
+    friend class OGRGeoJSONReaderStreamingParser;
 
     std::set<int> aoSetUndeterminedTypeFields_;
 
@@ -231,6 +234,7 @@ lh_entry* OGRGeoJSONFindMemberEntryByName( json_object* poObj,
 json_object* OGRGeoJSONFindMemberByName( json_object* poObj,
                                          const char* pszName );
 GeoJSONObject::Type OGRGeoJSONGetType( json_object* poObj );
+GeoJSONObject::Type OGRGeoJSONGetTypeFromName( const char* pszName );
 
 json_object* json_ex_get_object_by_path( json_object* poObj,
                                          const char* pszPath );
@@ -397,6 +397,10 @@ class OGRGeoPackageLayer CPL_NON_FINAL: public OGRLayer, public IOGRSQLiteGetSpa
     /* OGR API methods */
 
     OGRFeature*         GetNextFeature() override;
+    bool                GetArrowStream( struct ArrowArrayStream* out_stream,
+                                        CSLConstList papszOptions = nullptr ) override;
+    int                 GetNextArrowArray( struct ArrowArrayStream*,
+                                           struct ArrowArray* out_array ) override;
     const char*         GetFIDColumn() override;
     void                ResetReading() override;
     int                 TestCapability( const char * ) override;
@@ -524,6 +528,8 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     OGRErr              SetAttributeFilter( const char *pszQuery ) override;
     OGRErr              SyncToDisk() override;
     OGRFeature*         GetNextFeature() override;
+    int                 GetNextArrowArray( struct ArrowArrayStream*,
+                                           struct ArrowArray* out_array ) override;
     OGRFeature*         GetFeature(GIntBig nFID) override;
     OGRErr              StartTransaction() override;
     OGRErr              CommitTransaction() override;
@@ -645,6 +651,9 @@ class OGRGeoPackageSelectLayer final : public OGRGeoPackageLayer, public IOGRSQL
     virtual void        ResetReading() override;
 
     virtual OGRFeature *GetNextFeature() override;
+    virtual int         GetNextArrowArray( struct ArrowArrayStream* stream,
+                                           struct ArrowArray* out_array ) override
+                            { return OGRLayer::GetNextArrowArray(stream, out_array); }
     virtual GIntBig     GetFeatureCount( int ) override;
 
     virtual void        SetSpatialFilter( OGRGeometry * poGeom ) override { SetSpatialFilter(0, poGeom); }
@@ -31,6 +31,9 @@
 #include "ogrgeopackageutility.h"
 #include "ogrsqliteutility.h"
 #include "ogr_p.h"
+#include "ogrlayerarrow.h"
+
+#include <cerrno>
 
 CPL_CVSID("$Id$")
 
@@ -382,6 +385,227 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
     return poFeature;
 }
 
+/************************************************************************/
+/*                           GetArrowStream()                           */
+/************************************************************************/
+
+bool OGRGeoPackageLayer::GetArrowStream( struct ArrowArrayStream* out_stream,
+                                         CSLConstList papszOptions )
+{
+    // GeoPackage DateTime values are in UTC.
+    CPLStringList aosOptions(papszOptions);
+    if( aosOptions.FetchNameValue("TIMEZONE") == nullptr )
+        aosOptions.SetNameValue("TIMEZONE", "UTC");
+    return OGRLayer::GetArrowStream(out_stream, aosOptions.List());
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Fill the Arrow array directly from the result of the query,     */
+/*      without instantiating OGRFeature objects.                       */
+/************************************************************************/
+
+int OGRGeoPackageLayer::GetNextArrowArray( struct ArrowArrayStream* stream,
+                                           struct ArrowArray* out_array )
+{
+    // Attribute filters evaluated client-side need OGRFeature objects
+    if( m_poAttrQuery != nullptr )
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    OGRArrowArrayHelper oHelper(m_poFeatureDefn,
+                                m_aosArrowArrayStreamOptions.List(),
+                                out_array);
+    if( !oHelper.IsValid() )
+        return ENOMEM;
+
+    if( m_bEOF )
+        return oHelper.Finalize(0) ? 0 : ENOMEM;
+
+    if( m_poQueryStatement == nullptr )
+    {
+        ResetStatement();
+        if (m_poQueryStatement == nullptr)
+            return oHelper.Finalize(0) ? 0 : ENOMEM;
+    }
+
+    const bool bGeomSelected = iGeomCol >= 0 && oHelper.IsGeomFieldSelected(0);
+    OGRSpatialReference* poSrs = m_poFeatureDefn->GetGeomFieldCount() ?
+        m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() : nullptr;
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    const int nMaxFeatures = oHelper.GetMaxFeatureCount();
+    int iRow = 0;
+    while( iRow < nMaxFeatures )
+    {
+        if( bDoStep )
+        {
+            int rc = sqlite3_step( m_poQueryStatement );
+            if( rc != SQLITE_ROW )
+            {
+                if ( rc != SQLITE_DONE )
+                {
+                    sqlite3_reset(m_poQueryStatement);
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                            "In GetNextArrowArray(): sqlite3_step() : %s",
+                            sqlite3_errmsg(m_poDS->GetDB()) );
+                }
+
+                ClearStatement();
+                m_bEOF = true;
+                break;
+            }
+        }
+        else
+        {
+            bDoStep = true;
+        }
+
+        sqlite3_stmt* hStmt = m_poQueryStatement;
+
+        // The geometry is only decoded when a spatial filter must be
+        // evaluated, or when the blob is not a standard GeoPackage one.
+        const GByte* pabyGpkg = nullptr;
+        int nGpkgSize = 0;
+        std::unique_ptr<OGRGeometry> poGeom;
+        if( iGeomCol >= 0 &&
+            sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
+            (bGeomSelected || m_poFilterGeom != nullptr) )
+        {
+            nGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+            // coverity[tainted_data_return]
+            pabyGpkg = static_cast<const GByte*>(
+                sqlite3_column_blob(hStmt, iGeomCol));
+            GPkgHeader oHeader;
+            if( m_poFilterGeom != nullptr ||
+                GPkgHeaderFromWKB(pabyGpkg, nGpkgSize,
+                                  &oHeader) != OGRERR_NONE ||
+                oHeader.bExtended )
+            {
+                poGeom.reset(GPkgGeometryToOGR(pabyGpkg, nGpkgSize, nullptr));
+                if( poGeom == nullptr )
+                {
+                    OGRGeometry* poSpatialiteGeom = nullptr;
+                    if( OGRSQLiteLayer::ImportSpatiaLiteGeometry(
+                            pabyGpkg, nGpkgSize,
+                            &poSpatialiteGeom ) != OGRERR_NONE )
+                    {
+                        CPLError( CE_Failure, CPLE_AppDefined,
+                                  "Unable to read geometry");
+                    }
+                    poGeom.reset(poSpatialiteGeom);
+                }
+                if( poGeom )
+                    poGeom->assignSpatialReference(poSrs);
+                pabyGpkg = nullptr;
+            }
+            else
+            {
+                pabyGpkg += oHeader.nHeaderLen;
+                nGpkgSize -= static_cast<int>(oHeader.nHeaderLen);
+            }
+        }
+
+        GIntBig nFID;
+        if( iFIDCol >= 0 )
+        {
+            nFID = sqlite3_column_int64( hStmt, iFIDCol );
+            if( m_pszFidColumn == nullptr && nFID == 0 )
+            {
+                // Miht be the case for views with joins.
+                nFID = iNextShapeId;
+            }
+        }
+        else
+            nFID = iNextShapeId;
+        iNextShapeId++;
+
+        if( m_poFilterGeom != nullptr && !FilterGeometry(poGeom.get()) )
+            continue;
+
+        m_nFeaturesRead++;
+
+        oHelper.SetFID(iRow, nFID);
+
+        bool bOK = true;
+        if( bGeomSelected )
+        {
+            if( pabyGpkg )
+                bOK = oHelper.SetWKB(0, iRow, pabyGpkg, nGpkgSize);
+            else if( poGeom )
+                bOK = oHelper.SetGeometry(0, iRow, poGeom.get());
+        }
+
+        for( int iField = 0; bOK && iField < nFieldCount; iField++ )
+        {
+            if( !oHelper.IsFieldSelected(iField) )
+                continue;
+
+            const int iRawField = panFieldOrdinals[iField];
+            const int nSqlite3ColType = sqlite3_column_type( hStmt, iRawField );
+            if( nSqlite3ColType == SQLITE_NULL )
+                continue;
+
+            switch( m_poFeatureDefn->GetFieldDefn(iField)->GetType() )
+            {
+                case OFTInteger:
+                case OFTInteger64:
+                    oHelper.SetInteger( iField, iRow,
+                        sqlite3_column_int64( hStmt, iRawField ) );
+                    break;
+
+                case OFTReal:
+                    oHelper.SetReal( iField, iRow,
+                        sqlite3_column_double( hStmt, iRawField ) );
+                    break;
+
+                case OFTBinary:
+                {
+                    const int nBytes = sqlite3_column_bytes( hStmt, iRawField );
+                    // coverity[tainted_data_return]
+                    const void* pabyData =
+                        sqlite3_column_blob( hStmt, iRawField );
+                    bOK = oHelper.SetBytes( iField, iRow, pabyData, nBytes );
+                    break;
+                }
+
+                case OFTString:
+                {
+                    const char* pszTxt = reinterpret_cast<const char*>(
+                        sqlite3_column_text( hStmt, iRawField ));
+                    const int nBytes = sqlite3_column_bytes( hStmt, iRawField );
+                    bOK = oHelper.SetBytes( iField, iRow, pszTxt, nBytes );
+                    break;
+                }
+
+                case OFTDate:
+                case OFTDateTime:
+                {
+                    if( nSqlite3ColType != SQLITE_TEXT )
+                        break;
+                    const char* pszTxt = reinterpret_cast<const char*>(
+                        sqlite3_column_text( hStmt, iRawField ));
+                    OGRField sField;
+                    if( OGRParseXMLDateTime(pszTxt, &sField) ||
+                        OGRParseDate(pszTxt, &sField, 0) )
+                    {
+                        oHelper.SetDateTime( iField, iRow, &sField );
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+        if( !bOK )
+            return ENOMEM;
+
+        iRow++;
+    }
+
+    return oHelper.Finalize(iRow) ? 0 : ENOMEM;
+}
+
 /************************************************************************/
 /*                      GetFIDColumn()                                  */
 /************************************************************************/
@@ -404,6 +628,8 @@ int OGRGeoPackageLayer::TestCapability ( const char * pszCap )
         return TRUE;
     else if ( EQUAL(pszCap, OLCStringsAsUTF8) )
         return TRUE;
+    else if ( EQUAL(pszCap, OLCFastGetArrowStream) )
+        return m_poAttrQuery == nullptr;
     else
         return FALSE;
 }
@@ -32,8 +32,10 @@
 #include "ogrsqliteutility.h"
 #include "cpl_time.h"
 #include "ogr_p.h"
+#include "ogr_recordbatch.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <cmath>
 
 CPL_CVSID("$Id$")
@@ -2232,6 +2234,39 @@ OGRFeature* OGRGeoPackageTableLayer::GetNextFeature()
     return poFeature;
 }
 
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+int OGRGeoPackageTableLayer::GetNextArrowArray( struct ArrowArrayStream* stream,
+                                                struct ArrowArray* out_array )
+{
+    if( !m_bFeatureDefnCompleted )
+        GetLayerDefn();
+    if( m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE )
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    if( m_poFilterGeom != nullptr )
+    {
+        // Both are exclusive
+        CreateSpatialIndexIfNecessary();
+        if( !RunDeferredSpatialIndexUpdate() )
+        {
+            memset(out_array, 0, sizeof(*out_array));
+            return EIO;
+        }
+    }
+
+    // The FID must also be set in the regular field
+    if( m_iFIDAsRegularColumnIndex >= 0 )
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    return OGRGeoPackageLayer::GetNextArrowArray(stream, out_array);
+}
+
 /************************************************************************/
 /*                        GetFeature()                                  */
 /************************************************************************/
@@ -55,6 +55,10 @@
 class OGRLayerAttrIndex;
 class OGRSFDriver;
 
+struct ArrowArrayStream;
+struct ArrowSchema;
+struct ArrowArray;
+
 /************************************************************************/
 /*                               OGRLayer                               */
 /************************************************************************/
@@ -192,6 +196,13 @@ class CPL_DLL OGRLayer : public GDALMajorObject
 
     virtual OGRErr      SetIgnoredFields( const char **papszFields );
 
+    virtual bool        GetArrowStream( struct ArrowArrayStream* out_stream,
+                                        CSLConstList papszOptions = nullptr );
+    virtual int         GetArrowSchema( struct ArrowArrayStream*,
+                                        struct ArrowSchema* out_schema );
+    virtual int         GetNextArrowArray( struct ArrowArrayStream*,
+                                           struct ArrowArray* out_array );
+
     OGRErr              Intersection( OGRLayer *pLayerMethod,
                                       OGRLayer *pLayerResult,
                                       char** papszOptions = nullptr,
@@ -270,6 +281,8 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     int                  m_nRefCount;
 
     GIntBig              m_nFeaturesRead;
+
+    CPLStringList        m_aosArrowArrayStreamOptions{};
 //! @endcond
 };
 
@@ -56,6 +56,10 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape,
                                SHPObject *psShape, const char *pszSHPEncoding );
 OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape );
+OGRGeometry *SHPReadOGRGeometry( SHPHandle hSHP, int iShape,
+                                 SHPObject *psShape,
+                                 OGRwkbGeometryType eMyGeomType );
+void SHPParseOGRDate( const char* pszDateValue, OGRField* psField );
 OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
                                        SHPHandle hSHP, DBFHandle hDBF,
                                        const char *pszSHPEncoding,
@@ -222,6 +226,8 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
 
     void                ResetReading() override;
     OGRFeature *        GetNextFeature() override;
+    int                 GetNextArrowArray( struct ArrowArrayStream* stream,
+                                           struct ArrowArray* out_array ) override;
     OGRErr              SetNextByIndex( GIntBig nIndex ) override;
 
     OGRFeature         *GetFeature( GIntBig nFeatureId ) override;
@@ -37,6 +37,7 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <memory>
 #include <string>
 
 #include "cpl_conv.h"
@@ -52,6 +53,7 @@
 #include "ogr_p.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
+#include "ogrlayerarrow.h"
 #include "ogrlayerpool.h"
 #include "ogrsf_frmts.h"
 #include "shapefil.h"
@@ -935,6 +937,149 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Read the shapes and DBF records directly into the Arrow array,  */
+/*      without instantiating OGRFeature objects.                       */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextArrowArray( struct ArrowArrayStream* stream,
+                                      struct ArrowArray* out_array )
+
+{
+    // Filters may use the spatial and attribute indices, and need
+    // OGRFeature objects.
+    if( m_poAttrQuery != nullptr || m_poFilterGeom != nullptr )
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    if( !TouchLayer() )
+        return EIO;
+
+    OGRArrowArrayHelper oHelper(poFeatureDefn,
+                                m_aosArrowArrayStreamOptions.List(),
+                                out_array);
+    if( !oHelper.IsValid() )
+        return ENOMEM;
+
+    const bool bGeomSelected = hSHP != nullptr &&
+                               poFeatureDefn->GetGeomFieldCount() > 0 &&
+                               oHelper.IsGeomFieldSelected(0);
+    const OGRwkbGeometryType eGeomType = bGeomSelected ?
+        poFeatureDefn->GetGeomFieldDefn(0)->GetType() : wkbNone;
+    const int nFieldCount = hDBF ? poFeatureDefn->GetFieldCount() : 0;
+    const int nMaxFeatures = oHelper.GetMaxFeatureCount();
+    int iRow = 0;
+    while( iRow < nMaxFeatures && iNextShapeId < nTotalShapeCount )
+    {
+        const int iShape = iNextShapeId;
+        if( hDBF )
+        {
+            if( DBFIsRecordDeleted( hDBF, iShape ) )
+            {
+                iNextShapeId++;
+                continue;
+            }
+            if( VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)) )
+                return EIO;  // I/O error.
+        }
+        iNextShapeId++;
+        m_nFeaturesRead++;
+
+        oHelper.SetFID(iRow, iShape);
+
+        if( bGeomSelected )
+        {
+            std::unique_ptr<OGRGeometry> poGeom(
+                SHPReadOGRGeometry( hSHP, iShape, nullptr, eGeomType ));
+            if( poGeom && !oHelper.SetGeometry(0, iRow, poGeom.get()) )
+                return ENOMEM;
+        }
+
+        for( int iField = 0; iField < nFieldCount; iField++ )
+        {
+            if( !oHelper.IsFieldSelected(iField) )
+                continue;
+
+            switch( poFeatureDefn->GetFieldDefn(iField)->GetType() )
+            {
+              case OFTString:
+              {
+                  const char * const pszFieldVal =
+                      DBFReadStringAttribute( hDBF, iShape, iField );
+                  if( pszFieldVal == nullptr || pszFieldVal[0] == '\0' )
+                      break;
+                  bool bOK;
+                  if( !osEncoding.empty() )
+                  {
+                      char * const pszUTF8Field =
+                          CPLRecode( pszFieldVal, osEncoding, CPL_ENC_UTF8);
+                      bOK = oHelper.SetBytes( iField, iRow, pszUTF8Field,
+                                              strlen(pszUTF8Field) );
+                      CPLFree( pszUTF8Field );
+                  }
+                  else
+                  {
+                      bOK = oHelper.SetBytes( iField, iRow, pszFieldVal,
+                                              strlen(pszFieldVal) );
+                  }
+                  if( !bOK )
+                      return ENOMEM;
+                  break;
+              }
+
+              case OFTInteger:
+              case OFTInteger64:
+              {
+                  if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                      break;
+                  GIntBig nVal = CPLAtoGIntBig(
+                      DBFReadStringAttribute( hDBF, iShape, iField ) );
+                  if( poFeatureDefn->GetFieldDefn(iField)->GetType() ==
+                                                                OFTInteger )
+                  {
+                      nVal = std::max(static_cast<GIntBig>(INT_MIN),
+                                      std::min(static_cast<GIntBig>(INT_MAX),
+                                               nVal));
+                  }
+                  oHelper.SetInteger( iField, iRow, nVal );
+                  break;
+              }
+
+              case OFTReal:
+              {
+                  if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                      break;
+                  oHelper.SetReal( iField, iRow, CPLAtof(
+                      DBFReadStringAttribute( hDBF, iShape, iField ) ) );
+                  break;
+              }
+
+              case OFTDate:
+              {
+                  if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                      break;
+                  const char* const pszDateValue =
+                      DBFReadStringAttribute( hDBF, iShape, iField );
+                  if( pszDateValue[0] == '\0' )
+                      break;
+                  OGRField sFld;
+                  SHPParseOGRDate( pszDateValue, &sFld );
+                  oHelper.SetDateTime( iField, iRow, &sFld );
+                  break;
+              }
+
+              default:
+                  break;
+            }
+        }
+
+        iRow++;
+    }
+
+    return oHelper.Finalize(iRow) ? 0 : ENOMEM;
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -1652,6 +1797,9 @@ int OGRShapeLayer::TestCapability( const char * pszCap )
     if( EQUAL(pszCap,OLCFastSetNextByIndex) )
         return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
 
+    if( EQUAL(pszCap,OLCFastGetArrowStream) )
+        return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+
     if( EQUAL(pszCap,OLCCreateField) )
         return bUpdateAccess;
 
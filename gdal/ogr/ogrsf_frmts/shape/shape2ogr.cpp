@@ -1194,6 +1194,81 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
     return poDefn;
 }
 
+/************************************************************************/
+/*                         SHPReadOGRGeometry()                         */
+/*                                                                      */
+/*      Read a shape as an OGR geometry, whose Z and M flags are set    */
+/*      after the ones of the layer geometry type.                      */
+/************************************************************************/
+
+OGRGeometry *SHPReadOGRGeometry( SHPHandle hSHP, int iShape,
+                                 SHPObject *psShape,
+                                 OGRwkbGeometryType eMyGeomType )
+
+{
+    OGRGeometry* poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+
+    // Two possibilities are expected here (both are tested by
+    // GDAL Autotests):
+    //   1. Read valid geometry and assign it directly.
+    //   2. Read and assign null geometry if it can not be read
+    //      correctly from a shapefile.
+    //
+    // It is NOT required here to test poGeometry == NULL.
+
+    if( poGeometry && eMyGeomType != wkbUnknown )
+    {
+        // Set/unset flags.
+        OGRwkbGeometryType eGeomInType = poGeometry->getGeometryType();
+        if( wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType) )
+        {
+            poGeometry->set3D(TRUE);
+        }
+        else if( !wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType) )
+        {
+            poGeometry->set3D(FALSE);
+        }
+        if( wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType) )
+        {
+            poGeometry->setMeasured(TRUE);
+        }
+        else if( !wkbHasM(eMyGeomType) && wkbHasM(eGeomInType) )
+        {
+            poGeometry->setMeasured(FALSE);
+        }
+    }
+
+    return poGeometry;
+}
+
+/************************************************************************/
+/*                          SHPParseOGRDate()                           */
+/*                                                                      */
+/*      Parse a non-empty DBF date value, either as YYYYMMDD or as      */
+/*      MM/DD/YYYY.                                                     */
+/************************************************************************/
+
+void SHPParseOGRDate( const char* pszDateValue, OGRField* psField )
+
+{
+    memset( psField, 0, sizeof(*psField) );
+
+    if( strlen(pszDateValue) >= 10 &&
+        pszDateValue[2] == '/' && pszDateValue[5] == '/' )
+    {
+        psField->Date.Month = static_cast<GByte>(atoi(pszDateValue + 0));
+        psField->Date.Day   = static_cast<GByte>(atoi(pszDateValue + 3));
+        psField->Date.Year  = static_cast<GInt16>(atoi(pszDateValue + 6));
+    }
+    else
+    {
+        const int nFullDate = atoi(pszDateValue);
+        psField->Date.Year = static_cast<GInt16>(nFullDate / 10000);
+        psField->Date.Month = static_cast<GByte>((nFullDate / 100) % 100);
+        psField->Date.Day = static_cast<GByte>(nFullDate % 100);
+    }
+}
+
 /************************************************************************/
 /*                         SHPReadOGRFeature()                          */
 /************************************************************************/
@@ -1233,45 +1308,8 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
     {
         if( !poDefn->IsGeometryIgnored() )
         {
-            OGRGeometry* poGeometry =
-                SHPReadOGRObject( hSHP, iShape, psShape );
-
-            // Two possibilities are expected here (both are tested by
-            // GDAL Autotests):
-            //   1. Read valid geometry and assign it directly.
-            //   2. Read and assign null geometry if it can not be read
-            //      correctly from a shapefile.
-            //
-            // It is NOT required here to test poGeometry == NULL.
-
-            if( poGeometry )
-            {
-                // Set/unset flags.
-                const OGRwkbGeometryType eMyGeomType =
-                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType();
-
-                if( eMyGeomType != wkbUnknown )
-                {
-                    OGRwkbGeometryType eGeomInType =
-                        poGeometry->getGeometryType();
-                    if( wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(TRUE);
-                    }
-                    else if( !wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(FALSE);
-                    }
-                    if( wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(TRUE);
-                    }
-                    else if( !wkbHasM(eMyGeomType) && wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(FALSE);
-                    }
-                }
-            }
+            OGRGeometry* poGeometry = SHPReadOGRGeometry(
+                hSHP, iShape, psShape, poDefn->GetGeomFieldDefn(0)->GetType() );
 
             poFeature->SetGeometryDirectly( poGeometry );
         }
@@ -1351,22 +1389,7 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                   continue;
 
               OGRField sFld;
-              memset( &sFld, 0, sizeof(sFld) );
-
-              if( strlen(pszDateValue) >= 10 &&
-                  pszDateValue[2] == '/' && pszDateValue[5] == '/' )
-              {
-                  sFld.Date.Month = static_cast<GByte>(atoi(pszDateValue + 0));
-                  sFld.Date.Day   = static_cast<GByte>(atoi(pszDateValue + 3));
-                  sFld.Date.Year  = static_cast<GInt16>(atoi(pszDateValue + 6));
-              }
-              else
-              {
-                  const int nFullDate = atoi(pszDateValue);
-                  sFld.Date.Year = static_cast<GInt16>(nFullDate / 10000);
-                  sFld.Date.Month = static_cast<GByte>((nFullDate / 100) % 100);
-                  sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
-              }
+              SHPParseOGRDate( pszDateValue, &sFld );
 
               poFeature->SetField( iField, &sFld );
           }
@@ -42,10 +42,12 @@
 #include "cpl_port.h"
 #include "cpl_minizip_zip.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 #if HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
@@ -190,6 +192,8 @@ typedef struct
     int use_cpl_io;
     vsi_l_offset vsi_raw_length_before;
     VSIVirtualHandle* vsi_deflate_handle;
+    size_t vsi_deflate_chunk_size; /* non zero to deflate in independent chunks */
+    std::vector<vsi_l_offset>* vsi_deflate_chunk_offsets;
 } zip64_internal;
 
 #ifndef NOCRYPT
@@ -868,6 +872,8 @@ extern zipFile ZEXPORT cpl_zipOpen2 (
     ziinit.use_cpl_io = (pzlib_filefunc_def == nullptr) ? 1 : 0;
     ziinit.vsi_raw_length_before = 0;
     ziinit.vsi_deflate_handle = nullptr;
+    ziinit.vsi_deflate_chunk_size = 0;
+    ziinit.vsi_deflate_chunk_offsets = nullptr;
     init_linkedlist(&(ziinit.central_dir));
 
     zip64_internal* zi = static_cast<zip64_internal*>(ALLOC(sizeof(zip64_internal)));
@@ -1177,9 +1183,19 @@ extern int ZEXPORT cpl_zipOpenNewFileInZip3 (
         {
             auto fpRaw = reinterpret_cast<VSIVirtualHandle*>(zi->filestream);
             zi->vsi_raw_length_before = fpRaw->Tell();
-            zi->vsi_deflate_handle =
-                VSICreateGZipWritable( fpRaw,
-                                       CPL_DEFLATE_TYPE_RAW_DEFLATE, false);
+            if( zi->vsi_deflate_chunk_size )
+            {
+                zi->vsi_deflate_handle =
+                    VSICreateChunkedDeflateWritable(
+                        fpRaw, zi->vsi_deflate_chunk_size,
+                        zi->vsi_deflate_chunk_offsets );
+            }
+            else
+            {
+                zi->vsi_deflate_handle =
+                    VSICreateGZipWritable( fpRaw,
+                                           CPL_DEFLATE_TYPE_RAW_DEFLATE, false);
+            }
             err = Z_OK;
         }
         else
@@ -1845,6 +1861,10 @@ typedef struct
 {
     zipFile   hZip;
     char    **papszFilenames;
+    // Set while writing a file with SEEK_OPTIMIZED=YES
+    char     *pszChunkIndexedFilename;
+    size_t    nChunkSize;
+    std::vector<vsi_l_offset>* panChunkOffsets;
 } CPLZip;
 
 /************************************************************************/
@@ -1891,6 +1911,9 @@ void *CPLCreateZip( const char *pszZipFilename, char **papszOptions )
     CPLZip* psZip = static_cast<CPLZip *>(CPLMalloc(sizeof(CPLZip)));
     psZip->hZip = hZip;
     psZip->papszFilenames = papszFilenames;
+    psZip->pszChunkIndexedFilename = nullptr;
+    psZip->nChunkSize = 0;
+    psZip->panChunkOffsets = nullptr;
     return psZip;
 }
 
@@ -1918,6 +1941,27 @@ CPLErr CPLCreateFileInZip( void *hZip, const char *pszFilename,
     const bool bCompressed =
         CPLTestBool(CSLFetchNameValueDef(papszOptions, "COMPRESSED", "TRUE"));
 
+    // Deflate in independent chunks and write a chunk index after the file,
+    // so that readers can seek in it without decompressing from the start.
+    const bool bSeekOptimized = bCompressed &&
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SEEK_OPTIMIZED",
+            CPLGetConfigOption("CPL_VSIL_ZIP_SEEK_OPTIMIZED", "NO")));
+    size_t nChunkSize = 0;
+    if( bSeekOptimized )
+    {
+        const char* pszChunkSize = CSLFetchNameValueDef(papszOptions,
+            "SEEK_OPTIMIZED_CHUNK_SIZE",
+            CPLGetConfigOption("CPL_VSIL_ZIP_SEEK_OPTIMIZED_CHUNK_SIZE",
+                               "32K"));
+        GIntBig nVal = CPLAtoGIntBig(pszChunkSize);
+        if( strchr(pszChunkSize, 'K') )
+            nVal *= 1024;
+        else if( strchr(pszChunkSize, 'M') )
+            nVal *= 1024 * 1024;
+        nChunkSize = static_cast<size_t>(
+            std::max<GIntBig>(1024, std::min<GIntBig>(512 * 1024 * 1024, nVal)));
+    }
+
     // If the filename is ASCII only, then no need for an extended field
     bool bIsAscii = true;
     for( int i=0; pszFilename[i] != '\0'; i++ )
@@ -1967,6 +2011,21 @@ CPLErr CPLCreateFileInZip( void *hZip, const char *pszFilename,
         pszCPFilename = CPLStrdup(pszFilename);
     }
 
+    CPLFree( psZip->pszChunkIndexedFilename );
+    psZip->pszChunkIndexedFilename = nullptr;
+    delete psZip->panChunkOffsets;
+    psZip->panChunkOffsets = nullptr;
+    psZip->nChunkSize = 0;
+
+    zip64_internal* zi = reinterpret_cast<zip64_internal*>(psZip->hZip);
+    if( bSeekOptimized )
+    {
+        psZip->panChunkOffsets = new std::vector<vsi_l_offset>();
+        psZip->nChunkSize = nChunkSize;
+        zi->vsi_deflate_chunk_size = nChunkSize;
+        zi->vsi_deflate_chunk_offsets = psZip->panChunkOffsets;
+    }
+
     const int nErr =
         cpl_zipOpenNewFileInZip(
             psZip->hZip, pszCPFilename, nullptr,
@@ -1974,11 +2033,22 @@ CPLErr CPLCreateFileInZip( void *hZip, const char *pszFilename,
             bCompressed ? Z_DEFLATED : 0,
             bCompressed ? Z_DEFAULT_COMPRESSION : 0 );
 
+    zi->vsi_deflate_chunk_size = 0;
+    zi->vsi_deflate_chunk_offsets = nullptr;
+
     CPLFree( pabyExtra );
     CPLFree( pszCPFilename );
 
     if( nErr != ZIP_OK )
+    {
+        delete psZip->panChunkOffsets;
+        psZip->panChunkOffsets = nullptr;
+        psZip->nChunkSize = 0;
         return CE_Failure;
+    }
+
+    if( bSeekOptimized )
+        psZip->pszChunkIndexedFilename = CPLStrdup(pszFilename);
 
     psZip->papszFilenames = CSLAddString(psZip->papszFilenames, pszFilename);
     return CE_None;
@@ -2006,6 +2076,83 @@ CPLErr CPLWriteFileInZip( void *hZip, const void *pBuffer, int nBufferSize )
     return CE_None;
 }
 
+/************************************************************************/
+/*                        CPLWriteChunkIndexInZip()                     */
+/************************************************************************/
+
+/* Write the chunk index of the file that has just been closed, when it */
+/* has been created with SEEK_OPTIMIZED=YES. */
+static CPLErr CPLWriteChunkIndexInZip( CPLZip* psZip )
+{
+    const zip64_internal* zi = reinterpret_cast<zip64_internal*>(psZip->hZip);
+    const std::vector<vsi_l_offset>& anOffsets = *(psZip->panChunkOffsets);
+    const GUInt64 nUncompressedSize = zi->ci.totalUncompressedData;
+    const GUInt64 nCompressedSize = zi->ci.totalCompressedData;
+    const size_t nChunks = static_cast<size_t>(
+        (nUncompressedSize + psZip->nChunkSize - 1) / psZip->nChunkSize);
+
+    // Nothing to gain for files that fit in a single chunk.
+    if( nChunks <= 1 )
+        return CE_None;
+    if( anOffsets.size() != nChunks || anOffsets[0] != 0 )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Inconsistent chunk offsets for %s",
+                 psZip->pszChunkIndexedFilename);
+        return CE_Failure;
+    }
+
+    std::vector<GByte> abyIndex(
+        CPL_ZIP_CHUNK_INDEX_HEADER_SIZE + (nChunks - 1) * sizeof(GUInt64));
+    size_t nPos = 0;
+    const auto WriteUInt32 = [&abyIndex, &nPos](GUInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        memcpy(&abyIndex[nPos], &nVal, sizeof(nVal));
+        nPos += sizeof(nVal);
+    };
+    const auto WriteUInt64 = [&abyIndex, &nPos](GUInt64 nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        memcpy(&abyIndex[nPos], &nVal, sizeof(nVal));
+        nPos += sizeof(nVal);
+    };
+    WriteUInt32(CPL_ZIP_CHUNK_INDEX_VERSION);
+    WriteUInt32(CPL_ZIP_CHUNK_INDEX_HEADER_SIZE);
+    WriteUInt32(static_cast<GUInt32>(psZip->nChunkSize));
+    WriteUInt32(static_cast<GUInt32>(sizeof(GUInt64)));
+    WriteUInt64(nUncompressedSize);
+    WriteUInt64(nCompressedSize);
+    for( size_t i = 1; i < nChunks; ++i )
+        WriteUInt64(anOffsets[i]);
+
+    // The index is a hidden file, next to the indexed one.
+    const char* pszFilename = psZip->pszChunkIndexedFilename;
+    const char* pszLastSlash = strrchr(pszFilename, '/');
+    CPLString osIndexFilename;
+    if( pszLastSlash )
+    {
+        osIndexFilename.assign(pszFilename, pszLastSlash + 1 - pszFilename);
+        pszFilename = pszLastSlash + 1;
+    }
+    osIndexFilename += '.';
+    osIndexFilename += pszFilename;
+    osIndexFilename += CPL_ZIP_CHUNK_INDEX_SUFFIX;
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("COMPRESSED", "NO");
+    aosOptions.SetNameValue("SEEK_OPTIMIZED", "NO");
+    if( CPLCreateFileInZip(psZip, osIndexFilename,
+                           aosOptions.List()) != CE_None ||
+        CPLWriteFileInZip(psZip, abyIndex.data(),
+                          static_cast<int>(abyIndex.size())) != CE_None ||
+        cpl_zipCloseFileInZip(psZip->hZip) != ZIP_OK )
+    {
+        return CE_Failure;
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                         CPLCloseFileInZip()                          */
 /************************************************************************/
@@ -2021,10 +2168,19 @@ CPLErr CPLCloseFileInZip( void *hZip )
 
     int nErr = cpl_zipCloseFileInZip( psZip->hZip );
 
-    if( nErr != ZIP_OK )
-        return CE_Failure;
+    CPLErr eErr = nErr == ZIP_OK ? CE_None : CE_Failure;
+    if( eErr == CE_None && psZip->pszChunkIndexedFilename != nullptr )
+    {
+        eErr = CPLWriteChunkIndexInZip(psZip);
+    }
 
-    return CE_None;
+    CPLFree( psZip->pszChunkIndexedFilename );
+    psZip->pszChunkIndexedFilename = nullptr;
+    delete psZip->panChunkOffsets;
+    psZip->panChunkOffsets = nullptr;
+    psZip->nChunkSize = 0;
+
+    return eErr;
 }
 
 /************************************************************************/
@@ -2044,6 +2200,8 @@ CPLErr CPLCloseZip( void *hZip )
     psZip->hZip = nullptr;
     CSLDestroy(psZip->papszFilenames);
     psZip->papszFilenames = nullptr;
+    CPLFree(psZip->pszChunkIndexedFilename);
+    delete psZip->panChunkOffsets;
     CPLFree(psZip);
 
     if( nErr != ZIP_OK )
@@ -253,6 +253,24 @@ extern int ZEXPORT cpl_zipClose (zipFile file,
 }
 #endif
 
+/* Files created with the SEEK_OPTIMIZED=YES option of CPLCreateFileInZip()
+   are deflated as a sequence of independent chunks, and are immediately
+   followed in the archive by a hidden stored entry, ".{filename}" +
+   CPL_ZIP_CHUNK_INDEX_SUFFIX in the same directory, with the offsets of those
+   chunks. Its content, in little-endian order, is:
+    - uint32 version (CPL_ZIP_CHUNK_INDEX_VERSION)
+    - uint32 header size (CPL_ZIP_CHUNK_INDEX_HEADER_SIZE)
+    - uint32 size of an uncompressed chunk
+    - uint32 size of an offset (8)
+    - uint64 uncompressed size of the file
+    - uint64 compressed size of the file
+    - for each chunk but the first one, the uint64 offset of its compressed
+      data, relative to the start of the compressed data of the file.
+*/
+#define CPL_ZIP_CHUNK_INDEX_SUFFIX      ".gdal_chunk_idx"
+#define CPL_ZIP_CHUNK_INDEX_VERSION     1
+#define CPL_ZIP_CHUNK_INDEX_HEADER_SIZE 32
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 #endif /* _zip_H */
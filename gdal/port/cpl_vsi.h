@@ -165,6 +165,8 @@ vsi_l_offset CPL_DLL VSIFTellL( VSILFILE * ) CPL_WARN_UNUSED_RESULT;
 void CPL_DLL    VSIRewindL( VSILFILE * );
 size_t CPL_DLL  VSIFReadL( void *, size_t, size_t, VSILFILE * ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
 int CPL_DLL     VSIFReadMultiRangeL( int nRanges, void ** ppData, const vsi_l_offset* panOffsets, const size_t* panSizes, VSILFILE * ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
+size_t CPL_DLL  VSIFPReadL( void *, size_t, vsi_l_offset, VSILFILE * ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
+void CPL_DLL    VSIFAdviseReadL( int nRanges, const vsi_l_offset* panOffsets, const size_t* panSizes, VSILFILE * );
 size_t CPL_DLL  VSIFWriteL( const void *, size_t, size_t, VSILFILE * ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
 int CPL_DLL     VSIFEofL( VSILFILE * ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
 int CPL_DLL     VSIFTruncateL( VSILFILE *, vsi_l_offset ) EXPERIMENTAL_CPL_WARN_UNUSED_RESULT;
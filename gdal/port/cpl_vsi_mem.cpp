@@ -143,6 +143,9 @@ class VSIMemHandle final : public VSIVirtualHandle
     int Eof() override;
     int Close() override;
     int Truncate( vsi_l_offset nNewSize ) override;
+    bool HasPRead() const override { return true; }
+    size_t PRead( void* pBuffer, size_t nSize,
+                  vsi_l_offset nOffset ) const override;
 };
 
 /************************************************************************/
@@ -405,6 +408,23 @@ size_t VSIMemHandle::Read( void * pBuffer, size_t nSize, size_t nCount )
     return nCount;
 }
 
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+size_t VSIMemHandle::PRead( void* pBuffer, size_t nSize,
+                            vsi_l_offset nOffset ) const
+{
+    if( nOffset >= poFile->nLength )
+        return 0;
+    const size_t nBytesToRead = static_cast<size_t>(
+        std::min(static_cast<vsi_l_offset>(nSize),
+                 poFile->nLength - nOffset));
+    if( nBytesToRead )
+        memcpy( pBuffer, poFile->pabyData + nOffset, nBytesToRead );
+    return nBytesToRead;
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
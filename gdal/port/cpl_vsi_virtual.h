@@ -71,6 +71,12 @@ class CPL_DLL VSIVirtualHandle {
     virtual VSIRangeStatus GetRangeStatus( CPL_UNUSED vsi_l_offset nOffset,
                                            CPL_UNUSED vsi_l_offset nLength )
                                           { return VSI_RANGE_STATUS_UNKNOWN; }
+    virtual void      AdviseRead( CPL_UNUSED int nRanges,
+                                  CPL_UNUSED const vsi_l_offset* panOffsets,
+                                  CPL_UNUSED const size_t* panSizes ) {}
+    virtual bool      HasPRead() const;
+    virtual size_t    PRead( void* pBuffer, size_t nSize,
+                             vsi_l_offset nOffset ) const;
 
     virtual           ~VSIVirtualHandle() { }
 };
@@ -276,6 +282,7 @@ const int CPL_DEFLATE_TYPE_GZIP = 0;
 const int CPL_DEFLATE_TYPE_ZLIB = 1;
 const int CPL_DEFLATE_TYPE_RAW_DEFLATE = 2;
 VSIVirtualHandle CPL_DLL *VSICreateGZipWritable( VSIVirtualHandle* poBaseHandle, int nDeflateType, int bAutoCloseBaseHandle );
+VSIVirtualHandle CPL_DLL *VSICreateChunkedDeflateWritable( VSIVirtualHandle* poBaseHandle, size_t nChunkSize, std::vector<vsi_l_offset>* panChunkOffsets );
 
 VSIVirtualHandle *VSICreateUploadOnCloseFile( VSIVirtualHandle* poBaseHandle );
 
@@ -670,7 +670,8 @@ int VSIRename( const char * oldpath, const char * newpath )
  *     local file system, or for upload to /vsis3/, /vsiaz/ or /vsiadls/ from local file system.
  *     Only used if NUM_THREADS > 1.
  *     For upload to /vsis3/, this chunk size must be set at least to 5 MB.
- *     The default is 8 MB since GDAL 3.3</li>
+ *     The default is 8 MB for downloads (since GDAL 3.4). Uploads are not
+ *     split by default.</li>
  * </ul>
  * @param pProgressFunc Progress callback, or NULL.
  * @param pProgressData User data of progress callback, or NULL.
@@ -1708,6 +1709,9 @@ VSILFILE *VSIFOpenExL( const char * pszFilename, const char * pszAccess,
  *                     highly file system dependent. Currently only MIME headers
  *                     such as Content-Type and Content-Encoding are supported
  *                     for the /vsis3/, /vsigs/, /vsiaz/, /vsiadls/ file systems.
+ *                     Starting with GDAL 3.4, SEEK_OPTIMIZED=YES and
+ *                     SEEK_OPTIMIZED_CHUNK_SIZE are supported when creating
+ *                     a file in a /vsizip/ archive.
  *
  * @return NULL on failure, or the file handle.
  *
@@ -2057,6 +2061,96 @@ int VSIFReadMultiRangeL( int nRanges, void ** ppData,
     return poFileHandle->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
 }
 
+/************************************************************************/
+/*                             VSIFPReadL()                             */
+/************************************************************************/
+
+/**
+ * \brief Positional read, usable concurrently from several threads.
+ *
+ * Reads up to nSize bytes starting at offset nOffset in the file, without
+ * using nor affecting the current file offset. See VSIVirtualHandle::PRead()
+ * for the restrictions on concurrent use.
+ *
+ * @param pBuffer output buffer (must be at least nSize bytes large).
+ * @param nSize number of bytes to read in the file.
+ * @param nOffset file offset from which to read.
+ * @param fp file handle opened with VSIFOpenL().
+ *
+ * @return number of bytes read, which may be less than nSize at end of file
+ * or on error. 0 is returned, with an error, if the file system does not
+ * support positional reads.
+ * @since GDAL 3.4
+ */
+
+size_t VSIFPReadL( void* pBuffer, size_t nSize, vsi_l_offset nOffset,
+                   VSILFILE* fp )
+{
+    VSIVirtualHandle *poFileHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+
+    if( !poFileHandle->HasPRead() )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Positional read not supported on this file");
+        return 0;
+    }
+    return poFileHandle->PRead(pBuffer, nSize, nOffset);
+}
+
+/************************************************************************/
+/*                          VSIFAdviseReadL()                           */
+/************************************************************************/
+
+/**
+ * \fn VSIVirtualHandle::AdviseRead( int nRanges,
+ *                                   const vsi_l_offset* panOffsets,
+ *                                   const size_t* panSizes )
+ * \brief Advise that several ranges of bytes will be read soon.
+ *
+ * Network based file systems, such as /vsicurl/ and the ones derived from
+ * it, start downloading the ranges in the background and return
+ * immediately. The downloaded data is stored in the same cache as the one
+ * used by Read(), which will wait for a range being downloaded instead of
+ * issuing a new request for it. Other file systems ignore the advice.
+ *
+ * Ranges must be sorted in ascending start offset, and must not overlap each
+ * other.
+ *
+ * @param nRanges number of ranges.
+ * @param panOffsets array of nRanges offsets at which the data will be read.
+ * @param panSizes array of nRanges sizes of the ranges (in bytes).
+ *
+ * @since GDAL 3.4
+ */
+
+/**
+ * \brief Advise that several ranges of bytes will be read soon.
+ *
+ * Network based file systems, such as /vsicurl/ and the ones derived from
+ * it, start downloading the ranges in the background and return
+ * immediately. The downloaded data is stored in the same cache as the one
+ * used by VSIFReadL(), which will wait for a range being downloaded instead
+ * of issuing a new request for it. Other file systems ignore the advice.
+ *
+ * Ranges must be sorted in ascending start offset, and must not overlap each
+ * other.
+ *
+ * @param nRanges number of ranges.
+ * @param panOffsets array of nRanges offsets at which the data will be read.
+ * @param panSizes array of nRanges sizes of the ranges (in bytes).
+ * @param fp file handle opened with VSIFOpenL().
+ *
+ * @since GDAL 3.4
+ */
+
+void VSIFAdviseReadL( int nRanges, const vsi_l_offset* panOffsets,
+                      const size_t* panSizes, VSILFILE * fp )
+{
+    VSIVirtualHandle *poFileHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+
+    poFileHandle->AdviseRead(nRanges, panOffsets, panSizes);
+}
+
 /************************************************************************/
 /*                             VSIFWriteL()                             */
 /************************************************************************/
@@ -2917,3 +3011,48 @@ int VSIVirtualHandle::ReadMultiRange( int nRanges, void ** ppData,
 }
 
 #endif  // #ifndef DOXYGEN_SKIP
+
+/************************************************************************/
+/*                              HasPRead()                              */
+/************************************************************************/
+
+/** Returns whether this file handle supports the PRead() method.
+ *
+ * @since GDAL 3.4
+ */
+bool VSIVirtualHandle::HasPRead() const
+{
+    return false;
+}
+
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+/** Positional read, usable concurrently from several threads.
+ *
+ * This method reads into pBuffer up to nSize bytes starting at offset nOffset
+ * in the file. Contrary to Seek() + Read(), it does not use nor affect the
+ * current file offset, so that several threads can issue PRead() calls
+ * concurrently on the same VSIVirtualHandle object. PRead() must however
+ * not be called concurrently with Seek(), Read(), Write(), Truncate() or
+ * Close() on the same object.
+ *
+ * This method has the same semantics as the POSIX pread() call.
+ *
+ * This method is only available if HasPRead() returns true. The base
+ * implementation returns 0.
+ *
+ * @param pBuffer output buffer (must be at least nSize bytes large).
+ * @param nSize number of bytes to read in the file.
+ * @param nOffset file offset from which to read.
+ * @return number of bytes read, which may be less than nSize at end of file
+ * or on error.
+ * @since GDAL 3.4
+ */
+size_t VSIVirtualHandle::PRead( CPL_UNUSED void* pBuffer,
+                                CPL_UNUSED size_t nSize,
+                                CPL_UNUSED vsi_l_offset nOffset ) const
+{
+    return 0;
+}
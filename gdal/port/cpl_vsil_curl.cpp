@@ -41,6 +41,7 @@
 #include "cpl_json_header.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
@@ -60,6 +61,10 @@
 #define S_IXOTH     00001
 #endif
 
+#ifndef _WIN32
+#include <utime.h>
+#endif
+
 CPL_CVSID("$Id$")
 
 #ifndef HAVE_CURL
@@ -413,7 +418,22 @@ VSICurlHandle::VSICurlHandle( VSICurlFilesystemHandler* poFSIn,
     }
 
     m_bCached = poFSIn->AllowCachedDataFor(pszFilename);
+    if( m_bCached )
+        m_poDiskCache = VSICurlDiskCache::GetForFilename(pszFilename);
     poFS->GetCachedFileProp(m_pszURL, oFileProp);
+
+    m_nParallelDownloadCount = std::max(1, atoi(CPLGetConfigOption(
+        "CPL_VSIL_CURL_PARALLEL_DOWNLOAD_COUNT", "1")));
+    // 8 MB, as the default multipart chunk size of the Python s3transfer
+    // library.
+    const GIntBig nPartSize = CPLAtoGIntBig(CPLGetConfigOption(
+        "CPL_VSIL_CURL_PARALLEL_DOWNLOAD_PART_SIZE", "8388608"));
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    m_nParallelDownloadPartChunks = static_cast<int>(std::max(
+        GIntBig(1),
+        std::min(GIntBig(1024) * 1024 * 1024 / knDOWNLOAD_CHUNK_SIZE,
+                 (nPartSize + knDOWNLOAD_CHUNK_SIZE - 1) /
+                                                    knDOWNLOAD_CHUNK_SIZE)));
 }
 
 /************************************************************************/
@@ -422,6 +442,8 @@ VSICurlHandle::VSICurlHandle( VSICurlFilesystemHandler* poFSIn,
 
 VSICurlHandle::~VSICurlHandle()
 {
+    StopAdviseReadThread();
+
     if( !m_bCached )
     {
         poFS->InvalidateCachedData(m_pszURL);
@@ -441,6 +463,115 @@ void VSICurlHandle::SetURL(const char* pszURLIn)
     m_pszURL = CPLStrdup(pszURLIn);
 }
 
+/************************************************************************/
+/*                          GetDiskCacheKey()                           */
+/************************************************************************/
+
+// Returns an empty string if the remote file cannot be identified reliably
+// enough for its content to be cached on disk.
+std::string VSICurlHandle::GetDiskCacheKey( const char* pszURL,
+                                            vsi_l_offset nFileOffsetStart ) const
+{
+    FileProp oCachedFileProp;
+    if( !poFS->GetCachedFileProp(pszURL, oCachedFileProp) ||
+        oCachedFileProp.eExists != EXIST_YES ||
+        !oCachedFileProp.bHasComputedFileSize )
+    {
+        return std::string();
+    }
+
+    // Entries are validated by making the ETag, or failing that the
+    // Last-Modified date, part of the key: an updated remote file maps to
+    // new entries, and the stale ones are eventually evicted.
+    CPLString osValidator;
+    if( !oCachedFileProp.ETag.empty() )
+        osValidator = "ETag: " + oCachedFileProp.ETag;
+    else if( oCachedFileProp.mTime > 0 )
+        osValidator.Printf("Last-Modified: " CPL_FRMT_GIB,
+                           static_cast<GIntBig>(oCachedFileProp.mTime));
+    else
+        return std::string();
+
+    // The chunk size is part of the key, as it determines the extent of
+    // the region starting at nFileOffsetStart.
+    CPLString osIdentity;
+    osIdentity.Printf("%s\n%s\n" CPL_FRMT_GUIB "\n" CPL_FRMT_GUIB "\n%d",
+                      pszURL, osValidator.c_str(),
+                      static_cast<GUIntBig>(oCachedFileProp.fileSize),
+                      static_cast<GUIntBig>(nFileOffsetStart),
+                      VSICURLGetDownloadChunkSize());
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osIdentity.data(), osIdentity.size(), abyHash);
+    char* pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    std::string osKey(pszHex);
+    CPLFree(pszHex);
+    return osKey;
+}
+
+/************************************************************************/
+/*                             GetRegion()                              */
+/************************************************************************/
+
+std::shared_ptr<std::string>
+VSICurlHandle::GetRegion( const char* pszURL,
+                          vsi_l_offset nFileOffsetStart ) const
+{
+    std::shared_ptr<std::string> psRegion =
+        poFS->GetRegion(pszURL, nFileOffsetStart);
+    if( psRegion != nullptr || m_poDiskCache == nullptr )
+        return psRegion;
+
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    nFileOffsetStart =
+        (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+    const std::string osKey(GetDiskCacheKey(pszURL, nFileOffsetStart));
+    if( osKey.empty() )
+        return nullptr;
+    psRegion = m_poDiskCache->Get(osKey);
+    if( psRegion == nullptr )
+        return nullptr;
+
+    // A region shorter than the chunk is taken by Read() as the end of the
+    // file, so discard entries that do not have the expected size (for
+    // example truncated files).
+    FileProp oCachedFileProp;
+    poFS->GetCachedFileProp(pszURL, oCachedFileProp);
+    const vsi_l_offset nExpectedSize =
+        oCachedFileProp.fileSize > nFileOffsetStart ?
+            std::min(static_cast<vsi_l_offset>(knDOWNLOAD_CHUNK_SIZE),
+                     oCachedFileProp.fileSize - nFileOffsetStart) : 0;
+    if( psRegion->size() != nExpectedSize )
+    {
+        CPLDebug(poFS->GetDebugKey(),
+                 "Ignoring disk cache entry %s of size %u instead of %u",
+                 osKey.c_str(), static_cast<unsigned>(psRegion->size()),
+                 static_cast<unsigned>(nExpectedSize));
+        return nullptr;
+    }
+    poFS->AddRegion(pszURL, nFileOffsetStart,
+                    psRegion->size(), psRegion->data());
+    return psRegion;
+}
+
+/************************************************************************/
+/*                             AddRegion()                              */
+/************************************************************************/
+
+void VSICurlHandle::AddRegion( const char* pszURL,
+                               vsi_l_offset nFileOffsetStart,
+                               size_t nSize,
+                               const char *pData ) const
+{
+    poFS->AddRegion(pszURL, nFileOffsetStart, nSize, pData);
+    if( m_poDiskCache == nullptr || nSize == 0 )
+        return;
+
+    const std::string osKey(GetDiskCacheKey(pszURL, nFileOffsetStart));
+    if( !osKey.empty() )
+        m_poDiskCache->Put(osKey, pData, nSize);
+}
+
 /************************************************************************/
 /*                          InstallReadCbk()                            */
 /************************************************************************/
@@ -793,6 +924,27 @@ static GIntBig VSICurlGetExpiresFromS3LikeSignedURL( const char* pszURL )
     return CPLYMDHMSToUnixTime(&brokendowntime) + nDelay;
 }
 
+/************************************************************************/
+/*                     VSICurlGetETagFromHeaders()                      */
+/************************************************************************/
+
+static CPLString VSICurlGetETagFromHeaders( const char* pszHeaders )
+{
+    // HTTP/2 header names are in lower case.
+    for( const char* pszKey: { "ETag: \"", "etag: \"" } )
+    {
+        const char* pszETag = strstr(pszHeaders, pszKey);
+        if( pszETag )
+        {
+            pszETag += strlen(pszKey);
+            const char* pszEndOfETag = strchr(pszETag, '"');
+            if( pszEndOfETag )
+                return CPLString(pszETag, pszEndOfETag - pszETag);
+        }
+    }
+    return CPLString();
+}
+
 /************************************************************************/
 /*                           MultiPerform()                             */
 /************************************************************************/
@@ -1104,17 +1256,10 @@ retry:
         if( sWriteFuncHeaderData.pBuffer != nullptr &&
             (response_code == 200 || response_code == 206 ) )
         {
-            const char* pzETag = strstr(
-                sWriteFuncHeaderData.pBuffer, "ETag: \"");
-            if( pzETag )
-            {
-                pzETag += strlen("ETag: \"");
-                const char* pszEndOfETag = strchr(pzETag, '"');
-                if( pszEndOfETag )
-                {
-                    oFileProp.ETag.assign(pzETag, pszEndOfETag - pzETag);
-                }
-            }
+            const CPLString osETag(
+                VSICurlGetETagFromHeaders(sWriteFuncHeaderData.pBuffer));
+            if( !osETag.empty() )
+                oFileProp.ETag = osETag;
 
             // Azure Data Lake Storage
             const char* pszPermissions = strstr(sWriteFuncHeaderData.pBuffer, "x-ms-permissions: ");
@@ -1186,10 +1331,10 @@ retry:
                             nOffset + knDOWNLOAD_CHUNK_SIZE <= sWriteFuncData.nSize;
                             nOffset += knDOWNLOAD_CHUNK_SIZE )
                     {
-                        poFS->AddRegion(m_pszURL,
-                                        nOffset,
-                                        knDOWNLOAD_CHUNK_SIZE,
-                                        sWriteFuncData.pBuffer + nOffset);
+                        AddRegion(m_pszURL,
+                                  nOffset,
+                                  knDOWNLOAD_CHUNK_SIZE,
+                                  sWriteFuncData.pBuffer + nOffset);
                     }
                 }
             }
@@ -1393,16 +1538,51 @@ CPLString VSICurlHandle::GetRedirectURLIfValid(bool& bHasExpired)
 std::string VSICurlHandle::DownloadRegion( const vsi_l_offset startOffset,
                                            const int nBlocks )
 {
-    if( bInterrupted && bStopOnInterruptUntilUninstall )
-        return std::string();
+    std::string osRegion;
+    DownloadRegionInternal(startOffset, nBlocks, true, osRegion);
+    return osRegion;
+}
 
-    if( oFileProp.eExists == EXIST_NO )
-        return std::string();
+/************************************************************************/
+/*                       DownloadRegionInternal()                       */
+/************************************************************************/
+
+// Download nBlocks chunks from startOffset into osRegion, and add them to the
+// region cache. If bUpdateHandleState is false, as for PRead(), the state of
+// the handle is left unchanged, so that this can be called concurrently:
+// the read callback, the file properties and the redirect URL are not updated,
+// and errors that would require to authenticate again are not recovered from.
+bool VSICurlHandle::DownloadRegionInternal( const vsi_l_offset startOffset,
+                                            const int nBlocks,
+                                            bool bUpdateHandleState,
+                                            std::string& osRegion )
+{
+    osRegion.clear();
+
+    FileProp oLocalFileProp;
+    if( !bUpdateHandleState )
+        poFS->GetCachedFileProp(m_pszURL, oLocalFileProp);
+    FileProp& oProp = bUpdateHandleState ? oFileProp : oLocalFileProp;
+
+    if( bUpdateHandleState && bInterrupted && bStopOnInterruptUntilUninstall )
+        return false;
+
+    if( oProp.eExists == EXIST_NO )
+        return false;
 
     CURLM* hCurlMultiHandle = poFS->GetCurlMultiHandleFor(m_pszURL);
 
-    bool bHasExpired = false;
-    CPLString osURL(GetRedirectURLIfValid(bHasExpired));
+    CPLString osURL(m_pszURL + m_osQueryString);
+    if( bUpdateHandleState )
+    {
+        bool bHasExpired = false;
+        osURL = GetRedirectURLIfValid(bHasExpired);
+    }
+    else if( oProp.bS3LikeRedirect &&
+             time(nullptr) + 1 < oProp.nExpireTimestampLocal )
+    {
+        osURL = oProp.osRedirectURL;
+    }
     bool bUsedRedirect = osURL != m_pszURL;
 
     WriteFuncStruct sWriteFuncData;
@@ -1418,9 +1598,12 @@ retry:
     if( !AllowAutomaticRedirection() )
         curl_easy_setopt(hCurlHandle, CURLOPT_FOLLOWLOCATION, 0);
 
-    VSICURLInitWriteFuncStruct(&sWriteFuncData,
-                               reinterpret_cast<VSILFILE *>(this),
-                               pfnReadCbk, pReadCbkUserData);
+    if( bUpdateHandleState )
+        VSICURLInitWriteFuncStruct(&sWriteFuncData,
+                                   reinterpret_cast<VSILFILE *>(this),
+                                   pfnReadCbk, pReadCbkUserData);
+    else
+        VSICURLInitWriteFuncStruct(&sWriteFuncData, nullptr, nullptr, nullptr);
     curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA, &sWriteFuncData);
     curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
                      VSICurlHandleWriteFunc);
@@ -1432,12 +1615,13 @@ retry:
     sWriteFuncHeaderData.bIsHTTP = STARTS_WITH(m_pszURL, "http");
     sWriteFuncHeaderData.nStartOffset = startOffset;
     sWriteFuncHeaderData.nEndOffset =
-        startOffset + nBlocks * VSICURLGetDownloadChunkSize() - 1;
+        startOffset +
+        static_cast<vsi_l_offset>(nBlocks) * VSICURLGetDownloadChunkSize() - 1;
     // Some servers don't like we try to read after end-of-file (#5786).
-    if( oFileProp.bHasComputedFileSize &&
-        sWriteFuncHeaderData.nEndOffset >= oFileProp.fileSize )
+    if( oProp.bHasComputedFileSize &&
+        sWriteFuncHeaderData.nEndOffset >= oProp.fileSize )
     {
-        sWriteFuncHeaderData.nEndOffset = oFileProp.fileSize - 1;
+        sWriteFuncHeaderData.nEndOffset = oProp.fileSize - 1;
     }
 
     char rangeStr[512] = {};
@@ -1463,7 +1647,16 @@ retry:
     szCurlErrBuf[0] = '\0';
     curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER, szCurlErrBuf );
 
-    headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+    if( bUpdateHandleState )
+    {
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+    }
+    else
+    {
+        // GetCurlHeaders() may update the credentials of the handle.
+        std::lock_guard<std::mutex> oLock(m_oMutexPRead);
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+    }
     curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
     curl_easy_setopt(hCurlHandle, CURLOPT_FILETIME, 1);
@@ -1484,7 +1677,7 @@ retry:
         CPLFree(sWriteFuncHeaderData.pBuffer);
         curl_easy_cleanup(hCurlHandle);
 
-        return std::string();
+        return false;
     }
 
     long response_code = 0;
@@ -1501,12 +1694,22 @@ retry:
 
     long mtime = 0;
     curl_easy_getinfo(hCurlHandle, CURLINFO_FILETIME, &mtime);
-    if( mtime > 0 )
+    if( bUpdateHandleState && mtime > 0 )
     {
         oFileProp.mTime = mtime;
         poFS->SetCachedFileProp(m_pszURL, oFileProp);
     }
 
+    if( bUpdateHandleState &&
+        oFileProp.ETag.empty() && sWriteFuncHeaderData.pBuffer != nullptr &&
+        (response_code == 200 || response_code == 206) )
+    {
+        oFileProp.ETag =
+            VSICurlGetETagFromHeaders(sWriteFuncHeaderData.pBuffer);
+        if( !oFileProp.ETag.empty() )
+            poFS->SetCachedFileProp(m_pszURL, oFileProp);
+    }
+
     if( ENABLE_DEBUG )
         CPLDebug(poFS->GetDebugKey(),
                  "Got response_code=%ld", response_code);
@@ -1515,17 +1718,21 @@ retry:
     {
         CPLDebug(poFS->GetDebugKey(),
                  "Got an error with redirect URL. Retrying with original one");
-        oFileProp.bS3LikeRedirect = false;
-        poFS->SetCachedFileProp(m_pszURL, oFileProp);
+        if( bUpdateHandleState )
+        {
+            oFileProp.bS3LikeRedirect = false;
+            poFS->SetCachedFileProp(m_pszURL, oFileProp);
+        }
         bUsedRedirect = false;
-        osURL = m_pszURL;
+        osURL = m_pszURL + m_osQueryString;
         CPLFree(sWriteFuncData.pBuffer);
         CPLFree(sWriteFuncHeaderData.pBuffer);
         curl_easy_cleanup(hCurlHandle);
         goto retry;
     }
 
-    if( response_code == 401 && nRetryCount < m_nMaxRetry )
+    if( bUpdateHandleState && response_code == 401 &&
+        nRetryCount < m_nMaxRetry )
     {
         CPLDebug(poFS->GetDebugKey(),
                  "Unauthorized, trying to authenticate");
@@ -1535,7 +1742,7 @@ retry:
         nRetryCount++;
         if( Authenticate() )
             goto retry;
-        return std::string();
+        return false;
     }
 
     CPLString osEffectiveURL;
@@ -1546,7 +1753,8 @@ retry:
             osEffectiveURL = pszEffectiveURL;
     }
 
-    if( !oFileProp.bS3LikeRedirect && !osEffectiveURL.empty() &&
+    if( bUpdateHandleState &&
+        !oFileProp.bS3LikeRedirect && !osEffectiveURL.empty() &&
         strstr(osEffectiveURL, m_pszURL) == nullptr )
     {
         CPLDebug(poFS->GetDebugKey(),
@@ -1583,14 +1791,14 @@ retry:
          response_code != 426) ||
         sWriteFuncHeaderData.bError )
     {
-        if( sWriteFuncData.pBuffer != nullptr &&
+        if( bUpdateHandleState && sWriteFuncData.pBuffer != nullptr &&
             CanRestartOnError(reinterpret_cast<const char*>(sWriteFuncData.pBuffer),
                               reinterpret_cast<const char*>(sWriteFuncHeaderData.pBuffer), false) )
         {
             CPLFree(sWriteFuncData.pBuffer);
             CPLFree(sWriteFuncHeaderData.pBuffer);
             curl_easy_cleanup(hCurlHandle);
-            return DownloadRegion(startOffset, nBlocks);
+            return DownloadRegionInternal(startOffset, nBlocks, true, osRegion);
         }
 
         // Look if we should attempt a retry
@@ -1625,7 +1833,8 @@ retry:
                 CPLError(CE_Failure, CPLE_AppDefined, "%d: %s",
                          static_cast<int>(response_code), szCurlErrBuf);
         }
-        if( !oFileProp.bHasComputedFileSize && startOffset == 0 )
+        if( bUpdateHandleState &&
+            !oFileProp.bHasComputedFileSize && startOffset == 0 )
         {
             oFileProp.bHasComputedFileSize = true;
             oFileProp.fileSize = 0;
@@ -1635,10 +1844,11 @@ retry:
         CPLFree(sWriteFuncData.pBuffer);
         CPLFree(sWriteFuncHeaderData.pBuffer);
         curl_easy_cleanup(hCurlHandle);
-        return std::string();
+        return false;
     }
 
-    if( !oFileProp.bHasComputedFileSize && sWriteFuncHeaderData.pBuffer )
+    if( bUpdateHandleState &&
+        !oFileProp.bHasComputedFileSize && sWriteFuncHeaderData.pBuffer )
     {
         // Try to retrieve the filesize from the HTTP headers
         // if in the form: "Content-Range: bytes x-y/filesize".
@@ -1703,18 +1913,32 @@ retry:
         }
     }
 
-    DownloadRegionPostProcess(startOffset, nBlocks,
-                              sWriteFuncData.pBuffer,
-                              sWriteFuncData.nSize);
+    if( bUpdateHandleState )
+    {
+        DownloadRegionPostProcess(startOffset, nBlocks,
+                                  sWriteFuncData.pBuffer,
+                                  sWriteFuncData.nSize);
+    }
+    else
+    {
+        const size_t knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+        for( size_t nPos = 0; nPos < sWriteFuncData.nSize;
+             nPos += knDOWNLOAD_CHUNK_SIZE )
+        {
+            AddRegion(m_pszURL, startOffset + nPos,
+                      std::min(knDOWNLOAD_CHUNK_SIZE,
+                               sWriteFuncData.nSize - nPos),
+                      sWriteFuncData.pBuffer + nPos);
+        }
+    }
 
-    std::string osRet;
-    osRet.assign(sWriteFuncData.pBuffer, sWriteFuncData.nSize);
+    osRegion.assign(sWriteFuncData.pBuffer, sWriteFuncData.nSize);
 
     CPLFree(sWriteFuncData.pBuffer);
     CPLFree(sWriteFuncHeaderData.pBuffer);
     curl_easy_cleanup(hCurlHandle);
 
-    return osRet;
+    return true;
 }
 
 /************************************************************************/
@@ -1752,7 +1976,7 @@ void VSICurlHandle::DownloadRegionPostProcess( const vsi_l_offset startOffset,
 #endif
         const size_t nChunkSize =
             std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
-        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
+        AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
         l_startOffset += nChunkSize;
         pBuffer += nChunkSize;
         nSize -= nChunkSize;
@@ -1803,13 +2027,63 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
         const vsi_l_offset nOffsetToDownload =
                 (iterOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
         std::string osRegion;
-        std::shared_ptr<std::string> psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        std::shared_ptr<std::string> psRegion = GetRegion(m_pszURL, nOffsetToDownload);
+        if( psRegion == nullptr && WaitForAdviseRead(nOffsetToDownload) )
+            psRegion = GetRegion(m_pszURL, nOffsetToDownload);
         if( psRegion != nullptr )
         {
             osRegion = *psRegion;
         }
         else
         {
+            // Large reads are split into several range requests issued
+            // concurrently, which write directly into the output buffer.
+            const size_t nParallelPartSize =
+                static_cast<size_t>(m_nParallelDownloadPartChunks) *
+                                                    knDOWNLOAD_CHUNK_SIZE;
+            if( m_nParallelDownloadCount > 1 &&
+                nBufferRequestSize > nParallelPartSize &&
+                !oFileProp.bHasComputedFileSize )
+            {
+                // Worth a HEAD request to know where to stop.
+                GetFileSize(false);
+                poFS->GetCachedFileProp(m_pszURL, oFileProp);
+            }
+            if( m_nParallelDownloadCount > 1 &&
+                nBufferRequestSize > nParallelPartSize &&
+                CanReadParallel() )
+            {
+                vsi_l_offset nParallelEnd = std::min(
+                    iterOffset + nBufferRequestSize, oFileProp.fileSize);
+                // Stop before data already cached or being prefetched.
+                for( vsi_l_offset nChunkOffset =
+                        nOffsetToDownload + knDOWNLOAD_CHUNK_SIZE;
+                     nChunkOffset < nParallelEnd;
+                     nChunkOffset += knDOWNLOAD_CHUNK_SIZE )
+                {
+                    if( poFS->GetRegion(m_pszURL, nChunkOffset) != nullptr ||
+                        IsAdviseReadPending(nChunkOffset) )
+                    {
+                        nParallelEnd = nChunkOffset;
+                        break;
+                    }
+                }
+                if( nParallelEnd > iterOffset &&
+                    nParallelEnd - iterOffset > nParallelPartSize )
+                {
+                    const size_t nRead = ReadParallel(
+                        static_cast<GByte*>(pBuffer), iterOffset,
+                        static_cast<size_t>(nParallelEnd - iterOffset));
+                    if( nRead > 0 )
+                    {
+                        pBuffer = static_cast<char *>(pBuffer) + nRead;
+                        iterOffset += nRead;
+                        nBufferRequestSize -= nRead;
+                        continue;
+                    }
+                }
+            }
+
             if( nOffsetToDownload == lastDownloadedOffset )
             {
                 // In case of consecutive reads (of small size), we use a
@@ -1842,9 +2116,11 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
             // this should not cause bugs. Just missed optimization.
             for( int i = 1; i < nBlocksToDownload; i++ )
             {
-                if( poFS->GetRegion(
+                if( GetRegion(
                         m_pszURL,
-                        nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE) != nullptr )
+                        nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE) != nullptr ||
+                    IsAdviseReadPending(
+                        nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE) )
                 {
                     nBlocksToDownload = i;
                     break;
@@ -1894,119 +2170,1007 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
     if( ret != nMemb )
         bEOF = true;
 
+    if( m_nParallelDownloadCount > 1 )
+        PrefetchSequential(curOffset,
+                           static_cast<size_t>(iterOffset - curOffset));
+
     curOffset = iterOffset;
 
     return ret;
 }
 
 /************************************************************************/
-/*                           ReadMultiRange()                           */
+/*                                PRead()                               */
 /************************************************************************/
 
-int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
-                                   const vsi_l_offset* const panOffsets,
-                                   const size_t* const panSizes )
+size_t VSICurlHandle::PRead( void* pBuffer, size_t nSize,
+                             vsi_l_offset nOffset ) const
 {
-    if( bInterrupted && bStopOnInterruptUntilUninstall )
-        return FALSE;
-
-    poFS->GetCachedFileProp(m_pszURL, oFileProp);
-    if( oFileProp.eExists == EXIST_NO )
-        return -1;
-
+    // Contrary to Read(), this does not use nor update the current offset
+    // and the read-ahead heuristics, so that several threads can share
+    // the same handle. Only the region cache of poFS, which is protected
+    // by its mutex, is shared.
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
     NetworkStatisticsFile oContextFile(m_osFilename);
-    NetworkStatisticsAction oContextAction("ReadMultiRange");
+    NetworkStatisticsAction oContextAction("PRead");
 
-    const char* pszMultiRangeStrategy =
-        CPLGetConfigOption("GDAL_HTTP_MULTIRANGE", "");
-    if( EQUAL(pszMultiRangeStrategy, "SINGLE_GET") )
-    {
-        // Just in case someone needs it, but the interest of this mode is rather
-        // dubious now. We could probably remove it
-        return ReadMultiRangeSingleGet(nRanges, ppData, panOffsets, panSizes);
-    }
-    else if( nRanges == 1 || EQUAL(pszMultiRangeStrategy, "SERIAL") )
-    {
-        return VSIVirtualHandle::ReadMultiRange(
-                                    nRanges, ppData, panOffsets, panSizes);
-    }
+    FileProp oCachedFileProp;
+    poFS->GetCachedFileProp(m_pszURL, oCachedFileProp);
+    if( oCachedFileProp.eExists == EXIST_NO )
+        return 0;
 
-    bool bHasExpired = false;
-    CPLString osURL(GetRedirectURLIfValid(bHasExpired));
-    if( bHasExpired )
+    const int knMAX_REGIONS = GetMaxRegions();
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    GByte* pabyBuffer = static_cast<GByte*>(pBuffer);
+    const vsi_l_offset nEndOffset = nOffset + nSize;
+    vsi_l_offset iterOffset = nOffset;
+    while( iterOffset < nEndOffset )
     {
-        return VSIVirtualHandle::ReadMultiRange(
-                                    nRanges, ppData, panOffsets, panSizes);
-    }
+        // Don't try to read after end of file.
+        if( oCachedFileProp.bHasComputedFileSize &&
+            iterOffset >= oCachedFileProp.fileSize )
+        {
+            break;
+        }
 
-    CURLM * hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
-#ifdef CURLPIPE_MULTIPLEX
-    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
-    // used)
-    // Not that this does not enable HTTP/1.1 pipeling, which is not
-    // recommended for example by Google Cloud Storage.
-    // For HTTP/1.1, parallel connections work better since you can get
-    // results out of order.
-    if( CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")) )
-    {
-        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
-                          CURLPIPE_MULTIPLEX);
-    }
-#endif
+        const vsi_l_offset nOffsetToDownload =
+                (iterOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        std::shared_ptr<std::string> psRegion =
+            GetRegion(m_pszURL, nOffsetToDownload);
+        if( psRegion == nullptr && WaitForAdviseRead(nOffsetToDownload) )
+            psRegion = GetRegion(m_pszURL, nOffsetToDownload);
+        size_t nExpectedSize = knDOWNLOAD_CHUNK_SIZE;
+        if( psRegion == nullptr )
+        {
+            // Fetch in a single request the missing chunks needed to
+            // satisfy the remaining of the request.
+            int nBlocks = 1;
+            while( nBlocks < knMAX_REGIONS &&
+                   nOffsetToDownload +
+                        static_cast<vsi_l_offset>(nBlocks) *
+                            knDOWNLOAD_CHUNK_SIZE < nEndOffset &&
+                   GetRegion(
+                       m_pszURL,
+                       nOffsetToDownload +
+                            static_cast<vsi_l_offset>(nBlocks) *
+                                knDOWNLOAD_CHUNK_SIZE) == nullptr &&
+                   !IsAdviseReadPending(
+                       nOffsetToDownload +
+                            static_cast<vsi_l_offset>(nBlocks) *
+                                knDOWNLOAD_CHUNK_SIZE) )
+            {
+                nBlocks++;
+            }
 
-    std::vector<CURL*> aHandles;
-    std::vector<WriteFuncStruct> asWriteFuncData(nRanges);
-    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRanges);
-    std::vector<char*> apszRanges;
-    std::vector<struct curl_slist*> aHeaders;
+            std::string osRegion;
+            if( !const_cast<VSICurlHandle*>(this)->DownloadRegionInternal(
+                    nOffsetToDownload, nBlocks, false, osRegion) ||
+                osRegion.empty() )
+            {
+                break;
+            }
+            psRegion = std::make_shared<std::string>(std::move(osRegion));
+            nExpectedSize = static_cast<size_t>(nBlocks) * knDOWNLOAD_CHUNK_SIZE;
+        }
 
-    struct CurlErrBuffer
-    {
-        std::array<char,CURL_ERROR_SIZE+1> szCurlErrBuf;
-    };
-    std::vector<CurlErrBuffer> asCurlErrors(nRanges);
+        const vsi_l_offset nRegionOffset = iterOffset - nOffsetToDownload;
+        if( psRegion->size() <= nRegionOffset )
+            break;
 
-    const bool bMergeConsecutiveRanges = CPLTestBool(CPLGetConfigOption(
-        "GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+        const size_t nToCopy = static_cast<size_t>(
+            std::min(nEndOffset - iterOffset,
+                     psRegion->size() - nRegionOffset));
+        memcpy(pabyBuffer + (iterOffset - nOffset),
+               psRegion->data() + nRegionOffset,
+               nToCopy);
+        iterOffset += nToCopy;
+        if( psRegion->size() < nExpectedSize )
+            break;
+    }
 
-    for( int i = 0, iRequest = 0; i < nRanges; )
+    return static_cast<size_t>(iterOffset - nOffset);
+}
+
+/************************************************************************/
+/*                          AdviseReadRequest                           */
+/************************************************************************/
+
+struct VSICurlHandle::AdviseReadRequest
+{
+    CURL*              hCurlHandle = nullptr;
+    struct curl_slist* psHeaders = nullptr;
+    WriteFuncStruct    sWriteFuncData{};
+    WriteFuncStruct    sWriteFuncHeaderData{};
+    std::array<char, CURL_ERROR_SIZE+1> szCurlErrBuf{};
+    std::string        osURLKey{};
+    int                nChunkSize = 0;
+    int                nBlocks = 0;
+
+    AdviseReadRequest() = default;
+    AdviseReadRequest(const AdviseReadRequest&) = delete;
+    AdviseReadRequest& operator=(const AdviseReadRequest&) = delete;
+
+    ~AdviseReadRequest()
     {
-        size_t nSize = 0;
-        int iNext = i;
-        // Identify consecutive ranges
-        while( bMergeConsecutiveRanges &&
-               iNext + 1 < nRanges &&
-               panOffsets[iNext] + panSizes[iNext] == panOffsets[iNext+1] )
+        if( hCurlHandle )
         {
-            nSize += panSizes[iNext];
-            iNext++;
+            VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
+            curl_easy_cleanup(hCurlHandle);
         }
-        nSize += panSizes[iNext];
-        if( nSize == 0 )
-            continue;
+        CPLFree(sWriteFuncData.pBuffer);
+        CPLFree(sWriteFuncHeaderData.pBuffer);
+        curl_slist_free_all(psHeaders);
+    }
+};
 
-        CURL* hCurlHandle = curl_easy_init();
-        aHandles.push_back(hCurlHandle);
+/************************************************************************/
+/*                         AdviseReadThreadFunc()                       */
+/************************************************************************/
 
-        // As the multi-range request is likely not the first one, we don't
-        // need to wait as we already know if pipelining is possible
-        // curl_easy_setopt(hCurlHandle, CURLOPT_PIPEWAIT, 1);
+void VSICurlHandle::AdviseReadThreadFunc( void* pData )
+{
+    static_cast<VSICurlHandle*>(pData)->ProcessAdviseReadRequests(false);
+}
 
-        struct curl_slist* headers =
-            VSICurlSetOptions(hCurlHandle, osURL, m_papszHTTPOptions);
+/************************************************************************/
+/*                     ProcessAdviseReadRequests()                      */
+/************************************************************************/
 
-        VSICURLInitWriteFuncStruct(&asWriteFuncData[iRequest],
-                                reinterpret_cast<VSILFILE *>(this),
-                                pfnReadCbk, pReadCbkUserData);
-        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
-                         &asWriteFuncData[iRequest]);
-        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
-                        VSICurlHandleWriteFunc);
+// Runs the requests queued by AdviseRead() on the curl multi handle of the
+// handle, adding new requests to it as they are queued. The worker thread
+// runs this until StopAdviseReadThread() is called. Without worker thread,
+// it is run synchronously until the queued requests are completed
+// (bUntilIdle).
+void VSICurlHandle::ProcessAdviseReadRequests( bool bUntilIdle )
+{
+    std::vector<std::unique_ptr<AdviseReadRequest>> apoRunning;
 
-        VSICURLInitWriteFuncStruct(&asWriteFuncHeaderData[iRequest],
-                                   nullptr, nullptr, nullptr);
-        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+    const auto ProcessRequest = [this](AdviseReadRequest* poRequest,
+                                       bool bCompleted)
+    {
+        const WriteFuncStruct& sHeader = poRequest->sWriteFuncHeaderData;
+        const WriteFuncStruct& sData = poRequest->sWriteFuncData;
+        long response_code = 0;
+        curl_easy_getinfo(poRequest->hCurlHandle, CURLINFO_HTTP_CODE,
+                          &response_code);
+        NetworkStatisticsLogger::LogGET(sData.nSize);
+        if( bCompleted &&
+            (response_code == 206 || response_code == 225) &&
+            !sHeader.bError &&
+            sHeader.nEndOffset + 1 == sHeader.nStartOffset + sData.nSize )
+        {
+            for( size_t nPos = 0; nPos < sData.nSize;
+                                        nPos += poRequest->nChunkSize )
+            {
+                AddRegion(
+                    poRequest->osURLKey.c_str(), sHeader.nStartOffset + nPos,
+                    std::min(static_cast<size_t>(poRequest->nChunkSize),
+                             sData.nSize - nPos),
+                    sData.pBuffer + nPos);
+            }
+        }
+        else if( bCompleted )
+        {
+            CPLDebug(poFS->GetDebugKey(),
+                     "AdviseRead(): request for " CPL_FRMT_GUIB "-"
+                     CPL_FRMT_GUIB " failed: response_code=%d, msg=%s",
+                     sHeader.nStartOffset, sHeader.nEndOffset,
+                     static_cast<int>(response_code),
+                     &poRequest->szCurlErrBuf[0]);
+        }
+
+        // Wake up readers waiting for those chunks. If the request failed,
+        // they will download the chunks by themselves.
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+            for( int i = 0; i < poRequest->nBlocks; ++i )
+            {
+                m_oSetAdviseReadPendingChunks.erase(
+                    sHeader.nStartOffset +
+                    static_cast<vsi_l_offset>(i) * poRequest->nChunkSize);
+            }
+        }
+        m_oCondAdviseRead.notify_all();
+        curl_multi_remove_handle(m_hAdviseReadMultiHandle,
+                                 poRequest->hCurlHandle);
+    };
+
+    // Contrary to MultiPerform(), process each request as soon as it is
+    // completed, so that readers do not have to wait for the whole batch.
+    int repeats = 0;
+    while( true )
+    {
+        {
+            std::unique_lock<std::mutex> oLock(m_oMutexAdviseRead);
+            if( apoRunning.empty() && !bUntilIdle )
+            {
+                m_oCondAdviseReadQueue.wait(oLock, [this]()
+                {
+                    return m_bAdviseReadStop ||
+                           !m_apoAdviseReadQueue.empty();
+                });
+            }
+            if( m_bAdviseReadStop )
+                break;
+            for( auto& poRequest: m_apoAdviseReadQueue )
+            {
+                curl_multi_add_handle(m_hAdviseReadMultiHandle,
+                                      poRequest->hCurlHandle);
+                apoRunning.push_back(std::move(poRequest));
+            }
+            m_apoAdviseReadQueue.clear();
+        }
+        if( apoRunning.empty() )
+            break;
+
+        void* old_handler = CPLHTTPIgnoreSigPipe();
+        int still_running = 0;
+        while( curl_multi_perform(m_hAdviseReadMultiHandle,
+                                  &still_running) ==
+                                        CURLM_CALL_MULTI_PERFORM )
+        {
+            // loop
+        }
+
+        CURLMsg* psMsg = nullptr;
+        int nMsgInQueue = 0;
+        while( (psMsg = curl_multi_info_read(m_hAdviseReadMultiHandle,
+                                             &nMsgInQueue)) != nullptr )
+        {
+            if( psMsg->msg != CURLMSG_DONE )
+                continue;
+            char* pszPrivate = nullptr;
+            curl_easy_getinfo(psMsg->easy_handle, CURLINFO_PRIVATE,
+                              &pszPrivate);
+            AdviseReadRequest* poRequest =
+                reinterpret_cast<AdviseReadRequest*>(pszPrivate);
+            auto oIter = std::find_if(apoRunning.begin(), apoRunning.end(),
+                [poRequest](const std::unique_ptr<AdviseReadRequest>& poIter)
+                { return poIter.get() == poRequest; });
+            if( oIter != apoRunning.end() )
+            {
+                ProcessRequest(poRequest, true);
+                apoRunning.erase(oIter);
+            }
+        }
+
+        // Also woken up by StopAdviseReadThread() and when requests are
+        // queued, with curl >= 7.68.
+        if( still_running )
+            CPLMultiPerformWait(m_hAdviseReadMultiHandle, repeats);
+        CPLHTTPRestoreSigPipeHandler(old_handler);
+    }
+
+    for( auto& poRequest: apoRunning )
+        ProcessRequest(poRequest.get(), false);
+}
+
+/************************************************************************/
+/*                        StopAdviseReadThread()                        */
+/************************************************************************/
+
+void VSICurlHandle::StopAdviseReadThread()
+{
+    if( m_hAdviseReadThread )
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+            m_bAdviseReadStop = true;
+        }
+        m_oCondAdviseReadQueue.notify_one();
+#if CURL_AT_LEAST_VERSION(7,68,0)
+        curl_multi_wakeup(m_hAdviseReadMultiHandle);
+#endif
+        CPLJoinThread(m_hAdviseReadThread);
+        m_hAdviseReadThread = nullptr;
+    }
+    m_apoAdviseReadQueue.clear();
+    if( m_hAdviseReadMultiHandle )
+    {
+        curl_multi_cleanup(m_hAdviseReadMultiHandle);
+        m_hAdviseReadMultiHandle = nullptr;
+    }
+}
+
+/************************************************************************/
+/*                        IsAdviseReadPending()                         */
+/************************************************************************/
+
+bool VSICurlHandle::IsAdviseReadPending( vsi_l_offset nChunkOffset ) const
+{
+    std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+    return m_oSetAdviseReadPendingChunks.find(nChunkOffset) !=
+                                    m_oSetAdviseReadPendingChunks.end();
+}
+
+/************************************************************************/
+/*                         WaitForAdviseRead()                          */
+/************************************************************************/
+
+// Returns true if the chunk was being downloaded by AdviseRead(), once
+// that download is finished.
+bool VSICurlHandle::WaitForAdviseRead( vsi_l_offset nChunkOffset ) const
+{
+    std::unique_lock<std::mutex> oLock(m_oMutexAdviseRead);
+    if( m_oSetAdviseReadPendingChunks.find(nChunkOffset) ==
+                                    m_oSetAdviseReadPendingChunks.end() )
+    {
+        return false;
+    }
+    m_oCondAdviseRead.wait(oLock, [this, nChunkOffset]()
+    {
+        return m_oSetAdviseReadPendingChunks.find(nChunkOffset) ==
+                                    m_oSetAdviseReadPendingChunks.end();
+    });
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadFromRegionCache()                        */
+/************************************************************************/
+
+// Returns true if the whole range could be read from cached (or being
+// prefetched) chunks.
+bool VSICurlHandle::ReadFromRegionCache( void* pBuffer, vsi_l_offset nOffset,
+                                         size_t nSize )
+{
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    GByte* pabyBuffer = static_cast<GByte*>(pBuffer);
+    vsi_l_offset iterOffset = nOffset;
+    const vsi_l_offset nEndOffset = nOffset + nSize;
+    while( iterOffset < nEndOffset )
+    {
+        const vsi_l_offset nChunkOffset =
+                (iterOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        std::shared_ptr<std::string> psRegion =
+            GetRegion(m_pszURL, nChunkOffset);
+        if( psRegion == nullptr && WaitForAdviseRead(nChunkOffset) )
+            psRegion = GetRegion(m_pszURL, nChunkOffset);
+        if( psRegion == nullptr ||
+            psRegion->size() <= iterOffset - nChunkOffset )
+        {
+            return false;
+        }
+        const size_t nToCopy = static_cast<size_t>(
+            std::min(nEndOffset - iterOffset,
+                     psRegion->size() - (iterOffset - nChunkOffset)));
+        memcpy(pabyBuffer + (iterOffset - nOffset),
+               psRegion->data() + (iterOffset - nChunkOffset), nToCopy);
+        iterOffset += nToCopy;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSICurlHandle::AdviseRead( int nRanges, const vsi_l_offset* panOffsets,
+                                const size_t* panSizes )
+{
+    AdviseReadInternal(nRanges, panOffsets, panSizes,
+                       m_nParallelDownloadPartChunks);
+}
+
+/************************************************************************/
+/*                         AdviseReadInternal()                         */
+/************************************************************************/
+
+// Runs of consecutive chunks are split into requests of at most
+// nMaxChunksPerRequest chunks, so that large ranges are downloaded through
+// several parallel connections.
+void VSICurlHandle::AdviseReadInternal( int nRanges,
+                                        const vsi_l_offset* panOffsets,
+                                        const size_t* panSizes,
+                                        int nMaxChunksPerRequest )
+{
+    if( bInterrupted && bStopOnInterruptUntilUninstall )
+        return;
+
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if( oFileProp.eExists == EXIST_NO )
+        return;
+
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    // Do not let prefetched chunks occupy more than half of the region
+    // cache, so that they have a chance to be still there when read.
+    const size_t nMaxChunks =
+        static_cast<size_t>(std::max(1, GetMaxRegions() / 2));
+    size_t nChunks = 0;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+        nChunks = m_oSetAdviseReadPendingChunks.size();
+    }
+
+    // Collect the chunks that are neither cached nor being downloaded,
+    // grouped as runs of consecutive chunks.
+    std::vector<std::pair<vsi_l_offset, int>> aoRuns;
+    for( int i = 0; i < nRanges && nChunks < nMaxChunks; ++i )
+    {
+        vsi_l_offset nEndOffset = panOffsets[i] + panSizes[i];
+        if( oFileProp.bHasComputedFileSize )
+            nEndOffset = std::min(nEndOffset, oFileProp.fileSize);
+        for( vsi_l_offset nChunkOffset =
+                (panOffsets[i] / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+             nChunkOffset < nEndOffset && nChunks < nMaxChunks;
+             nChunkOffset += knDOWNLOAD_CHUNK_SIZE )
+        {
+            const vsi_l_offset nRunEnd = aoRuns.empty() ? 0 :
+                aoRuns.back().first +
+                    static_cast<vsi_l_offset>(aoRuns.back().second) *
+                        knDOWNLOAD_CHUNK_SIZE;
+            if( !aoRuns.empty() && nChunkOffset < nRunEnd )
+                continue; // Chunk shared with the previous range.
+            if( GetRegion(m_pszURL, nChunkOffset) != nullptr ||
+                IsAdviseReadPending(nChunkOffset) )
+            {
+                continue;
+            }
+            if( !aoRuns.empty() && nChunkOffset == nRunEnd &&
+                aoRuns.back().second < nMaxChunksPerRequest )
+                aoRuns.back().second++;
+            else
+                aoRuns.emplace_back(nChunkOffset, 1);
+            nChunks++;
+        }
+    }
+    if( aoRuns.empty() )
+        return;
+
+    m_bAdviseReadUsed = true;
+
+    bool bHasExpired = false;
+    const CPLString osURL(GetRedirectURLIfValid(bHasExpired));
+
+    // The requests are fully set up in this thread, as GetCurlHeaders()
+    // may update the state of the handle.
+    std::vector<std::unique_ptr<AdviseReadRequest>> apoRequests;
+    for( const auto& oRun: aoRuns )
+    {
+        std::unique_ptr<AdviseReadRequest> poRequest(new AdviseReadRequest());
+        poRequest->osURLKey = m_pszURL;
+        poRequest->nChunkSize = knDOWNLOAD_CHUNK_SIZE;
+        poRequest->nBlocks = oRun.second;
+
+        CURL* hCurlHandle = curl_easy_init();
+        poRequest->hCurlHandle = hCurlHandle;
+        curl_easy_setopt(hCurlHandle, CURLOPT_PRIVATE, poRequest.get());
+
+        struct curl_slist* headers =
+            VSICurlSetOptions(hCurlHandle, osURL, m_papszHTTPOptions);
+
+        if( !AllowAutomaticRedirection() )
+            curl_easy_setopt(hCurlHandle, CURLOPT_FOLLOWLOCATION, 0);
+
+        VSICURLInitWriteFuncStruct(&poRequest->sWriteFuncData,
+                                   nullptr, nullptr, nullptr);
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                         &poRequest->sWriteFuncData);
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                         VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&poRequest->sWriteFuncHeaderData,
+                                   nullptr, nullptr, nullptr);
+        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                         &poRequest->sWriteFuncHeaderData);
+        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                         VSICurlHandleWriteFunc);
+        WriteFuncStruct& sHeader = poRequest->sWriteFuncHeaderData;
+        sHeader.bIsHTTP = STARTS_WITH(m_pszURL, "http");
+        sHeader.nStartOffset = oRun.first;
+        sHeader.nEndOffset = oRun.first +
+            static_cast<vsi_l_offset>(oRun.second) * knDOWNLOAD_CHUNK_SIZE - 1;
+        // Some servers don't like we try to read after end-of-file (#5786).
+        if( oFileProp.bHasComputedFileSize &&
+            sHeader.nEndOffset >= oFileProp.fileSize )
+        {
+            sHeader.nEndOffset = oFileProp.fileSize - 1;
+        }
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr),
+                 CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 sHeader.nStartOffset, sHeader.nEndOffset);
+
+        if( ENABLE_DEBUG )
+            CPLDebug(poFS->GetDebugKey(), "Prefetching %s (%s)...",
+                     rangeStr, osURL.c_str());
+
+        if( sHeader.bIsHTTP )
+        {
+            CPLString osHeaderRange;
+            osHeaderRange.Printf("Range: bytes=%s", rangeStr);
+            // So it gets included in Azure signature
+            headers = curl_slist_append(headers, osHeaderRange.c_str());
+            curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+        }
+        else
+            curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+
+        curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER,
+                         &poRequest->szCurlErrBuf[0]);
+
+        {
+            // GetCurlHeaders() may update the credentials of the handle,
+            // concurrently with PRead().
+            std::lock_guard<std::mutex> oLock(m_oMutexPRead);
+            headers = VSICurlMergeHeaders(headers,
+                                          GetCurlHeaders("GET", headers));
+        }
+        curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        poRequest->psHeaders = headers;
+
+        apoRequests.push_back(std::move(poRequest));
+    }
+
+    // All the requests of the handle are run by a single worker thread,
+    // on a single curl multi handle, so that their connections are reused.
+    if( m_hAdviseReadMultiHandle == nullptr )
+    {
+        m_hAdviseReadMultiHandle = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+        if( CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")) )
+        {
+            curl_multi_setopt(m_hAdviseReadMultiHandle, CURLMOPT_PIPELINING,
+                              CURLPIPE_MULTIPLEX);
+        }
+#endif
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+        for( const auto& oRun: aoRuns )
+        {
+            for( int i = 0; i < oRun.second; ++i )
+            {
+                m_oSetAdviseReadPendingChunks.insert(
+                    oRun.first +
+                    static_cast<vsi_l_offset>(i) * knDOWNLOAD_CHUNK_SIZE);
+            }
+        }
+        for( auto& poRequest: apoRequests )
+            m_apoAdviseReadQueue.push_back(std::move(poRequest));
+    }
+
+    if( m_hAdviseReadThread == nullptr )
+    {
+        m_hAdviseReadThread =
+            CPLCreateJoinableThread(AdviseReadThreadFunc, this);
+        if( m_hAdviseReadThread == nullptr )
+        {
+            // Fallback to a synchronous download.
+            ProcessAdviseReadRequests(true);
+        }
+    }
+    else
+    {
+        m_oCondAdviseReadQueue.notify_one();
+#if CURL_AT_LEAST_VERSION(7,68,0)
+        curl_multi_wakeup(m_hAdviseReadMultiHandle);
+#endif
+    }
+}
+
+/************************************************************************/
+/*                          CanReadParallel()                           */
+/************************************************************************/
+
+bool VSICurlHandle::CanReadParallel() const
+{
+    // The content is streamed to the read callback in file order, and
+    // written to the disk cache chunk by chunk, so those modes rule out
+    // out-of-order downloads into the output buffer.
+    return oFileProp.bHasComputedFileSize &&
+           pfnReadCbk == nullptr &&
+           m_poDiskCache == nullptr &&
+           STARTS_WITH(m_pszURL, "http") &&
+           !(bInterrupted && bStopOnInterruptUntilUninstall);
+}
+
+/************************************************************************/
+/*                       ParallelReadPart                               */
+/************************************************************************/
+
+namespace {
+struct ParallelReadPart
+{
+    CURL*              hCurlHandle = nullptr;
+    struct curl_slist* psHeaders = nullptr;
+    WriteFuncStruct    sWriteFuncHeaderData{};
+    std::array<char, CURL_ERROR_SIZE+1> szCurlErrBuf{};
+    GByte*             pabyDst = nullptr;
+    vsi_l_offset       nOffset = 0;
+    size_t             nSize = 0;
+    size_t             nReceived = 0;
+    bool               bOK = false;
+};
+} // namespace
+
+/************************************************************************/
+/*                    VSICurlParallelReadWriteFunc()                    */
+/************************************************************************/
+
+static size_t VSICurlParallelReadWriteFunc( void *buffer, size_t count,
+                                            size_t nmemb, void *req )
+{
+    ParallelReadPart* psPart = static_cast<ParallelReadPart*>(req);
+    const size_t nSize = count * nmemb;
+    // Only accept the body of a range response, and never write outside of
+    // the area of the output buffer reserved to the part.
+    const int nHTTPCode = psPart->sWriteFuncHeaderData.nHTTPCode;
+    if( (nHTTPCode != 206 && nHTTPCode != 225) ||
+        nSize > psPart->nSize - psPart->nReceived )
+    {
+        return 0;
+    }
+    memcpy(psPart->pabyDst + psPart->nReceived, buffer, nSize);
+    psPart->nReceived += nSize;
+    return nmemb;
+}
+
+/************************************************************************/
+/*                            ReadParallel()                            */
+/************************************************************************/
+
+// Downloads [nOffset, nOffset + nSize[ into pabyBuffer with parts of at
+// most m_nParallelDownloadPartChunks chunks, and at most
+// m_nParallelDownloadCount requests in flight. Parts may complete in any
+// order as each one is written at its final place in the buffer.
+// Returns the number of bytes successfully read from nOffset, which is less
+// than nSize if a part failed. The caller then falls back to the regular
+// (retrying) code path for the remaining bytes.
+size_t VSICurlHandle::ReadParallel( GByte* pabyBuffer, vsi_l_offset nOffset,
+                                    size_t nSize )
+{
+    bool bHasExpired = false;
+    const CPLString osURL(GetRedirectURLIfValid(bHasExpired));
+    if( bHasExpired )
+        return 0;
+
+    const size_t nMaxPartSize =
+        static_cast<size_t>(m_nParallelDownloadPartChunks) *
+                                            VSICURLGetDownloadChunkSize();
+    const size_t nParts = (nSize + nMaxPartSize - 1) / nMaxPartSize;
+    const size_t nPartSize = (nSize + nParts - 1) / nParts;
+    std::vector<ParallelReadPart> asParts(nParts);
+    for( size_t i = 0; i < nParts; ++i )
+    {
+        asParts[i].pabyDst = pabyBuffer + i * nPartSize;
+        asParts[i].nOffset = nOffset + i * nPartSize;
+        asParts[i].nSize = std::min(nPartSize, nSize - i * nPartSize);
+    }
+
+    CURLM* hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
+#ifdef CURLPIPE_MULTIPLEX
+    if( CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")) )
+    {
+        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    const auto StartPart = [this, &osURL, hMultiHandle](ParallelReadPart& oPart)
+    {
+        CURL* hCurlHandle = curl_easy_init();
+        oPart.hCurlHandle = hCurlHandle;
+        curl_easy_setopt(hCurlHandle, CURLOPT_PRIVATE, &oPart);
+
+        struct curl_slist* headers =
+            VSICurlSetOptions(hCurlHandle, osURL, m_papszHTTPOptions);
+
+        if( !AllowAutomaticRedirection() )
+            curl_easy_setopt(hCurlHandle, CURLOPT_FOLLOWLOCATION, 0);
+
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA, &oPart);
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                         VSICurlParallelReadWriteFunc);
+
+        WriteFuncStruct& sHeader = oPart.sWriteFuncHeaderData;
+        VSICURLInitWriteFuncStruct(&sHeader, nullptr, nullptr, nullptr);
+        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA, &sHeader);
+        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                         VSICurlHandleWriteFunc);
+        sHeader.bIsHTTP = true;
+        sHeader.nStartOffset = oPart.nOffset;
+        sHeader.nEndOffset = oPart.nOffset + oPart.nSize - 1;
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr),
+                 CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 sHeader.nStartOffset, sHeader.nEndOffset);
+
+        if( ENABLE_DEBUG )
+            CPLDebug(poFS->GetDebugKey(), "Downloading %s (%s)...",
+                     rangeStr, osURL.c_str());
+
+        CPLString osHeaderRange;
+        osHeaderRange.Printf("Range: bytes=%s", rangeStr);
+        // So it gets included in Azure signature
+        headers = curl_slist_append(headers, osHeaderRange.c_str());
+        curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+
+        curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER,
+                         &oPart.szCurlErrBuf[0]);
+
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+        curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        oPart.psHeaders = headers;
+
+        curl_multi_add_handle(hMultiHandle, hCurlHandle);
+    };
+
+    size_t iNextPart = 0;
+    int nRunning = 0;
+    while( iNextPart < nParts && nRunning < m_nParallelDownloadCount )
+    {
+        StartPart(asParts[iNextPart++]);
+        nRunning++;
+    }
+
+    size_t nTotalDownloaded = 0;
+    void* old_handler = CPLHTTPIgnoreSigPipe();
+    int repeats = 0;
+    while( nRunning > 0 )
+    {
+        int still_running = 0;
+        while( curl_multi_perform(hMultiHandle, &still_running) ==
+                                        CURLM_CALL_MULTI_PERFORM )
+        {
+            // loop
+        }
+
+        CURLMsg* psMsg = nullptr;
+        int nMsgInQueue = 0;
+        while( (psMsg = curl_multi_info_read(hMultiHandle,
+                                             &nMsgInQueue)) != nullptr )
+        {
+            if( psMsg->msg != CURLMSG_DONE )
+                continue;
+            char* pszPrivate = nullptr;
+            curl_easy_getinfo(psMsg->easy_handle, CURLINFO_PRIVATE,
+                              &pszPrivate);
+            ParallelReadPart* psPart =
+                reinterpret_cast<ParallelReadPart*>(pszPrivate);
+            if( psPart == nullptr )
+                continue;
+
+            long response_code = 0;
+            curl_easy_getinfo(psPart->hCurlHandle, CURLINFO_HTTP_CODE,
+                              &response_code);
+            psPart->bOK = (response_code == 206 || response_code == 225) &&
+                          psPart->nReceived == psPart->nSize;
+            nTotalDownloaded += psPart->nReceived;
+            if( !psPart->bOK )
+            {
+                CPLDebug(poFS->GetDebugKey(),
+                         "ReadParallel(): request for " CPL_FRMT_GUIB "-"
+                         CPL_FRMT_GUIB " failed: response_code=%d, msg=%s",
+                         psPart->sWriteFuncHeaderData.nStartOffset,
+                         psPart->sWriteFuncHeaderData.nEndOffset,
+                         static_cast<int>(response_code),
+                         &psPart->szCurlErrBuf[0]);
+                // Do not start new requests: the data after the failed
+                // part will be read by the regular code path.
+                iNextPart = nParts;
+            }
+
+            curl_multi_remove_handle(hMultiHandle, psPart->hCurlHandle);
+            VSICURLResetHeaderAndWriterFunctions(psPart->hCurlHandle);
+            curl_easy_cleanup(psPart->hCurlHandle);
+            psPart->hCurlHandle = nullptr;
+            CPLFree(psPart->sWriteFuncHeaderData.pBuffer);
+            psPart->sWriteFuncHeaderData.pBuffer = nullptr;
+            curl_slist_free_all(psPart->psHeaders);
+            psPart->psHeaders = nullptr;
+            nRunning--;
+
+            if( iNextPart < nParts )
+            {
+                StartPart(asParts[iNextPart++]);
+                nRunning++;
+            }
+        }
+
+        if( nRunning == 0 )
+            break;
+
+        CPLMultiPerformWait(hMultiHandle, repeats);
+    }
+    CPLHTTPRestoreSigPipeHandler(old_handler);
+
+    NetworkStatisticsLogger::LogGET(nTotalDownloaded);
+
+    size_t nRead = 0;
+    for( const auto& oPart: asParts )
+    {
+        if( !oPart.bOK )
+            break;
+        nRead += oPart.nSize;
+    }
+    return nRead;
+}
+
+/************************************************************************/
+/*                         PrefetchSequential()                         */
+/************************************************************************/
+
+// Called after each Read(). Once a few consecutive reads have been
+// detected, keeps m_nParallelDownloadCount parts being downloaded in the
+// background ahead of the current position.
+void VSICurlHandle::PrefetchSequential( vsi_l_offset nReadOffset,
+                                        size_t nReadSize )
+{
+    if( nReadOffset == m_nLastReadEnd )
+    {
+        if( m_nSequentialReads < INT_MAX )
+            m_nSequentialReads++;
+    }
+    else
+    {
+        m_nSequentialReads = 0;
+        m_nPrefetchEnd = 0;
+    }
+    m_nLastReadEnd = nReadOffset + nReadSize;
+    if( m_nSequentialReads < 2 || !CanReadParallel() )
+        return;
+
+    // The prefetched parts must fit in the share of the region cache that
+    // AdviseRead() may use.
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const int nPartChunks = std::max(1,
+        std::min(m_nParallelDownloadPartChunks,
+                 GetMaxRegions() / 2 / m_nParallelDownloadCount));
+    const vsi_l_offset nWindow =
+        static_cast<vsi_l_offset>(nPartChunks) * knDOWNLOAD_CHUNK_SIZE *
+                                                    m_nParallelDownloadCount;
+    // Wait for half of the window to be consumed before topping it up.
+    if( m_nPrefetchEnd >= m_nLastReadEnd + nWindow / 2 )
+        return;
+    const vsi_l_offset nStart = std::max(m_nPrefetchEnd, m_nLastReadEnd);
+    const vsi_l_offset nEnd =
+        std::min(m_nLastReadEnd + nWindow, oFileProp.fileSize);
+    if( nStart >= nEnd )
+        return;
+    const size_t nSize = static_cast<size_t>(nEnd - nStart);
+    AdviseReadInternal(1, &nStart, &nSize, nPartChunks);
+    m_nPrefetchEnd = nEnd;
+}
+
+/************************************************************************/
+/*                           ReadMultiRange()                           */
+/************************************************************************/
+
+int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
+                                   const vsi_l_offset* const panOffsets,
+                                   const size_t* const panSizes )
+{
+    if( bInterrupted && bStopOnInterruptUntilUninstall )
+        return FALSE;
+
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if( oFileProp.eExists == EXIST_NO )
+        return -1;
+
+    NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
+    NetworkStatisticsFile oContextFile(m_osFilename);
+    NetworkStatisticsAction oContextAction("ReadMultiRange");
+
+    // Serve from the region cache the ranges that AdviseRead() has prefetched
+    // or is prefetching, and only request the other ones.
+    if( m_bAdviseReadUsed )
+    {
+        std::vector<void*> apMissingData;
+        std::vector<vsi_l_offset> anMissingOffsets;
+        std::vector<size_t> anMissingSizes;
+        for( int i = 0; i < nRanges; ++i )
+        {
+            if( !ReadFromRegionCache(ppData[i], panOffsets[i], panSizes[i]) )
+            {
+                apMissingData.push_back(ppData[i]);
+                anMissingOffsets.push_back(panOffsets[i]);
+                anMissingSizes.push_back(panSizes[i]);
+            }
+        }
+        if( apMissingData.empty() )
+            return 0;
+        if( static_cast<int>(apMissingData.size()) < nRanges )
+        {
+            return ReadMultiRange(static_cast<int>(apMissingData.size()),
+                                  apMissingData.data(),
+                                  anMissingOffsets.data(),
+                                  anMissingSizes.data());
+        }
+    }
+
+    const char* pszMultiRangeStrategy =
+        CPLGetConfigOption("GDAL_HTTP_MULTIRANGE", "");
+    if( EQUAL(pszMultiRangeStrategy, "SINGLE_GET") )
+    {
+        // Just in case someone needs it, but the interest of this mode is rather
+        // dubious now. We could probably remove it
+        return ReadMultiRangeSingleGet(nRanges, ppData, panOffsets, panSizes);
+    }
+    else if( nRanges == 1 || EQUAL(pszMultiRangeStrategy, "SERIAL") )
+    {
+        return VSIVirtualHandle::ReadMultiRange(
+                                    nRanges, ppData, panOffsets, panSizes);
+    }
+
+    bool bHasExpired = false;
+    CPLString osURL(GetRedirectURLIfValid(bHasExpired));
+    if( bHasExpired )
+    {
+        return VSIVirtualHandle::ReadMultiRange(
+                                    nRanges, ppData, panOffsets, panSizes);
+    }
+
+    CURLM * hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
+#ifdef CURLPIPE_MULTIPLEX
+    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
+    // used)
+    // Not that this does not enable HTTP/1.1 pipeling, which is not
+    // recommended for example by Google Cloud Storage.
+    // For HTTP/1.1, parallel connections work better since you can get
+    // results out of order.
+    if( CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")) )
+    {
+        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    std::vector<CURL*> aHandles;
+    std::vector<WriteFuncStruct> asWriteFuncData(nRanges);
+    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRanges);
+    std::vector<char*> apszRanges;
+    std::vector<struct curl_slist*> aHeaders;
+
+    struct CurlErrBuffer
+    {
+        std::array<char,CURL_ERROR_SIZE+1> szCurlErrBuf;
+    };
+    std::vector<CurlErrBuffer> asCurlErrors(nRanges);
+
+    const bool bMergeConsecutiveRanges = CPLTestBool(CPLGetConfigOption(
+        "GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+
+    for( int i = 0, iRequest = 0; i < nRanges; )
+    {
+        size_t nSize = 0;
+        int iNext = i;
+        // Identify consecutive ranges
+        while( bMergeConsecutiveRanges &&
+               iNext + 1 < nRanges &&
+               panOffsets[iNext] + panSizes[iNext] == panOffsets[iNext+1] )
+        {
+            nSize += panSizes[iNext];
+            iNext++;
+        }
+        nSize += panSizes[iNext];
+        if( nSize == 0 )
+            continue;
+
+        CURL* hCurlHandle = curl_easy_init();
+        aHandles.push_back(hCurlHandle);
+
+        // As the multi-range request is likely not the first one, we don't
+        // need to wait as we already know if pipelining is possible
+        // curl_easy_setopt(hCurlHandle, CURLOPT_PIPEWAIT, 1);
+
+        struct curl_slist* headers =
+            VSICurlSetOptions(hCurlHandle, osURL, m_papszHTTPOptions);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncData[iRequest],
+                                reinterpret_cast<VSILFILE *>(this),
+                                pfnReadCbk, pReadCbkUserData);
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                         &asWriteFuncData[iRequest]);
+        curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                        VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncHeaderData[iRequest],
+                                   nullptr, nullptr, nullptr);
+        curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
                          &asWriteFuncHeaderData[iRequest]);
         curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
                          VSICurlHandleWriteFunc);
@@ -2764,6 +3928,336 @@ void VSICurlFilesystemHandler::AddRegion( const char* pszURL,
         value);
 }
 
+/************************************************************************/
+/*                          VSICurlDiskCache()                          */
+/************************************************************************/
+
+VSICurlDiskCache::VSICurlDiskCache( const CPLString& osDirectory ) :
+    m_osDirectory(osDirectory)
+{
+}
+
+/************************************************************************/
+/*                         ~VSICurlDiskCache()                          */
+/************************************************************************/
+
+VSICurlDiskCache::~VSICurlDiskCache()
+{
+    JoinScanThread();
+}
+
+/************************************************************************/
+/*                             GetCaches()                              */
+/************************************************************************/
+
+std::map<CPLString, std::unique_ptr<VSICurlDiskCache>>&
+VSICurlDiskCache::GetCaches()
+{
+    static std::map<CPLString, std::unique_ptr<VSICurlDiskCache>> oMapCaches;
+    return oMapCaches;
+}
+
+/************************************************************************/
+/*                           GetCachesMutex()                           */
+/************************************************************************/
+
+std::mutex& VSICurlDiskCache::GetCachesMutex()
+{
+    static std::mutex oMutex;
+    return oMutex;
+}
+
+/************************************************************************/
+/*                          JoinScanThreads()                           */
+/************************************************************************/
+
+// Waits for the pending evictions of all disk caches, so that they do not
+// run while the file system handlers are destroyed.
+void VSICurlDiskCache::JoinScanThreads()
+{
+    std::lock_guard<std::mutex> oLock(GetCachesMutex());
+    for( auto& oIter: GetCaches() )
+        oIter.second->JoinScanThread();
+}
+
+/************************************************************************/
+/*                           JoinScanThread()                           */
+/************************************************************************/
+
+void VSICurlDiskCache::JoinScanThread()
+{
+    CPLJoinableThread* hThread = nullptr;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        hThread = m_hScanThread;
+        m_hScanThread = nullptr;
+    }
+    if( hThread )
+        CPLJoinThread(hThread);
+}
+
+/************************************************************************/
+/*                           GetForFilename()                           */
+/************************************************************************/
+
+// Returns the disk cache to use for pszFilename, or nullptr if disk caching
+// is not enabled for it.
+VSICurlDiskCache* VSICurlDiskCache::GetForFilename( const char* pszFilename )
+{
+    const char* pszDirectory =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if( pszDirectory == nullptr || pszDirectory[0] == '\0' )
+        return nullptr;
+
+    const GIntBig nMaxSize =
+        CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE",
+                                         "1073741824"));
+    if( nMaxSize <= 0 )
+        return nullptr;
+
+    const char* pszPrefixes =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_PREFIXES", nullptr);
+    if( pszPrefixes != nullptr && pszPrefixes[0] != '\0' )
+    {
+        const CPLStringList aosPrefixes(
+            CSLTokenizeString2(pszPrefixes, ",", CSLT_STRIPLEADSPACES |
+                                                 CSLT_STRIPENDSPACES));
+        bool bMatch = false;
+        for( int i = 0; i < aosPrefixes.size(); i++ )
+        {
+            if( STARTS_WITH(pszFilename, aosPrefixes[i]) )
+            {
+                bMatch = true;
+                break;
+            }
+        }
+        if( !bMatch )
+            return nullptr;
+    }
+
+    std::lock_guard<std::mutex> oLock(GetCachesMutex());
+    auto& oMapCaches = GetCaches();
+    auto& poCache = oMapCaches[pszDirectory];
+    if( poCache == nullptr )
+    {
+        VSIMkdirRecursive(pszDirectory, 0755);
+        VSIStatBufL sStat;
+        if( VSIStatL(pszDirectory, &sStat) != 0 || !VSI_ISDIR(sStat.st_mode) )
+        {
+            oMapCaches.erase(pszDirectory);
+            CPLError(CE_Warning, CPLE_FileIO,
+                     "Cannot create %s. Disk cache disabled", pszDirectory);
+            return nullptr;
+        }
+        poCache.reset(new VSICurlDiskCache(pszDirectory));
+    }
+    {
+        std::lock_guard<std::mutex> oCacheLock(poCache->m_oMutex);
+        poCache->m_nMaxSize = nMaxSize;
+    }
+    return poCache.get();
+}
+
+/************************************************************************/
+/*                              GetPath()                               */
+/************************************************************************/
+
+CPLString VSICurlDiskCache::GetPath( const std::string& osKey ) const
+{
+    // Spread the files over subdirectories named after the first two
+    // characters of the key.
+    return CPLFormFilename(
+        CPLFormFilename(m_osDirectory, osKey.substr(0, 2).c_str(), nullptr),
+        osKey.c_str(), nullptr);
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+std::shared_ptr<std::string> VSICurlDiskCache::Get( const std::string& osKey )
+{
+    const CPLString osPath(GetPath(osKey));
+    VSILFILE* fp = VSIFOpenL(osPath, "rb");
+    if( fp == nullptr )
+        return nullptr;
+
+    std::shared_ptr<std::string> psRegion;
+    if( VSIFSeekL(fp, 0, SEEK_END) == 0 )
+    {
+        const vsi_l_offset nSize = VSIFTellL(fp);
+        if( nSize > 0 && nSize == static_cast<size_t>(nSize) &&
+            VSIFSeekL(fp, 0, SEEK_SET) == 0 )
+        {
+            psRegion = std::make_shared<std::string>();
+            psRegion->resize(static_cast<size_t>(nSize));
+            if( VSIFReadL(&(*psRegion)[0], 1, psRegion->size(), fp) !=
+                                                        psRegion->size() )
+            {
+                psRegion.reset();
+            }
+        }
+    }
+    VSIFCloseL(fp);
+
+#ifndef _WIN32
+    // The modification time serves as the last access time for the LRU
+    // eviction done by Scan().
+    if( psRegion != nullptr && !STARTS_WITH(osPath, "/vsi") )
+        utime(osPath, nullptr);
+#endif
+
+    return psRegion;
+}
+
+/************************************************************************/
+/*                                Put()                                 */
+/************************************************************************/
+
+void VSICurlDiskCache::Put( const std::string& osKey,
+                            const char* pData, size_t nSize )
+{
+    const CPLString osPath(GetPath(osKey));
+    VSIStatBufL sStat;
+    if( VSIStatExL(osPath, &sStat, VSI_STAT_EXISTS_FLAG) == 0 )
+        return;
+
+    // Write to a temporary file that is then renamed, so that other
+    // processes never see partially written files.
+    static std::atomic<int> nCounter{0};
+    const CPLString osTmpPath(CPLSPrintf("%s.tmp" CPL_FRMT_GIB "_%d",
+                                         osPath.c_str(), CPLGetPID(),
+                                         ++nCounter));
+    VSILFILE* fp = VSIFOpenL(osTmpPath, "wb");
+    if( fp == nullptr )
+    {
+        VSIMkdir(CPLGetPath(osPath), 0755);
+        fp = VSIFOpenL(osTmpPath, "wb");
+        if( fp == nullptr )
+            return;
+    }
+    const bool bOK = VSIFWriteL(pData, 1, nSize, fp) == nSize;
+    if( VSIFCloseL(fp) != 0 || !bOK ||
+        VSIRename(osTmpPath, osPath) != 0 )
+    {
+        VSIUnlink(osTmpPath);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nBytesWrittenSinceScan += static_cast<GIntBig>(nSize);
+        // Other processes may also be writing in the directory, so its
+        // actual size is re-evaluated regularly.
+        if( m_bScanInProgress ||
+            (m_bScanned && m_nBytesWrittenSinceScan <= m_nMaxSize / 20) )
+        {
+            return;
+        }
+        m_bScanInProgress = true;
+        m_nBytesWrittenSinceScan = 0;
+
+        // The directory walk can be long, so eviction is done in the
+        // background. The previous scan thread has already finished, as
+        // m_bScanInProgress was false.
+        if( m_hScanThread )
+            CPLJoinThread(m_hScanThread);
+        m_hScanThread = CPLCreateJoinableThread(ScanThreadFunc, this);
+        if( m_hScanThread )
+            return;
+    }
+    ScanThreadFunc(this);
+}
+
+/************************************************************************/
+/*                           ScanThreadFunc()                           */
+/************************************************************************/
+
+void VSICurlDiskCache::ScanThreadFunc( void* pData )
+{
+    VSICurlDiskCache* poCache = static_cast<VSICurlDiskCache*>(pData);
+    poCache->Scan();
+    std::lock_guard<std::mutex> oLock(poCache->m_oMutex);
+    poCache->m_bScanned = true;
+    poCache->m_bScanInProgress = false;
+}
+
+/************************************************************************/
+/*                                Scan()                                */
+/************************************************************************/
+
+// Evicts the least recently used files when the directory exceeds the
+// maximum size. Several processes may evict concurrently, which at worst
+// removes slightly more files than needed.
+void VSICurlDiskCache::Scan()
+{
+    struct Entry
+    {
+        GIntBig   nMTime = 0;
+        GIntBig   nSize = 0;
+        CPLString osPath{};
+    };
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const GIntBig nNow = static_cast<GIntBig>(time(nullptr));
+
+    const CPLStringList aosSubDirs(VSIReadDir(m_osDirectory));
+    for( int i = 0; i < aosSubDirs.size(); i++ )
+    {
+        if( strlen(aosSubDirs[i]) != 2 || EQUAL(aosSubDirs[i], "..") )
+            continue;
+        const CPLString osSubDir(
+            CPLFormFilename(m_osDirectory, aosSubDirs[i], nullptr));
+        const CPLStringList aosFiles(VSIReadDir(osSubDir));
+        for( int j = 0; j < aosFiles.size(); j++ )
+        {
+            if( aosFiles[j][0] == '.' )
+                continue;
+            const CPLString osPath(
+                CPLFormFilename(osSubDir, aosFiles[j], nullptr));
+            VSIStatBufL sStat;
+            if( VSIStatL(osPath, &sStat) != 0 || !VSI_ISREG(sStat.st_mode) )
+                continue;
+            if( strstr(aosFiles[j], ".tmp") != nullptr )
+            {
+                // Leftover of a process that was killed while writing.
+                if( nNow - static_cast<GIntBig>(sStat.st_mtime) > 3600 )
+                    VSIUnlink(osPath);
+                continue;
+            }
+            Entry oEntry;
+            oEntry.nMTime = static_cast<GIntBig>(sStat.st_mtime);
+            oEntry.nSize = static_cast<GIntBig>(sStat.st_size);
+            oEntry.osPath = osPath;
+            nTotalSize += oEntry.nSize;
+            aoEntries.emplace_back(std::move(oEntry));
+        }
+    }
+
+    GIntBig nMaxSize;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        nMaxSize = m_nMaxSize;
+    }
+    if( nTotalSize <= nMaxSize )
+        return;
+
+    // Go a bit below the limit, so as not to scan again too soon.
+    const GIntBig nTargetSize = nMaxSize - nMaxSize / 10;
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry& a, const Entry& b)
+              { return a.nMTime < b.nMTime; });
+    for( const auto& oEntry: aoEntries )
+    {
+        if( nTotalSize <= nTargetSize )
+            break;
+        if( VSIUnlink(oEntry.osPath) == 0 )
+            nTotalSize -= oEntry.nSize;
+    }
+    CPLDebug("VSICURL", "Disk cache %s: " CPL_FRMT_GIB " bytes after eviction",
+             m_osDirectory.c_str(), nTotalSize);
+}
+
 /************************************************************************/
 /*                         GetCachedFileProp()                          */
 /************************************************************************/
@@ -2896,6 +4390,9 @@ void VSICurlFilesystemHandler::InvalidateCachedData( const char* pszURL )
 
 void VSICurlFilesystemHandler::ClearCache()
 {
+    // Also makes sure that no eviction runs once the handlers are destroyed.
+    VSICurlDiskCache::JoinScanThreads();
+
     CPLMutexHolder oHolder( &hMutex );
 
     GetRegionCache()->clear();
@@ -3040,6 +4537,22 @@ const char* VSICurlFilesystemHandler::GetActualURL(const char* pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' " \
         "description='Size in bytes of the global /vsicurl/ cache' " \
         "default='16384000'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' " \
+        "description='Directory where downloaded content is cached " \
+        "persistently'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' " \
+        "description='Maximum size in bytes of the persistent cache' " \
+        "default='1073741824'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_PREFIXES' type='string' " \
+        "description='Comma-separated list of filename prefixes for which " \
+        "the persistent cache is used'/>" \
+    "  <Option name='CPL_VSIL_CURL_PARALLEL_DOWNLOAD_COUNT' type='integer' " \
+        "description='Number of concurrent range requests used for large or " \
+        "sequential reads' default='1'/>" \
+    "  <Option name='CPL_VSIL_CURL_PARALLEL_DOWNLOAD_PART_SIZE' " \
+        "type='integer' description='Size in bytes of each range request " \
+        "when CPL_VSIL_CURL_PARALLEL_DOWNLOAD_COUNT > 1' " \
+        "default='8388608'/>" \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' " \
         "description='Whether to skip files with Glacier storage class in " \
         "directory listing.' default='YES'/>"
@@ -38,13 +38,17 @@
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_multiproc.h"
 
 #include "cpl_curl_priv.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <set>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 //! @cond Doxygen_Suppress
 
@@ -146,6 +150,45 @@ struct PutData
     }
 };
 
+/************************************************************************/
+/*                           VSICurlDiskCache                           */
+/************************************************************************/
+
+// Persistent cache of downloaded regions, stored as one file per region in a
+// local directory that may be shared by several processes.
+class VSICurlDiskCache
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlDiskCache)
+
+    CPLString       m_osDirectory{};
+    std::mutex      m_oMutex{};
+    GIntBig         m_nMaxSize = 0;
+    GIntBig         m_nBytesWrittenSinceScan = 0;
+    bool            m_bScanned = false;
+    bool            m_bScanInProgress = false;
+    CPLJoinableThread* m_hScanThread = nullptr;
+
+    explicit        VSICurlDiskCache( const CPLString& osDirectory );
+
+    CPLString       GetPath( const std::string& osKey ) const;
+    static void     ScanThreadFunc( void* pData );
+    void            Scan();
+    void            JoinScanThread();
+
+    static std::map<CPLString, std::unique_ptr<VSICurlDiskCache>>& GetCaches();
+    static std::mutex& GetCachesMutex();
+
+  public:
+                    ~VSICurlDiskCache();
+
+    static VSICurlDiskCache* GetForFilename( const char* pszFilename );
+    static void     JoinScanThreads();
+
+    std::shared_ptr<std::string> Get( const std::string& osKey );
+    void            Put( const std::string& osKey,
+                         const char* pData, size_t nSize );
+};
+
 /************************************************************************/
 /*                     VSICurlFilesystemHandler                         */
 /************************************************************************/
@@ -334,6 +377,14 @@ class VSICurlHandle : public VSIVirtualHandle
 
     CPLStringList       m_aosHeaders{};
 
+    // Region cache accessors that also go through m_poDiskCache.
+    std::shared_ptr<std::string> GetRegion( const char* pszURL,
+                                            vsi_l_offset nFileOffsetStart ) const;
+    void                AddRegion( const char* pszURL,
+                                   vsi_l_offset nFileOffsetStart,
+                                   size_t nSize,
+                                   const char *pData ) const;
+
     void                DownloadRegionPostProcess( const vsi_l_offset startOffset,
                                                    const int nBlocks,
                                                    const char* pBuffer,
@@ -354,6 +405,63 @@ class VSICurlHandle : public VSIVirtualHandle
                                          const size_t* panSizes );
     CPLString    GetRedirectURLIfValid(bool& bHasExpired);
 
+    // Serializes the calls to GetCurlHeaders() issued by PRead(), as it may
+    // update credentials of the handle helpers.
+    mutable std::mutex  m_oMutexPRead{};
+
+    bool         DownloadRegionInternal( vsi_l_offset startOffset,
+                                         int nBlocks,
+                                         bool bUpdateHandleState,
+                                         std::string& osRegion );
+
+    // Background downloads started by AdviseRead(), run by a single worker
+    // thread per handle on its curl multi handle.
+    struct AdviseReadRequest;
+    // Requests not picked yet by the worker thread.
+    std::vector<std::unique_ptr<AdviseReadRequest>> m_apoAdviseReadQueue{};
+    CPLJoinableThread*  m_hAdviseReadThread = nullptr;
+    CURLM*              m_hAdviseReadMultiHandle = nullptr;
+    bool                m_bAdviseReadStop = false;
+    bool                m_bAdviseReadUsed = false;
+    // Offsets of the chunks being downloaded by AdviseRead() requests.
+    std::set<vsi_l_offset> m_oSetAdviseReadPendingChunks{};
+    // Protects the members above, except the multi handle, which is only
+    // used by the worker thread once it is started.
+    mutable std::mutex  m_oMutexAdviseRead{};
+    mutable std::condition_variable m_oCondAdviseRead{};
+    std::condition_variable m_oCondAdviseReadQueue{};
+
+    static void  AdviseReadThreadFunc( void* pData );
+    void         ProcessAdviseReadRequests( bool bUntilIdle );
+    void         StopAdviseReadThread();
+    bool         IsAdviseReadPending( vsi_l_offset nChunkOffset ) const;
+    bool         WaitForAdviseRead( vsi_l_offset nChunkOffset ) const;
+    bool         ReadFromRegionCache( void* pBuffer, vsi_l_offset nOffset,
+                                      size_t nSize );
+
+    // Optional persistent cache backing the in-memory region cache.
+    VSICurlDiskCache* m_poDiskCache = nullptr;
+
+    std::string  GetDiskCacheKey( const char* pszURL,
+                                  vsi_l_offset nFileOffsetStart ) const;
+
+    // Parallel download of large reads, and read-ahead of sequential reads.
+    int          m_nParallelDownloadCount = 1;
+    int          m_nParallelDownloadPartChunks = 1;
+    vsi_l_offset m_nLastReadEnd = 0;
+    int          m_nSequentialReads = 0;
+    vsi_l_offset m_nPrefetchEnd = 0;
+
+    void         AdviseReadInternal( int nRanges,
+                                     const vsi_l_offset* panOffsets,
+                                     const size_t* panSizes,
+                                     int nMaxChunksPerRequest );
+    bool         CanReadParallel() const;
+    size_t       ReadParallel( GByte* pabyBuffer, vsi_l_offset nOffset,
+                               size_t nSize );
+    void         PrefetchSequential( vsi_l_offset nReadOffset,
+                                     size_t nReadSize );
+
   protected:
     virtual struct curl_slist* GetCurlHeaders( const CPLString& /*osVerb*/,
                                 const struct curl_slist* /* psExistingHeaders */)
@@ -384,6 +492,12 @@ class VSICurlHandle : public VSIVirtualHandle
     int Flush() override;
     int Close() override;
 
+    void AdviseRead( int nRanges, const vsi_l_offset* panOffsets,
+                     const size_t* panSizes ) override;
+    bool HasPRead() const override { return true; }
+    size_t PRead( void* pBuffer, size_t nSize,
+                  vsi_l_offset nOffset ) const override;
+
     bool IsKnownFileSize() const { return oFileProp.bHasComputedFileSize; }
     vsi_l_offset         GetFileSizeOrHeaders(bool bSetError, bool bGetHeaders);
     virtual vsi_l_offset GetFileSize( bool bSetError ) { return GetFileSizeOrHeaders(bSetError, false); }
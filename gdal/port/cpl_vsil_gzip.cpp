@@ -71,6 +71,11 @@
 
    For .zip and .gz, both reading and writing are supported, but just one mode
    at a time (read-only or write-only).
+
+   Zip members written with the SEEK_OPTIMIZED option are made of independently
+   deflated chunks, whose offsets are stored in a hidden entry following them.
+   They are read with VSIZipChunkedHandle, which inflates only the chunks
+   needed, in parallel, instead of relying on snapshots.
 */
 
 #include "cpl_port.h"
@@ -107,8 +112,10 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
+#include "cpl_minizip_zip.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
@@ -1207,6 +1214,9 @@ class VSIGZipWriteHandleMT final : public VSIVirtualHandle
     int                nSeqNumberExpectedCRC_ = 0;
     size_t             nChunkSize_ = 0;
     bool               bHasErrored_ = false;
+    // Offsets of the compressed chunks, relative to the start of the stream
+    std::vector<vsi_l_offset>* panChunkOffsets_ = nullptr;
+    vsi_l_offset       nCompressedOffset_ = 0;
 
     struct Job
     {
@@ -1235,7 +1245,9 @@ class VSIGZipWriteHandleMT final : public VSIVirtualHandle
     VSIGZipWriteHandleMT( VSIVirtualHandle* poBaseHandle,
                         int nThreads,
                         int nDeflateType,
-                        bool bAutoCloseBaseHandleIn );
+                        bool bAutoCloseBaseHandleIn,
+                        size_t nChunkSize = 0,
+                        std::vector<vsi_l_offset>* panChunkOffsets = nullptr );
 
     ~VSIGZipWriteHandleMT() override;
 
@@ -1255,21 +1267,28 @@ class VSIGZipWriteHandleMT final : public VSIVirtualHandle
 VSIGZipWriteHandleMT::VSIGZipWriteHandleMT(  VSIVirtualHandle* poBaseHandle,
                         int nThreads,
                         int nDeflateType,
-                        bool bAutoCloseBaseHandleIn ):
+                        bool bAutoCloseBaseHandleIn,
+                        size_t nChunkSize,
+                        std::vector<vsi_l_offset>* panChunkOffsets ):
     poBaseHandle_(poBaseHandle),
     nDeflateType_(nDeflateType),
     bAutoCloseBaseHandle_(bAutoCloseBaseHandleIn),
-    nThreads_(nThreads)
-{
-    const char* pszChunkSize = CPLGetConfigOption
-        ("CPL_VSIL_DEFLATE_CHUNK_SIZE", "1024K");
-    nChunkSize_ = static_cast<size_t>(atoi(pszChunkSize));
-    if( strchr(pszChunkSize, 'K') )
-        nChunkSize_ *= 1024;
-    else if( strchr(pszChunkSize, 'M') )
-        nChunkSize_ *= 1024 * 1024;
-    nChunkSize_ = std::max(static_cast<size_t>(32 * 1024),
-                    std::min(static_cast<size_t>(UINT_MAX), nChunkSize_));
+    nThreads_(nThreads),
+    nChunkSize_(nChunkSize),
+    panChunkOffsets_(panChunkOffsets)
+{
+    if( nChunkSize_ == 0 )
+    {
+        const char* pszChunkSize = CPLGetConfigOption
+            ("CPL_VSIL_DEFLATE_CHUNK_SIZE", "1024K");
+        nChunkSize_ = static_cast<size_t>(atoi(pszChunkSize));
+        if( strchr(pszChunkSize, 'K') )
+            nChunkSize_ *= 1024;
+        else if( strchr(pszChunkSize, 'M') )
+            nChunkSize_ *= 1024 * 1024;
+        nChunkSize_ = std::max(static_cast<size_t>(32 * 1024),
+                        std::min(static_cast<size_t>(UINT_MAX), nChunkSize_));
+    }
 
     for( int i = 0; i < 1 + nThreads_; i++ )
         aposBuffers_.emplace_back( new std::string() );
@@ -1455,14 +1474,20 @@ void VSIGZipWriteHandleMT::DeflateCompress(void* inData)
     // Z_FULL_FLUSH only is sufficient, but it is not obvious if a
     // 0x00 0x00 0xff 0xff marker in the codestream is just a SYNC_FLUSH (
     // without dictionary reset) or a FULL_FLUSH (with dictionary reset)
+    // The markers are skipped for the empty job emitted by Close(), so that
+    // an empty stream is only made of the final empty block, that the
+    // /vsizip/ reader expects for empty raw deflate streams.
+    if( !psJob->pBuffer_->empty() )
     {
-        const int zlibRet = deflate( &sStream, Z_SYNC_FLUSH );
-        CPLAssertAlwaysEval( zlibRet == Z_OK );
-    }
+        {
+            const int zlibRet = deflate( &sStream, Z_SYNC_FLUSH );
+            CPLAssertAlwaysEval( zlibRet == Z_OK );
+        }
 
-    {
-        const int zlibRet = deflate( &sStream, Z_FULL_FLUSH );
-        CPLAssertAlwaysEval( zlibRet == Z_OK );
+        {
+            const int zlibRet = deflate( &sStream, Z_FULL_FLUSH );
+            CPLAssertAlwaysEval( zlibRet == Z_OK );
+        }
     }
 
     if( psJob->bFinish_ )
@@ -1574,6 +1599,11 @@ bool VSIGZipWriteHandleMT::ProcessCompletedJobs()
                 sMutex_.unlock();
 
                 const size_t nToWrite = psJob->sCompressedData_.size();
+                // Each job deflates its chunk independently of the previous
+                // ones, so its output can be inflated on its own.
+                if( panChunkOffsets_ && !psJob->pBuffer_->empty() )
+                    panChunkOffsets_->push_back(nCompressedOffset_);
+                nCompressedOffset_ += nToWrite;
                 bool bError =
                     poBaseHandle_->Write( psJob->sCompressedData_.data(), 1,
                                           nToWrite) < nToWrite;
@@ -1855,6 +1885,23 @@ VSIGZipWriteHandle::VSIGZipWriteHandle( VSIVirtualHandle *poBaseHandle,
     }
 }
 
+/************************************************************************/
+/*                         VSIGZipGetNumThreads()                       */
+/************************************************************************/
+
+static int VSIGZipGetNumThreads( int nDefault )
+{
+    const char* pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if( pszThreads == nullptr )
+        return nDefault;
+    int nThreads = 0;
+    if( EQUAL(pszThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
 /************************************************************************/
 /*                       VSICreateGZipWritable()                        */
 /************************************************************************/
@@ -1863,29 +1910,41 @@ VSIVirtualHandle* VSICreateGZipWritable( VSIVirtualHandle* poBaseHandle,
                                          int nDeflateTypeIn,
                                          int bAutoCloseBaseHandle )
 {
-    const char* pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
-    if( pszThreads )
+    const int nThreads = VSIGZipGetNumThreads(1);
+    if( nThreads > 1 )
     {
-        int nThreads = 0;
-        if( EQUAL(pszThreads, "ALL_CPUS") )
-            nThreads = CPLGetNumCPUs();
-        else
-            nThreads = atoi(pszThreads);
-        nThreads = std::max(1, std::min(128, nThreads));
-        if( nThreads > 1 )
-        {
-            // coverity[tainted_data]
-            return new VSIGZipWriteHandleMT( poBaseHandle,
-                                                nThreads,
-                                                nDeflateTypeIn,
-                                                CPL_TO_BOOL(bAutoCloseBaseHandle) );
-        }
+        // coverity[tainted_data]
+        return new VSIGZipWriteHandleMT( poBaseHandle,
+                                            nThreads,
+                                            nDeflateTypeIn,
+                                            CPL_TO_BOOL(bAutoCloseBaseHandle) );
     }
     return new VSIGZipWriteHandle( poBaseHandle,
                                    nDeflateTypeIn,
                                    CPL_TO_BOOL(bAutoCloseBaseHandle) );
 }
 
+/************************************************************************/
+/*                   VSICreateChunkedDeflateWritable()                  */
+/************************************************************************/
+
+/* Creates a raw deflate writer that compresses independent chunks of */
+/* nChunkSize uncompressed bytes, and appends the offset of each chunk in */
+/* the compressed stream to *panChunkOffsets as they are written. */
+VSIVirtualHandle* VSICreateChunkedDeflateWritable(
+                                VSIVirtualHandle* poBaseHandle,
+                                size_t nChunkSize,
+                                std::vector<vsi_l_offset>* panChunkOffsets )
+{
+    // coverity[tainted_data]
+    return new VSIGZipWriteHandleMT( poBaseHandle,
+                                     VSIGZipGetNumThreads(1),
+                                     CPL_DEFLATE_TYPE_RAW_DEFLATE,
+                                     false,
+                                     nChunkSize,
+                                     panChunkOffsets );
+}
+
 /************************************************************************/
 /*                        ~VSIGZipWriteHandle()                         */
 /************************************************************************/
@@ -2479,6 +2538,8 @@ public:
 /* ==================================================================== */
 /************************************************************************/
 
+static bool VSIZipIsChunkIndexFilename( const CPLString& osFilename );
+
 class VSIZipReader final : public VSIArchiveReader
 {
     CPL_DISALLOW_COPY_ASSIGN(VSIZipReader)
@@ -2572,11 +2633,25 @@ bool VSIZipReader::SetInfo()
 
 int VSIZipReader::GotoNextFile()
 {
-    if( cpl_unzGoToNextFile(unzF) != UNZ_OK )
-        return FALSE;
+    // Chunk indexes of seek-optimized files are hidden. If only such
+    // entries remain, stay on the current file.
+    unz_file_pos sCurPos = file_pos;
+    do
+    {
+        if( cpl_unzGoToNextFile(unzF) != UNZ_OK )
+        {
+            if( sCurPos.num_of_file != file_pos.num_of_file &&
+                cpl_unzGoToFilePos(unzF, &sCurPos) == UNZ_OK )
+            {
+                SetInfo();
+            }
+            return FALSE;
+        }
 
-    if( !SetInfo() )
-        return FALSE;
+        if( !SetInfo() )
+            return FALSE;
+    }
+    while( VSIZipIsChunkIndexFilename(osNextFileName) );
 
     return TRUE;
 }
@@ -2593,6 +2668,9 @@ int VSIZipReader::GotoFirstFile()
     if( !SetInfo() )
         return FALSE;
 
+    if( VSIZipIsChunkIndexFilename(osNextFileName) )
+        return GotoNextFile();
+
     return TRUE;
 }
 
@@ -2616,6 +2694,542 @@ int VSIZipReader::GotoFileOffset( VSIArchiveEntryFileOffset* pOffset )
     return TRUE;
 }
 
+/************************************************************************/
+/*                     VSIZipGetChunkIndexFilename()                    */
+/************************************************************************/
+
+static CPLString VSIZipGetChunkIndexFilename( const CPLString& osFilename )
+{
+    const size_t nPos = osFilename.rfind('/');
+    if( nPos == std::string::npos )
+        return "." + osFilename + CPL_ZIP_CHUNK_INDEX_SUFFIX;
+    return osFilename.substr(0, nPos + 1) + "." + osFilename.substr(nPos + 1) +
+           CPL_ZIP_CHUNK_INDEX_SUFFIX;
+}
+
+/************************************************************************/
+/*                      VSIZipIsChunkIndexFilename()                    */
+/************************************************************************/
+
+static bool VSIZipIsChunkIndexFilename( const CPLString& osFilename )
+{
+    const size_t nPos = osFilename.rfind('/');
+    const size_t nStart = nPos == std::string::npos ? 0 : nPos + 1;
+    const size_t nSuffixLen = strlen(CPL_ZIP_CHUNK_INDEX_SUFFIX);
+    return osFilename.size() > nStart + 1 + nSuffixLen &&
+           osFilename[nStart] == '.' &&
+           osFilename.compare(osFilename.size() - nSuffixLen, nSuffixLen,
+                              CPL_ZIP_CHUNK_INDEX_SUFFIX) == 0;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         VSIZipChunkedHandle                          */
+/* ==================================================================== */
+/************************************************************************/
+
+// Read handle for a zip member deflated as independent chunks (see
+// CPL_ZIP_CHUNK_INDEX_SUFFIX). Any chunk can be inflated on its own from the
+// chunk index, which gives true random access, and the chunks needed by a
+// read are inflated in parallel.
+
+class VSIZipChunkedHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIZipChunkedHandle)
+
+    VSIVirtualHandle* m_poBaseHandle = nullptr;
+    vsi_l_offset      m_nStartOffset = 0;
+    vsi_l_offset      m_nUncompressedSize = 0;
+    size_t            m_nChunkSize = 0;
+    // Offset of each chunk in the compressed data, plus the compressed size.
+    std::vector<vsi_l_offset> m_anChunkOffsets{};
+    vsi_l_offset      m_nCurOffset = 0;
+    vsi_l_offset      m_nLastReadEnd = 0;
+    bool              m_bEOF = false;
+    int               m_nThreads = 1;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    lru11::Cache<size_t, std::shared_ptr<std::string>> m_oCacheChunks;
+    std::string       m_osCompressedData{};
+
+    struct InflateJob
+    {
+        const GByte* pabySrc = nullptr;
+        size_t       nSrcSize = 0;
+        GByte*       pabyDst = nullptr;
+        size_t       nDstSize = 0;
+        bool         bOK = false;
+    };
+
+    static void Inflate( void* pData );
+
+    size_t GetChunkCount() const { return m_anChunkOffsets.size() - 1; }
+    size_t GetChunkSize( size_t iChunk ) const;
+    bool   InflateChunks( std::vector<InflateJob>& asJobs,
+                          const std::vector<size_t>& anChunks );
+
+  public:
+    VSIZipChunkedHandle( VSIVirtualHandle* poBaseHandle,
+                         vsi_l_offset nStartOffset,
+                         vsi_l_offset nUncompressedSize,
+                         size_t nChunkSize,
+                         std::vector<vsi_l_offset>&& anChunkOffsets );
+    ~VSIZipChunkedHandle() override;
+
+    int Seek( vsi_l_offset nOffset, int nWhence ) override;
+    vsi_l_offset Tell() override { return m_nCurOffset; }
+    size_t Read( void *pBuffer, size_t nSize, size_t nMemb ) override;
+    size_t Write( const void *pBuffer, size_t nSize, size_t nMemb ) override;
+    int Eof() override { return m_bEOF; }
+    int Close() override;
+
+    static VSIZipChunkedHandle* Create( VSIVirtualHandle* poBaseHandle,
+                                        unzFile unzF,
+                                        const CPLString& osFilename,
+                                        vsi_l_offset nStartOffset,
+                                        const unz_file_info& file_info );
+};
+
+/************************************************************************/
+/*                        VSIZipChunkedHandle()                         */
+/************************************************************************/
+
+VSIZipChunkedHandle::VSIZipChunkedHandle(
+                            VSIVirtualHandle* poBaseHandle,
+                            vsi_l_offset nStartOffset,
+                            vsi_l_offset nUncompressedSize,
+                            size_t nChunkSize,
+                            std::vector<vsi_l_offset>&& anChunkOffsets ) :
+    m_poBaseHandle(poBaseHandle),
+    m_nStartOffset(nStartOffset),
+    m_nUncompressedSize(nUncompressedSize),
+    m_nChunkSize(nChunkSize),
+    m_anChunkOffsets(std::move(anChunkOffsets)),
+    m_nThreads(VSIGZipGetNumThreads(CPLGetNumCPUs())),
+    // Keep up to 8 MB of uncompressed chunks, and at least one chunk per
+    // thread for the read-ahead of sequential reads.
+    m_oCacheChunks(std::max(static_cast<size_t>(2 * m_nThreads),
+                            8 * 1024 * 1024 / nChunkSize), 0)
+{
+}
+
+/************************************************************************/
+/*                       ~VSIZipChunkedHandle()                         */
+/************************************************************************/
+
+VSIZipChunkedHandle::~VSIZipChunkedHandle()
+{
+    VSIZipChunkedHandle::Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIZipChunkedHandle::Close()
+{
+    int nRet = 0;
+    if( m_poBaseHandle )
+    {
+        nRet = m_poBaseHandle->Close();
+        delete m_poBaseHandle;
+        m_poBaseHandle = nullptr;
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+/* Returns a chunked handle if the member on which unzF is positioned is */
+/* followed by a valid chunk index, or nullptr otherwise. */
+/* unzF is left on an undefined member. */
+
+VSIZipChunkedHandle* VSIZipChunkedHandle::Create(
+                                    VSIVirtualHandle* poBaseHandle,
+                                    unzFile unzF,
+                                    const CPLString& osFilename,
+                                    vsi_l_offset nStartOffset,
+                                    const unz_file_info& file_info )
+{
+    if( file_info.compression_method != Z_DEFLATED ||
+        VSIZipIsChunkIndexFilename(osFilename) )
+        return nullptr;
+
+    // The chunk index is written just after the file it indexes.
+    if( cpl_unzGoToNextFile(unzF) != UNZ_OK )
+        return nullptr;
+    char szIndexFilename[8193] = {};
+    unz_file_info index_info;
+    if( cpl_unzGetCurrentFileInfo(unzF, &index_info,
+                                  szIndexFilename, sizeof(szIndexFilename) - 1,
+                                  nullptr, 0, nullptr, 0) != UNZ_OK ||
+        VSIZipGetChunkIndexFilename(osFilename) != szIndexFilename ||
+        index_info.compression_method != 0 ||
+        index_info.uncompressed_size < CPL_ZIP_CHUNK_INDEX_HEADER_SIZE )
+    {
+        return nullptr;
+    }
+
+    // Reject index sizes that cannot fit in the archive before allocating.
+    if( poBaseHandle->Seek(0, SEEK_END) != 0 ||
+        index_info.uncompressed_size > poBaseHandle->Tell() )
+        return nullptr;
+
+    GByte abyHeader[CPL_ZIP_CHUNK_INDEX_HEADER_SIZE];
+    if( cpl_unzOpenCurrentFile(unzF) != UNZ_OK )
+        return nullptr;
+    bool bOK = cpl_unzReadCurrentFile(unzF, abyHeader, sizeof(abyHeader)) ==
+                    static_cast<int>(sizeof(abyHeader));
+
+    GUInt32 nVersion = 0;
+    GUInt32 nHeaderSize = 0;
+    GUInt32 nChunkSize = 0;
+    GUInt32 nOffsetSize = 0;
+    GUInt64 nUncompressedSize = 0;
+    GUInt64 nCompressedSize = 0;
+    memcpy(&nVersion, abyHeader, 4);
+    memcpy(&nHeaderSize, abyHeader + 4, 4);
+    memcpy(&nChunkSize, abyHeader + 8, 4);
+    memcpy(&nOffsetSize, abyHeader + 12, 4);
+    memcpy(&nUncompressedSize, abyHeader + 16, 8);
+    memcpy(&nCompressedSize, abyHeader + 24, 8);
+    CPL_LSBPTR32(&nVersion);
+    CPL_LSBPTR32(&nHeaderSize);
+    CPL_LSBPTR32(&nChunkSize);
+    CPL_LSBPTR32(&nOffsetSize);
+    CPL_LSBPTR64(&nUncompressedSize);
+    CPL_LSBPTR64(&nCompressedSize);
+
+    // Only trust an index that describes this very file.
+    const GUInt64 nChunks = nChunkSize == 0 ? 0 :
+        (nUncompressedSize + nChunkSize - 1) / nChunkSize;
+    bOK = bOK &&
+          nVersion == CPL_ZIP_CHUNK_INDEX_VERSION &&
+          nHeaderSize == CPL_ZIP_CHUNK_INDEX_HEADER_SIZE &&
+          nOffsetSize == sizeof(GUInt64) &&
+          nUncompressedSize == file_info.uncompressed_size &&
+          nCompressedSize == file_info.compressed_size &&
+          nChunks >= 2 &&
+          index_info.uncompressed_size ==
+                nHeaderSize + (nChunks - 1) * sizeof(GUInt64);
+
+    std::vector<vsi_l_offset> anChunkOffsets;
+    if( bOK )
+    {
+        std::vector<GUInt64> anOffsetsLE;
+        try
+        {
+            anOffsetsLE.resize(static_cast<size_t>(nChunks - 1));
+            anChunkOffsets.reserve(static_cast<size_t>(nChunks + 1));
+        }
+        catch( const std::exception& )
+        {
+            bOK = false;
+        }
+        const size_t nToRead = anOffsetsLE.size() * sizeof(GUInt64);
+        if( bOK && nToRead > static_cast<size_t>(INT_MAX) )
+            bOK = false;
+        bOK = bOK &&
+              cpl_unzReadCurrentFile(unzF, anOffsetsLE.data(),
+                                     static_cast<unsigned>(nToRead)) ==
+                    static_cast<int>(nToRead);
+        if( bOK )
+        {
+            anChunkOffsets.push_back(0);
+            for( GUInt64 nOffset : anOffsetsLE )
+            {
+                CPL_LSBPTR64(&nOffset);
+                if( nOffset <= anChunkOffsets.back() ||
+                    nOffset >= nCompressedSize )
+                {
+                    bOK = false;
+                    break;
+                }
+                anChunkOffsets.push_back(nOffset);
+            }
+            anChunkOffsets.push_back(nCompressedSize);
+        }
+    }
+    cpl_unzCloseCurrentFile(unzF);
+
+    if( !bOK )
+    {
+        CPLDebug("VSIZIP", "Ignoring invalid chunk index for %s",
+                 osFilename.c_str());
+        return nullptr;
+    }
+
+    return new VSIZipChunkedHandle(poBaseHandle, nStartOffset,
+                                   nUncompressedSize, nChunkSize,
+                                   std::move(anChunkOffsets));
+}
+
+/************************************************************************/
+/*                           GetChunkSize()                             */
+/************************************************************************/
+
+size_t VSIZipChunkedHandle::GetChunkSize( size_t iChunk ) const
+{
+    const vsi_l_offset nStart = static_cast<vsi_l_offset>(iChunk) * m_nChunkSize;
+    return static_cast<size_t>(
+        std::min(static_cast<vsi_l_offset>(m_nChunkSize),
+                 m_nUncompressedSize - nStart));
+}
+
+/************************************************************************/
+/*                              Inflate()                               */
+/************************************************************************/
+
+void VSIZipChunkedHandle::Inflate( void* pData )
+{
+    InflateJob* psJob = static_cast<InflateJob*>(pData);
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if( inflateInit2(&sStream, -MAX_WBITS) != Z_OK )
+    {
+        psJob->bOK = false;
+        return;
+    }
+    sStream.next_in = const_cast<Bytef*>(psJob->pabySrc);
+    sStream.avail_in = static_cast<uInt>(psJob->nSrcSize);
+    sStream.next_out = psJob->pabyDst;
+    sStream.avail_out = static_cast<uInt>(psJob->nDstSize);
+    // Chunks other than the last one have no end-of-stream marker, so
+    // Z_BUF_ERROR is expected once the output buffer is full.
+    const int ret = inflate(&sStream, Z_FINISH);
+    inflateEnd(&sStream);
+    psJob->bOK = (ret == Z_STREAM_END || ret == Z_BUF_ERROR || ret == Z_OK) &&
+                 sStream.avail_out == 0;
+}
+
+/************************************************************************/
+/*                           InflateChunks()                            */
+/************************************************************************/
+
+/* Inflates the chunks of anChunks (sorted by increasing index), whose */
+/* destination buffers are set in asJobs. */
+
+bool VSIZipChunkedHandle::InflateChunks( std::vector<InflateJob>& asJobs,
+                                         const std::vector<size_t>& anChunks )
+{
+    // Bound the size of a single read of compressed data.
+    constexpr vsi_l_offset MAX_COMPRESSED_BATCH = 16 * 1024 * 1024;
+
+    size_t iFirst = 0;
+    while( iFirst < anChunks.size() )
+    {
+        const vsi_l_offset nBatchStart = m_anChunkOffsets[anChunks[iFirst]];
+        size_t iLast = iFirst;
+        while( iLast + 1 < anChunks.size() &&
+               m_anChunkOffsets[anChunks[iLast + 1] + 1] - nBatchStart <=
+                                                    MAX_COMPRESSED_BATCH )
+        {
+            ++iLast;
+        }
+        const vsi_l_offset nBatchEnd = m_anChunkOffsets[anChunks[iLast] + 1];
+        const size_t nBatchSize = static_cast<size_t>(nBatchEnd - nBatchStart);
+
+        try
+        {
+            m_osCompressedData.resize(nBatchSize);
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate %u bytes",
+                     static_cast<unsigned>(nBatchSize));
+            return false;
+        }
+        if( m_poBaseHandle->Seek(m_nStartOffset + nBatchStart, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(&m_osCompressedData[0], 1, nBatchSize) !=
+                                                                nBatchSize )
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Cannot read compressed data");
+            return false;
+        }
+
+        std::vector<void*> apJobs;
+        for( size_t i = iFirst; i <= iLast; ++i )
+        {
+            const size_t iChunk = anChunks[i];
+            asJobs[i].pabySrc = reinterpret_cast<const GByte*>(
+                m_osCompressedData.data()) +
+                (m_anChunkOffsets[iChunk] - nBatchStart);
+            asJobs[i].nSrcSize = static_cast<size_t>(
+                m_anChunkOffsets[iChunk + 1] - m_anChunkOffsets[iChunk]);
+            apJobs.push_back(&asJobs[i]);
+        }
+
+        if( apJobs.size() >= 2 && m_nThreads > 1 && m_poJobQueue == nullptr )
+        {
+            // Use the process-wide pool, rather than creating threads for
+            // each opened file.
+            CPLWorkerThreadPool* poPool = CPLGetGlobalWorkerThreadPool(m_nThreads);
+            if( poPool )
+                m_poJobQueue = poPool->CreateJobQueue();
+            else
+                m_nThreads = 1;
+        }
+        if( apJobs.size() >= 2 && m_poJobQueue )
+        {
+            for( void* pJob : apJobs )
+            {
+                if( !m_poJobQueue->SubmitJob(Inflate, pJob) )
+                    Inflate(pJob);
+            }
+            m_poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for( void* pJob : apJobs )
+                Inflate(pJob);
+        }
+
+        for( size_t i = iFirst; i <= iLast; ++i )
+        {
+            if( !asJobs[i].bOK )
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Error while inflating chunk %u",
+                         static_cast<unsigned>(anChunks[i]));
+                return false;
+            }
+        }
+
+        iFirst = iLast + 1;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIZipChunkedHandle::Read( void *pBuffer, size_t nSize, size_t nMemb )
+{
+    const size_t nBytes = nSize * nMemb;
+    if( nBytes == 0 )
+        return 0;
+    if( m_nCurOffset >= m_nUncompressedSize )
+    {
+        m_bEOF = true;
+        return 0;
+    }
+
+    size_t nToRead = nBytes;
+    if( m_nUncompressedSize - m_nCurOffset < nBytes )
+    {
+        nToRead = static_cast<size_t>(m_nUncompressedSize - m_nCurOffset);
+        m_bEOF = true;
+    }
+    const vsi_l_offset nEnd = m_nCurOffset + nToRead;
+    const size_t nFirstChunk = static_cast<size_t>(m_nCurOffset / m_nChunkSize);
+    const size_t nLastChunk = static_cast<size_t>((nEnd - 1) / m_nChunkSize);
+
+    // For sequential reads, inflate the next chunks together with the ones
+    // that are needed now.
+    size_t nLastChunkToInflate = nLastChunk;
+    if( m_nCurOffset == m_nLastReadEnd && m_nThreads > 1 )
+    {
+        nLastChunkToInflate = std::min(GetChunkCount() - 1,
+                                       nLastChunk + m_nThreads - 1);
+    }
+
+    GByte* pabyBuffer = static_cast<GByte*>(pBuffer);
+    std::vector<std::shared_ptr<std::string>> apoChunks(
+                                    nLastChunkToInflate - nFirstChunk + 1);
+    std::vector<size_t> anChunksToInflate;
+    std::vector<InflateJob> asJobs;
+    for( size_t iChunk = nFirstChunk; iChunk <= nLastChunkToInflate; ++iChunk )
+    {
+        auto& poChunk = apoChunks[iChunk - nFirstChunk];
+        if( m_oCacheChunks.tryGet(iChunk, poChunk) )
+            continue;
+        if( iChunk > nLastChunk && anChunksToInflate.empty() )
+            break;
+
+        InflateJob sJob;
+        sJob.nDstSize = GetChunkSize(iChunk);
+        const vsi_l_offset nChunkStart =
+            static_cast<vsi_l_offset>(iChunk) * m_nChunkSize;
+        if( nChunkStart >= m_nCurOffset && nChunkStart + sJob.nDstSize <= nEnd )
+        {
+            // Chunk fully covered by the request: inflate it in place.
+            sJob.pabyDst = pabyBuffer + (nChunkStart - m_nCurOffset);
+        }
+        else
+        {
+            poChunk = std::make_shared<std::string>();
+            poChunk->resize(sJob.nDstSize);
+            sJob.pabyDst = reinterpret_cast<GByte*>(&(*poChunk)[0]);
+        }
+        anChunksToInflate.push_back(iChunk);
+        asJobs.push_back(sJob);
+    }
+
+    if( !anChunksToInflate.empty() &&
+        !InflateChunks(asJobs, anChunksToInflate) )
+    {
+        m_bEOF = false;
+        return 0;
+    }
+
+    for( size_t iChunk = nFirstChunk; iChunk <= nLastChunkToInflate; ++iChunk )
+    {
+        const auto& poChunk = apoChunks[iChunk - nFirstChunk];
+        if( poChunk == nullptr )
+            continue;
+        m_oCacheChunks.insert(iChunk, poChunk);
+        if( iChunk > nLastChunk )
+            continue;
+
+        const vsi_l_offset nChunkStart =
+            static_cast<vsi_l_offset>(iChunk) * m_nChunkSize;
+        const vsi_l_offset nCopyStart = std::max(nChunkStart, m_nCurOffset);
+        const vsi_l_offset nCopyEnd =
+            std::min(nChunkStart + poChunk->size(), nEnd);
+        memcpy(pabyBuffer + (nCopyStart - m_nCurOffset),
+               poChunk->data() + (nCopyStart - nChunkStart),
+               static_cast<size_t>(nCopyEnd - nCopyStart));
+    }
+
+    m_nCurOffset = nEnd;
+    m_nLastReadEnd = nEnd;
+    return nToRead / nSize;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIZipChunkedHandle::Seek( vsi_l_offset nOffset, int nWhence )
+{
+    m_bEOF = false;
+    if( nWhence == SEEK_SET )
+        m_nCurOffset = nOffset;
+    else if( nWhence == SEEK_CUR )
+        m_nCurOffset += nOffset;
+    else
+        m_nCurOffset = m_nUncompressedSize + nOffset;
+    return 0;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIZipChunkedHandle::Write( const void * /* pBuffer */,
+                                   size_t /* nSize */,
+                                   size_t /* nMemb */ )
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on Zip read streams");
+    return 0;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIZipFilesystemHandler                  */
@@ -2630,7 +3244,8 @@ class VSIZipFilesystemHandler final : public VSIArchiveFilesystemHandler
 
     std::map<CPLString, VSIZipWriteHandle*> oMapZipWriteHandles{};
     VSIVirtualHandle *OpenForWrite_unlocked( const char *pszFilename,
-                                            const char *pszAccess );
+                                            const char *pszAccess,
+                                            CSLConstList papszOptions );
 
   public:
     VSIZipFilesystemHandler() = default;
@@ -2643,10 +3258,11 @@ class VSIZipFilesystemHandler final : public VSIArchiveFilesystemHandler
     VSIVirtualHandle *Open( const char *pszFilename,
                             const char *pszAccess,
                             bool bSetError,
-                            CSLConstList /* papszOptions */ ) override;
+                            CSLConstList papszOptions ) override;
 
     VSIVirtualHandle *OpenForWrite( const char *pszFilename,
-                                    const char *pszAccess );
+                                    const char *pszAccess,
+                                    CSLConstList papszOptions = nullptr );
 
     int Mkdir( const char *pszDirname, long nMode ) override;
     char **ReadDirEx( const char *pszDirname, int nMaxFiles ) override;
@@ -2777,12 +3393,12 @@ VSIArchiveReader* VSIZipFilesystemHandler::CreateReader(
 VSIVirtualHandle* VSIZipFilesystemHandler::Open( const char *pszFilename,
                                                  const char *pszAccess,
                                                  bool /* bSetError */,
-                                                 CSLConstList /* papszOptions */ )
+                                                 CSLConstList papszOptions )
 {
 
     if( strchr(pszAccess, 'w') != nullptr )
     {
-        return OpenForWrite(pszFilename, pszAccess);
+        return OpenForWrite(pszFilename, pszAccess, papszOptions);
     }
 
     if( strchr(pszAccess, '+') != nullptr )
@@ -2858,8 +3474,17 @@ VSIVirtualHandle* VSIZipFilesystemHandler::Open( const char *pszFilename,
 
     cpl_unzCloseCurrentFile(unzF);
 
+    // Files with a chunk index can be read at random without a snapshot
+    // mechanism.
+    VSIVirtualHandle* poChunkedHandle =
+        VSIZipChunkedHandle::Create(poVirtualHandle, unzF,
+                                    poReader->GetFileName(), pos, file_info);
+
     delete poReader;
 
+    if( poChunkedHandle )
+        return poChunkedHandle;
+
     VSIGZipHandle* poGZIPHandle =
         new VSIGZipHandle(poVirtualHandle,
                           nullptr,
@@ -2983,15 +3608,17 @@ void VSIZipFilesystemHandler::RemoveFromMap( VSIZipWriteHandle* poHandle )
 
 VSIVirtualHandle *
 VSIZipFilesystemHandler::OpenForWrite( const char *pszFilename,
-                                       const char *pszAccess )
+                                       const char *pszAccess,
+                                       CSLConstList papszOptions )
 {
     CPLMutexHolder oHolder( &hMutex );
-    return OpenForWrite_unlocked(pszFilename, pszAccess);
+    return OpenForWrite_unlocked(pszFilename, pszAccess, papszOptions);
 }
 
 VSIVirtualHandle *
 VSIZipFilesystemHandler::OpenForWrite_unlocked( const char *pszFilename,
-                                                const char *pszAccess )
+                                                const char *pszAccess,
+                                                CSLConstList papszOptions )
 {
     CPLString osZipInFileName;
 
@@ -3041,7 +3668,8 @@ VSIZipFilesystemHandler::OpenForWrite_unlocked( const char *pszFilename,
             osZipInFileName += chLastChar;
 
         if( CPLCreateFileInZip(poZIPHandle->GetHandle(),
-                               osZipInFileName, nullptr) != CE_None )
+                               osZipInFileName,
+                               const_cast<char**>(papszOptions)) != CE_None )
             return nullptr;
 
         VSIZipWriteHandle* poChildHandle =
@@ -3053,17 +3681,18 @@ VSIZipFilesystemHandler::OpenForWrite_unlocked( const char *pszFilename,
     }
     else
     {
-        char** papszOptions = nullptr;
+        char** papszCreateOptions = nullptr;
         if( (strchr(pszAccess, '+') && osZipInFileName.empty()) ||
              !osZipInFileName.empty() )
         {
             VSIStatBufL sBuf;
             if( VSIStatExL(osZipFilename, &sBuf, VSI_STAT_EXISTS_FLAG) == 0 )
-                papszOptions = CSLAddNameValue(papszOptions, "APPEND", "TRUE");
+                papszCreateOptions = CSLAddNameValue(papszCreateOptions,
+                                                     "APPEND", "TRUE");
         }
 
-        void* hZIP = CPLCreateZip(osZipFilename, papszOptions);
-        CSLDestroy(papszOptions);
+        void* hZIP = CPLCreateZip(osZipFilename, papszCreateOptions);
+        CSLDestroy(papszCreateOptions);
 
         if( hZIP == nullptr )
             return nullptr;
@@ -3074,7 +3703,7 @@ VSIZipFilesystemHandler::OpenForWrite_unlocked( const char *pszFilename,
         if( !osZipInFileName.empty() )
         {
             VSIZipWriteHandle* poRes = reinterpret_cast<VSIZipWriteHandle*>(
-                OpenForWrite_unlocked(pszFilename, pszAccess));
+                OpenForWrite_unlocked(pszFilename, pszAccess, papszOptions));
             if( poRes == nullptr )
             {
                 delete oMapZipWriteHandles[osZipFilename];
@@ -3103,6 +3732,12 @@ const char* VSIZipFilesystemHandler::GetOptions()
     "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
         "description='Chunk of uncompressed data for parallelization. "
         "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+    "  <Option name='CPL_VSIL_ZIP_SEEK_OPTIMIZED' type='boolean' "
+        "description='Whether to write files as independent chunks with a "
+        "chunk index, for fast random access' default='NO'/>"
+    "  <Option name='CPL_VSIL_ZIP_SEEK_OPTIMIZED_CHUNK_SIZE' type='string' "
+        "description='Chunk of uncompressed data for seek-optimized files. "
+        "Use K(ilobytes) or M(egabytes) suffix' default='32K'/>"
     "</Options>";
 }
 
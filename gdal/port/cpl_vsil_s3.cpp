@@ -3313,6 +3313,34 @@ bool IVSIS3LikeFSHandler::CopyFile(VSILFILE* fpIn,
     return ret;
 }
 
+/************************************************************************/
+/*                     CreateTargetForChunkedCopy()                     */
+/************************************************************************/
+
+// Creates the target file with its final size, so that its chunks can then
+// be written concurrently by CopyChunk(), which opens it without truncating
+// it.
+static bool CreateTargetForChunkedCopy(const char* pszTarget,
+                                       vsi_l_offset nSize)
+{
+    VSILFILE* fpOut = VSIFOpenExL(pszTarget, "wb", TRUE);
+    if( fpOut == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszTarget);
+        return false;
+    }
+    bool ret = VSIFTruncateL(fpOut, nSize) == 0;
+    if( VSIFCloseL(fpOut) != 0 )
+    {
+        ret = false;
+    }
+    if( !ret )
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot set size of %s", pszTarget);
+    }
+    return ret;
+}
+
 /************************************************************************/
 /*                          CopyChunk()                                 */
 /************************************************************************/
@@ -3329,10 +3357,11 @@ static bool CopyChunk(const char* pszSource,
         return false;
     }
 
-    VSILFILE* fpOut = VSIFOpenExL(pszTarget, "wb+", TRUE);
+    // The target has been created by CreateTargetForChunkedCopy()
+    VSILFILE* fpOut = VSIFOpenExL(pszTarget, "rb+", TRUE);
     if( fpOut == nullptr )
     {
-        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszTarget);
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s", pszTarget);
         VSIFCloseL(fpIn);
         return false;
     }
@@ -3345,17 +3374,27 @@ static bool CopyChunk(const char* pszSource,
     }
     else
     {
-        void* pBuffer = VSI_MALLOC_VERBOSE(nChunkSize);
+        // Bound memory usage, whatever the chunk size.
+        constexpr size_t nMaxBufferSize = 8 * 1024 * 1024;
+        const size_t nBufferSize = std::min(nChunkSize, nMaxBufferSize);
+        void* pBuffer = VSI_MALLOC_VERBOSE(nBufferSize);
         if( pBuffer == nullptr )
         {
             ret = false;
         }
         else
         {
-            if( VSIFReadL(pBuffer, 1, nChunkSize, fpIn) != nChunkSize ||
-                VSIFWriteL(pBuffer, 1, nChunkSize, fpOut) != nChunkSize )
+            size_t nRemaining = nChunkSize;
+            while( nRemaining > 0 )
             {
-                ret = false;
+                const size_t nToCopy = std::min(nRemaining, nBufferSize);
+                if( VSIFReadL(pBuffer, 1, nToCopy, fpIn) != nToCopy ||
+                    VSIFWriteL(pBuffer, 1, nToCopy, fpOut) != nToCopy )
+                {
+                    ret = false;
+                    break;
+                }
+                nRemaining -= nToCopy;
             }
         }
         VSIFree(pBuffer);
@@ -3565,6 +3604,12 @@ bool IVSIS3LikeFSHandler::Sync( const char* pszSource, const char* pszTarget,
     std::vector<ChunkToCopy> aoChunksToCopy;
     std::set<CPLString> aoSetDirsToCreate;
     const char* pszChunkSize = CSLFetchNameValue(papszOptions, "CHUNK_SIZE");
+    // Large downloads are split in chunks of 8 MB by default, as done by
+    // the Python s3transfer library.
+    const bool bDefaultChunkSize =
+        pszChunkSize == nullptr && bDownloadFromNetworkToLocal;
+    if( bDefaultChunkSize )
+        pszChunkSize = "8388608";
 #if !defined(CPL_MULTIPROC_STUB)
     // 10 threads used by default by the Python s3transfer library
     const int nRequestedThreads = atoi(CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "10"));
@@ -3720,7 +3765,8 @@ bool IVSIS3LikeFSHandler::Sync( const char* pszSource, const char* pszTarget,
                 // Split file in possibly multiple chunks
                 const vsi_l_offset nChunksLarge = nMaxChunkSize == 0 ? 1 :
                         (entry->nSize + nMaxChunkSize - 1) / nMaxChunkSize;
-                if( nChunksLarge > 1000 ) // must also be below knMAX_PART_NUMBER for upload
+                // must also be below knMAX_PART_NUMBER for upload
+                if( nChunksLarge > 1000 && !bDefaultChunkSize )
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
                              "Too small CHUNK_SIZE w.r.t file size");
@@ -3822,9 +3868,9 @@ bool IVSIS3LikeFSHandler::Sync( const char* pszSource, const char* pszTarget,
                 {
                     if( bDownloadFromNetworkToLocal )
                     {
-                        // Suppress target file as we're going to open in wb+ mode
-                        // for parallelized writing
-                        VSIUnlink(osSubTarget);
+                        if( !CreateTargetForChunkedCopy(osSubTarget,
+                                                        chunk.nTotalSize) )
+                            return false;
                     }
                     else if( bSupportsParallelMultipartUpload )
                     {
@@ -3979,7 +4025,8 @@ bool IVSIS3LikeFSHandler::Sync( const char* pszSource, const char* pszTarget,
         // Split file in possibly multiple chunks
         const vsi_l_offset nChunksLarge = nMaxChunkSize == 0 ? 1 :
                 (sSource.st_size + nMaxChunkSize - 1) / nMaxChunkSize;
-        if( nChunksLarge > 1000 ) // must also be below knMAX_PART_NUMBER for upload
+        // must also be below knMAX_PART_NUMBER for upload
+        if( nChunksLarge > 1000 && !bDefaultChunkSize )
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                         "Too small CHUNK_SIZE w.r.t file size");
@@ -4005,9 +4052,9 @@ bool IVSIS3LikeFSHandler::Sync( const char* pszSource, const char* pszTarget,
                 {
                     if( bDownloadFromNetworkToLocal )
                     {
-                        // Suppress target file as we're going to open in wb+ mode
-                        // for parallelized writing
-                        VSIUnlink(osTarget);
+                        if( !CreateTargetForChunkedCopy(osTarget,
+                                                        chunk.nTotalSize) )
+                            return false;
                     }
                     else if( bSupportsParallelMultipartUpload )
                     {
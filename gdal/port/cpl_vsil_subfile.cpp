@@ -37,6 +37,7 @@
 #  include <fcntl.h>
 #endif
 #include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_multiproc.h"
@@ -70,6 +71,11 @@ class VSISubFileHandle final: public VSIVirtualHandle
     size_t Write( const void *pBuffer, size_t nSize, size_t nMemb ) override;
     int Eof() override;
     int Close() override;
+    void AdviseRead( int nRanges, const vsi_l_offset* panOffsets,
+                     const size_t* panSizes ) override;
+    bool HasPRead() const override;
+    size_t PRead( void* pBuffer, size_t nSize,
+                  vsi_l_offset nOffset ) const override;
 };
 
 /************************************************************************/
@@ -224,6 +230,61 @@ size_t VSISubFileHandle::Read( void * pBuffer, size_t nSize, size_t nCount )
     return nRet;
 }
 
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSISubFileHandle::AdviseRead( int nRanges,
+                                   const vsi_l_offset* panOffsets,
+                                   const size_t* panSizes )
+{
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for( int i = 0; i < nRanges; ++i )
+    {
+        if( nSubregionSize != 0 && panOffsets[i] >= nSubregionSize )
+            break;
+        size_t nSize = panSizes[i];
+        if( nSubregionSize != 0 && nSize > nSubregionSize - panOffsets[i] )
+            nSize = static_cast<size_t>(nSubregionSize - panOffsets[i]);
+        anOffsets.push_back(nSubregionOffset + panOffsets[i]);
+        anSizes.push_back(nSize);
+    }
+    if( !anOffsets.empty() )
+    {
+        VSIFAdviseReadL(static_cast<int>(anOffsets.size()), anOffsets.data(),
+                        anSizes.data(), fp);
+    }
+}
+
+/************************************************************************/
+/*                              HasPRead()                              */
+/************************************************************************/
+
+bool VSISubFileHandle::HasPRead() const
+{
+    return reinterpret_cast<VSIVirtualHandle*>(fp)->HasPRead();
+}
+
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+size_t VSISubFileHandle::PRead( void* pBuffer, size_t nSize,
+                                vsi_l_offset nOffset ) const
+{
+    size_t nByteToRead = nSize;
+    if( nSubregionSize != 0 )
+    {
+        if( nOffset >= nSubregionSize )
+            return 0;
+        if( nSize > nSubregionSize - nOffset )
+            nByteToRead = static_cast<size_t>(nSubregionSize - nOffset);
+    }
+    return reinterpret_cast<VSIVirtualHandle*>(fp)->PRead(
+        pBuffer, nByteToRead, nSubregionOffset + nOffset);
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -109,6 +109,10 @@ CPL_CVSID("$Id$")
 #ifndef VSI_FTRUNCATE64
 #define VSI_FTRUNCATE64 ftruncate64
 #endif
+#ifndef VSI_PREAD64
+// Not all systems with 64 bit stdio have pread64() (macOS, BSDs)
+#define VSI_PREAD64 pread
+#endif
 
 #else /* not UNIX_STDIO_64 */
 
@@ -130,6 +134,9 @@ CPL_CVSID("$Id$")
 #ifndef VSI_FTRUNCATE64
 #define VSI_FTRUNCATE64 ftruncate
 #endif
+#ifndef VSI_PREAD64
+#define VSI_PREAD64 pread
+#endif
 
 #endif /* ndef UNIX_STDIO_64 */
 
@@ -215,6 +222,11 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
         return reinterpret_cast<void *>(static_cast<size_t>(fileno(fp))); }
     VSIRangeStatus GetRangeStatus( vsi_l_offset nOffset,
                                    vsi_l_offset nLength ) override;
+    // Data written through the FILE* may still sit in its buffer, so only
+    // read-only handles can safely bypass it.
+    bool HasPRead() const override { return bReadOnly; }
+    size_t PRead( void* pBuffer, size_t nSize,
+                  vsi_l_offset nOffset ) const override;
 };
 
 /************************************************************************/
@@ -507,6 +519,39 @@ int VSIUnixStdioHandle::Truncate( vsi_l_offset nNewSize )
     return VSI_FTRUNCATE64( fileno(fp), nNewSize );
 }
 
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+size_t VSIUnixStdioHandle::PRead( void* pBuffer, size_t nSize,
+                                  vsi_l_offset nOffset ) const
+{
+    // pread() does not use nor update the file position shared with the
+    // FILE* stream, so it is safe to call from several threads.
+    const int fd = fileno(fp);
+    GByte* pabyBuffer = static_cast<GByte*>(pBuffer);
+    size_t nRead = 0;
+    while( nRead < nSize )
+    {
+        const ssize_t nRet = VSI_PREAD64( fd, pabyBuffer + nRead,
+                                          nSize - nRead,
+                                          nOffset + nRead );
+        if( nRet < 0 && errno == EINTR )
+            continue;
+        if( nRet <= 0 )
+            break;
+        nRead += static_cast<size_t>(nRet);
+    }
+
+#ifdef VSI_DEBUG
+    VSIDebug4( "VSIUnixStdioHandle::PRead(%p," CPL_FRMT_GUIB ",%ld) = %ld",
+               fp, nOffset, static_cast<long>(nSize),
+               static_cast<long>(nRead) );
+#endif
+
+    return nRead;
+}
+
 /************************************************************************/
 /*                          GetRangeStatus()                            */
 /************************************************************************/
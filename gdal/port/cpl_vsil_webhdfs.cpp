@@ -130,6 +130,14 @@ class VSIWebHDFSHandle final : public VSICurlHandle
                                                  panOffsets, panSizes );
     }
 
+    // Reads go through a data node that is discovered by DownloadRegion().
+    bool HasPRead() const override { return false; }
+    size_t PRead( void* pBuffer, size_t nSize,
+                  vsi_l_offset nOffset ) const override {
+        return VSIVirtualHandle::PRead( pBuffer, nSize, nOffset );
+    }
+    void AdviseRead( int, const vsi_l_offset*, const size_t* ) override {}
+
     vsi_l_offset GetFileSize( bool bSetError ) override;
 };
 
@@ -30,10 +30,12 @@
 #include "cpl_worker_thread_pool.h"
 
 #include <cstddef>
+#include <iterator>
 #include <memory>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_vsi.h"
 
 
@@ -43,6 +45,7 @@ struct CPLWorkerThreadJob
 {
     CPLThreadFunc  pfnFunc;
     void          *pData;
+    const CPLJobQueue *poOwner;
 };
 
 /************************************************************************/
@@ -87,6 +90,33 @@ CPLWorkerThreadPool::~CPLWorkerThreadPool()
     CPLListDestroy(psWaitingWorkerThreadsList);
 }
 
+/************************************************************************/
+/*                       GetCurrentWorkerThread()                       */
+/************************************************************************/
+
+CPLWorkerThread* CPLWorkerThreadPool::GetCurrentWorkerThread() const
+{
+    CPLWorkerThread* psWT =
+        static_cast<CPLWorkerThread*>(CPLGetTLS(CTLS_WORKERTHREAD));
+    if( psWT != nullptr && psWT->poTP == this )
+        return psWT;
+    return nullptr;
+}
+
+/************************************************************************/
+/*                        IsCurrentThreadWorker()                       */
+/************************************************************************/
+
+/** Return whether the calling thread is one of the worker threads of this
+ * pool, that is whether it is currently running a job of this pool.
+ *
+ * @since GDAL 3.4
+ */
+bool CPLWorkerThreadPool::IsCurrentThreadWorker() const
+{
+    return GetCurrentWorkerThread() != nullptr;
+}
+
 /************************************************************************/
 /*                       WorkerThreadFunction()                         */
 /************************************************************************/
@@ -96,6 +126,8 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void* user_data)
     CPLWorkerThread* psWT = static_cast<CPLWorkerThread*>(user_data);
     CPLWorkerThreadPool* poTP = psWT->poTP;
 
+    CPLSetTLS(CTLS_WORKERTHREAD, psWT, FALSE);
+
     if( psWT->pfnInitFunc )
         psWT->pfnInitFunc( psWT->pInitData );
 
@@ -122,12 +154,22 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void* user_data)
 /************************************************************************/
 
 /** Queue a new job.
+ *
+ * This method may be called from a job running in this pool: the new job is
+ * then queued to the calling worker thread, which runs it next if it is not
+ * stolen by an idle worker thread in the meantime.
  *
  * @param pfnFunc Function to run for the job.
  * @param pData User data to pass to the job function.
  * @return true in case of success.
  */
 bool CPLWorkerThreadPool::SubmitJob( CPLThreadFunc pfnFunc, void* pData )
+{
+    return SubmitJob(pfnFunc, pData, nullptr);
+}
+
+bool CPLWorkerThreadPool::SubmitJob( CPLThreadFunc pfnFunc, void* pData,
+                                     const CPLJobQueue* poOwner )
 {
     CPLAssert( !aWT.empty() );
 
@@ -137,49 +179,31 @@ bool CPLWorkerThreadPool::SubmitJob( CPLThreadFunc pfnFunc, void* pData )
         return false;
     psJob->pfnFunc = pfnFunc;
     psJob->pData = pData;
+    psJob->poOwner = poOwner;
 
-    CPLList* psItem =
-        static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-    if( psItem == nullptr )
-    {
-        VSIFree(psJob);
-        return false;
-    }
-    psItem->pData = psJob;
-
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-
-    psItem->psNext = psJobQueue;
-    psJobQueue = psItem;
+    // Incremented before the job can be run, so that it cannot be declared
+    // finished before being counted.
     nPendingJobs++;
 
-    if( psWaitingWorkerThreadsList )
+    CPLWorkerThread* psCurrentWT = GetCurrentWorkerThread();
+    if( psCurrentWT )
     {
-        CPLWorkerThread* psWorkerThread =
-            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
-
-        CPLAssert( psWorkerThread->bMarkedAsWaiting );
-        psWorkerThread->bMarkedAsWaiting = false;
-
-        CPLList* psNext = psWaitingWorkerThreadsList->psNext;
-        CPLList* psToFree = psWaitingWorkerThreadsList;
-        psWaitingWorkerThreadsList = psNext;
-        nWaitingWorkerThreads--;
-
-        // CPLAssert(
-        //   CPLListCount(psWaitingWorkerThreadsList) == nWaitingWorkerThreads);
-
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
-
-        {
-            std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-            oGuard.unlock();
-            psWorkerThread->m_cv.notify_one();
-        }
+        std::lock_guard<std::mutex> oGuardJobs(psCurrentWT->m_mutexJobs);
+        psCurrentWT->m_apsJobs.push_back(psJob);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> oGuardJobs(m_mutexJobQueue);
+        m_apsJobQueue.push_back(psJob);
+    }
+    m_nQueuedJobs++;
 
-        CPLFree(psToFree);
+    // See GetNextJob() for why testing nWaitingWorkerThreads outside of
+    // m_mutex cannot miss a worker thread going to sleep.
+    if( nWaitingWorkerThreads > 0 )
+    {
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        WakeUpWaitingWorkerThreads(oGuard, 1);
     }
 
     return true;
@@ -200,89 +224,186 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 {
     CPLAssert( !aWT.empty() );
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-
-    CPLList* psJobQueueInit = psJobQueue;
-    bool bRet = true;
-
+    std::vector<CPLWorkerThreadJob*> apsJobs;
+    apsJobs.reserve(apData.size());
     for(size_t i=0;i<apData.size();i++)
     {
         CPLWorkerThreadJob* psJob = static_cast<CPLWorkerThreadJob*>(
             VSI_MALLOC_VERBOSE(sizeof(CPLWorkerThreadJob)));
         if( psJob == nullptr )
         {
-            bRet = false;
-            break;
+            for( auto psOtherJob: apsJobs )
+                VSIFree(psOtherJob);
+            return false;
         }
         psJob->pfnFunc = pfnFunc;
         psJob->pData = apData[i];
+        psJob->poOwner = nullptr;
+        apsJobs.push_back(psJob);
+    }
 
-        CPLList* psItem =
-            static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-        if( psItem == nullptr )
-        {
-            VSIFree(psJob);
-            bRet = false;
-            break;
-        }
-        psItem->pData = psJob;
+    nPendingJobs += static_cast<int>(apsJobs.size());
 
-        psItem->psNext = psJobQueue;
-        psJobQueue = psItem;
-        nPendingJobs++;
+    CPLWorkerThread* psCurrentWT = GetCurrentWorkerThread();
+    if( psCurrentWT )
+    {
+        std::lock_guard<std::mutex> oGuardJobs(psCurrentWT->m_mutexJobs);
+        psCurrentWT->m_apsJobs.insert(psCurrentWT->m_apsJobs.end(),
+                                      apsJobs.begin(), apsJobs.end());
     }
-
-    if( !bRet )
+    else
     {
-        for( CPLList* psIter = psJobQueue; psIter != psJobQueueInit; )
-        {
-            CPLList* psNext = psIter->psNext;
-            VSIFree(psIter->pData);
-            VSIFree(psIter);
-            nPendingJobs--;
-            psIter = psNext;
-        }
-        return false;
+        std::lock_guard<std::mutex> oGuardJobs(m_mutexJobQueue);
+        m_apsJobQueue.insert(m_apsJobQueue.end(),
+                             apsJobs.begin(), apsJobs.end());
     }
+    m_nQueuedJobs += static_cast<int>(apsJobs.size());
 
-    for(size_t i=0;i<apData.size();i++)
+    if( nWaitingWorkerThreads > 0 )
     {
-        if( psWaitingWorkerThreadsList && psJobQueue )
-        {
-            CPLWorkerThread* psWorkerThread;
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        WakeUpWaitingWorkerThreads(oGuard, static_cast<int>(apsJobs.size()));
+    }
 
-            psWorkerThread = static_cast<CPLWorkerThread*>(psWaitingWorkerThreadsList->pData);
+    return true;
+}
 
-            CPLAssert( psWorkerThread->bMarkedAsWaiting );
-            psWorkerThread->bMarkedAsWaiting = false;
+/************************************************************************/
+/*                     WakeUpWaitingWorkerThreads()                     */
+/************************************************************************/
 
-            CPLList* psNext = psWaitingWorkerThreadsList->psNext;
-            CPLList* psToFree = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psNext;
-            nWaitingWorkerThreads--;
+// Must be called with m_mutex locked through oGuard. Returns with it locked.
+void CPLWorkerThreadPool::WakeUpWaitingWorkerThreads(
+                        std::unique_lock<std::mutex>& oGuard, int nJobs)
+{
+    for( int i = 0; i < nJobs && psWaitingWorkerThreadsList; i++ )
+    {
+        CPLWorkerThread* psWorkerThread =
+            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
 
-            // CPLAssert(
-            //    CPLListCount(psWaitingWorkerThreadsList) ==
-            //    nWaitingWorkerThreads);
+        CPLAssert( psWorkerThread->bMarkedAsWaiting );
+
+        CPLList* psNext = psWaitingWorkerThreadsList->psNext;
+        CPLList* psToFree = psWaitingWorkerThreadsList;
+        psWaitingWorkerThreadsList = psNext;
+        nWaitingWorkerThreads--;
+
+        // CPLAssert(
+        //   CPLListCount(psWaitingWorkerThreadsList) == nWaitingWorkerThreads);
 
 #if DEBUG_VERBOSE
-            CPLDebug("JOB", "Waking up %p", psWorkerThread);
+        CPLDebug("JOB", "Waking up %p", psWorkerThread);
 #endif
+
+        {
+            std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+            psWorkerThread->bMarkedAsWaiting = false;
+            oGuard.unlock();
+            psWorkerThread->m_cv.notify_one();
+        }
+
+        CPLFree(psToFree);
+        oGuard.lock();
+    }
+}
+
+/************************************************************************/
+/*                              TakeJob()                               */
+/************************************************************************/
+
+// Dequeue a job that has not been started yet. The jobs submitted by the
+// current thread are taken first, most recent first, as their data is the
+// most likely to be still hot in cache. Then the ones submitted from outside
+// of the pool, and finally the oldest jobs of other worker threads are stolen.
+// If poOwner is not null, only jobs submitted through that job queue are
+// considered.
+// Each job list is protected by its own mutex: stealing only locks the list
+// of the victim thread, and m_mutex is not needed.
+CPLWorkerThreadJob* CPLWorkerThreadPool::TakeJob(
+                                    CPLWorkerThread* psCurrentWorkerThread,
+                                    const CPLJobQueue* poOwner)
+{
+    const auto Matches = [poOwner](const CPLWorkerThreadJob* psJob)
+    {
+        return poOwner == nullptr || psJob->poOwner == poOwner;
+    };
+
+    CPLWorkerThreadJob* psJob = nullptr;
+    if( m_nQueuedJobs <= 0 )
+        return nullptr;
+
+    if( psCurrentWorkerThread )
+    {
+        std::lock_guard<std::mutex> oGuardJobs(
+                                    psCurrentWorkerThread->m_mutexJobs);
+        auto& apsJobs = psCurrentWorkerThread->m_apsJobs;
+        for( auto oIter = apsJobs.rbegin(); oIter != apsJobs.rend(); ++oIter )
+        {
+            if( Matches(*oIter) )
             {
-                std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-                oGuard.unlock();
-                psWorkerThread->m_cv.notify_one();
+                psJob = *oIter;
+                apsJobs.erase(std::next(oIter).base());
+                break;
             }
+        }
+    }
 
-            CPLFree(psToFree);
-            oGuard.lock();
+    if( psJob == nullptr )
+    {
+        std::lock_guard<std::mutex> oGuardJobs(m_mutexJobQueue);
+        for( auto oIter = m_apsJobQueue.begin();
+                  oIter != m_apsJobQueue.end(); ++oIter )
+        {
+            if( Matches(*oIter) )
+            {
+                psJob = *oIter;
+                m_apsJobQueue.erase(oIter);
+                break;
+            }
         }
-        else
+    }
+    if( psJob == nullptr )
+    {
+        std::lock_guard<std::mutex> oGuardWT(m_mutexWT);
+        for( auto& wt: aWT )
         {
-            break;
+            if( wt.get() == psCurrentWorkerThread )
+                continue;
+            std::lock_guard<std::mutex> oGuardJobs(wt->m_mutexJobs);
+            for( auto oIter = wt->m_apsJobs.begin();
+                      oIter != wt->m_apsJobs.end(); ++oIter )
+            {
+                if( Matches(*oIter) )
+                {
+                    psJob = *oIter;
+                    wt->m_apsJobs.erase(oIter);
+                    break;
+                }
+            }
+            if( psJob )
+                break;
         }
     }
+    if( psJob )
+        m_nQueuedJobs--;
+    return psJob;
+}
 
+/************************************************************************/
+/*                         ProcessPendingJob()                          */
+/************************************************************************/
+
+// Run in the calling thread one job of poOwner that has not been started yet.
+// Returns false if there is no such job.
+bool CPLWorkerThreadPool::ProcessPendingJob(const CPLJobQueue* poOwner)
+{
+    CPLWorkerThreadJob* psJob = TakeJob(GetCurrentWorkerThread(), poOwner);
+    if( psJob == nullptr )
+        return false;
+
+    psJob->pfnFunc(psJob->pData);
+    CPLFree(psJob);
+    DeclareJobFinished();
     return true;
 }
 
@@ -291,6 +412,9 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * This must not be called from a job running in this pool, as the pending
+ * jobs include the calling one. Use a CPLJobQueue in that case.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might be
@@ -298,6 +422,7 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
  */
 void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
 {
+    CPLAssert( !IsCurrentThreadWorker() );
     if( nMaxRemainingJobs < 0 )
         nMaxRemainingJobs = 0;
     std::unique_lock<std::mutex> oGuard(m_mutex);
@@ -382,6 +507,8 @@ bool CPLWorkerThreadPool::Setup(int nThreads,
             bRet = false;
             break;
         }
+        // TakeJob() iterates over aWT with m_mutexWT held.
+        std::lock_guard<std::mutex> oGuard(m_mutexWT);
         aWT.emplace_back(std::move(wt));
     }
 
@@ -409,7 +536,8 @@ void CPLWorkerThreadPool::DeclareJobFinished()
 {
     std::lock_guard<std::mutex> oGuard(m_mutex);
     nPendingJobs --;
-    m_cv.notify_one();
+    // Several threads may be in WaitCompletion() or WaitEvent().
+    m_cv.notify_all();
 }
 
 /************************************************************************/
@@ -421,25 +549,21 @@ CPLWorkerThreadPool::GetNextJob( CPLWorkerThread* psWorkerThread )
 {
     while(true)
     {
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        if( eState == CPLWTS_STOP )
-        {
-            return nullptr;
-        }
-        CPLList* psTopJobIter = psJobQueue;
-        if( psTopJobIter )
+        CPLWorkerThreadJob* psJob = TakeJob(psWorkerThread, nullptr);
+        if( psJob )
         {
-            psJobQueue = psTopJobIter->psNext;
-
 #if DEBUG_VERBOSE
             CPLDebug("JOB", "%p got a job", psWorkerThread);
 #endif
-            CPLWorkerThreadJob* psJob =
-                static_cast<CPLWorkerThreadJob*>(psTopJobIter->pData);
-            CPLFree(psTopJobIter);
             return psJob;
         }
 
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        if( eState == CPLWTS_STOP )
+        {
+            return nullptr;
+        }
+
         if( !psWorkerThread->bMarkedAsWaiting )
         {
             psWorkerThread->bMarkedAsWaiting = true;
@@ -467,6 +591,13 @@ CPLWorkerThreadPool::GetNextJob( CPLWorkerThread* psWorkerThread )
 
         m_cv.notify_one();
 
+        // Submitters increment m_nQueuedJobs before testing
+        // nWaitingWorkerThreads, and we have incremented the latter before
+        // testing the former: either we see the new job here, or the
+        // submitter sees us as waiting and wakes us up.
+        if( m_nQueuedJobs > 0 )
+            continue;
+
 #if DEBUG_VERBOSE
         CPLDebug("JOB", "%p sleeping", psWorkerThread);
 #endif
@@ -542,7 +673,7 @@ void CPLJobQueue::DeclareJobFinished()
 {
     std::lock_guard<std::mutex> oGuard(m_mutex);
     m_nPendingJobs --;
-    m_cv.notify_one();
+    m_cv.notify_all();
 }
 
 /************************************************************************/
@@ -565,10 +696,19 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void* pData)
         std::lock_guard<std::mutex> oGuard(m_mutex);
         m_nPendingJobs ++;
     }
-    bool bRet = m_poPool->SubmitJob(JobQueueFunction, poJob);
+    bool bRet = m_poPool->SubmitJob(JobQueueFunction, poJob, this);
     if( !bRet )
     {
         delete poJob;
+        DeclareJobFinished();
+    }
+    else
+    {
+        // Wake up the threads waiting in WaitCompletion() so that they can
+        // help running the new job.
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_nSubmittedJobs ++;
+        m_cv.notify_all();
     }
     return bRet;
 }
@@ -578,6 +718,10 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void* pData)
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * While jobs of this queue have not been started yet, the calling thread runs
+ * them itself instead of just blocking. This makes it safe to wait for a queue
+ * from a job running in the same worker thread pool.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might be
@@ -585,9 +729,75 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void* pData)
  */
 void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
 {
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-    while( m_nPendingJobs > nMaxRemainingJobs )
+    while( true )
     {
-        m_cv.wait(oGuard);
+        int nSubmittedJobs;
+        {
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            if( m_nPendingJobs <= nMaxRemainingJobs )
+                return;
+            nSubmittedJobs = m_nSubmittedJobs;
+        }
+
+        if( m_poPool->ProcessPendingJob(this) )
+            continue;
+
+        // All remaining jobs were running in other threads. Wait for one of
+        // them to finish, or for a job submitted since then, which we may
+        // run ourselves.
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        m_cv.wait(oGuard, [this, nMaxRemainingJobs, nSubmittedJobs]
+        {
+            return m_nPendingJobs <= nMaxRemainingJobs ||
+                   m_nSubmittedJobs != nSubmittedJobs;
+        });
     }
 }
+
+/************************************************************************/
+/*                    CPLGetGlobalWorkerThreadPool()                    */
+/************************************************************************/
+
+static std::mutex gMutexGlobalThreadPool;
+static CPLWorkerThreadPool *gpoGlobalThreadPool = nullptr;
+
+/** Return the process-wide worker thread pool, creating it, or increasing
+ * its number of threads, so that it has at least nThreads threads.
+ *
+ * @return the pool, or nullptr if it cannot be created.
+ * @since GDAL 3.4
+ */
+CPLWorkerThreadPool* CPLGetGlobalWorkerThreadPool(int nThreads)
+{
+    std::lock_guard<std::mutex> oGuard(gMutexGlobalThreadPool);
+    if( gpoGlobalThreadPool == nullptr )
+    {
+        gpoGlobalThreadPool = new CPLWorkerThreadPool();
+        if( !gpoGlobalThreadPool->Setup(nThreads, nullptr, nullptr) )
+        {
+            delete gpoGlobalThreadPool;
+            gpoGlobalThreadPool = nullptr;
+        }
+    }
+    else if( nThreads > gpoGlobalThreadPool->GetThreadCount() )
+    {
+        // Increase size of thread pool
+        gpoGlobalThreadPool->Setup(nThreads, nullptr, nullptr, false);
+    }
+    return gpoGlobalThreadPool;
+}
+
+/************************************************************************/
+/*                  CPLDestroyGlobalWorkerThreadPool()                  */
+/************************************************************************/
+
+/** Destroy the pool returned by CPLGetGlobalWorkerThreadPool().
+ *
+ * @since GDAL 3.4
+ */
+void CPLDestroyGlobalWorkerThreadPool()
+{
+    std::lock_guard<std::mutex> oGuard(gMutexGlobalThreadPool);
+    delete gpoGlobalThreadPool;
+    gpoGlobalThreadPool = nullptr;
+}
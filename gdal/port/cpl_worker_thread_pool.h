@@ -33,7 +33,9 @@
 #include "cpl_multiproc.h"
 #include "cpl_list.h"
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -62,6 +64,11 @@ struct CPLWorkerThread
 
     std::mutex              m_mutex{};
     std::condition_variable m_cv{};
+
+    // Jobs submitted from this thread. The owner thread pushes and pops at
+    // the back, other threads steal from the front.
+    std::mutex              m_mutexJobs{};
+    std::deque<CPLWorkerThreadJob*> m_apsJobs{};
 };
 
 typedef enum
@@ -80,19 +87,37 @@ class CPL_DLL CPLWorkerThreadPool
         CPL_DISALLOW_COPY_ASSIGN(CPLWorkerThreadPool)
 
         std::vector<std::unique_ptr<CPLWorkerThread>> aWT{};
+        // Protects the growth of aWT, which is iterated over when stealing.
+        std::mutex              m_mutexWT{};
         std::mutex              m_mutex{};
         std::condition_variable m_cv{};
         volatile CPLWorkerThreadState eState = CPLWTS_OK;
-        CPLList* psJobQueue = nullptr;
-        volatile int nPendingJobs = 0;
+        // Jobs submitted from threads that are not workers of this pool.
+        std::mutex              m_mutexJobQueue{};
+        std::deque<CPLWorkerThreadJob*> m_apsJobQueue{};
+        std::atomic<int> nPendingJobs{0};
+        // Number of submitted jobs not yet started. Incremented after a job
+        // is queued, and decremented after it is dequeued, so it may be
+        // transiently off by the number of concurrent submissions/takes.
+        std::atomic<int> m_nQueuedJobs{0};
 
         CPLList* psWaitingWorkerThreadsList = nullptr;
-        int nWaitingWorkerThreads = 0;
+        std::atomic<int> nWaitingWorkerThreads{0};
 
         static void WorkerThreadFunction(void* user_data);
 
         void DeclareJobFinished();
         CPLWorkerThreadJob* GetNextJob(CPLWorkerThread* psWorkerThread);
+        CPLWorkerThread* GetCurrentWorkerThread() const;
+        CPLWorkerThreadJob* TakeJob(CPLWorkerThread* psCurrentWorkerThread,
+                                    const CPLJobQueue* poOwner);
+        void WakeUpWaitingWorkerThreads(std::unique_lock<std::mutex>& oGuard,
+                                        int nJobs);
+
+        friend class CPLJobQueue;
+        bool SubmitJob(CPLThreadFunc pfnFunc, void* pData,
+                       const CPLJobQueue* poOwner);
+        bool ProcessPendingJob(const CPLJobQueue* poOwner);
 
     public:
         CPLWorkerThreadPool();
@@ -114,6 +139,8 @@ class CPL_DLL CPLWorkerThreadPool
         void WaitCompletion(int nMaxRemainingJobs = 0);
         void WaitEvent();
 
+        bool IsCurrentThreadWorker() const;
+
         /** Return the number of threads setup */
         int GetThreadCount() const { return static_cast<int>(aWT.size()); }
 };
@@ -126,6 +153,8 @@ class CPL_DLL CPLJobQueue
         std::mutex m_mutex{};
         std::condition_variable m_cv{};
         int m_nPendingJobs = 0;
+        // Number of jobs successfully submitted so far
+        int m_nSubmittedJobs = 0;
 
         static void JobQueueFunction(void*);
         void DeclareJobFinished();
@@ -146,4 +175,8 @@ public:
         void WaitCompletion(int nMaxRemainingJobs = 0);
 };
 
+CPLWorkerThreadPool CPL_DLL * CPLGetGlobalWorkerThreadPool(int nThreads);
+
+void CPL_DLL CPLDestroyGlobalWorkerThreadPool();
+
 #endif // CPL_WORKER_THREAD_POOL_H_INCLUDED_
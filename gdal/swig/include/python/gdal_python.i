@@ -295,6 +295,63 @@ unsigned int wrapper_VSIFReadL( void **buf, unsigned int nMembSize, unsigned int
 %clear (void **buf );
 %clear VSILFILE* fp;
 
+/* -------------------------------------------------------------------- */
+/*      VSIFPReadL()                                                    */
+/*                                                                      */
+/*      Positional read, which does not change the file position and    */
+/*      may be called from several threads.                             */
+/* -------------------------------------------------------------------- */
+
+%rename (VSIFPReadL) wrapper_VSIFPReadL;
+
+%apply ( void **outPythonObject ) { (void **buf ) };
+%apply Pointer NONNULL {VSILFILE* fp};
+%inline %{
+unsigned int wrapper_VSIFPReadL( void **buf, unsigned int nSize, GIntBig nOffset, VSILFILE *fp)
+{
+    if( nOffset < 0 )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Negative offset");
+        *buf = NULL;
+        return 0;
+    }
+
+    if (nSize == 0)
+    {
+        *buf = NULL;
+        return 0;
+    }
+
+    SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+    *buf = (void *)PyByteArray_FromStringAndSize( NULL, nSize );
+    if (*buf == NULL)
+    {
+        *buf = Py_None;
+        if( !bUseExceptions )
+        {
+            PyErr_Clear();
+        }
+        SWIG_PYTHON_THREAD_END_BLOCK;
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate result buffer");
+        return 0;
+    }
+    PyObject* o = (PyObject*) *buf;
+    char *data = PyByteArray_AsString(o);
+    SWIG_PYTHON_THREAD_END_BLOCK;
+    size_t nRet = VSIFPReadL( data, nSize, static_cast<vsi_l_offset>(nOffset), fp );
+    if (nRet < nSize)
+    {
+        SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+        PyByteArray_Resize(o, nRet);
+        SWIG_PYTHON_THREAD_END_BLOCK;
+        *buf = o;
+    }
+    return static_cast<unsigned int>(nRet);
+}
+%}
+%clear (void **buf );
+%clear VSILFILE* fp;
+
 /* -------------------------------------------------------------------- */
 /*      VSIGetMemFileBuffer_unsafe()                                    */
 /* -------------------------------------------------------------------- */
@@ -1927,7 +1984,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
               zFactor=None, scale=None, azimuth=None, altitude=None,
               combined=False, multiDirectional=False, igor=False,
               slopeFormat=None, trigonometric=False, zeroForFlat=False,
-              addAlpha=None, colorSelection=None,
+              addAlpha=None, colorSelection=None, numThreads=None,
               callback=None, callback_data=None):
     """ Create a DEMProcessingOptions() object that can be passed to gdal.DEMProcessing()
         Keyword arguments are :
@@ -1950,6 +2007,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
           zeroForFlat --- (aspect only) whether to return 0 for flat areas with slope=0, instead of -9999.
           addAlpha --- adds an alpha band to the output file (only for processing = 'color-relief')
           colorSelection --- (color-relief only) Determines how color entries are selected from an input value. Can be "nearest_color_entry", "exact_color_entry" or "linear_interpolation". Defaults to "linear_interpolation"
+          numThreads --- number of worker threads, or 'ALL_CPUS'. Not used for "color-relief".
           callback --- callback method
           callback_data --- user data for callback
     """
@@ -1966,6 +2024,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
                 new_options += ['-co', opt]
         if computeEdges:
             new_options += ['-compute_edges']
+        if numThreads is not None:
+            new_options += ['-num_threads', str(numThreads)]
         if alg:
             new_options += ['-alg', alg]
         new_options += ['-b', str(band)]
@@ -3608,6 +3608,49 @@ unsigned int wrapper_VSIFReadL( void **buf, unsigned int nMembSize, unsigned int
 }
 
 
+unsigned int wrapper_VSIFPReadL( void **buf, unsigned int nSize, GIntBig nOffset, VSILFILE *fp)
+{
+    if( nOffset < 0 )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Negative offset");
+        *buf = NULL;
+        return 0;
+    }
+
+    if (nSize == 0)
+    {
+        *buf = NULL;
+        return 0;
+    }
+
+    SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+    *buf = (void *)PyByteArray_FromStringAndSize( NULL, nSize );
+    if (*buf == NULL)
+    {
+        *buf = Py_None;
+        if( !bUseExceptions )
+        {
+            PyErr_Clear();
+        }
+        SWIG_PYTHON_THREAD_END_BLOCK;
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate result buffer");
+        return 0;
+    }
+    PyObject* o = (PyObject*) *buf;
+    char *data = PyByteArray_AsString(o);
+    SWIG_PYTHON_THREAD_END_BLOCK;
+    size_t nRet = VSIFPReadL( data, nSize, static_cast<vsi_l_offset>(nOffset), fp );
+    if (nRet < nSize)
+    {
+        SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+        PyByteArray_Resize(o, nRet);
+        SWIG_PYTHON_THREAD_END_BLOCK;
+        *buf = o;
+    }
+    return static_cast<unsigned int>(nRet);
+}
+
+
 #include <limits.h>
 #if !defined(SWIG_NO_LLONG_MAX)
 # if !defined(LLONG_MAX) && defined(__GNUC__) && defined (__LONG_LONG_MAX__)
@@ -8382,6 +8425,89 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_VSIFPReadL(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0; int bLocalUseExceptionsCode = bUseExceptions;
+  void **arg1 = (void **) 0 ;
+  unsigned int arg2 ;
+  GIntBig arg3 ;
+  VSILFILE *arg4 = (VSILFILE *) 0 ;
+  void *pyObject1 = NULL ;
+  unsigned int val2 ;
+  int ecode2 = 0 ;
+  void *argp4 = 0 ;
+  int res4 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  PyObject * obj2 = 0 ;
+  unsigned int result;
+  
+  {
+    /* %typemap(in,numinputs=0) ( void **outPythonObject ) ( void *pyObject1 = NULL ) */
+    arg1 = &pyObject1;
+  }
+  if (!PyArg_ParseTuple(args,(char *)"OOO:VSIFPReadL",&obj0,&obj1,&obj2)) SWIG_fail;
+  ecode2 = SWIG_AsVal_unsigned_SS_int(obj0, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "VSIFPReadL" "', argument " "2"" of type '" "unsigned int""'");
+  } 
+  arg2 = static_cast< unsigned int >(val2);
+  {
+    PY_LONG_LONG val;
+    if ( !PyArg_Parse(obj1,"L",&val) ) {
+      PyErr_SetString(PyExc_TypeError, "not an integer");
+      SWIG_fail;
+    }
+    arg3 = (GIntBig)val;
+  }
+  res4 = SWIG_ConvertPtr(obj2, &argp4,SWIGTYPE_p_VSILFILE, 0 |  0 );
+  if (!SWIG_IsOK(res4)) {
+    SWIG_exception_fail(SWIG_ArgError(res4), "in method '" "VSIFPReadL" "', argument " "4"" of type '" "VSILFILE *""'"); 
+  }
+  arg4 = reinterpret_cast< VSILFILE * >(argp4);
+  {
+    if (!arg4) {
+      SWIG_exception(SWIG_ValueError,"Received a NULL pointer.");
+    }
+  }
+  {
+    if ( bUseExceptions ) {
+      ClearErrorState();
+    }
+    {
+      SWIG_PYTHON_THREAD_BEGIN_ALLOW;
+      result = (unsigned int)wrapper_VSIFPReadL(arg1,arg2,arg3,arg4);
+      SWIG_PYTHON_THREAD_END_ALLOW;
+    }
+#ifndef SED_HACKS
+    if ( bUseExceptions ) {
+      CPLErr eclass = CPLGetLastErrorType();
+      if ( eclass == CE_Failure || eclass == CE_Fatal ) {
+        SWIG_exception( SWIG_RuntimeError, CPLGetLastErrorMsg() );
+      }
+    }
+#endif
+  }
+  resultobj = SWIG_From_unsigned_SS_int(static_cast< unsigned int >(result));
+  {
+    /* %typemap(argout) ( void **outPythonObject ) */
+    Py_XDECREF(resultobj);
+    if (*arg1)
+    {
+      resultobj = (PyObject*)*arg1;
+    }
+    else
+    {
+      resultobj = Py_None;
+      Py_INCREF(resultobj);
+    }
+  }
+  if ( ReturnSame(bLocalUseExceptionsCode) ) { CPLErr eclass = CPLGetLastErrorType(); if ( eclass == CE_Failure || eclass == CE_Fatal ) { Py_XDECREF(resultobj); SWIG_Error( SWIG_RuntimeError, CPLGetLastErrorMsg() ); return NULL; } }
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_VSIGetMemFileBuffer_unsafe(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0; int bLocalUseExceptionsCode = bUseExceptions;
   char *arg1 = (char *) 0 ;
@@ -42853,6 +42979,7 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"UseExceptions", _wrap_UseExceptions, METH_VARARGS, (char *)"UseExceptions()"},
 	 { (char *)"DontUseExceptions", _wrap_DontUseExceptions, METH_VARARGS, (char *)"DontUseExceptions()"},
 	 { (char *)"VSIFReadL", _wrap_VSIFReadL, METH_VARARGS, (char *)"VSIFReadL(unsigned int nMembSize, unsigned int nMembCount, VSILFILE fp) -> unsigned int"},
+	 { (char *)"VSIFPReadL", _wrap_VSIFPReadL, METH_VARARGS, (char *)"VSIFPReadL(unsigned int nSize, GIntBig nOffset, VSILFILE fp) -> unsigned int"},
 	 { (char *)"VSIGetMemFileBuffer_unsafe", _wrap_VSIGetMemFileBuffer_unsafe, METH_VARARGS, (char *)"VSIGetMemFileBuffer_unsafe(char const * utf8_path)"},
 	 { (char *)"Debug", _wrap_Debug, METH_VARARGS, (char *)"Debug(char const * msg_class, char const * message)"},
 	 { (char *)"SetErrorHandler", _wrap_SetErrorHandler, METH_VARARGS, (char *)"SetErrorHandler(CPLErrorHandler pfnErrorHandler=0) -> CPLErr"},
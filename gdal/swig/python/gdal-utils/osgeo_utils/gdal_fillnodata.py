@@ -43,7 +43,7 @@ def CopyBand(srcband, dstband):
 
 def Usage():
     print("""gdal_fillnodata [-q] [-md max_distance] [-si smooth_iterations]
-                [-o name=value] [-b band]
+                [-interp {inv_dist,push_pull}] [-o name=value] [-b band]
                 srcfile [-nomask] [-mask filename] [-of format] [-co name=value]* [dstfile]""")
     return 1
 
@@ -94,6 +94,14 @@ def main(argv):
             i = i + 1
             max_distance = float(argv[i])
 
+        elif arg == '-interp':
+            i = i + 1
+            options.append('INTERPOLATION=' + argv[i].upper())
+
+        elif arg == '-o':
+            i = i + 1
+            options.append(argv[i])
+
         elif arg == '-nomask':
             mask = 'none'
 
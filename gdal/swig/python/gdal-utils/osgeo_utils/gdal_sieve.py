@@ -31,7 +31,7 @@
 # ******************************************************************************
 
 import sys
-from typing import Optional
+from typing import Optional, Sequence
 
 from osgeo import gdal
 
@@ -53,6 +53,7 @@ def main(argv):
 
     dst_filename = None
     driver_name = None
+    options = []
 
     mask = 'default'
 
@@ -82,6 +83,10 @@ def main(argv):
             i = i + 1
             threshold = int(argv[i])
 
+        elif arg == '-o':
+            i = i + 1
+            options.append(argv[i])
+
         elif arg == '-nomask':
             mask = 'none'
 
@@ -111,13 +116,14 @@ def main(argv):
         return Usage()
 
     return gdal_sieve(src_filename=src_filename, dst_filename=dst_filename, driver_name=driver_name,
-                      mask=mask, threshold=threshold, connectedness=connectedness, quiet=quiet)
+                      mask=mask, threshold=threshold, connectedness=connectedness, quiet=quiet,
+                      options=options)
 
 
 def gdal_sieve(src_filename: Optional[str] = None,
                dst_filename: PathLikeOrStr = None, driver_name: Optional[str] = None, mask: str = 'default',
                threshold: int = 2, connectedness: int = 4,
-               quiet: bool = False):
+               quiet: bool = False, options: Optional[Sequence[str]] = None):
     # =============================================================================
     # 	Verify we have next gen bindings with the sievefilter method.
     # =============================================================================
@@ -186,6 +192,7 @@ def gdal_sieve(src_filename: Optional[str] = None,
 
     result = gdal.SieveFilter(srcband, maskband, dstband,
                               threshold, connectedness,
+                              options=options,
                               callback=prog_func)
 
     src_ds = None
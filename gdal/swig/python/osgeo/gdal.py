@@ -200,6 +200,10 @@ def VSIFReadL(*args):
     """VSIFReadL(unsigned int nMembSize, unsigned int nMembCount, VSILFILE fp) -> unsigned int"""
     return _gdal.VSIFReadL(*args)
 
+def VSIFPReadL(*args):
+    """VSIFPReadL(unsigned int nSize, GIntBig nOffset, VSILFILE fp) -> unsigned int"""
+    return _gdal.VSIFPReadL(*args)
+
 def VSIGetMemFileBuffer_unsafe(*args):
     """VSIGetMemFileBuffer_unsafe(char const * utf8_path)"""
     return _gdal.VSIGetMemFileBuffer_unsafe(*args)
@@ -861,7 +865,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
               zFactor=None, scale=None, azimuth=None, altitude=None,
               combined=False, multiDirectional=False, igor=False,
               slopeFormat=None, trigonometric=False, zeroForFlat=False,
-              addAlpha=None, colorSelection=None,
+              addAlpha=None, colorSelection=None, numThreads=None,
               callback=None, callback_data=None):
     """ Create a DEMProcessingOptions() object that can be passed to gdal.DEMProcessing()
         Keyword arguments are :
@@ -884,6 +888,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
           zeroForFlat --- (aspect only) whether to return 0 for flat areas with slope=0, instead of -9999.
           addAlpha --- adds an alpha band to the output file (only for processing = 'color-relief')
           colorSelection --- (color-relief only) Determines how color entries are selected from an input value. Can be "nearest_color_entry", "exact_color_entry" or "linear_interpolation". Defaults to "linear_interpolation"
+          numThreads --- number of worker threads, or 'ALL_CPUS'. Not used for "color-relief".
           callback --- callback method
           callback_data --- user data for callback
     """
@@ -900,6 +905,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
                 new_options += ['-co', opt]
         if computeEdges:
             new_options += ['-compute_edges']
+        if numThreads is not None:
+            new_options += ['-num_threads', str(numThreads)]
         if alg:
             new_options += ['-alg', alg]
         new_options += ['-b', str(band)]